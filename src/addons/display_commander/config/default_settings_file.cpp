@@ -36,7 +36,7 @@ const char* const DEFAULT_SETTINGS_TEMPLATE = R"(# Display Commander — User de
 # window_mode2 = 1
 
 # FPS limiter: fps_limit = target FPS (0 = unlimited, 1–240 otherwise). Requires fps_limiter_enabled = true.
-# fps_limiter_mode: 0 = Default, 1 = Reflex (low latency).
+# fps_limiter_mode: 0 = Default, 1 = Reflex (low latency), 2 = VBlank phase lock (fixed refresh).
 # fps_limit_background = limit when game window has no focus (0 = unlimited).
 # fps_limiter_enabled = true
 # fps_limit = 60
@@ -6,11 +6,13 @@
 #include "default_settings_file.hpp"
 #include "global_overrides_file.hpp"
 #include "hotkeys_file.hpp"
+#include "../feature/hitch/hitch.hpp"
 #include "../globals.hpp"
 #include "../utils.hpp"
 #include "../utils/display_commander_logger.hpp"
 #include "../utils/logging.hpp"
 #include "../utils/srwlock_wrapper.hpp"
+#include "../utils/timing.hpp"
 
 #include <algorithm>
 #include <cctype>
@@ -513,7 +515,10 @@ void DisplayCommanderConfigManager::SaveConfig(const char* reason) {
     }
 
     EnsureConfigFileExists();
-    if (config_file_->SaveToFile(config_path_)) {
+    const LONGLONG save_start_ns = utils::get_now_ns();
+    const bool saved = config_file_->SaveToFile(config_path_);
+    display_commander::feature::hitch::RecordHitchConfigSave(save_start_ns, utils::get_now_ns());
+    if (saved) {
         // Clear any previous save failure state
         g_config_save_failure_path.store(nullptr);
 
@@ -1,11 +1,19 @@
+#include "continuous_monitoring.hpp"
 #include "addon.hpp"
 #include "adhd_multi_monitor/adhd_simple_api.hpp"
 #include "display/display_cache.hpp"
 #include "feature/cpu_telemetry/cpu_telemetry.hpp"
+#include "feature/foreground/foreground.hpp"
+#include "feature/frame_bound/frame_bound.hpp"
+#include "feature/input_latency/input_latency.hpp"
+#include "feature/latency_estimate/latency_estimate.hpp"
+#include "feature/reflex_latency/reflex_latency.hpp"
+#include "feature/trace/trace.hpp"
 #include "process_exit_hooks.hpp"
 #include "globals.hpp"
 #include "hooks/windows_hooks/api_hooks.hpp"
 #include "hooks/loadlibrary_hooks.hpp"
+#include "hooks/nvidia/pclstats_etw_hooks.hpp"
 #include "hooks/windows_hooks/windows_message_hooks.hpp"
 #include "nvapi/nvapi_init.hpp"
 #include "nvapi/nvapi_loader.hpp"
@@ -25,6 +33,8 @@
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <iterator>
+#include <memory>
 #include <sstream>
 #include <thread>
 
@@ -36,6 +46,18 @@
 namespace {
 constexpr bool kMonitorHighFreqEnabled = true;
 constexpr int kMonitorHighFreqIntervalMs = 8;
+// Safety-net poll of the foreground window; changes are normally pushed by feature/foreground.
+constexpr int kMonitorForegroundPollIntervalMs = 500;
+// Safety-net poll of the window auto-fix; game window moves / resizes are pushed by the window proc hook.
+constexpr int kMonitorWindowAutoFixPollIntervalMs = 100;
+// Overlay CPU load queries are at least 100 frames apart (cpu_telemetry.cpp), i.e. >= 100 ms up to 1000 FPS.
+constexpr int kMonitorCpuTelemetryIntervalMs = 100;
+// Frame timeline consumers (frame_bound, input_latency, latency_estimate) read g_frame_data 8 frames behind the
+// newest frame and must run before the 64-slot ring wraps. Batch this many frames per pass, within the bounds below.
+constexpr uint64_t kMonitorFrameBatchFrames = 16;
+constexpr int kMonitorFrameBatchMaxIntervalMs = 100;
+// PCLStats ETW drain while no foreign PCLStats provider is registered (nothing can be queued until then).
+constexpr int kMonitorPclStatsIdleIntervalMs = 1000;
 constexpr bool kMonitorPerSecondEnabled = true;
 constexpr int kMonitorPerSecondIntervalSec = 1;
 constexpr bool kMonitorScreensaver = true;
@@ -43,8 +65,12 @@ constexpr bool kMonitorFpsAggregate = true;
 constexpr bool kMonitorVrrStatus = true;
 constexpr bool kMonitorExclusiveKeyGroups = true;
 constexpr bool kMonitorReflexAutoConfigure = true;
+constexpr bool kMonitorReflexLatencyHistory = true;
+// Decodes PCLStats ETW writes queued by the EventWriteTransfer hook (markers reach the latency marker bus)
+constexpr bool kMonitorPclStatsEtwDrain = true;
 constexpr bool kMonitorDisplayCache = true;
-constexpr int kMonitorDisplayCacheIntervalSec = 2;
+// Fingerprint check only; WM_DISPLAYCHANGE / WM_DEVICECHANGE request an immediate refresh.
+constexpr int kMonitorDisplayCacheIntervalSec = 5;
 }  // namespace
 
 // Stuck detection: last time the continuous monitoring loop started an iteration (real time ns)
@@ -66,6 +92,7 @@ void HandleReflexAutoConfigure() {
     CALL_GUARD_NO_TS();
     // Only run if auto-configure is enabled
     if (!settings::g_advancedTabSettings.reflex_auto_configure.GetValue()) {
+        display_commander::feature::frame_bound::SetInjectedReflexSleepRecommended(true);
         return;
     }
 
@@ -101,6 +128,20 @@ void HandleReflexAutoConfigure() {
         && settings::g_advancedTabSettings.reflex_enable_sleep.GetValue() != !is_native_reflex_active) {
         settings::g_advancedTabSettings.reflex_enable_sleep.SetValue(!is_native_reflex_active);
     }
+
+    // Injected Reflex sleep is kept only while the bound analysis says frames queue up behind the GPU. This is a
+    // runtime override; the saved setting is left alone. The Reflex FPS limiter paces through the sleep, so it
+    // stays on in that mode.
+    namespace frame_bound = display_commander::feature::frame_bound;
+    const bool was_recommended = frame_bound::IsInjectedReflexSleepRecommended();
+    bool recommended = true;
+    if (!is_native_reflex_active && !is_reflex_mode) {
+        recommended = frame_bound::RecommendInjectedReflexSleep(frame_bound::GetLatestBoundAnalysis(), was_recommended);
+    }
+    if (recommended != was_recommended) {
+        frame_bound::SetInjectedReflexSleepRecommended(recommended);
+        LogInfo("Reflex auto-configure: injected sleep %s", recommended ? "resumed" : "paused (CPU-bound)");
+    }
 }
 
 bool IsAppInBackground() {
@@ -130,22 +171,22 @@ void TrySetGameWindowFromForeground() {
     g_last_swapchain_hwnd.store(fg, std::memory_order_release);
 }
 
+// Applies foreground/background side effects (cursor clip) for the state in g_app_in_background.
+// The state itself is pushed by feature/foreground (WinEvent hook, window proc) and corrected by the slow poll.
 void check_is_background() {
     CALL_GUARD_NO_TS();
     HWND hwnd = g_last_swapchain_hwnd.load();
 
     // BACKGROUND DETECTION: Run at least once (no early return) so g_app_in_background and
     // g_last_foreground_background_switch_ns are set; downstream (e.g. NVAPI VRR cache) relies on this.
-    const bool prev_in_bg = g_app_in_background.load(std::memory_order_acquire);
-    bool app_in_background = IsAppInBackground();
+    display_commander::feature::foreground::PollForegroundState();
+    bool app_in_background = g_app_in_background.load(std::memory_order_acquire);
     static bool first_time = true;
+    static bool applied_in_background = false;
 
-    if (app_in_background != prev_in_bg || first_time) {
+    if (app_in_background != applied_in_background || first_time) {
         first_time = false;
-
-        g_app_in_background.store(app_in_background);
-        g_last_foreground_background_switch_ns.store(static_cast<LONGLONG>(utils::get_now_ns()),
-                                                     std::memory_order_release);
+        applied_in_background = app_in_background;
 
         if (hwnd != nullptr) {
             if (settings::g_mainTabSettings.clip_cursor_enabled.GetValue()) {
@@ -180,6 +221,12 @@ void check_is_background() {
             }
         }
     }
+}
+
+// High-frequency window auto-fix (runs independently of foreground changes).
+void apply_window_auto_fix() {
+    CALL_GUARD_NO_TS();
+    HWND hwnd = g_last_swapchain_hwnd.load();
 
     // Apply window changes - the function will automatically determine what needs to be changed
     // Skip if suppress_window_changes is enabled (compatibility feature), or if window mode does not imply resize
@@ -604,131 +651,354 @@ void StuckCheckWatchdogThread() {
 
 }  // namespace
 
+namespace {
+
+// Auto-reset event the monitoring thread waits on between scheduled tasks; created once, lives for the process.
+HANDLE g_monitoring_wake_event = nullptr;
+// Bit per continuous_monitoring::MonitoringTask requested by other threads.
+std::atomic<uint32_t> g_pending_task_requests{0};
+std::atomic<std::shared_ptr<const continuous_monitoring::MonitoringSchedulerStats>> g_scheduler_stats{nullptr};
+
+// Longest single wait, so the stuck-check timestamp and the shutdown flag are refreshed regularly.
+constexpr LONGLONG kMonitorMaxWaitNs = 1 * utils::SEC_TO_NS;
+// Tasks that touch game/window state start after this delay (as before the scheduler).
+constexpr LONGLONG kMonitorWarmupNs = 1 * utils::SEC_TO_NS;
+
+int64_t MonitoringClockNs() { return static_cast<int64_t>(utils::get_now_ns()); }
+
+}  // namespace
+
+namespace continuous_monitoring {
+
+void RequestTaskRun(MonitoringTask task) {
+    if (task >= MonitoringTask::kCount) {
+        return;
+    }
+    g_pending_task_requests.fetch_or(1u << static_cast<uint32_t>(task), std::memory_order_acq_rel);
+    if (g_monitoring_wake_event != nullptr) {
+        SetEvent(g_monitoring_wake_event);
+    }
+}
+
+std::shared_ptr<const MonitoringSchedulerStats> GetSchedulerStats() {
+    return g_scheduler_stats.load(std::memory_order_acquire);
+}
+
+}  // namespace continuous_monitoring
+
 // Main monitoring thread function
+// Work is registered as timer-wheel tasks; the thread sleeps until the earliest deadline (or a RequestTaskRun wake)
+// instead of polling every 8 ms.
 void ContinuousMonitoringThread() {
     CALL_GUARD_NO_TS();
     LogInfo("Continuous monitoring thread started");
 
-    auto start_time = utils::get_now_ns();
-    LONGLONG last_cache_refresh_ns = start_time;
-    LONGLONG last_60fps_update_ns = start_time;
-    LONGLONG last_1s_update_ns = start_time;
+    using continuous_monitoring::MonitoringTask;
+    using utils::TimerWheelScheduler;
+
+    const int64_t start_time = MonitoringClockNs();
+    TimerWheelScheduler scheduler(start_time, &MonitoringClockNs);
+    scheduler.SetTaskObserver(&display_commander::feature::trace::TraceMonitoringTask);
+    TimerWheelScheduler::TaskId request_task_ids[static_cast<size_t>(MonitoringTask::kCount)];
+    std::fill(std::begin(request_task_ids), std::end(request_task_ids), TimerWheelScheduler::kInvalidTask);
+    TimerWheelScheduler::TaskId enumerate_task = TimerWheelScheduler::kInvalidTask;
+    TimerWheelScheduler::TaskId reflex_latency_task = TimerWheelScheduler::kInvalidTask;
+    int64_t reflex_latency_period_ns = 0;
+    TimerWheelScheduler::TaskId frame_batch_task = TimerWheelScheduler::kInvalidTask;
+    TimerWheelScheduler::TaskId pclstats_drain_task = TimerWheelScheduler::kInvalidTask;
+    int64_t pclstats_drain_period_ns = 0;
+    int64_t keyboard_period_ns = 0;
+    int enumerate_after_10s_count = 0;
+
+    const int64_t high_freq_interval_ns = static_cast<int64_t>(kMonitorHighFreqIntervalMs) * utils::NS_TO_MS;
+    const int64_t per_second_interval_ns = static_cast<int64_t>(kMonitorPerSecondIntervalSec) * utils::SEC_TO_NS;
+
+    // When no swapchain window is set (e.g. no-ReShade mode), infer game window from foreground. Foreground changes
+    // also run it through background_check; this poll covers the warmup and a missed push.
+    scheduler.AddPeriodic(
+        "game_window_from_foreground", static_cast<int64_t>(kMonitorForegroundPollIntervalMs) * utils::NS_TO_MS,
+        [] {
+            g_continuous_monitoring_section.store("game_window_from_foreground", std::memory_order_release);
+            TrySetGameWindowFromForeground();
+        },
+        0);
+
+    // Periodic display cache refresh off the UI thread
+    if (kMonitorDisplayCache) {
+        request_task_ids[static_cast<size_t>(MonitoringTask::kDisplayCacheRefresh)] = scheduler.AddPeriodic(
+            "display_cache_refresh", static_cast<int64_t>(kMonitorDisplayCacheIntervalSec) * utils::SEC_TO_NS, [] {
+                CALL_GUARD_NO_TS();
+                g_continuous_monitoring_section.store("display_cache_refresh", std::memory_order_release);
+                display_cache::g_displayCache.Refresh();
+            });
+    }
 
-    while (g_monitoring_thread_running.load()) {
-        const bool high_freq_enabled = kMonitorHighFreqEnabled;
-        const int high_freq_ms = kMonitorHighFreqIntervalMs;
-        const LONGLONG sleep_ns = high_freq_enabled ? (static_cast<LONGLONG>(high_freq_ms) * 1000000)
-                                                    : (50 * 1000000);  // 50 ms when high-freq disabled
-        g_continuous_monitoring_section.store("sleeping", std::memory_order_release);
-        std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
-        CALL_GUARD_NO_TS();
-        LONGLONG loop_time_ns = utils::get_real_time_ns();
-        g_last_continuous_monitoring_loop_real_ns.store(loop_time_ns, std::memory_order_release);
-        g_continuous_monitoring_section.store("after_sleep", std::memory_order_release);
+    // Event-driven updates with safety-net polls (background check, window auto-fix, keyboard, hotkeys) and
+    // frame-rate driven consumers
+    if (kMonitorHighFreqEnabled) {
+        // Foreground changes are pushed (RequestTaskRun); this period is only the safety-net poll.
+        request_task_ids[static_cast<size_t>(MonitoringTask::kBackgroundCheck)] = scheduler.AddPeriodic(
+            "background_check", static_cast<int64_t>(kMonitorForegroundPollIntervalMs) * utils::NS_TO_MS,
+            [] {
+                CALL_GUARD_NO_TS();
+                g_continuous_monitoring_section.store("background_check", std::memory_order_release);
+                TrySetGameWindowFromForeground();
+                check_is_background();
+            },
+            kMonitorWarmupNs);
+
+        request_task_ids[static_cast<size_t>(MonitoringTask::kWindowAutoFix)] = scheduler.AddPeriodic(
+            "window_auto_fix", static_cast<int64_t>(kMonitorWindowAutoFixPollIntervalMs) * utils::NS_TO_MS,
+            [] {
+                CALL_GUARD_NO_TS();
+                g_continuous_monitoring_section.store("window_auto_fix", std::memory_order_release);
+                apply_window_auto_fix();
+                // Delay ADHD init/SetEnabled until frame 500 to avoid early-present issues
+                if (g_global_frame_id.load(std::memory_order_acquire) >= 500) {
+                    adhd_multi_monitor::api::SetEnabled(
+                        settings::g_mainTabSettings.adhd_single_monitor_enabled_for_game_display.GetValue(),
+                        settings::g_mainTabSettings.adhd_multi_monitor_enabled.GetValue());
+                }
+            },
+            kMonitorWarmupNs);
+
+        // Key downs request a run; the period is the poll rate only until key events reach the hooks.
+        keyboard_period_ns = high_freq_interval_ns;
+        request_task_ids[static_cast<size_t>(MonitoringTask::kKeyboardHotkeys)] = scheduler.AddPeriodic(
+            "keyboard_hotkeys", keyboard_period_ns,
+            [&scheduler, &request_task_ids, &keyboard_period_ns, high_freq_interval_ns] {
+                CALL_GUARD_NO_TS();
+                g_continuous_monitoring_section.store("keyboard_hotkeys", std::memory_order_release);
+                // Update keyboard tracking system
+                display_commanderhooks::keyboard_tracker::Update();
 
-        // Hold shared lock for entire loop body so FreeLibrary_Detour can wait (exclusive) until we sleep again
-        utils::SRWLockShared loop_lock(utils::g_continuous_monitoring_loop_lock);
+                // Handle keyboard shortcuts
+                HandleKeyboardShortcuts();
+
+                // Input blocking may have been toggled (hotkey, settings, XInput detection window)
+                display_commanderhooks::RefreshMessageSuppressionFilter();
 
-        // When no swapchain window is set (e.g. no-ReShade mode), infer game window from foreground
-        TrySetGameWindowFromForeground();
-
-        // Periodic display cache refresh off the UI thread
-        {
-            CALL_GUARD_NO_TS();
-            LONGLONG now_ns = utils::get_now_ns();
-            if (kMonitorDisplayCache) {
-                const int cache_interval_sec = kMonitorDisplayCacheIntervalSec;
-                if (now_ns - last_cache_refresh_ns >= static_cast<LONGLONG>(cache_interval_sec) * utils::SEC_TO_NS) {
-                    g_continuous_monitoring_section.store("display_cache_refresh", std::memory_order_release);
-                    display_cache::g_displayCache.Refresh();
-                    last_cache_refresh_ns = now_ns;
+                // Reset keyboard frame states for next frame
+                display_commanderhooks::keyboard_tracker::ResetFrame();
+
+                const int64_t period_ns =
+                    display_commanderhooks::keyboard_tracker::GetUpdateIntervalNs(high_freq_interval_ns);
+                if (period_ns != keyboard_period_ns) {
+                    keyboard_period_ns = period_ns;
+                    scheduler.SetPeriod(request_task_ids[static_cast<size_t>(MonitoringTask::kKeyboardHotkeys)],
+                                        period_ns, MonitoringClockNs());
                 }
-            }
-            g_continuous_monitoring_section.store("after_cache_refresh", std::memory_order_release);
-        }
-        // Wait for 1 second to start
-        if (utils::get_now_ns() - start_time < 1 * utils::SEC_TO_NS) {
-            continue;
+            },
+            kMonitorWarmupNs);
+
+        scheduler.AddPeriodic(
+            "cpu_telemetry", static_cast<int64_t>(kMonitorCpuTelemetryIntervalMs) * utils::NS_TO_MS,
+            [] {
+                g_continuous_monitoring_section.store("cpu_telemetry", std::memory_order_release);
+                display_commander::feature::cpu_telemetry::ProcessCpuLoadRequestsInContinuousMonitoring();
+            },
+            kMonitorWarmupNs);
+
+        // One pass over the new frames for all frame timeline consumers; the period follows the frame rate
+        // (kMonitorFrameBatchFrames per pass): 100 ms up to 160 FPS, 8 ms only from 2000 FPS.
+        struct FrameBatchState {
+            int64_t period_ns = 0;
+            uint64_t last_frame_id = 0;
+            int64_t last_run_ns = 0;
+        };
+        auto frame_batch = std::make_shared<FrameBatchState>();
+        frame_batch->period_ns = static_cast<int64_t>(kMonitorFrameBatchMaxIntervalMs) * utils::NS_TO_MS;
+        frame_batch_task = scheduler.AddPeriodic(
+            "frame_timeline_consumers", frame_batch->period_ns,
+            [&scheduler, &frame_batch_task, frame_batch, high_freq_interval_ns] {
+                g_continuous_monitoring_section.store("frame_bound", std::memory_order_release);
+                display_commander::feature::frame_bound::ProcessFrameBoundAnalysisInContinuousMonitoring();
+                g_continuous_monitoring_section.store("input_latency", std::memory_order_release);
+                display_commander::feature::input_latency::ProcessInputLatencyInContinuousMonitoring();
+                g_continuous_monitoring_section.store("latency_estimate", std::memory_order_release);
+                display_commander::feature::latency_estimate::ProcessLatencyEstimateInContinuousMonitoring();
+
+                const int64_t now_ns = MonitoringClockNs();
+                const uint64_t frame_id = g_global_frame_id.load(std::memory_order_acquire);
+                const uint64_t frames = frame_id - frame_batch->last_frame_id;
+                const int64_t elapsed_ns = now_ns - frame_batch->last_run_ns;
+                const bool measured = frame_batch->last_run_ns != 0 && frame_id > frame_batch->last_frame_id;
+                frame_batch->last_frame_id = frame_id;
+                frame_batch->last_run_ns = now_ns;
+                if (!measured) {
+                    return;
+                }
+                const int64_t max_period_ns = static_cast<int64_t>(kMonitorFrameBatchMaxIntervalMs) * utils::NS_TO_MS;
+                const int64_t period_ns =
+                    (std::clamp)(static_cast<int64_t>(static_cast<uint64_t>(elapsed_ns) * kMonitorFrameBatchFrames
+                                                      / frames),
+                                 high_freq_interval_ns, max_period_ns);
+                // Only follow real frame rate changes, not frame-to-frame jitter
+                if (period_ns < frame_batch->period_ns * 4 / 5 || period_ns > frame_batch->period_ns * 5 / 4) {
+                    frame_batch->period_ns = period_ns;
+                    scheduler.SetPeriod(frame_batch_task, period_ns, now_ns);
+                }
+            },
+            kMonitorWarmupNs);
+
+        if (kMonitorPclStatsEtwDrain) {
+            // Markers feed the latency marker bus, so the drain keeps the high-frequency rate while a foreign
+            // PCLStats provider writes events (per-thread rings hold 256 writes, ~25 frames of markers).
+            pclstats_drain_period_ns = static_cast<int64_t>(kMonitorPclStatsIdleIntervalMs) * utils::NS_TO_MS;
+            pclstats_drain_task = scheduler.AddPeriodic(
+                "pclstats_etw_drain", pclstats_drain_period_ns,
+                [&scheduler, &pclstats_drain_task, &pclstats_drain_period_ns, high_freq_interval_ns] {
+                    g_continuous_monitoring_section.store("pclstats_etw_drain", std::memory_order_release);
+                    DrainPclStatsEtwEvents();
+                    const int64_t period_ns =
+                        PclStatsForeignInitObserved()
+                            ? high_freq_interval_ns
+                            : static_cast<int64_t>(kMonitorPclStatsIdleIntervalMs) * utils::NS_TO_MS;
+                    if (period_ns != pclstats_drain_period_ns) {
+                        pclstats_drain_period_ns = period_ns;
+                        scheduler.SetPeriod(pclstats_drain_task, period_ns, MonitoringClockNs());
+                    }
+                },
+                0);
         }
+    }
 
-        // High-frequency updates (background check, ADHD, keyboard, hotkeys)
-        LONGLONG now_ns = utils::get_now_ns();
-        const LONGLONG high_freq_interval_ns = static_cast<LONGLONG>(kMonitorHighFreqIntervalMs) * utils::NS_TO_MS;
-        if (kMonitorHighFreqEnabled && now_ns - last_60fps_update_ns >= high_freq_interval_ns) {
-            CALL_GUARD_NO_TS();
-            g_continuous_monitoring_section.store("60fps_block", std::memory_order_release);
-            check_is_background();
-            last_60fps_update_ns = now_ns;
-            // Delay ADHD init/SetEnabled until frame 500 to avoid early-present issues
-            if (g_global_frame_id.load(std::memory_order_acquire) >= 500) {
-                adhd_multi_monitor::api::SetEnabled(
-                    settings::g_mainTabSettings.adhd_single_monitor_enabled_for_game_display.GetValue(),
-                    settings::g_mainTabSettings.adhd_multi_monitor_enabled.GetValue());
-            }
+    if (kMonitorPerSecondEnabled) {
+        scheduler.AddPeriodic(
+            "every1s_tasks", per_second_interval_ns,
+            [] {
+                CALL_GUARD_NO_TS();
+                g_continuous_monitoring_section.store("every1s_tasks", std::memory_order_release);
+                every1s_tasks();
 
-            // Update keyboard tracking system
-            display_commanderhooks::keyboard_tracker::Update();
+                if (kMonitorExclusiveKeyGroups) {
+                    CALL_GUARD_NO_TS();
+                    g_continuous_monitoring_section.store("exclusive_key_groups", std::memory_order_release);
+                    display_commanderhooks::exclusive_key_groups::UpdateCachedActiveKeys();
+                }
+            },
+            kMonitorWarmupNs);
+
+        // Re-enumerate loaded modules 6 times, every 10s (at 10s, 20s, 30s, 40s, 50s, 60s). Catches modules
+        // loaded via paths EnumProcessModules misses at init, e.g. NvLowLatencyVk.dll.
+        constexpr int kEnumerateRuns = 6;
+        constexpr int64_t kEnumerateIntervalNs = 10 * utils::SEC_TO_NS;
+        enumerate_task = scheduler.AddPeriodic(
+            "enumerate_loaded_modules_10s", kEnumerateIntervalNs,
+            [&scheduler, &enumerate_task, &enumerate_after_10s_count, start_time] {
+                CALL_GUARD_NO_TS();
+                g_continuous_monitoring_section.store("enumerate_loaded_modules_10s", std::memory_order_release);
+                enumerate_after_10s_count++;
+                if (display_commanderhooks::EnumerateLoadedModules(true)) {  // modules loaded late without us noticing
+                    LogInfo("Continuous monitoring: EnumerateLoadedModules run %d/6 (at %lld s) completed",
+                            enumerate_after_10s_count, (MonitoringClockNs() - start_time) / utils::SEC_TO_NS);
+                } else {
+                    LogError("Continuous monitoring: EnumerateLoadedModules run %d/6 failed",
+                             enumerate_after_10s_count);
+                }
+                if (enumerate_after_10s_count >= kEnumerateRuns) {
+                    scheduler.Cancel(enumerate_task);
+                }
+            });
+
+        if (kMonitorReflexAutoConfigure) {
+            scheduler.AddPeriodic(
+                "reflex_auto_configure", per_second_interval_ns,
+                [] {
+                    CALL_GUARD_NO_TS();
+                    g_continuous_monitoring_section.store("reflex_auto_configure", std::memory_order_release);
+                    HandleReflexAutoConfigure();
+                },
+                10 * utils::SEC_TO_NS);
+        }
 
-            // Handle keyboard shortcuts
-            HandleKeyboardShortcuts();
+        if (kMonitorReflexLatencyHistory) {
+            // NVAPI keeps only the last 64 frame reports: the poll period follows the frame rate
+            reflex_latency_period_ns = per_second_interval_ns;
+            reflex_latency_task = scheduler.AddPeriodic(
+                "reflex_latency_history", reflex_latency_period_ns,
+                [&scheduler, &reflex_latency_task, &reflex_latency_period_ns] {
+                    CALL_GUARD_NO_TS();
+                    g_continuous_monitoring_section.store("reflex_latency_history", std::memory_order_release);
+                    const int64_t next_poll_ns =
+                        display_commander::feature::reflex_latency::ProcessReflexLatencyInContinuousMonitoring();
+                    // Only follow real frame rate changes, not frame-to-frame jitter
+                    if (next_poll_ns < reflex_latency_period_ns * 4 / 5
+                        || next_poll_ns > reflex_latency_period_ns * 5 / 4) {
+                        reflex_latency_period_ns = next_poll_ns;
+                        scheduler.SetPeriod(reflex_latency_task, next_poll_ns, MonitoringClockNs());
+                    }
+                },
+                kMonitorWarmupNs);
+        }
 
-            // Reset keyboard frame states for next frame
-            display_commanderhooks::keyboard_tracker::ResetFrame();
+        // Publish scheduler accounting for the debug UI
+        struct PublishState {
+            uint64_t last_wakeups = 0;
+            int64_t last_publish_ns = 0;
+        };
+        auto publish_state = std::make_shared<PublishState>();
+        publish_state->last_publish_ns = start_time;
+        scheduler.AddPeriodic(
+            "publish_scheduler_stats", per_second_interval_ns,
+            [&scheduler, publish_state] {
+                const int64_t now_ns = MonitoringClockNs();
+                auto stats = std::make_shared<continuous_monitoring::MonitoringSchedulerStats>();
+                stats->tasks = scheduler.GetStats();
+                stats->wakeups = scheduler.GetWakeupCount();
+                const int64_t elapsed_ns = now_ns - publish_state->last_publish_ns;
+                if (elapsed_ns > 0) {
+                    stats->wakeups_per_sec = static_cast<double>(stats->wakeups - publish_state->last_wakeups)
+                                             * static_cast<double>(utils::SEC_TO_NS) / static_cast<double>(elapsed_ns);
+                }
+                publish_state->last_wakeups = stats->wakeups;
+                publish_state->last_publish_ns = now_ns;
+                g_scheduler_stats.store(std::shared_ptr<const continuous_monitoring::MonitoringSchedulerStats>(
+                                            std::move(stats)),
+                                        std::memory_order_release);
+            });
+    }
 
-            display_commander::feature::cpu_telemetry::ProcessCpuLoadRequestsInContinuousMonitoring();
+    while (g_monitoring_thread_running.load()) {
+        g_continuous_monitoring_section.store("sleeping", std::memory_order_release);
+        const int64_t wait_start_ns = MonitoringClockNs();
+        const int64_t wake_ns = continuous_monitoring::MonitorWakeTimeNs(
+            scheduler.NextDeadlineNs(), wait_start_ns, g_pending_task_requests.load(std::memory_order_acquire) != 0,
+            start_time + kMonitorWarmupNs);
+        if (wake_ns > wait_start_ns) {
+            const int64_t wait_ns = (std::min)(wake_ns - wait_start_ns, kMonitorMaxWaitNs);
+            const DWORD wait_ms = static_cast<DWORD>((wait_ns + utils::NS_TO_MS - 1) / utils::NS_TO_MS);
+            WaitForSingleObject(g_monitoring_wake_event, wait_ms);
         }
-        g_continuous_monitoring_section.store("after_60fps", std::memory_order_release);
-
-        const int per_second_interval_sec = kMonitorPerSecondIntervalSec;
-        if (kMonitorPerSecondEnabled
-            && now_ns - last_1s_update_ns >= static_cast<LONGLONG>(per_second_interval_sec) * utils::SEC_TO_NS) {
-            CALL_GUARD_NO_TS();
-            last_1s_update_ns = now_ns;
-            check_is_background();
-            g_continuous_monitoring_section.store("every1s_tasks", std::memory_order_release);
-            every1s_tasks();
-
-            if (kMonitorExclusiveKeyGroups) {
-                CALL_GUARD_NO_TS();
-                g_continuous_monitoring_section.store("exclusive_key_groups", std::memory_order_release);
-                display_commanderhooks::exclusive_key_groups::UpdateCachedActiveKeys();
-            }
+        if (!g_monitoring_thread_running.load()) {
+            break;
+        }
+        CALL_GUARD_NO_TS();
+        scheduler.NoteWakeup();
+        LONGLONG loop_time_ns = utils::get_real_time_ns();
+        g_last_continuous_monitoring_loop_real_ns.store(loop_time_ns, std::memory_order_release);
+        g_continuous_monitoring_section.store("after_sleep", std::memory_order_release);
 
-            // Re-enumerate loaded modules 6 times, every 10s (at 10s, 20s, 30s, 40s, 50s, 60s). Catches modules
-            // loaded via paths EnumProcessModules misses at init, e.g. NvLowLatencyVk.dll.
-            CALL_GUARD_NO_TS();
-            g_continuous_monitoring_section.store("enumerate_loaded_modules_10s", std::memory_order_release);
-            {
-                static int enumerate_after_10s_count = 0;
-                constexpr int kEnumerateRuns = 6;
-                constexpr LONGLONG kIntervalNs = 10 * utils::SEC_TO_NS;
-                if (enumerate_after_10s_count < kEnumerateRuns) {
-                    LONGLONG elapsed_ns = now_ns - start_time;
-                    LONGLONG next_run_at_ns = (enumerate_after_10s_count + 1) * kIntervalNs;
-                    if (elapsed_ns >= next_run_at_ns) {
-                        enumerate_after_10s_count++;
-                        if (display_commanderhooks::EnumerateLoadedModules(
-                                true)) {  // modules loaded late without us noticing
-                            LogInfo("Continuous monitoring: EnumerateLoadedModules run %d/6 (at %lld s) completed",
-                                    enumerate_after_10s_count, elapsed_ns / utils::SEC_TO_NS);
-                        } else {
-                            LogError("Continuous monitoring: EnumerateLoadedModules run %d/6 failed",
-                                     enumerate_after_10s_count);
-                        }
-                    }
-                }
-            }
+        // Hold shared lock for entire loop body so FreeLibrary_Detour can wait (exclusive) until we sleep again
+        utils::SRWLockShared loop_lock(utils::g_continuous_monitoring_loop_lock);
 
-            if (kMonitorReflexAutoConfigure && now_ns - start_time >= 10 * utils::SEC_TO_NS) {
-                CALL_GUARD_NO_TS();
-                g_continuous_monitoring_section.store("reflex_auto_configure", std::memory_order_release);
-                HandleReflexAutoConfigure();
+        const int64_t now_ns = MonitoringClockNs();
+        // Requests from other threads; kept pending during warmup so they run once tasks are started.
+        if (now_ns - start_time >= kMonitorWarmupNs) {
+            const uint32_t requests = g_pending_task_requests.exchange(0, std::memory_order_acq_rel);
+            for (size_t i = 0; i < static_cast<size_t>(MonitoringTask::kCount); ++i) {
+                if ((requests & (1u << i)) != 0 && request_task_ids[i] != TimerWheelScheduler::kInvalidTask) {
+                    scheduler.Trigger(request_task_ids[i]);
+                }
             }
         }
+        scheduler.RunDue(now_ns);
+
         g_continuous_monitoring_section.store("end_of_loop", std::memory_order_release);
         // loop_lock released here; next iteration we sleep then re-acquire
     }
 
+    g_scheduler_stats.store(nullptr, std::memory_order_release);
     LogInfo("Continuous monitoring thread stopped");
 }
 
@@ -741,6 +1011,10 @@ void StartContinuousMonitoring() {
     }
     g_monitoring_thread_running.store(true);
 
+    if (g_monitoring_wake_event == nullptr) {
+        g_monitoring_wake_event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    }
+
     // Start the monitoring thread
     if (g_monitoring_thread.joinable()) {
         LogInfo("[StartContinuousMonitoring] joining previous monitoring thread...");
@@ -751,6 +1025,8 @@ void StartContinuousMonitoring() {
     LogInfo("[StartContinuousMonitoring] starting ContinuousMonitoringThread");
     g_monitoring_thread = std::thread(ContinuousMonitoringThread);
 
+    display_commander::feature::foreground::StartForegroundEventHook();
+
     // Separate thread to call CheckStuckMethodsAndLogUndestroyedGuards so we can detect
     // if the main monitoring loop is stuck (watchdog runs independently).
     if (g_stuck_check_watchdog_thread.joinable()) {
@@ -769,6 +1045,11 @@ void StopContinuousMonitoring() {
     }
 
     g_monitoring_thread_running.store(false);
+    if (g_monitoring_wake_event != nullptr) {
+        SetEvent(g_monitoring_wake_event);
+    }
+
+    display_commander::feature::foreground::StopForegroundEventHook();
 
     // Wait for watchdog thread first (it only sleeps and checks; exits when flag is false)
     if (g_stuck_check_watchdog_thread.joinable()) {
@@ -0,0 +1,46 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#pragma once
+
+#include "utils/timer_wheel_scheduler.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace continuous_monitoring {
+
+// Tasks of the continuous monitoring thread that other threads may request to run immediately
+// (instead of waiting for their next scheduled tick).
+enum class MonitoringTask : uint8_t {
+    kBackgroundCheck = 0,  // Foreground/background detection
+    kDisplayCacheRefresh,  // display_cache::g_displayCache.Refresh()
+    kKeyboardHotkeys,      // keyboard_tracker update + hotkey processing
+    kWindowAutoFix,        // apply_window_auto_fix (game window moved / resized / restyled)
+    kCount
+};
+
+// Any thread: run task on the monitoring thread as soon as possible and wake it. No-op when the thread is not running.
+void RequestTaskRun(MonitoringTask task);
+
+// Monitoring thread: absolute time to wake for the next pass. Requests are held back until warmup_end_ns; while any
+// are pending the wait is clamped to the end of the warmup instead of being skipped (no busy loop during warmup).
+inline int64_t MonitorWakeTimeNs(int64_t next_deadline_ns, int64_t now_ns, bool requests_pending,
+                                 int64_t warmup_end_ns) {
+    if (!requests_pending) {
+        return next_deadline_ns;
+    }
+    return next_deadline_ns < warmup_end_ns ? next_deadline_ns : (warmup_end_ns > now_ns ? warmup_end_ns : now_ns);
+}
+
+// Snapshot of the scheduler, published by the monitoring thread about once per second.
+struct MonitoringSchedulerStats {
+    std::vector<utils::TimerWheelScheduler::TaskStats> tasks;
+    uint64_t wakeups = 0;
+    double wakeups_per_sec = 0.0;  // Over the last publish interval
+};
+
+// Latest published snapshot (nullptr until the monitoring thread has run for ~1 s).
+std::shared_ptr<const MonitoringSchedulerStats> GetSchedulerStats();
+
+}  // namespace continuous_monitoring
@@ -3,7 +3,11 @@
 #include "../globals.hpp"
 #include "../settings/main_tab_settings.hpp"
 #include "../utils.hpp"
+#include "../continuous_monitoring.hpp"
 #include "../utils/logging.hpp"
+#include "../utils/srwlock_registry.hpp"
+#include "../utils/srwlock_wrapper.hpp"
+#include "../utils/timing.hpp"
 
 #include <windows.h>
 #include <wingdi.h>
@@ -126,105 +130,210 @@ void EnumerateDisplayModes(HMONITOR monitor, std::vector<Resolution>& resolution
     }
 }
 
-bool DisplayCache::Initialize() { return Refresh(); }
+namespace {
 
-bool DisplayCache::Refresh() {
-    // Build a fresh cache snapshot locally (no locking, allows system calls)
-    std::vector<std::unique_ptr<DisplayInfo>> new_displays;
+// Cheap per-monitor state gathered by WindowsDisplayProbeBackend (index-aligned with the probes it returns).
+struct MonitorProbeData {
+    HMONITOR monitor = nullptr;
+    MONITORINFOEXW mi{};
+    int width = 0;
+    int height = 0;
+    RationalRefreshRate refresh_rate;
+    int x = 0;
+    int y = 0;
+};
+
+uint64_t FingerprintRect(uint64_t hash, const RECT& r) {
+    hash = FingerprintMix(hash, static_cast<uint64_t>(static_cast<uint32_t>(r.left)));
+    hash = FingerprintMix(hash, static_cast<uint64_t>(static_cast<uint32_t>(r.top)));
+    hash = FingerprintMix(hash, static_cast<uint64_t>(static_cast<uint32_t>(r.right)));
+    return FingerprintMix(hash, static_cast<uint64_t>(static_cast<uint32_t>(r.bottom)));
+}
 
-    // Query display configuration once for all monitors to avoid duplication
-    UINT32 path_count = 0, mode_count = 0;
-    if (GetDisplayConfigBufferSizes(QDC_ONLY_ACTIVE_PATHS, &path_count, &mode_count) != ERROR_SUCCESS) {
-        LogError("DisplayCache: Failed to get display config buffer sizes");
-        return false;
-    }
+// EnumDisplayMonitors + one QueryDisplayConfig; no DXGI, no per-monitor device name queries.
+class WindowsDisplayProbeBackend : public IDisplayProbeBackend {
+   public:
+    bool Probe(std::vector<DisplayProbe>& out) override {
+        out.clear();
+        data_.clear();
+
+        // Query display configuration once for all monitors to avoid duplication
+        UINT32 path_count = 0, mode_count = 0;
+        if (GetDisplayConfigBufferSizes(QDC_ONLY_ACTIVE_PATHS, &path_count, &mode_count) != ERROR_SUCCESS) {
+            LogError("DisplayCache: Failed to get display config buffer sizes");
+            return false;
+        }
 
-    if (path_count == 0 || mode_count == 0) {
-        LogError("DisplayCache: No active display paths or modes found");
-        return false;
-    }
+        if (path_count == 0 || mode_count == 0) {
+            LogError("DisplayCache: No active display paths or modes found");
+            return false;
+        }
 
-    std::vector<DISPLAYCONFIG_PATH_INFO> paths(path_count);
-    std::vector<DISPLAYCONFIG_MODE_INFO> modes(mode_count);
+        std::vector<DISPLAYCONFIG_PATH_INFO> paths(path_count);
+        std::vector<DISPLAYCONFIG_MODE_INFO> modes(mode_count);
 
-    if (QueryDisplayConfig(QDC_ONLY_ACTIVE_PATHS, &path_count, paths.data(), &mode_count, modes.data(), nullptr)
-        != ERROR_SUCCESS) {
-        LogError("DisplayCache: Failed to query display configuration");
-        return false;
-    }
+        if (QueryDisplayConfig(QDC_ONLY_ACTIVE_PATHS, &path_count, paths.data(), &mode_count, modes.data(), nullptr)
+            != ERROR_SUCCESS) {
+            LogError("DisplayCache: Failed to query display configuration");
+            return false;
+        }
+        paths.resize(path_count);
+        modes.resize(mode_count);
+
+        // Enumerate all monitors
+        std::vector<HMONITOR> monitors;
+        EnumDisplayMonitors(
+            nullptr, nullptr,
+            [](HMONITOR hmon, HDC, LPRECT, LPARAM lparam) -> BOOL {
+                auto* monitors_ptr = reinterpret_cast<std::vector<HMONITOR>*>(lparam);
+                monitors_ptr->push_back(hmon);
+                return TRUE;
+            },
+            reinterpret_cast<LPARAM>(&monitors));
+        if (monitors.empty()) {
+            LogError("DisplayCache: No monitors found");
+            return false;
+        }
 
-    // Enumerate all monitors
-    std::vector<HMONITOR> monitors;
-    EnumDisplayMonitors(
-        nullptr, nullptr,
-        [](HMONITOR hmon, HDC, LPRECT, LPARAM lparam) -> BOOL {
-            auto* monitors_ptr = reinterpret_cast<std::vector<HMONITOR>*>(lparam);
-            monitors_ptr->push_back(hmon);
-            return TRUE;
-        },
-        reinterpret_cast<LPARAM>(&monitors));
-    if (monitors.empty()) {
-        LogError("DisplayCache: No monitors found");
-        return false;
+        static bool first_time_log = true;
+        for (HMONITOR monitor : monitors) {
+            MonitorProbeData d;
+            d.monitor = monitor;
+            d.mi.cbSize = sizeof(d.mi);
+            if (!GetMonitorInfoW(monitor, &d.mi)) {
+                continue;
+            }
+            // Get current settings
+            uint64_t monitor_identity = 0;
+            if (!GetCurrentDisplaySettingsQueryConfig(monitor, d.width, d.height, d.refresh_rate.numerator,
+                                                      d.refresh_rate.denominator, d.x, d.y, first_time_log, paths,
+                                                      modes, &monitor_identity)) {
+                continue;
+            }
+
+            DisplayProbe probe;
+            probe.device_name = d.mi.szDevice;
+
+            // Device name + connected monitor + mode: what the expensive enumeration (name, mode list) depends on
+            uint64_t h = FingerprintString(kFingerprintSeed, probe.device_name);
+            h = FingerprintMix(h, monitor_identity);
+            h = FingerprintMix(h, (static_cast<uint64_t>(static_cast<uint32_t>(d.width)) << 32)
+                                      | static_cast<uint32_t>(d.height));
+            h = FingerprintMix(h, (static_cast<uint64_t>(d.refresh_rate.numerator) << 32)
+                                      | d.refresh_rate.denominator);
+            h = FingerprintMix(h, (static_cast<uint64_t>(static_cast<uint32_t>(d.x)) << 32)
+                                      | static_cast<uint32_t>(d.y));
+            probe.fingerprint = h;
+
+            uint64_t a = FingerprintMix(kFingerprintSeed, reinterpret_cast<uintptr_t>(monitor));
+            a = FingerprintRect(a, d.mi.rcMonitor);
+            a = FingerprintRect(a, d.mi.rcWork);
+            probe.attributes = FingerprintMix(a, d.mi.dwFlags);
+            out.push_back(std::move(probe));
+            data_.push_back(d);
+        }
+        first_time_log = false;
+        return !out.empty();
     }
 
-    static bool first_time_log = true;
+    const MonitorProbeData& Data(size_t index) const { return data_[index]; }
 
-    auto old_displays = displays.load(std::memory_order_acquire);
+   private:
+    std::vector<MonitorProbeData> data_;
+};
 
-    // Process each monitor
-    for (HMONITOR monitor : monitors) {
-        auto display_info = std::make_unique<DisplayInfo>();
-        display_info->monitor_handle = monitor;
+// Full (expensive) enumeration of one display: friendly name (QueryDisplayConfig device names) + DXGI mode list.
+std::shared_ptr<const DisplayInfo> BuildDisplayInfo(const MonitorProbeData& d) {
+    auto display_info = std::make_shared<DisplayInfo>();
+    display_info->monitor_handle = d.monitor;
+    MONITORINFOEXW mi = d.mi;
+    display_info->simple_device_id = mi.szDevice;
+    display_info->friendly_name = GetMonitorFriendlyName(mi);
 
-        // Get monitor information
-        MONITORINFOEXW mi;
-        mi.cbSize = sizeof(mi);
-        if (!GetMonitorInfoW(monitor, &mi)) {
-            continue;
-        }
+    // Store monitor properties from MONITORINFOEXW
+    display_info->is_primary = (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
+    display_info->monitor_rect = mi.rcMonitor;
+    display_info->work_rect = mi.rcWork;
 
-        display_info->simple_device_id = mi.szDevice;
-        display_info->friendly_name = GetMonitorFriendlyName(mi);
+    display_info->width = d.width;
+    display_info->height = d.height;
+    display_info->current_refresh_rate = d.refresh_rate;
+    display_info->x = d.x;
+    display_info->y = d.y;
 
-        // Store monitor properties from MONITORINFOEXW
-        display_info->is_primary = (mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
-        display_info->monitor_rect = mi.rcMonitor;
-        display_info->work_rect = mi.rcWork;
+    // Enumerate resolutions and refresh rates (uses DXGI - may block on D3D9 process)
+    EnumerateDisplayModes(d.monitor, display_info->resolutions);
 
-        // Get current settings
-        if (!GetCurrentDisplaySettingsQueryConfig(monitor, display_info->width, display_info->height,
-                                                  display_info->current_refresh_rate.numerator,
-                                                  display_info->current_refresh_rate.denominator, display_info->x,
-                                                  display_info->y, first_time_log, paths, modes)) {
-            continue;
-        }
+    // Sort resolutions
+    std::sort(display_info->resolutions.begin(), display_info->resolutions.end());
+    return display_info;
+}
 
-        for (const auto& old_display_info : *old_displays) {
-            if (old_display_info->simple_device_id == display_info->simple_device_id) {
-                display_info->resolutions = old_display_info->resolutions;
-            }
-        }
+// Same monitor and mode, new handle / work area / flags: copy the entry without re-enumerating modes.
+std::shared_ptr<const DisplayInfo> UpdateDisplayInfo(const MonitorProbeData& d, const DisplayInfo& previous) {
+    auto display_info = std::make_shared<DisplayInfo>(previous);
+    display_info->monitor_handle = d.monitor;
+    display_info->is_primary = (d.mi.dwFlags & MONITORINFOF_PRIMARY) != 0;
+    display_info->monitor_rect = d.mi.rcMonitor;
+    display_info->work_rect = d.mi.rcWork;
+    return display_info;
+}
 
-        if (display_info->resolutions.empty()) {  // only update resolutions if they are not already set
-            // Enumerate resolutions and refresh rates (uses DXGI - may block on D3D9 process)
-            EnumerateDisplayModes(monitor, display_info->resolutions);
+}  // namespace
 
-            // Sort resolutions
-            std::sort(display_info->resolutions.begin(), display_info->resolutions.end());
-        }
+bool DisplayCache::Initialize() { return Refresh(); }
 
-        // Add to snapshot
-        new_displays.push_back(std::move(display_info));
+bool DisplayCache::Refresh(bool force_full) {
+    // Serialize refreshes (monitoring thread, init paths); readers never block, they load the published snapshot.
+    utils::SRWLockExclusive refresh_lock(utils::g_display_cache_refresh_lock);
+    const LONGLONG start_ns = utils::get_now_ns();
+    const bool full = full_refresh_requested.exchange(false, std::memory_order_acq_rel) || force_full;
+
+    WindowsDisplayProbeBackend backend;
+    std::vector<DisplayProbe> probes;
+    if (!backend.Probe(probes)) {
+        return false;
     }
-    first_time_log = false;
+    stat_refreshes.fetch_add(1, std::memory_order_relaxed);
 
-    // Atomically swap the new displays data
-    displays.store(std::make_shared<std::vector<std::unique_ptr<DisplayInfo>>>(std::move(new_displays)),
-                   std::memory_order_release);
-    is_initialized.store(true, std::memory_order_release);
+    auto previous = snapshot.load(std::memory_order_acquire);
+    const bool first_publish = !is_initialized.load(std::memory_order_acquire);
+    DisplayDiffStats diff;
+    auto next = BuildIncrementalDisplaySnapshot<DisplayInfo>(
+        first_publish ? nullptr : previous.get(), probes, full,
+        [&backend](size_t index) { return BuildDisplayInfo(backend.Data(index)); },
+        [&backend](size_t index, const DisplayInfo& previous_info) {
+            return UpdateDisplayInfo(backend.Data(index), previous_info);
+        },
+        &diff);
 
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    const int64_t elapsed_us = static_cast<int64_t>((utils::get_now_ns() - start_ns) / 1000);
+    stat_last_refresh_us.store(elapsed_us, std::memory_order_relaxed);
+    if (elapsed_us > stat_max_refresh_us.load(std::memory_order_relaxed)) {
+        stat_max_refresh_us.store(elapsed_us, std::memory_order_relaxed);
+    }
+
+    // Nothing changed: keep the published snapshot (and DisplayInfo pointers handed out from it)
+    if (next != nullptr) {
+        stat_published.fetch_add(1, std::memory_order_relaxed);
+        stat_displays_enumerated.fetch_add(diff.changed + diff.added, std::memory_order_relaxed);
+        if (full) {
+            stat_full_refreshes.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!first_publish) {
+            LogInfo(
+                "DisplayCache: display change (unchanged %zu, updated %zu, changed %zu, added %zu, removed %zu%s) in "
+                "%lld us",
+                diff.unchanged, diff.updated, diff.changed, diff.added, diff.removed, full ? ", full" : "",
+                static_cast<long long>(elapsed_us));
+        }
+
+        // Atomically swap the new displays data
+        snapshot.store(next, std::memory_order_release);
+        is_initialized.store(true, std::memory_order_release);
+    }
+
+    auto displays_ptr = GetDisplays();
     // Helper: true if device_id matches a current display (extended or simple ID)
     auto is_known_display_id = [this, &displays_ptr](const std::string& device_id) -> bool {
         if (device_id.empty() || device_id == "No Window" || device_id == "No Monitor"
@@ -267,7 +376,7 @@ bool DisplayCache::Refresh() {
 }
 
 const DisplayInfo* DisplayCache::GetDisplayByHandle(HMONITOR monitor) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr) return nullptr;
 
     for (const auto& display : *displays_ptr) {
@@ -279,7 +388,7 @@ const DisplayInfo* DisplayCache::GetDisplayByHandle(HMONITOR monitor) const {
 }
 
 const DisplayInfo* DisplayCache::GetDisplayByDeviceName(const std::wstring& device_name) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr) return nullptr;
 
     for (const auto& display : *displays_ptr) {
@@ -291,7 +400,7 @@ const DisplayInfo* DisplayCache::GetDisplayByDeviceName(const std::wstring& devi
 }
 
 int DisplayCache::GetDisplayIndexByDeviceName(const std::string& device_name) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr) return -1;
 
     // Convert string to wstring for comparison
@@ -307,7 +416,7 @@ int DisplayCache::GetDisplayIndexByDeviceName(const std::string& device_name) co
 }
 
 std::vector<std::string> DisplayCache::GetResolutionLabels(size_t display_index) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || display_index >= displays_ptr->size()) return {};
     const auto* display = (*displays_ptr)[display_index].get();
     if (!display) return {};
@@ -315,7 +424,7 @@ std::vector<std::string> DisplayCache::GetResolutionLabels(size_t display_index)
 }
 
 std::vector<std::string> DisplayCache::GetRefreshRateLabels(size_t display_index, size_t resolution_index) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || display_index >= displays_ptr->size()) return {};
     const auto* display = (*displays_ptr)[display_index].get();
     if (!display) return {};
@@ -323,7 +432,7 @@ std::vector<std::string> DisplayCache::GetRefreshRateLabels(size_t display_index
 }
 
 std::vector<std::string> DisplayCache::GetMonitorLabels() const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr) {
         return {};
     }
@@ -372,7 +481,7 @@ std::vector<std::string> DisplayCache::GetMonitorLabels() const {
 }
 
 std::vector<DisplayInfoForUI> DisplayCache::GetDisplayInfoForUI() const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr) {
         return {};
     }
@@ -453,7 +562,7 @@ const DisplayInfoForUI* DisplayCache::GetDisplayInfoByDeviceId(const std::string
 }
 
 bool DisplayCache::GetCurrentResolution(size_t display_index, int& width, int& height) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || display_index >= displays_ptr->size()) return false;
     const auto* display = (*displays_ptr)[display_index].get();
     if (!display) return false;
@@ -463,7 +572,7 @@ bool DisplayCache::GetCurrentResolution(size_t display_index, int& width, int& h
 }
 
 bool DisplayCache::GetCurrentRefreshRate(size_t display_index, RationalRefreshRate& refresh_rate) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || display_index >= displays_ptr->size()) return false;
     const auto* display = (*displays_ptr)[display_index].get();
     if (!display) return false;
@@ -473,7 +582,7 @@ bool DisplayCache::GetCurrentRefreshRate(size_t display_index, RationalRefreshRa
 
 bool DisplayCache::GetRationalRefreshRate(size_t display_index, size_t resolution_index, size_t refresh_rate_index,
                                           RationalRefreshRate& refresh_rate) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || display_index >= displays_ptr->size()) return false;
     const auto* display = (*displays_ptr)[display_index].get();
     if (!display) return false;
@@ -506,23 +615,44 @@ bool DisplayCache::GetRationalRefreshRate(size_t display_index, size_t resolutio
     return false;
 }
 
-std::shared_ptr<std::vector<std::unique_ptr<DisplayInfo>>> DisplayCache::GetDisplays() const {
-    return displays.load(std::memory_order_acquire);
+std::shared_ptr<const DisplayList> DisplayCache::GetDisplays() const {
+    auto snap = snapshot.load(std::memory_order_acquire);
+    if (!snap) return nullptr;
+    // Aliasing constructor: the list lives as long as the snapshot that owns it
+    return std::shared_ptr<const DisplayList>(snap, &snap->entries);
+}
+
+DisplayCacheRefreshStats DisplayCache::GetRefreshStats() const {
+    DisplayCacheRefreshStats s;
+    s.refreshes = stat_refreshes.load(std::memory_order_relaxed);
+    s.published = stat_published.load(std::memory_order_relaxed);
+    s.displays_enumerated = stat_displays_enumerated.load(std::memory_order_relaxed);
+    s.full_refreshes = stat_full_refreshes.load(std::memory_order_relaxed);
+    s.last_refresh_us = stat_last_refresh_us.load(std::memory_order_relaxed);
+    s.max_refresh_us = stat_max_refresh_us.load(std::memory_order_relaxed);
+    return s;
+}
+
+void DisplayCache::RequestRefresh(bool full) {
+    if (full) {
+        full_refresh_requested.store(true, std::memory_order_release);
+    }
+    continuous_monitoring::RequestTaskRun(continuous_monitoring::MonitoringTask::kDisplayCacheRefresh);
 }
 
 size_t DisplayCache::GetDisplayCount() const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     return displays_ptr ? displays_ptr->size() : 0;
 }
 
 const DisplayInfo* DisplayCache::GetDisplay(size_t index) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || index >= displays_ptr->size()) return nullptr;
     return (*displays_ptr)[index].get();
 }
 
 double DisplayCache::GetMaxRefreshRateAcrossAllMonitors() const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || displays_ptr->empty()) {
         return 60.0;  // Default fallback
     }
@@ -633,7 +763,7 @@ static int ParseDisplayNumberFromDeviceName(const std::wstring& device_name) {
 }
 
 std::string DisplayCache::GetAdjacentDisplayDeviceId(const std::string& current_device_id, bool to_the_left) const {
-    auto displays_ptr = displays.load(std::memory_order_acquire);
+    auto displays_ptr = GetDisplays();
     if (!displays_ptr || displays_ptr->empty()) {
         return {};
     }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "display_probe.hpp"
+
 #include <algorithm> // Added for std::max_element
 #include <atomic>
 #include <cmath>   // Added for std::round
@@ -294,26 +296,55 @@ struct DisplayInfoForUI {
     DisplayInfoForUI() : is_primary(false), monitor_handle(nullptr), display_index(-1) {}
 };
 
+// Published display list; DisplayInfo objects are immutable and shared across snapshots while unchanged
+using DisplayList = std::vector<std::shared_ptr<const DisplayInfo>>;
+using DisplaySnapshot = IncrementalDisplaySnapshot<DisplayInfo>;
+
+// Refresh counters (for debug UI)
+struct DisplayCacheRefreshStats {
+    uint64_t refreshes = 0;           // Refresh() calls that probed successfully
+    uint64_t published = 0;           // Snapshots published (something changed)
+    uint64_t displays_enumerated = 0; // Displays fully re-enumerated (friendly name + mode list)
+    uint64_t full_refreshes = 0;      // Forced re-enumeration of all displays (RequestRefresh(true))
+    int64_t last_refresh_us = 0;
+    int64_t max_refresh_us = 0;
+};
+
 // Main display cache class
 class DisplayCache {
   private:
-    std::atomic<std::shared_ptr<std::vector<std::unique_ptr<DisplayInfo>>>> displays;
+    std::atomic<std::shared_ptr<const DisplaySnapshot>> snapshot;
     std::atomic<bool> is_initialized;
+    std::atomic<bool> full_refresh_requested;
+
+    std::atomic<uint64_t> stat_refreshes{0};
+    std::atomic<uint64_t> stat_published{0};
+    std::atomic<uint64_t> stat_displays_enumerated{0};
+    std::atomic<uint64_t> stat_full_refreshes{0};
+    std::atomic<int64_t> stat_last_refresh_us{0};
+    std::atomic<int64_t> stat_max_refresh_us{0};
 
   public:
-    DisplayCache() : displays(std::make_shared<std::vector<std::unique_ptr<DisplayInfo>>>()), is_initialized(false) {}
+    DisplayCache()
+        : snapshot(std::make_shared<const DisplaySnapshot>()), is_initialized(false), full_refresh_requested(false) {}
 
     // Initialize the cache by enumerating all displays
     bool Initialize();
 
-    // Refresh the cache (re-enumerate displays)
-    bool Refresh();
+    // Refresh the cache: probes every monitor (cheap fingerprint) and re-enumerates only displays that changed.
+    // force_full (or a pending RequestRefresh(true)) re-enumerates all displays.
+    bool Refresh(bool force_full = false);
+
+    // Any thread (e.g. WM_DISPLAYCHANGE / WM_DEVICECHANGE): refresh on the continuous monitoring thread soon.
+    void RequestRefresh(bool full);
+
+    DisplayCacheRefreshStats GetRefreshStats() const;
 
     // Get number of displays
     size_t GetDisplayCount() const;
 
-    // Get all displays
-    std::shared_ptr<std::vector<std::unique_ptr<DisplayInfo>>> GetDisplays() const;
+    // Get all displays (immutable snapshot)
+    std::shared_ptr<const DisplayList> GetDisplays() const;
 
     // Get display by index
     const DisplayInfo *GetDisplay(size_t index) const;
@@ -0,0 +1,139 @@
+// Source Code <Display Commander> // Incremental display snapshot core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace display_cache {
+
+// Cheap per-monitor state used to decide whether a display must be re-enumerated.
+struct DisplayProbe {
+    std::wstring device_name;  // GDI device name, e.g. \\.\DISPLAY1
+    // Device name, connected monitor and current mode (FingerprintMix); a change re-enumerates the display.
+    uint64_t fingerprint = 0;
+    // Session-local state that is cheap to read (monitor handle, work area, flags); a change only updates the entry.
+    // Handles are not stable across hot-plug, so they never go into the fingerprint.
+    uint64_t attributes = 0;
+};
+
+// FNV-1a step over the 8 bytes of v.
+inline uint64_t FingerprintMix(uint64_t hash, uint64_t v) {
+    constexpr uint64_t kPrime = 1099511628211ull;
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (v >> (i * 8)) & 0xFFu;
+        hash *= kPrime;
+    }
+    return hash;
+}
+constexpr uint64_t kFingerprintSeed = 14695981039346656037ull;
+
+inline uint64_t FingerprintString(uint64_t hash, const std::wstring& s) {
+    for (const wchar_t c : s) {
+        hash = FingerprintMix(hash, static_cast<uint64_t>(c));
+    }
+    return FingerprintMix(hash, s.size());
+}
+
+// Source of probes. The Windows backend (display_cache.cpp) uses EnumDisplayMonitors + QueryDisplayConfig;
+// a scripted backend can feed probe lists to BuildIncrementalDisplaySnapshot off Windows.
+class IDisplayProbeBackend {
+   public:
+    virtual ~IDisplayProbeBackend() = default;
+    // Fills out with the current monitors; false when the system could not be queried.
+    virtual bool Probe(std::vector<DisplayProbe>& out) = 0;
+};
+
+struct DisplayDiffStats {
+    size_t unchanged = 0;
+    size_t changed = 0;  // Same device, different fingerprint (re-enumerated)
+    size_t updated = 0;  // Same device and fingerprint, different attributes (entry updated, not re-enumerated)
+    size_t added = 0;
+    size_t removed = 0;
+};
+
+// Immutable snapshot; entries are shared with the previous snapshot when their display did not change.
+template <typename Entry>
+struct IncrementalDisplaySnapshot {
+    std::vector<DisplayProbe> probes;
+    std::vector<std::shared_ptr<const Entry>> entries;  // Index-aligned with probes
+};
+
+// Builds the next snapshot from fresh probes. build(probe_index) -> std::shared_ptr<const Entry> is called only for
+// displays that are new or whose fingerprint changed (every display when force_all); nullptr drops the display.
+// update(probe_index, const Entry& previous) -> std::shared_ptr<const Entry> is called when only the attributes
+// changed. Returns nullptr when nothing changed, so the caller keeps the published snapshot.
+template <typename Entry, typename BuildFn, typename UpdateFn>
+std::shared_ptr<const IncrementalDisplaySnapshot<Entry>> BuildIncrementalDisplaySnapshot(
+    const IncrementalDisplaySnapshot<Entry>* previous, const std::vector<DisplayProbe>& probes, bool force_all,
+    BuildFn&& build, UpdateFn&& update, DisplayDiffStats* out_stats = nullptr) {
+    DisplayDiffStats stats;
+    auto next = std::make_shared<IncrementalDisplaySnapshot<Entry>>();
+    next->probes.reserve(probes.size());
+    next->entries.reserve(probes.size());
+
+    const size_t previous_count = previous != nullptr ? previous->probes.size() : 0;
+    std::vector<bool> matched(previous_count, false);
+    bool same_order = previous_count == probes.size();
+
+    for (size_t i = 0; i < probes.size(); ++i) {
+        const DisplayProbe& probe = probes[i];
+        size_t prev_index = previous_count;
+        for (size_t j = 0; j < previous_count; ++j) {
+            if (!matched[j] && previous->probes[j].device_name == probe.device_name) {
+                prev_index = j;
+                break;
+            }
+        }
+        if (prev_index != i) {
+            same_order = false;
+        }
+
+        std::shared_ptr<const Entry> entry;
+        if (prev_index < previous_count) {
+            matched[prev_index] = true;
+            const DisplayProbe& prev_probe = previous->probes[prev_index];
+            if (!force_all && prev_probe.fingerprint == probe.fingerprint) {
+                if (prev_probe.attributes == probe.attributes) {
+                    entry = previous->entries[prev_index];
+                    stats.unchanged++;
+                } else {
+                    entry = update(i, *previous->entries[prev_index]);
+                    stats.updated++;
+                }
+            } else {
+                entry = build(i);
+                stats.changed++;
+            }
+        } else {
+            entry = build(i);
+            stats.added++;
+        }
+        if (entry == nullptr) {
+            same_order = false;
+            continue;
+        }
+        next->probes.push_back(probe);
+        next->entries.push_back(std::move(entry));
+    }
+    for (size_t j = 0; j < previous_count; ++j) {
+        if (!matched[j]) {
+            stats.removed++;
+        }
+    }
+
+    if (out_stats != nullptr) {
+        *out_stats = stats;
+    }
+    if (previous != nullptr && !force_all && same_order && stats.changed == 0 && stats.updated == 0 && stats.added == 0
+        && stats.removed == 0) {
+        return nullptr;
+    }
+    return next;
+}
+
+}  // namespace display_cache
@@ -1,6 +1,7 @@
 #include "query_display.hpp"
 #include <windows.h>
 #include "../utils/logging.hpp"
+#include "display_probe.hpp"
 
 
 #include <dxgi.h>
@@ -165,7 +166,8 @@ std::string WideCharToUTF8(const std::wstring& in) {
 bool GetCurrentDisplaySettingsQueryConfig(HMONITOR monitor, int& width, int& height, uint32_t& refresh_numerator,
                                           uint32_t& refresh_denominator, int& x, int& y, bool first_time_log,
                                           const std::vector<DISPLAYCONFIG_PATH_INFO>& paths,
-                                          const std::vector<DISPLAYCONFIG_MODE_INFO>& modes) {
+                                          const std::vector<DISPLAYCONFIG_MODE_INFO>& modes,
+                                          uint64_t* monitor_identity) {
     if (paths.empty() || modes.empty()) {
         return false;
     }
@@ -252,6 +254,27 @@ bool GetCurrentDisplaySettingsQueryConfig(HMONITOR monitor, int& width, int& hei
             x = y = 0;  // Default position if source mode index invalid
         }
 
+        if (monitor_identity != nullptr) {
+            using display_cache::FingerprintMix;
+            const LUID adapter = path.targetInfo.adapterId;
+            uint64_t h = display_cache::kFingerprintSeed;
+            h = FingerprintMix(h, (static_cast<uint64_t>(static_cast<uint32_t>(adapter.HighPart)) << 32)
+                                      | adapter.LowPart);
+            h = FingerprintMix(h, path.targetInfo.id);
+            DISPLAYCONFIG_TARGET_DEVICE_NAME target_name = {};
+            target_name.header.type = DISPLAYCONFIG_DEVICE_INFO_GET_TARGET_NAME;
+            target_name.header.size = sizeof(target_name);
+            target_name.header.adapterId = path.targetInfo.adapterId;
+            target_name.header.id = path.targetInfo.id;
+            if (DisplayConfigGetDeviceInfo(&target_name.header) == ERROR_SUCCESS) {
+                h = FingerprintMix(h, (static_cast<uint64_t>(target_name.edidManufactureId) << 32)
+                                          | (static_cast<uint64_t>(target_name.edidProductCodeId) << 16)
+                                          | (target_name.connectorInstance & 0xFFFFu));
+                h = display_cache::FingerprintString(h, target_name.monitorDevicePath);
+            }
+            *monitor_identity = h;
+        }
+
         if (first_time_log) {
             std::string device_name_str = WideCharToUTF8(mi.szDevice);
             LogInfo(
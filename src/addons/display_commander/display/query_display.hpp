@@ -32,8 +32,11 @@ extern std::vector<DisplayTimingInfo> QueryDisplayTimingInfo();
 // Utility function to convert wstring to string (similar to Special-K's SK_WideCharToUTF8)
 std::string WideCharToUTF8(const std::wstring &in);
 
-// Get current display settings using QueryDisplayConfig for precise refresh rate
+// Get current display settings using QueryDisplayConfig for precise refresh rate.
+// monitor_identity (optional): hash of the connected monitor (target, EDID ids, monitor device path), so a monitor
+// swapped on the same output is detected even when the mode stays identical.
 bool GetCurrentDisplaySettingsQueryConfig(HMONITOR monitor, int &width, int &height, uint32_t &refresh_numerator,
                                           uint32_t &refresh_denominator, int &x, int &y, bool first_time_log,
                                           const std::vector<DISPLAYCONFIG_PATH_INFO> &paths,
-                                          const std::vector<DISPLAYCONFIG_MODE_INFO> &modes);
\ No newline at end of file
+                                          const std::vector<DISPLAYCONFIG_MODE_INFO> &modes,
+                                          uint64_t *monitor_identity = nullptr);
\ No newline at end of file
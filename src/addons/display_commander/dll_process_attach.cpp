@@ -5,7 +5,11 @@
 #include "config/display_commander_config.hpp"
 #include "dll_boot_logging.hpp"
 #include "exit_handler.hpp"
+#include "feature/frame_capture/frame_capture.hpp"
+#include "feature/trace/trace.hpp"
+#include "feature/vblank_lock/vblank_lock.hpp"
 #include "globals.hpp"
+#include "hooks/dxgi/dxgi_gpu_completion.hpp"
 #include "hooks/loadlibrary_hooks.hpp"
 #include "hooks/vulkan/nvlowlatencyvk_hooks.hpp"
 #include "hooks/vulkan/vulkan_loader_hooks.hpp"
@@ -663,6 +667,15 @@ void OnProcessDetach(HMODULE h_module) {
 
     StopContinuousMonitoring();
 
+    display_commander::feature::vblank_lock::StopVblankSampler();
+
+    // Finish an active capture / trace and join their threads before the module goes away
+    display_commander::feature::frame_capture::ShutdownFrameCapture();
+    display_commander::feature::trace::ShutdownTrace();
+
+    // Join the GPU completion waiter threads while their fences and events are still alive
+    display_commanderhooks::dxgi::CleanupGPUMeasurementState();
+
     if (g_reflexProvider) {
         g_reflexProvider->Shutdown();
     }
@@ -0,0 +1,73 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "adaptive_delay_bias.hpp"
+#include "../../settings/main_tab_settings.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <mutex>
+
+namespace display_commander::feature::adaptive_delay_bias {
+
+namespace {
+
+std::mutex g_controller_mutex;  // Present thread updates, UI / overlay read state
+DelayBiasController g_controller;
+bool g_active = false;  // Controller output is in use (present thread, under g_controller_mutex)
+std::atomic<int64_t> g_last_frame_ns{0};
+
+DelayBiasControllerConfig ConfigFromSettings() {
+    DelayBiasControllerConfig config;
+    const int target = settings::g_mainTabSettings.onpresent_sync_adaptive_bias_target.GetValue();
+    if (target == static_cast<int>(DelayBiasControlTarget::kFrameTimeDeviation)) {
+        config.target = DelayBiasControlTarget::kFrameTimeDeviation;
+        config.setpoint = settings::g_mainTabSettings.onpresent_sync_adaptive_bias_deviation_ms.GetValue();
+    } else {
+        config.target = DelayBiasControlTarget::kLateFramePercent;
+        config.setpoint = settings::g_mainTabSettings.onpresent_sync_adaptive_bias_late_pct.GetValue();
+    }
+    return config;
+}
+
+}  // namespace
+
+float GetAdaptiveDelayBias(float manual_bias) {
+    std::lock_guard<std::mutex> lock(g_controller_mutex);
+    if (!settings::g_mainTabSettings.onpresent_sync_adaptive_bias_enabled.GetValue()) {
+        g_active = false;
+        return manual_bias;
+    }
+    g_controller.SetConfig(ConfigFromSettings());
+    if (!g_active) {
+        g_controller.Reset(manual_bias);
+        g_active = true;
+    }
+    return static_cast<float>(g_controller.GetOutput());
+}
+
+void RecordAdaptiveDelayBiasFrame(int64_t frame_start_ns, int64_t frame_time_ns, bool late) {
+    std::lock_guard<std::mutex> lock(g_controller_mutex);
+    if (!g_active) {
+        return;
+    }
+    DelayBiasFrameSample sample;
+    sample.frame_start_ns = frame_start_ns;
+    sample.frame_time_ns = frame_time_ns;
+    sample.late = late;
+    g_controller.Update(sample);
+    g_last_frame_ns.store(utils::get_now_ns(), std::memory_order_relaxed);
+}
+
+AdaptiveDelayBiasStatus GetAdaptiveDelayBiasStatus() {
+    AdaptiveDelayBiasStatus status;
+    {
+        std::lock_guard<std::mutex> lock(g_controller_mutex);
+        status.controller = g_controller.GetState();
+        status.enabled = g_active;
+    }
+    const int64_t last_frame_ns = g_last_frame_ns.load(std::memory_order_relaxed);
+    status.enabled = status.enabled && last_frame_ns > 0 && utils::get_now_ns() - last_frame_ns < utils::SEC_TO_NS;
+    return status;
+}
+
+}  // namespace display_commander::feature::adaptive_delay_bias
@@ -0,0 +1,22 @@
+// Source Code <Display Commander> // Adaptive delay_bias feature slice
+#pragma once
+
+#include "delay_bias_controller.hpp"
+
+namespace display_commander::feature::adaptive_delay_bias {
+
+struct AdaptiveDelayBiasStatus {
+    bool enabled = false;  // Setting on and the OnPresentSync limiter fed a frame in the last second
+    DelayBiasControllerState controller;
+};
+
+// FPS limiter (present thread, OnPresentSync). Returns the controller's bias when the adaptive setting is on, else
+// manual_bias. The controller (re)starts from manual_bias when enabled.
+float GetAdaptiveDelayBias(float manual_bias);
+
+// FPS limiter (present thread), once per frame after lateness is known. frame_start_ns is the paced frame start.
+void RecordAdaptiveDelayBiasFrame(int64_t frame_start_ns, int64_t frame_time_ns, bool late);
+
+AdaptiveDelayBiasStatus GetAdaptiveDelayBiasStatus();
+
+}  // namespace display_commander::feature::adaptive_delay_bias
@@ -0,0 +1,92 @@
+// Source Code <Display Commander> // Adaptive delay_bias controller core (platform-neutral, no Windows includes)
+#include "delay_bias_controller.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+
+namespace display_commander::feature::adaptive_delay_bias {
+
+namespace {
+
+constexpr double kNsPerMs = 1'000'000.0;
+constexpr double kNsPerSecond = 1'000'000'000.0;
+// Frame start gaps above this many frame times are pauses (loading, alt-tab), not pacing
+constexpr int64_t kMaxFrameTimeMultiple = 4;
+// Setpoints are floored so the normalized error stays finite
+constexpr double kMinSetpoint = 0.01;
+
+}  // namespace
+
+void DelayBiasController::SetConfig(const DelayBiasControllerConfig& config) {
+    if (config.target != config_.target) {
+        have_measurement_ = false;
+        deviation_sq_ema_ns2_ = 0.0;
+        state_.measurement = 0.0;
+    }
+    config_ = config;
+    state_.target = config.target;
+    state_.setpoint = config.setpoint;
+    state_.output = Clamp(state_.output);
+}
+
+double DelayBiasController::Clamp(double bias) const { return std::clamp(bias, config_.min_bias, config_.max_bias); }
+
+double DelayBiasController::Update(const DelayBiasFrameSample& sample) {
+    const int64_t interval_ns = last_frame_start_ns_ > 0 ? sample.frame_start_ns - last_frame_start_ns_ : 0;
+    last_frame_start_ns_ = sample.frame_start_ns;
+    if (interval_ns <= 0 || sample.frame_time_ns <= 0 || interval_ns > kMaxFrameTimeMultiple * sample.frame_time_ns) {
+        return state_.output;
+    }
+    ++state_.frames;
+
+    // Measurement: time-based EMA so the response does not depend on the frame rate
+    const double dt_ns = static_cast<double>(interval_ns);
+    const double alpha = 1.0 - std::exp(-dt_ns / kMeasurementTimeConstantNs);
+    if (config_.target == DelayBiasControlTarget::kLateFramePercent) {
+        const double late_pct = sample.late ? 100.0 : 0.0;
+        state_.measurement =
+            have_measurement_ ? state_.measurement + alpha * (late_pct - state_.measurement) : late_pct;
+    } else {
+        const double deviation_ns = dt_ns - static_cast<double>(sample.frame_time_ns);
+        const double deviation_sq = deviation_ns * deviation_ns;
+        deviation_sq_ema_ns2_ =
+            have_measurement_ ? deviation_sq_ema_ns2_ + alpha * (deviation_sq - deviation_sq_ema_ns2_) : deviation_sq;
+        state_.measurement = std::sqrt(deviation_sq_ema_ns2_) / kNsPerMs;
+    }
+    have_measurement_ = true;
+
+    const double setpoint = (std::max)(config_.setpoint, kMinSetpoint);
+    state_.error = std::clamp((setpoint - state_.measurement) / setpoint, kMinError, kMaxError);
+    state_.proportional = kProportionalGain * state_.error;
+
+    // Conditional integration: a step that would push the output past a bound only integrates up to that bound
+    const double integral_step = kIntegralGainPerSecond * state_.error * dt_ns / kNsPerSecond;
+    const double unclamped = state_.proportional + state_.integral + integral_step;
+    if (integral_step > 0.0 && unclamped > config_.max_bias) {
+        state_.integral = (std::max)(state_.integral, config_.max_bias - state_.proportional);
+    } else if (integral_step < 0.0 && unclamped < config_.min_bias) {
+        state_.integral = (std::min)(state_.integral, config_.min_bias - state_.proportional);
+    } else {
+        state_.integral += integral_step;
+    }
+    // Keep the integral inside the output range: a large P term must not leave it stranded far outside
+    state_.integral = std::clamp(state_.integral, config_.min_bias - kProportionalGain * kMaxError,
+                                 config_.max_bias - kProportionalGain * kMinError);
+    const double output = state_.proportional + state_.integral;
+    state_.saturated = output >= config_.max_bias || output <= config_.min_bias;
+    state_.output = Clamp(output);
+    return state_.output;
+}
+
+void DelayBiasController::Reset(double initial_bias) {
+    const DelayBiasControllerConfig config = config_;
+    *this = DelayBiasController();
+    config_ = config;
+    state_.target = config.target;
+    state_.setpoint = config.setpoint;
+    state_.output = Clamp(initial_bias);
+    state_.integral = state_.output;
+}
+
+}  // namespace display_commander::feature::adaptive_delay_bias
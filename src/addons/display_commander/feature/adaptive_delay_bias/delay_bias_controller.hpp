@@ -0,0 +1,76 @@
+// Source Code <Display Commander> // Adaptive delay_bias controller core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace display_commander::feature::adaptive_delay_bias {
+
+enum class DelayBiasControlTarget : uint8_t {
+    kLateFramePercent = 0,    // Hold the share of late limiter frames
+    kFrameTimeDeviation = 1,  // Hold the RMS deviation of frame start spacing from the target frame time
+};
+
+struct DelayBiasControllerConfig {
+    DelayBiasControlTarget target = DelayBiasControlTarget::kLateFramePercent;
+    double setpoint = 2.0;  // Late frames (%) or frame time deviation (ms)
+    double min_bias = 0.0;
+    double max_bias = 1.0;
+};
+
+// One OnPresentSync limiter frame, after its lateness is known.
+struct DelayBiasFrameSample {
+    int64_t frame_start_ns = 0;  // Limiter frame start (monotonic)
+    int64_t frame_time_ns = 0;   // Target frame time
+    bool late = false;
+};
+
+struct DelayBiasControllerState {
+    DelayBiasControlTarget target = DelayBiasControlTarget::kLateFramePercent;
+    double setpoint = 0.0;
+    double measurement = 0.0;   // Filtered late frames (%) or frame time deviation (ms)
+    double error = 0.0;         // (setpoint - measurement) / setpoint, clamped: > 0 = room to cut latency
+    double proportional = 0.0;
+    double integral = 0.0;
+    double output = 0.0;        // delay_bias for the next frame
+    bool saturated = false;     // Output at a bound; integration stops there while the error pushes further out
+    uint64_t frames = 0;
+};
+
+// PI controller for the OnPresentSync delay_bias (0 = all limiter sleep before the frame, smooth; 1 = all after
+// present, lowest input latency). While the measured late frames / deviation stay below the setpoint the integral
+// keeps raising the bias, so the controller settles at the lowest-latency bias the current load allows; load spikes
+// push the measurement over the setpoint and the bias back down. The error is normalized by the setpoint so both
+// targets share one set of gains, and clamped asymmetrically so a burst of late frames backs off faster than calm
+// frames advance. Anti-windup by conditional integration. Not thread-safe: update and read from one thread.
+class DelayBiasController {
+   public:
+    static constexpr double kProportionalGain = 0.15;
+    static constexpr double kIntegralGainPerSecond = 0.25;
+    static constexpr double kMeasurementTimeConstantNs = 1'000'000'000.0;
+    static constexpr double kMinError = -3.0;
+    static constexpr double kMaxError = 1.0;
+
+    // Keeps the integral unless the target changes (then the measurement restarts too).
+    void SetConfig(const DelayBiasControllerConfig& config);
+
+    // Feeds one frame; returns the bias for the next frame.
+    double Update(const DelayBiasFrameSample& sample);
+
+    double GetOutput() const { return state_.output; }
+    DelayBiasControllerState GetState() const { return state_; }
+
+    // Bumpless start: the output continues from initial_bias (e.g. the manual ratio).
+    void Reset(double initial_bias);
+
+   private:
+    double Clamp(double bias) const;
+
+    DelayBiasControllerConfig config_;
+    DelayBiasControllerState state_;
+    int64_t last_frame_start_ns_ = 0;
+    double deviation_sq_ema_ns2_ = 0.0;
+    bool have_measurement_ = false;
+};
+
+}  // namespace display_commander::feature::adaptive_delay_bias
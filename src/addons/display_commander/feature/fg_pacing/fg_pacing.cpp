@@ -0,0 +1,99 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "fg_pacing.hpp"
+#include "../../latency/latency_markers.hpp"
+#include "../../settings/main_tab_settings.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <mutex>
+
+namespace display_commander::feature::fg_pacing {
+
+namespace {
+
+// Markers newer than this win over game presents as the real frame source
+constexpr int64_t kMarkerSourceTimeoutNs = 500'000'000;
+
+std::mutex g_model_mutex;  // Output presents (present thread), real frames (marker bus / game thread), UI
+FgPacingModel g_model;
+FgRealFrameSource g_source = FgRealFrameSource::kNone;  // Under g_model_mutex
+
+std::atomic<int64_t> g_last_marker_ns{0};
+std::atomic<int64_t> g_last_output_ns{0};
+std::atomic<int> g_last_fg_mode{0};
+std::atomic<int> g_last_limiter_multiplier{0};
+std::once_flag g_subscribe_once;
+
+void AddRealFrame(FgRealFrameSource source, int64_t time_ns) {
+    std::lock_guard<std::mutex> lock(g_model_mutex);
+    if (source != g_source) {
+        g_model.Reset();
+        g_source = source;
+    }
+    g_model.AddRealFrame(time_ns);
+}
+
+void SubscribeToMarkers() {
+    latency::GetLatencyMarkerBus().Subscribe([](const latency::LatencyFrameMarkers& frame) {
+        if (!frame.Has(latency::LatencyMarker::kPresentStart)) {
+            return;
+        }
+        const int64_t present_start_ns = frame.Time(latency::LatencyMarker::kPresentStart);
+        g_last_marker_ns.store(utils::get_now_ns(), std::memory_order_relaxed);
+        AddRealFrame(FgRealFrameSource::kLatencyMarkers, present_start_ns);
+    });
+}
+
+}  // namespace
+
+const char* FgRealFrameSourceName(FgRealFrameSource source) {
+    switch (source) {
+        case FgRealFrameSource::kNone:           return "None";
+        case FgRealFrameSource::kLatencyMarkers: return "Present markers";
+        case FgRealFrameSource::kGamePresent:    return "Game present (Streamline proxy)";
+    }
+    return "?";
+}
+
+void RecordFgOutputPresent(int64_t now_ns) {
+    std::call_once(g_subscribe_once, SubscribeToMarkers);
+    g_last_output_ns.store(now_ns, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(g_model_mutex);
+    g_model.AddOutputPresent(now_ns);
+}
+
+void RecordFgGamePresent(int64_t now_ns) {
+    if (now_ns - g_last_marker_ns.load(std::memory_order_relaxed) < kMarkerSourceTimeoutNs) {
+        return;
+    }
+    AddRealFrame(FgRealFrameSource::kGamePresent, now_ns);
+}
+
+int GetFgPacingMultiplier(int fg_mode) {
+    int multiplier = fg_mode >= 2 ? fg_mode : 1;
+    if (settings::g_mainTabSettings.fps_limiter_fg_pacing_model.GetValue()
+        && utils::get_now_ns() - g_last_output_ns.load(std::memory_order_relaxed) < utils::SEC_TO_NS) {
+        std::lock_guard<std::mutex> lock(g_model_mutex);
+        multiplier = ResolveFgMultiplier(g_model.GetStats(), fg_mode);
+    }
+    g_last_fg_mode.store(fg_mode, std::memory_order_relaxed);
+    g_last_limiter_multiplier.store(multiplier, std::memory_order_relaxed);
+    return multiplier;
+}
+
+FgPacingStatus GetFgPacingStatus() {
+    FgPacingStatus status;
+    {
+        std::lock_guard<std::mutex> lock(g_model_mutex);
+        status.source = g_source;
+        status.stats = g_model.GetStats();
+    }
+    const int64_t last_output_ns = g_last_output_ns.load(std::memory_order_relaxed);
+    status.outputs_recent = last_output_ns > 0 && utils::get_now_ns() - last_output_ns < utils::SEC_TO_NS;
+    status.fg_mode = g_last_fg_mode.load(std::memory_order_relaxed);
+    status.limiter_multiplier = g_last_limiter_multiplier.load(std::memory_order_relaxed);
+    return status;
+}
+
+}  // namespace display_commander::feature::fg_pacing
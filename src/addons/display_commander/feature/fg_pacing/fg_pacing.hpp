@@ -0,0 +1,36 @@
+// Source Code <Display Commander> // Frame generation pacing feature slice
+#pragma once
+
+#include "fg_pacing_model.hpp"
+
+namespace display_commander::feature::fg_pacing {
+
+enum class FgRealFrameSource : uint8_t {
+    kNone = 0,
+    kLatencyMarkers,  // Present start markers from the latency marker bus (Reflex / PCLStats)
+    kGamePresent,     // Game's own Present on the Streamline proxy swap chain
+};
+
+const char* FgRealFrameSourceName(FgRealFrameSource source);
+
+struct FgPacingStatus {
+    FgRealFrameSource source = FgRealFrameSource::kNone;
+    bool outputs_recent = false;  // Output presents seen in the last second
+    int fg_mode = 0;              // DLSSGSummaryLite::fg_mode at the last limiter frame
+    int limiter_multiplier = 0;   // What the limiter divided the target by (0 = FG-aware limiter not running)
+    FgPacingStats stats;
+};
+
+// Native swap chain Present / Present1, not nested: every frame that reaches the display, real or generated.
+void RecordFgOutputPresent(int64_t now_ns);
+
+// Streamline proxy swap chain Present: one per rendered frame. Used while no Present start markers arrive.
+void RecordFgGamePresent(int64_t now_ns);
+
+// FPS limiter (frame generation aware path). Multiplier to divide the output target by: the model's when enabled
+// and locked, else the fixed fg_mode rule.
+int GetFgPacingMultiplier(int fg_mode);
+
+FgPacingStatus GetFgPacingStatus();
+
+}  // namespace display_commander::feature::fg_pacing
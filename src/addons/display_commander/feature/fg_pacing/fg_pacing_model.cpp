@@ -0,0 +1,192 @@
+// Source Code <Display Commander> // Frame generation pacing model core (platform-neutral, no Windows includes)
+#include "fg_pacing_model.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+
+namespace display_commander::feature::fg_pacing {
+
+namespace {
+
+constexpr double kNsPerMs = 1'000'000.0;
+
+double StddevFromSums(double sum, double sq_sum, double count) {
+    if (count < 2.0) {
+        return 0.0;
+    }
+    const double mean = sum / count;
+    return std::sqrt((std::max)(0.0, sq_sum / count - mean * mean));
+}
+
+}  // namespace
+
+void FgPacingModel::AddOutputPresent(int64_t time_ns) {
+    if (output_count_ > 0 && time_ns < outputs_[(output_count_ - 1) % kOutputHistory]) {
+        return;  // Presents from another swap chain / thread racing: keep the history sorted
+    }
+    outputs_[output_count_ % kOutputHistory] = time_ns;
+    ++output_count_;
+    ++stats_.output_presents;
+    AttributeReady();
+}
+
+void FgPacingModel::AddRealFrame(int64_t time_ns) {
+    const int64_t newest = pending_size_ > 0 ? pending_[(pending_head_ + pending_size_ - 1) % kPendingRealFrames]
+                                             : last_real_ns_;
+    if (time_ns <= newest) {
+        ++stats_.unattributed_frames;
+        return;
+    }
+    if (pending_size_ == kPendingRealFrames) {
+        // Outputs stopped (minimized, other swap chain): drop the oldest and restart the interval chain
+        pending_head_ = (pending_head_ + 1) % kPendingRealFrames;
+        --pending_size_;
+        last_real_ns_ = 0;
+        ++stats_.unattributed_frames;
+    }
+    pending_[(pending_head_ + pending_size_) % kPendingRealFrames] = time_ns;
+    ++pending_size_;
+    ++stats_.real_frames;
+    AttributeReady();
+}
+
+void FgPacingModel::AttributeReady() {
+    if (output_count_ == 0) {
+        return;
+    }
+    const int64_t newest_output_ns = outputs_[(output_count_ - 1) % kOutputHistory];
+    bool attributed = false;
+    while (pending_size_ > 0 && newest_output_ns >= pending_[pending_head_]) {
+        const int64_t real_ns = pending_[pending_head_];
+        pending_head_ = (pending_head_ + 1) % kPendingRealFrames;
+        --pending_size_;
+        if (last_real_ns_ != 0 && real_ns - last_real_ns_ <= kMaxRealIntervalNs) {
+            Attribute(last_real_ns_, real_ns);
+            attributed = true;
+        } else {
+            // First frame or after a pause: only moves the cursor to this frame
+            while (output_cursor_ < output_count_ && outputs_[output_cursor_ % kOutputHistory] < real_ns) {
+                ++output_cursor_;
+            }
+        }
+        last_real_ns_ = real_ns;
+    }
+    if (attributed) {
+        UpdateStats();
+    }
+}
+
+void FgPacingModel::Attribute(int64_t start_ns, int64_t end_ns) {
+    const uint64_t oldest_kept = output_count_ > kOutputHistory ? output_count_ - kOutputHistory : 0;
+    if (output_cursor_ < oldest_kept) {
+        // Real frames lagged further than the output history reaches
+        ++stats_.unattributed_frames;
+        output_cursor_ = oldest_kept;
+        while (output_cursor_ < output_count_ && outputs_[output_cursor_ % kOutputHistory] < end_ns) {
+            ++output_cursor_;
+        }
+        return;
+    }
+    while (output_cursor_ < output_count_ && outputs_[output_cursor_ % kOutputHistory] < start_ns) {
+        ++output_cursor_;
+    }
+    const uint64_t first = output_cursor_;
+    while (output_cursor_ < output_count_ && outputs_[output_cursor_ % kOutputHistory] < end_ns) {
+        ++output_cursor_;
+    }
+
+    RealInterval interval;
+    interval.interval_ns = end_ns - start_ns;
+    interval.outputs = static_cast<uint32_t>(output_cursor_ - first);
+    for (uint64_t i = (std::max)(first, oldest_kept + 1); i < output_cursor_; ++i) {
+        const double delta_ns = static_cast<double>(outputs_[i % kOutputHistory] - outputs_[(i - 1) % kOutputHistory]);
+        interval.output_interval_sum_ns += delta_ns;
+        interval.output_interval_sq_sum_ns2 += delta_ns * delta_ns;
+        ++interval.output_intervals;
+    }
+    window_[window_next_] = interval;
+    window_next_ = (window_next_ + 1) % kWindowFrames;
+    window_size_ = (std::min)(window_size_ + 1, kWindowFrames);
+}
+
+void FgPacingModel::UpdateStats() {
+    double real_sum = 0.0;
+    double real_sq_sum = 0.0;
+    double outputs = 0.0;
+    double output_sum = 0.0;
+    double output_sq_sum = 0.0;
+    double output_intervals = 0.0;
+    for (size_t i = 0; i < window_size_; ++i) {
+        const RealInterval& interval = window_[i];
+        const double interval_ns = static_cast<double>(interval.interval_ns);
+        real_sum += interval_ns;
+        real_sq_sum += interval_ns * interval_ns;
+        outputs += static_cast<double>(interval.outputs);
+        output_sum += interval.output_interval_sum_ns;
+        output_sq_sum += interval.output_interval_sq_sum_ns2;
+        output_intervals += static_cast<double>(interval.output_intervals);
+    }
+    const double frames = static_cast<double>(window_size_);
+    stats_.valid = window_size_ >= kMinValidFrames;
+    stats_.observed_multiplier = frames > 0.0 ? outputs / frames : 0.0;
+    stats_.real_interval_ms = frames > 0.0 ? real_sum / frames / kNsPerMs : 0.0;
+    stats_.real_stddev_ms = StddevFromSums(real_sum, real_sq_sum, frames) / kNsPerMs;
+    stats_.output_interval_ms = output_intervals > 0.0 ? output_sum / output_intervals / kNsPerMs : 0.0;
+    stats_.output_stddev_ms = StddevFromSums(output_sum, output_sq_sum, output_intervals) / kNsPerMs;
+
+    const int nearest = static_cast<int>(std::lround(stats_.observed_multiplier));
+    // Output pacing error vs even spacing (real interval / nearest) from the per-frame sums:
+    // sum (d - ideal)^2 = sum d^2 - 2 * ideal * sum d + n * ideal^2
+    double output_error_sq = 0.0;
+    size_t irregular = 0;
+    const size_t oldest = (window_next_ + kWindowFrames - window_size_) % kWindowFrames;
+    for (size_t i = 0; i < window_size_; ++i) {
+        const RealInterval& interval = window_[(oldest + i) % kWindowFrames];
+        if (nearest >= 1) {
+            const double ideal_ns = static_cast<double>(interval.interval_ns) / nearest;
+            output_error_sq += interval.output_interval_sq_sum_ns2 - 2.0 * ideal_ns * interval.output_interval_sum_ns
+                               + static_cast<double>(interval.output_intervals) * ideal_ns * ideal_ns;
+        }
+        const int count = static_cast<int>(interval.outputs);
+        if (count == nearest) {
+            continue;
+        }
+        const bool shifted_from_previous =
+            i > 0 && count + static_cast<int>(window_[(oldest + i - 1) % kWindowFrames].outputs) == 2 * nearest;
+        const bool shifted_to_next =
+            i + 1 < window_size_
+            && count + static_cast<int>(window_[(oldest + i + 1) % kWindowFrames].outputs) == 2 * nearest;
+        if (!shifted_from_previous && !shifted_to_next) {
+            ++irregular;
+        }
+    }
+    stats_.output_pacing_error_ms =
+        output_intervals > 0.0 ? std::sqrt((std::max)(0.0, output_error_sq) / output_intervals) / kNsPerMs : 0.0;
+    stats_.irregular_pct = frames > 0.0 ? 100.0 * static_cast<double>(irregular) / frames : 0.0;
+    const bool stable = std::abs(stats_.observed_multiplier - nearest) <= kLockTolerance
+                        && stats_.irregular_pct <= kMaxIrregularPct;
+    stats_.locked_multiplier = stats_.valid && stable && nearest >= 1 && nearest <= kMaxMultiplier ? nearest : 0;
+}
+
+void FgPacingModel::Reset() {
+    const uint64_t real_frames = stats_.real_frames;
+    const uint64_t output_presents = stats_.output_presents;
+    const uint64_t unattributed_frames = stats_.unattributed_frames;
+    *this = FgPacingModel();
+    stats_.real_frames = real_frames;
+    stats_.output_presents = output_presents;
+    stats_.unattributed_frames = unattributed_frames;
+}
+
+int ResolveFgMultiplier(const FgPacingStats& stats, int fg_mode) {
+    if (fg_mode == 0) {
+        return 1;
+    }
+    if (stats.locked_multiplier >= 1) {
+        return stats.locked_multiplier;
+    }
+    return fg_mode >= 2 ? fg_mode : 1;
+}
+
+}  // namespace display_commander::feature::fg_pacing
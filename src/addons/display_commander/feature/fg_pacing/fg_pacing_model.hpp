@@ -0,0 +1,92 @@
+// Source Code <Display Commander> // Frame generation pacing model core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::feature::fg_pacing {
+
+struct FgPacingStats {
+    bool valid = false;            // Enough attributed real frames in the window
+    double observed_multiplier = 0.0;  // Mean output presents per real frame
+    int locked_multiplier = 0;     // Stable integer multiplier (0 = not locked)
+    double real_interval_ms = 0.0;     // Real (rendered) frame cadence
+    double real_stddev_ms = 0.0;
+    double output_interval_ms = 0.0;   // Output (real + generated) present cadence
+    double output_stddev_ms = 0.0;
+    double output_pacing_error_ms = 0.0;  // RMS of output intervals vs real interval / multiplier (even split)
+    // Real frames whose output count differs from the multiplier, not counting a frame boundary that only moved an
+    // output to the neighbouring frame (N+1 then N-1)
+    double irregular_pct = 0.0;
+    uint64_t real_frames = 0;
+    uint64_t output_presents = 0;
+    uint64_t unattributed_frames = 0;  // Output history overrun or real frames out of order
+};
+
+// Separates real from generated frames. Output presents (every frame that reaches the swap chain, real or
+// generated) and real frames (one per rendered frame: Present start markers or the game's own presents) are
+// recorded separately; each real frame interval [t(k-1), t(k)) is attributed the output presents inside it. A real
+// frame is attributed only once an output at or after t(k) was seen, so late (marker bus) real frames work as long
+// as the output history still covers them. Both cadences and the output pacing error come from a window of the
+// last kWindowFrames real frames.
+//
+// Not thread-safe: feed and read under one lock.
+class FgPacingModel {
+   public:
+    static constexpr size_t kOutputHistory = 1024;  // Output presents kept for attribution
+    static constexpr size_t kPendingRealFrames = 16;
+    static constexpr size_t kWindowFrames = 128;
+    static constexpr size_t kMinValidFrames = 16;
+    static constexpr double kLockTolerance = 0.25;  // |observed - integer| to lock (dropped generated frames)
+    static constexpr double kMaxIrregularPct = 25.0;
+    static constexpr int kMaxMultiplier = 8;
+    // Real frame gaps above this are pauses (loading, alt-tab): attribution restarts
+    static constexpr int64_t kMaxRealIntervalNs = 250'000'000;
+
+    void AddOutputPresent(int64_t time_ns);
+    void AddRealFrame(int64_t time_ns);
+
+    // Updated on every attributed real frame.
+    const FgPacingStats& GetStats() const { return stats_; }
+
+    void Reset();
+
+   private:
+    struct RealInterval {
+        int64_t interval_ns = 0;
+        uint32_t outputs = 0;
+        // Gaps before each output attributed to this interval (to the previous output, real or generated)
+        uint32_t output_intervals = 0;
+        double output_interval_sum_ns = 0.0;
+        double output_interval_sq_sum_ns2 = 0.0;
+    };
+
+    void AttributeReady();
+    void Attribute(int64_t start_ns, int64_t end_ns);
+    void UpdateStats();
+
+    std::array<int64_t, kOutputHistory> outputs_ = {};
+    uint64_t output_count_ = 0;   // Total outputs recorded (ring index = count % size)
+    uint64_t output_cursor_ = 0;  // First output not yet attributed
+
+    std::array<int64_t, kPendingRealFrames> pending_ = {};
+    size_t pending_head_ = 0;
+    size_t pending_size_ = 0;
+    int64_t last_real_ns_ = 0;  // End of the last attributed interval
+
+    std::array<RealInterval, kWindowFrames> window_ = {};
+    size_t window_next_ = 0;
+    size_t window_size_ = 0;
+
+    FgPacingStats stats_;
+};
+
+// Frame generation multiplier the FPS limiter divides the output target by. fg_mode as in DLSSGSummaryLite (0 = off,
+// -1 = active with unknown MultiFrameCount, >= 2 = Nx). With FG on, a locked model wins: it reflects the presents
+// actually seen (dynamic multi-frame generation, unknown MultiFrameCount). Otherwise the fixed rule: fg_mode when
+// >= 2, else 1.
+int ResolveFgMultiplier(const FgPacingStats& stats, int fg_mode);
+
+}  // namespace display_commander::feature::fg_pacing
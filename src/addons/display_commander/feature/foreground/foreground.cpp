@@ -0,0 +1,195 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "foreground.hpp"
+#include "../../continuous_monitoring.hpp"
+#include "../hitch/hitch.hpp"
+#include "../../globals.hpp"
+#include "../../hooks/windows_hooks/api_hooks.hpp"
+#include "../../hooks/windows_hooks/windows_message_hooks.hpp"
+#include "../../utils/logging.hpp"
+#include "../../utils/srwlock_registry.hpp"
+#include "../../utils/srwlock_wrapper.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Windows.h
+#include <Windows.h>
+
+namespace display_commander::feature::foreground {
+
+namespace {
+
+ForegroundTracker g_tracker;  // Guarded by utils::g_foreground_tracker_lock
+
+std::thread g_hook_thread;
+std::atomic<DWORD> g_hook_thread_id{0};
+
+bool IsForegroundWindowOurs(HWND foreground_window) {
+    if (foreground_window == nullptr) {
+        return false;
+    }
+    DWORD pid = 0;
+    GetWindowThreadProcessId(foreground_window, &pid);
+    return pid == GetCurrentProcessId();
+}
+
+// Minimize events are filtered to this process; only the game window (when known) counts.
+bool IsGameWindowOrUnknown(HWND hwnd) {
+    HWND game_hwnd = g_last_swapchain_hwnd.load(std::memory_order_acquire);
+    return game_hwnd == nullptr || game_hwnd == hwnd;
+}
+
+void Report(const ForegroundEvent& event) {
+    const int64_t now_ns = static_cast<int64_t>(utils::get_now_ns());
+    ForegroundUpdate update;
+    {
+        utils::SRWLockExclusive lock(utils::g_foreground_tracker_lock);
+        update = g_tracker.OnEvent(event, now_ns);
+        if (update.changed) {
+            // Store under the lock so concurrent reporters publish in the order the tracker applied them.
+            g_app_in_background.store(update.in_background, std::memory_order_release);
+            g_last_foreground_background_switch_ns.store(static_cast<LONGLONG>(now_ns), std::memory_order_release);
+        }
+    }
+    if (!update.changed) {
+        return;
+    }
+    hitch::RecordHitchBackgroundTransition(now_ns, update.in_background);
+    // Switches the hotkey task between per-pass polling (background) and event-driven key state right away.
+    display_commanderhooks::keyboard_tracker::RequestReconcile();
+    LogDebug("Foreground tracking: app moved to %s (source: %s, latency %.2f ms)",
+             update.in_background ? "BACKGROUND" : "FOREGROUND", ForegroundEventSourceName(event.source),
+             static_cast<double>(update.latency_ns) / utils::NS_TO_MS);
+    if (event.source != ForegroundEventSource::kPoll) {
+        // Cursor clip / window side effects run on the monitoring thread.
+        continuous_monitoring::RequestTaskRun(continuous_monitoring::MonitoringTask::kBackgroundCheck);
+    }
+}
+
+void CALLBACK ForegroundWinEventProc(HWINEVENTHOOK /*hook*/, DWORD event, HWND hwnd, LONG id_object,
+                                     LONG /*id_child*/, DWORD /*event_thread*/, DWORD /*event_time_ms*/) {
+    if (id_object != OBJID_WINDOW) {
+        return;
+    }
+    // Stamped on receipt with the same clock as the window proc. dwmsEventTime is GetTickCount-based (~15.6 ms
+    // steps), so converting it could order a WinEvent before a window message that actually came first.
+    ForegroundEvent e;
+    e.source = ForegroundEventSource::kWinEvent;
+    e.event_time_ns = static_cast<int64_t>(utils::get_now_ns());
+
+    switch (event) {
+        case EVENT_SYSTEM_FOREGROUND:
+            e.kind = ForegroundEventKind::kForeground;
+            e.foreground_is_ours = IsForegroundWindowOurs(hwnd);
+            break;
+        case EVENT_SYSTEM_MINIMIZESTART:
+            if (!IsGameWindowOrUnknown(hwnd)) {
+                return;
+            }
+            e.kind = ForegroundEventKind::kMinimizeStart;
+            break;
+        case EVENT_SYSTEM_MINIMIZEEND:
+            if (!IsGameWindowOrUnknown(hwnd)) {
+                return;
+            }
+            e.kind = ForegroundEventKind::kMinimizeEnd;
+            e.foreground_is_ours = IsForegroundWindowOurs(display_commanderhooks::GetForegroundWindow_Direct());
+            break;
+        default: return;
+    }
+    Report(e);
+}
+
+// Out-of-context WinEvent hooks are delivered through this thread's message queue.
+void ForegroundHookThread(HANDLE ready_event) {
+    MSG msg;
+    PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);  // Create the message queue
+    g_hook_thread_id.store(GetCurrentThreadId(), std::memory_order_release);
+
+    HWINEVENTHOOK foreground_hook = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, nullptr,
+                                                    ForegroundWinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT);
+    HWINEVENTHOOK minimize_hook =
+        SetWinEventHook(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND, nullptr, ForegroundWinEventProc,
+                        GetCurrentProcessId(), 0, WINEVENT_OUTOFCONTEXT);
+    SetEvent(ready_event);
+
+    if (foreground_hook == nullptr || minimize_hook == nullptr) {
+        LogError("Foreground tracking: SetWinEventHook failed (foreground=%p, minimize=%p, error %lu); using poll only",
+                 foreground_hook, minimize_hook, GetLastError());
+    } else {
+        LogInfo("Foreground tracking: WinEvent hooks installed");
+    }
+
+    while (GetMessageW(&msg, nullptr, 0, 0) > 0) {
+        TranslateMessage(&msg);
+        DispatchMessageW(&msg);
+    }
+
+    if (minimize_hook != nullptr) {
+        UnhookWinEvent(minimize_hook);
+    }
+    if (foreground_hook != nullptr) {
+        UnhookWinEvent(foreground_hook);
+    }
+    g_hook_thread_id.store(0, std::memory_order_release);
+}
+
+}  // namespace
+
+void StartForegroundEventHook() {
+    if (g_hook_thread.joinable()) {
+        return;
+    }
+    HANDLE ready_event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (ready_event == nullptr) {
+        LogError("Foreground tracking: CreateEvent failed (%lu); using poll only", GetLastError());
+        return;
+    }
+    g_hook_thread = std::thread(ForegroundHookThread, ready_event);
+    // Wait until the thread has a message queue so Stop can always post WM_QUIT.
+    WaitForSingleObject(ready_event, 2000);
+    CloseHandle(ready_event);
+}
+
+void StopForegroundEventHook() {
+    if (!g_hook_thread.joinable()) {
+        return;
+    }
+    const DWORD thread_id = g_hook_thread_id.load(std::memory_order_acquire);
+    if (thread_id != 0) {
+        PostThreadMessageW(thread_id, WM_QUIT, 0, 0);
+        g_hook_thread.join();
+    } else {
+        g_hook_thread.detach();
+    }
+}
+
+void ReportWindowActivationMessage() {
+    ForegroundEvent e;
+    e.kind = ForegroundEventKind::kForeground;
+    e.source = ForegroundEventSource::kWindowProc;
+    e.event_time_ns = static_cast<int64_t>(utils::get_now_ns());
+    e.foreground_is_ours = IsForegroundWindowOurs(display_commanderhooks::GetForegroundWindow_Direct());
+    Report(e);
+}
+
+void PollForegroundState() {
+    ForegroundEvent e;
+    e.kind = ForegroundEventKind::kForeground;
+    e.source = ForegroundEventSource::kPoll;
+    e.event_time_ns = static_cast<int64_t>(utils::get_now_ns());
+    e.foreground_is_ours = IsForegroundWindowOurs(display_commanderhooks::GetForegroundWindow_Direct());
+    HWND game_hwnd = g_last_swapchain_hwnd.load(std::memory_order_acquire);
+    e.minimized = game_hwnd != nullptr && display_commanderhooks::IsIconic_direct(game_hwnd);
+    Report(e);
+}
+
+ForegroundTrackerStats GetForegroundTrackerStats() {
+    utils::SRWLockShared lock(utils::g_foreground_tracker_lock);
+    return g_tracker.GetStats();
+}
+
+}  // namespace display_commander::feature::foreground
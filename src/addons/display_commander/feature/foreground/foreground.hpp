@@ -0,0 +1,22 @@
+// Source Code <Display Commander> // Event-driven foreground/background tracking feature slice
+#pragma once
+
+#include "foreground_tracker.hpp"
+
+namespace display_commander::feature::foreground {
+
+// Starts the WinEvent hook thread (EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_MINIMIZESTART/END for this process).
+// Foreground changes then update g_app_in_background immediately and request the background task of the
+// continuous monitoring thread (cursor clip, etc.). Safe to call more than once.
+void StartForegroundEventHook();
+void StopForegroundEventHook();
+
+// Window proc: WM_ACTIVATEAPP / WM_ACTIVATE reached one of our windows; re-checks the foreground owner.
+void ReportWindowActivationMessage();
+
+// Continuous monitoring: slow safety-net poll (GetForegroundWindow / IsIconic) for missed events.
+void PollForegroundState();
+
+ForegroundTrackerStats GetForegroundTrackerStats();
+
+}  // namespace display_commander::feature::foreground
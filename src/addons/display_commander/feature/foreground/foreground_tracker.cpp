@@ -0,0 +1,82 @@
+// Source Code <Display Commander> // Foreground/background state machine (platform-neutral, no Windows includes)
+#include "foreground_tracker.hpp"
+
+namespace display_commander::feature::foreground {
+
+const char* ForegroundEventSourceName(ForegroundEventSource source) {
+    switch (source) {
+        case ForegroundEventSource::kWinEvent:   return "WinEvent";
+        case ForegroundEventSource::kWindowProc: return "Window proc";
+        case ForegroundEventSource::kPoll:       return "Poll";
+        default:                                 return "?";
+    }
+}
+
+ForegroundUpdate ForegroundTracker::OnEvent(const ForegroundEvent& event, int64_t now_ns) {
+    ForegroundUpdate out;
+    const size_t source_index = static_cast<size_t>(event.source);
+    if (source_index < static_cast<size_t>(ForegroundEventSource::kCount)) {
+        stats_.events[source_index]++;
+    }
+
+    const bool is_poll = event.source == ForegroundEventSource::kPoll;
+    out.in_background = in_background_;
+    if (known_ && is_poll && last_push_report_ns_ > 0 && now_ns - last_push_report_ns_ < kPollGraceNs) {
+        stats_.deferred_polls++;
+        return out;
+    }
+    // Pushed events come from several threads; one that lost the race to a newer event carries stale state.
+    if (known_ && !is_poll && event.event_time_ns < last_event_time_ns_) {
+        stats_.stale_events++;
+        return out;
+    }
+    if (!is_poll) {
+        last_push_report_ns_ = now_ns;
+        last_event_time_ns_ = event.event_time_ns;
+    }
+
+    switch (event.kind) {
+        case ForegroundEventKind::kMinimizeStart: minimized_ = true; break;
+        case ForegroundEventKind::kMinimizeEnd:   minimized_ = false; break;
+        case ForegroundEventKind::kForeground:
+            if (is_poll) {
+                minimized_ = event.minimized;
+            }
+            break;
+    }
+
+    // While minimized, foreground_is_ours is not trusted (the window may still own the foreground while animating).
+    out.in_background = minimized_ || !event.foreground_is_ours;
+
+    if (known_ && out.in_background == in_background_) {
+        return out;
+    }
+
+    out.changed = true;
+    if (known_) {
+        stats_.transitions++;
+        if (is_poll) {
+            stats_.poll_corrections++;
+        } else {
+            out.latency_ns = now_ns > event.event_time_ns ? now_ns - event.event_time_ns : 0;
+            stats_.latency_samples++;
+            stats_.last_latency_ns = out.latency_ns;
+            if (out.latency_ns > stats_.max_latency_ns) {
+                stats_.max_latency_ns = out.latency_ns;
+            }
+            latency_total_ns_ += out.latency_ns;
+        }
+    }
+    known_ = true;
+    in_background_ = out.in_background;
+    return out;
+}
+
+ForegroundTrackerStats ForegroundTracker::GetStats() const {
+    ForegroundTrackerStats s = stats_;
+    s.avg_latency_ns =
+        s.latency_samples > 0 ? latency_total_ns_ / static_cast<int64_t>(s.latency_samples) : 0;
+    return s;
+}
+
+}  // namespace display_commander::feature::foreground
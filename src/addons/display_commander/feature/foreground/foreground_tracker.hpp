@@ -0,0 +1,79 @@
+// Source Code <Display Commander> // Foreground/background state machine (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::feature::foreground {
+
+enum class ForegroundEventSource : uint8_t {
+    kWinEvent = 0,  // EVENT_SYSTEM_FOREGROUND / EVENT_SYSTEM_MINIMIZESTART / EVENT_SYSTEM_MINIMIZEEND
+    kWindowProc,    // WM_ACTIVATEAPP / WM_ACTIVATE seen by our window proc
+    kPoll,          // Slow safety-net poll from continuous monitoring
+    kCount
+};
+
+const char* ForegroundEventSourceName(ForegroundEventSource source);
+
+enum class ForegroundEventKind : uint8_t {
+    kForeground = 0,  // Foreground window changed (or was re-checked); foreground_is_ours is authoritative
+    kMinimizeStart,   // Our window started minimizing: background until restored
+    kMinimizeEnd,     // Our window was restored; foreground_is_ours is re-checked by the reporter
+};
+
+struct ForegroundEvent {
+    ForegroundEventKind kind = ForegroundEventKind::kForeground;
+    ForegroundEventSource source = ForegroundEventSource::kPoll;
+    bool foreground_is_ours = false;  // Foreground window belongs to this process (at report time)
+    bool minimized = false;           // kPoll only: game window is iconic
+    int64_t event_time_ns = 0;        // When the change was received (get_now_ns, <= report time)
+};
+
+struct ForegroundUpdate {
+    bool changed = false;
+    bool in_background = false;
+    int64_t latency_ns = 0;  // event_time -> state update; 0 for poll-detected changes (time of change unknown)
+};
+
+struct ForegroundTrackerStats {
+    uint64_t transitions = 0;
+    uint64_t events[static_cast<size_t>(ForegroundEventSource::kCount)] = {};
+    uint64_t stale_events = 0;      // Older than the last applied event (reordered across reporter threads)
+    uint64_t deferred_polls = 0;    // Polls ignored within kPollGraceNs of a pushed event
+    uint64_t poll_corrections = 0;  // Changes only the safety-net poll noticed (missed / lost events)
+    uint64_t latency_samples = 0;
+    int64_t last_latency_ns = 0;
+    int64_t max_latency_ns = 0;
+    int64_t avg_latency_ns = 0;
+};
+
+// Derives "app in background" from pushed foreground/minimize/activation events, with a periodic poll as a
+// correction. Deterministic: events carry their own timestamps, so a scripted sequence reproduces a run.
+// Not thread-safe; the owner serializes calls.
+class ForegroundTracker {
+   public:
+    // A poll within this long after a pushed event is ignored: the pushed state is newer than what a poll can see
+    // (e.g. IsIconic is still false while the minimize animation runs).
+    static constexpr int64_t kPollGraceNs = 250 * 1000000LL;
+
+    ForegroundUpdate OnEvent(const ForegroundEvent& event, int64_t now_ns);
+
+    // False until the first event.
+    bool IsKnown() const { return known_; }
+    bool InBackground() const { return in_background_; }
+    bool IsMinimized() const { return minimized_; }
+
+    ForegroundTrackerStats GetStats() const;
+
+   private:
+    bool known_ = false;
+    bool in_background_ = false;
+    bool minimized_ = false;
+    int64_t last_event_time_ns_ = 0;
+    int64_t last_push_report_ns_ = 0;
+    int64_t latency_total_ns_ = 0;
+    ForegroundTrackerStats stats_{};
+};
+
+}  // namespace display_commander::feature::foreground
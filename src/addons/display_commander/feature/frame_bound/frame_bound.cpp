@@ -0,0 +1,101 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "frame_bound.hpp"
+#include "../../globals.hpp"
+#include "../../utils/logging.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace display_commander::feature::frame_bound {
+
+namespace {
+
+// Frames younger than this are not analyzed yet (GPU completion may still be pending; ring holds up to 8).
+constexpr uint64_t kAnalysisFrameLag = 8;
+
+FrameBoundAnalyzer g_analyzer;  // Continuous monitoring thread only
+uint64_t g_last_analyzed_frame_id = 0;
+BoundState g_last_logged_state = BoundState::kUnknown;
+
+std::atomic<std::shared_ptr<const BoundAnalysis>> g_latest_analysis{nullptr};
+std::atomic<bool> g_injected_sleep_recommended{true};
+
+FrameTimeline ReadTimeline(const FrameData& fd, uint64_t frame_id) {
+    FrameTimeline t;
+    t.frame_id = frame_id;
+    t.sim_start_ns = fd.sim_start_ns.load(std::memory_order_relaxed);
+    t.submit_start_ns = fd.submit_start_time_ns.load(std::memory_order_relaxed);
+    t.present_start_ns = fd.present_start_time_ns.load(std::memory_order_relaxed);
+    t.present_end_ns = fd.present_end_time_ns.load(std::memory_order_relaxed);
+    t.gpu_done_ns = fd.gpu_completion_time_ns.load(std::memory_order_acquire);
+
+    LONGLONG sleep_ns = 0;
+    const LONGLONG pre_start = fd.sleep_pre_present_start_time_ns.load(std::memory_order_relaxed);
+    const LONGLONG pre_end = fd.sleep_pre_present_end_time_ns.load(std::memory_order_relaxed);
+    if (pre_start > 0 && pre_end > pre_start) {
+        sleep_ns += pre_end - pre_start;
+    }
+    const LONGLONG post_start = fd.sleep_post_present_start_time_ns.load(std::memory_order_relaxed);
+    const LONGLONG post_end = fd.sleep_post_present_end_time_ns.load(std::memory_order_relaxed);
+    if (post_start > 0 && post_end > post_start) {
+        sleep_ns += post_end - post_start;
+    }
+    t.limiter_sleep_ns = sleep_ns;
+    // Post-present sleep is measured from present end; exclude it from the Present blocking window.
+    if (post_start > 0 && t.present_end_ns > post_start) {
+        t.present_end_ns = post_start;
+    }
+    return t;
+}
+
+}  // namespace
+
+void ProcessFrameBoundAnalysisInContinuousMonitoring() {
+    const uint64_t current = g_global_frame_id.load(std::memory_order_acquire);
+    if (current <= kAnalysisFrameLag) {
+        return;
+    }
+    const uint64_t newest = current - kAnalysisFrameLag;
+    uint64_t next = g_last_analyzed_frame_id + 1;
+    // Fell behind the cyclic buffer (monitoring stalled): skip to the oldest slot that is still intact.
+    if (newest - next >= kFrameDataBufferSize - kAnalysisFrameLag) {
+        next = newest - (kFrameDataBufferSize - kAnalysisFrameLag) + 1;
+    }
+    if (next > newest) {
+        return;
+    }
+
+    for (uint64_t frame_id = next; frame_id <= newest; ++frame_id) {
+        const FrameData& fd = g_frame_data[frame_id % kFrameDataBufferSize];
+        if (fd.frame_id.load(std::memory_order_acquire) != frame_id) {
+            continue;  // Slot not finalized for this frame (or already reused); breaks pairing via frame_id gap
+        }
+        g_analyzer.AddFrame(ReadTimeline(fd, frame_id));
+    }
+    g_last_analyzed_frame_id = newest;
+
+    const BoundAnalysis analysis = g_analyzer.GetAnalysis();
+    g_latest_analysis.store(std::make_shared<const BoundAnalysis>(analysis), std::memory_order_release);
+
+    if (analysis.state != g_last_logged_state && analysis.confidence >= 0.8f) {
+        LogInfo("[frame_bound] %s (confidence %.0f%%, frame %.2f ms, CPU busy %.2f ms, GPU busy %.2f ms, queue %.2f)",
+                BoundStateName(analysis.state), analysis.confidence * 100.0f, analysis.frame_time_ms,
+                analysis.cpu_busy_ms, analysis.gpu_busy_ms, analysis.queue_depth);
+        g_last_logged_state = analysis.state;
+    }
+}
+
+BoundAnalysis GetLatestBoundAnalysis() {
+    const std::shared_ptr<const BoundAnalysis> p = g_latest_analysis.load(std::memory_order_acquire);
+    return p ? *p : BoundAnalysis{};
+}
+
+bool IsInjectedReflexSleepRecommended() { return g_injected_sleep_recommended.load(std::memory_order_relaxed); }
+
+void SetInjectedReflexSleepRecommended(bool recommended) {
+    g_injected_sleep_recommended.store(recommended, std::memory_order_relaxed);
+}
+
+}  // namespace display_commander::feature::frame_bound
@@ -0,0 +1,20 @@
+// Source Code <Display Commander> // CPU/GPU bound estimation feature slice
+#pragma once
+
+#include "frame_bound_analyzer.hpp"
+
+namespace display_commander::feature::frame_bound {
+
+// Continuous monitoring worker: feeds finished FrameData slots (a few frames behind the present thread so
+// GPU completion has landed) into the analyzer and publishes the rolling result.
+void ProcessFrameBoundAnalysisInContinuousMonitoring();
+
+// Latest published analysis (state kUnknown until enough frames were seen).
+BoundAnalysis GetLatestBoundAnalysis();
+
+// Runtime override from Reflex auto-configure (RecommendInjectedReflexSleep); never saved. true when auto-configure
+// is off or has no data. The injected Reflex sleep path skips the sleep while it is false.
+bool IsInjectedReflexSleepRecommended();
+void SetInjectedReflexSleepRecommended(bool recommended);
+
+}  // namespace display_commander::feature::frame_bound
@@ -0,0 +1,191 @@
+// Source Code <Display Commander> // CPU/GPU bound analysis core (platform-neutral, no Windows includes)
+#include "frame_bound_analyzer.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <iterator>
+
+namespace display_commander::feature::frame_bound {
+
+const char* BoundStateName(BoundState state) {
+    switch (state) {
+        case BoundState::kCpuBound:     return "CPU-bound";
+        case BoundState::kGpuBound:     return "GPU-bound";
+        case BoundState::kLimiterBound: return "Limiter";
+        case BoundState::kMixed:        return "Mixed";
+        default:                        return "Unknown";
+    }
+}
+
+bool RecommendInjectedReflexSleep(const BoundAnalysis& analysis, bool currently_enabled) {
+    if (analysis.state == BoundState::kUnknown) {
+        return true;
+    }
+    const bool cpu_bound = analysis.state == BoundState::kCpuBound;
+    if (currently_enabled) {
+        return !(cpu_bound && analysis.confidence >= 0.8f && analysis.queue_depth < 0.5);
+    }
+    return !(cpu_bound && analysis.confidence >= 0.5f && analysis.queue_depth < 1.0);
+}
+
+BoundState FrameBoundAnalyzer::ClassifySample(const FrameBoundSample& s) {
+    if (s.frame_interval_ns <= 0) {
+        return BoundState::kUnknown;
+    }
+    const double interval = static_cast<double>(s.frame_interval_ns);
+    const double cpu_util = static_cast<double>(s.cpu_busy_ns) / interval;
+    const double present_block_share = static_cast<double>(s.present_block_ns) / interval;
+    const double limiter_share = static_cast<double>(s.limiter_sleep_ns) / interval;
+
+    if (s.gpu_valid) {
+        const double gpu_util = static_cast<double>(s.gpu_busy_ns) / interval;
+        if (gpu_util >= kSaturatedUtilization
+            && (s.queue_depth >= 1 || present_block_share >= kPresentBlockShare || cpu_util < gpu_util)) {
+            return BoundState::kGpuBound;
+        }
+        if (limiter_share >= kLimiterSleepShare) {
+            return BoundState::kLimiterBound;
+        }
+        if (cpu_util >= kSaturatedUtilization && gpu_util < kSaturatedUtilization) {
+            return BoundState::kCpuBound;
+        }
+        return BoundState::kMixed;
+    }
+
+    // No GPU completion data: Present back-pressure is the only GPU signal.
+    if (limiter_share >= kLimiterSleepShare) {
+        return BoundState::kLimiterBound;
+    }
+    if (present_block_share >= kPresentBlockShare) {
+        return BoundState::kGpuBound;
+    }
+    if (cpu_util >= kSaturatedUtilization) {
+        return BoundState::kCpuBound;
+    }
+    return BoundState::kMixed;
+}
+
+bool FrameBoundAnalyzer::AddFrame(const FrameTimeline& frame, FrameBoundSample* out_sample) {
+    const bool paired = has_prev_ && frame.frame_id == prev_.frame_id + 1 && prev_.present_start_ns > 0
+                        && frame.present_start_ns > prev_.present_start_ns;
+
+    int64_t gpu_start_ns = 0;
+    FrameBoundSample s{};
+    if (paired) {
+        s.frame_interval_ns = frame.present_start_ns - prev_.present_start_ns;
+        s.limiter_sleep_ns = std::clamp<int64_t>(frame.limiter_sleep_ns, 0, s.frame_interval_ns);
+        if (frame.present_end_ns >= frame.present_start_ns) {
+            s.present_block_ns = std::min(frame.present_end_ns - frame.present_start_ns, s.frame_interval_ns);
+        }
+        s.cpu_busy_ns = std::max<int64_t>(0, s.frame_interval_ns - s.limiter_sleep_ns - s.present_block_ns);
+
+        s.gpu_valid = frame.gpu_done_ns > 0 && prev_.gpu_done_ns > 0 && frame.gpu_done_ns >= prev_.gpu_done_ns;
+        if (s.gpu_valid) {
+            // GPU can start frame n once frame n-1 is done and the CPU has started submitting frame n.
+            const int64_t submit_ns = frame.submit_start_ns > 0 ? frame.submit_start_ns : frame.present_start_ns;
+            gpu_start_ns = std::min(std::max(prev_.gpu_done_ns, submit_ns), frame.gpu_done_ns);
+            s.gpu_busy_ns = std::min(frame.gpu_done_ns - gpu_start_ns, s.frame_interval_ns);
+
+            // CPU window of frame n vs GPU window of frame n-1.
+            const int64_t cpu_begin_ns = frame.sim_start_ns > 0 ? frame.sim_start_ns : prev_.present_end_ns;
+            if (cpu_begin_ns > 0 && prev_gpu_start_ns_ > 0) {
+                const int64_t lo = std::max(cpu_begin_ns, prev_gpu_start_ns_);
+                const int64_t hi = std::min(frame.present_start_ns, prev_.gpu_done_ns);
+                s.overlap_ns = std::max<int64_t>(0, hi - lo);
+            }
+        }
+
+        uint8_t depth = 0;
+        for (const int64_t done_ns : recent_gpu_done_ns_) {
+            if (done_ns > frame.present_start_ns) {
+                ++depth;
+            }
+        }
+        s.queue_depth = depth;
+        s.state = ClassifySample(s);
+
+        samples_[sample_head_] = s;
+        sample_head_ = (sample_head_ + 1) % kWindowSize;
+        sample_count_ = std::min(sample_count_ + 1, kWindowSize);
+    } else if (has_prev_ && frame.frame_id != prev_.frame_id + 1) {
+        // Gap in the frame sequence: queue history no longer refers to adjacent frames.
+        std::fill(std::begin(recent_gpu_done_ns_), std::end(recent_gpu_done_ns_), 0);
+    }
+
+    recent_gpu_done_ns_[recent_gpu_head_] = frame.gpu_done_ns;
+    recent_gpu_head_ = (recent_gpu_head_ + 1) % kGpuHistory;
+    prev_ = frame;
+    prev_gpu_start_ns_ = gpu_start_ns;
+    has_prev_ = true;
+
+    if (paired && out_sample != nullptr) {
+        *out_sample = s;
+    }
+    return paired;
+}
+
+BoundAnalysis FrameBoundAnalyzer::GetAnalysis() const {
+    BoundAnalysis out;
+    if (sample_count_ == 0) {
+        return out;
+    }
+
+    uint32_t votes[5] = {};
+    double sum_interval = 0.0;
+    double sum_cpu = 0.0;
+    double sum_gpu = 0.0;
+    double sum_overlap = 0.0;
+    double sum_queue = 0.0;
+    double sum_gpu_interval = 0.0;
+    for (size_t i = 0; i < sample_count_; ++i) {
+        const FrameBoundSample& s = samples_[i];
+        votes[static_cast<size_t>(s.state)]++;
+        sum_interval += static_cast<double>(s.frame_interval_ns);
+        sum_cpu += static_cast<double>(s.cpu_busy_ns);
+        sum_queue += static_cast<double>(s.queue_depth);
+        if (s.gpu_valid) {
+            out.gpu_samples++;
+            sum_gpu += static_cast<double>(s.gpu_busy_ns);
+            sum_overlap += static_cast<double>(s.overlap_ns);
+            sum_gpu_interval += static_cast<double>(s.frame_interval_ns);
+        }
+    }
+
+    const double n = static_cast<double>(sample_count_);
+    out.samples = static_cast<uint32_t>(sample_count_);
+    out.frame_time_ms = sum_interval / n / 1e6;
+    out.cpu_busy_ms = sum_cpu / n / 1e6;
+    out.queue_depth = sum_queue / n;
+    out.cpu_utilization = sum_interval > 0.0 ? sum_cpu / sum_interval : 0.0;
+    if (out.gpu_samples > 0) {
+        const double g = static_cast<double>(out.gpu_samples);
+        out.gpu_busy_ms = sum_gpu / g / 1e6;
+        out.overlap_ms = sum_overlap / g / 1e6;
+        out.gpu_utilization = sum_gpu_interval > 0.0 ? sum_gpu / sum_gpu_interval : 0.0;
+    }
+
+    size_t best = static_cast<size_t>(BoundState::kUnknown);
+    for (size_t i = 1; i < 5; ++i) {
+        if (votes[i] > votes[best]) {
+            best = i;
+        }
+    }
+    const uint32_t classified = out.samples - votes[static_cast<size_t>(BoundState::kUnknown)];
+    if (classified == 0 || best == static_cast<size_t>(BoundState::kUnknown)) {
+        return out;
+    }
+    out.state = static_cast<BoundState>(best);
+
+    double confidence = static_cast<double>(votes[best]) / static_cast<double>(classified);
+    confidence *= std::min(1.0, static_cast<double>(classified) / static_cast<double>(kFullConfidenceSamples));
+    // Present back-pressure alone is a weaker signal than GPU completion timestamps.
+    if (out.gpu_samples * 2 < out.samples) {
+        confidence *= 0.5;
+    }
+    out.confidence = static_cast<float>(confidence);
+    return out;
+}
+
+void FrameBoundAnalyzer::Reset() { *this = FrameBoundAnalyzer{}; }
+
+}  // namespace display_commander::feature::frame_bound
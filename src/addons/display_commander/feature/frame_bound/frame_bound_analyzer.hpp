@@ -0,0 +1,105 @@
+// Source Code <Display Commander> // CPU/GPU bound analysis core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::feature::frame_bound {
+
+// Timestamps of one finished frame, copied from FrameData (all ns on the same clock; 0 = not recorded).
+struct FrameTimeline {
+    uint64_t frame_id = 0;
+    int64_t sim_start_ns = 0;
+    int64_t submit_start_ns = 0;
+    int64_t present_start_ns = 0;
+    int64_t present_end_ns = 0;
+    int64_t gpu_done_ns = 0;
+    // FPS limiter sleep attributed to this frame (pre-present + post-present pacing).
+    int64_t limiter_sleep_ns = 0;
+};
+
+enum class BoundState : uint8_t {
+    kUnknown = 0,  // Not enough samples
+    kCpuBound,     // CPU thread busy for the whole frame, GPU waits
+    kGpuBound,     // GPU busy for the whole frame, CPU waits in Present / queue is full
+    kLimiterBound, // Neither saturated; frame rate set by the FPS limiter
+    kMixed,        // Neither saturated and no limiter sleep (VSync, OS throttling, alternating)
+};
+
+const char* BoundStateName(BoundState state);
+
+// Per-frame values derived from two consecutive timelines.
+struct FrameBoundSample {
+    int64_t frame_interval_ns = 0;  // present_start[n] - present_start[n-1]
+    int64_t cpu_busy_ns = 0;        // interval minus limiter sleep and time blocked in Present
+    int64_t gpu_busy_ns = 0;        // gpu_done[n] - max(gpu_done[n-1], submit_start[n]); 0 when !gpu_valid
+    int64_t overlap_ns = 0;         // CPU work on frame n overlapping GPU work on frame n-1
+    int64_t present_block_ns = 0;   // present_end[n] - present_start[n]
+    int64_t limiter_sleep_ns = 0;
+    uint8_t queue_depth = 0;        // Earlier frames still on the GPU when frame n was presented
+    bool gpu_valid = false;         // GPU completion timestamps available for n and n-1
+    BoundState state = BoundState::kUnknown;
+};
+
+// Rolling result over the analyzer window.
+struct BoundAnalysis {
+    BoundState state = BoundState::kUnknown;
+    float confidence = 0.0f;  // 0..1: agreement of per-frame votes, scaled down for few samples / no GPU data
+    uint32_t samples = 0;
+    uint32_t gpu_samples = 0;  // Samples with GPU completion data
+    double frame_time_ms = 0.0;
+    double cpu_busy_ms = 0.0;
+    double gpu_busy_ms = 0.0;
+    double overlap_ms = 0.0;
+    double cpu_utilization = 0.0;  // cpu_busy / frame interval (0..1)
+    double gpu_utilization = 0.0;  // gpu_busy / frame interval (0..1), 0 without GPU data
+    double queue_depth = 0.0;      // Average render queue depth
+};
+
+// Auto-configure (continuous_monitoring HandleReflexAutoConfigure): injected Reflex sleep only helps while frames
+// queue up behind the GPU. Returns false once the window is confidently CPU-bound with an empty render queue, true
+// again when that no longer holds; the two thresholds keep it from flapping. No data keeps the sleep enabled.
+bool RecommendInjectedReflexSleep(const BoundAnalysis& analysis, bool currently_enabled);
+
+// Derives GPU busy time, CPU/GPU overlap and render-queue depth per frame and keeps a rolling
+// bound-ness classification. Frames must be fed in increasing frame_id order; a gap resets pairing.
+// Not thread-safe: owned by one thread (continuous monitoring), results published by the caller.
+class FrameBoundAnalyzer {
+   public:
+    static constexpr size_t kWindowSize = 128;
+    // Confidence reaches full weight after this many samples.
+    static constexpr uint32_t kFullConfidenceSamples = 60;
+    // Utilization at or above which a resource counts as saturated.
+    static constexpr double kSaturatedUtilization = 0.85;
+    // Limiter sleep share of the frame above which the frame counts as limiter-paced.
+    static constexpr double kLimiterSleepShare = 0.10;
+    // Present blocking share of the frame that indicates back-pressure from the GPU.
+    static constexpr double kPresentBlockShare = 0.15;
+
+    // Returns false when the frame could not be paired with the previous one (first frame, gap, bad timestamps).
+    bool AddFrame(const FrameTimeline& frame, FrameBoundSample* out_sample = nullptr);
+
+    BoundAnalysis GetAnalysis() const;
+
+    void Reset();
+
+    static BoundState ClassifySample(const FrameBoundSample& sample);
+
+   private:
+    static constexpr size_t kGpuHistory = 8;
+
+    FrameBoundSample samples_[kWindowSize] = {};
+    size_t sample_head_ = 0;
+    size_t sample_count_ = 0;
+
+    bool has_prev_ = false;
+    FrameTimeline prev_{};
+    int64_t prev_gpu_start_ns_ = 0;
+
+    // GPU completion times of the most recent frames (for queue depth).
+    int64_t recent_gpu_done_ns_[kGpuHistory] = {};
+    size_t recent_gpu_head_ = 0;
+};
+
+}  // namespace display_commander::feature::frame_bound
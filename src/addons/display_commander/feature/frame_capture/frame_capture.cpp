@@ -0,0 +1,482 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "frame_capture.hpp"
+#include "frame_capture_writer.hpp"
+#include "../reflex_latency/reflex_latency.hpp"
+#include "../../globals.hpp"
+#include "../../settings/main_tab_settings.hpp"
+#include "../../swapchain_events.hpp"
+#include "../../utils/general_utils.hpp"
+#include "../../utils/logging.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Libraries <Windows.h>
+#include <Windows.h>
+
+namespace display_commander::feature::frame_capture {
+
+namespace {
+
+// No per-duration frame budget: capacity is what kMaxChunks chunks hold (~2M frames, 35 min at 1000 FPS), and the
+// chunks are mapped as they fill, so a high frame rate is not cut off and a short capture stays small
+constexpr uint64_t kMaxCaptureRecords = UINT64_MAX;  // FrameCaptureWriter::Open limits it to kMaxChunks chunks
+// The file grows by this much at a time (65536 records; a multiple of the 64 KB view alignment), so a capture only
+// maps what it has used plus one chunk
+constexpr size_t kChunkBytes = 8 * 1024 * 1024;
+constexpr int kCaptureThreadPollMs = 100;
+constexpr uint64_t kRecordDelayFrames = 8;      // GPU completion for a frame lands a few frames later
+constexpr size_t kSideInfoRing = kFrameDataBufferSize;
+static_assert(kRecordDelayFrames < kSideInfoRing, "Delayed frame must still be in the FrameData ring");
+
+// Per-frame values that are not in FrameData, sampled when the frame is finalized. Present thread only.
+struct SideInfo {
+    uint64_t frame_id = 0;
+    int64_t late_amount_ns = 0;
+    uint32_t reflex_pc_latency_us = 0;
+    float target_fps = 0.0f;
+    int8_t fg_mode = 0;
+    uint8_t fps_limiter_mode = 0;
+    uint8_t flags = 0;
+};
+std::array<SideInfo, kSideInfoRing> g_side_info = {};
+
+// Present thread checks g_active, then holds g_in_flight while appending; Stop clears g_active and waits for
+// g_in_flight to drain before the views are unmapped. Both sides store one flag and load the other, so those
+// operations are seq_cst.
+std::atomic<bool> g_active{false};
+std::atomic<int> g_in_flight{0};
+FrameCaptureWriter g_writer;
+
+using ChunkViews = std::array<void*, FrameCaptureWriter::kMaxChunks>;
+
+// Capture session and status, under g_mutex (UI, hotkeys, capture thread)
+std::mutex g_mutex;
+std::condition_variable g_capture_wake;  // Capture stopped
+std::thread g_capture_thread;  // Maps chunks, stops at the deadline, finalizes; joined by the next Start or shutdown
+HANDLE g_file = INVALID_HANDLE_VALUE;
+ChunkViews g_views = {};
+bool g_finalizing = false;
+int64_t g_deadline_ns = 0;  // 0 = until stopped
+int64_t g_start_ns = 0;
+int64_t g_stop_ns = 0;
+int g_duration_s = 0;
+FrameCaptureStatus g_last;  // path, outputs, summary and error of the current / last capture
+
+const char* RuntimeName(reshade::api::device_api api) {
+    switch (api) {
+        case reshade::api::device_api::d3d9:   return "D3D9";
+        case reshade::api::device_api::d3d10:
+        case reshade::api::device_api::d3d11:
+        case reshade::api::device_api::d3d12:  return "DXGI";
+        case reshade::api::device_api::opengl: return "OpenGL";
+        case reshade::api::device_api::vulkan: return "Vulkan";
+        default:                               return "Other";
+    }
+}
+
+void CopyName(const std::string& name, char* out, size_t out_size) {
+    const size_t n = (std::min)(name.size(), out_size - 1);
+    std::copy_n(name.data(), n, out);
+    out[n] = '\0';
+}
+
+std::filesystem::path OutputPath(const std::filesystem::path& capture_path, const char* extension) {
+    std::filesystem::path path = capture_path;
+    return path.replace_extension(extension);
+}
+
+// Writes .csv and .summary.txt beside the capture file.
+bool WriteOutputs(const FrameCaptureData& data, const std::filesystem::path& capture_path,
+                  const FrameCaptureSummary& summary, std::string* error) {
+    const std::filesystem::path csv_path = OutputPath(capture_path, ".csv");
+    std::ofstream csv(csv_path, std::ios::binary | std::ios::trunc);
+    if (!csv) {
+        *error = "Cannot open " + csv_path.string();
+        return false;
+    }
+    WriteFrameCaptureCsv(data, csv);
+    const std::filesystem::path summary_path = OutputPath(capture_path, ".summary.txt");
+    std::ofstream summary_file(summary_path, std::ios::binary | std::ios::trunc);
+    if (!summary_file) {
+        *error = "Cannot open " + summary_path.string();
+        return false;
+    }
+    WriteFrameCaptureSummary(data, summary, summary_file);
+    if (!csv || !summary_file) {
+        *error = "Write failed: " + csv_path.string();
+        return false;
+    }
+    return true;
+}
+
+// Maps file bytes [index * kChunkBytes, + kChunkBytes), growing the file to the end of the chunk.
+void* MapChunk(HANDLE file, size_t index) {
+    const uint64_t end = static_cast<uint64_t>(index + 1) * kChunkBytes;
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(end >> 32),
+                                        static_cast<DWORD>(end & 0xFFFFFFFFu), nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+    const uint64_t offset = static_cast<uint64_t>(index) * kChunkBytes;
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32),
+                               static_cast<DWORD>(offset & 0xFFFFFFFFu), kChunkBytes);
+    CloseHandle(mapping);  // The view keeps the section alive
+    return view;
+}
+
+// Unmaps every chunk, then truncates the file to used_bytes (0 = leave the size).
+void CloseCaptureFile(HANDLE file, const ChunkViews& views, size_t used_bytes) {
+    for (void* view : views) {
+        if (view != nullptr) {
+            FlushViewOfFile(view, 0);
+            UnmapViewOfFile(view);
+        }
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+        if (used_bytes != 0) {
+            LARGE_INTEGER size = {};
+            size.QuadPart = static_cast<LONGLONG>(used_bytes);
+            if (SetFilePointerEx(file, size, nullptr, FILE_BEGIN)) {
+                SetEndOfFile(file);
+            }
+        }
+        CloseHandle(file);
+    }
+}
+
+// Reads a .dcfc file and writes .csv and .summary.txt beside it.
+bool ConvertFile(const std::filesystem::path& path, FrameCaptureData* data, FrameCaptureSummary* summary,
+                 std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        *error = "Cannot open " + path.string();
+        return false;
+    }
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!ReadFrameCapture(bytes.data(), bytes.size(), data, error)) {
+        return false;
+    }
+    *summary = SummarizeFrameCapture(*data);
+    return WriteOutputs(*data, path, *summary, error);
+}
+
+// Under g_mutex. Stops the writers; false when no capture is active.
+bool StopWritersLocked() {
+    if (!g_active.exchange(false)) {
+        return false;
+    }
+    while (g_in_flight.load() != 0) {
+        std::this_thread::yield();
+    }
+    g_stop_ns = utils::get_now_ns();
+    g_finalizing = true;
+    return true;
+}
+
+// After the writers stopped: the file is truncated to the records written, then converted.
+void FinalizeCapture(const std::filesystem::path& path) {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    ChunkViews views = {};
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        file = g_file;
+        views = g_views;
+        g_file = INVALID_HANDLE_VALUE;
+        g_views = {};
+    }
+    const size_t used_bytes = g_writer.Finish();
+    CloseCaptureFile(file, views, used_bytes);
+
+    FrameCaptureData data;
+    FrameCaptureSummary summary;
+    std::string error;
+    const bool converted = ConvertFile(path, &data, &summary, &error);
+    if (converted) {
+        LogInfo("Frame capture: %llu frames, %.1f s, avg %.1f FPS, 1%% low %.1f FPS -> %s",
+                static_cast<unsigned long long>(data.records.size()), summary.duration_s, summary.avg_fps,
+                summary.low_1pct_fps, path.string().c_str());
+    } else {
+        LogWarn("Frame capture: conversion failed: %s", error.c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_finalizing = false;
+    g_last.frames = data.records.size();
+    g_last.dropped = data.header.dropped;
+    g_last.has_summary = converted;
+    g_last.summary = summary;
+    g_last.csv_path = converted ? OutputPath(path, ".csv").string() : std::string();
+    g_last.summary_path = converted ? OutputPath(path, ".summary.txt").string() : std::string();
+    g_last.error = converted ? std::string() : error;
+}
+
+// Capture thread: maps the next chunk before the writer runs out, stops at the deadline, then finalizes.
+void RunCaptureThread(std::filesystem::path path) {
+    {
+        std::unique_lock<std::mutex> lock(g_mutex);
+        bool can_grow = true;
+        while (g_active.load(std::memory_order_relaxed)) {
+            if (g_deadline_ns != 0 && utils::get_now_ns() >= g_deadline_ns) {
+                StopWritersLocked();
+                break;
+            }
+            if (can_grow && g_writer.NeedsChunk()) {
+                const size_t index = g_writer.MappedChunks();
+                void* view = MapChunk(g_file, index);
+                if (view != nullptr && g_writer.AddChunk(view)) {
+                    g_views[index] = view;
+                } else {
+                    // Frames past the mapped chunks are dropped (counted in the header)
+                    LogWarn("Frame capture: cannot grow %s past %zu MB (error %lu)", path.string().c_str(),
+                            index * kChunkBytes / (1024 * 1024), GetLastError());
+                    if (view != nullptr) {
+                        UnmapViewOfFile(view);
+                    }
+                    can_grow = false;
+                }
+            }
+            g_capture_wake.wait_for(lock, std::chrono::milliseconds(kCaptureThreadPollMs));
+        }
+    }
+    FinalizeCapture(path);
+}
+
+void AppendFrame(uint64_t frame_id) {
+    SideInfo& side = g_side_info[frame_id % kSideInfoRing];
+    side.frame_id = frame_id;
+    side.late_amount_ns = ::late_amount_ns.load(std::memory_order_relaxed);
+    side.reflex_pc_latency_us = reflex_latency::GetLatestReflexPcLatencyUs();
+    side.target_fps = GetTargetFps();
+    side.fg_mode = static_cast<int8_t>(GetDLSSGSummaryLite().fg_mode);
+    side.fps_limiter_mode = static_cast<uint8_t>(s_fps_limiter_mode.load(std::memory_order_relaxed));
+    side.flags = 0;
+    if (g_app_in_background.load(std::memory_order_relaxed)) {
+        side.flags |= kFrameCaptureFlagBackground;
+    }
+    if (IsNativeReflexActive() || IsInjectedReflexEnabled()) {
+        side.flags |= kFrameCaptureFlagReflexActive;
+    }
+
+    if (frame_id <= kRecordDelayFrames) {
+        return;
+    }
+    const uint64_t target = frame_id - kRecordDelayFrames;
+    const SideInfo& target_side = g_side_info[target % kSideInfoRing];
+    const FrameData& fd = g_frame_data[target % kFrameDataBufferSize];
+    // Frames finalized before the capture started (no side info) or slots already reused are skipped
+    if (target_side.frame_id != target || fd.frame_id.load(std::memory_order_relaxed) != target) {
+        return;
+    }
+
+    FrameCaptureRecord record;
+    record.frame_id = target;
+    record.sim_start_ns = fd.sim_start_ns.load(std::memory_order_relaxed);
+    record.submit_start_ns = fd.submit_start_time_ns.load(std::memory_order_relaxed);
+    record.render_submit_end_ns = fd.render_submit_end_time_ns.load(std::memory_order_relaxed);
+    record.present_start_ns = fd.present_start_time_ns.load(std::memory_order_relaxed);
+    record.present_end_ns = fd.present_end_time_ns.load(std::memory_order_relaxed);
+    record.gpu_completion_ns = fd.gpu_completion_time_ns.load(std::memory_order_acquire);
+    record.sleep_pre_present_start_ns = fd.sleep_pre_present_start_time_ns.load(std::memory_order_relaxed);
+    record.sleep_pre_present_end_ns = fd.sleep_pre_present_end_time_ns.load(std::memory_order_relaxed);
+    record.sleep_post_present_start_ns = fd.sleep_post_present_start_time_ns.load(std::memory_order_relaxed);
+    record.sleep_post_present_end_ns = fd.sleep_post_present_end_time_ns.load(std::memory_order_relaxed);
+    record.late_amount_ns = target_side.late_amount_ns;
+    record.reflex_pc_latency_us = target_side.reflex_pc_latency_us;
+    record.target_fps = target_side.target_fps;
+    record.fg_mode = target_side.fg_mode;
+    record.fps_limiter_mode = target_side.fps_limiter_mode;
+    record.flags = target_side.flags;
+    if (record.gpu_completion_ns != 0) {
+        record.flags |= kFrameCaptureFlagGpuCompletion;
+    }
+    g_writer.Append(record);
+}
+
+}  // namespace
+
+bool StartFrameCapture(int duration_s) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_active.load(std::memory_order_relaxed) || g_finalizing || g_shutdown.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (g_capture_thread.joinable()) {
+        g_capture_thread.join();  // Previous capture is finalized; its thread has only returning left
+    }
+    duration_s = (std::max)(duration_s, 0);
+
+    std::error_code ec;
+    const std::filesystem::path folder = GetDisplayCommanderAppDataFolder() / "frame_captures";
+    std::filesystem::create_directories(folder, ec);
+    const std::filesystem::path exe_path(GetCurrentProcessPathW());
+    const std::string exe_name = exe_path.filename().string();
+    char file_name[64] = "capture.dcfc";
+    const std::time_t raw_time = std::time(nullptr);
+    std::tm time_info = {};
+    if (localtime_s(&time_info, &raw_time) == 0) {
+        strftime(file_name, sizeof(file_name), "_%Y%m%d_%H%M%S.dcfc", &time_info);
+    }
+    const std::filesystem::path path = folder / (exe_path.stem().string() + file_name);
+
+    g_last = FrameCaptureStatus();
+    g_last.path = path.string();
+    g_last.duration_s = duration_s;
+
+    g_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (g_file == INVALID_HANDLE_VALUE) {
+        g_last.error = "Cannot create " + path.string();
+        return false;
+    }
+    g_views = {};
+    g_views[0] = MapChunk(g_file, 0);
+
+    FrameCaptureHeader header;
+    header.start_ns = utils::get_now_ns();
+    header.start_unix_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+    header.process_id = GetCurrentProcessId();
+    CopyName(exe_name, header.application, sizeof(header.application));
+    CopyName(RuntimeName(g_last_reshade_device_api.load()), header.runtime, sizeof(header.runtime));
+    if (g_views[0] == nullptr || !g_writer.Open(g_views[0], kChunkBytes, kMaxCaptureRecords, header)) {
+        g_last.error = "Cannot map " + path.string() + " (error " + std::to_string(GetLastError()) + ")";
+        CloseCaptureFile(g_file, g_views, 0);
+        g_file = INVALID_HANDLE_VALUE;
+        g_views = {};
+        std::filesystem::remove(path, ec);
+        return false;
+    }
+
+    g_start_ns = header.start_ns;
+    g_stop_ns = 0;
+    g_duration_s = duration_s;
+    g_deadline_ns = duration_s > 0 ? header.start_ns + duration_s * utils::SEC_TO_NS : 0;
+    g_active.store(true);
+    g_capture_thread = std::thread(RunCaptureThread, path);
+    LogInfo("Frame capture: started (%s, %llu frames max) -> %s", duration_s > 0 ? "timed" : "until stopped",
+            static_cast<unsigned long long>(g_writer.Capacity()), path.string().c_str());
+    return true;
+}
+
+void StopFrameCapture() {
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (!StopWritersLocked()) {
+            return;
+        }
+    }
+    g_capture_wake.notify_all();
+}
+
+void ShutdownFrameCapture() {
+    StopFrameCapture();
+    std::thread capture_thread;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        capture_thread = std::move(g_capture_thread);
+    }
+    if (capture_thread.joinable()) {
+        capture_thread.join();
+    }
+}
+
+void ToggleFrameCapture() {
+    if (g_active.load(std::memory_order_relaxed)) {
+        StopFrameCapture();
+    } else {
+        StartFrameCapture(settings::g_mainTabSettings.frame_capture_duration_seconds.GetValue());
+    }
+}
+
+FrameCaptureStatus GetFrameCaptureStatus() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    FrameCaptureStatus status = g_last;
+    status.active = g_active.load(std::memory_order_relaxed);
+    status.finalizing = g_finalizing;
+    status.duration_s = g_duration_s;
+    if (status.active) {
+        status.frames = g_writer.Count();
+        status.capacity = g_writer.Capacity();
+        status.dropped = g_writer.Dropped();
+    }
+    if (g_start_ns != 0) {
+        const int64_t end_ns = status.active ? utils::get_now_ns() : g_stop_ns;
+        status.elapsed_s = static_cast<double>(end_ns - g_start_ns) / static_cast<double>(utils::SEC_TO_NS);
+    }
+    return status;
+}
+
+void RecordFrameCaptureFrame(uint64_t frame_id) {
+    if (!g_active.load(std::memory_order_relaxed)) {
+        return;
+    }
+    g_in_flight.fetch_add(1);
+    if (g_active.load()) {
+        AppendFrame(frame_id);
+    }
+    g_in_flight.fetch_sub(1, std::memory_order_release);
+}
+
+bool ConvertFrameCaptureFile(const std::filesystem::path& path, FrameCaptureSummary* summary, std::string* error) {
+    FrameCaptureData data;
+    return ConvertFile(path, &data, summary, error);
+}
+
+}  // namespace display_commander::feature::frame_capture
+
+namespace {
+
+void RunConvertFrameCapture(std::wstring path) {
+    // Quotes and surrounding whitespace from the rundll32 command line
+    while (!path.empty() && (path.front() == L'"' || path.front() == L' ')) {
+        path.erase(path.begin());
+    }
+    while (!path.empty() && (path.back() == L'"' || path.back() == L' ' || path.back() == L'\r'
+                             || path.back() == L'\n')) {
+        path.pop_back();
+    }
+    display_commander::feature::frame_capture::FrameCaptureSummary summary;
+    std::string error;
+    if (path.empty()) {
+        OutputDebugStringA("ConvertFrameCapture: usage: rundll32 <dll>,ConvertFrameCapture <capture.dcfc>\n");
+    } else if (!display_commander::feature::frame_capture::ConvertFrameCaptureFile(path, &summary, &error)) {
+        OutputDebugStringA(("ConvertFrameCapture: " + error + "\n").c_str());
+    }
+}
+
+}  // namespace
+
+// rundll32 .\dc_64.dll,ConvertFrameCapture <capture.dcfc>: writes <capture>.csv and <capture>.summary.txt
+extern "C" __declspec(dllexport) void CALLBACK ConvertFrameCapture(HWND hwnd, HINSTANCE hinst, LPSTR lpszCmdLine,
+                                                                   int nCmdShow) {
+    (void)hwnd;
+    (void)hinst;
+    (void)nCmdShow;
+    wchar_t path_w[MAX_PATH] = {};
+    if (lpszCmdLine != nullptr && lpszCmdLine[0] != '\0') {
+        MultiByteToWideChar(CP_ACP, 0, lpszCmdLine, -1, path_w, MAX_PATH);
+    }
+    RunConvertFrameCapture(path_w);
+}
+
+extern "C" __declspec(dllexport) void CALLBACK ConvertFrameCaptureW(HWND hwnd, HINSTANCE hinst, LPWSTR lpszCmdLine,
+                                                                    int nCmdShow) {
+    (void)hwnd;
+    (void)hinst;
+    (void)nCmdShow;
+    RunConvertFrameCapture(lpszCmdLine != nullptr ? lpszCmdLine : L"");
+}
@@ -0,0 +1,52 @@
+// Source Code <Display Commander> // Frame capture feature slice
+#pragma once
+
+#include "frame_capture_convert.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace display_commander::feature::frame_capture {
+
+struct FrameCaptureStatus {
+    bool active = false;
+    bool finalizing = false;  // Stopped; CSV and summary still being written
+    uint64_t frames = 0;      // Records written (current capture, or the last one when idle)
+    uint64_t capacity = 0;
+    uint64_t dropped = 0;
+    double elapsed_s = 0.0;
+    int duration_s = 0;  // 0 = until stopped
+    std::string path;    // .dcfc of the current / last capture
+    std::string csv_path;
+    std::string summary_path;
+    bool has_summary = false;  // Last capture finished and was converted
+    FrameCaptureSummary summary;
+    std::string error;
+};
+
+// Starts a capture into <app data>/frame_captures/<exe>_<date>_<time>.dcfc. duration_s 0 = until stopped. False when
+// a capture is active or still finalizing, or the file could not be created (see FrameCaptureStatus::error).
+bool StartFrameCapture(int duration_s);
+
+// Stops the active capture without blocking on the file; the capture thread truncates and converts it (.csv,
+// .summary.txt).
+void StopFrameCapture();
+
+// Addon unload: stops the capture and joins the capture thread (waits for the conversion).
+void ShutdownFrameCapture();
+
+// Hotkey / UI: start with frame_capture_duration_seconds, or stop.
+void ToggleFrameCapture();
+
+FrameCaptureStatus GetFrameCaptureStatus();
+
+// Present thread, once per finalized frame (before g_global_frame_id advances). One relaxed load when idle. Frames
+// are recorded a few frames late so that GPU completion has landed in g_frame_data.
+void RecordFrameCaptureFrame(uint64_t frame_id);
+
+// Offline: .dcfc -> .csv + .summary.txt beside it. Also exported for rundll32 (ConvertFrameCapture <path>).
+bool ConvertFrameCaptureFile(const std::filesystem::path& path, FrameCaptureSummary* summary, std::string* error);
+
+}  // namespace display_commander::feature::frame_capture
@@ -0,0 +1,254 @@
+// Source Code <Display Commander> // Frame capture converter (platform-neutral, no Windows includes)
+#include "frame_capture_convert.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace display_commander::feature::frame_capture {
+
+namespace {
+
+constexpr double kNsPerMs = 1'000'000.0;
+
+double NsToMs(int64_t ns) { return static_cast<double>(ns) / kNsPerMs; }
+
+int64_t PresentTimeNs(const FrameCaptureRecord& record) {
+    return record.present_start_ns != 0 ? record.present_start_ns : record.present_end_ns;
+}
+
+// Nearest-rank percentile of an ascending list
+double Percentile(const std::vector<double>& sorted, double pct) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    // Tolerance: 99.9 / 100 * 1000 is slightly above 999 in binary
+    const double rank = std::ceil(pct / 100.0 * static_cast<double>(sorted.size()) - 1e-9);
+    const size_t index = static_cast<size_t>((std::max)(rank, 1.0)) - 1;
+    return sorted[(std::min)(index, sorted.size() - 1)];
+}
+
+// 1000 / mean of the slowest pct% (at least one frame)
+double LowFps(const std::vector<double>& sorted, double pct) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t count = (std::max)(size_t{1}, static_cast<size_t>(static_cast<double>(sorted.size()) * pct / 100.0));
+    double sum = 0.0;
+    for (size_t i = sorted.size() - count; i < sorted.size(); ++i) {
+        sum += sorted[i];
+    }
+    const double mean_ms = sum / static_cast<double>(count);
+    return mean_ms > 0.0 ? 1000.0 / mean_ms : 0.0;
+}
+
+}  // namespace
+
+bool ReadFrameCapture(const void* data, size_t size, FrameCaptureData* out, std::string* error) {
+    if (data == nullptr || size < sizeof(FrameCaptureHeader)) {
+        *error = "file too small for a capture header";
+        return false;
+    }
+    std::memcpy(&out->header, data, sizeof(FrameCaptureHeader));
+    const FrameCaptureHeader& header = out->header;
+    if (header.magic != kFrameCaptureMagic) {
+        *error = "not a Display Commander frame capture (bad magic)";
+        return false;
+    }
+    if (header.version != kFrameCaptureVersion || header.header_size != sizeof(FrameCaptureHeader)
+        || header.record_size != sizeof(FrameCaptureRecord)) {
+        *error = "unsupported capture version " + std::to_string(header.version);
+        return false;
+    }
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data) + sizeof(FrameCaptureHeader);
+    const uint64_t slots_in_file = (size - sizeof(FrameCaptureHeader)) / sizeof(FrameCaptureRecord);
+    const bool finished = header.record_count > 0;
+    const uint64_t slots = (std::min)(finished ? header.record_count : header.capacity, slots_in_file);
+    out->records.clear();
+    out->records.reserve(static_cast<size_t>(slots));
+    out->torn_records = 0;
+    for (uint64_t slot = 0; slot < slots; ++slot) {
+        FrameCaptureRecord record;
+        std::memcpy(&record, bytes + slot * sizeof(FrameCaptureRecord), sizeof(FrameCaptureRecord));
+        if (record.sequence == slot + 1) {
+            out->records.push_back(record);
+        } else if (record.sequence == 0 && !finished) {
+            break;  // Never claimed: end of an unfinished capture
+        } else {
+            ++out->torn_records;
+        }
+    }
+    return true;
+}
+
+bool FrameCaptureFrameTimeNs(const std::vector<FrameCaptureRecord>& records, size_t i, int64_t* frame_time_ns) {
+    if (i == 0 || i >= records.size() || records[i].frame_id != records[i - 1].frame_id + 1) {
+        return false;
+    }
+    const int64_t current_ns = PresentTimeNs(records[i]);
+    const int64_t previous_ns = PresentTimeNs(records[i - 1]);
+    if (current_ns == 0 || previous_ns == 0 || current_ns <= previous_ns) {
+        return false;
+    }
+    *frame_time_ns = current_ns - previous_ns;
+    return true;
+}
+
+FrameCaptureSummary SummarizeFrameCapture(const FrameCaptureData& data) {
+    FrameCaptureSummary summary;
+    const std::vector<FrameCaptureRecord>& records = data.records;
+    std::vector<double> frame_ms;
+    frame_ms.reserve(records.size());
+    double present_sum_ms = 0.0;
+    uint64_t present_frames = 0;
+    double sleep_sum_ms = 0.0;
+    uint64_t sleep_frames = 0;
+    double late_sum_ms = 0.0;
+    double reflex_sum_ms = 0.0;
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        const FrameCaptureRecord& r = records[i];
+        if (i > 0 && r.frame_id != records[i - 1].frame_id + 1) {
+            ++summary.gaps;
+        }
+        int64_t frame_time_ns = 0;
+        if (!FrameCaptureFrameTimeNs(records, i, &frame_time_ns)) {
+            continue;
+        }
+        frame_ms.push_back(NsToMs(frame_time_ns));
+        if (r.present_start_ns != 0 && r.present_end_ns > r.present_start_ns) {
+            present_sum_ms += NsToMs(r.present_end_ns - r.present_start_ns);
+            ++present_frames;
+        }
+        if (r.sleep_pre_present_start_ns != 0 && r.sleep_pre_present_end_ns >= r.sleep_pre_present_start_ns) {
+            sleep_sum_ms += NsToMs(r.sleep_pre_present_end_ns - r.sleep_pre_present_start_ns);
+            ++sleep_frames;
+        }
+        if (r.late_amount_ns > 0) {
+            ++summary.late_frames;
+            late_sum_ms += NsToMs(r.late_amount_ns);
+        }
+        if (r.reflex_pc_latency_us > 0) {
+            ++summary.reflex_frames;
+            reflex_sum_ms += static_cast<double>(r.reflex_pc_latency_us) / 1000.0;
+        }
+    }
+
+    summary.frames = frame_ms.size();
+    if (frame_ms.empty()) {
+        return summary;
+    }
+    double sum_ms = 0.0;
+    double sq_sum_ms = 0.0;
+    for (double ms : frame_ms) {
+        sum_ms += ms;
+        sq_sum_ms += ms * ms;
+    }
+    const double count = static_cast<double>(frame_ms.size());
+    summary.duration_s = sum_ms / 1000.0;
+    summary.avg_frame_ms = sum_ms / count;
+    summary.avg_fps = summary.avg_frame_ms > 0.0 ? 1000.0 / summary.avg_frame_ms : 0.0;
+    summary.stddev_frame_ms =
+        std::sqrt((std::max)(0.0, sq_sum_ms / count - summary.avg_frame_ms * summary.avg_frame_ms));
+
+    std::sort(frame_ms.begin(), frame_ms.end());
+    summary.min_frame_ms = frame_ms.front();
+    summary.max_frame_ms = frame_ms.back();
+    summary.p50_frame_ms = Percentile(frame_ms, 50.0);
+    summary.p90_frame_ms = Percentile(frame_ms, 90.0);
+    summary.p95_frame_ms = Percentile(frame_ms, 95.0);
+    summary.p99_frame_ms = Percentile(frame_ms, 99.0);
+    summary.p999_frame_ms = Percentile(frame_ms, 99.9);
+    summary.low_1pct_fps = LowFps(frame_ms, 1.0);
+    summary.low_01pct_fps = LowFps(frame_ms, 0.1);
+    summary.avg_present_ms = present_frames > 0 ? present_sum_ms / static_cast<double>(present_frames) : 0.0;
+    summary.avg_limiter_sleep_ms = sleep_frames > 0 ? sleep_sum_ms / static_cast<double>(sleep_frames) : 0.0;
+    summary.avg_late_ms = summary.late_frames > 0 ? late_sum_ms / static_cast<double>(summary.late_frames) : 0.0;
+    summary.avg_reflex_pc_latency_ms =
+        summary.reflex_frames > 0 ? reflex_sum_ms / static_cast<double>(summary.reflex_frames) : 0.0;
+    return summary;
+}
+
+void WriteFrameCaptureCsv(const FrameCaptureData& data, std::ostream& out) {
+    const FrameCaptureHeader& header = data.header;
+    const std::vector<FrameCaptureRecord>& records = data.records;
+    out << "Application,ProcessID,SwapChainAddress,Runtime,SyncInterval,PresentFlags,AllowsTearing,PresentMode,"
+           "Dropped,TimeInSeconds,MsBetweenPresents,MsInPresentAPI,MsUntilRenderComplete,MsBetweenSimulationStart,"
+           "MsRenderSubmit,MsFpsLimiterSleep,MsFpsLimiterLate,MsPCLatency,TargetFPS,FgMode,Background,FrameID\n";
+    char line[512];
+    const int64_t start_ns = header.start_ns;
+    for (size_t i = 0; i < records.size(); ++i) {
+        int64_t frame_time_ns = 0;
+        if (!FrameCaptureFrameTimeNs(records, i, &frame_time_ns)) {
+            continue;
+        }
+        const FrameCaptureRecord& r = records[i];
+        const FrameCaptureRecord& prev = records[i - 1];
+        const int64_t present_ns = PresentTimeNs(r);
+        const double present_api_ms = r.present_start_ns != 0 && r.present_end_ns > r.present_start_ns
+                                          ? NsToMs(r.present_end_ns - r.present_start_ns)
+                                          : 0.0;
+        const double render_complete_ms =
+            r.gpu_completion_ns != 0 && present_ns != 0 ? NsToMs(r.gpu_completion_ns - present_ns) : 0.0;
+        const double sim_delta_ms =
+            r.sim_start_ns != 0 && prev.sim_start_ns != 0 ? NsToMs(r.sim_start_ns - prev.sim_start_ns) : 0.0;
+        const double submit_ms = r.submit_start_ns != 0 && r.render_submit_end_ns > r.submit_start_ns
+                                     ? NsToMs(r.render_submit_end_ns - r.submit_start_ns)
+                                     : 0.0;
+        const double sleep_ms = r.sleep_pre_present_start_ns != 0
+                                        && r.sleep_pre_present_end_ns >= r.sleep_pre_present_start_ns
+                                    ? NsToMs(r.sleep_pre_present_end_ns - r.sleep_pre_present_start_ns)
+                                    : 0.0;
+        std::snprintf(line, sizeof(line),
+                      "%s,%u,0x0000000000000000,%s,-1,0,0,Unknown,0,%.6f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,"
+                      "%.2f,%d,%d,%llu\n",
+                      header.application, header.process_id, header.runtime[0] != '\0' ? header.runtime : "Other",
+                      static_cast<double>(present_ns - start_ns) / 1'000'000'000.0, NsToMs(frame_time_ns),
+                      present_api_ms, render_complete_ms, sim_delta_ms, submit_ms, sleep_ms, NsToMs(r.late_amount_ns),
+                      static_cast<double>(r.reflex_pc_latency_us) / 1000.0, static_cast<double>(r.target_fps),
+                      static_cast<int>(r.fg_mode), (r.flags & kFrameCaptureFlagBackground) != 0 ? 1 : 0,
+                      static_cast<unsigned long long>(r.frame_id));
+        out << line;
+    }
+}
+
+void WriteFrameCaptureSummary(const FrameCaptureData& data, const FrameCaptureSummary& summary, std::ostream& out) {
+    char line[256];
+    std::snprintf(line, sizeof(line), "Application: %s (pid %u, %s)\n", data.header.application,
+                  data.header.process_id, data.header.runtime[0] != '\0' ? data.header.runtime : "Other");
+    out << line;
+    std::snprintf(line, sizeof(line),
+                  "Records: %zu (torn %llu, dropped %u), frames with frame time: %llu, gaps: %llu\n",
+                  data.records.size(), static_cast<unsigned long long>(data.torn_records), data.header.dropped,
+                  static_cast<unsigned long long>(summary.frames), static_cast<unsigned long long>(summary.gaps));
+    out << line;
+    std::snprintf(line, sizeof(line), "Duration: %.2f s\n", summary.duration_s);
+    out << line;
+    std::snprintf(line, sizeof(line), "Average: %.2f FPS (%.3f ms, stddev %.3f ms)\n", summary.avg_fps,
+                  summary.avg_frame_ms, summary.stddev_frame_ms);
+    out << line;
+    std::snprintf(line, sizeof(line), "1%% low: %.2f FPS, 0.1%% low: %.2f FPS\n", summary.low_1pct_fps,
+                  summary.low_01pct_fps);
+    out << line;
+    std::snprintf(line, sizeof(line),
+                  "Frame time: min %.3f, p50 %.3f, p90 %.3f, p95 %.3f, p99 %.3f, p99.9 %.3f, max %.3f ms\n",
+                  summary.min_frame_ms, summary.p50_frame_ms, summary.p90_frame_ms, summary.p95_frame_ms,
+                  summary.p99_frame_ms, summary.p999_frame_ms, summary.max_frame_ms);
+    out << line;
+    std::snprintf(line, sizeof(line), "Present: %.3f ms avg, FPS limiter sleep: %.3f ms avg\n", summary.avg_present_ms,
+                  summary.avg_limiter_sleep_ms);
+    out << line;
+    std::snprintf(line, sizeof(line), "FPS limiter late: %llu frames, %.3f ms avg\n",
+                  static_cast<unsigned long long>(summary.late_frames), summary.avg_late_ms);
+    out << line;
+    if (summary.reflex_frames > 0) {
+        std::snprintf(line, sizeof(line), "Reflex PC latency: %.2f ms avg over %llu frames\n",
+                      summary.avg_reflex_pc_latency_ms, static_cast<unsigned long long>(summary.reflex_frames));
+        out << line;
+    }
+}
+
+}  // namespace display_commander::feature::frame_capture
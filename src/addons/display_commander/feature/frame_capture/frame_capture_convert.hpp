@@ -0,0 +1,60 @@
+// Source Code <Display Commander> // Frame capture converter (platform-neutral, no Windows includes)
+#pragma once
+
+#include "frame_capture_format.hpp"
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace display_commander::feature::frame_capture {
+
+struct FrameCaptureData {
+    FrameCaptureHeader header;
+    std::vector<FrameCaptureRecord> records;  // Completed records, in slot order
+    uint64_t torn_records = 0;                // Slots claimed but not completed (capture stopped mid-write / crash)
+};
+
+// Parses a capture file image. Unfinished captures (record_count 0) are read up to the first never-claimed slot.
+bool ReadFrameCapture(const void* data, size_t size, FrameCaptureData* out, std::string* error);
+
+struct FrameCaptureSummary {
+    uint64_t frames = 0;  // Frames with a frame time (a predecessor one frame_id earlier)
+    uint64_t gaps = 0;    // Breaks in frame_id (frames not recorded); the frame after a gap has no frame time
+    double duration_s = 0.0;
+    double avg_fps = 0.0;
+    double avg_frame_ms = 0.0;
+    double stddev_frame_ms = 0.0;
+    double min_frame_ms = 0.0;
+    double max_frame_ms = 0.0;
+    double p50_frame_ms = 0.0;  // Nearest-rank percentiles of frame time
+    double p90_frame_ms = 0.0;
+    double p95_frame_ms = 0.0;
+    double p99_frame_ms = 0.0;
+    double p999_frame_ms = 0.0;
+    double low_1pct_fps = 0.0;   // 1000 / mean of the slowest 1% of frame times
+    double low_01pct_fps = 0.0;  // Same for the slowest 0.1%
+    double avg_present_ms = 0.0;        // Time in Present
+    double avg_limiter_sleep_ms = 0.0;  // FPS limiter sleep before present
+    uint64_t late_frames = 0;           // Frames the FPS limiter started late
+    double avg_late_ms = 0.0;           // Over late frames
+    uint64_t reflex_frames = 0;
+    double avg_reflex_pc_latency_ms = 0.0;  // Over frames with a Reflex report
+};
+
+// Frame time of record i: present start (present end when not recorded) minus that of record i - 1, only when the
+// two are consecutive frames. Returns false for the first record and after gaps.
+bool FrameCaptureFrameTimeNs(const std::vector<FrameCaptureRecord>& records, size_t i, int64_t* frame_time_ns);
+
+FrameCaptureSummary SummarizeFrameCapture(const FrameCaptureData& data);
+
+// PresentMon-style CSV (PresentMon 1.x column names where they apply, so CapFrameX / FrameView style tools and
+// the hitch trace replay in tests read it), plus Display Commander columns. Frames without a frame time are left out.
+void WriteFrameCaptureCsv(const FrameCaptureData& data, std::ostream& out);
+
+void WriteFrameCaptureSummary(const FrameCaptureData& data, const FrameCaptureSummary& summary, std::ostream& out);
+
+}  // namespace display_commander::feature::frame_capture
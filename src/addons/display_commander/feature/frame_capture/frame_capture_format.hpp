@@ -0,0 +1,67 @@
+// Source Code <Display Commander> // Frame capture file format (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::feature::frame_capture {
+
+// .dcfc file: FrameCaptureHeader, then up to capacity FrameCaptureRecord slots. Little-endian, fixed layout; bump
+// kFrameCaptureVersion when a field changes meaning. All times are utils::get_now_ns() (QPC) nanoseconds, 0 = not
+// recorded for that frame.
+constexpr uint32_t kFrameCaptureMagic = 0x43464344;  // "DCFC"
+constexpr uint32_t kFrameCaptureVersion = 1;
+
+struct FrameCaptureHeader {
+    uint32_t magic = kFrameCaptureMagic;
+    uint32_t version = kFrameCaptureVersion;
+    uint32_t header_size = sizeof(FrameCaptureHeader);
+    uint32_t record_size = 0;
+    uint64_t capacity = 0;      // Record slots in the file
+    uint64_t record_count = 0;  // Set when the capture stops; 0 = not finished (reader scans slot sequences)
+    int64_t start_ns = 0;
+    int64_t start_unix_ms = 0;  // Wall clock at start
+    uint32_t process_id = 0;
+    uint32_t dropped = 0;       // Frames not written because the file was full
+    char application[64] = {};  // Executable name (NUL-terminated)
+    char runtime[16] = {};      // "DXGI", "D3D9", "Vulkan", "OpenGL", ...
+    uint8_t reserved[120] = {};
+};
+static_assert(sizeof(FrameCaptureHeader) == 256, "FrameCaptureHeader layout is part of the file format");
+
+enum FrameCaptureFlags : uint8_t {
+    kFrameCaptureFlagBackground = 1 << 0,     // Game was in the background
+    kFrameCaptureFlagReflexActive = 1 << 1,   // Native or injected Reflex active
+    kFrameCaptureFlagGpuCompletion = 1 << 2,  // gpu_completion_ns measured (Enqueue GPU Completion)
+};
+
+struct FrameCaptureRecord {
+    uint64_t sequence = 0;  // Slot index + 1, stored last: a slot whose sequence does not match was not completed
+    uint64_t frame_id = 0;  // g_global_frame_id
+    // FrameData timestamps
+    int64_t sim_start_ns = 0;
+    int64_t submit_start_ns = 0;
+    int64_t render_submit_end_ns = 0;
+    int64_t present_start_ns = 0;  // After the FPS limiter
+    int64_t present_end_ns = 0;
+    int64_t gpu_completion_ns = 0;
+    int64_t sleep_pre_present_start_ns = 0;  // FPS limiter sleep before present
+    int64_t sleep_pre_present_end_ns = 0;
+    int64_t sleep_post_present_start_ns = 0;  // Pacing after present
+    int64_t sleep_post_present_end_ns = 0;
+    int64_t late_amount_ns = 0;          // FPS limiter: frame started this late (0 = on time / no limiter)
+    uint32_t reflex_pc_latency_us = 0;   // Newest NVAPI latency report at the time (0 = Reflex not reporting)
+    float target_fps = 0.0f;             // FPS limit in effect (0 = none)
+    int8_t fg_mode = 0;                  // DLSSGSummaryLite::fg_mode (0 = off, -1 = active unknown, >= 2 = Nx)
+    uint8_t fps_limiter_mode = 0;        // FpsLimiterMode
+    uint8_t flags = 0;                   // FrameCaptureFlags
+    uint8_t reserved[9] = {};
+};
+static_assert(sizeof(FrameCaptureRecord) == 128, "FrameCaptureRecord layout is part of the file format");
+
+constexpr size_t FrameCaptureFileBytes(uint64_t capacity) {
+    return sizeof(FrameCaptureHeader) + static_cast<size_t>(capacity) * sizeof(FrameCaptureRecord);
+}
+
+}  // namespace display_commander::feature::frame_capture
@@ -0,0 +1,109 @@
+// Source Code <Display Commander> // Frame capture writer (platform-neutral, no Windows includes)
+#include "frame_capture_writer.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cstring>
+
+namespace display_commander::feature::frame_capture {
+
+uint64_t FrameCaptureWriter::SlotsInChunks(size_t chunks) const {
+    return (static_cast<uint64_t>(chunks) * chunk_bytes_ - sizeof(FrameCaptureHeader)) / sizeof(FrameCaptureRecord);
+}
+
+bool FrameCaptureWriter::Open(void* first_chunk, size_t chunk_bytes, uint64_t max_records,
+                              const FrameCaptureHeader& header) {
+    if (first_chunk == nullptr || chunk_bytes < FrameCaptureFileBytes(1)
+        || chunk_bytes % sizeof(FrameCaptureRecord) != 0
+        || reinterpret_cast<uintptr_t>(first_chunk) % alignof(FrameCaptureRecord) != 0 || max_records == 0) {
+        return false;
+    }
+    header_ = static_cast<FrameCaptureHeader*>(first_chunk);
+    chunk_bytes_ = chunk_bytes;
+    for (std::atomic<unsigned char*>& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    chunks_[0].store(static_cast<unsigned char*>(first_chunk), std::memory_order_relaxed);
+    mapped_chunks_ = 1;
+    capacity_ = (std::min)(max_records, SlotsInChunks(kMaxChunks));
+    next_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    mapped_slots_.store((std::min)(SlotsInChunks(1), capacity_), std::memory_order_release);
+
+    *header_ = header;
+    header_->magic = kFrameCaptureMagic;
+    header_->version = kFrameCaptureVersion;
+    header_->header_size = sizeof(FrameCaptureHeader);
+    header_->record_size = sizeof(FrameCaptureRecord);
+    header_->capacity = capacity_;
+    header_->record_count = 0;
+    header_->dropped = 0;
+    return true;
+}
+
+bool FrameCaptureWriter::AddChunk(void* memory) {
+    if (header_ == nullptr || memory == nullptr || mapped_chunks_ >= kMaxChunks
+        || reinterpret_cast<uintptr_t>(memory) % alignof(FrameCaptureRecord) != 0) {
+        return false;
+    }
+    chunks_[mapped_chunks_].store(static_cast<unsigned char*>(memory), std::memory_order_relaxed);
+    ++mapped_chunks_;
+    mapped_slots_.store((std::min)(SlotsInChunks(mapped_chunks_), capacity_), std::memory_order_release);
+    return true;
+}
+
+bool FrameCaptureWriter::NeedsChunk() const {
+    if (header_ == nullptr || mapped_chunks_ >= kMaxChunks) {
+        return false;
+    }
+    const uint64_t mapped = mapped_slots_.load(std::memory_order_relaxed);
+    const uint64_t used = next_.load(std::memory_order_relaxed);
+    return mapped < capacity_ && used + chunk_bytes_ / sizeof(FrameCaptureRecord) / 2 >= mapped;
+}
+
+bool FrameCaptureWriter::Append(const FrameCaptureRecord& record) {
+    if (header_ == nullptr) {
+        return false;
+    }
+    // Claim only mapped slots, so a dropped frame leaves no hole in the file
+    uint64_t slot = next_.load(std::memory_order_relaxed);
+    do {
+        if (slot >= mapped_slots_.load(std::memory_order_acquire)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!next_.compare_exchange_weak(slot, slot + 1, std::memory_order_relaxed));
+
+    const size_t offset = FrameCaptureFileBytes(slot);
+    unsigned char* chunk = chunks_[offset / chunk_bytes_].load(std::memory_order_relaxed);
+    FrameCaptureRecord& target = *reinterpret_cast<FrameCaptureRecord*>(chunk + offset % chunk_bytes_);
+    // Everything but the sequence, then publish it
+    std::memcpy(reinterpret_cast<unsigned char*>(&target) + sizeof(target.sequence),
+                reinterpret_cast<const unsigned char*>(&record) + sizeof(record.sequence),
+                sizeof(FrameCaptureRecord) - sizeof(record.sequence));
+    std::atomic_ref<uint64_t>(target.sequence).store(slot + 1, std::memory_order_release);
+    return true;
+}
+
+uint64_t FrameCaptureWriter::Count() const {
+    return (std::min)(next_.load(std::memory_order_relaxed), capacity_);
+}
+
+size_t FrameCaptureWriter::Finish() {
+    if (header_ == nullptr) {
+        return 0;
+    }
+    const uint64_t count = Count();
+    header_->record_count = count;
+    const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    header_->dropped = static_cast<uint32_t>((std::min)(dropped, uint64_t{UINT32_MAX}));
+    header_ = nullptr;
+    for (std::atomic<unsigned char*>& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    mapped_chunks_ = 0;
+    mapped_slots_.store(0, std::memory_order_relaxed);
+    return FrameCaptureFileBytes(count);
+}
+
+}  // namespace display_commander::feature::frame_capture
@@ -0,0 +1,64 @@
+// Source Code <Display Commander> // Frame capture writer (platform-neutral, no Windows includes)
+#pragma once
+
+#include "frame_capture_format.hpp"
+
+// Libraries <Standard C++>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::feature::frame_capture {
+
+// Appends records into caller-owned memory chunks (mapped views of consecutive chunk_bytes ranges of the capture
+// file, the first one starting with the header). The file grows a chunk at a time: the owner maps the next chunk
+// when NeedsChunk() says the mapped ones are running out, so a long capture never maps its whole budget up front.
+// Append is lock-free: a CAS claims a slot only inside the mapped chunks (otherwise the frame is dropped), the
+// record is copied in, and its sequence is published last, so a reader of the file (or a crash mid-capture) never
+// sees a half-written record as valid. The caller keeps every chunk mapped until all Appends have returned and then
+// calls Finish.
+class FrameCaptureWriter {
+   public:
+    static constexpr size_t kMaxChunks = 32;
+
+    // first_chunk: file bytes [0, chunk_bytes), 8-byte aligned. chunk_bytes is a multiple of the record size and
+    // holds at least the header and one record. Writes the header (magic, sizes and capacity filled in); capacity is
+    // max_records, limited to what kMaxChunks chunks hold.
+    bool Open(void* first_chunk, size_t chunk_bytes, uint64_t max_records, const FrameCaptureHeader& header);
+
+    // Maps the next chunk: memory for file bytes [MappedChunks() * chunk_bytes, + chunk_bytes). Owner thread only.
+    bool AddChunk(void* memory);
+
+    // Less than half a chunk of mapped slots left and the capacity needs more (owner thread).
+    bool NeedsChunk() const;
+    size_t MappedChunks() const { return mapped_chunks_; }
+    size_t ChunkBytes() const { return chunk_bytes_; }
+
+    // Any thread. False when not open, full, or the next chunk is not mapped yet (counted as dropped).
+    bool Append(const FrameCaptureRecord& record);
+
+    // Records the final count in the header. Returns the bytes used (header + written records) so the file can be
+    // truncated to that size.
+    size_t Finish();
+
+    bool IsOpen() const { return header_ != nullptr; }
+    uint64_t Count() const;  // Records written so far
+    uint64_t Capacity() const { return capacity_; }
+    uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+   private:
+    // Slots that fit in the first `chunks` chunks
+    uint64_t SlotsInChunks(size_t chunks) const;
+
+    FrameCaptureHeader* header_ = nullptr;
+    size_t chunk_bytes_ = 0;
+    uint64_t capacity_ = 0;
+    std::array<std::atomic<unsigned char*>, kMaxChunks> chunks_ = {};
+    size_t mapped_chunks_ = 0;             // Owner thread
+    std::atomic<uint64_t> mapped_slots_{0};  // Published after the chunk pointer
+    std::atomic<uint64_t> next_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+}  // namespace display_commander::feature::frame_capture
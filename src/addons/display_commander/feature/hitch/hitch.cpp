@@ -0,0 +1,175 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "hitch.hpp"
+#include "../../globals.hpp"
+#include "../../settings/main_tab_settings.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+namespace display_commander::feature::hitch {
+
+namespace {
+
+constexpr int64_t kMinModuleLoadNs = 500'000;     // Faster loads were already mapped: not worth a hitch
+constexpr int64_t kMinLimiterLateNs = 1'000'000;  // Limiter late amount that counts as evidence
+constexpr int64_t kLogBurstWindowNs = 100'000'000;
+constexpr int kLogBurstLines = 25;  // Lines per window that make a burst
+
+// Present thread (frames), hook threads (evidence), UI (status). Never log while holding it: the logger feeds
+// RecordHitchLogLine.
+std::mutex g_detector_mutex;
+HitchDetector g_detector;
+std::vector<HitchRecord> g_hitches;  // Ring of kHitchHistory, under g_detector_mutex
+size_t g_hitches_next = 0;
+
+std::atomic<int64_t> g_log_window{0};
+std::atomic<int> g_log_window_lines{0};
+
+void AddEvidence(HitchCause cause, int64_t start_ns, int64_t end_ns, const char* detail) {
+    HitchEvidence evidence;
+    evidence.cause = cause;
+    evidence.time_ns = end_ns;
+    evidence.duration_ns = end_ns > start_ns ? end_ns - start_ns : 0;
+    SetHitchEvidenceDetail(&evidence, detail);
+    std::lock_guard<std::mutex> lock(g_detector_mutex);
+    g_detector.AddEvidence(evidence);
+}
+
+// File name part of a module path, narrowed (non-ASCII becomes '?')
+template <typename CharT>
+void ModuleBaseName(const CharT* path, char* out, size_t out_size) {
+    out[0] = '\0';
+    if (path == nullptr) {
+        return;
+    }
+    const CharT* name = path;
+    for (const CharT* p = path; *p != 0; ++p) {
+        if (*p == '\\' || *p == '/') {
+            name = p + 1;
+        }
+    }
+    size_t i = 0;
+    for (; name[i] != 0 && i + 1 < out_size; ++i) {
+        const auto c = static_cast<uint32_t>(name[i]);
+        out[i] = c < 0x80 ? static_cast<char>(c) : '?';
+    }
+    out[i] = '\0';
+}
+
+}  // namespace
+
+void RecordHitchFrame(int64_t now_ns, int64_t frame_time_ns) {
+    const int64_t late_ns = ::late_amount_ns.load(std::memory_order_relaxed);
+    char detail[32] = {};
+    if (late_ns >= kMinLimiterLateNs) {
+        std::snprintf(detail, sizeof(detail), "late %.1f ms", static_cast<double>(late_ns) / 1'000'000.0);
+    }
+
+    std::lock_guard<std::mutex> lock(g_detector_mutex);
+    HitchDetectorConfig config = g_detector.GetConfig();
+    const double multiplier = static_cast<double>(settings::g_mainTabSettings.hitch_threshold_multiplier.GetValue());
+    if (config.threshold_multiplier != multiplier) {
+        config.threshold_multiplier = multiplier;
+        g_detector.SetConfig(config);
+    }
+    if (late_ns >= kMinLimiterLateNs) {
+        HitchEvidence evidence;
+        evidence.cause = HitchCause::kLimiterLate;
+        evidence.time_ns = now_ns;
+        evidence.duration_ns = late_ns;
+        SetHitchEvidenceDetail(&evidence, detail);
+        g_detector.AddEvidence(evidence);
+    }
+    HitchRecord record;
+    if (!g_detector.AddFrame(now_ns, frame_time_ns, &record)) {
+        return;
+    }
+    if (g_hitches.size() < kHitchHistory) {
+        g_hitches.push_back(record);
+    } else {
+        g_hitches[g_hitches_next] = record;
+    }
+    g_hitches_next = (g_hitches_next + 1) % kHitchHistory;
+}
+
+void RecordHitchModuleLoad(int64_t start_ns, int64_t end_ns, const char* module_name) {
+    if (end_ns - start_ns < kMinModuleLoadNs) {
+        return;
+    }
+    char name[48];
+    ModuleBaseName(module_name, name, sizeof(name));
+    AddEvidence(HitchCause::kModuleLoad, start_ns, end_ns, name);
+}
+
+void RecordHitchModuleLoad(int64_t start_ns, int64_t end_ns, const wchar_t* module_name) {
+    if (end_ns - start_ns < kMinModuleLoadNs) {
+        return;
+    }
+    char name[48];
+    ModuleBaseName(module_name, name, sizeof(name));
+    AddEvidence(HitchCause::kModuleLoad, start_ns, end_ns, name);
+}
+
+void RecordHitchDisplayModeChange(int64_t start_ns, int64_t end_ns, const char* reason) {
+    AddEvidence(HitchCause::kDisplayModeChange, start_ns, end_ns, reason);
+}
+
+void RecordHitchBackgroundTransition(int64_t now_ns, bool to_background) {
+    AddEvidence(HitchCause::kBackgroundTransition, now_ns, now_ns, to_background ? "to background" : "to foreground");
+}
+
+void RecordHitchConfigSave(int64_t start_ns, int64_t end_ns) {
+    AddEvidence(HitchCause::kConfigSave, start_ns, end_ns, "DisplayCommander.ini");
+}
+
+void RecordHitchLogLine(int64_t now_ns) {
+    const int64_t window = now_ns / kLogBurstWindowNs;
+    int64_t current = g_log_window.load(std::memory_order_relaxed);
+    if (current != window && g_log_window.compare_exchange_strong(current, window, std::memory_order_relaxed)) {
+        g_log_window_lines.store(0, std::memory_order_relaxed);
+    }
+    // Evidence once per window, when the count crosses the threshold; it spans the window so far
+    if (g_log_window_lines.fetch_add(1, std::memory_order_relaxed) + 1 == kLogBurstLines) {
+        char detail[32];
+        std::snprintf(detail, sizeof(detail), "%d+ lines in %lld ms", kLogBurstLines,
+                      static_cast<long long>(kLogBurstWindowNs / 1'000'000));
+        AddEvidence(HitchCause::kLogBurst, window * kLogBurstWindowNs, now_ns, detail);
+    }
+}
+
+HitchStatus GetHitchStatus() {
+    HitchStatus status;
+    std::lock_guard<std::mutex> lock(g_detector_mutex);
+    status.stats = g_detector.GetStats();
+    const HitchDetectorConfig& config = g_detector.GetConfig();
+    status.threshold_ms = (std::max)(status.stats.median_ms * config.threshold_multiplier,
+                                     status.stats.median_ms + config.min_excess_ms);
+    if (!g_hitches.empty()) {
+        status.last_hitch = g_hitches[(g_hitches_next + kHitchHistory - 1) % kHitchHistory];
+        status.last_hitch_age_ns = utils::get_now_ns() - status.last_hitch.frame_end_ns;
+    }
+    return status;
+}
+
+std::vector<HitchRecord> GetRecentHitches() {
+    std::lock_guard<std::mutex> lock(g_detector_mutex);
+    std::vector<HitchRecord> hitches;
+    hitches.reserve(g_hitches.size());
+    for (size_t i = 1; i <= g_hitches.size(); ++i) {
+        hitches.push_back(g_hitches[(g_hitches_next + kHitchHistory - i) % kHitchHistory]);
+    }
+    return hitches;
+}
+
+void ClearHitches() {
+    std::lock_guard<std::mutex> lock(g_detector_mutex);
+    g_detector.Reset();
+    g_hitches.clear();
+    g_hitches_next = 0;
+}
+
+}  // namespace display_commander::feature::hitch
@@ -0,0 +1,45 @@
+// Source Code <Display Commander> // Hitch detector feature slice
+#pragma once
+
+#include "hitch_detector.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <vector>
+
+namespace display_commander::feature::hitch {
+
+struct HitchStatus {
+    HitchSessionStats stats;
+    double threshold_ms = 0.0;  // Current hitch threshold at the rolling median
+    HitchRecord last_hitch;      // Valid when stats.hitches > 0
+    int64_t last_hitch_age_ns = 0;
+};
+
+// Present thread, once per frame (RecordFrameTime). Also samples the FPS limiter late amount as evidence.
+void RecordHitchFrame(int64_t now_ns, int64_t frame_time_ns);
+
+// LoadLibrary* detours. Short loads (cached modules) are ignored.
+void RecordHitchModuleLoad(int64_t start_ns, int64_t end_ns, const char* module_name);
+void RecordHitchModuleLoad(int64_t start_ns, int64_t end_ns, const wchar_t* module_name);
+
+// ChangeDisplaySettings* detours and WM_DISPLAYCHANGE. start_ns == end_ns for instant events.
+void RecordHitchDisplayModeChange(int64_t start_ns, int64_t end_ns, const char* reason);
+
+void RecordHitchBackgroundTransition(int64_t now_ns, bool to_background);
+
+void RecordHitchConfigSave(int64_t start_ns, int64_t end_ns);
+
+// Logger, once per line. Lock-free until the line count in the current window crosses the burst threshold.
+void RecordHitchLogLine(int64_t now_ns);
+
+HitchStatus GetHitchStatus();
+
+// Newest first, at most the last kHitchHistory hitches.
+constexpr size_t kHitchHistory = 256;
+std::vector<HitchRecord> GetRecentHitches();
+
+// Clears the hitch list and session stats. Detection resumes after the median warms up again.
+void ClearHitches();
+
+}  // namespace display_commander::feature::hitch
@@ -0,0 +1,162 @@
+// Source Code <Display Commander> // Hitch detector core (platform-neutral, no Windows includes)
+#include "hitch_detector.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cstring>
+
+namespace display_commander::feature::hitch {
+
+namespace {
+
+constexpr double kNsPerMs = 1'000'000.0;
+
+}  // namespace
+
+const char* HitchCauseName(HitchCause cause) {
+    switch (cause) {
+        case HitchCause::kDisplayModeChange:    return "Display mode change";
+        case HitchCause::kBackgroundTransition: return "Background transition";
+        case HitchCause::kModuleLoad:           return "Module load";
+        case HitchCause::kConfigSave:           return "Config save";
+        case HitchCause::kLogBurst:             return "Log burst";
+        case HitchCause::kLimiterLate:          return "FPS limiter late";
+        case HitchCause::kCount:                return "Unknown";
+    }
+    return "?";
+}
+
+void SetHitchEvidenceDetail(HitchEvidence* evidence, const char* text) {
+    evidence->detail.fill('\0');
+    if (text != nullptr) {
+        std::strncpy(evidence->detail.data(), text, evidence->detail.size() - 1);
+    }
+}
+
+HitchDetector::HitchDetector(const HitchDetectorConfig& config) { SetConfig(config); }
+
+void HitchDetector::SetConfig(const HitchDetectorConfig& config) {
+    const bool window_changed = config.median_window != config_.median_window || window_ms_.empty();
+    config_ = config;
+    config_.median_window = (std::max)(config_.median_window, size_t{8});
+    if (window_changed) {
+        window_ms_.clear();
+        window_ms_.reserve(config_.median_window);
+        scratch_ms_.reserve(config_.median_window);
+        window_next_ = 0;
+        median_ms_ = 0.0;
+    }
+    if (evidence_.empty()) {
+        evidence_.reserve(kEvidenceHistory);
+    }
+}
+
+void HitchDetector::AddEvidence(const HitchEvidence& evidence) {
+    if (evidence.cause >= HitchCause::kCount) {
+        return;
+    }
+    if (evidence_.size() < kEvidenceHistory) {
+        evidence_.push_back(evidence);
+    } else {
+        evidence_[evidence_next_] = evidence;
+        evidence_next_ = (evidence_next_ + 1) % kEvidenceHistory;
+    }
+}
+
+double HitchDetector::MedianMs() {
+    scratch_ms_.assign(window_ms_.begin(), window_ms_.end());
+    const auto middle = scratch_ms_.begin() + static_cast<std::ptrdiff_t>(scratch_ms_.size() / 2);
+    std::nth_element(scratch_ms_.begin(), middle, scratch_ms_.end());
+    return *middle;
+}
+
+bool HitchDetector::AddFrame(int64_t frame_end_ns, int64_t frame_time_ns, HitchRecord* hitch_out) {
+    if (frame_time_ns <= 0 || frame_time_ns > config_.max_frame_time_ns) {
+        return false;
+    }
+    ++frame_index_;
+    ++stats_.frames;
+    const double frame_ms = static_cast<double>(frame_time_ns) / kNsPerMs;
+    stats_.session_seconds += frame_ms / 1000.0;
+    stats_.worst_frame_ms = (std::max)(stats_.worst_frame_ms, frame_ms);
+
+    bool is_hitch = false;
+    HitchRecord record;
+    if (window_ms_.size() >= (std::min)(config_.warmup_frames, config_.median_window)) {
+        const double threshold_ms =
+            (std::max)(median_ms_ * config_.threshold_multiplier, median_ms_ + config_.min_excess_ms);
+        if (frame_ms > threshold_ms) {
+            is_hitch = true;
+            record.frame_index = frame_index_;
+            record.frame_end_ns = frame_end_ns;
+            record.frame_time_ms = frame_ms;
+            record.median_ms = median_ms_;
+            record.threshold_ms = threshold_ms;
+            Attribute(frame_end_ns - frame_time_ns, frame_end_ns, &record);
+            ++stats_.hitches;
+            if (record.primary_cause < HitchCause::kCount) {
+                ++stats_.by_primary_cause[static_cast<size_t>(record.primary_cause)];
+            } else {
+                ++stats_.unattributed;
+            }
+        }
+    }
+
+    // Hitches stay out of the median so a stutter burst does not raise the threshold it is measured against
+    if (!is_hitch) {
+        if (window_ms_.size() < config_.median_window) {
+            window_ms_.push_back(frame_ms);
+        } else {
+            window_ms_[window_next_] = frame_ms;
+            window_next_ = (window_next_ + 1) % config_.median_window;
+        }
+        median_ms_ = MedianMs();
+        stats_.median_ms = median_ms_;
+    }
+
+    if (stats_.session_seconds > 0.0) {
+        stats_.hitches_per_minute = static_cast<double>(stats_.hitches) * 60.0 / stats_.session_seconds;
+    }
+    stats_.hitch_frame_pct = 100.0 * static_cast<double>(stats_.hitches) / static_cast<double>(stats_.frames);
+    if (is_hitch && hitch_out != nullptr) {
+        *hitch_out = record;
+    }
+    return is_hitch;
+}
+
+void HitchDetector::Attribute(int64_t start_ns, int64_t end_ns, HitchRecord* record) const {
+    const int64_t window_start_ns = start_ns - config_.evidence_slack_ns;
+    const int64_t window_end_ns = end_ns + config_.evidence_slack_ns;
+    std::array<const HitchEvidence*, kEvidenceHistory> matches = {};
+    size_t match_count = 0;
+    for (const HitchEvidence& evidence : evidence_) {
+        const int64_t evidence_start_ns = evidence.time_ns - (std::max)(evidence.duration_ns, int64_t{0});
+        if (evidence.time_ns < window_start_ns || evidence_start_ns > window_end_ns) {
+            continue;
+        }
+        record->cause_mask |= 1u << static_cast<uint32_t>(evidence.cause);
+        matches[match_count++] = &evidence;
+    }
+    // Highest priority cause first; within a cause, the longest event
+    std::sort(matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>(match_count),
+              [](const HitchEvidence* a, const HitchEvidence* b) {
+                  if (a->cause != b->cause) {
+                      return a->cause < b->cause;
+                  }
+                  return a->duration_ns > b->duration_ns;
+              });
+    record->evidence_count = static_cast<uint32_t>((std::min)(match_count, HitchRecord::kMaxEvidence));
+    for (uint32_t i = 0; i < record->evidence_count; ++i) {
+        record->evidence[i] = *matches[i];
+    }
+    record->primary_cause = match_count > 0 ? matches[0]->cause : HitchCause::kCount;
+}
+
+HitchSessionStats HitchDetector::GetStats() const { return stats_; }
+
+void HitchDetector::Reset() {
+    const HitchDetectorConfig config = config_;
+    *this = HitchDetector(config);
+}
+
+}  // namespace display_commander::feature::hitch
@@ -0,0 +1,109 @@
+// Source Code <Display Commander> // Hitch detector core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace display_commander::feature::hitch {
+
+// Something the addon saw happen that can stall a frame. Order is attribution priority (first = most specific).
+enum class HitchCause : uint8_t {
+    kDisplayModeChange = 0,  // ChangeDisplaySettings*, WM_DISPLAYCHANGE
+    kBackgroundTransition,   // Game moved to / from the background
+    kModuleLoad,             // LoadLibrary* call (duration = time in the loader)
+    kConfigSave,             // Display Commander config written to disk
+    kLogBurst,               // Many log lines in a short window
+    kLimiterLate,            // FPS limiter found the frame already late (duration = late amount)
+    kCount
+};
+constexpr size_t kHitchCauseCount = static_cast<size_t>(HitchCause::kCount);
+
+const char* HitchCauseName(HitchCause cause);
+
+struct HitchEvidence {
+    HitchCause cause = HitchCause::kCount;
+    int64_t time_ns = 0;      // End of the event (call return, message, save done)
+    int64_t duration_ns = 0;  // Event spans [time_ns - duration_ns, time_ns]; 0 = instant
+    std::array<char, 48> detail = {};  // Module name, reason (truncated, NUL-terminated)
+};
+
+struct HitchRecord {
+    uint64_t frame_index = 0;
+    int64_t frame_end_ns = 0;
+    double frame_time_ms = 0.0;
+    double median_ms = 0.0;     // Rolling median before this frame
+    double threshold_ms = 0.0;  // Frame time that counts as a hitch at that median
+    HitchCause primary_cause = HitchCause::kCount;  // kCount = no evidence
+    uint32_t cause_mask = 0;                         // Bit per HitchCause with overlapping evidence
+    static constexpr size_t kMaxEvidence = 4;
+    std::array<HitchEvidence, kMaxEvidence> evidence = {};  // Highest priority first
+    uint32_t evidence_count = 0;
+};
+
+struct HitchSessionStats {
+    uint64_t frames = 0;
+    uint64_t hitches = 0;
+    double session_seconds = 0.0;       // Sum of frame times (pauses excluded)
+    double hitches_per_minute = 0.0;
+    double hitch_frame_pct = 0.0;
+    double worst_frame_ms = 0.0;
+    double median_ms = 0.0;
+    std::array<uint64_t, kHitchCauseCount> by_primary_cause = {};
+    uint64_t unattributed = 0;
+};
+
+struct HitchDetectorConfig {
+    double threshold_multiplier = 2.0;  // Hitch: frame time above multiplier x rolling median ...
+    double min_excess_ms = 4.0;         // ... and at least this much above the median
+    size_t median_window = 120;         // Frames in the rolling median (hitches excluded)
+    size_t warmup_frames = 30;          // No detection until the median has this many frames
+    int64_t evidence_slack_ns = 2'000'000;  // Evidence this close outside the frame still counts
+    int64_t max_frame_time_ns = 2'000'000'000;  // Longer gaps are pauses (loading, minimized): not hitches
+};
+
+// Flags frames above an adaptive threshold and tags each one with the evidence that overlaps it. Evidence may be
+// added in any order (the last kEvidenceHistory events are kept); it is matched against the frame interval
+// [frame_end - frame_time - slack, frame_end + slack], so evidence must arrive before the frame that it explains is
+// added (true for events on the game's threads during that frame). Not thread-safe: feed and read under one lock.
+class HitchDetector {
+   public:
+    static constexpr size_t kEvidenceHistory = 256;
+
+    explicit HitchDetector(const HitchDetectorConfig& config = HitchDetectorConfig());
+
+    void SetConfig(const HitchDetectorConfig& config);
+    const HitchDetectorConfig& GetConfig() const { return config_; }
+
+    void AddEvidence(const HitchEvidence& evidence);
+
+    // One presented frame. Returns true (and fills hitch_out) when it is a hitch.
+    bool AddFrame(int64_t frame_end_ns, int64_t frame_time_ns, HitchRecord* hitch_out);
+
+    HitchSessionStats GetStats() const;
+
+    void Reset();
+
+   private:
+    double MedianMs();
+    void Attribute(int64_t start_ns, int64_t end_ns, HitchRecord* record) const;
+
+    HitchDetectorConfig config_;
+    std::vector<HitchEvidence> evidence_;  // Ring of kEvidenceHistory
+    size_t evidence_next_ = 0;
+
+    std::vector<double> window_ms_;  // Ring of config_.median_window non-hitch frame times
+    size_t window_next_ = 0;
+    std::vector<double> scratch_ms_;
+    double median_ms_ = 0.0;
+
+    uint64_t frame_index_ = 0;
+    HitchSessionStats stats_;
+};
+
+// Copies text into an evidence detail field (truncated).
+void SetHitchEvidenceDetail(HitchEvidence* evidence, const char* text);
+
+}  // namespace display_commander::feature::hitch
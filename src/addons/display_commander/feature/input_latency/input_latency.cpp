@@ -0,0 +1,114 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "input_latency.hpp"
+#include "../../globals.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <array>
+#include <atomic>
+#include <memory>
+
+// Libraries <Windows.h>
+#include <Windows.h>
+
+namespace display_commander::feature::input_latency {
+
+namespace {
+
+// Frames younger than this are not attributed yet (present end / GPU completion may still be pending).
+constexpr uint64_t kAttributionFrameLag = 8;
+
+InputLatencyTracker g_tracker;  // RecordInput from any thread; frames / stats on the continuous monitoring thread
+PadChangeDetector g_pad_changes;
+std::array<std::atomic<LONGLONG>, PadChangeDetector::kSlotCount> g_last_pad_poll_ns = {};
+uint64_t g_last_attributed_frame_id = 0;  // Continuous monitoring thread only
+std::atomic<bool> g_reset_requested{false};
+
+std::atomic<std::shared_ptr<const InputLatencyStats>> g_latest_stats{nullptr};
+
+InputFrameTimeline ReadTimeline(const FrameData& fd, uint64_t frame_id) {
+    InputFrameTimeline t;
+    t.frame_id = frame_id;
+    t.sim_start_ns = fd.sim_start_ns.load(std::memory_order_relaxed);
+    t.present_end_ns = fd.present_end_time_ns.load(std::memory_order_relaxed);
+    t.gpu_done_ns = fd.gpu_completion_time_ns.load(std::memory_order_acquire);
+    // Post-present pacing sleep is not part of the path to the screen
+    const LONGLONG post_start = fd.sleep_post_present_start_time_ns.load(std::memory_order_relaxed);
+    if (post_start > 0 && t.present_end_ns > post_start) {
+        t.present_end_ns = post_start;
+    }
+    return t;
+}
+
+}  // namespace
+
+void ReportPadPoll(uint32_t slot, uint32_t raw_packet_number, uint64_t packed_state, int64_t poll_ns) {
+    if (slot >= PadChangeDetector::kSlotCount) {
+        return;
+    }
+    const LONGLONG previous_poll_ns = g_last_pad_poll_ns[slot].exchange(poll_ns, std::memory_order_relaxed);
+    if (g_pad_changes.Update(slot, raw_packet_number, packed_state) && previous_poll_ns > 0) {
+        g_tracker.RecordInput(InputSource::kPad, previous_poll_ns);
+    }
+}
+
+void ReportWindowInputMessage(unsigned int msg, intptr_t lparam) {
+    switch (msg) {
+        case WM_KEYDOWN:
+        case WM_SYSKEYDOWN:
+            // Bit 30: key was already down (auto-repeat)
+            if ((lparam & (1 << 30)) == 0) {
+                g_tracker.RecordInput(InputSource::kKeyboard, utils::get_now_ns());
+            }
+            break;
+        case WM_MOUSEMOVE:
+        case WM_LBUTTONDOWN:
+        case WM_RBUTTONDOWN:
+        case WM_MBUTTONDOWN:
+        case WM_XBUTTONDOWN:
+        case WM_MOUSEWHEEL:
+        case WM_MOUSEHWHEEL:  g_tracker.RecordInput(InputSource::kMouse, utils::get_now_ns()); break;
+        default: break;
+    }
+}
+
+void ReportRawInput(InputSource source) { g_tracker.RecordInput(source, utils::get_now_ns()); }
+
+void ProcessInputLatencyInContinuousMonitoring() {
+    if (g_reset_requested.exchange(false, std::memory_order_acq_rel)) {
+        g_tracker.Reset();
+    }
+    const uint64_t current = g_global_frame_id.load(std::memory_order_acquire);
+    if (current <= kAttributionFrameLag) {
+        return;
+    }
+    const uint64_t newest = current - kAttributionFrameLag;
+    uint64_t next = g_last_attributed_frame_id + 1;
+    // Fell behind the cyclic buffer: skip to the oldest intact slot (the tracker treats the gap as a reset)
+    if (newest - next >= kFrameDataBufferSize - kAttributionFrameLag) {
+        next = newest - (kFrameDataBufferSize - kAttributionFrameLag) + 1;
+    }
+    if (next > newest) {
+        return;
+    }
+
+    for (uint64_t frame_id = next; frame_id <= newest; ++frame_id) {
+        const FrameData& fd = g_frame_data[frame_id % kFrameDataBufferSize];
+        if (fd.frame_id.load(std::memory_order_acquire) != frame_id) {
+            continue;
+        }
+        g_tracker.AddFrame(ReadTimeline(fd, frame_id));
+    }
+    g_last_attributed_frame_id = newest;
+
+    g_latest_stats.store(std::make_shared<const InputLatencyStats>(g_tracker.GetStats()), std::memory_order_release);
+}
+
+InputLatencyStats GetLatestInputLatencyStats() {
+    const std::shared_ptr<const InputLatencyStats> p = g_latest_stats.load(std::memory_order_acquire);
+    return p ? *p : InputLatencyStats{};
+}
+
+void RequestInputLatencyReset() { g_reset_requested.store(true, std::memory_order_release); }
+
+}  // namespace display_commander::feature::input_latency
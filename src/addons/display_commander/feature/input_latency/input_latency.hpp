@@ -0,0 +1,32 @@
+// Source Code <Display Commander> // Input-to-photon latency estimator feature slice
+#pragma once
+
+#include "input_latency_tracker.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace display_commander::feature::input_latency {
+
+// XInputGetState hook, after a successful original call. raw_packet_number / packed_state are the unmodified
+// controller state (PadChangeDetector::PackState). A change is stamped with the previous poll of that slot: the
+// change became visible after it, and the game reads it with this poll.
+void ReportPadPoll(uint32_t slot, uint32_t raw_packet_number, uint64_t packed_state, int64_t poll_ns);
+
+// Window message seen by the message hooks / window proc: key down (not auto-repeat) and mouse move / button down /
+// wheel are stamped with the time they reached the game. WM_INPUT goes through ReportRawInput.
+void ReportWindowInputMessage(unsigned int msg, intptr_t lparam);
+
+// Raw keyboard make / mouse input (WM_INPUT packet or GetRawInputBuffer record).
+void ReportRawInput(InputSource source);
+
+// Continuous monitoring worker: feeds finished FrameData slots into the tracker and publishes the statistics.
+void ProcessInputLatencyInContinuousMonitoring();
+
+// Latest published statistics (all zero until the first monitoring pass).
+InputLatencyStats GetLatestInputLatencyStats();
+
+// Clears the histograms on the next monitoring pass.
+void RequestInputLatencyReset();
+
+}  // namespace display_commander::feature::input_latency
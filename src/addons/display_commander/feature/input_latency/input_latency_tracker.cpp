@@ -0,0 +1,213 @@
+// Source Code <Display Commander> // Input-to-photon latency attribution core (platform-neutral, no Windows includes)
+#include "input_latency_tracker.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cstdlib>
+
+namespace display_commander::feature::input_latency {
+
+namespace {
+
+double NsToMs(int64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+// Percentile from the histogram, interpolated inside the bucket and clamped to the observed range.
+double HistogramPercentileMs(const std::array<uint32_t, kHistogramBucketCount>& histogram, uint64_t total,
+                             double percentile, int64_t min_ns, int64_t max_ns) {
+    if (total == 0) {
+        return 0.0;
+    }
+    const double target = percentile * static_cast<double>(total);
+    uint64_t cumulative = 0;
+    for (size_t b = 0; b < kHistogramBucketCount; ++b) {
+        const uint64_t count = histogram[b];
+        if (count == 0 || static_cast<double>(cumulative + count) < target) {
+            cumulative += count;
+            continue;
+        }
+        if (b == kHistogramBucketCount - 1) {
+            return NsToMs(max_ns);  // Overflow bucket has no upper edge
+        }
+        const double fraction = (target - static_cast<double>(cumulative)) / static_cast<double>(count);
+        const double ns = (static_cast<double>(b) + fraction) * static_cast<double>(kHistogramBucketNs);
+        return std::clamp(ns, static_cast<double>(min_ns), static_cast<double>(max_ns)) / 1e6;
+    }
+    return NsToMs(max_ns);
+}
+
+}  // namespace
+
+const char* InputSourceName(InputSource source) {
+    switch (source) {
+        case InputSource::kPad:      return "Pad";
+        case InputSource::kKeyboard: return "Keyboard";
+        case InputSource::kMouse:    return "Mouse";
+        default:                     return "Unknown";
+    }
+}
+
+void InputLatencyTracker::RecordInput(InputSource source, int64_t time_ns) {
+    const size_t index = static_cast<size_t>(source);
+    if (index >= kInputSourceCount || time_ns <= 0) {
+        return;
+    }
+    PendingInput& pending = pending_[index];
+    pending.events.fetch_add(1, std::memory_order_relaxed);
+    int64_t current = pending.earliest_ns.load(std::memory_order_relaxed);
+    while (current == 0 || time_ns < current) {
+        if (pending.earliest_ns.compare_exchange_weak(current, time_ns, std::memory_order_release,
+                                                      std::memory_order_relaxed)) {
+            if (current != 0) {
+                pending.coalesced.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+        }
+    }
+    pending.coalesced.fetch_add(1, std::memory_order_relaxed);
+}
+
+void InputLatencyTracker::AddFrame(const InputFrameTimeline& frame) {
+    if (frame.sim_start_ns <= 0) {
+        return;
+    }
+    ++frames_;
+    // After a gap (or at start) inputs older than this frame cannot be placed: the frame that took them is unknown
+    const bool contiguous = has_prev_ && frame.frame_id == prev_frame_id_ + 1 && prev_sim_start_ns_ > 0
+                            && prev_sim_start_ns_ < frame.sim_start_ns;
+    const int64_t window_start_ns = contiguous ? prev_sim_start_ns_ : frame.sim_start_ns;
+
+    for (size_t i = 0; i < kInputSourceCount; ++i) {
+        PendingInput& pending = pending_[i];
+        int64_t input_ns = pending.earliest_ns.load(std::memory_order_acquire);
+        // Claim the pending input only if this frame's simulation started after it
+        while (input_ns != 0 && input_ns < frame.sim_start_ns
+               && !pending.earliest_ns.compare_exchange_weak(input_ns, 0, std::memory_order_acq_rel,
+                                                             std::memory_order_acquire)) {
+        }
+        if (input_ns == 0 || input_ns >= frame.sim_start_ns) {
+            continue;
+        }
+        if (input_ns < window_start_ns) {
+            ++acc_[i].stale;
+            continue;
+        }
+        Attribute(acc_[i], input_ns, frame);
+    }
+
+    has_prev_ = true;
+    prev_frame_id_ = frame.frame_id;
+    prev_sim_start_ns_ = frame.sim_start_ns;
+}
+
+void InputLatencyTracker::Attribute(SourceAccumulator& acc, int64_t input_ns, const InputFrameTimeline& frame) {
+    const int64_t end_ns = (std::max)(frame.present_end_ns, frame.gpu_done_ns);
+    const int64_t latency_ns = end_ns - input_ns;
+    if (end_ns <= 0 || latency_ns <= 0 || latency_ns > kMaxLatencyNs) {
+        ++acc.dropped;
+        return;
+    }
+    if (acc.samples == 0) {
+        acc.min_ns = latency_ns;
+        acc.max_ns = latency_ns;
+    } else {
+        acc.min_ns = (std::min)(acc.min_ns, latency_ns);
+        acc.max_ns = (std::max)(acc.max_ns, latency_ns);
+    }
+    ++acc.samples;
+    acc.last_ns = latency_ns;
+    acc.sum_ns += latency_ns;
+    const size_t bucket =
+        (std::min)(static_cast<size_t>(latency_ns / kHistogramBucketNs), kHistogramBucketCount - 1);
+    ++acc.histogram[bucket];
+}
+
+InputLatencyStats InputLatencyTracker::GetStats() const {
+    InputLatencyStats stats;
+    stats.frames = frames_;
+    for (size_t i = 0; i < kInputSourceCount; ++i) {
+        const SourceAccumulator& acc = acc_[i];
+        InputLatencySourceStats& s = stats.sources[i];
+        s.events = pending_[i].events.load(std::memory_order_relaxed);
+        s.coalesced = pending_[i].coalesced.load(std::memory_order_relaxed);
+        s.samples = acc.samples;
+        s.stale = acc.stale;
+        s.dropped = acc.dropped;
+        s.histogram = acc.histogram;
+        if (acc.samples == 0) {
+            continue;
+        }
+        s.last_ms = NsToMs(acc.last_ns);
+        s.min_ms = NsToMs(acc.min_ns);
+        s.max_ms = NsToMs(acc.max_ns);
+        s.avg_ms = NsToMs(acc.sum_ns) / static_cast<double>(acc.samples);
+        s.p50_ms = HistogramPercentileMs(acc.histogram, acc.samples, 0.50, acc.min_ns, acc.max_ns);
+        s.p95_ms = HistogramPercentileMs(acc.histogram, acc.samples, 0.95, acc.min_ns, acc.max_ns);
+        s.p99_ms = HistogramPercentileMs(acc.histogram, acc.samples, 0.99, acc.min_ns, acc.max_ns);
+    }
+    return stats;
+}
+
+void InputLatencyTracker::Reset() {
+    for (PendingInput& pending : pending_) {
+        pending.earliest_ns.store(0, std::memory_order_relaxed);
+        pending.events.store(0, std::memory_order_relaxed);
+        pending.coalesced.store(0, std::memory_order_relaxed);
+    }
+    acc_ = {};
+    frames_ = 0;
+    has_prev_ = false;
+    prev_frame_id_ = 0;
+    prev_sim_start_ns_ = 0;
+}
+
+uint64_t PadChangeDetector::PackState(uint16_t buttons, uint8_t left_trigger, uint8_t right_trigger, int16_t lx,
+                                      int16_t ly, int16_t rx, int16_t ry) {
+    const auto high_byte = [](int16_t axis) { return static_cast<uint64_t>(static_cast<uint8_t>(axis >> 8)); };
+    return static_cast<uint64_t>(buttons) | (static_cast<uint64_t>(left_trigger) << 16)
+           | (static_cast<uint64_t>(right_trigger) << 24) | (high_byte(lx) << 32) | (high_byte(ly) << 40)
+           | (high_byte(rx) << 48) | (high_byte(ry) << 56);
+}
+
+bool PadChangeDetector::Update(uint32_t slot, uint32_t packet_number, uint64_t packed_state) {
+    if (slot >= kSlotCount) {
+        return false;
+    }
+    Slot& s = slots_[slot];
+    if (s.packet_number.exchange(packet_number, std::memory_order_relaxed) == packet_number
+        && s.seen.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (!s.seen.exchange(true, std::memory_order_acq_rel)) {
+        s.state.store(packed_state, std::memory_order_release);
+        return false;
+    }
+
+    uint64_t previous = s.state.load(std::memory_order_acquire);
+    // Buttons and triggers exactly; sticks only past the threshold (baseline moves when a change is reported)
+    if ((previous & 0xFFFFFFFFull) == (packed_state & 0xFFFFFFFFull)) {
+        bool moved = false;
+        for (int shift = 32; shift < 64; shift += 8) {
+            const int a = static_cast<int8_t>(static_cast<uint8_t>(previous >> shift));
+            const int b = static_cast<int8_t>(static_cast<uint8_t>(packed_state >> shift));
+            if (std::abs(a - b) >= kStickThreshold) {
+                moved = true;
+                break;
+            }
+        }
+        if (!moved) {
+            return false;
+        }
+    }
+    // A concurrent poll that already reported this change wins
+    return s.state.compare_exchange_strong(previous, packed_state, std::memory_order_acq_rel);
+}
+
+void PadChangeDetector::Reset() {
+    for (Slot& s : slots_) {
+        s.packet_number.store(0, std::memory_order_relaxed);
+        s.state.store(0, std::memory_order_relaxed);
+        s.seen.store(false, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace display_commander::feature::input_latency
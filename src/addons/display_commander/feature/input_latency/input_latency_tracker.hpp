@@ -0,0 +1,128 @@
+// Source Code <Display Commander> // Input-to-photon latency attribution core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::feature::input_latency {
+
+enum class InputSource : uint8_t { kPad = 0, kKeyboard, kMouse, kCount };
+constexpr size_t kInputSourceCount = static_cast<size_t>(InputSource::kCount);
+
+const char* InputSourceName(InputSource source);
+
+// Timestamps of one finished frame, copied from FrameData (ns on the same clock as the input stamps; 0 = not set).
+struct InputFrameTimeline {
+    uint64_t frame_id = 0;
+    int64_t sim_start_ns = 0;
+    int64_t present_end_ns = 0;
+    int64_t gpu_done_ns = 0;
+};
+
+// Histogram: 1 ms buckets, last bucket collects everything at or above kHistogramBucketCount - 1 ms.
+constexpr size_t kHistogramBucketCount = 128;
+constexpr int64_t kHistogramBucketNs = 1'000'000;
+
+struct InputLatencySourceStats {
+    uint64_t events = 0;     // Input changes stamped
+    uint64_t coalesced = 0;  // Stamped while an earlier input of the same source was still waiting for its frame
+    uint64_t samples = 0;    // Inputs attributed to a frame with a latency
+    uint64_t stale = 0;      // Inputs older than the previous frame's sim start (frame gap, late stamp)
+    uint64_t dropped = 0;    // Attributed frame had no present/GPU timestamp or an implausible latency
+    double last_ms = 0.0;
+    double min_ms = 0.0;
+    double avg_ms = 0.0;
+    double max_ms = 0.0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    std::array<uint32_t, kHistogramBucketCount> histogram = {};
+};
+
+struct InputLatencyStats {
+    uint64_t frames = 0;  // Frames fed to the tracker
+    std::array<InputLatencySourceStats, kInputSourceCount> sources = {};
+};
+
+// Joins input-change stamps with the frame timeline. Each input is attributed to the first frame whose simulation
+// started after it; its latency is the later of that frame's present end and GPU completion minus the stamp (the
+// addon does not see scanout, so this is input-to-present rather than true photon time).
+//
+// Only the earliest pending input per source is kept: further inputs of that source before the frame that picks
+// it up are counted as coalesced (they would land on the same frame with a shorter latency).
+//
+// RecordInput may be called from any thread (lock-free). AddFrame / GetStats / Reset belong to one consumer thread;
+// frames must be fed in increasing frame_id order.
+class InputLatencyTracker {
+   public:
+    // Latencies above this are treated as a pause (loading screen, alt-tab) and dropped.
+    static constexpr int64_t kMaxLatencyNs = 1'000'000'000;
+
+    void RecordInput(InputSource source, int64_t time_ns);
+
+    void AddFrame(const InputFrameTimeline& frame);
+
+    InputLatencyStats GetStats() const;
+
+    void Reset();
+
+   private:
+    struct PendingInput {
+        std::atomic<int64_t> earliest_ns{0};  // 0 = nothing pending
+        std::atomic<uint64_t> events{0};
+        std::atomic<uint64_t> coalesced{0};
+    };
+
+    struct SourceAccumulator {
+        uint64_t samples = 0;
+        uint64_t stale = 0;
+        uint64_t dropped = 0;
+        int64_t last_ns = 0;
+        int64_t min_ns = 0;
+        int64_t max_ns = 0;
+        int64_t sum_ns = 0;
+        std::array<uint32_t, kHistogramBucketCount> histogram = {};
+    };
+
+    void Attribute(SourceAccumulator& acc, int64_t input_ns, const InputFrameTimeline& frame);
+
+    std::array<PendingInput, kInputSourceCount> pending_;
+    std::array<SourceAccumulator, kInputSourceCount> acc_ = {};
+    uint64_t frames_ = 0;
+    bool has_prev_ = false;
+    uint64_t prev_frame_id_ = 0;
+    int64_t prev_sim_start_ns_ = 0;
+};
+
+// Detects a real change of a controller's state between polls. The packet number is the fast path (XInput bumps it
+// on any change); the state is then compared with analog noise filtered out, so a resting stick that jitters by a few
+// units does not count as input. Lock-free; safe for concurrent polls of one slot.
+class PadChangeDetector {
+   public:
+    static constexpr uint32_t kSlotCount = 4;
+    // Stick movement (in 1/256 of the half range) that counts as input, ~3%.
+    static constexpr int kStickThreshold = 8;
+
+    // Buttons, both triggers and the high byte of each stick axis in one word.
+    static uint64_t PackState(uint16_t buttons, uint8_t left_trigger, uint8_t right_trigger, int16_t lx, int16_t ly,
+                              int16_t rx, int16_t ry);
+
+    // Returns true when the state differs from the last reported one (never for the first poll of a slot).
+    bool Update(uint32_t slot, uint32_t packet_number, uint64_t packed_state);
+
+    void Reset();
+
+   private:
+    struct Slot {
+        std::atomic<uint32_t> packet_number{0};
+        std::atomic<uint64_t> state{0};
+        std::atomic<bool> seen{false};
+    };
+
+    std::array<Slot, kSlotCount> slots_;
+};
+
+}  // namespace display_commander::feature::input_latency
@@ -0,0 +1,117 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "latency_estimate.hpp"
+#include "../../globals.hpp"
+#include "../../utils/timing.hpp"
+#include "../reflex_latency/reflex_latency.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <memory>
+
+namespace display_commander::feature::latency_estimate {
+
+namespace {
+
+// Frames younger than this are not estimated yet (present end / GPU completion may still be pending).
+constexpr uint64_t kEstimateFrameLag = 8;
+constexpr int64_t kCrossValidationIntervalNs = utils::SEC_TO_NS;
+
+LatencyEstimator g_estimator;  // Continuous monitoring thread only
+uint64_t g_last_estimated_frame_id = 0;
+int64_t g_last_cross_validation_ns = 0;
+uint64_t g_last_reflex_frames = 0;
+std::atomic<bool> g_reset_requested{false};
+
+std::atomic<std::shared_ptr<const LatencyEstimatorStats>> g_latest_stats{nullptr};
+
+EstimatorFrameTimeline ReadTimeline(const FrameData& fd, uint64_t frame_id) {
+    EstimatorFrameTimeline t;
+    t.frame_id = frame_id;
+    t.sim_start_ns = fd.sim_start_ns.load(std::memory_order_relaxed);
+    t.render_submit_start_ns = fd.submit_start_time_ns.load(std::memory_order_relaxed);
+    t.render_submit_end_ns = fd.render_submit_end_time_ns.load(std::memory_order_relaxed);
+    t.sleep_pre_present_start_ns = fd.sleep_pre_present_start_time_ns.load(std::memory_order_relaxed);
+    t.present_start_ns = fd.present_start_time_ns.load(std::memory_order_relaxed);
+    t.present_end_ns = fd.present_end_time_ns.load(std::memory_order_relaxed);
+    t.sleep_post_present_start_ns = fd.sleep_post_present_start_time_ns.load(std::memory_order_relaxed);
+    t.gpu_done_ns = fd.gpu_completion_time_ns.load(std::memory_order_acquire);
+    return t;
+}
+
+EstimatorDisplayTiming ReadDisplayTiming() {
+    EstimatorDisplayTiming d;
+    const auto window_state = ::g_window_state.load();
+    const double refresh_hz = window_state ? window_state->current_monitor_refresh_rate.ToHz() : 0.0;
+    if (refresh_hz > 1.0) {
+        d.refresh_period_ns = static_cast<int64_t>(static_cast<double>(utils::SEC_TO_NS) / refresh_hz);
+    }
+    // NVAPI only; other vendors are modeled as fixed refresh (the wider bound)
+    if (vrr_status::cached_nvapi_ok.load()) {
+        const std::shared_ptr<nvapi::VrrStatus> vrr = vrr_status::cached_nvapi_vrr.load();
+        d.vrr_active = vrr && vrr->is_display_in_vrr_mode && vrr->is_vrr_enabled;
+    }
+    return d;
+}
+
+void CrossValidateWithReflex() {
+    namespace rl = display_commander::feature::reflex_latency;
+    const rl::ReflexFrameHistoryStats reflex = rl::GetReflexFrameHistory().GetStats();
+    if (reflex.frames == g_last_reflex_frames) {
+        return;  // Reflex not reporting (non-NVIDIA, no markers, or paused)
+    }
+    g_last_reflex_frames = reflex.frames;
+    const rl::ReflexStageStats& pcl = reflex.stages[static_cast<size_t>(rl::ReflexStatsWindow::k1s)]
+                                                   [static_cast<size_t>(rl::ReflexStage::kPcLatency)];
+    if (pcl.samples > 0) {
+        g_estimator.AddReference(pcl.avg_ms);
+    }
+}
+
+}  // namespace
+
+void ProcessLatencyEstimateInContinuousMonitoring() {
+    if (g_reset_requested.exchange(false, std::memory_order_acq_rel)) {
+        g_estimator.Reset();
+    }
+    const uint64_t current = g_global_frame_id.load(std::memory_order_acquire);
+    if (current <= kEstimateFrameLag) {
+        return;
+    }
+    const uint64_t newest = current - kEstimateFrameLag;
+    uint64_t next = g_last_estimated_frame_id + 1;
+    // Fell behind the cyclic buffer: skip to the oldest intact slot
+    if (newest - next >= kFrameDataBufferSize - kEstimateFrameLag) {
+        next = newest - (kFrameDataBufferSize - kEstimateFrameLag) + 1;
+    }
+    if (next > newest) {
+        return;
+    }
+
+    const EstimatorDisplayTiming display = ReadDisplayTiming();
+    for (uint64_t frame_id = next; frame_id <= newest; ++frame_id) {
+        const FrameData& fd = g_frame_data[frame_id % kFrameDataBufferSize];
+        if (fd.frame_id.load(std::memory_order_acquire) != frame_id) {
+            continue;
+        }
+        g_estimator.AddFrame(ReadTimeline(fd, frame_id), display);
+    }
+    g_last_estimated_frame_id = newest;
+
+    const int64_t now_ns = static_cast<int64_t>(utils::get_now_ns());
+    if (now_ns - g_last_cross_validation_ns >= kCrossValidationIntervalNs) {
+        g_last_cross_validation_ns = now_ns;
+        CrossValidateWithReflex();
+    }
+
+    g_latest_stats.store(std::make_shared<const LatencyEstimatorStats>(g_estimator.GetStats()),
+                         std::memory_order_release);
+}
+
+LatencyEstimatorStats GetLatestLatencyEstimateStats() {
+    const std::shared_ptr<const LatencyEstimatorStats> p = g_latest_stats.load(std::memory_order_acquire);
+    return p ? *p : LatencyEstimatorStats{};
+}
+
+void RequestLatencyEstimateReset() { g_reset_requested.store(true, std::memory_order_release); }
+
+}  // namespace display_commander::feature::latency_estimate
@@ -0,0 +1,18 @@
+// Source Code <Display Commander> // Software latency estimator feature slice
+#pragma once
+
+#include "latency_estimator.hpp"
+
+namespace display_commander::feature::latency_estimate {
+
+// Continuous monitoring worker: estimates finished FrameData slots, cross-validates against the Reflex latency
+// history once per second when it is collecting frames, and publishes the statistics.
+void ProcessLatencyEstimateInContinuousMonitoring();
+
+// Latest published statistics (all zero until the first frame was estimated).
+LatencyEstimatorStats GetLatestLatencyEstimateStats();
+
+// Clears the estimator on the next monitoring pass.
+void RequestLatencyEstimateReset();
+
+}  // namespace display_commander::feature::latency_estimate
@@ -0,0 +1,225 @@
+// Source Code <Display Commander> // Software latency estimator core (platform-neutral, no Windows includes)
+#include "latency_estimator.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+
+namespace display_commander::feature::latency_estimate {
+
+namespace {
+
+constexpr double kNsPerMs = 1'000'000.0;
+// Frame rate at or below this fraction of the refresh rate counts as inside the VRR range
+constexpr double kVrrRangeMargin = 0.98;
+// Reflex and our timeline stamp sim start / GPU end at slightly different points (marker vs present hook)
+constexpr double kReferenceToleranceMs = 1.0;
+// Bound of a modeled GPU lag in mean absolute deviations (~2 sigma for normal jitter)
+constexpr double kGpuLagBoundDeviations = 2.5;
+// Frame intervals above this are pauses (loading, alt-tab), not frame rate
+constexpr int64_t kMaxFrameIntervalNs = 1'000'000'000;
+
+double ToMs(int64_t ns) { return static_cast<double>(ns) / kNsPerMs; }
+
+void Ema(double* ema, double value, double alpha, bool first) { *ema = first ? value : *ema + alpha * (value - *ema); }
+
+}  // namespace
+
+LatencyEstimator::LatencyEstimator() : history_(kHistoryCapacity) { scratch_.reserve(kHistoryCapacity); }
+
+bool LatencyEstimator::AddFrame(const EstimatorFrameTimeline& frame, const EstimatorDisplayTiming& display,
+                                LatencyEstimate* estimate_out) {
+    display_ = display;
+    const int64_t sim = frame.sim_start_ns;
+    int64_t present_end = frame.present_end_ns;
+    if (frame.sleep_post_present_start_ns > 0 && frame.sleep_post_present_start_ns < present_end) {
+        present_end = frame.sleep_post_present_start_ns;
+    }
+
+    if (sim > 0 && prev_sim_start_ns_ > 0 && sim > prev_sim_start_ns_
+        && sim - prev_sim_start_ns_ < kMaxFrameIntervalNs) {
+        Ema(&frame_interval_ema_ns_, static_cast<double>(sim - prev_sim_start_ns_), kEmaAlpha,
+            frame_interval_ema_ns_ == 0.0);
+    }
+    if (sim > 0) {
+        prev_sim_start_ns_ = sim;
+    }
+    if (sim <= 0 || present_end <= 0 || present_end < sim || present_end - sim > kMaxPlausibleLatencyNs) {
+        ++skipped_;
+        return false;
+    }
+
+    LatencyEstimate e;
+    e.frame_id = frame.frame_id;
+    e.sim_start_ns = sim;
+    e.sim_to_present_ns = present_end - sim;
+    if (frame.sleep_pre_present_start_ns > 0 && frame.present_start_ns >= frame.sleep_pre_present_start_ns) {
+        e.limiter_sleep_ns = frame.present_start_ns - frame.sleep_pre_present_start_ns;
+    }
+
+    // GPU done
+    const bool gpu_valid = frame.gpu_done_ns >= sim && frame.gpu_done_ns - sim <= kMaxPlausibleLatencyNs;
+    int64_t gpu_low_ns = 0;
+    int64_t gpu_high_ns = 0;
+    if (gpu_valid) {
+        // The fence can signal before the present call returns: the frame was done by present end
+        e.present_to_gpu_done_ns = (std::max)(int64_t{0}, frame.gpu_done_ns - present_end);
+        gpu_low_ns = gpu_high_ns = e.present_to_gpu_done_ns;
+        e.gpu_measured = true;
+        const double lag = static_cast<double>(e.present_to_gpu_done_ns);
+        Ema(&gpu_lag_dev_ema_ns_, std::fabs(lag - gpu_lag_ema_ns_), kEmaAlpha, !have_gpu_lag_);
+        Ema(&gpu_lag_ema_ns_, lag, kEmaAlpha, !have_gpu_lag_);
+        if (!have_gpu_lag_) {
+            gpu_lag_dev_ema_ns_ = 0.0;
+        }
+        have_gpu_lag_ = true;
+        ++gpu_measured_frames_;
+    } else if (have_gpu_lag_) {
+        e.present_to_gpu_done_ns = static_cast<int64_t>(gpu_lag_ema_ns_);
+        const double spread_ns = kGpuLagBoundDeviations * gpu_lag_dev_ema_ns_;
+        gpu_low_ns = static_cast<int64_t>((std::max)(0.0, gpu_lag_ema_ns_ - spread_ns));
+        gpu_high_ns = static_cast<int64_t>(gpu_lag_ema_ns_ + spread_ns);
+    } else {
+        // No GPU timing at all: the GPU finishes this frame at most one frame interval after present
+        const int64_t interval_ns =
+            frame_interval_ema_ns_ > 0.0 ? static_cast<int64_t>(frame_interval_ema_ns_) : e.sim_to_present_ns;
+        e.present_to_gpu_done_ns = interval_ns / 2;
+        gpu_low_ns = 0;
+        gpu_high_ns = interval_ns;
+    }
+
+    // Scanout
+    int64_t scanout_low_ns = 0;
+    int64_t scanout_high_ns = 0;
+    const int64_t period_ns = display.refresh_period_ns;
+    if (period_ns > 0) {
+        e.scanout_modeled = true;
+        // Frame interval unknown on the first frame: trust VRR
+        const bool inside_vrr_range =
+            display.vrr_active
+            && (frame_interval_ema_ns_ == 0.0
+                || frame_interval_ema_ns_ >= kVrrRangeMargin * static_cast<double>(period_ns));
+        if (!inside_vrr_range) {
+            e.gpu_done_to_scanout_ns = period_ns / 2;
+            scanout_high_ns = period_ns;
+        }
+    }
+
+    e.pc_latency_ns = e.sim_to_present_ns + e.present_to_gpu_done_ns;
+    e.pc_latency_low_ns = e.sim_to_present_ns + gpu_low_ns;
+    e.pc_latency_high_ns = e.sim_to_present_ns + gpu_high_ns;
+    e.total_ns = e.pc_latency_ns + e.gpu_done_to_scanout_ns;
+    e.total_low_ns = e.pc_latency_low_ns + scanout_low_ns;
+    e.total_high_ns = e.pc_latency_high_ns + scanout_high_ns;
+
+    AddToHistory(e);
+    ++frames_;
+    if (estimate_out != nullptr) {
+        *estimate_out = e;
+    }
+    return true;
+}
+
+void LatencyEstimator::AddToHistory(const LatencyEstimate& estimate) {
+    history_[history_next_] = estimate;
+    history_next_ = (history_next_ + 1) % history_.size();
+    history_size_ = (std::min)(history_size_ + 1, history_.size());
+    window_dirty_ = true;
+}
+
+void LatencyEstimator::UpdateWindowStats() const {
+    if (!window_dirty_) {
+        return;
+    }
+    window_dirty_ = false;
+    LatencyEstimatorStats w;
+    scratch_.clear();
+    if (history_size_ > 0) {
+        const size_t newest = (history_next_ + history_.size() - 1) % history_.size();
+        const int64_t window_start_ns = history_[newest].sim_start_ns - kWindowNs;
+        double sums[10] = {};
+        for (size_t i = 0; i < history_size_; ++i) {
+            const LatencyEstimate& e = history_[(newest + history_.size() - i) % history_.size()];
+            if (e.sim_start_ns < window_start_ns) {
+                break;
+            }
+            sums[0] += ToMs(e.sim_to_present_ns);
+            sums[1] += ToMs(e.limiter_sleep_ns);
+            sums[2] += ToMs(e.present_to_gpu_done_ns);
+            sums[3] += ToMs(e.gpu_done_to_scanout_ns);
+            sums[4] += ToMs(e.pc_latency_ns);
+            sums[5] += ToMs(e.pc_latency_low_ns);
+            sums[6] += ToMs(e.pc_latency_high_ns);
+            sums[7] += ToMs(e.total_ns);
+            sums[8] += ToMs(e.total_low_ns);
+            sums[9] += ToMs(e.total_high_ns);
+            scratch_.push_back(e.total_ns);
+        }
+        const size_t n = scratch_.size();
+        w.window_frames = n;
+        if (n > 0) {
+            const double inv = 1.0 / static_cast<double>(n);
+            w.sim_to_present_ms = sums[0] * inv;
+            w.limiter_sleep_ms = sums[1] * inv;
+            w.present_to_gpu_done_ms = sums[2] * inv;
+            w.gpu_done_to_scanout_ms = sums[3] * inv;
+            w.pc_latency_ms = sums[4] * inv;
+            w.pc_latency_low_ms = sums[5] * inv;
+            w.pc_latency_high_ms = sums[6] * inv;
+            w.total_ms = sums[7] * inv;
+            w.total_low_ms = sums[8] * inv;
+            w.total_high_ms = sums[9] * inv;
+            auto p50 = scratch_.begin() + static_cast<std::ptrdiff_t>(n / 2);
+            std::nth_element(scratch_.begin(), p50, scratch_.end());
+            w.total_p50_ms = ToMs(*p50);
+            auto p95 = scratch_.begin() + static_cast<std::ptrdiff_t>((n * 95) / 100);
+            std::nth_element(scratch_.begin(), p95, scratch_.end());
+            w.total_p95_ms = ToMs(*p95);
+        }
+    }
+    window_stats_ = w;
+}
+
+void LatencyEstimator::AddReference(double reference_pc_latency_ms) {
+    UpdateWindowStats();
+    if (window_stats_.window_frames == 0 || !(reference_pc_latency_ms > 0.0)) {
+        return;
+    }
+    const double error_ms = window_stats_.pc_latency_ms - reference_pc_latency_ms;
+    ++validations_;
+    last_reference_ms_ = reference_pc_latency_ms;
+    error_sum_ms_ += error_ms;
+    abs_error_sum_ms_ += std::fabs(error_ms);
+    if (reference_pc_latency_ms >= window_stats_.pc_latency_low_ms - kReferenceToleranceMs
+        && reference_pc_latency_ms <= window_stats_.pc_latency_high_ms + kReferenceToleranceMs) {
+        ++within_bounds_;
+    }
+}
+
+LatencyEstimatorStats LatencyEstimator::GetStats() const {
+    UpdateWindowStats();
+    LatencyEstimatorStats s = window_stats_;
+    s.frames = frames_;
+    s.skipped = skipped_;
+    s.gpu_measured_frames = gpu_measured_frames_;
+    s.frame_interval_ms = frame_interval_ema_ns_ / kNsPerMs;
+    s.refresh_period_ms = ToMs(display_.refresh_period_ns);
+    s.vrr_active = display_.vrr_active;
+    s.validations = validations_;
+    s.last_reference_ms = last_reference_ms_;
+    if (validations_ > 0) {
+        const double inv = 1.0 / static_cast<double>(validations_);
+        s.mean_error_ms = error_sum_ms_ * inv;
+        s.mean_abs_error_ms = abs_error_sum_ms_ * inv;
+        s.within_bounds_pct = 100.0 * static_cast<double>(within_bounds_) * inv;
+    }
+    return s;
+}
+
+void LatencyEstimator::Reset() {
+    const EstimatorDisplayTiming display = display_;
+    *this = LatencyEstimator();
+    display_ = display;
+}
+
+}  // namespace display_commander::feature::latency_estimate
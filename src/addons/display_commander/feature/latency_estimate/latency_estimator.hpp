@@ -0,0 +1,135 @@
+// Source Code <Display Commander> // Software latency estimator core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace display_commander::feature::latency_estimate {
+
+// Timestamps of one finished frame, copied from FrameData (ns, one clock; 0 = not recorded).
+struct EstimatorFrameTimeline {
+    uint64_t frame_id = 0;
+    int64_t sim_start_ns = 0;  // Game loop start (end of the previous present when the game sends no markers)
+    int64_t render_submit_start_ns = 0;
+    int64_t render_submit_end_ns = 0;
+    int64_t sleep_pre_present_start_ns = 0;  // FPS limiter sleep before present
+    int64_t present_start_ns = 0;
+    int64_t present_end_ns = 0;
+    int64_t sleep_post_present_start_ns = 0;  // Present end for latency purposes when set (pacing after present)
+    int64_t gpu_done_ns = 0;                  // Fence signaled after the frame's GPU work
+};
+
+// Display state the scanout term depends on.
+struct EstimatorDisplayTiming {
+    int64_t refresh_period_ns = 0;  // 0 = unknown: no scanout term
+    bool vrr_active = false;        // The display refreshes when a frame is ready (within the VRR range)
+};
+
+// Latency of one frame: sim start -> present -> GPU done -> start of scanout. Low / high bound the modeled terms.
+struct LatencyEstimate {
+    uint64_t frame_id = 0;
+    int64_t sim_start_ns = 0;
+    int64_t sim_to_present_ns = 0;  // Includes the limiter sleep before present
+    int64_t limiter_sleep_ns = 0;
+    int64_t present_to_gpu_done_ns = 0;  // Measured, or modeled from the recent GPU lag / frame interval
+    int64_t gpu_done_to_scanout_ns = 0;  // Expected wait for the next refresh
+    int64_t pc_latency_ns = 0;           // sim start -> GPU done (what Reflex calls PC latency, without input sample)
+    int64_t pc_latency_low_ns = 0;
+    int64_t pc_latency_high_ns = 0;
+    int64_t total_ns = 0;  // sim start -> scanout start
+    int64_t total_low_ns = 0;
+    int64_t total_high_ns = 0;
+    bool gpu_measured = false;
+    bool scanout_modeled = false;
+};
+
+struct LatencyEstimatorStats {
+    uint64_t frames = 0;   // Frames estimated
+    uint64_t skipped = 0;  // Frames without sim start / present end, or with implausible timestamps
+    uint64_t gpu_measured_frames = 0;
+    uint64_t window_frames = 0;  // Frames in the averaging window
+    double frame_interval_ms = 0.0;
+    double refresh_period_ms = 0.0;
+    bool vrr_active = false;
+    // Window averages
+    double sim_to_present_ms = 0.0;
+    double limiter_sleep_ms = 0.0;
+    double present_to_gpu_done_ms = 0.0;
+    double gpu_done_to_scanout_ms = 0.0;
+    double pc_latency_ms = 0.0;
+    double pc_latency_low_ms = 0.0;
+    double pc_latency_high_ms = 0.0;
+    double total_ms = 0.0;
+    double total_low_ms = 0.0;
+    double total_high_ms = 0.0;
+    double total_p50_ms = 0.0;
+    double total_p95_ms = 0.0;
+    // Cross-validation against Reflex PC latency (sim start -> GPU render end) over the same window
+    uint64_t validations = 0;
+    double last_reference_ms = 0.0;
+    double mean_error_ms = 0.0;      // Estimate minus Reflex
+    double mean_abs_error_ms = 0.0;
+    double within_bounds_pct = 0.0;  // Validations where Reflex fell inside [pc low, pc high]
+};
+
+// Model-based latency for frames without Reflex reports. Measured segments come straight from the frame timeline;
+// the rest is modeled:
+//  - GPU done: the fence time when GPU completion tracking runs; otherwise the recent present -> GPU done lag, or
+//    half a frame interval (bounds 0 .. one frame interval) before any frame was measured.
+//  - Scanout: with a fixed refresh the next refresh starts uniformly within one period (expected half a period);
+//    with VRR inside its range scanout starts when the frame is done.
+// Statistics cover the frames of the last kWindowNs. Not thread-safe: feed and read from one thread.
+class LatencyEstimator {
+   public:
+    static constexpr int64_t kWindowNs = 1'000'000'000;
+    static constexpr size_t kHistoryCapacity = 2048;
+    static constexpr int64_t kMaxPlausibleLatencyNs = 2'000'000'000;
+
+    LatencyEstimator();
+
+    // Frames in frame ID order. Returns false when the frame was skipped.
+    bool AddFrame(const EstimatorFrameTimeline& frame, const EstimatorDisplayTiming& display,
+                  LatencyEstimate* estimate_out = nullptr);
+
+    // Compares a Reflex PC latency (ms, same window) with the current window; ignored while the window is empty.
+    void AddReference(double reference_pc_latency_ms);
+
+    LatencyEstimatorStats GetStats() const;
+
+    void Reset();
+
+   private:
+    static constexpr double kEmaAlpha = 0.1;
+
+    void AddToHistory(const LatencyEstimate& estimate);
+    void UpdateWindowStats() const;
+
+    std::vector<LatencyEstimate> history_;  // Ring of kHistoryCapacity
+    size_t history_next_ = 0;
+    size_t history_size_ = 0;
+
+    int64_t prev_sim_start_ns_ = 0;
+    double frame_interval_ema_ns_ = 0.0;
+    double gpu_lag_ema_ns_ = 0.0;      // present end -> GPU done of measured frames
+    double gpu_lag_dev_ema_ns_ = 0.0;  // Mean absolute deviation of that lag
+    bool have_gpu_lag_ = false;
+    EstimatorDisplayTiming display_;
+
+    uint64_t frames_ = 0;
+    uint64_t skipped_ = 0;
+    uint64_t gpu_measured_frames_ = 0;
+
+    uint64_t validations_ = 0;
+    double last_reference_ms_ = 0.0;
+    double error_sum_ms_ = 0.0;
+    double abs_error_sum_ms_ = 0.0;
+    uint64_t within_bounds_ = 0;
+
+    mutable LatencyEstimatorStats window_stats_;  // Window part, recomputed lazily
+    mutable bool window_dirty_ = true;
+    mutable std::vector<int64_t> scratch_;
+};
+
+}  // namespace display_commander::feature::latency_estimate
@@ -0,0 +1,313 @@
+// Source Code <Display Commander> // Reflex latency frame history core (platform-neutral, no Windows includes)
+#include "reflex_frame_history.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace display_commander::feature::reflex_latency {
+
+namespace {
+
+constexpr uint64_t kSlot1sUs = 100'000;    // 10 slots of 100 ms
+constexpr uint64_t kSlot10sUs = 1'000'000;  // 10 slots of 1 s
+constexpr size_t kWindowSlots = 10;
+
+// Time of a frame on NVAPI's µs clock, for window placement.
+uint64_t FrameTimeUs(const ReflexFrameReport& r) {
+    if (r.sim_start_us != 0) return r.sim_start_us;
+    if (r.present_start_us != 0) return r.present_start_us;
+    return r.gpu_render_end_us;
+}
+
+bool Span(uint64_t start_us, uint64_t end_us, uint64_t* duration_us_out) {
+    if (start_us == 0 || end_us == 0 || end_us < start_us) {
+        return false;
+    }
+    *duration_us_out = end_us - start_us;
+    return true;
+}
+
+}  // namespace
+
+const char* ReflexStageName(ReflexStage stage) {
+    switch (stage) {
+        case ReflexStage::kSimulation:    return "Simulation";
+        case ReflexStage::kRenderSubmit:  return "Render submit";
+        case ReflexStage::kPresent:       return "Present";
+        case ReflexStage::kDriver:        return "Driver";
+        case ReflexStage::kOsRenderQueue: return "OS render queue";
+        case ReflexStage::kGpuRender:     return "GPU render";
+        case ReflexStage::kPcLatency:     return "PC latency";
+        default:                          return "Unknown";
+    }
+}
+
+const char* ReflexStatsWindowName(ReflexStatsWindow window) {
+    switch (window) {
+        case ReflexStatsWindow::k1s:      return "1 s";
+        case ReflexStatsWindow::k10s:     return "10 s";
+        case ReflexStatsWindow::kSession: return "Session";
+        default:                          return "Unknown";
+    }
+}
+
+bool ReflexStageDurationUs(const ReflexFrameReport& r, ReflexStage stage, uint64_t* duration_us_out) {
+    switch (stage) {
+        case ReflexStage::kSimulation:    return Span(r.sim_start_us, r.sim_end_us, duration_us_out);
+        case ReflexStage::kRenderSubmit:
+            return Span(r.render_submit_start_us, r.render_submit_end_us, duration_us_out);
+        case ReflexStage::kPresent:       return Span(r.present_start_us, r.present_end_us, duration_us_out);
+        case ReflexStage::kDriver:        return Span(r.driver_start_us, r.driver_end_us, duration_us_out);
+        case ReflexStage::kOsRenderQueue:
+            return Span(r.os_render_queue_start_us, r.os_render_queue_end_us, duration_us_out);
+        case ReflexStage::kGpuRender:     return Span(r.gpu_render_start_us, r.gpu_render_end_us, duration_us_out);
+        case ReflexStage::kPcLatency:
+            return Span(r.input_sample_us != 0 ? r.input_sample_us : r.sim_start_us, r.gpu_render_end_us,
+                        duration_us_out);
+        default:                          return false;
+    }
+}
+
+ReflexFrameHistory::ReflexFrameHistory(size_t capacity) : ring_((std::max)(capacity, kNvapiReportCount)) {
+    InitWindow(&window_1s_, kSlot1sUs, kWindowSlots);
+    InitWindow(&window_10s_, kSlot10sUs, kWindowSlots);
+    batch_.reserve(kNvapiReportCount);
+}
+
+void ReflexFrameHistory::InitWindow(Window* window, uint64_t slot_us, size_t slot_count) {
+    window->slot_us = slot_us;
+    window->slot_index.assign(slot_count, -1);
+    window->slots.assign(slot_count, {});
+}
+
+size_t ReflexFrameHistory::BucketFor(uint64_t value_us) {
+    if (value_us < kSubBuckets) {
+        return static_cast<size_t>(value_us);
+    }
+    const int msb = std::bit_width(value_us) - 1;  // >= kSubBucketBits
+    const size_t octave = static_cast<size_t>(msb - kSubBucketBits + 1);
+    if (octave > kOctaves) {
+        return kBucketCount - 1;
+    }
+    const size_t sub = static_cast<size_t>(value_us >> (msb - kSubBucketBits)) & (kSubBuckets - 1);
+    return octave * kSubBuckets + sub;
+}
+
+uint64_t ReflexFrameHistory::BucketMidpointUs(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+    const size_t octave = bucket / kSubBuckets;
+    const size_t sub = bucket % kSubBuckets;
+    const int shift = static_cast<int>(octave) - 1;
+    const uint64_t low = static_cast<uint64_t>(kSubBuckets + sub) << shift;
+    return low + ((uint64_t{1} << shift) >> 1);
+}
+
+void ReflexFrameHistory::Histogram::Add(uint64_t value_us) {
+    ++buckets[BucketFor(value_us)];
+    ++count;
+    sum_us += value_us;
+    min_us = (std::min)(min_us, value_us);
+    max_us = (std::max)(max_us, value_us);
+}
+
+void ReflexFrameHistory::Histogram::Merge(const Histogram& other) {
+    if (other.count == 0) {
+        return;
+    }
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    sum_us += other.sum_us;
+    min_us = (std::min)(min_us, other.min_us);
+    max_us = (std::max)(max_us, other.max_us);
+}
+
+ReflexStageStats ReflexFrameHistory::ToStats(const Histogram& h) {
+    ReflexStageStats s;
+    if (h.count == 0) {
+        return s;
+    }
+    s.samples = h.count;
+    s.min_ms = static_cast<double>(h.min_us) / 1000.0;
+    s.max_ms = static_cast<double>(h.max_us) / 1000.0;
+    s.avg_ms = static_cast<double>(h.sum_us) / static_cast<double>(h.count) / 1000.0;
+
+    // Nearest-rank percentiles; the bucket midpoint is clamped to the exact min / max
+    const double fractions[] = {0.50, 0.90, 0.99};
+    double* outputs[] = {&s.p50_ms, &s.p90_ms, &s.p99_ms};
+    size_t bucket = 0;
+    uint64_t seen = 0;
+    for (size_t p = 0; p < 3; ++p) {
+        const uint64_t rank =
+            (std::max)(uint64_t{1}, static_cast<uint64_t>(std::ceil(fractions[p] * static_cast<double>(h.count))));
+        while (bucket < kBucketCount && seen + h.buckets[bucket] < rank) {
+            seen += h.buckets[bucket];
+            ++bucket;
+        }
+        const uint64_t value_us = (std::clamp)(BucketMidpointUs((std::min)(bucket, kBucketCount - 1)), h.min_us,
+                                               h.max_us);
+        *outputs[p] = static_cast<double>(value_us) / 1000.0;
+    }
+    return s;
+}
+
+size_t ReflexFrameHistory::Ingest(const ReflexFrameReport* reports, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++counters_.polls;
+
+    batch_.clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (reports[i].frame_id != 0) {
+            batch_.push_back(reports[i]);
+        }
+    }
+    if (batch_.empty()) {
+        return 0;
+    }
+    std::sort(batch_.begin(), batch_.end(),
+              [](const ReflexFrameReport& a, const ReflexFrameReport& b) { return a.frame_id < b.frame_id; });
+
+    // A poll always holds the newest frames; if even those are older than what we have, the IDs restarted
+    if (batch_.back().frame_id < last_frame_id_) {
+        last_frame_id_ = 0;
+        ++counters_.id_resets;
+    }
+
+    const uint64_t first_time_us = FrameTimeUs(batch_.front());
+    const uint64_t last_time_us = FrameTimeUs(batch_.back());
+    if (batch_.size() >= 2 && first_time_us != 0 && last_time_us > first_time_us) {
+        const double interval_us =
+            static_cast<double>(last_time_us - first_time_us) / static_cast<double>(batch_.size() - 1);
+        counters_.frame_interval_ms = interval_us / 1000.0;
+        counters_.recommended_poll_interval_ns =
+            PollIntervalForFrameIntervalNs(static_cast<int64_t>(interval_us * 1000.0));
+    }
+
+    const bool had_frames = last_frame_id_ != 0;
+    size_t added = 0;
+    for (const ReflexFrameReport& report : batch_) {
+        if (report.frame_id <= last_frame_id_) {
+            ++counters_.duplicates;
+            continue;
+        }
+        AddFrameLocked(report);
+        last_frame_id_ = report.frame_id;
+        ++added;
+    }
+    if (had_frames && added == batch_.size() && batch_.size() >= kNvapiReportCount) {
+        ++counters_.overruns;
+    }
+    counters_.frames += added;
+    counters_.newest_frame_id = last_frame_id_;
+    return added;
+}
+
+void ReflexFrameHistory::AddFrameLocked(const ReflexFrameReport& report) {
+    ring_[ring_next_] = report;
+    ring_next_ = (ring_next_ + 1) % ring_.size();
+    ring_size_ = (std::min)(ring_size_ + 1, ring_.size());
+
+    const uint64_t time_us = FrameTimeUs(report);
+    newest_time_us_ = (std::max)(newest_time_us_, time_us);
+
+    std::array<Histogram, kReflexStageCount>* window_slots[2] = {nullptr, nullptr};
+    Window* windows[2] = {&window_1s_, &window_10s_};
+    for (size_t w = 0; w < 2; ++w) {
+        Window& window = *windows[w];
+        const int64_t index = static_cast<int64_t>(time_us / window.slot_us);
+        const size_t pos = static_cast<size_t>(index) % window.slots.size();
+        if (window.slot_index[pos] != index) {
+            if (window.slot_index[pos] > index) {
+                continue;  // Older than the slot's current occupant: already outside the window
+            }
+            for (Histogram& h : window.slots[pos]) {
+                h.Clear();
+            }
+            window.slot_index[pos] = index;
+        }
+        window_slots[w] = &window.slots[pos];
+    }
+
+    for (size_t s = 0; s < kReflexStageCount; ++s) {
+        uint64_t duration_us = 0;
+        if (!ReflexStageDurationUs(report, static_cast<ReflexStage>(s), &duration_us)) {
+            continue;
+        }
+        session_[s].Add(duration_us);
+        for (auto* slot : window_slots) {
+            if (slot != nullptr) {
+                (*slot)[s].Add(duration_us);
+            }
+        }
+    }
+}
+
+void ReflexFrameHistory::MergeWindowLocked(const Window& window, ReflexStage stage, Histogram* out) const {
+    const int64_t newest_index = static_cast<int64_t>(newest_time_us_ / window.slot_us);
+    const int64_t oldest_index = newest_index - static_cast<int64_t>(window.slots.size()) + 1;
+    for (size_t i = 0; i < window.slots.size(); ++i) {
+        if (window.slot_index[i] >= oldest_index && window.slot_index[i] <= newest_index) {
+            out->Merge(window.slots[i][static_cast<size_t>(stage)]);
+        }
+    }
+}
+
+std::vector<ReflexFrameReport> ReflexFrameHistory::Snapshot(size_t max_frames) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t n = (std::min)(max_frames, ring_size_);
+    std::vector<ReflexFrameReport> out;
+    out.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        out.push_back(ring_[(ring_next_ + ring_.size() - 1 - i) % ring_.size()]);
+    }
+    return out;
+}
+
+ReflexFrameHistoryStats ReflexFrameHistory::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReflexFrameHistoryStats s = counters_;
+    for (size_t stage = 0; stage < kReflexStageCount; ++stage) {
+        Histogram merged;
+        MergeWindowLocked(window_1s_, static_cast<ReflexStage>(stage), &merged);
+        s.stages[static_cast<size_t>(ReflexStatsWindow::k1s)][stage] = ToStats(merged);
+        merged.Clear();
+        MergeWindowLocked(window_10s_, static_cast<ReflexStage>(stage), &merged);
+        s.stages[static_cast<size_t>(ReflexStatsWindow::k10s)][stage] = ToStats(merged);
+        s.stages[static_cast<size_t>(ReflexStatsWindow::kSession)][stage] = ToStats(session_[stage]);
+    }
+    return s;
+}
+
+void ReflexFrameHistory::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ring_next_ = 0;
+    ring_size_ = 0;
+    InitWindow(&window_1s_, kSlot1sUs, kWindowSlots);
+    InitWindow(&window_10s_, kSlot10sUs, kWindowSlots);
+    for (Histogram& h : session_) {
+        h.Clear();
+    }
+    newest_time_us_ = 0;
+    last_frame_id_ = 0;
+    counters_ = {};
+}
+
+int64_t ReflexFrameHistory::GetPollIntervalNs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counters_.recommended_poll_interval_ns > 0 ? counters_.recommended_poll_interval_ns : kMaxPollIntervalNs;
+}
+
+int64_t ReflexFrameHistory::PollIntervalForFrameIntervalNs(int64_t frame_interval_ns) {
+    if (frame_interval_ns <= 0) {
+        return kMinPollIntervalNs;
+    }
+    return (std::clamp)(frame_interval_ns * static_cast<int64_t>(kNvapiReportCount / 2), kMinPollIntervalNs,
+                        kMaxPollIntervalNs);
+}
+
+}  // namespace display_commander::feature::reflex_latency
@@ -0,0 +1,156 @@
+// Source Code <Display Commander> // Reflex latency frame history core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace display_commander::feature::reflex_latency {
+
+// One NV_LATENCY_RESULT_PARAMS frame report as NVAPI returns it (µs timestamps; 0 = stage not reported).
+struct ReflexFrameReport {
+    uint64_t frame_id = 0;
+    uint64_t input_sample_us = 0;
+    uint64_t sim_start_us = 0;
+    uint64_t sim_end_us = 0;
+    uint64_t render_submit_start_us = 0;
+    uint64_t render_submit_end_us = 0;
+    uint64_t present_start_us = 0;
+    uint64_t present_end_us = 0;
+    uint64_t driver_start_us = 0;
+    uint64_t driver_end_us = 0;
+    uint64_t os_render_queue_start_us = 0;
+    uint64_t os_render_queue_end_us = 0;
+    uint64_t gpu_render_start_us = 0;
+    uint64_t gpu_render_end_us = 0;
+    uint32_t gpu_frame_time_us = 0;
+    uint32_t gpu_active_render_time_us = 0;
+};
+
+enum class ReflexStage : uint8_t {
+    kSimulation = 0,  // simStart -> simEnd
+    kRenderSubmit,    // renderSubmitStart -> renderSubmitEnd
+    kPresent,         // presentStart -> presentEnd
+    kDriver,          // driverStart -> driverEnd
+    kOsRenderQueue,   // osRenderQueueStart -> osRenderQueueEnd
+    kGpuRender,       // gpuRenderStart -> gpuRenderEnd
+    kPcLatency,       // inputSample (simStart when not reported) -> gpuRenderEnd
+    kCount
+};
+constexpr size_t kReflexStageCount = static_cast<size_t>(ReflexStage::kCount);
+
+const char* ReflexStageName(ReflexStage stage);
+
+// Stage duration of one frame; false when a stamp is missing or the end precedes the start.
+bool ReflexStageDurationUs(const ReflexFrameReport& report, ReflexStage stage, uint64_t* duration_us_out);
+
+enum class ReflexStatsWindow : uint8_t { k1s = 0, k10s, kSession, kCount };
+constexpr size_t kReflexStatsWindowCount = static_cast<size_t>(ReflexStatsWindow::kCount);
+
+const char* ReflexStatsWindowName(ReflexStatsWindow window);
+
+struct ReflexStageStats {
+    uint64_t samples = 0;
+    double min_ms = 0.0;
+    double avg_ms = 0.0;
+    double p50_ms = 0.0;  // Percentiles from log-linear buckets (within ~3%)
+    double p90_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+struct ReflexFrameHistoryStats {
+    uint64_t polls = 0;
+    uint64_t frames = 0;       // New frames added to the history
+    uint64_t duplicates = 0;   // Reports already seen in an earlier poll
+    uint64_t overruns = 0;     // Polls where every report was new: frames between polls may have been lost
+    uint64_t id_resets = 0;    // Frame IDs went backwards (swapchain / Reflex re-initialized)
+    uint64_t newest_frame_id = 0;
+    double frame_interval_ms = 0.0;            // simStart spacing of the last poll
+    int64_t recommended_poll_interval_ns = 0;  // Half of NVAPI's 64-frame window at that spacing
+    std::array<std::array<ReflexStageStats, kReflexStageCount>, kReflexStatsWindowCount> stages = {};
+};
+
+// Long-lived history of Reflex frame reports. NvAPI_D3D_GetLatency only returns the last 64 frames; polling it faster
+// than that window and merging by frameID keeps every frame. Per-stage durations go into log-linear histograms for
+// sliding 1 s / 10 s windows (time sub-slots on the frames' own simStart clock) and for the whole session.
+//
+// Thread-safe: Ingest from the polling thread, Snapshot / GetStats from the UI.
+class ReflexFrameHistory {
+   public:
+    static constexpr size_t kDefaultCapacity = 4096;
+    static constexpr size_t kNvapiReportCount = 64;
+    static constexpr int64_t kMinPollIntervalNs = 50'000'000;
+    static constexpr int64_t kMaxPollIntervalNs = 1'000'000'000;
+
+    explicit ReflexFrameHistory(size_t capacity = kDefaultCapacity);
+
+    // Reports of one poll in any order (frame_id 0 = unused entry). Returns the number of new frames.
+    size_t Ingest(const ReflexFrameReport* reports, size_t count);
+
+    // Newest first, up to max_frames.
+    std::vector<ReflexFrameReport> Snapshot(size_t max_frames) const;
+
+    ReflexFrameHistoryStats GetStats() const;
+
+    void Reset();
+
+    // Poll interval for the frame rate of the last poll (the 1 s maximum before any frame was seen).
+    int64_t GetPollIntervalNs() const;
+
+    // Poll interval that sees every frame with margin: 32 frames at frame_interval_ns, clamped to 50 ms .. 1 s.
+    static int64_t PollIntervalForFrameIntervalNs(int64_t frame_interval_ns);
+
+   private:
+    // Bucket b < kSubBuckets holds b µs; above that kSubBuckets buckets per power of two.
+    static constexpr int kSubBucketBits = 4;
+    static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+    static constexpr size_t kOctaves = 22;  // Up to ~67 s; larger values land in the last bucket
+    static constexpr size_t kBucketCount = kSubBuckets * (kOctaves + 1);
+
+    struct Histogram {
+        std::array<uint32_t, kBucketCount> buckets = {};
+        uint64_t count = 0;
+        uint64_t sum_us = 0;
+        uint64_t min_us = UINT64_MAX;
+        uint64_t max_us = 0;
+
+        void Add(uint64_t value_us);
+        void Merge(const Histogram& other);
+        void Clear() { *this = Histogram{}; }
+    };
+
+    // Sliding window: slot_count time slots of slot_us, tagged with their slot index.
+    struct Window {
+        uint64_t slot_us = 0;
+        std::vector<int64_t> slot_index;
+        std::vector<std::array<Histogram, kReflexStageCount>> slots;
+    };
+
+    static size_t BucketFor(uint64_t value_us);
+    static uint64_t BucketMidpointUs(size_t bucket);
+    static ReflexStageStats ToStats(const Histogram& h);
+
+    void AddFrameLocked(const ReflexFrameReport& report);
+    void MergeWindowLocked(const Window& window, ReflexStage stage, Histogram* out) const;
+    static void InitWindow(Window* window, uint64_t slot_us, size_t slot_count);
+
+    mutable std::mutex mutex_;
+    std::vector<ReflexFrameReport> ring_;
+    size_t ring_next_ = 0;
+    size_t ring_size_ = 0;
+
+    Window window_1s_;
+    Window window_10s_;
+    std::array<Histogram, kReflexStageCount> session_ = {};
+    uint64_t newest_time_us_ = 0;
+
+    uint64_t last_frame_id_ = 0;
+    std::vector<ReflexFrameReport> batch_;  // Ingest scratch
+    ReflexFrameHistoryStats counters_;      // Counters only; stage stats are computed in GetStats
+};
+
+}  // namespace display_commander::feature::reflex_latency
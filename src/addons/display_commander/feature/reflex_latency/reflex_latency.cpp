@@ -0,0 +1,81 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "reflex_latency.hpp"
+#include "../../globals.hpp"
+#include "../../latency/reflex_provider.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace display_commander::feature::reflex_latency {
+
+namespace {
+
+ReflexFrameHistory g_history;  // Ingest on the continuous monitoring thread; read by the UI
+std::atomic<bool> g_reset_requested{false};
+std::atomic<uint32_t> g_latest_pc_latency_us{0};
+
+// Continuous monitoring thread only
+NV_LATENCY_RESULT_PARAMS_V1 g_params = {};
+std::array<ReflexFrameReport, ReflexFrameHistory::kNvapiReportCount> g_reports = {};
+
+ReflexFrameReport ToReport(const NV_LATENCY_RESULT_PARAMS_V1::FrameReport& fr) {
+    ReflexFrameReport r;
+    r.frame_id = static_cast<uint64_t>(fr.frameID);
+    r.input_sample_us = static_cast<uint64_t>(fr.inputSampleTime);
+    r.sim_start_us = static_cast<uint64_t>(fr.simStartTime);
+    r.sim_end_us = static_cast<uint64_t>(fr.simEndTime);
+    r.render_submit_start_us = static_cast<uint64_t>(fr.renderSubmitStartTime);
+    r.render_submit_end_us = static_cast<uint64_t>(fr.renderSubmitEndTime);
+    r.present_start_us = static_cast<uint64_t>(fr.presentStartTime);
+    r.present_end_us = static_cast<uint64_t>(fr.presentEndTime);
+    r.driver_start_us = static_cast<uint64_t>(fr.driverStartTime);
+    r.driver_end_us = static_cast<uint64_t>(fr.driverEndTime);
+    r.os_render_queue_start_us = static_cast<uint64_t>(fr.osRenderQueueStartTime);
+    r.os_render_queue_end_us = static_cast<uint64_t>(fr.osRenderQueueEndTime);
+    r.gpu_render_start_us = static_cast<uint64_t>(fr.gpuRenderStartTime);
+    r.gpu_render_end_us = static_cast<uint64_t>(fr.gpuRenderEndTime);
+    r.gpu_frame_time_us = static_cast<uint32_t>(fr.gpuFrameTimeUs);
+    r.gpu_active_render_time_us = static_cast<uint32_t>(fr.gpuActiveRenderTimeUs);
+    return r;
+}
+
+}  // namespace
+
+int64_t ProcessReflexLatencyInContinuousMonitoring() {
+    if (g_reset_requested.exchange(false, std::memory_order_acq_rel)) {
+        g_history.Reset();
+    }
+    if (!g_reflexProvider || !g_reflexProvider->IsInitialized() || !g_reflexProvider->GetLatencyParamsV1(g_params)) {
+        g_latest_pc_latency_us.store(0, std::memory_order_relaxed);
+        return ReflexFrameHistory::kMaxPollIntervalNs;
+    }
+    for (size_t i = 0; i < g_reports.size(); ++i) {
+        g_reports[i] = ToReport(g_params.frameReport[i]);
+    }
+    g_history.Ingest(g_reports.data(), g_reports.size());
+
+    // Newest frame (highest frameID) with a PC latency; reports are not guaranteed to be ordered
+    const ReflexFrameReport* latest = nullptr;
+    uint64_t latest_us = 0;
+    for (const ReflexFrameReport& report : g_reports) {
+        uint64_t us = 0;
+        if ((latest == nullptr || report.frame_id > latest->frame_id)
+            && ReflexStageDurationUs(report, ReflexStage::kPcLatency, &us)) {
+            latest = &report;
+            latest_us = us;
+        }
+    }
+    g_latest_pc_latency_us.store(static_cast<uint32_t>((std::min)(latest_us, uint64_t{UINT32_MAX})),
+                                 std::memory_order_relaxed);
+    return g_history.GetPollIntervalNs();
+}
+
+const ReflexFrameHistory& GetReflexFrameHistory() { return g_history; }
+
+void RequestReflexFrameHistoryReset() { g_reset_requested.store(true, std::memory_order_release); }
+
+uint32_t GetLatestReflexPcLatencyUs() { return g_latest_pc_latency_us.load(std::memory_order_relaxed); }
+
+}  // namespace display_commander::feature::reflex_latency
@@ -0,0 +1,24 @@
+// Source Code <Display Commander> // Reflex latency frame history feature slice
+#pragma once
+
+#include "reflex_frame_history.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace display_commander::feature::reflex_latency {
+
+// Continuous monitoring worker: one NvAPI_D3D_GetLatency call; frames not seen before (by frameID) go into the
+// history. Returns the delay until the next poll, about half of NVAPI's 64-frame window at the reported frame rate.
+int64_t ProcessReflexLatencyInContinuousMonitoring();
+
+// Session-long frame history and per-stage statistics (thread-safe).
+const ReflexFrameHistory& GetReflexFrameHistory();
+
+// Clears the history and statistics on the next monitoring pass.
+void RequestReflexFrameHistoryReset();
+
+// PC latency of the newest frame in the last NVAPI report, 0 when Reflex is not reporting (any thread).
+uint32_t GetLatestReflexPcLatencyUs();
+
+}  // namespace display_commander::feature::reflex_latency
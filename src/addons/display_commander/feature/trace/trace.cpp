@@ -0,0 +1,350 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "trace.hpp"
+#include "trace_buffer.hpp"
+#include "trace_json.hpp"
+#include "../../globals.hpp"
+#include "../../settings/main_tab_settings.hpp"
+#include "../../utils/detour_call_tracker.hpp"
+#include "../../utils/general_utils.hpp"
+#include "../../utils/logging.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Libraries <Windows.h>
+#include <Windows.h>
+
+namespace display_commander::feature::trace {
+
+namespace {
+
+constexpr size_t kTraceEventCapacity = 256 * 1024;  // ~12 MB, allocated when a trace starts
+constexpr uint64_t kFramePhaseDelayFrames = 8;      // GPU completion for a frame lands a few frames later
+constexpr size_t kMaxTracks = 64;
+constexpr int kTraceThreadPollMs = 100;  // Deadline check
+
+// Virtual tracks for frame phases (Windows thread ids are multiples of 4, so these never collide)
+constexpr uint32_t kGameFrameTrack = 1;     // Simulation, render submit (game threads, may overlap the next track)
+constexpr uint32_t kPresentFrameTrack = 2;  // FPS limiter sleep, present, pacing after present
+constexpr uint32_t kGpuFrameTrack = 3;      // Present start -> GPU completion
+
+// Writers check g_active, then hold g_in_flight while appending; Stop clears g_active and waits for g_in_flight to
+// drain before the buffer is handed to the writer thread. Both sides store one flag and load the other, so those
+// operations are seq_cst.
+std::atomic<bool> g_active{false};
+std::atomic<int> g_in_flight{0};
+std::atomic<int64_t> g_origin_ns{0};
+std::atomic<uint32_t> g_generation{0};  // Bumped per trace; invalidates per-thread track names
+TraceBuffer* g_buffer = nullptr;        // Owned by g_buffer_owner; stable while g_active
+
+struct TrackSlot {
+    uint32_t tid = 0;
+    const char* name = nullptr;
+};
+std::array<TrackSlot, kMaxTracks> g_tracks = {};
+std::atomic<size_t> g_track_count{0};
+thread_local uint32_t t_named_generation = 0;
+
+// Session and status, under g_mutex (UI, hotkeys, trace thread)
+std::mutex g_mutex;
+std::condition_variable g_trace_wake;  // Trace stopped
+std::thread g_trace_thread;  // Stops at the deadline, writes the JSON; joined by the next Start or shutdown
+std::unique_ptr<TraceBuffer> g_buffer_owner;
+bool g_writing = false;
+int64_t g_deadline_ns = 0;  // 0 = until stopped
+int64_t g_stop_ns = 0;
+TraceStatus g_last;  // path, counts and error of the current / last trace
+
+// RAII in-flight marker; Active() is false when the trace stopped in between
+class ActiveScope {
+   public:
+    ActiveScope() { g_in_flight.fetch_add(1); }
+    ~ActiveScope() { g_in_flight.fetch_sub(1, std::memory_order_release); }
+    ActiveScope(const ActiveScope&) = delete;
+    ActiveScope& operator=(const ActiveScope&) = delete;
+
+    bool Active() const { return g_active.load(); }
+};
+
+void Append(TraceEventPhase phase, const char* category, const char* name, int64_t time_ns, int64_t duration_ns,
+            uint64_t frame_id, uint32_t tid) {
+    TraceEvent event;
+    event.time_ns = time_ns;
+    event.duration_ns = duration_ns;
+    event.name = name;
+    event.category = category;
+    event.frame_id = frame_id;
+    event.tid = tid;
+    event.phase = phase;
+    g_buffer->Append(event);
+}
+
+// Span on a virtual frame track, when both stamps were recorded during the trace
+void AppendFramePhase(const char* name, uint32_t track, int64_t start_ns, int64_t end_ns, uint64_t frame_id) {
+    if (start_ns == 0 || end_ns < start_ns || start_ns < g_origin_ns.load(std::memory_order_relaxed)) {
+        return;
+    }
+    Append(TraceEventPhase::kComplete, "frame", name, start_ns, end_ns - start_ns, frame_id, track);
+}
+
+// Under g_mutex. Stops the writers; false when no trace is active.
+bool StopWritersLocked() {
+    if (!g_active.exchange(false)) {
+        return false;
+    }
+    detour_call_tracker::SetTracedSites(std::string());
+    while (g_in_flight.load() != 0) {
+        std::this_thread::yield();
+    }
+    g_stop_ns = utils::get_now_ns();
+    g_last.events = g_buffer->Size();
+    g_last.capacity = g_buffer->Capacity();
+    g_last.dropped = g_buffer->Dropped();
+    g_writing = true;
+    return true;
+}
+
+// Under g_mutex, after the writers stopped
+TraceJsonMetadata BuildMetadataLocked() {
+    TraceJsonMetadata metadata;
+    metadata.pid = GetCurrentProcessId();
+    metadata.process_name = std::filesystem::path(GetCurrentProcessPathW()).filename().string();
+    metadata.origin_ns = g_origin_ns.load(std::memory_order_relaxed);
+    metadata.dropped_events = g_buffer->Dropped();
+    metadata.tracks.push_back({kGameFrameTrack, "Frames: simulation / submit"});
+    metadata.tracks.push_back({kPresentFrameTrack, "Frames: limiter / present"});
+    metadata.tracks.push_back({kGpuFrameTrack, "Frames: GPU"});
+    const size_t tracks = (std::min)(g_track_count.load(std::memory_order_acquire), kMaxTracks);
+    for (size_t i = 0; i < tracks; ++i) {
+        metadata.tracks.push_back({g_tracks[i].tid, g_tracks[i].name});
+    }
+    return metadata;
+}
+
+// After the writers stopped: no Append is running and g_active is false
+void WriteTraceFile(const TraceBuffer& buffer, const TraceJsonMetadata& metadata, const std::filesystem::path& path) {
+    std::string error;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file) {
+        WriteChromeTraceJson(buffer.Events(), buffer.Size(), metadata, file);
+        file.close();
+    }
+    if (!file) {
+        error = "Write failed: " + path.string();
+        LogWarn("Trace export: %s", error.c_str());
+    } else {
+        LogInfo("Trace export: %zu events (%llu dropped) -> %s", buffer.Size(),
+                static_cast<unsigned long long>(buffer.Dropped()), path.string().c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_writing = false;
+    g_last.error = error;
+}
+
+// Trace thread: stops at the deadline, then writes the JSON after Stop.
+void RunTraceThread(std::filesystem::path path) {
+    std::unique_ptr<TraceBuffer> buffer;
+    TraceJsonMetadata metadata;
+    {
+        std::unique_lock<std::mutex> lock(g_mutex);
+        while (g_active.load(std::memory_order_relaxed)) {
+            if (g_deadline_ns != 0 && utils::get_now_ns() >= g_deadline_ns) {
+                StopWritersLocked();
+                break;
+            }
+            g_trace_wake.wait_for(lock, std::chrono::milliseconds(kTraceThreadPollMs));
+        }
+        metadata = BuildMetadataLocked();
+        buffer = std::move(g_buffer_owner);
+        g_buffer = nullptr;
+    }
+    WriteTraceFile(*buffer, metadata, path);
+}
+
+}  // namespace
+
+bool StartTrace(int duration_s) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_active.load(std::memory_order_relaxed) || g_writing || g_shutdown.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (g_trace_thread.joinable()) {
+        g_trace_thread.join();  // Previous trace is written; its thread has only returning left
+    }
+    duration_s = (std::max)(duration_s, 0);
+
+    std::error_code ec;
+    const std::filesystem::path folder = GetDisplayCommanderAppDataFolder() / "traces";
+    std::filesystem::create_directories(folder, ec);
+    const std::filesystem::path exe_path(GetCurrentProcessPathW());
+    char file_name[64] = "trace.json";
+    const std::time_t raw_time = std::time(nullptr);
+    std::tm time_info = {};
+    if (localtime_s(&time_info, &raw_time) == 0) {
+        strftime(file_name, sizeof(file_name), "_%Y%m%d_%H%M%S.json", &time_info);
+    }
+
+    g_last = TraceStatus();
+    g_last.path = (folder / (exe_path.stem().string() + file_name)).string();
+    g_last.duration_s = duration_s;
+    g_buffer_owner = std::make_unique<TraceBuffer>(kTraceEventCapacity);
+    g_buffer = g_buffer_owner.get();
+    g_track_count.store(0, std::memory_order_relaxed);
+    g_generation.fetch_add(1, std::memory_order_relaxed);
+    g_stop_ns = 0;
+
+    const int64_t now_ns = utils::get_now_ns();
+    g_origin_ns.store(now_ns, std::memory_order_relaxed);
+    g_deadline_ns = duration_s > 0 ? now_ns + duration_s * utils::SEC_TO_NS : 0;
+    g_active.store(true);
+    g_trace_thread = std::thread(RunTraceThread, std::filesystem::path(g_last.path));
+    detour_call_tracker::SetTracedSites(settings::g_mainTabSettings.trace_detour_sites.GetValue());
+    LogInfo("Trace export: started (%s, detour sites \"%s\")", duration_s > 0 ? "timed" : "until stopped",
+            settings::g_mainTabSettings.trace_detour_sites.GetValue().c_str());
+    return true;
+}
+
+void StopTrace() {
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (!StopWritersLocked()) {
+            return;
+        }
+    }
+    g_trace_wake.notify_all();
+}
+
+void ShutdownTrace() {
+    StopTrace();
+    std::thread trace_thread;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        trace_thread = std::move(g_trace_thread);
+    }
+    if (trace_thread.joinable()) {
+        trace_thread.join();
+    }
+}
+
+void ToggleTrace() {
+    if (g_active.load(std::memory_order_relaxed)) {
+        StopTrace();
+    } else {
+        StartTrace(settings::g_mainTabSettings.trace_duration_seconds.GetValue());
+    }
+}
+
+TraceStatus GetTraceStatus() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    TraceStatus status = g_last;
+    status.active = g_active.load(std::memory_order_relaxed);
+    status.writing = g_writing;
+    if (status.active && g_buffer != nullptr) {
+        status.events = g_buffer->Size();
+        status.capacity = g_buffer->Capacity();
+        status.dropped = g_buffer->Dropped();
+    }
+    const int64_t origin_ns = g_origin_ns.load(std::memory_order_relaxed);
+    if (origin_ns != 0) {
+        const int64_t end_ns = status.active ? utils::get_now_ns() : g_stop_ns;
+        status.elapsed_s = static_cast<double>(end_ns - origin_ns) / static_cast<double>(utils::SEC_TO_NS);
+    }
+    return status;
+}
+
+bool IsTracing() { return g_active.load(std::memory_order_relaxed); }
+
+void TraceSpan(const char* category, const char* name, int64_t start_ns, int64_t end_ns, uint64_t frame_id) {
+    if (!IsTracing()) {
+        return;
+    }
+    ActiveScope scope;
+    if (scope.Active()) {
+        Append(TraceEventPhase::kComplete, category, name, start_ns, end_ns - start_ns, frame_id,
+               GetCurrentThreadId());
+    }
+}
+
+void TraceInstant(const char* category, const char* name, int64_t time_ns, uint64_t frame_id) {
+    if (!IsTracing()) {
+        return;
+    }
+    ActiveScope scope;
+    if (scope.Active()) {
+        Append(TraceEventPhase::kInstant, category, name, time_ns, 0, frame_id, GetCurrentThreadId());
+    }
+}
+
+void SetTraceThreadName(const char* name) {
+    if (!IsTracing()) {
+        return;
+    }
+    ActiveScope scope;
+    if (!scope.Active()) {
+        return;
+    }
+    const uint32_t generation = g_generation.load(std::memory_order_relaxed);
+    if (t_named_generation == generation) {
+        return;
+    }
+    t_named_generation = generation;
+    const size_t index = g_track_count.fetch_add(1, std::memory_order_acq_rel);
+    if (index < kMaxTracks) {
+        g_tracks[index].tid = GetCurrentThreadId();
+        g_tracks[index].name = name;
+    }
+}
+
+void RecordTraceFrame(uint64_t frame_id) {
+    if (!IsTracing()) {
+        return;
+    }
+    SetTraceThreadName("Present");
+    ActiveScope scope;
+    if (scope.Active() && frame_id > kFramePhaseDelayFrames) {
+        const uint64_t target = frame_id - kFramePhaseDelayFrames;
+        const FrameData& fd = g_frame_data[target % kFrameDataBufferSize];
+        if (fd.frame_id.load(std::memory_order_relaxed) == target) {
+            const int64_t sim_start_ns = fd.sim_start_ns.load(std::memory_order_relaxed);
+            const int64_t submit_start_ns = fd.submit_start_time_ns.load(std::memory_order_relaxed);
+            const int64_t submit_end_ns = fd.render_submit_end_time_ns.load(std::memory_order_relaxed);
+            const int64_t present_start_ns = fd.present_start_time_ns.load(std::memory_order_relaxed);
+            AppendFramePhase("Simulation", kGameFrameTrack, sim_start_ns, submit_start_ns, target);
+            AppendFramePhase("Render submit", kGameFrameTrack, submit_start_ns, submit_end_ns, target);
+            AppendFramePhase("FPS limiter sleep", kPresentFrameTrack,
+                             fd.sleep_pre_present_start_time_ns.load(std::memory_order_relaxed),
+                             fd.sleep_pre_present_end_time_ns.load(std::memory_order_relaxed), target);
+            AppendFramePhase("Present", kPresentFrameTrack, present_start_ns,
+                             fd.present_end_time_ns.load(std::memory_order_relaxed), target);
+            AppendFramePhase("Pacing after present", kPresentFrameTrack,
+                             fd.sleep_post_present_start_time_ns.load(std::memory_order_relaxed),
+                             fd.sleep_post_present_end_time_ns.load(std::memory_order_relaxed), target);
+            AppendFramePhase("GPU completion", kGpuFrameTrack, present_start_ns,
+                             fd.gpu_completion_time_ns.load(std::memory_order_acquire), target);
+        }
+    }
+}
+
+void TraceMonitoringTask(const char* name, int64_t start_ns, int64_t end_ns) {
+    if (!IsTracing()) {
+        return;
+    }
+    SetTraceThreadName("Continuous monitoring");
+    TraceSpan("monitoring", name, start_ns, end_ns);
+}
+
+}  // namespace display_commander::feature::trace
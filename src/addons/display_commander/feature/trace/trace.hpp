@@ -0,0 +1,54 @@
+// Source Code <Display Commander> // Trace export feature slice
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace display_commander::feature::trace {
+
+struct TraceStatus {
+    bool active = false;
+    bool writing = false;  // Stopped; JSON still being written
+    size_t events = 0;
+    size_t capacity = 0;
+    uint64_t dropped = 0;
+    double elapsed_s = 0.0;
+    int duration_s = 0;  // 0 = until stopped
+    std::string path;    // .json of the current / last trace
+    std::string error;
+};
+
+// Starts recording into a preallocated event buffer (trace_duration_seconds; 0 = until stopped). CALL_GUARD sites
+// matching trace_detour_sites are traced as spans. False when a trace is active or still being written.
+bool StartTrace(int duration_s);
+
+// Stops recording without blocking on the file; the trace thread writes <app data>/traces/<exe>_<date>_<time>.json.
+void StopTrace();
+
+// Addon unload: stops recording and joins the trace thread (waits for the JSON).
+void ShutdownTrace();
+
+// Hotkey / UI
+void ToggleTrace();
+
+TraceStatus GetTraceStatus();
+
+// One relaxed load; callers skip timestamping when false.
+bool IsTracing();
+
+// Any thread. name / category must outlive the trace (string literals, CALL_GUARD keys, task names).
+void TraceSpan(const char* category, const char* name, int64_t start_ns, int64_t end_ns, uint64_t frame_id = 0);
+void TraceInstant(const char* category, const char* name, int64_t time_ns, uint64_t frame_id = 0);
+
+// Names the calling thread's track in the trace (static string). Cheap after the first call per trace.
+void SetTraceThreadName(const char* name);
+
+// Present thread, once per finalized frame (next to RecordFrameCaptureFrame): frame phase spans from g_frame_data.
+void RecordTraceFrame(uint64_t frame_id);
+
+// TimerWheelScheduler task observer for the continuous monitoring thread.
+void TraceMonitoringTask(const char* name, int64_t start_ns, int64_t end_ns);
+
+}  // namespace display_commander::feature::trace
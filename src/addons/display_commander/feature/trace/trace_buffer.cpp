@@ -0,0 +1,25 @@
+// Source Code <Display Commander> // Trace event buffer (platform-neutral, no Windows includes)
+#include "trace_buffer.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+
+namespace display_commander::feature::trace {
+
+TraceBuffer::TraceBuffer(size_t capacity) : events_(new TraceEvent[capacity]), capacity_(capacity) {}
+
+bool TraceBuffer::Append(const TraceEvent& event) {
+    const uint64_t slot = next_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= capacity_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    events_[slot] = event;
+    return true;
+}
+
+size_t TraceBuffer::Size() const {
+    return static_cast<size_t>((std::min)(next_.load(std::memory_order_acquire), static_cast<uint64_t>(capacity_)));
+}
+
+}  // namespace display_commander::feature::trace
@@ -0,0 +1,48 @@
+// Source Code <Display Commander> // Trace event buffer (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace display_commander::feature::trace {
+
+enum class TraceEventPhase : uint8_t {
+    kComplete = 0,  // Span with a duration (Chrome "X")
+    kInstant,       // Point in time (Chrome "i", thread scope)
+};
+
+// name and category are not copied: they must outlive the trace (string literals, CALL_GUARD keys, task names).
+struct TraceEvent {
+    int64_t time_ns = 0;
+    int64_t duration_ns = 0;  // kComplete only
+    const char* name = nullptr;
+    const char* category = nullptr;
+    uint64_t frame_id = 0;  // Written as args.frame_id when != 0
+    uint32_t tid = 0;       // Track (OS thread id, or a virtual track id)
+    TraceEventPhase phase = TraceEventPhase::kComplete;
+};
+
+// Fixed-capacity event store, allocated once up front. Append is lock-free (one fetch_add claims a slot); events
+// past capacity are counted as dropped. Events() may only be read once no Append is running.
+class TraceBuffer {
+   public:
+    explicit TraceBuffer(size_t capacity);
+
+    bool Append(const TraceEvent& event);
+
+    size_t Size() const;  // Events written
+    size_t Capacity() const { return capacity_; }
+    uint64_t Dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    const TraceEvent* Events() const { return events_.get(); }
+
+   private:
+    std::unique_ptr<TraceEvent[]> events_;
+    size_t capacity_ = 0;
+    std::atomic<uint64_t> next_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+}  // namespace display_commander::feature::trace
@@ -0,0 +1,111 @@
+// Source Code <Display Commander> // Chrome trace JSON writer (platform-neutral, no Windows includes)
+#include "trace_json.hpp"
+
+// Libraries <Standard C++>
+#include <cinttypes>
+#include <cstdio>
+
+namespace display_commander::feature::trace {
+
+namespace {
+
+constexpr size_t kFlushBytes = 64 * 1024;
+
+// Nanoseconds as microseconds with three decimals, without going through double (exact for any trace length)
+void AppendMicros(std::string* out, int64_t ns) {
+    char buf[32];
+    const uint64_t magnitude = ns < 0 ? 0 - static_cast<uint64_t>(ns) : static_cast<uint64_t>(ns);
+    std::snprintf(buf, sizeof(buf), "%s%" PRIu64 ".%03" PRIu64, ns < 0 ? "-" : "", magnitude / 1000,
+                  magnitude % 1000);
+    out->append(buf);
+}
+
+void AppendQuoted(std::string* out, const char* text) {
+    out->push_back('"');
+    AppendJsonEscaped(out, text != nullptr ? text : "");
+    out->push_back('"');
+}
+
+void AppendMetadataEvent(std::string* out, const char* event_name, uint32_t pid, uint32_t tid, const char* name) {
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":", pid, tid);
+    out->append("{\"name\":");
+    AppendQuoted(out, event_name);
+    out->push_back(',');
+    out->append(buf);
+    AppendQuoted(out, name);
+    out->append("}}");
+}
+
+}  // namespace
+
+void AppendJsonEscaped(std::string* out, const char* text) {
+    for (const char* p = text; *p != '\0'; ++p) {
+        const auto c = static_cast<unsigned char>(*p);
+        switch (c) {
+            case '"':  out->append("\\\""); break;
+            case '\\': out->append("\\\\"); break;
+            case '\n': out->append("\\n"); break;
+            case '\r': out->append("\\r"); break;
+            case '\t': out->append("\\t"); break;
+            default:
+                if (c < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out->append(buf);
+                } else {
+                    out->push_back(static_cast<char>(c));
+                }
+                break;
+        }
+    }
+}
+
+void WriteChromeTraceJson(const TraceEvent* events, size_t count, const TraceJsonMetadata& metadata,
+                          std::ostream& out) {
+    std::string buf;
+    buf.reserve(kFlushBytes + 1024);
+    buf.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    AppendMetadataEvent(&buf, "process_name", metadata.pid, 0, metadata.process_name.c_str());
+    for (const TraceTrackName& track : metadata.tracks) {
+        buf.append(",\n");
+        AppendMetadataEvent(&buf, "thread_name", metadata.pid, track.tid, track.name.c_str());
+    }
+
+    char ids[64];
+    for (size_t i = 0; i < count; ++i) {
+        const TraceEvent& e = events[i];
+        buf.append(",\n{\"name\":");
+        AppendQuoted(&buf, e.name);
+        buf.append(",\"cat\":");
+        AppendQuoted(&buf, e.category);
+        if (e.phase == TraceEventPhase::kComplete) {
+            buf.append(",\"ph\":\"X\",\"ts\":");
+            AppendMicros(&buf, e.time_ns - metadata.origin_ns);
+            buf.append(",\"dur\":");
+            AppendMicros(&buf, e.duration_ns > 0 ? e.duration_ns : 0);
+        } else {
+            buf.append(",\"ph\":\"i\",\"s\":\"t\",\"ts\":");
+            AppendMicros(&buf, e.time_ns - metadata.origin_ns);
+        }
+        std::snprintf(ids, sizeof(ids), ",\"pid\":%u,\"tid\":%u", metadata.pid, e.tid);
+        buf.append(ids);
+        if (e.frame_id != 0) {
+            std::snprintf(ids, sizeof(ids), ",\"args\":{\"frame_id\":%" PRIu64 "}", e.frame_id);
+            buf.append(ids);
+        }
+        buf.push_back('}');
+        if (buf.size() >= kFlushBytes) {
+            out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+            buf.clear();
+        }
+    }
+
+    char tail[96];
+    std::snprintf(tail, sizeof(tail), "\n],\"otherData\":{\"dropped_events\":%" PRIu64 "}}\n",
+                  metadata.dropped_events);
+    buf.append(tail);
+    out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+}
+
+}  // namespace display_commander::feature::trace
@@ -0,0 +1,36 @@
+// Source Code <Display Commander> // Chrome trace JSON writer (platform-neutral, no Windows includes)
+#pragma once
+
+#include "trace_buffer.hpp"
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace display_commander::feature::trace {
+
+struct TraceTrackName {
+    uint32_t tid = 0;
+    std::string name;
+};
+
+struct TraceJsonMetadata {
+    uint32_t pid = 0;
+    std::string process_name;
+    int64_t origin_ns = 0;  // Written as ts 0
+    std::vector<TraceTrackName> tracks;
+    uint64_t dropped_events = 0;
+};
+
+// JSON string body (no quotes): escapes '"', '\\' and control characters; other bytes are passed through.
+void AppendJsonEscaped(std::string* out, const char* text);
+
+// Chrome Trace Event Format (JSON object form), loadable by chrome://tracing, Perfetto UI and speedscope. Timestamps
+// are microseconds from origin_ns with nanosecond precision; process / thread names become "M" metadata events.
+void WriteChromeTraceJson(const TraceEvent* events, size_t count, const TraceJsonMetadata& metadata,
+                          std::ostream& out);
+
+}  // namespace display_commander::feature::trace
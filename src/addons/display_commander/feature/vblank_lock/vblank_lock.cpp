@@ -0,0 +1,370 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "vblank_lock.hpp"
+#include "../../globals.hpp"
+#include "../../hooks/windows_hooks/api_hooks.hpp"
+#include "../../settings/main_tab_settings.hpp"
+#include "../../utils/logging.hpp"
+#include "../../utils/timing.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Libraries <Windows.h>
+#include <Windows.h>
+
+namespace display_commander::feature::vblank_lock {
+
+namespace {
+
+// D3DKMT thunks from gdi32 (d3dkmthk.h layouts; the header needs the WDK NTSTATUS setup, so declared here)
+using KmtHandle = UINT;
+struct KmtOpenAdapterFromHdc {
+    HDC hdc;
+    KmtHandle adapter;
+    LUID adapter_luid;
+    UINT vidpn_source_id;
+};
+struct KmtCloseAdapter {
+    KmtHandle adapter;
+};
+struct KmtGetScanLine {
+    KmtHandle adapter;
+    UINT vidpn_source_id;
+    BOOLEAN in_vertical_blank;
+    UINT scan_line;
+};
+struct KmtWaitForVerticalBlankEvent {
+    KmtHandle adapter;
+    KmtHandle device;  // 0: wait on the adapter
+    UINT vidpn_source_id;
+};
+using KmtOpenAdapterFromHdcFn = LONG(APIENTRY*)(KmtOpenAdapterFromHdc*);
+using KmtCloseAdapterFn = LONG(APIENTRY*)(const KmtCloseAdapter*);
+using KmtGetScanLineFn = LONG(APIENTRY*)(KmtGetScanLine*);
+using KmtWaitForVerticalBlankEventFn = LONG(APIENTRY*)(const KmtWaitForVerticalBlankEvent*);
+
+constexpr uint32_t kScanlineReadsPerRefresh = 2;
+constexpr DWORD kIdleSleepMs = 100;
+constexpr DWORD kRetrySleepMs = 500;
+constexpr LONGLONG kGeometryRefreshNs = utils::SEC_TO_NS;
+// A read that took longer than this was preempted: its timestamp does not pin the scanline
+constexpr LONGLONG kMaxScanlineReadNs = 50'000;
+constexpr uint32_t kMaxIntervalVblanks = 8;
+
+// Display adapter the game window is on (sampler thread only)
+class KmtDisplay {
+   public:
+    ~KmtDisplay() { Close(); }
+
+    bool Open(HMONITOR monitor, const char** error_out) {
+        Close();
+        if (!ResolveThunks()) {
+            *error_out = "D3DKMT functions not available in gdi32.dll";
+            return false;
+        }
+        MONITORINFOEXW mi = {};
+        mi.cbSize = sizeof(mi);
+        if (!GetMonitorInfoW(monitor, &mi)) {
+            *error_out = "GetMonitorInfoW failed";
+            return false;
+        }
+        DEVMODEW dm = {};
+        dm.dmSize = sizeof(dm);
+        if (!EnumDisplaySettingsW(mi.szDevice, ENUM_CURRENT_SETTINGS, &dm) || dm.dmPelsHeight == 0) {
+            *error_out = "EnumDisplaySettingsW failed";
+            return false;
+        }
+        HDC hdc = CreateDCW(nullptr, mi.szDevice, nullptr, nullptr);
+        if (hdc == nullptr) {
+            *error_out = "CreateDCW failed for the game display";
+            return false;
+        }
+        KmtOpenAdapterFromHdc open = {};
+        open.hdc = hdc;
+        const LONG status = s_open_adapter(&open);
+        DeleteDC(hdc);
+        if (status != 0) {
+            *error_out = "D3DKMTOpenAdapterFromHdc failed";
+            return false;
+        }
+        adapter_ = open.adapter;
+        vidpn_source_id_ = open.vidpn_source_id;
+        monitor_ = monitor;
+        active_lines_ = dm.dmPelsHeight;
+        display_frequency_hz_ = dm.dmDisplayFrequency;
+        return true;
+    }
+
+    void Close() {
+        if (adapter_ != 0) {
+            KmtCloseAdapter close = {adapter_};
+            s_close_adapter(&close);
+            adapter_ = 0;
+        }
+        monitor_ = nullptr;
+    }
+
+    bool IsOpen() const { return adapter_ != 0; }
+    HMONITOR Monitor() const { return monitor_; }
+    uint32_t ActiveLines() const { return active_lines_; }
+    uint32_t DisplayFrequencyHz() const { return display_frequency_hz_; }
+
+    bool WaitForVblank() {
+        KmtWaitForVerticalBlankEvent wait = {adapter_, 0, vidpn_source_id_};
+        return s_wait_for_vblank(&wait) == 0;
+    }
+
+    bool ReadScanline(VblankObservation* observation_out) {
+        KmtGetScanLine scan = {};
+        scan.adapter = adapter_;
+        scan.vidpn_source_id = vidpn_source_id_;
+        const LONGLONG before_ns = utils::get_now_ns();
+        const LONG status = s_get_scan_line(&scan);
+        const LONGLONG after_ns = utils::get_now_ns();
+        if (status != 0 || after_ns - before_ns > kMaxScanlineReadNs) {
+            return false;
+        }
+        observation_out->time_ns = before_ns + (after_ns - before_ns) / 2;
+        observation_out->in_vblank = scan.in_vertical_blank != FALSE;
+        observation_out->scanline = scan.scan_line;
+        return true;
+    }
+
+   private:
+    static bool ResolveThunks() {
+        if (s_open_adapter != nullptr) {
+            return true;
+        }
+        HMODULE gdi32 = GetModuleHandleW(L"gdi32.dll");
+        if (gdi32 == nullptr) {
+            return false;
+        }
+        s_close_adapter = reinterpret_cast<KmtCloseAdapterFn>(GetProcAddress(gdi32, "D3DKMTCloseAdapter"));
+        s_get_scan_line = reinterpret_cast<KmtGetScanLineFn>(GetProcAddress(gdi32, "D3DKMTGetScanLine"));
+        s_wait_for_vblank =
+            reinterpret_cast<KmtWaitForVerticalBlankEventFn>(GetProcAddress(gdi32, "D3DKMTWaitForVerticalBlankEvent"));
+        if (s_close_adapter == nullptr || s_get_scan_line == nullptr || s_wait_for_vblank == nullptr) {
+            return false;
+        }
+        s_open_adapter = reinterpret_cast<KmtOpenAdapterFromHdcFn>(GetProcAddress(gdi32, "D3DKMTOpenAdapterFromHdc"));
+        return s_open_adapter != nullptr;
+    }
+
+    static inline KmtOpenAdapterFromHdcFn s_open_adapter = nullptr;
+    static inline KmtCloseAdapterFn s_close_adapter = nullptr;
+    static inline KmtGetScanLineFn s_get_scan_line = nullptr;
+    static inline KmtWaitForVerticalBlankEventFn s_wait_for_vblank = nullptr;
+
+    KmtHandle adapter_ = 0;
+    UINT vidpn_source_id_ = 0;
+    HMONITOR monitor_ = nullptr;
+    uint32_t active_lines_ = 0;
+    uint32_t display_frequency_hz_ = 0;
+};
+
+std::mutex g_sampler_thread_mutex;  // Start / stop of g_sampler_thread
+std::thread g_sampler_thread;
+std::atomic<bool> g_sampler_started{false};
+std::atomic<bool> g_sampler_stop{false};
+std::atomic<bool> g_sampler_running{false};
+std::atomic<const char*> g_sampler_error{nullptr};
+
+std::mutex g_phase_lock_mutex;  // Sampler thread feeds, UI reads stats
+VblankPhaseLock g_phase_lock;
+std::atomic<std::shared_ptr<const VblankGrid>> g_grid{nullptr};  // Published after every reading
+
+std::mutex g_scheduler_mutex;  // Present thread schedules, UI reads stats
+VblankPresentScheduler g_scheduler;
+std::atomic<uint32_t> g_interval_vblanks{0};
+std::atomic<int64_t> g_lead_ns{0};
+
+std::mutex g_fallback_mutex;  // Present threads of several swapchains
+VblankFallbackPacer g_fallback_pacer;
+
+bool ShouldSamplerRun() {
+    return !g_shutdown.load(std::memory_order_acquire) && !g_sampler_stop.load(std::memory_order_acquire);
+}
+
+bool IsVblankLockSelected() {
+    return s_fps_limiter_enabled.load(std::memory_order_relaxed)
+           && s_fps_limiter_mode.load(std::memory_order_relaxed) == FpsLimiterMode::kVblankLocked;
+}
+
+void AddObservation(const VblankObservation& observation) {
+    VblankGrid grid;
+    {
+        std::lock_guard<std::mutex> lock(g_phase_lock_mutex);
+        g_phase_lock.AddObservation(observation);
+        grid = g_phase_lock.GetGrid();
+    }
+    g_grid.store(std::make_shared<const VblankGrid>(grid), std::memory_order_release);
+}
+
+void StopSampling(KmtDisplay* display) {
+    if (!display->IsOpen()) {
+        return;
+    }
+    display->Close();
+    g_sampler_running.store(false, std::memory_order_relaxed);
+    g_grid.store(nullptr, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(g_phase_lock_mutex);
+    g_phase_lock.Reset();
+}
+
+// Waits for each vblank on the game display, then reads the scanline a few times across the refresh. Idles while
+// the limiter mode is not selected.
+void RunVblankSamplerThread() {
+    LogInfo("[VBlankLock] sampler thread running");
+    KmtDisplay display;
+    LONGLONG last_geometry_ns = 0;
+    while (ShouldSamplerRun()) {
+        if (!IsVblankLockSelected()) {
+            StopSampling(&display);
+            Sleep(kIdleSleepMs);
+            continue;
+        }
+
+        const LONGLONG now_ns = utils::get_now_ns();
+        if (!display.IsOpen() || now_ns - last_geometry_ns >= kGeometryRefreshNs) {
+            last_geometry_ns = now_ns;
+            HMONITOR monitor = MonitorFromWindow(display_commanderhooks::GetGameWindow(), MONITOR_DEFAULTTOPRIMARY);
+            if (monitor != display.Monitor()) {
+                StopSampling(&display);
+                const char* error = nullptr;
+                if (!display.Open(monitor, &error)) {
+                    if (g_sampler_error.exchange(error, std::memory_order_relaxed) != error) {
+                        LogWarn("[VBlankLock] %s", error);
+                    }
+                    Sleep(kRetrySleepMs);
+                    continue;
+                }
+                g_sampler_error.store(nullptr, std::memory_order_relaxed);
+                g_sampler_running.store(true, std::memory_order_relaxed);
+                LogInfo("[VBlankLock] sampling display %u lines @ %u Hz", display.ActiveLines(),
+                        display.DisplayFrequencyHz());
+            }
+            // Rational refresh rate when known (59.94 Hz reports as 59 in the display mode)
+            const auto window_state = ::g_window_state.load();
+            double refresh_hz = window_state ? window_state->current_monitor_refresh_rate.ToHz() : 0.0;
+            if (!(refresh_hz > 0.0)) {
+                refresh_hz = static_cast<double>(display.DisplayFrequencyHz());
+            }
+            const int64_t nominal_period_ns =
+                refresh_hz > 1.0 ? static_cast<int64_t>(std::llround(1'000'000'000.0 / refresh_hz)) : 0;
+            std::lock_guard<std::mutex> lock(g_phase_lock_mutex);
+            g_phase_lock.SetGeometry(nominal_period_ns, display.ActiveLines());
+        }
+
+        if (!display.WaitForVblank()) {
+            g_sampler_error.store("D3DKMTWaitForVerticalBlankEvent failed", std::memory_order_relaxed);
+            StopSampling(&display);
+            Sleep(kRetrySleepMs);
+            continue;
+        }
+        VblankObservation wait;
+        wait.from_wait = true;
+        wait.time_ns = utils::get_now_ns();
+        AddObservation(wait);
+
+        const std::shared_ptr<const VblankGrid> grid = g_grid.load(std::memory_order_acquire);
+        const double period_ns = grid ? grid->period_ns : 0.0;
+        for (uint32_t i = 1; i <= kScanlineReadsPerRefresh && period_ns > 0.0; ++i) {
+            // Timer resolution is enough: each read carries its own timestamp
+            const LONGLONG read_at_ns =
+                wait.time_ns + static_cast<LONGLONG>(period_ns * i / (kScanlineReadsPerRefresh + 1));
+            const LONGLONG sleep_ns = read_at_ns - utils::get_now_ns();
+            if (sleep_ns > 0) {
+                Sleep(static_cast<DWORD>(sleep_ns / utils::NS_TO_MS));
+            }
+            if (!ShouldSamplerRun()) {
+                break;
+            }
+            VblankObservation read;
+            if (display.ReadScanline(&read)) {
+                AddObservation(read);
+            }
+        }
+    }
+    StopSampling(&display);
+    LogInfo("[VBlankLock] sampler thread stopped");
+}
+
+void StartSamplerThread() {
+    std::lock_guard<std::mutex> lock(g_sampler_thread_mutex);
+    if (g_sampler_started.load(std::memory_order_relaxed) || g_sampler_stop.load(std::memory_order_relaxed)) {
+        return;
+    }
+    LogInfo("[VBlankLock] Starting sampler thread");
+    g_sampler_thread = std::thread(RunVblankSamplerThread);
+    g_sampler_started.store(true, std::memory_order_release);
+}
+
+}  // namespace
+
+bool ScheduleVblankLockedPresent(int64_t now_ns, float target_fps, VblankTarget* target_out) {
+    if (!g_sampler_started.load(std::memory_order_acquire)) {
+        StartSamplerThread();
+    }
+    const std::shared_ptr<const VblankGrid> grid = g_grid.load(std::memory_order_acquire);
+    if (!grid || grid->period_ns <= 0.0 || !(target_fps > 0.0f)) {
+        return false;
+    }
+
+    const double frame_time_ns = 1'000'000'000.0 / static_cast<double>(target_fps);
+    const uint32_t interval = static_cast<uint32_t>(
+        std::clamp(std::lround(frame_time_ns / grid->period_ns), 1L, static_cast<long>(kMaxIntervalVblanks)));
+    int64_t lead_ns = static_cast<int64_t>(
+        std::llround(static_cast<double>(settings::g_mainTabSettings.vblank_lock_offset_ms.GetValue()) * 1'000'000.0));
+    if (settings::g_mainTabSettings.vblank_lock_tear_line_enabled.GetValue()) {
+        lead_ns += TearLineLeadNs(*grid, settings::g_mainTabSettings.vblank_lock_tear_line_percent.GetValue() / 100.0);
+    }
+    g_interval_vblanks.store(interval, std::memory_order_relaxed);
+    g_lead_ns.store(lead_ns, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(g_scheduler_mutex);
+    return g_scheduler.Schedule(*grid, now_ns, interval, lead_ns, target_out);
+}
+
+VblankTarget ScheduleVblankFallbackPresent(uint64_t swapchain_key, int64_t now_ns, float target_fps) {
+    std::lock_guard<std::mutex> lock(g_fallback_mutex);
+    return g_fallback_pacer.Schedule(swapchain_key, now_ns, 1'000'000'000.0 / static_cast<double>(target_fps));
+}
+
+void ForgetVblankSwapchain(uint64_t swapchain_key) {
+    std::lock_guard<std::mutex> lock(g_fallback_mutex);
+    g_fallback_pacer.Forget(swapchain_key);
+}
+
+void StopVblankSampler() {
+    std::lock_guard<std::mutex> lock(g_sampler_thread_mutex);
+    g_sampler_stop.store(true, std::memory_order_release);
+    g_sampler_started.store(true, std::memory_order_release);  // Keeps the present thread off the start path
+    // Wakes within one idle sleep, vblank wait or retry sleep (at most kRetrySleepMs)
+    if (g_sampler_thread.joinable()) {
+        g_sampler_thread.join();
+    }
+}
+
+VblankLockStatus GetVblankLockStatus() {
+    VblankLockStatus status;
+    status.sampler_running = g_sampler_running.load(std::memory_order_relaxed);
+    status.sampler_error = g_sampler_error.load(std::memory_order_relaxed);
+    status.interval_vblanks = g_interval_vblanks.load(std::memory_order_relaxed);
+    status.lead_ms = static_cast<double>(g_lead_ns.load(std::memory_order_relaxed)) / 1'000'000.0;
+    {
+        std::lock_guard<std::mutex> lock(g_phase_lock_mutex);
+        status.lock = g_phase_lock.GetStats();
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_scheduler_mutex);
+        status.scheduler = g_scheduler.GetStats();
+    }
+    return status;
+}
+
+}  // namespace display_commander::feature::vblank_lock
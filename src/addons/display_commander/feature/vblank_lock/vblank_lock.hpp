@@ -0,0 +1,34 @@
+// Source Code <Display Commander> // VBlank phase-locked FPS limiter feature slice
+#pragma once
+
+#include "vblank_phase_lock.hpp"
+
+namespace display_commander::feature::vblank_lock {
+
+struct VblankLockStatus {
+    bool sampler_running = false;       // Sampler thread is reading the game display
+    const char* sampler_error = nullptr;  // Why it is not (nullptr when running or idle)
+    uint32_t interval_vblanks = 0;      // Refreshes per frame at the current FPS limit
+    double lead_ms = 0.0;               // Present issued this long before vblank (offset + tear line)
+    VblankPhaseLockStats lock;
+    VblankSchedulerStats scheduler;
+};
+
+// FPS limiter (present thread). Picks the vblank for a frame ready at now_ns: every Nth refresh, N = refresh rate /
+// target_fps rounded (at least 1, so the limit never exceeds the refresh rate). Starts the sampler thread on first
+// use. Returns false while the display timing is not locked yet.
+bool ScheduleVblankLockedPresent(int64_t now_ns, float target_fps, VblankTarget* target_out);
+
+// FPS limiter fallback while ScheduleVblankLockedPresent returns false: frames spaced by 1 / target_fps, one cadence
+// per swapchain window.
+VblankTarget ScheduleVblankFallbackPresent(uint64_t swapchain_key, int64_t now_ns, float target_fps);
+
+// Swapchain destroyed (not resized): drops its fallback cadence.
+void ForgetVblankSwapchain(uint64_t swapchain_key);
+
+// Stops and joins the sampler thread (DLL detach). The limiter mode does not restart it afterwards.
+void StopVblankSampler();
+
+VblankLockStatus GetVblankLockStatus();
+
+}  // namespace display_commander::feature::vblank_lock
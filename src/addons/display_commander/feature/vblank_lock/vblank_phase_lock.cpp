@@ -0,0 +1,284 @@
+// Source Code <Display Commander> // VBlank phase lock core (platform-neutral, no Windows includes)
+#include "vblank_phase_lock.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+
+namespace display_commander::feature::vblank_lock {
+
+namespace {
+
+constexpr double kNsPerMs = 1'000'000.0;
+constexpr double kNsPerUs = 1'000.0;
+constexpr double kLineTimeAlpha = 0.05;
+constexpr double kErrorAlpha = 0.05;
+// Without a nominal refresh rate, the first wait interval is taken as the period when it is plausible
+constexpr int64_t kMinPeriodNs = 2'000'000;    // 500 Hz
+constexpr int64_t kMaxPeriodNs = 100'000'000;  // 10 Hz
+// Total lines per refresh stay between active lines and 2x active lines (vblank is a small part of the period)
+constexpr double kMaxTotalToActiveLines = 2.0;
+// Frames later than this many refreshes were paused (loading, alt-tab, limiter mode switch), not missing vblanks
+constexpr double kMaxMissedVblanks = 16.0;
+
+}  // namespace
+
+int64_t VblankGrid::NextVblankAtOrAfter(int64_t time_ns) const {
+    if (period_ns <= 0.0) {
+        return 0;
+    }
+    const double n = std::ceil(static_cast<double>(time_ns - reference_vblank_ns) / period_ns);
+    return reference_vblank_ns + static_cast<int64_t>(std::llround(n * period_ns));
+}
+
+void VblankPhaseLock::SetGeometry(int64_t nominal_period_ns, uint32_t active_lines) {
+    if (nominal_period_ns == nominal_period_ns_ && active_lines == active_lines_) {
+        return;
+    }
+    Reset();
+    nominal_period_ns_ = nominal_period_ns;
+    active_lines_ = active_lines;
+}
+
+void VblankPhaseLock::AddObservation(const VblankObservation& observation) {
+    if (observation.from_wait) {
+        ++wait_observations_;
+        if (scanline_tracking_) {
+            // Vblank waits return after the vblank started; measure by how much for diagnostics
+            const VblankGrid grid = GetGrid();
+            const int64_t vblank_ns =
+                grid.NextVblankAtOrAfter(observation.time_ns) - static_cast<int64_t>(std::llround(period_ns_));
+            const double latency_ns = static_cast<double>(observation.time_ns - vblank_ns);
+            wait_latency_ema_ns_ += kErrorAlpha * (latency_ns - wait_latency_ema_ns_);
+            return;
+        }
+        Track(observation.time_ns);
+        return;
+    }
+
+    ++scanline_observations_;
+    if (observation.in_vblank || active_lines_ == 0 || observation.scanline >= active_lines_) {
+        return;
+    }
+    // Two reads in the same refresh give the line time: a later line less than one period apart is the same scanout
+    const double period_ns = period_ns_ > 0.0 ? period_ns_ : static_cast<double>(nominal_period_ns_);
+    const int64_t dt_ns = observation.time_ns - last_active_time_ns_;
+    if (last_active_time_ns_ > 0 && observation.scanline > last_active_line_ && period_ns > 0.0
+        && static_cast<double>(dt_ns) < period_ns) {
+        const double sample =
+            static_cast<double>(dt_ns) / static_cast<double>(observation.scanline - last_active_line_);
+        const double min_line_ns = period_ns / (kMaxTotalToActiveLines * static_cast<double>(active_lines_));
+        const double max_line_ns = period_ns / static_cast<double>(active_lines_);
+        if (sample >= min_line_ns && sample <= max_line_ns) {
+            line_time_ns_ = line_time_ns_ == 0.0 ? sample : line_time_ns_ + kLineTimeAlpha * (sample - line_time_ns_);
+        }
+    }
+    last_active_time_ns_ = observation.time_ns;
+    last_active_line_ = observation.scanline;
+    if (line_time_ns_ == 0.0) {
+        return;
+    }
+    if (!scanline_tracking_) {
+        scanline_tracking_ = true;
+        tracked_since_lock_ = 0;  // Different (unbiased) phase reference: lock again on it
+    }
+    const double lines_left = static_cast<double>(active_lines_ - observation.scanline);
+    Track(observation.time_ns + static_cast<int64_t>(std::llround(lines_left * line_time_ns_)));
+}
+
+void VblankPhaseLock::Track(int64_t vblank_ns) {
+    if (!have_reference_) {
+        have_reference_ = true;
+        reference_ns_ = vblank_ns;
+        period_ns_ = static_cast<double>(nominal_period_ns_);
+        return;
+    }
+    if (period_ns_ == 0.0) {
+        const int64_t interval_ns = vblank_ns - reference_ns_;
+        if (interval_ns >= kMinPeriodNs && interval_ns <= kMaxPeriodNs) {
+            period_ns_ = static_cast<double>(interval_ns);
+        }
+        reference_ns_ = vblank_ns;
+        return;
+    }
+
+    const double k = std::round(static_cast<double>(vblank_ns - reference_ns_) / period_ns_);
+    const double predicted_ns = static_cast<double>(reference_ns_) + k * period_ns_;
+    const double error_ns = static_cast<double>(vblank_ns) - predicted_ns;
+    last_error_ns_ = error_ns;
+    if (std::fabs(error_ns) > kOutlierFraction * period_ns_) {
+        ++outliers_;
+        if (++consecutive_outliers_ >= kRelockOutliers) {
+            Relock(vblank_ns);
+        }
+        return;
+    }
+    consecutive_outliers_ = 0;
+
+    if (k >= 1.0) {
+        period_ns_ += kPeriodGain * error_ns / k;
+        if (nominal_period_ns_ > 0) {
+            const double nominal = static_cast<double>(nominal_period_ns_);
+            period_ns_ =
+                std::clamp(period_ns_, nominal * (1.0 - kMaxDriftFraction), nominal * (1.0 + kMaxDriftFraction));
+        }
+    }
+    // Older reads (k < 0) only nudge the phase; the reference stays on the latest vblank
+    const double base_ns = k >= 0.0 ? predicted_ns : static_cast<double>(reference_ns_);
+    reference_ns_ = static_cast<int64_t>(std::llround(base_ns + kPhaseGain * error_ns));
+
+    const double error_sq = error_ns * error_ns;
+    error_sq_ema_ = tracked_since_lock_ == 0 ? error_sq : error_sq_ema_ + kErrorAlpha * (error_sq - error_sq_ema_);
+    if (tracked_since_lock_ < UINT32_MAX) {
+        ++tracked_since_lock_;
+    }
+}
+
+void VblankPhaseLock::Relock(int64_t vblank_ns) {
+    ++relocks_;
+    reference_ns_ = vblank_ns;
+    if (nominal_period_ns_ > 0) {
+        period_ns_ = static_cast<double>(nominal_period_ns_);
+    }
+    consecutive_outliers_ = 0;
+    tracked_since_lock_ = 0;
+    error_sq_ema_ = 0.0;
+}
+
+bool VblankPhaseLock::IsLocked() const {
+    return period_ns_ > 0.0 && tracked_since_lock_ >= kLockObservations
+           && std::sqrt(error_sq_ema_) < kLockedRmsFraction * period_ns_;
+}
+
+VblankGrid VblankPhaseLock::GetGrid() const {
+    VblankGrid grid;
+    grid.reference_vblank_ns = reference_ns_;
+    grid.period_ns = period_ns_;
+    grid.line_time_ns = line_time_ns_;
+    grid.active_lines = active_lines_;
+    grid.locked = IsLocked();
+    return grid;
+}
+
+VblankPhaseLockStats VblankPhaseLock::GetStats() const {
+    VblankPhaseLockStats s;
+    s.locked = IsLocked();
+    s.period_ms = period_ns_ / kNsPerMs;
+    s.nominal_period_ms = static_cast<double>(nominal_period_ns_) / kNsPerMs;
+    if (nominal_period_ns_ > 0 && period_ns_ > 0.0) {
+        s.drift_ppm = (period_ns_ / static_cast<double>(nominal_period_ns_) - 1.0) * 1'000'000.0;
+    }
+    s.line_time_us = line_time_ns_ / kNsPerUs;
+    s.active_lines = active_lines_;
+    if (line_time_ns_ > 0.0) {
+        s.total_lines = static_cast<uint32_t>(std::lround(period_ns_ / line_time_ns_));
+    }
+    s.phase_error_rms_us = std::sqrt(error_sq_ema_) / kNsPerUs;
+    s.last_phase_error_us = last_error_ns_ / kNsPerUs;
+    s.wait_latency_us = wait_latency_ema_ns_ / kNsPerUs;
+    s.wait_observations = wait_observations_;
+    s.scanline_observations = scanline_observations_;
+    s.outliers = outliers_;
+    s.relocks = relocks_;
+    return s;
+}
+
+void VblankPhaseLock::Reset() {
+    const int64_t nominal_period_ns = nominal_period_ns_;
+    const uint32_t active_lines = active_lines_;
+    *this = VblankPhaseLock();
+    nominal_period_ns_ = nominal_period_ns;
+    active_lines_ = active_lines;
+}
+
+int64_t TearLineLeadNs(const VblankGrid& grid, double tear_line_fraction) {
+    const double below_line = 1.0 - std::clamp(tear_line_fraction, 0.0, 1.0);
+    // Without a line time the active area is taken as the whole period (vblank is a few percent of it)
+    const double active_ns = grid.line_time_ns > 0.0 ? grid.line_time_ns * static_cast<double>(grid.active_lines)
+                                                     : grid.period_ns;
+    return static_cast<int64_t>(std::llround(below_line * active_ns));
+}
+
+bool VblankPresentScheduler::Schedule(const VblankGrid& grid, int64_t now_ns, uint32_t interval_vblanks,
+                                      int64_t lead_ns, VblankTarget* target_out) {
+    ++stats_.frames;
+    if (!grid.locked || grid.period_ns <= 0.0) {
+        ++stats_.unlocked_frames;
+        last_vblank_ns_ = 0;
+        return false;
+    }
+    const uint32_t interval = (std::max)(interval_vblanks, 1u);
+    const int64_t half_period_ns = static_cast<int64_t>(grid.period_ns / 2.0);
+    // First vblank present can still be issued for
+    const int64_t earliest_ns = grid.NextVblankAtOrAfter(now_ns + lead_ns);
+
+    VblankTarget target;
+    target.vblank_ns = earliest_ns;
+    if (last_vblank_ns_ > 0) {
+        const int64_t planned_ns = grid.NextVblankAtOrAfter(
+            last_vblank_ns_ + static_cast<int64_t>(std::llround(interval * grid.period_ns)) - half_period_ns);
+        if (planned_ns >= earliest_ns) {
+            // Planned vblank still reachable; a plan further out than one interval means the grid moved (relock)
+            if (static_cast<double>(planned_ns - earliest_ns) < interval * grid.period_ns) {
+                target.vblank_ns = planned_ns;
+            }
+        } else if (static_cast<double>(earliest_ns - planned_ns) <= kMaxMissedVblanks * grid.period_ns) {
+            target.missed_vblanks =
+                static_cast<uint32_t>(std::lround(static_cast<double>(earliest_ns - planned_ns) / grid.period_ns));
+            target.late_ns = now_ns + lead_ns - planned_ns;
+            ++stats_.late_frames;
+            stats_.missed_vblanks += target.missed_vblanks;
+        }
+    }
+    target.release_ns = target.vblank_ns - lead_ns;
+    last_vblank_ns_ = target.vblank_ns;
+    *target_out = target;
+    return true;
+}
+
+void VblankPresentScheduler::Reset() {
+    last_vblank_ns_ = 0;
+    stats_ = VblankSchedulerStats{};
+}
+
+VblankTarget VblankFallbackPacer::Schedule(uint64_t swapchain_key, int64_t now_ns, double frame_time_ns) {
+    Cadence* cadence = nullptr;
+    for (Cadence& c : cadences_) {
+        if (c.used && c.key == swapchain_key) {
+            cadence = &c;
+            break;
+        }
+    }
+    if (cadence == nullptr) {
+        // Free slot, else the swapchain that presented least recently
+        cadence = &cadences_[0];
+        for (Cadence& c : cadences_) {
+            if (!c.used || (cadence->used && c.last_release_ns < cadence->last_release_ns)) {
+                cadence = &c;
+                if (!c.used) {
+                    break;
+                }
+            }
+        }
+        *cadence = Cadence{true, swapchain_key, 0};
+    }
+
+    VblankTarget target;
+    target.release_ns = now_ns;
+    if (cadence->last_release_ns != 0 && now_ns - cadence->last_release_ns <= kIdleRestartNs) {
+        target.release_ns = cadence->last_release_ns + static_cast<int64_t>(std::llround(frame_time_ns));
+        target.late_ns = (std::max)(int64_t{0}, now_ns - target.release_ns);
+    }
+    cadence->last_release_ns = (std::max)(target.release_ns, now_ns);
+    return target;
+}
+
+void VblankFallbackPacer::Forget(uint64_t swapchain_key) {
+    for (Cadence& c : cadences_) {
+        if (c.used && c.key == swapchain_key) {
+            c = Cadence{};
+        }
+    }
+}
+
+}  // namespace display_commander::feature::vblank_lock
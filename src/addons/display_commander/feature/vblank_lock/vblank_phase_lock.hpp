@@ -0,0 +1,165 @@
+// Source Code <Display Commander> // VBlank phase lock core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::feature::vblank_lock {
+
+// One reading from the display: the return of a vblank wait, or a scanline query.
+struct VblankObservation {
+    int64_t time_ns = 0;      // When the reading was taken (midpoint of the query for scanline reads)
+    bool from_wait = false;   // Return of a vblank wait: the vblank started shortly before time_ns
+    bool in_vblank = false;   // Scanline reads only
+    uint32_t scanline = 0;    // Scanline reads only; valid outside vblank
+};
+
+// Estimated vblank timeline: vblanks start at reference_vblank_ns + n * period_ns.
+struct VblankGrid {
+    int64_t reference_vblank_ns = 0;
+    double period_ns = 0.0;
+    double line_time_ns = 0.0;  // Scanout time of one line (0 = unknown)
+    uint32_t active_lines = 0;
+    bool locked = false;
+
+    // Start of the first vblank at or after time_ns (0 when the grid has no period yet).
+    int64_t NextVblankAtOrAfter(int64_t time_ns) const;
+};
+
+struct VblankPhaseLockStats {
+    bool locked = false;
+    double period_ms = 0.0;
+    double nominal_period_ms = 0.0;
+    double drift_ppm = 0.0;  // Estimated period vs nominal refresh rate
+    double line_time_us = 0.0;
+    uint32_t active_lines = 0;
+    uint32_t total_lines = 0;  // Active + vblank lines, from period / line time
+    double phase_error_rms_us = 0.0;  // Observed vs predicted vblank start
+    double last_phase_error_us = 0.0;
+    double wait_latency_us = 0.0;  // How late vblank waits return (once scanline reads drive the lock)
+    uint64_t wait_observations = 0;
+    uint64_t scanline_observations = 0;
+    uint64_t outliers = 0;
+    uint64_t relocks = 0;
+};
+
+// Tracks vblank phase and period with an alpha-beta filter. Scanline reads outside vblank give the precise phase
+// (time left until the active area ends, from the measured line time); vblank waits only acquire the lock while no
+// scanline reads are available, since their wake-up delay is biased and jittery. The period term follows the
+// display clock, so the grid stays aligned when the refresh rate differs slightly from its nominal value (drift).
+// Not thread-safe: feed and read from one thread, publish GetGrid() to others.
+class VblankPhaseLock {
+   public:
+    static constexpr double kPhaseGain = 0.2;
+    static constexpr double kPeriodGain = 0.02;
+    static constexpr double kOutlierFraction = 0.25;  // Of a period
+    static constexpr uint32_t kRelockOutliers = 6;    // Consecutive outliers: the display timing changed
+    static constexpr uint32_t kLockObservations = 32;
+    static constexpr double kLockedRmsFraction = 0.03;  // Of a period
+    static constexpr double kMaxDriftFraction = 0.03;   // Estimated period stays within this of nominal
+
+    // nominal_period_ns from the refresh rate (0 = unknown: measured from vblank waits), active_lines from the
+    // display mode height. Resets when either changes.
+    void SetGeometry(int64_t nominal_period_ns, uint32_t active_lines);
+
+    void AddObservation(const VblankObservation& observation);
+
+    VblankGrid GetGrid() const;
+    VblankPhaseLockStats GetStats() const;
+
+    void Reset();
+
+   private:
+    void Track(int64_t vblank_ns);
+    void Relock(int64_t vblank_ns);
+    bool IsLocked() const;
+
+    int64_t nominal_period_ns_ = 0;
+    uint32_t active_lines_ = 0;
+
+    bool have_reference_ = false;
+    int64_t reference_ns_ = 0;  // Latest tracked vblank start
+    double period_ns_ = 0.0;
+    double line_time_ns_ = 0.0;
+    int64_t last_active_time_ns_ = 0;
+    uint32_t last_active_line_ = 0;
+    bool scanline_tracking_ = false;  // Scanline reads drive the loop
+
+    uint32_t tracked_since_lock_ = 0;
+    uint32_t consecutive_outliers_ = 0;
+    double error_sq_ema_ = 0.0;
+    double last_error_ns_ = 0.0;
+    double wait_latency_ema_ns_ = 0.0;
+
+    uint64_t wait_observations_ = 0;
+    uint64_t scanline_observations_ = 0;
+    uint64_t outliers_ = 0;
+    uint64_t relocks_ = 0;
+};
+
+// Lead before vblank that puts the tear line (presenting without VSync) at tear_line_fraction of the active area:
+// 0 = top, 1 = bottom edge (the vblank itself).
+int64_t TearLineLeadNs(const VblankGrid& grid, double tear_line_fraction);
+
+struct VblankTarget {
+    int64_t vblank_ns = 0;   // Vblank this frame is meant for
+    int64_t release_ns = 0;  // vblank_ns - lead: when present should be issued
+    uint32_t missed_vblanks = 0;  // Vblanks skipped because the frame was ready too late for its planned one
+    int64_t late_ns = 0;          // How far past its planned release the frame became ready (0 = on time)
+};
+
+struct VblankSchedulerStats {
+    uint64_t frames = 0;
+    uint64_t late_frames = 0;
+    uint64_t missed_vblanks = 0;
+    uint64_t unlocked_frames = 0;  // No lock yet: not scheduled
+};
+
+// Picks the vblank each frame presents for: interval_vblanks after the previous frame's, or the first one still
+// reachable when the frame is late. Targets are re-snapped to the current grid every frame, so period corrections
+// apply immediately instead of accumulating as drift.
+class VblankPresentScheduler {
+   public:
+    // now_ns: frame ready to present. lead_ns: how long before vblank present is issued. Returns false (out
+    // untouched) while the grid is not locked.
+    bool Schedule(const VblankGrid& grid, int64_t now_ns, uint32_t interval_vblanks, int64_t lead_ns,
+                  VblankTarget* target_out);
+
+    VblankSchedulerStats GetStats() const { return stats_; }
+
+    void Reset();
+
+   private:
+    int64_t last_vblank_ns_ = 0;
+    VblankSchedulerStats stats_;
+};
+
+// Spaces frames by frame time while the display timing is not locked yet. One cadence per swapchain (keyed by its
+// window): a second or recreated swapchain starts its own cadence instead of inheriting another one's release time,
+// and a cadence idle for kIdleRestartNs (mode switched away, loading screen) restarts at the current frame instead
+// of reporting it as late.
+class VblankFallbackPacer {
+   public:
+    static constexpr size_t kMaxSwapchains = 4;
+    static constexpr int64_t kIdleRestartNs = 1'000'000'000;
+
+    // Release time (vblank_ns stays 0) and lateness of a frame ready at now_ns. swapchain_key 0 is a valid key.
+    VblankTarget Schedule(uint64_t swapchain_key, int64_t now_ns, double frame_time_ns);
+
+    // Swapchain destroyed: its next frame starts a new cadence.
+    void Forget(uint64_t swapchain_key);
+
+    void Reset() { cadences_ = {}; }
+
+   private:
+    struct Cadence {
+        bool used = false;
+        uint64_t key = 0;
+        int64_t last_release_ns = 0;
+    };
+    std::array<Cadence, kMaxSwapchains> cadences_ = {};
+};
+
+}  // namespace display_commander::feature::vblank_lock
@@ -1,5 +1,6 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #include "streamline_proxy_dxgi.hpp"
+#include "../../feature/fg_pacing/fg_pacing.hpp"
 
 #include "../../globals.hpp"
 #include "../../hooks/dxgi/dxgi_present_hooks.hpp"
@@ -176,6 +177,7 @@ HRESULT STDMETHODCALLTYPE IDXGISwapChain_Present_Streamline_Detour(IDXGISwapChai
     }
     const LONGLONG now_ns = utils::get_now_ns();
     display_commanderhooks::g_last_dxgi_present_time_ns.store(static_cast<uint64_t>(now_ns), std::memory_order_relaxed);
+    display_commander::feature::fg_pacing::RecordFgGamePresent(now_ns);
     CALL_GUARD(now_ns);
 
     if (settings::g_advancedTabSettings.flush_command_queue_before_sleep.GetValue()) {
@@ -220,6 +222,7 @@ HRESULT STDMETHODCALLTYPE IDXGISwapChain_Present1_Streamline_Detour(IDXGISwapCha
         display_commanderhooks::dxgi::LoadDCDxgiSwapchainData(baseSwapChain, &data);
     }
     CALL_GUARD_NO_TS();
+    display_commander::feature::fg_pacing::RecordFgGamePresent(utils::get_now_ns());
 
     if (settings::g_advancedTabSettings.flush_command_queue_before_sleep.GetValue()) {
         if (data.command_queue != nullptr) {
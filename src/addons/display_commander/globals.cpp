@@ -505,7 +505,7 @@ std::atomic<int> g_game_render_height{0};
 std::atomic<bool> g_app_in_background{false};
 std::atomic<LONGLONG> g_last_foreground_background_switch_ns{0};
 
-// FPS limiter: enabled by checkbox; mode 0 = OnPresentSync, 1 = Reflex
+// FPS limiter: enabled by checkbox; mode 0 = OnPresentSync, 1 = Reflex, 2 = VBlank phase lock
 std::atomic<bool> s_fps_limiter_enabled{true};
 std::atomic<FpsLimiterMode> s_fps_limiter_mode{FpsLimiterMode::kOnPresentSync};
 
@@ -292,7 +292,7 @@ Microsoft::WRL::ComPtr<IDXGIFactory1> GetSharedDXGIFactory();
 
 // Enums
 enum class WindowStyleMode : std::uint8_t { KEEP, BORDERLESS, OVERLAPPED_WINDOW };
-enum class FpsLimiterMode : std::uint8_t { kOnPresentSync = 0, kReflex = 1 };
+enum class FpsLimiterMode : std::uint8_t { kOnPresentSync = 0, kReflex = 1, kVblankLocked = 2 };
 enum class WindowMode : std::uint8_t {
     kNoChanges = 0,                 // No changes; do not prevent exclusive fullscreen
     kFullscreen = 1,                // Borderless fullscreen (resize) + prevent exclusive fullscreen
@@ -719,8 +719,8 @@ bool IsAppInBackground();
 // Timestamp (ns) of last foreground<->background switch; used to limit VRR/NVAPI updates to 5s after switch
 extern std::atomic<LONGLONG> g_last_foreground_background_switch_ns;
 
-// FPS limiter: enabled by checkbox (s_fps_limiter_enabled). Mode: 0 = OnPresentSync, 1 = Reflex
-// (VBlank).
+// FPS limiter: enabled by checkbox (s_fps_limiter_enabled). Mode: 0 = OnPresentSync, 1 = Reflex,
+// 2 = VBlank phase lock.
 extern std::atomic<bool> s_fps_limiter_enabled;
 extern std::atomic<FpsLimiterMode> s_fps_limiter_mode;
 
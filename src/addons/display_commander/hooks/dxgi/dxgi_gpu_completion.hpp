@@ -6,9 +6,13 @@
 #include <d3d11_4.h>
 #include <d3d12.h>
 
+#include <cstddef>
+#include <cstdint>
+
 // GPU completion measurement functions
 // Enqueue GPU completion measurement for the given swapchain
-// This sets up a GPU fence that will be signaled when the GPU completes rendering
+// This signals the next value of the swapchain's fence ring; a per-swapchain waiter thread stamps
+// g_frame_data[frame_id % kFrameDataBufferSize].gpu_completion_time_ns when the GPU reaches it.
 // command_queue is optional but recommended for D3D12 to signal the fence correctly
 void EnqueueGPUCompletion(reshade::api::swapchain* swapchain, IDXGISwapChain* dxgi_swapchain, reshade::api::command_queue* command_queue = nullptr);
 
@@ -17,3 +21,24 @@ void EnqueueGPUCompletion(reshade::api::swapchain* swapchain, IDXGISwapChain* dx
 void EnqueueGPUCompletionFromRecordedState(IDXGISwapChain* dxgi_swapchain,
                                            const display_commanderhooks::dxgi::DCDxgiSwapchainData* data);
 
+namespace display_commanderhooks::dxgi {
+
+// Aggregated fence ring counters over all tracked swapchains (debug / overlay).
+struct GPUCompletionStats {
+    size_t active_swapchains = 0;
+    size_t in_flight = 0;
+    uint64_t enqueued = 0;
+    uint64_t completed = 0;
+    uint64_t dropped_ring_full = 0;
+    uint64_t signal_failures = 0;
+};
+
+GPUCompletionStats GetGPUCompletionStats();
+
+// Stop all waiter threads and release every fence ring (device destroyed).
+void CleanupGPUMeasurementState();
+
+// Stop the waiter and release the fence ring of one swapchain (swapchain destroyed, not resized).
+void ReleaseGPUCompletionForSwapchain(IDXGISwapChain* dxgi_swapchain);
+
+}  // namespace display_commanderhooks::dxgi
@@ -1,4 +1,5 @@
 #include "dxgi_present_hooks.hpp"
+#include "../../feature/fg_pacing/fg_pacing.hpp"
 #include "../../features/smooth_motion/smooth_motion.hpp"
 #include "../../globals.hpp"
 #include "../../performance_types.hpp"
@@ -42,257 +43,6 @@
  * The base IDXGISwapChain interface only goes up to index 17.
  */
 
-// GPU completion measurement state
-namespace {
-struct GPUMeasurementState {
-    // TODO: caused reshade to report not cleaned up state
-    Microsoft::WRL::ComPtr<ID3D11Fence> d3d11_fence;
-    Microsoft::WRL::ComPtr<ID3D12Fence> d3d12_fence;
-    HANDLE event_handle = nullptr;
-    std::atomic<uint64_t> fence_value{0};
-    std::atomic<bool> initialized{false};
-    std::atomic<bool> is_d3d12{false};
-    std::atomic<bool> initialization_attempted{false};
-
-    ~GPUMeasurementState() {
-        if (event_handle != nullptr) {
-            CloseHandle(event_handle);
-            event_handle = nullptr;
-        }
-    }
-};
-
-GPUMeasurementState g_gpu_state;
-
-// Helper function to enqueue GPU completion measurement for D3D11
-void EnqueueGPUCompletionD3D11(IDXGISwapChain* swapchain) {
-    if (settings::g_mainTabSettings.gpu_measurement_enabled.GetValue() == 0) {
-        g_gpu_fence_failure_reason.store("GPU measurement disabled");
-        return;
-    }
-
-    Microsoft::WRL::ComPtr<ID3D11Device5> device5;
-    HRESULT hr = swapchain->GetDevice(IID_PPV_ARGS(&device5));
-    if (FAILED(hr)) {
-        g_gpu_fence_failure_reason.store("D3D11: Failed to get device from swapchain");
-        return;
-    }
-    // Initialize fence on first use
-    if (!g_gpu_state.initialized.load() && !g_gpu_state.initialization_attempted.load()) {
-        g_gpu_state.initialization_attempted.store(true);
-
-        hr = device5->CreateFence(0, D3D11_FENCE_FLAG_NONE, IID_PPV_ARGS(&g_gpu_state.d3d11_fence));
-        if (FAILED(hr)) {
-            g_gpu_fence_failure_reason.store("D3D11: CreateFence failed (driver may not support fences)");
-            return;
-        }
-
-        g_gpu_state.event_handle = CreateEventW(nullptr, FALSE, FALSE, nullptr);
-        if (g_gpu_state.event_handle == nullptr) {
-            g_gpu_state.d3d11_fence.Reset();
-            g_gpu_fence_failure_reason.store("D3D11: Failed to create event handle");
-            return;
-        }
-
-        g_gpu_state.is_d3d12.store(false);
-        g_gpu_state.initialized.store(true);
-        //  g_gpu_fence_failure_reason.store("success!!!"); // Clear failure reason on success
-    }
-
-    if (!static_cast<bool>(g_gpu_state.d3d11_fence)) {
-        g_gpu_fence_failure_reason.store("D3D11: Fence not initialized");
-        return;
-    }
-
-    // Get immediate context and signal fence
-    Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
-    device5->GetImmediateContext(&context);
-
-    Microsoft::WRL::ComPtr<ID3D11DeviceContext4> context4;
-    hr = context.As(&context4);
-    if (FAILED(hr)) {
-        g_gpu_fence_failure_reason.store("D3D11: ID3D11DeviceContext4 not supported (requires D3D11.3+)");
-        return;
-    }
-
-    uint64_t signal_value = g_gpu_state.fence_value.fetch_add(1) + 1;
-
-    // Signal the fence from GPU
-    hr = context4->Signal(g_gpu_state.d3d11_fence.Get(), signal_value);
-    if (FAILED(hr)) {
-        g_gpu_fence_failure_reason.store("D3D11: Failed to signal fence");
-        return;
-    }
-
-    // Set event to trigger when fence reaches this value
-    hr = g_gpu_state.d3d11_fence->SetEventOnCompletion(signal_value, g_gpu_state.event_handle);
-    if (FAILED(hr)) {
-        g_gpu_fence_failure_reason.store("D3D11: SetEventOnCompletion failed");
-        return;
-    }
-
-    g_gpu_fence_failure_reason.store(nullptr);  // Clear failure reason on success
-}
-
-// Helper function to enqueue GPU completion measurement for D3D12
-void EnqueueGPUCompletionD3D12(IDXGISwapChain* swapchain, ID3D12CommandQueue* command_queue) {
-    if (settings::g_mainTabSettings.gpu_measurement_enabled.GetValue() == 0) {
-        return;
-    }
-
-    Microsoft::WRL::ComPtr<ID3D12Device> device;
-    HRESULT hr = swapchain->GetDevice(IID_PPV_ARGS(&device));
-    if (FAILED(hr)) {
-        g_gpu_fence_failure_reason.store("D3D12: Failed to get device from swapchain");
-        return;
-    }
-
-    // Initialize fence on first use
-    if (!g_gpu_state.initialized.load() && !g_gpu_state.initialization_attempted.load()) {
-        g_gpu_state.initialization_attempted.store(true);
-
-        hr = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&g_gpu_state.d3d12_fence));
-        if (FAILED(hr)) {
-            g_gpu_fence_failure_reason.store("D3D12: CreateFence failed");
-            return;
-        }
-
-        g_gpu_state.event_handle = CreateEventW(nullptr, FALSE, FALSE, nullptr);
-        if (g_gpu_state.event_handle == nullptr) {
-            g_gpu_state.d3d12_fence.Reset();
-            g_gpu_fence_failure_reason.store("D3D12: Failed to create event handle");
-            return;
-        }
-
-        g_gpu_state.is_d3d12.store(true);
-        g_gpu_state.initialized.store(true);
-    }
-
-    if (!static_cast<bool>(g_gpu_state.d3d12_fence)) {
-        g_gpu_fence_failure_reason.store("D3D12: Fence not initialized");
-        return;
-    }
-
-    // Check if command queue is available
-    if (command_queue == nullptr) {
-        g_gpu_fence_failure_reason.store("D3D12: Command queue not provided (cannot signal fence)");
-        return;
-    }
-
-    // Increment fence value and signal it on the command queue
-    uint64_t signal_value = g_gpu_state.fence_value.fetch_add(1) + 1;
-
-    // Set event to trigger when fence reaches this value
-    hr = g_gpu_state.d3d12_fence->SetEventOnCompletion(signal_value, g_gpu_state.event_handle);
-    if (FAILED(hr)) {
-        g_gpu_fence_failure_reason.store("D3D12: SetEventOnCompletion failed");
-        return;
-    }
-
-    // Signal the fence on the command queue
-    // This will be signaled when the GPU completes all work up to this point
-    hr = command_queue->Signal(g_gpu_state.d3d12_fence.Get(), signal_value);
-    if (FAILED(hr)) {
-        g_gpu_fence_failure_reason.store("D3D12: Failed to signal fence on command queue");
-        return;
-    }
-
-    g_gpu_fence_failure_reason.store(nullptr);  // Clear failure reason on success
-}
-
-// Helper function to enqueue GPU completion measurement (auto-detects API)
-void EnqueueGPUCompletionInternal(IDXGISwapChain* swapchain, ID3D12CommandQueue* command_queue) {
-    if (swapchain == nullptr) {
-        g_gpu_fence_failure_reason.store("Failed to get device from swapchain");
-        return;
-    }
-    // Reset FG-detection tracking flag for this frame
-    g_present_update_after2_called.store(false);
-
-    // Try D3D12 first
-
-    // Try D3D11
-    Microsoft::WRL::ComPtr<ID3D11Device> d3d11_device;
-    Microsoft::WRL::ComPtr<ID3D12Device> d3d12_device;
-    if (SUCCEEDED(swapchain->GetDevice(IID_PPV_ARGS(&d3d12_device)))) {
-        EnqueueGPUCompletionD3D12(swapchain, command_queue);
-        return;
-    } else if (SUCCEEDED(swapchain->GetDevice(IID_PPV_ARGS(&d3d11_device)))) {
-        EnqueueGPUCompletionD3D11(swapchain);
-        return;
-    } else {
-        g_gpu_fence_failure_reason.store("Failed to get device from swapchain");
-    }
-}
-
-// Cleanup function to reset fences and state when device is destroyed
-void CleanupGPUMeasurementState() {
-    if (g_gpu_state.initialized.load()) {
-        LogInfo("Cleaning up GPU measurement fences on device destruction");
-
-        // Reset fences (ComPtr will automatically release references)
-        g_gpu_state.d3d11_fence.Reset();
-        g_gpu_state.d3d12_fence.Reset();
-
-        // Close event handle if it exists
-        if (g_gpu_state.event_handle != nullptr) {
-            CloseHandle(g_gpu_state.event_handle);
-            g_gpu_state.event_handle = nullptr;
-        }
-
-        // Reset state flags
-        g_gpu_state.fence_value.store(0);
-        g_gpu_state.initialized.store(false);
-        g_gpu_state.is_d3d12.store(false);
-        g_gpu_state.initialization_attempted.store(false);
-
-        LogInfo("GPU measurement fences cleaned up successfully");
-    }
-}
-}  // namespace
-
-// Public API wrapper that works with ReShade swapchain
-void EnqueueGPUCompletion(reshade::api::swapchain* swapchain, IDXGISwapChain* dxgi_swapchain,
-                          reshade::api::command_queue* command_queue) {
-    if (perf_measurement::IsSuppressionEnabled()
-        && perf_measurement::IsMetricSuppressed(perf_measurement::Metric::EnqueueGPUCompletion)) {
-        return;
-    }
-
-    perf_measurement::ScopedTimer perf_timer(perf_measurement::Metric::EnqueueGPUCompletion);
-
-    if (swapchain == nullptr) {
-        g_gpu_fence_failure_reason.store("Failed to get swapchain from swapchain, swapchain is nullptr");
-        return;
-    }
-
-    // Get native D3D12 command queue if provided (for D3D12 fence signaling)
-    ID3D12CommandQueue* d3d12_command_queue = nullptr;
-    if (command_queue != nullptr && swapchain->get_device()->get_api() == reshade::api::device_api::d3d12) {
-        d3d12_command_queue = reinterpret_cast<ID3D12CommandQueue*>(command_queue->get_native());
-    }
-
-    // Call the internal enqueue function
-    ::EnqueueGPUCompletionInternal(dxgi_swapchain, d3d12_command_queue);
-}
-
-void EnqueueGPUCompletionFromRecordedState(IDXGISwapChain* dxgi_swapchain,
-                                           const display_commanderhooks::dxgi::DCDxgiSwapchainData* data) {
-    if (perf_measurement::IsSuppressionEnabled()
-        && perf_measurement::IsMetricSuppressed(perf_measurement::Metric::EnqueueGPUCompletion)) {
-        return;
-    }
-    perf_measurement::ScopedTimer perf_timer(perf_measurement::Metric::EnqueueGPUCompletion);
-    if (dxgi_swapchain == nullptr || data == nullptr || data->dxgi_swapchain == nullptr) {
-        return;
-    }
-    ID3D12CommandQueue* d3d12_queue = nullptr;
-    if (data->device_api == reshade::api::device_api::d3d12 && data->command_queue != nullptr) {
-        d3d12_queue = reinterpret_cast<ID3D12CommandQueue*>(data->command_queue->get_native());
-    }
-    ::EnqueueGPUCompletionInternal(data->dxgi_swapchain, d3d12_queue);
-}
-
 namespace display_commanderhooks::dxgi {
 
 // Log DXGI error up to 10 times per method (each detour has its own static counter).
@@ -348,6 +98,7 @@ HRESULT STDMETHODCALLTYPE IDXGISwapChain_Present_Detour(IDXGISwapChain* This, UI
     CALL_GUARD_NO_TS();
     const LONGLONG now_ns = utils::get_now_ns();
     display_commanderhooks::g_last_dxgi_present_time_ns.store(static_cast<uint64_t>(now_ns), std::memory_order_relaxed);
+    display_commander::feature::fg_pacing::RecordFgOutputPresent(now_ns);
     CALL_GUARD(now_ns);
 
     // Flush command queue before present when we have it from this swapchain's private data (optional, default on)
@@ -411,6 +162,7 @@ HRESULT STDMETHODCALLTYPE IDXGISwapChain_Present1_Detour(IDXGISwapChain1* This,
     }
 
     CALL_GUARD_NO_TS();
+    display_commander::feature::fg_pacing::RecordFgOutputPresent(utils::get_now_ns());
 
     // Flush command queue before present when we have it from this swapchain's private data (optional, default on)
     if (settings::g_advancedTabSettings.flush_command_queue_before_sleep.GetValue()) {
@@ -746,7 +498,7 @@ void SaveDCDxgiSwapchainDataForD3D9(const DCDxgiSwapchainData* data) {
 // Cleanup GPU measurement fences when device is destroyed
 void CleanupGPUMeasurementFences() {
     LogInfo("[CleanupGPUMeasurementFences] cleaning up GPU measurement fences");
-    ::CleanupGPUMeasurementState();
+    CleanupGPUMeasurementState();
 }
 
 }  // namespace display_commanderhooks::dxgi
@@ -16,6 +16,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "../globals.hpp"
+#include "../feature/hitch/hitch.hpp"
 #include "../features/smooth_motion/smooth_motion.hpp"
 #include "../settings/streamline_tab_settings.hpp"
 #include "../utils/detour_call_tracker.hpp"
@@ -377,8 +378,10 @@ HMODULE WINAPI LoadLibraryA_Detour(LPCSTR lpLibFileName) {
     }
 
     // Call original function with potentially overridden path
+    const LONGLONG load_start_ns = utils::get_now_ns();
     HMODULE result =
         LoadLibraryA_Original ? LoadLibraryA_Original(actual_lib_file_name) : LoadLibraryA(actual_lib_file_name);
+    display_commander::feature::hitch::RecordHitchModuleLoad(load_start_ns, utils::get_now_ns(), lpLibFileName);
 
     if (result && used_dlss_override) {
         RecordDlssOverrideHandle(std::wstring(dll_name.begin(), dll_name.end()), result);
@@ -452,8 +455,10 @@ HMODULE WINAPI LoadLibraryW_Detour(LPCWSTR lpLibFileName) {
     }
 
     // Call original function with potentially overridden path
+    const LONGLONG load_start_ns = utils::get_now_ns();
     HMODULE result =
         LoadLibraryW_Original ? LoadLibraryW_Original(actual_lib_file_name) : LoadLibraryW(actual_lib_file_name);
+    display_commander::feature::hitch::RecordHitchModuleLoad(load_start_ns, utils::get_now_ns(), lpLibFileName);
 
     if (result && !override_path.empty() && std::filesystem::exists(override_path)) {
         RecordDlssOverrideHandle(lpLibFileName, result);
@@ -517,8 +522,10 @@ HMODULE WINAPI LoadLibraryExA_Detour(LPCSTR lpLibFileName, HANDLE hFile, DWORD d
     }
 
     // Call original function with potentially overridden path
+    const LONGLONG load_start_ns = utils::get_now_ns();
     HMODULE result = LoadLibraryExA_Original ? LoadLibraryExA_Original(actual_lib_file_name, hFile, dwFlags)
                                              : LoadLibraryExA(actual_lib_file_name, hFile, dwFlags);
+    display_commander::feature::hitch::RecordHitchModuleLoad(load_start_ns, utils::get_now_ns(), lpLibFileName);
 
     if (result && used_dlss_override_exa) {
         RecordDlssOverrideHandle(std::wstring(dll_name.begin(), dll_name.end()), result);
@@ -595,8 +602,10 @@ HMODULE WINAPI LoadLibraryExW_Detour(LPCWSTR lpLibFileName, HANDLE hFile, DWORD
     }
 
     // Call original function with potentially overridden path
+    const LONGLONG load_start_ns = utils::get_now_ns();
     HMODULE result = LoadLibraryExW_Original ? LoadLibraryExW_Original(actual_lib_file_name, hFile, dwFlags)
                                              : LoadLibraryExW(actual_lib_file_name, hFile, dwFlags);
+    display_commander::feature::hitch::RecordHitchModuleLoad(load_start_ns, utils::get_now_ns(), lpLibFileName);
 
     if (result && !override_path.empty() && std::filesystem::exists(override_path)) {
         RecordDlssOverrideHandle(lpLibFileName, result);
@@ -1,6 +1,7 @@
 #include "nvapi_hooks.hpp"
 #include "../../../../external/nvapi/nvapi_interface.h"
 #include "../../globals.hpp"
+#include "../../latency/latency_markers.hpp"
 #include "../../settings/advanced_tab_settings.hpp"
 #include "../../settings/main_tab_settings.hpp"
 #include "../../swapchain_events.hpp"
@@ -256,6 +257,9 @@ NvAPI_Status __cdecl NvAPI_D3D_SetLatencyMarker_Detour(IUnknown* pDev,
         g_nvapi_d3d_setlatencymarker_last_thread_id[static_cast<size_t>(marker_type)].store(
             static_cast<uint32_t>(GetCurrentThreadId()), std::memory_order_relaxed);
     }
+    display_commander::latency::PublishLatencyMarker(display_commander::latency::LatencyMarkerSource::kNvapiD3D,
+                                                     static_cast<uint32_t>(marker_type),
+                                                     pSetLatencyMarkerParams->frameID);
 
     const ReflexMarkerTypes nvapi_markers = GetNvapiReflexMarkerTypesForFpsLimiter();
     #ifdef FIX_REFLEX
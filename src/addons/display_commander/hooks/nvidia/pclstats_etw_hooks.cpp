@@ -1,13 +1,18 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #include "pclstats_etw_hooks.hpp"
 #include "../../globals.hpp"
+#include "../../latency/latency_markers.hpp"
+#include "../../latency/pclstats_event_queue.hpp"
 #include "../../utils/general_utils.hpp"
 #include "../../utils/logging.hpp"
 #include "../../utils/string_utils.hpp"
+#include "../../utils/timing.hpp"
 
 // Libraries <standard C++>
+#include <algorithm>
 #include <atomic>
 #include <array>
+#include <cstdint>
 #include <cstring>
 #include <cstdio>
 #include <cwchar>
@@ -38,6 +43,19 @@ static EventWriteTransfer_pfn EventWriteTransfer_Original = nullptr;
 static std::atomic<bool> g_pclstats_etw_hooks_installed{false};
 // REGHANDLE returned when a non–Display Commander module registers the PCLStats provider
 static std::atomic<REGHANDLE> g_pclstats_foreign_reg_handle{REGHANDLE(0)};
+// All foreign PCLStats registrations (game PCLStats and Streamline sl.pcl register separately); matched per write
+static constexpr size_t kMaxForeignRegistrations = 4;
+static std::array<std::atomic<REGHANDLE>, kMaxForeignRegistrations> g_pclstats_foreign_reg_handles{};
+static std::atomic<size_t> g_pclstats_foreign_reg_count{0};
+static const uint64_t kPCLStatsProviderIdHash = display_commander::latency::HashProviderGuid(&kPCLStatsProviderId);
+// Matched writes are copied raw into the queue on the game thread and decoded by DrainPclStatsEtwEvents
+static display_commander::latency::PclStatsEventQueue& g_pclstats_event_queue =
+    *new display_commander::latency::PclStatsEventQueue();  // Leaked: game threads may write during unload
+static std::atomic<uint64_t> g_pclstats_etw_forwarded{0};
+static std::atomic<uint64_t> g_pclstats_etw_matched{0};
+static std::atomic<uint64_t> g_pclstats_etw_copy_failed{0};
+static std::atomic<uint64_t> g_pclstats_etw_decoded_markers{0};
+static std::atomic<uint64_t> g_pclstats_etw_decoded_other{0};
 static std::atomic<bool> g_pclstats_foreign_pclstatsinit_seen{false};
 static std::atomic<ULONG> g_dc_cleanup_removed_count{0};
 static std::atomic<ULONG> g_dc_cleanup_status{ERROR_GEN_FAILURE};
@@ -66,6 +84,31 @@ static bool BlobContainsPclStatsInit(const void* ptr, ULONG size) {
     return false;
 }
 
+// Raw copy of a PCLStats write into a queue slot; the consumer decodes it. Plain data only (SEH).
+static bool CopyPclStatsRawEvent(ULONG user_data_count, const EVENT_DATA_DESCRIPTOR* user_data,
+                                 display_commander::latency::PclStatsRawEvent* out) {
+    using display_commander::latency::PclStatsRawEvent;
+    if (user_data == nullptr || user_data_count < 2) return false;
+    __try {
+        const EVENT_DATA_DESCRIPTOR& meta = user_data[1];
+        const ULONG meta_size = (std::min)(meta.Size, static_cast<ULONG>(PclStatsRawEvent::kMetaBytes));
+        std::memcpy(out->meta, reinterpret_cast<const void*>(static_cast<uintptr_t>(meta.Ptr)), meta_size);
+        out->meta_size = static_cast<uint16_t>(meta_size);
+        out->field_count = static_cast<uint8_t>((std::min)(user_data_count - 2, ULONG{2}));
+        size_t offset = 0;
+        for (uint8_t i = 0; i < out->field_count; ++i) {
+            const EVENT_DATA_DESCRIPTOR& field = user_data[2 + i];
+            out->field_sizes[i] = static_cast<uint8_t>((std::min)(field.Size, ULONG{255}));
+            const size_t n = (std::min)(static_cast<size_t>(field.Size), PclStatsRawEvent::kPayloadBytes - offset);
+            std::memcpy(out->payload + offset, reinterpret_cast<const void*>(static_cast<uintptr_t>(field.Ptr)), n);
+            offset += n;
+        }
+    } __except (EXCEPTION_EXECUTE_HANDLER) {
+        return false;
+    }
+    return true;
+}
+
 static bool IsDcNamedSession(const wchar_t* name) {
     if (name == nullptr || name[0] == L'\0') {
         return false;
@@ -135,6 +178,22 @@ static void CleanupOtherDcEtwSessionsOnStartup() {
     LogInfo("[PCLStats ETW] startup cleanup done: removed %u stale DC_ session(s)", removed);
 }
 
+static bool IsForeignPclStatsHandle(REGHANDLE handle) {
+    if (handle == REGHANDLE(0)) return false;
+    for (const auto& h : g_pclstats_foreign_reg_handles) {
+        if (h.load(std::memory_order_relaxed) == handle) return true;
+    }
+    return false;
+}
+
+static void AddForeignPclStatsHandle(REGHANDLE handle) {
+    g_pclstats_foreign_reg_handle.store(handle, std::memory_order_release);
+    const size_t slot = g_pclstats_foreign_reg_count.fetch_add(1, std::memory_order_acq_rel);
+    if (slot < kMaxForeignRegistrations) {
+        g_pclstats_foreign_reg_handles[slot].store(handle, std::memory_order_release);
+    }
+}
+
 ULONG WINAPI EventRegister_Detour(LPCGUID ProviderId, PENABLECALLBACK EnableCallback, PVOID CallbackContext,
                                   PREGHANDLE RegHandle) {
     const ULONG ret = EventRegister_Original(ProviderId, EnableCallback, CallbackContext, RegHandle);
@@ -143,8 +202,10 @@ ULONG WINAPI EventRegister_Detour(LPCGUID ProviderId, PENABLECALLBACK EnableCall
     if (calling_module != nullptr && our_module != nullptr && calling_module == our_module) {
         return ret;
     }
-    if (ret == 0 && RegHandle != nullptr && ProviderId != nullptr && GuidEquals(ProviderId, &kPCLStatsProviderId)) {
-        g_pclstats_foreign_reg_handle.store(*RegHandle, std::memory_order_release);
+    if (ret == 0 && RegHandle != nullptr && ProviderId != nullptr
+        && display_commander::latency::HashProviderGuid(ProviderId) == kPCLStatsProviderIdHash
+        && GuidEquals(ProviderId, &kPCLStatsProviderId)) {
+        AddForeignPclStatsHandle(*RegHandle);
         static bool first_log = true;
         if (first_log) {
             first_log = false;
@@ -164,7 +225,25 @@ ULONG WINAPI EventWriteTransfer_Detour(REGHANDLE RegHandle, PCEVENT_DESCRIPTOR E
                                            UserData);
     }
 
-    if (UserData != nullptr && UserDataCount > 0) {
+    g_pclstats_etw_forwarded.fetch_add(1, std::memory_order_relaxed);
+    if (IsForeignPclStatsHandle(RegHandle)) {
+        // Fast path: raw copy only, decoding happens on the continuous monitoring thread
+        g_pclstats_etw_matched.fetch_add(1, std::memory_order_relaxed);
+        const auto thread_id = static_cast<uint32_t>(GetCurrentThreadId());
+        display_commander::latency::PclStatsRawEvent* slot = g_pclstats_event_queue.BeginPush(thread_id);
+        if (slot != nullptr) {
+            slot->time_ns = static_cast<int64_t>(utils::get_now_ns());
+            slot->thread_id = thread_id;
+            if (CopyPclStatsRawEvent(UserDataCount, UserData, slot)) {
+                g_pclstats_event_queue.CommitPush();
+            } else {
+                g_pclstats_event_queue.AbortPush();
+                g_pclstats_etw_copy_failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    } else if (!g_pclstats_foreign_pclstatsinit_seen.load(std::memory_order_relaxed) && UserData != nullptr
+               && UserDataCount > 0) {
+        // Provider registered before our hooks: its handle is unknown until its PCLStatsInit shows up
         for (ULONG i = 0; i < UserDataCount; ++i) {
             const EVENT_DATA_DESCRIPTOR* d = &UserData[i];
             if (d->Size == 0 || d->Size > 0x10000) continue;
@@ -172,6 +251,7 @@ ULONG WINAPI EventWriteTransfer_Detour(REGHANDLE RegHandle, PCEVENT_DESCRIPTOR E
             __try {
                 if (BlobContainsPclStatsInit(ptr, d->Size)) {
                     g_pclstats_foreign_pclstatsinit_seen.store(true, std::memory_order_release);
+                    AddForeignPclStatsHandle(RegHandle);  // Its markers take the fast path from now on
                     static bool first_init_log = true;
                     if (first_init_log) {
                         first_init_log = false;
@@ -188,7 +268,6 @@ ULONG WINAPI EventWriteTransfer_Detour(REGHANDLE RegHandle, PCEVENT_DESCRIPTOR E
     (void)EventDescriptor;
     (void)ActivityId;
     (void)RelatedActivityId;
-    (void)RegHandle;
 
     return EventWriteTransfer_Original(RegHandle, EventDescriptor, ActivityId, RelatedActivityId, UserDataCount,
                                        UserData);
@@ -248,6 +327,10 @@ void UninstallPCLStatsEtwHooks() {
         EventRegister_Original = nullptr;
     }
     g_pclstats_foreign_reg_handle.store(REGHANDLE(0), std::memory_order_relaxed);
+    for (auto& h : g_pclstats_foreign_reg_handles) {
+        h.store(REGHANDLE(0), std::memory_order_relaxed);
+    }
+    g_pclstats_foreign_reg_count.store(0, std::memory_order_relaxed);
     g_pclstats_foreign_pclstatsinit_seen.store(false, std::memory_order_relaxed);
     g_dc_cleanup_removed_count.store(0, std::memory_order_relaxed);
     g_dc_cleanup_status.store(ERROR_GEN_FAILURE, std::memory_order_relaxed);
@@ -270,3 +353,46 @@ const char* GetPCLStatsOwnedEtwSessionName() { return g_owned_dc_session_name_ut
 ULONG GetPCLStatsDcEtwCleanupRemovedCount() { return g_dc_cleanup_removed_count.load(std::memory_order_acquire); }
 
 ULONG GetPCLStatsDcEtwCleanupStatus() { return g_dc_cleanup_status.load(std::memory_order_acquire); }
+
+size_t DrainPclStatsEtwEvents() {
+    using namespace display_commander::latency;
+    LatencyMarkerBus& bus = GetLatencyMarkerBus();
+    return g_pclstats_event_queue.Drain([&bus](const PclStatsRawEvent& raw) {
+        uint32_t marker = 0;
+        uint64_t frame_id = 0;
+        switch (DecodePclStatsRawEvent(raw, &marker, &frame_id)) {
+            case PclStatsEventKind::kMarker: {
+                g_pclstats_etw_decoded_markers.fetch_add(1, std::memory_order_relaxed);
+                LatencyMarkerEvent event;
+                event.source = LatencyMarkerSource::kPclStatsEtw;
+                event.raw_marker = marker;
+                event.frame_id = frame_id;
+                event.time_ns = raw.time_ns;
+                bus.Publish(event);
+                break;
+            }
+            case PclStatsEventKind::kInit:
+                if (!g_pclstats_foreign_pclstatsinit_seen.exchange(true, std::memory_order_acq_rel)) {
+                    LogInfo("[PCLStats ETW] observed foreign PCLStatsInit (queued EventWriteTransfer)");
+                }
+                break;
+            default: g_pclstats_etw_decoded_other.fetch_add(1, std::memory_order_relaxed); break;
+        }
+    });
+}
+
+PclStatsEtwInterceptStats GetPclStatsEtwInterceptStats() {
+    const display_commander::latency::PclStatsEventQueueStats queue = g_pclstats_event_queue.GetStats();
+    PclStatsEtwInterceptStats stats;
+    stats.forwarded = g_pclstats_etw_forwarded.load(std::memory_order_relaxed);
+    stats.matched = g_pclstats_etw_matched.load(std::memory_order_relaxed);
+    stats.queued = queue.queued;
+    stats.dropped = queue.dropped + g_pclstats_etw_copy_failed.load(std::memory_order_relaxed);
+    stats.decoded_markers = g_pclstats_etw_decoded_markers.load(std::memory_order_relaxed);
+    stats.decoded_other = g_pclstats_etw_decoded_other.load(std::memory_order_relaxed);
+    stats.pending = queue.queued - queue.drained;
+    stats.producer_threads = queue.producer_threads;
+    stats.foreign_registrations =
+        static_cast<uint32_t>(g_pclstats_foreign_reg_count.load(std::memory_order_relaxed));
+    return stats;
+}
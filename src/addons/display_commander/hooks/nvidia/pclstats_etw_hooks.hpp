@@ -1,5 +1,9 @@
 #pragma once
 
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+
 // Libraries <Windows.h> — before other Windows headers
 #include <Windows.h>
 
@@ -24,3 +28,21 @@ ULONG GetPCLStatsDcEtwCleanupRemovedCount();
 
 /** Last startup cleanup status (Win32). */
 ULONG GetPCLStatsDcEtwCleanupStatus();
+
+/** EventWriteTransfer interception counters (foreign writes only). */
+struct PclStatsEtwInterceptStats {
+    uint64_t forwarded = 0;        // Writes passed on to EventWriteTransfer
+    uint64_t matched = 0;          // Writes on a foreign PCLStats registration
+    uint64_t queued = 0;           // Matched writes copied into the per-thread rings
+    uint64_t dropped = 0;          // Matched writes lost (ring full or unreadable descriptors)
+    uint64_t decoded_markers = 0;  // PCLStatsEvent markers published to the latency marker bus
+    uint64_t decoded_other = 0;    // Other PCLStats events (flags, ping, unknown)
+    uint64_t pending = 0;          // Queued, not yet drained
+    uint32_t producer_threads = 0;
+    uint32_t foreign_registrations = 0;
+};
+
+/** Decodes queued PCLStats writes and publishes their markers. Continuous monitoring thread only. */
+size_t DrainPclStatsEtwEvents();
+
+PclStatsEtwInterceptStats GetPclStatsEtwInterceptStats();
@@ -1,5 +1,6 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #include "display_settings_hooks.hpp"
+#include "../../feature/hitch/hitch.hpp"
 #include "../../globals.hpp"
 #include "../../settings/advanced_tab_settings.hpp"
 #include "../../utils.hpp"
@@ -44,7 +45,11 @@ LONG WINAPI ChangeDisplaySettingsA_Detour(DEVMODEA* lpDevMode, DWORD dwFlags) {
         return DISP_CHANGE_SUCCESSFUL;  // Return success without changing display mode
     }
 
-    return ChangeDisplaySettingsA_Original(lpDevMode, dwFlags);
+    const LONGLONG start_ns = utils::get_now_ns();
+    const LONG result = ChangeDisplaySettingsA_Original(lpDevMode, dwFlags);
+    display_commander::feature::hitch::RecordHitchDisplayModeChange(start_ns, utils::get_now_ns(),
+                                                                    "ChangeDisplaySettingsA");
+    return result;
 }
 
 LONG WINAPI ChangeDisplaySettingsW_Detour(DEVMODEW* lpDevMode, DWORD dwFlags) {
@@ -56,7 +61,11 @@ LONG WINAPI ChangeDisplaySettingsW_Detour(DEVMODEW* lpDevMode, DWORD dwFlags) {
         return DISP_CHANGE_SUCCESSFUL;  // Return success without changing display mode
     }
 
-    return ChangeDisplaySettingsW_Original(lpDevMode, dwFlags);
+    const LONGLONG start_ns = utils::get_now_ns();
+    const LONG result = ChangeDisplaySettingsW_Original(lpDevMode, dwFlags);
+    display_commander::feature::hitch::RecordHitchDisplayModeChange(start_ns, utils::get_now_ns(),
+                                                                    "ChangeDisplaySettingsW");
+    return result;
 }
 
 LONG WINAPI ChangeDisplaySettingsExA_Detour(LPCSTR lpszDeviceName, DEVMODEA* lpDevMode, HWND hWnd, DWORD dwFlags,
@@ -69,7 +78,11 @@ LONG WINAPI ChangeDisplaySettingsExA_Detour(LPCSTR lpszDeviceName, DEVMODEA* lpD
         return DISP_CHANGE_SUCCESSFUL;  // Return success without changing display mode
     }
 
-    return ChangeDisplaySettingsExA_Original(lpszDeviceName, lpDevMode, hWnd, dwFlags, lParam);
+    const LONGLONG start_ns = utils::get_now_ns();
+    const LONG result = ChangeDisplaySettingsExA_Original(lpszDeviceName, lpDevMode, hWnd, dwFlags, lParam);
+    display_commander::feature::hitch::RecordHitchDisplayModeChange(start_ns, utils::get_now_ns(),
+                                                                    "ChangeDisplaySettingsExA");
+    return result;
 }
 
 LONG WINAPI ChangeDisplaySettingsExW_Detour(LPCWSTR lpszDeviceName, DEVMODEW* lpDevMode, HWND hWnd, DWORD dwFlags,
@@ -82,7 +95,11 @@ LONG WINAPI ChangeDisplaySettingsExW_Detour(LPCWSTR lpszDeviceName, DEVMODEW* lp
         return DISP_CHANGE_SUCCESSFUL;  // Return success without changing display mode
     }
 
-    return ChangeDisplaySettingsExW_Original(lpszDeviceName, lpDevMode, hWnd, dwFlags, lParam);
+    const LONGLONG start_ns = utils::get_now_ns();
+    const LONG result = ChangeDisplaySettingsExW_Original(lpszDeviceName, lpDevMode, hWnd, dwFlags, lParam);
+    display_commander::feature::hitch::RecordHitchDisplayModeChange(start_ns, utils::get_now_ns(),
+                                                                    "ChangeDisplaySettingsExW");
+    return result;
 }
 
 // SetWindowPos_Detour function moved to api_hooks.cpp to avoid duplicate hook creation
@@ -1,5 +1,6 @@
 #include "nvlowlatencyvk_hooks.hpp"
 #include "../../globals.hpp"
+#include "../../latency/latency_markers.hpp"
 #include "../../settings/advanced_tab_settings.hpp"
 #include "../../settings/main_tab_settings.hpp"
 #include "../../swapchain_events.hpp"
@@ -120,6 +121,8 @@ static NvLL_VK_Status NvLL_VK_SetLatencyMarker_Detour(void* device, NVLL_VK_LATE
     }
     g_nvll_last_marker_type.store(marker_type);
     g_nvll_last_frame_id.store(params->frameID);
+    display_commander::latency::PublishLatencyMarker(display_commander::latency::LatencyMarkerSource::kNvLowLatencyVk,
+                                                     static_cast<uint32_t>(marker_type), params->frameID);
 
     // Re-apply SleepMode on SIMULATION_START (same idea as D3D ApplySleepMode on present): either our
     // overridden params or the last params the game tried to set.
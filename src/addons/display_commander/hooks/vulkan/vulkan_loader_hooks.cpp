@@ -1,6 +1,7 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #include "vulkan_loader_hooks.hpp"
 #include "../../globals.hpp"
+#include "../../latency/latency_markers.hpp"
 #include "../../settings/main_tab_settings.hpp"
 #include "../../swapchain_events.hpp"
 #include "../../utils/detour_call_tracker.hpp"
@@ -289,6 +290,9 @@ void VKAPI_CALL vkSetLatencyMarkerNV_Detour(VkDevice device, VkSwapchainKHR swap
     if (pLatencyMarkerInfo != nullptr) {
         g_loader_last_marker_type.store(static_cast<int>(pLatencyMarkerInfo->marker));
         g_loader_last_present_id.store(pLatencyMarkerInfo->presentID);
+        display_commander::latency::PublishLatencyMarker(display_commander::latency::LatencyMarkerSource::kVulkanNv,
+                                                         static_cast<uint32_t>(pLatencyMarkerInfo->marker),
+                                                         pLatencyMarkerInfo->presentID);
     }
     if (g_real_vkSetLatencyMarkerNV != nullptr) {
         g_real_vkSetLatencyMarkerNV(device, swapchain, pLatencyMarkerInfo);
@@ -0,0 +1,157 @@
+// Source Code <Display Commander> // Event-driven key state core (platform-neutral, no Windows includes)
+#include "keyboard_state_tracker.hpp"
+
+namespace display_commanderhooks::keyboard_tracker {
+
+KeyStateTracker::KeyStateTracker() {
+    for (uint32_t i = 0; i < kQueueCapacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool KeyStateTracker::SetKeyState(int vk, bool down, KeyEdgeSource source, int64_t time_ns) {
+    if (!ValidKey(vk)) {
+        return false;
+    }
+    const uint64_t bit = 1ull << (vk & 63);
+    std::atomic<uint64_t>& word = down_[static_cast<size_t>(vk) >> 6];
+    const uint64_t previous = down ? word.fetch_or(bit, std::memory_order_acq_rel)
+                                   : word.fetch_and(~bit, std::memory_order_acq_rel);
+    if (((previous & bit) != 0) == down) {
+        return false;
+    }
+    edge_counts_[static_cast<size_t>(source)].fetch_add(1, std::memory_order_relaxed);
+    KeyEdge edge;
+    edge.time_ns = time_ns;
+    edge.vk = static_cast<uint8_t>(vk);
+    edge.down = down;
+    edge.source = source;
+    if (!Enqueue(edge)) {
+        queue_overflows_.fetch_add(1, std::memory_order_relaxed);
+        if (down) {
+            overflow_pressed_[static_cast<size_t>(vk) >> 6].fetch_or(bit, std::memory_order_release);
+        }
+    }
+    return true;
+}
+
+bool KeyStateTracker::IsDown(int vk) const {
+    if (!ValidKey(vk)) {
+        return false;
+    }
+    return (down_[static_cast<size_t>(vk) >> 6].load(std::memory_order_acquire) & (1ull << (vk & 63))) != 0;
+}
+
+// Bounded MPSC queue (per-cell sequence numbers): producers claim a position with CAS, the single consumer
+// releases cells by advancing their sequence by the capacity.
+bool KeyStateTracker::Enqueue(const KeyEdge& edge) {
+    uint32_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells_[pos & (kQueueCapacity - 1)];
+        const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.edge = edge;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t KeyStateTracker::DrainEdges() {
+    size_t drained = 0;
+    for (;;) {
+        Cell& cell = cells_[dequeue_pos_ & (kQueueCapacity - 1)];
+        const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(sequence - (dequeue_pos_ + 1)) < 0) {
+            break;  // Empty (or the next cell is still being written)
+        }
+        const KeyEdge edge = cell.edge;
+        cell.sequence.store(dequeue_pos_ + kQueueCapacity, std::memory_order_release);
+        ++dequeue_pos_;
+        ApplyEdge(edge);
+        ++drained;
+    }
+    for (size_t i = 0; i < overflow_pressed_.size(); ++i) {
+        pressed_[i] |= overflow_pressed_[i].exchange(0, std::memory_order_acquire);
+        // Resync the replay (edges lost to overflow, or published but not yet queued)
+        replayed_down_[i] = down_[i].load(std::memory_order_acquire);
+    }
+    return drained;
+}
+
+void KeyStateTracker::ApplyEdge(const KeyEdge& edge) {
+    const uint64_t bit = 1ull << (edge.vk & 63);
+    if (!edge.down) {
+        replayed_down_[edge.vk >> 6] &= ~bit;
+        return;
+    }
+    replayed_down_[edge.vk >> 6] |= bit;
+    pressed_[edge.vk >> 6] |= bit;
+    if (press_count_ < kMaxFramePresses) {
+        KeyPress& press = presses_[press_count_++];
+        press.time_ns = edge.time_ns;
+        press.vk = edge.vk;
+        press.source = edge.source;
+        press.held = replayed_down_;
+    }
+    // A reconciliation poll only bounds when the key went down; keep it out of the response time
+    press_time_ns_[edge.vk] = edge.source == KeyEdgeSource::kPoll ? 0 : edge.time_ns;
+}
+
+bool KeyStateTracker::Reconcile(int vk, bool polled_down, int64_t time_ns) {
+    if (!ValidKey(vk) || IsDown(vk) == polled_down) {
+        return false;
+    }
+    // Polled edges go through the queue too so they stay ordered with concurrent message edges
+    return SetKeyState(vk, polled_down, KeyEdgeSource::kPoll, time_ns);
+}
+
+bool KeyStateTracker::IsPressed(int vk) const {
+    if (!ValidKey(vk)) {
+        return false;
+    }
+    return (pressed_[static_cast<size_t>(vk) >> 6] & (1ull << (vk & 63))) != 0;
+}
+
+void KeyStateTracker::ResetFrame() {
+    pressed_ = {};
+    press_count_ = 0;
+}
+
+void KeyStateTracker::ReportHotkeyHandled(int vk, int64_t now_ns) {
+    if (!ValidKey(vk) || press_time_ns_[vk] <= 0) {
+        return;
+    }
+    const int64_t response_ns = now_ns > press_time_ns_[vk] ? now_ns - press_time_ns_[vk] : 0;
+    press_time_ns_[vk] = 0;
+    hotkey_responses_.fetch_add(1, std::memory_order_relaxed);
+    last_response_ns_.store(response_ns, std::memory_order_relaxed);
+    total_response_ns_.fetch_add(response_ns, std::memory_order_relaxed);
+    if (response_ns > max_response_ns_.load(std::memory_order_relaxed)) {
+        max_response_ns_.store(response_ns, std::memory_order_relaxed);
+    }
+}
+
+KeyboardTrackerStats KeyStateTracker::GetStats() const {
+    KeyboardTrackerStats s;
+    for (size_t i = 0; i < kKeyEdgeSourceCount; ++i) {
+        s.edges[i] = edge_counts_[i].load(std::memory_order_relaxed);
+    }
+    s.queue_overflows = queue_overflows_.load(std::memory_order_relaxed);
+    s.hotkey_responses = hotkey_responses_.load(std::memory_order_relaxed);
+    s.last_response_ns = last_response_ns_.load(std::memory_order_relaxed);
+    s.max_response_ns = max_response_ns_.load(std::memory_order_relaxed);
+    s.avg_response_ns = s.hotkey_responses > 0 ? total_response_ns_.load(std::memory_order_relaxed)
+                                                     / static_cast<int64_t>(s.hotkey_responses)
+                                               : 0;
+    return s;
+}
+
+}  // namespace display_commanderhooks::keyboard_tracker
@@ -0,0 +1,150 @@
+// Source Code <Display Commander> // Event-driven key state core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace display_commanderhooks::keyboard_tracker {
+
+enum class KeyEdgeSource : uint8_t { kMessage = 0, kRawInput, kPoll, kCount };
+constexpr size_t kKeyEdgeSourceCount = static_cast<size_t>(KeyEdgeSource::kCount);
+
+struct KeyEdge {
+    int64_t time_ns = 0;
+    uint8_t vk = 0;
+    bool down = false;
+    KeyEdgeSource source = KeyEdgeSource::kMessage;
+};
+
+// Down edge in queue order, with the keys that were down at that point (replayed from the edge stream).
+struct KeyPress {
+    int64_t time_ns = 0;
+    uint8_t vk = 0;
+    KeyEdgeSource source = KeyEdgeSource::kMessage;
+    std::array<uint64_t, 4> held = {};  // Includes vk
+};
+
+struct KeyboardTrackerStats {
+    std::array<uint64_t, kKeyEdgeSourceCount> edges = {};  // Transitions by source (kPoll = reconciliation fixes)
+    uint64_t queue_overflows = 0;                          // Edges dropped because the queue was full
+    uint64_t hotkey_responses = 0;
+    int64_t last_response_ns = 0;  // Key-down edge -> hotkey action
+    int64_t avg_response_ns = 0;
+    int64_t max_response_ns = 0;
+};
+
+// Virtual-key state fed by input events instead of polling.
+//
+// Producers (message hooks, raw input; any thread) call SetKeyState. The 256-bit down bitmap is updated immediately
+// and, when the bit actually changed, the edge is pushed to a bounded lock-free MPSC queue; repeated reports of the
+// same state (a message seen by both GetMessage and the window proc, auto-repeat) produce no edge.
+//
+// The consumer (continuous monitoring, hotkey processing) calls DrainEdges once per pass: down edges set the
+// "pressed since last ResetFrame" bit, so a tap shorter than a pass is still seen, and are also kept in order (with the
+// held keys at that moment) for matchers that need sequences and chords. Reconcile compares the bitmap with
+// a polled state and applies the difference as a kPoll edge, for transitions the hooks never saw (focus loss,
+// input filtered before our hooks).
+class KeyStateTracker {
+   public:
+    static constexpr size_t kKeyCount = 256;
+    static constexpr uint32_t kQueueCapacity = 256;  // Power of two
+    static constexpr size_t kMaxFramePresses = 64;    // Further presses in one pass only set the pressed bit
+
+    KeyStateTracker();
+
+    // Any thread. Returns true if the key changed state (edge queued, or counted as overflow).
+    bool SetKeyState(int vk, bool down, KeyEdgeSource source, int64_t time_ns);
+
+    // Any thread.
+    bool IsDown(int vk) const;
+
+    // Consumer thread: applies queued edges (pressed bits, press times). Returns the number of edges drained.
+    size_t DrainEdges();
+
+    // Consumer thread: fixes the bitmap from a polled state; the resulting edge is applied right away.
+    bool Reconcile(int vk, bool polled_down, int64_t time_ns);
+
+    // Consumer thread.
+    bool IsPressed(int vk) const;
+    // Down edges drained since the last ResetFrame, oldest first.
+    std::span<const KeyPress> GetPresses() const { return {presses_.data(), press_count_}; }
+    void ResetFrame();
+
+    // Consumer thread: a hotkey triggered by vk ran its action; records the key-down -> action time once per press.
+    void ReportHotkeyHandled(int vk, int64_t now_ns);
+
+    // Any thread (counters are relaxed atomics; response times are written by the consumer only).
+    KeyboardTrackerStats GetStats() const;
+
+   private:
+    struct Cell {
+        std::atomic<uint32_t> sequence{0};
+        KeyEdge edge;
+    };
+
+    static bool ValidKey(int vk) { return vk >= 0 && vk < static_cast<int>(kKeyCount); }
+    bool Enqueue(const KeyEdge& edge);
+    void ApplyEdge(const KeyEdge& edge);
+
+    std::array<std::atomic<uint64_t>, kKeyCount / 64> down_ = {};
+
+    std::array<Cell, kQueueCapacity> cells_;
+    // Down edges that did not fit into the queue; merged into pressed_ by DrainEdges
+    std::array<std::atomic<uint64_t>, kKeyCount / 64> overflow_pressed_ = {};
+    std::atomic<uint32_t> enqueue_pos_{0};
+    uint32_t dequeue_pos_ = 0;  // Consumer only
+
+    // Consumer only
+    std::array<uint64_t, kKeyCount / 64> pressed_ = {};
+    std::array<int64_t, kKeyCount> press_time_ns_ = {};  // 0 once the press was reported by ReportHotkeyHandled
+    std::array<uint64_t, kKeyCount / 64> replayed_down_ = {};  // down_ as of the edge being applied
+    std::array<KeyPress, kMaxFramePresses> presses_ = {};
+    size_t press_count_ = 0;
+
+    std::array<std::atomic<uint64_t>, kKeyEdgeSourceCount> edge_counts_ = {};
+    std::atomic<uint64_t> queue_overflows_{0};
+    std::atomic<uint64_t> hotkey_responses_{0};
+    std::atomic<int64_t> last_response_ns_{0};
+    std::atomic<int64_t> total_response_ns_{0};
+    std::atomic<int64_t> max_response_ns_{0};
+};
+
+// When the consumer polls the real key state (Reconcile) on top of the event stream.
+//
+// Before any key event reached the hooks, and while the game is in background (its window gets no key messages,
+// only polling sees keys), every pass polls. Otherwise events carry the state and a reconcile every
+// kReconcileIntervalNs (or on request, e.g. focus loss) only catches transitions the hooks never saw.
+class ReconcileSchedule {
+   public:
+    static constexpr int64_t kReconcileIntervalNs = 250'000'000;
+
+    // Any thread: a key event changed the tracked state.
+    void OnEventTraffic() { event_traffic_seen_.store(true, std::memory_order_relaxed); }
+
+    // Any thread.
+    bool PollEveryPass(bool in_background) const {
+        return in_background || !event_traffic_seen_.load(std::memory_order_relaxed);
+    }
+    int64_t UpdateIntervalNs(int64_t poll_interval_ns, bool in_background) const {
+        return PollEveryPass(in_background) ? poll_interval_ns : kReconcileIntervalNs;
+    }
+
+    // Consumer thread: true if this pass polls; records the poll time.
+    bool ShouldReconcile(int64_t now_ns, bool in_background, bool requested) {
+        if (!PollEveryPass(in_background) && !requested && now_ns - last_reconcile_ns_ < kReconcileIntervalNs) {
+            return false;
+        }
+        last_reconcile_ns_ = now_ns;
+        return true;
+    }
+
+   private:
+    std::atomic<bool> event_traffic_seen_{false};
+    int64_t last_reconcile_ns_ = 0;  // Consumer only
+};
+
+}  // namespace display_commanderhooks::keyboard_tracker
@@ -0,0 +1,73 @@
+// Source Code <Display Commander> // Message suppression filter core (platform-neutral, no Windows includes)
+#include "message_suppression_filter.hpp"
+
+namespace display_commanderhooks {
+
+// Message ids from winuser.h
+MessageClass ClassifyMessage(uint32_t msg) {
+    switch (msg) {
+        case 0x0100:                                     // WM_KEYDOWN
+        case 0x0104: return MessageClass::kKeyDown;      // WM_SYSKEYDOWN
+        case 0x0102:                                     // WM_CHAR
+        case 0x0103:                                     // WM_DEADCHAR
+        case 0x0106:                                     // WM_SYSCHAR
+        case 0x0107: return MessageClass::kChar;         // WM_SYSDEADCHAR
+        case 0x0201:                                     // WM_LBUTTONDOWN
+        case 0x0204:                                     // WM_RBUTTONDOWN
+        case 0x0207:                                     // WM_MBUTTONDOWN
+        case 0x020B: return MessageClass::kMouseButton;  // WM_XBUTTONDOWN
+        case 0x0200: return MessageClass::kMouseMove;    // WM_MOUSEMOVE
+        case 0x020A:                                     // WM_MOUSEWHEEL
+        case 0x020E: return MessageClass::kMouseWheel;   // WM_MOUSEHWHEEL
+        case 0x0020: return MessageClass::kCursor;       // WM_SETCURSOR
+        default:     return MessageClass::kOther;
+    }
+}
+
+const char* MessageClassName(MessageClass c) {
+    switch (c) {
+        case MessageClass::kOther:       return "Other";
+        case MessageClass::kKeyDown:     return "Key down";
+        case MessageClass::kChar:        return "Char";
+        case MessageClass::kMouseButton: return "Mouse button";
+        case MessageClass::kMouseMove:   return "Mouse move";
+        case MessageClass::kMouseWheel:  return "Mouse wheel";
+        case MessageClass::kCursor:      return "Set cursor";
+        default:                         return "Unknown";
+    }
+}
+
+bool MessageSuppressionFilter::SetBlockedClasses(uint32_t blocked_classes) {
+    // kOther is never suppressed
+    blocked_classes &= ~MessageClassBit(MessageClass::kOther);
+    std::lock_guard<std::mutex> lock(rebuild_mutex_);
+    if (blocked_classes_.load(std::memory_order_relaxed) == blocked_classes) {
+        return false;
+    }
+    blocked_classes_.store(blocked_classes, std::memory_order_relaxed);
+    std::array<uint64_t, kMessageCount / 64> words = {};
+    for (uint32_t msg = 0; msg < kMessageCount; ++msg) {
+        if ((blocked_classes & MessageClassBit(ClassifyMessage(msg))) != 0) {
+            words[msg >> 6] |= 1ull << (msg & 63);
+        }
+    }
+    for (size_t i = 0; i < words.size(); ++i) {
+        if (bits_[i].load(std::memory_order_relaxed) != words[i]) {
+            bits_[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+    rebuilds_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+MessageSuppressionStats MessageSuppressionFilter::GetStats() const {
+    MessageSuppressionStats s;
+    s.blocked_classes = blocked_classes_.load(std::memory_order_relaxed);
+    s.rebuilds = rebuilds_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kMessageClassCount; ++i) {
+        s.suppressed[i] = suppressed_[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+}  // namespace display_commanderhooks
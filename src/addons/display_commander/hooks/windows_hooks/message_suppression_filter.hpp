@@ -0,0 +1,77 @@
+// Source Code <Display Commander> // Message suppression filter core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace display_commanderhooks {
+
+// Messages input blocking can eat, grouped by what the counters report.
+enum class MessageClass : uint8_t {
+    kOther = 0,    // Never suppressed
+    kKeyDown,      // WM_KEYDOWN, WM_SYSKEYDOWN
+    kChar,         // WM_CHAR, WM_SYSCHAR, WM_DEADCHAR, WM_SYSDEADCHAR
+    kMouseButton,  // WM_[LRMX]BUTTONDOWN (ups always pass, so nothing stays stuck)
+    kMouseMove,    // WM_MOUSEMOVE
+    kMouseWheel,   // WM_MOUSEWHEEL, WM_MOUSEHWHEEL
+    kCursor,       // WM_SETCURSOR
+    kCount
+};
+constexpr size_t kMessageClassCount = static_cast<size_t>(MessageClass::kCount);
+
+constexpr uint32_t MessageClassBit(MessageClass c) { return 1u << static_cast<uint32_t>(c); }
+constexpr uint32_t kKeyboardMessageClasses =
+    MessageClassBit(MessageClass::kKeyDown) | MessageClassBit(MessageClass::kChar);
+constexpr uint32_t kMouseMessageClasses = MessageClassBit(MessageClass::kMouseButton)
+                                          | MessageClassBit(MessageClass::kMouseMove)
+                                          | MessageClassBit(MessageClass::kMouseWheel)
+                                          | MessageClassBit(MessageClass::kCursor);
+
+MessageClass ClassifyMessage(uint32_t msg);
+const char* MessageClassName(MessageClass c);
+
+struct MessageSuppressionStats {
+    uint32_t blocked_classes = 0;                              // MessageClassBit mask
+    std::array<uint64_t, kMessageClassCount> suppressed = {};  // Per class
+    uint64_t rebuilds = 0;
+};
+
+// One bit per message id (0..0xFFFF, covers registered messages): the message pump detours test a single bit instead
+// of re-evaluating the blocking settings for every message. Rebuilt with SetBlockedClasses when the inputs change;
+// words are replaced one by one, so a reader racing a rebuild sees the old or the new decision per message.
+class MessageSuppressionFilter {
+   public:
+    static constexpr uint32_t kMessageCount = 0x10000;
+
+    // Any thread.
+    bool IsBlocked(uint32_t msg) const {
+        return msg < kMessageCount
+               && ((bits_[msg >> 6].load(std::memory_order_relaxed) >> (msg & 63)) & 1ull) != 0;
+    }
+
+    // Any thread: rebuilds the bitmap for a MessageClassBit mask; no-op (returns false) if the mask is unchanged.
+    // Rebuilds are serialized, so the bitmap always ends up matching the last mask set.
+    bool SetBlockedClasses(uint32_t blocked_classes);
+
+    // A message was suppressed (after IsBlocked and the target window check). Plain load + store instead of a locked
+    // increment: messages are pumped by one thread in practice, and a lost count under contention is acceptable.
+    void CountSuppressed(uint32_t msg) {
+        std::atomic<uint64_t>& counter = suppressed_[static_cast<size_t>(ClassifyMessage(msg))];
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    MessageSuppressionStats GetStats() const;
+
+   private:
+    std::array<std::atomic<uint64_t>, kMessageCount / 64> bits_ = {};
+    std::atomic<uint32_t> blocked_classes_{0};
+    std::mutex rebuild_mutex_;  // Writers only; IsBlocked stays lock-free
+    std::atomic<uint64_t> rebuilds_{0};
+    std::array<std::atomic<uint64_t>, kMessageClassCount> suppressed_ = {};
+};
+
+}  // namespace display_commanderhooks
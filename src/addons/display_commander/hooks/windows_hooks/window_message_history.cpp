@@ -0,0 +1,160 @@
+// Source Code <Display Commander> // Window message history ring (platform-neutral, no Windows includes)
+#include "window_message_history.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace display_commanderhooks {
+
+namespace {
+
+size_t RoundDepth(size_t depth, size_t capacity) {
+    size_t rounded = WindowMessageHistory::kMinDepth;
+    while (rounded < depth && rounded < capacity) {
+        rounded <<= 1;
+    }
+    return (std::min)(rounded, capacity);
+}
+
+}  // namespace
+
+const char* MessageSuppressionName(MessageSuppression s) {
+    switch (s) {
+        case MessageSuppression::kNone:          return "";
+        case MessageSuppression::kWindowProc:    return "window proc";
+        case MessageSuppression::kInputBlocking: return "input blocking";
+        default:                                 return "unknown";
+    }
+}
+
+WindowMessageHistory::WindowMessageHistory(size_t max_depth, size_t depth)
+    : capacity_(RoundDepth(max_depth, kMaxDepth)), slots_(std::make_unique<Slot[]>(capacity_)) {
+    layout_.store(RoundDepth(depth, capacity_) - 1, std::memory_order_relaxed);
+}
+
+uint64_t WindowMessageHistory::Record(uintptr_t hwnd, uint32_t message_id, uintptr_t wparam, intptr_t lparam,
+                                      uint32_t thread_id, int64_t time_ns) {
+    const RecordClaim claim = BeginRecord();
+    if (claim.slot != kNoSlot) {
+        CommitRecord(claim, hwnd, message_id, wparam, lparam, thread_id, time_ns);
+    }
+    return claim.sequence;
+}
+
+WindowMessageHistory::RecordClaim WindowMessageHistory::BeginRecord() {
+    RecordClaim claim;
+    const uint64_t layout = layout_.load(std::memory_order_acquire);
+    claim.sequence = next_sequence_.fetch_add(1, std::memory_order_seq_cst);
+    const size_t index = static_cast<size_t>(claim.sequence & LayoutMask(layout));
+    Slot& slot = slots_[index];
+    uint64_t stamp = slot.stamp.load(std::memory_order_relaxed);
+    // One attempt only (wait-free): a writer still in this slot a full ring ago wins
+    if (stamp == kBusy || !slot.stamp.compare_exchange_strong(stamp, kBusy, std::memory_order_acquire)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return claim;
+    }
+    // SetDepth ran since the layout was loaded: hand the slot back untouched. If this check passes, SetDepth comes
+    // later in the seq_cst order and its Clear starts after our sequence number.
+    if (layout_.load(std::memory_order_seq_cst) != layout) {
+        slot.stamp.store(stamp, std::memory_order_release);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return claim;
+    }
+    claim.slot = index;
+    return claim;
+}
+
+void WindowMessageHistory::CommitRecord(const RecordClaim& claim, uintptr_t hwnd, uint32_t message_id,
+                                        uintptr_t wparam, intptr_t lparam, uint32_t thread_id, int64_t time_ns) {
+    Slot& slot = slots_[claim.slot];
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.time_ns.store(time_ns, std::memory_order_relaxed);
+    slot.hwnd.store(hwnd, std::memory_order_relaxed);
+    slot.wparam.store(wparam, std::memory_order_relaxed);
+    slot.lparam.store(lparam, std::memory_order_relaxed);
+    slot.message_thread.store(static_cast<uint64_t>(message_id) | (static_cast<uint64_t>(thread_id) << 32),
+                              std::memory_order_relaxed);
+    slot.suppressed.store(0, std::memory_order_relaxed);
+    slot.stamp.store(claim.sequence + 1, std::memory_order_release);
+}
+
+void WindowMessageHistory::SetSuppressed(uint64_t sequence, MessageSuppression reason) {
+    Slot& slot = slots_[sequence & LayoutMask(layout_.load(std::memory_order_relaxed))];
+    if (slot.stamp.load(std::memory_order_acquire) == sequence + 1) {
+        slot.suppressed.store(static_cast<uint8_t>(reason), std::memory_order_relaxed);
+    }
+}
+
+void WindowMessageHistory::SetDepth(size_t depth) {
+    const uint64_t mask = RoundDepth(depth, capacity_) - 1;
+    uint64_t layout = layout_.load(std::memory_order_relaxed);
+    while (!layout_.compare_exchange_weak(layout, (((layout >> kGenerationShift) + 1) << kGenerationShift) | mask,
+                                          std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+    Clear();
+}
+
+void WindowMessageHistory::Clear() {
+    first_visible_.store(next_sequence_.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+}
+
+std::vector<WindowMessageRecord> WindowMessageHistory::Snapshot(size_t max_count) const {
+    const size_t mask = LayoutMask(layout_.load(std::memory_order_relaxed));
+    const uint64_t end = next_sequence_.load(std::memory_order_acquire);
+    const uint64_t first_visible = first_visible_.load(std::memory_order_relaxed);
+    size_t count = mask + 1;
+    if (max_count > 0) {
+        count = (std::min)(count, max_count);
+    }
+    const uint64_t begin = (std::max)(first_visible, end > count ? end - count : 0);
+
+    std::vector<WindowMessageRecord> out;
+    out.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t sequence = end; sequence > begin;) {
+        --sequence;
+        const Slot& slot = slots_[sequence & mask];
+        const uint64_t stamp = slot.stamp.load(std::memory_order_acquire);
+        if (stamp != sequence + 1) {
+            continue;  // Still being written, dropped, or already reused
+        }
+        WindowMessageRecord r;
+        r.sequence = sequence;
+        r.time_ns = slot.time_ns.load(std::memory_order_relaxed);
+        r.hwnd = slot.hwnd.load(std::memory_order_relaxed);
+        r.wparam = slot.wparam.load(std::memory_order_relaxed);
+        r.lparam = slot.lparam.load(std::memory_order_relaxed);
+        const uint64_t message_thread = slot.message_thread.load(std::memory_order_relaxed);
+        r.message_id = static_cast<uint32_t>(message_thread);
+        r.thread_id = static_cast<uint32_t>(message_thread >> 32);
+        r.suppressed = static_cast<MessageSuppression>(slot.suppressed.load(std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.stamp.load(std::memory_order_relaxed) != stamp) {
+            continue;  // Overwritten while copying
+        }
+        out.push_back(r);
+    }
+    return out;
+}
+
+std::string FormatWindowMessagesCsv(const std::vector<WindowMessageRecord>& newest_first, WindowMessageNameFn name) {
+    std::string csv = "sequence,time_ms,thread_id,hwnd,message,message_id,wparam,lparam,suppressed\n";
+    if (newest_first.empty()) {
+        return csv;
+    }
+    const int64_t base_ns = newest_first.back().time_ns;
+    char line[256];
+    for (auto it = newest_first.rbegin(); it != newest_first.rend(); ++it) {
+        const WindowMessageRecord& r = *it;
+        snprintf(line, sizeof(line),
+                 "%" PRIu64 ",%.3f,%" PRIu32 ",0x%" PRIxPTR ",%s,0x%04" PRIX32 ",0x%" PRIxPTR ",0x%" PRIxPTR ",%s\n",
+                 r.sequence, static_cast<double>(r.time_ns - base_ns) / 1e6, r.thread_id, r.hwnd,
+                 name != nullptr ? name(r.message_id) : "", r.message_id, r.wparam, static_cast<uintptr_t>(r.lparam),
+                 MessageSuppressionName(r.suppressed));
+        csv += line;
+    }
+    return csv;
+}
+
+}  // namespace display_commanderhooks
@@ -0,0 +1,113 @@
+// Source Code <Display Commander> // Window message history ring (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace display_commanderhooks {
+
+// Why a recorded message did not reach the game.
+enum class MessageSuppression : uint8_t {
+    kNone = 0,
+    kWindowProc,     // ProcessWindowMessage returned true (continue rendering, activation spoofing, ...)
+    kInputBlocking,  // ShouldSuppressMessage / exclusive key groups in the message pump hooks
+};
+
+const char* MessageSuppressionName(MessageSuppression s);
+
+struct WindowMessageRecord {
+    uint64_t sequence = 0;  // Global order of recording
+    int64_t time_ns = 0;
+    uintptr_t hwnd = 0;
+    uint32_t message_id = 0;
+    uint32_t thread_id = 0;
+    uintptr_t wparam = 0;
+    intptr_t lparam = 0;
+    MessageSuppression suppressed = MessageSuppression::kNone;
+};
+
+// Fixed-capacity ring of recent window messages.
+//
+// Record is wait-free for any number of producer threads: one fetch_add claims a sequence number, one CAS claims the
+// slot (if another writer still holds it after a full wrap, the record is dropped instead of waiting), then the fields
+// are written as relaxed atomics and the slot stamp is published. Snapshot never blocks producers: a slot whose stamp
+// changes while it is copied (seqlock) is skipped.
+//
+// The depth mask and a generation share one atomic. A writer re-checks it after its CAS and drops the record if
+// SetDepth ran in between, so every published record either used the current depth or is hidden by SetDepth's Clear.
+class WindowMessageHistory {
+   public:
+    static constexpr size_t kMinDepth = 16;
+    static constexpr size_t kMaxDepth = size_t{1} << 31;
+    static constexpr size_t kNoSlot = SIZE_MAX;
+
+    // A slot held between BeginRecord and CommitRecord.
+    struct RecordClaim {
+        uint64_t sequence = 0;
+        size_t slot = kNoSlot;  // kNoSlot: dropped (slot still busy, or the depth changed)
+    };
+
+    // Slots for max_depth are allocated up front; depth is the initial depth in use.
+    WindowMessageHistory(size_t max_depth, size_t depth);
+
+    // Any thread. Returns the sequence number of the record (for SetSuppressed).
+    uint64_t Record(uintptr_t hwnd, uint32_t message_id, uintptr_t wparam, intptr_t lparam, uint32_t thread_id,
+                    int64_t time_ns);
+
+    // Record in two steps: BeginRecord takes the sequence number and marks its slot busy (counted as dropped if it
+    // cannot); CommitRecord fills and publishes a claimed slot. Snapshot skips the slot until it is committed.
+    RecordClaim BeginRecord();
+    void CommitRecord(const RecordClaim& claim, uintptr_t hwnd, uint32_t message_id, uintptr_t wparam, intptr_t lparam,
+                      uint32_t thread_id, int64_t time_ns);
+
+    // Any thread: marks an already recorded message; no-op if its slot was reused since.
+    void SetSuppressed(uint64_t sequence, MessageSuppression reason);
+
+    // Depth in use (power of two, kMinDepth..max depth). Changing it clears the history.
+    void SetDepth(size_t depth);
+    size_t GetDepth() const { return LayoutMask(layout_.load(std::memory_order_relaxed)) + 1; }
+    size_t GetMaxDepth() const { return capacity_; }
+
+    void Clear();
+
+    // Newest first, at most max_count records (all in the current depth when 0).
+    std::vector<WindowMessageRecord> Snapshot(size_t max_count = 0) const;
+
+    uint64_t GetRecordedCount() const { return next_sequence_.load(std::memory_order_relaxed); }
+    uint64_t GetDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+   private:
+    static constexpr uint64_t kBusy = UINT64_MAX;
+    static constexpr uint32_t kGenerationShift = 32;  // layout_: depth mask | generation << 32
+
+    static size_t LayoutMask(uint64_t layout) { return static_cast<size_t>(layout & 0xFFFFFFFFull); }
+
+    struct Slot {
+        std::atomic<uint64_t> stamp{0};  // sequence + 1 when published, kBusy while written, 0 never written
+        std::atomic<int64_t> time_ns{0};
+        std::atomic<uintptr_t> hwnd{0};
+        std::atomic<uintptr_t> wparam{0};
+        std::atomic<intptr_t> lparam{0};
+        std::atomic<uint64_t> message_thread{0};  // message_id | thread_id << 32
+        std::atomic<uint8_t> suppressed{0};
+    };
+
+    size_t capacity_ = 0;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> layout_{0};
+    std::atomic<uint64_t> next_sequence_{0};
+    std::atomic<uint64_t> first_visible_{0};  // Records before this sequence were cleared
+    std::atomic<uint64_t> dropped_{0};
+};
+
+using WindowMessageNameFn = const char* (*)(uint32_t message_id);
+
+// CSV export of a snapshot (oldest first, times relative to the oldest record).
+std::string FormatWindowMessagesCsv(const std::vector<WindowMessageRecord>& newest_first, WindowMessageNameFn name);
+
+}  // namespace display_commanderhooks
@@ -10,18 +10,26 @@
 #include "window_proc_hooks.hpp"
 #include <atomic>
 #include <array>
+#include <dbt.h>
 #include <cstdio>
 #include <thread>
 #include <unordered_map>
 #include <vector>
+#include "../../continuous_monitoring.hpp"
+#include "../../display/display_cache.hpp"
 #include "../../exit_handler.hpp"
+#include "../../feature/foreground/foreground.hpp"
+#include "../../feature/hitch/hitch.hpp"
+#include "../../feature/input_latency/input_latency.hpp"
 #include "../../globals.hpp"
+#include "../../modules/controller/xinput_hooks.hpp"
 #include "../../settings/advanced_tab_settings.hpp"
 #include "../../utils/logging.hpp"
 #include "../../utils/srwlock_registry.hpp"
 #include "../../utils/srwlock_wrapper.hpp"
 #include "../../utils/timing.hpp"
 #include "api_hooks.hpp"  // For GetGameWindow
+#include "windows_message_hooks.hpp"
 
 #include "../../latency/reflex_provider.hpp"
 #include "../../../../../external/Streamline/source/plugins/sl.pcl/pclstats.h"
@@ -49,15 +57,21 @@ static std::atomic<uint32_t> g_message_rate_last_logged_threshold{0};
 static std::atomic<uint32_t> g_message_rate_print_remaining{0};
 static std::atomic<uint32_t> g_message_rate_next_print_count{kMessageRatePrintNextCountInitial};
 
-static constexpr size_t kWindowMessageHistoryCapacity = 50;
+static constexpr size_t kWindowMessageHistoryMaxDepth = 4096;
+static constexpr size_t kWindowMessageHistoryDefaultDepth = 256;
 static constexpr UINT kIgnoredWindowMessageA = 0x14FE;
 static constexpr UINT kIgnoredWindowMessageB = 0xC2A1;
 static constexpr UINT kIgnoredWindowMessageC = 0x0060;  // WM_SETREDRAW
 static constexpr UINT kIgnoredWindowMessageD = 0x0113;  // WM_TIMER
-static std::array<WindowMessageRecord, kWindowMessageHistoryCapacity> g_window_message_history = {};
-static size_t g_window_message_history_next_index = 0;
-static size_t g_window_message_history_count = 0;
-static SRWLOCK g_window_message_history_lock = SRWLOCK_INIT;
+// Lock-free: every hooked message records here, from whichever thread pumps it
+static WindowMessageHistory g_window_message_history(kWindowMessageHistoryMaxDepth, kWindowMessageHistoryDefaultDepth);
+// Last message this thread recorded, so the message pump hooks can flag it when input blocking eats it
+struct LastRecordedWindowMessage {
+    uint64_t sequence = 0;
+    UINT message_id = 0;
+    bool valid = false;
+};
+static thread_local LastRecordedWindowMessage g_last_recorded_window_message;
 static std::atomic<bool> g_filter_ignored_message_a{false};
 static std::atomic<bool> g_filter_ignored_message_b{false};
 static std::atomic<bool> g_filter_ignored_message_c{false};
@@ -79,16 +93,17 @@ static bool ShouldIgnoreWindowMessageForDebugHistory(UINT message_id) {
     return false;
 }
 
-static void RecordWindowMessage(UINT message_id) {
+static void RecordWindowMessage(HWND hwnd, UINT message_id, WPARAM wParam, LPARAM lParam) {
+    LastRecordedWindowMessage& last = g_last_recorded_window_message;
     if (ShouldIgnoreWindowMessageForDebugHistory(message_id)) {
+        last.valid = false;
         return;
     }
-    utils::SRWLockExclusive guard(g_window_message_history_lock);
-    g_window_message_history[g_window_message_history_next_index].message_id = message_id;
-    g_window_message_history_next_index = (g_window_message_history_next_index + 1) % kWindowMessageHistoryCapacity;
-    if (g_window_message_history_count < kWindowMessageHistoryCapacity) {
-        ++g_window_message_history_count;
-    }
+    last.sequence = g_window_message_history.Record(reinterpret_cast<uintptr_t>(hwnd), message_id,
+                                                    static_cast<uintptr_t>(wParam), static_cast<intptr_t>(lParam),
+                                                    GetCurrentThreadId(), utils::get_real_time_ns());
+    last.message_id = message_id;
+    last.valid = true;
 }
 
 // Trampoline (SK-style): 1) ProcessWindowMessage; 2) if not skipped, call original WNDPROC.
@@ -165,11 +180,21 @@ static int CountOtherProcessWindows(HWND exclude_hwnd) {
     return data.count;
 }
 
+static bool ProcessWindowMessageImpl(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
 // Process window message - returns true if message should be suppressed
 // This function contains the logic previously in WindowProc_Detour
 bool ProcessWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-    RecordWindowMessage(uMsg);
+    RecordWindowMessage(hwnd, uMsg, wParam, lParam);
+    const bool suppress = ProcessWindowMessageImpl(hwnd, uMsg, wParam, lParam);
+    if (suppress && g_last_recorded_window_message.valid) {
+        g_window_message_history.SetSuppressed(g_last_recorded_window_message.sequence,
+                                               MessageSuppression::kWindowProc);
+    }
+    return suppress;
+}
 
+static bool ProcessWindowMessageImpl(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     // Check if continue rendering is enabled
     // Special-K style: set ping signal when ping message is received, inject marker on next SIMULATION_START
     if (PCLSTATS_IS_PING_MSG_ID(uMsg)) {
@@ -188,6 +213,40 @@ bool ProcessWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
         g_sent_activate.store(true);
     }
 
+    // Push activation changes to foreground tracking before continue-rendering may suppress them
+    if (uMsg == WM_ACTIVATEAPP || uMsg == WM_ACTIVATE) {
+        display_commander::feature::foreground::ReportWindowActivationMessage();
+    }
+    // Display cache refresh is notification driven; the periodic refresh is only a fingerprint check.
+    if (uMsg == WM_DISPLAYCHANGE) {
+        display_cache::g_displayCache.RequestRefresh(false);
+        const LONGLONG now_ns = utils::get_now_ns();
+        display_commander::feature::hitch::RecordHitchDisplayModeChange(now_ns, now_ns, "WM_DISPLAYCHANGE");
+    } else if (uMsg == WM_DEVICECHANGE && wParam == DBT_DEVNODES_CHANGED) {
+        // Monitor hot-plug / swap: the fingerprint includes the connected monitor, so the incremental refresh
+        // re-enumerates only the displays that changed
+        display_cache::g_displayCache.RequestRefresh(false);
+    }
+    // Controller plugged in: stop answering XInputGetState "not connected" from the disconnected-slot cache
+    if ((uMsg == WM_DEVICECHANGE && (wParam == DBT_DEVNODES_CHANGED || wParam == DBT_DEVICEARRIVAL))
+        || (uMsg == WM_INPUT_DEVICE_CHANGE && wParam == GIDC_ARRIVAL)) {
+        display_commanderhooks::InvalidateXInputConnectionCache();
+    }
+    // Window auto-fix runs when the game window changes instead of polling it every few ms
+    if (game_window == hwnd
+        && (uMsg == WM_WINDOWPOSCHANGED || uMsg == WM_STYLECHANGED || (uMsg == WM_SIZE && wParam != SIZE_MINIMIZED))) {
+        continuous_monitoring::RequestTaskRun(continuous_monitoring::MonitoringTask::kWindowAutoFix);
+    }
+    // Key state (hotkeys) and input latency: keyboard / mouse arrival (no-op for other messages)
+    keyboard_tracker::ReportKeyMessage(uMsg, wParam, lParam);
+    display_commander::feature::input_latency::ReportWindowInputMessage(uMsg, lParam);
+    if (uMsg == WM_INPUT) {
+        TrackRawInputMessage(lParam);
+    } else if (uMsg == WM_KILLFOCUS || (uMsg == WM_ACTIVATEAPP && wParam == FALSE)) {
+        // Key ups after focus loss go to the other window
+        keyboard_tracker::RequestReconcile();
+    }
+
     // Handle specific window messages here
     switch (uMsg) {
         case WM_ACTIVATE: {
@@ -362,23 +421,24 @@ bool ProcessWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     return false;  // Don't suppress the message
 }
 
-std::vector<WindowMessageRecord> GetRecentWindowMessagesSnapshot() {
-    std::vector<WindowMessageRecord> snapshot;
-    utils::SRWLockShared guard(g_window_message_history_lock);
-    snapshot.reserve(g_window_message_history_count);
-    for (size_t i = 0; i < g_window_message_history_count; ++i) {
-        const size_t index = (g_window_message_history_next_index + kWindowMessageHistoryCapacity - 1 - i)
-                             % kWindowMessageHistoryCapacity;
-        snapshot.push_back(g_window_message_history[index]);
+std::vector<WindowMessageRecord> GetRecentWindowMessagesSnapshot() { return g_window_message_history.Snapshot(); }
+
+void ClearRecentWindowMessages() { g_window_message_history.Clear(); }
+
+void MarkLastWindowMessageSuppressed(UINT message_id) {
+    const LastRecordedWindowMessage& last = g_last_recorded_window_message;
+    if (last.valid && last.message_id == message_id) {
+        g_window_message_history.SetSuppressed(last.sequence, MessageSuppression::kInputBlocking);
     }
-    return snapshot;
 }
 
-void ClearRecentWindowMessages() {
-    utils::SRWLockExclusive guard(g_window_message_history_lock);
-    g_window_message_history_count = 0;
-    g_window_message_history_next_index = 0;
-}
+size_t GetWindowMessageHistoryDepth() { return g_window_message_history.GetDepth(); }
+
+size_t GetWindowMessageHistoryMaxDepth() { return g_window_message_history.GetMaxDepth(); }
+
+void SetWindowMessageHistoryDepth(size_t depth) { g_window_message_history.SetDepth(depth); }
+
+uint64_t GetWindowMessageHistoryDroppedCount() { return g_window_message_history.GetDroppedCount(); }
 
 bool GetDebugHistoryFilterEnabledForMessage(UINT message_id) {
     if (message_id == kIgnoredWindowMessageA) {
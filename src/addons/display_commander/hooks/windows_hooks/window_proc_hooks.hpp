@@ -7,13 +7,10 @@
 
 #include <windows.h>
 #include <vector>
+#include "window_message_history.hpp"
 
 namespace display_commanderhooks {
 
-struct WindowMessageRecord {
-    UINT message_id = 0;
-};
-
 // True if window has caption or thick frame (standard bordered window). Borderless windows return false.
 bool WindowHasBorder(HWND hwnd);
 
@@ -34,12 +31,23 @@ void DetourWindowMessageNonBlocking(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM
 // Called from message retrieval hooks (GetMessage/PeekMessage) when hwnd belongs to current process
 bool ProcessWindowMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
-// Returns latest-to-oldest snapshot of recent window messages.
+// Returns latest-to-oldest snapshot of recent window messages. Never blocks the message pump.
 std::vector<WindowMessageRecord> GetRecentWindowMessagesSnapshot();
 
 // Clears the captured recent window message history.
 void ClearRecentWindowMessages();
 
+// Flags the message this thread last passed to ProcessWindowMessage as eaten by input blocking (no-op if the id
+// differs, e.g. the message was not recorded).
+void MarkLastWindowMessageSuppressed(UINT message_id);
+
+// History depth (power of two, up to GetWindowMessageHistoryMaxDepth). Changing it clears the history.
+size_t GetWindowMessageHistoryDepth();
+size_t GetWindowMessageHistoryMaxDepth();
+void SetWindowMessageHistoryDepth(size_t depth);
+// Records lost because a slot was still being written by another thread a full ring earlier.
+uint64_t GetWindowMessageHistoryDroppedCount();
+
 // Per-message debug history filters (when enabled, message is ignored in history capture).
 bool GetDebugHistoryFilterEnabledForMessage(UINT message_id);
 void SetDebugHistoryFilterEnabledForMessage(UINT message_id, bool enabled);
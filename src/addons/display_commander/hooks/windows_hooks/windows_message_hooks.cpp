@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <array>
 #include <sstream>
+#include "../../continuous_monitoring.hpp"
+#include "../../feature/input_latency/input_latency.hpp"
 #include "../../globals.hpp"
 #include "../../process_exit_hooks.hpp"  // For UnhandledExceptionHandler
 #include "../../settings/advanced_tab_settings.hpp"
@@ -51,7 +53,7 @@ bool ShouldBlockMouseInput(bool assume_foreground) {
         case InputBlockingMode::kEnabled:                   return true;
         case InputBlockingMode::kEnabledInBackground:       return is_background;
         case InputBlockingMode::kEnabledWhenXInputDetected: {
-            // Check if XInput was detected recently (within last 180 frames, ~3 seconds at 60 FPS)
+            // Check if XInput was detected recently (within kXInputDetectionWindowFrames)
             uint64_t current_frame_id = g_global_frame_id.load();
             uint64_t last_xinput_frame_id = g_last_xinput_detected_frame_id.load();
 
@@ -60,8 +62,7 @@ bool ShouldBlockMouseInput(bool assume_foreground) {
                 return false;
             }
 
-            // Check if XInput was detected within the last 180 frames
-            constexpr uint64_t kXInputDetectionWindowFrames = 180;
+            // Check if XInput was detected within the detection window
             uint64_t frame_difference =
                 current_frame_id > last_xinput_frame_id ? current_frame_id - last_xinput_frame_id : 0;
 
@@ -241,8 +242,33 @@ constexpr bool HookInfoOrderValid() {
 static_assert(HookInfoOrderValid(), "g_hook_info order must match HookIndex enum");
 }  // namespace
 
+namespace {
+// Message ids currently blocked by input blocking; rebuilt by RefreshMessageSuppressionFilter
+MessageSuppressionFilter g_message_filter;
+}  // namespace
+
+void RefreshMessageSuppressionFilter() {
+    // Only DOWN events are blocked; UP events pass to clear stuck keys/buttons. Exclusive key groups are checked in
+    // GetMessage/PeekMessage where wParam is available.
+    uint32_t blocked_classes = 0;
+    if (settings::g_experimentalTabSettings.test_block_keyboard_messages.GetValue() || ShouldBlockKeyboardInput(true)) {
+        blocked_classes |= kKeyboardMessageClasses;
+    }
+    if (settings::g_experimentalTabSettings.test_block_mouse_messages.GetValue() || ShouldBlockMouseInput(true)) {
+        blocked_classes |= kMouseMessageClasses;
+    }
+    g_message_filter.SetBlockedClasses(blocked_classes);
+}
+
+MessageSuppressionStats GetMessageSuppressionStats() { return g_message_filter.GetStats(); }
+
 // Check if we should suppress a message (for input blocking)
 bool ShouldSuppressMessage(HWND hWnd, UINT uMsg) {
+    // One bit test for the common case (message not blocked), before any window lookup
+    if (!g_message_filter.IsBlocked(uMsg)) {
+        return false;
+    }
+
     // Get the game window from API hooks
     HWND gameWindow = GetGameWindow();
     if (gameWindow == nullptr) {
@@ -251,46 +277,9 @@ bool ShouldSuppressMessage(HWND hWnd, UINT uMsg) {
 
     // Check if the message is for the game window or its children
     if (hWnd == nullptr || hWnd == gameWindow || IsChild(gameWindow, hWnd)) {
-        // Check if it's an input message that should be blocked
-        // Only block DOWN events, allow UP events to clear stuck keys/buttons
-        switch (uMsg) {
-            // Keyboard DOWN messages only
-            case WM_KEYDOWN:
-            case WM_SYSKEYDOWN:
-            case WM_CHAR:
-            case WM_SYSCHAR:
-            case WM_DEADCHAR:
-            case WM_SYSDEADCHAR:
-                // Test setting: Block keyboard messages
-                if (settings::g_experimentalTabSettings.test_block_keyboard_messages.GetValue()) {
-                    return true;
-                }
-                // Note: Exclusive key group check is done in GetMessage/PeekMessage where we have access to wParam
-                return ShouldBlockKeyboardInput(true);
-            // Mouse DOWN messages only
-            case WM_LBUTTONDOWN:
-            case WM_RBUTTONDOWN:
-            case WM_MBUTTONDOWN:
-            case WM_XBUTTONDOWN:
-            case WM_MOUSEMOVE:
-            case WM_MOUSEWHEEL:
-            case WM_MOUSEHWHEEL:
-            // Cursor messages
-            case WM_SETCURSOR:
-                // Test setting: Block mouse messages
-                if (settings::g_experimentalTabSettings.test_block_mouse_messages.GetValue()) {
-                    return true;
-                }
-                return ShouldBlockMouseInput(true);
-            // Allow UP events to pass through to clear stuck keys/buttons
-            case WM_KEYUP:
-            case WM_SYSKEYUP:
-            case WM_LBUTTONUP:
-            case WM_RBUTTONUP:
-            case WM_MBUTTONUP:
-            case WM_XBUTTONUP:
-            default:           return false;
-        }
+        g_message_filter.CountSuppressed(uMsg);
+        MarkLastWindowMessageSuppressed(uMsg);
+        return true;
     }
 
     return false;
@@ -445,6 +434,27 @@ static void RewriteWmInputBackgroundToForeground(LPMSG lpMsg) {
     lpMsg->wParam = RIM_INPUT;
 }
 
+void TrackRawInput(const RAWINPUT& input) {
+    keyboard_tracker::ReportRawInput(input);
+    if (input.header.dwType == RIM_TYPEMOUSE) {
+        display_commander::feature::input_latency::ReportRawInput(
+            display_commander::feature::input_latency::InputSource::kMouse);
+    } else if (input.header.dwType == RIM_TYPEKEYBOARD && (input.data.keyboard.Flags & RI_KEY_BREAK) == 0) {
+        display_commander::feature::input_latency::ReportRawInput(
+            display_commander::feature::input_latency::InputSource::kKeyboard);
+    }
+}
+
+void TrackRawInputMessage(LPARAM lParam) {
+    RAWINPUT input = {};
+    UINT size = sizeof(input);
+    // HID reports do not fit into RAWINPUT and fail here; only keyboard / mouse are tracked
+    if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &input, &size, sizeof(RAWINPUTHEADER))
+        != static_cast<UINT>(-1)) {
+        TrackRawInput(input);
+    }
+}
+
 // Hooked GetMessageA function
 // Loop until we get a message we do not suppress, so the app never sees suppressed messages.
 BOOL WINAPI GetMessageA_Detour(LPMSG lpMsg, HWND hWnd, UINT wMsgFilterMin, UINT wMsgFilterMax) {
@@ -1117,6 +1127,9 @@ UINT WINAPI GetRawInputBuffer_Detour(PRAWINPUT pData, PUINT pcbSize, UINT cbSize
                 break;
             }
 
+            // Key state / input latency see the original input, also when it is blocked for the game below
+            TrackRawInput(*current);
+
             // Check if this input should be replaced
             bool should_replace = false;
 
@@ -2288,20 +2301,73 @@ DllGroup GetHookDllGroup(int hook_index) {
 // Keyboard state tracking implementation
 namespace keyboard_tracker {
 
-// Keyboard state arrays (256 keys)
-std::array<std::atomic<bool>, 256> s_key_down{};
-std::array<std::atomic<bool>, 256> s_key_pressed{};
-std::array<bool, 256> s_prev_key_state{};
-// only get key state if it was ever checked
+namespace {
+
+// Event-fed key state; drained / polled by the continuous monitoring thread (keyboard_hotkeys task)
+KeyStateTracker g_key_state;
+
+// Only keys that were ever checked are reconciled by polling (monitoring thread only)
 std::array<bool, 256> was_ever_checked{};
 
-void Initialize() {
-    // Initialize all states to false
-    for (int i = 0; i < 256; ++i) {
-        s_key_down[i].store(false);
-        s_key_pressed[i].store(false);
-        s_prev_key_state[i] = false;
+// Polls every pass until key events arrive through the hooks and while the game is in background, so hotkeys keep
+// working when no message hook / window proc sees keyboard input.
+ReconcileSchedule g_reconcile_schedule;
+std::atomic<bool> g_reconcile_requested{false};
+
+// GetTickCount of the last poll correction per key: queued messages older than that are stale (the poll already
+// applied the transition) and must not produce a second press.
+std::array<std::atomic<DWORD>, 256> s_poll_corrected_tick{};
+
+// Scan codes of the right-hand Shift (left is 0x2A); Ctrl / Alt use the extended-key flag.
+constexpr UINT kRightShiftScanCode = 0x36;
+
+void ApplyKeyEvent(int vk, bool down, KeyEdgeSource source) {
+    if (g_key_state.SetKeyState(vk, down, source, utils::get_now_ns())) {
+        g_reconcile_schedule.OnEventTraffic();
+        if (down) {
+            continuous_monitoring::RequestTaskRun(continuous_monitoring::MonitoringTask::kKeyboardHotkeys);
+        }
     }
+}
+
+// Generic modifier (VK_SHIFT, ...) is down while either side is down.
+void ApplyModifierEvent(int generic_vk, int side_vk, int other_side_vk, bool down, KeyEdgeSource source) {
+    ApplyKeyEvent(side_vk, down, source);
+    ApplyKeyEvent(generic_vk, down || g_key_state.IsDown(other_side_vk), source);
+}
+
+void ApplyVirtualKeyEvent(int vk, UINT scan_code, bool extended, bool down, KeyEdgeSource source) {
+    switch (vk) {
+        case VK_SHIFT:
+            if ((scan_code & 0xFF) == kRightShiftScanCode) {
+                ApplyModifierEvent(VK_SHIFT, VK_RSHIFT, VK_LSHIFT, down, source);
+            } else {
+                ApplyModifierEvent(VK_SHIFT, VK_LSHIFT, VK_RSHIFT, down, source);
+            }
+            break;
+        case VK_CONTROL:
+            ApplyModifierEvent(VK_CONTROL, extended ? VK_RCONTROL : VK_LCONTROL, extended ? VK_LCONTROL : VK_RCONTROL,
+                               down, source);
+            break;
+        case VK_MENU:
+            ApplyModifierEvent(VK_MENU, extended ? VK_RMENU : VK_LMENU, extended ? VK_LMENU : VK_RMENU, down, source);
+            break;
+        default: ApplyKeyEvent(vk, down, source); break;
+    }
+}
+
+bool IsStaleMessage(int vk) {
+    if (vk < 0 || vk >= 256) {
+        return true;
+    }
+    const DWORD corrected_tick = s_poll_corrected_tick[vk].load(std::memory_order_relaxed);
+    return corrected_tick != 0 && static_cast<LONG>(static_cast<DWORD>(GetMessageTime()) - corrected_tick) < 0;
+}
+
+}  // namespace
+
+void Initialize() {
+    g_key_state.ResetFrame();
 
     // Initialize exclusive key groups
     exclusive_key_groups::Initialize();
@@ -2310,58 +2376,142 @@ void Initialize() {
     exclusive_key_groups::UpdateCachedActiveKeys();
 }
 
+void ReportKeyMessage(UINT msg, WPARAM wParam, LPARAM lParam) {
+    int vk = 0;
+    bool down = false;
+    switch (msg) {
+        case WM_KEYDOWN:
+        case WM_SYSKEYDOWN:
+        case WM_KEYUP:
+        case WM_SYSKEYUP: {
+            vk = static_cast<int>(wParam);
+            if (IsStaleMessage(vk)) {
+                return;
+            }
+            down = msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN;
+            const UINT scan_code = static_cast<UINT>((lParam >> 16) & 0xFF);
+            const bool extended = (lParam & (1 << 24)) != 0;
+            ApplyVirtualKeyEvent(vk, scan_code, extended, down, KeyEdgeSource::kMessage);
+            return;
+        }
+        case WM_LBUTTONDOWN: vk = VK_LBUTTON; down = true; break;
+        case WM_LBUTTONUP:   vk = VK_LBUTTON; break;
+        case WM_RBUTTONDOWN: vk = VK_RBUTTON; down = true; break;
+        case WM_RBUTTONUP:   vk = VK_RBUTTON; break;
+        case WM_MBUTTONDOWN: vk = VK_MBUTTON; down = true; break;
+        case WM_MBUTTONUP:   vk = VK_MBUTTON; break;
+        case WM_XBUTTONDOWN:
+        case WM_XBUTTONUP:
+            vk = GET_XBUTTON_WPARAM(wParam) == XBUTTON2 ? VK_XBUTTON2 : VK_XBUTTON1;
+            down = msg == WM_XBUTTONDOWN;
+            break;
+        default: return;
+    }
+    if (!IsStaleMessage(vk)) {
+        ApplyKeyEvent(vk, down, KeyEdgeSource::kMessage);
+    }
+}
+
+void ReportRawInput(const RAWINPUT& input) {
+    if (input.header.dwType == RIM_TYPEKEYBOARD) {
+        const RAWKEYBOARD& kb = input.data.keyboard;
+        // 0xFF: fake key of an escape sequence (e.g. Pause, Print Screen prefix)
+        if (kb.VKey == 0 || kb.VKey >= 0xFF) {
+            return;
+        }
+        ApplyVirtualKeyEvent(kb.VKey, kb.MakeCode, (kb.Flags & RI_KEY_E0) != 0, (kb.Flags & RI_KEY_BREAK) == 0,
+                             KeyEdgeSource::kRawInput);
+    } else if (input.header.dwType == RIM_TYPEMOUSE) {
+        const USHORT flags = input.data.mouse.usButtonFlags;
+        if (flags == 0) {
+            return;  // Movement only
+        }
+        static constexpr struct {
+            USHORT down_flag;
+            USHORT up_flag;
+            int vk;
+        } kButtons[] = {
+            {RI_MOUSE_LEFT_BUTTON_DOWN, RI_MOUSE_LEFT_BUTTON_UP, VK_LBUTTON},
+            {RI_MOUSE_RIGHT_BUTTON_DOWN, RI_MOUSE_RIGHT_BUTTON_UP, VK_RBUTTON},
+            {RI_MOUSE_MIDDLE_BUTTON_DOWN, RI_MOUSE_MIDDLE_BUTTON_UP, VK_MBUTTON},
+            {RI_MOUSE_BUTTON_4_DOWN, RI_MOUSE_BUTTON_4_UP, VK_XBUTTON1},
+            {RI_MOUSE_BUTTON_5_DOWN, RI_MOUSE_BUTTON_5_UP, VK_XBUTTON2},
+        };
+        for (const auto& button : kButtons) {
+            if ((flags & button.down_flag) != 0) {
+                ApplyKeyEvent(button.vk, true, KeyEdgeSource::kRawInput);
+            } else if ((flags & button.up_flag) != 0) {
+                ApplyKeyEvent(button.vk, false, KeyEdgeSource::kRawInput);
+            }
+        }
+    }
+}
+
+void RequestReconcile() {
+    g_reconcile_requested.store(true, std::memory_order_release);
+    continuous_monitoring::RequestTaskRun(continuous_monitoring::MonitoringTask::kKeyboardHotkeys);
+}
+
+LONGLONG GetUpdateIntervalNs(LONGLONG poll_interval_ns) {
+    return g_reconcile_schedule.UpdateIntervalNs(poll_interval_ns, g_app_in_background.load(std::memory_order_acquire));
+}
+
 void Update() {
     if (g_last_swapchain_hwnd.load() == nullptr) {
         return;
     }
+    g_key_state.DrainEdges();
+
+    const LONGLONG now_ns = utils::get_now_ns();
+    const bool requested = g_reconcile_requested.exchange(false, std::memory_order_acq_rel);
+    if (!g_reconcile_schedule.ShouldReconcile(now_ns, g_app_in_background.load(std::memory_order_acquire),
+                                              requested)) {
+        return;
+    }
+
+    // Slow path: catch transitions the hooks never saw (focus loss, input filtered before our hooks)
     auto first_reshade_runtime = GetSelectedReShadeRuntime();
-    // Update keyboard state using GetAsyncKeyState
+    const bool use_reshade_state = g_global_frame_id.load() > 500 && first_reshade_runtime != nullptr;
+    bool corrected = false;
     for (int vKey = 0; vKey < 256; ++vKey) {
         if (!was_ever_checked[vKey]) {
             continue;
         }
         // Use the original GetAsyncKeyState to get real keyboard state
         SHORT state = GetAsyncKeyState_Direct(vKey);
-        if (g_global_frame_id.load() > 500 && first_reshade_runtime != nullptr) {
+        if (use_reshade_state) {
             state |= first_reshade_runtime->is_key_down(vKey) ? 0x8000 : 0;
         }
-
-        // Check if key is currently down (high-order bit)
-        bool is_down = (state & 0x8000) != 0;
-
-        // Update current state
-        s_key_down[vKey].store(is_down);
-
-        // Check if this is a new press (was up, now down)
-        bool was_down = s_prev_key_state[vKey];
-        if (is_down && !was_down) {
-            s_key_pressed[vKey].store(true);
+        if (g_key_state.Reconcile(vKey, (state & 0x8000) != 0, now_ns)) {
+            s_poll_corrected_tick[vKey].store(GetTickCount(), std::memory_order_relaxed);
+            corrected = true;
         }
-
-        // Store current state for next frame
-        s_prev_key_state[vKey] = is_down;
     }
-}
-
-void ResetFrame() {
-    // Reset all pressed states for next frame
-    for (int i = 0; i < 256; ++i) {
-        s_key_pressed[i].store(false);
+    if (corrected) {
+        g_key_state.DrainEdges();
     }
 }
 
+void ResetFrame() { g_key_state.ResetFrame(); }
+
 bool IsKeyDown(int vKey) {
     if (vKey < 0 || vKey >= 256) return false;
     was_ever_checked[vKey] = true;
-    return s_key_down[vKey].load();
+    return g_key_state.IsDown(vKey);
 }
 
 bool IsKeyPressed(int vKey) {
     if (vKey < 0 || vKey >= 256) return false;
     was_ever_checked[vKey] = true;
-    return s_key_pressed[vKey].load();
+    return g_key_state.IsPressed(vKey);
 }
 
+std::span<const KeyPress> GetFramePresses() { return g_key_state.GetPresses(); }
+
+void ReportHotkeyHandled(int vKey) { g_key_state.ReportHotkeyHandled(vKey, utils::get_now_ns()); }
+
+KeyboardTrackerStats GetKeyboardTrackerStats() { return g_key_state.GetStats(); }
+
 }  // namespace keyboard_tracker
 
 // Exclusive key groups management
@@ -5,6 +5,8 @@
 #include <array>
 #include <atomic>
 #include "../../globals.hpp"  // For InputBlockingMode enum
+#include "keyboard_state_tracker.hpp"
+#include "message_suppression_filter.hpp"
 
 namespace display_commanderhooks {
 
@@ -264,12 +266,20 @@ void UninstallWindowsMessageHooks();
 // Helper functions
 bool ShouldSuppressMessage(HWND hWnd, UINT uMsg);
 
+// Re-evaluates the input blocking settings / toggle into the message filter used by ShouldSuppressMessage. Any
+// thread: called when the settings, the toggle or XInput detection change, and on every keyboard_hotkeys pass
+// (continuous monitoring) to catch the XInput detection window expiring.
+void RefreshMessageSuppressionFilter();
+MessageSuppressionStats GetMessageSuppressionStats();
+
 // Debug: suppress all GetMessage/PeekMessage (default off, not saved). Use to test if we forgot to spoof some message
 // type for continue rendering.
 bool GetDebugSuppressAllGetMessage();
 void SetDebugSuppressAllGetMessage(bool enable);
 
 // Input blocking helper functions
+// kEnabledWhenXInputDetected: XInput counts as detected for this many frames (~3 seconds at 60 FPS)
+constexpr uint64_t kXInputDetectionWindowFrames = 180;
 bool ShouldBlockKeyboardInput(bool assume_foreground = false);
 bool ShouldBlockMouseInput(bool assume_foreground = false);
 bool ShouldBlockGamepadInput();
@@ -288,24 +298,50 @@ const char* GetHookName(int hook_index);
 const char* GetDllGroupName(DllGroup group);
 DllGroup GetHookDllGroup(int hook_index);
 
-// Keyboard state tracking
+// Raw keyboard / mouse input reached the game (WM_INPUT or GetRawInputBuffer): key state and input latency tracking.
+void TrackRawInput(const RAWINPUT& input);
+// WM_INPUT: reads the packet (lParam = HRAWINPUT) once and passes it to TrackRawInput.
+void TrackRawInputMessage(LPARAM lParam);
+
+// Keyboard state tracking: key-state bitmap fed by the message hooks / raw input, edges queued for the
+// continuous monitoring thread, slow GetAsyncKeyState reconciliation for missed transitions.
 namespace keyboard_tracker {
 
 // Initialize keyboard tracking
 void Initialize();
 
-// Update keyboard state (call each frame)
+// Any thread: keyboard / mouse button message (WM_KEY*, WM_SYSKEY*, WM_*BUTTON*) or raw input reached the game.
+void ReportKeyMessage(UINT msg, WPARAM wParam, LPARAM lParam);
+void ReportRawInput(const RAWINPUT& input);
+
+// Any thread: re-poll tracked keys on the next update (focus loss can swallow key ups).
+void RequestReconcile();
+
+// Apply queued key edges; reconcile by polling every 250 ms (every call until key events are seen, and while the
+// game is in background: its window gets no key messages then)
 void Update();
 
+// How often the monitoring thread has to call Update(): poll_interval_ns while keys are only seen by polling
+// (no key events yet, game in background), the reconcile interval otherwise (key downs request an immediate Update).
+LONGLONG GetUpdateIntervalNs(LONGLONG poll_interval_ns);
+
 // Reset frame states (call after processing shortcuts)
 void ResetFrame();
 
 // Check if a key is currently down
 bool IsKeyDown(int vKey);
 
-// Check if a key was just pressed this frame
+// Check if a key was pressed since the last ResetFrame (also true for a tap released in between)
 bool IsKeyPressed(int vKey);
 
+// Key-down edges since the last ResetFrame in arrival order, with the keys held at each (valid until ResetFrame).
+std::span<const KeyPress> GetFramePresses();
+
+// A hotkey on vKey ran its action: records the key-down -> action response time.
+void ReportHotkeyHandled(int vKey);
+
+KeyboardTrackerStats GetKeyboardTrackerStats();
+
 }  // namespace keyboard_tracker
 
 namespace exclusive_key_groups {
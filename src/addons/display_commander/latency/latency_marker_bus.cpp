@@ -0,0 +1,259 @@
+// Source Code <Display Commander> // Latency marker bus core (platform-neutral, no Windows includes)
+#include "latency_marker_bus.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+
+namespace display_commander::latency {
+
+namespace {
+
+// VkLatencyMarkerNV has no PC_LATENCY_PING: its out-of-band markers start at 8
+constexpr uint32_t kVulkanNvOutOfBandFirst = 8;
+constexpr uint32_t kPclStatsControllerInputSample = 13;
+
+}  // namespace
+
+const char* LatencyMarkerSourceName(LatencyMarkerSource source) {
+    switch (source) {
+        case LatencyMarkerSource::kNvapiD3D:       return "NVAPI D3D";
+        case LatencyMarkerSource::kNvLowLatencyVk: return "NvLowLatencyVk";
+        case LatencyMarkerSource::kVulkanNv:       return "VK_NV_low_latency2";
+        case LatencyMarkerSource::kPclStatsEtw:    return "PCLStats ETW";
+        case LatencyMarkerSource::kInjected:       return "Injected";
+        default:                                   return "None";
+    }
+}
+
+const char* LatencyMarkerName(LatencyMarker marker) {
+    switch (marker) {
+        case LatencyMarker::kSimulationStart:            return "SIMULATION_START";
+        case LatencyMarker::kSimulationEnd:              return "SIMULATION_END";
+        case LatencyMarker::kRenderSubmitStart:          return "RENDERSUBMIT_START";
+        case LatencyMarker::kRenderSubmitEnd:            return "RENDERSUBMIT_END";
+        case LatencyMarker::kPresentStart:               return "PRESENT_START";
+        case LatencyMarker::kPresentEnd:                 return "PRESENT_END";
+        case LatencyMarker::kInputSample:                return "INPUT_SAMPLE";
+        case LatencyMarker::kTriggerFlash:               return "TRIGGER_FLASH";
+        case LatencyMarker::kPcLatencyPing:              return "PC_LATENCY_PING";
+        case LatencyMarker::kOutOfBandRenderSubmitStart: return "OUT_OF_BAND_RENDERSUBMIT_START";
+        case LatencyMarker::kOutOfBandRenderSubmitEnd:   return "OUT_OF_BAND_RENDERSUBMIT_END";
+        case LatencyMarker::kOutOfBandPresentStart:      return "OUT_OF_BAND_PRESENT_START";
+        case LatencyMarker::kOutOfBandPresentEnd:        return "OUT_OF_BAND_PRESENT_END";
+        case LatencyMarker::kControllerInputSample:      return "CONTROLLER_INPUT_SAMPLE";
+        default:                                         return "UNKNOWN";
+    }
+}
+
+bool NormalizeLatencyMarker(LatencyMarkerSource source, uint32_t raw_marker, LatencyMarker* marker_out) {
+    uint32_t normalized = raw_marker;
+    switch (source) {
+        case LatencyMarkerSource::kNvapiD3D:
+        case LatencyMarkerSource::kInjected:
+            if (raw_marker > static_cast<uint32_t>(LatencyMarker::kOutOfBandPresentEnd)) return false;
+            break;
+        case LatencyMarkerSource::kNvLowLatencyVk:
+            if (raw_marker > static_cast<uint32_t>(LatencyMarker::kPcLatencyPing)) return false;
+            break;
+        case LatencyMarkerSource::kVulkanNv:
+            if (raw_marker >= kVulkanNvOutOfBandFirst) {
+                normalized = raw_marker - kVulkanNvOutOfBandFirst
+                             + static_cast<uint32_t>(LatencyMarker::kOutOfBandRenderSubmitStart);
+                if (normalized > static_cast<uint32_t>(LatencyMarker::kOutOfBandPresentEnd)) return false;
+            }
+            break;
+        case LatencyMarkerSource::kPclStatsEtw:
+            if (raw_marker > kPclStatsControllerInputSample) return false;
+            break;
+        default: return false;
+    }
+    *marker_out = static_cast<LatencyMarker>(normalized);
+    return true;
+}
+
+LatencyMarkerBus::LatencyMarkerBus()
+    : subscribers_(std::make_shared<const SubscriberList>()), recent_(kRecentFrameCount) {
+    pending_.reserve(kOpenFrameSlots * 2);
+    handing_.reserve(kOpenFrameSlots * 2);
+}
+
+LatencyMarkerBus::SubscriberId LatencyMarkerBus::Subscribe(Subscriber subscriber) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const SubscriberId id = next_subscriber_id_++;
+    auto list = std::make_shared<SubscriberList>(*subscribers_);
+    list->emplace_back(id, std::move(subscriber));
+    subscribers_ = std::move(list);
+    return id;
+}
+
+void LatencyMarkerBus::Unsubscribe(SubscriberId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto list = std::make_shared<SubscriberList>(*subscribers_);
+    list->erase(std::remove_if(list->begin(), list->end(), [id](const auto& entry) { return entry.first == id; }),
+                list->end());
+    subscribers_ = std::move(list);
+}
+
+LatencyMarkerSource LatencyMarkerBus::ElectSourceLocked(int64_t now_ns) const {
+    for (size_t i = 0; i < kLatencyMarkerSourceCount; ++i) {
+        const LatencyMarkerSourceStats& s = stats_.sources[i];
+        if (s.events > s.unknown && now_ns - s.last_event_ns <= kSourceTimeoutNs) {
+            return static_cast<LatencyMarkerSource>(i);
+        }
+    }
+    return LatencyMarkerSource::kCount;
+}
+
+void LatencyMarkerBus::Publish(const LatencyMarkerEvent& event) {
+    if (event.source >= LatencyMarkerSource::kCount) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    PublishLocked(event);
+    DrainDeliveries(lock);
+}
+
+void LatencyMarkerBus::PublishLocked(const LatencyMarkerEvent& event) {
+    LatencyMarkerSourceStats& source_stats = stats_.sources[static_cast<size_t>(event.source)];
+    ++source_stats.events;
+    LatencyMarker marker{};
+    if (!NormalizeLatencyMarker(event.source, event.raw_marker, &marker)) {
+        ++source_stats.unknown;
+        return;
+    }
+    source_stats.last_event_ns = event.time_ns;
+
+    const LatencyMarkerSource elected = ElectSourceLocked(event.time_ns);
+    if (elected != stats_.active_source) {
+        // Frame IDs of different sources are unrelated: finish the old stream and start over
+        DeliverAllLocked();
+        if (stats_.active_source != LatencyMarkerSource::kCount) {
+            ++stats_.source_switches;
+        }
+        stats_.active_source = elected;
+        newest_frame_id_ = 0;
+        last_delivered_frame_id_ = 0;
+    }
+    if (event.source != stats_.active_source) {
+        ++source_stats.shadowed;
+        return;
+    }
+
+    const uint64_t frame_id = event.frame_id;
+    if (newest_frame_id_ != 0 && frame_id + kIdResetFrames < newest_frame_id_) {
+        DeliverAllLocked();
+        ++stats_.id_resets;
+        newest_frame_id_ = 0;
+        last_delivered_frame_id_ = 0;
+    }
+    if (frame_id > newest_frame_id_) {
+        newest_frame_id_ = frame_id;
+        if (frame_id > kDeliveryLagFrames) {
+            DeliverOlderThanLocked(frame_id - kDeliveryLagFrames + 1);
+        }
+    }
+
+    OpenFrame& slot = open_[frame_id % kOpenFrameSlots];
+    if (!slot.open || slot.record.frame_id != frame_id) {
+        if (frame_id <= last_delivered_frame_id_ || (slot.open && slot.record.frame_id > frame_id)) {
+            ++source_stats.late;
+            return;
+        }
+        if (slot.open) {
+            DeliverLocked(slot);  // Only reachable when IDs jump by more than the slot count
+        }
+        slot.open = true;
+        slot.record = LatencyFrameMarkers{};
+        slot.record.frame_id = frame_id;
+        slot.record.source = event.source;
+    }
+    const uint32_t bit = 1u << static_cast<uint32_t>(marker);
+    if ((slot.record.marker_mask & bit) != 0) {
+        ++source_stats.repeats;
+        return;
+    }
+    slot.record.marker_mask |= bit;
+    slot.record.time_ns[static_cast<size_t>(marker)] = event.time_ns;
+}
+
+void LatencyMarkerBus::DeliverOlderThanLocked(uint64_t frame_id_limit) {
+    // At most kOpenFrameSlots frames: selection in frame ID order
+    for (;;) {
+        OpenFrame* oldest = nullptr;
+        for (OpenFrame& f : open_) {
+            if (f.open && f.record.frame_id < frame_id_limit
+                && (oldest == nullptr || f.record.frame_id < oldest->record.frame_id)) {
+                oldest = &f;
+            }
+        }
+        if (oldest == nullptr) {
+            return;
+        }
+        DeliverLocked(*oldest);
+    }
+}
+
+void LatencyMarkerBus::DeliverAllLocked() { DeliverOlderThanLocked(UINT64_MAX); }
+
+void LatencyMarkerBus::DeliverLocked(OpenFrame& frame) {
+    frame.open = false;
+    last_delivered_frame_id_ = (std::max)(last_delivered_frame_id_, frame.record.frame_id);
+    ++stats_.frames_delivered;
+    recent_[recent_next_] = frame.record;
+    recent_next_ = (recent_next_ + 1) % recent_.size();
+    recent_size_ = (std::min)(recent_size_ + 1, recent_.size());
+    pending_.push_back(frame.record);
+}
+
+void LatencyMarkerBus::DrainDeliveries(std::unique_lock<std::mutex>& lock) {
+    if (draining_ || pending_.empty()) {
+        return;  // The draining thread (possibly further up this stack) picks the records up
+    }
+    draining_ = true;
+    while (!pending_.empty()) {
+        handing_.swap(pending_);
+        const std::shared_ptr<const SubscriberList> subscribers = subscribers_;
+        lock.unlock();
+        for (const LatencyFrameMarkers& record : handing_) {
+            for (const auto& [id, subscriber] : *subscribers) {
+                subscriber(record);
+            }
+        }
+        handing_.clear();
+        lock.lock();
+    }
+    draining_ = false;
+}
+
+void LatencyMarkerBus::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    DeliverAllLocked();
+    DrainDeliveries(lock);
+}
+
+bool LatencyMarkerBus::GetLatestFrame(LatencyFrameMarkers* frame_out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (recent_size_ == 0) {
+        return false;
+    }
+    *frame_out = recent_[(recent_next_ + recent_.size() - 1) % recent_.size()];
+    return true;
+}
+
+std::vector<LatencyFrameMarkers> LatencyMarkerBus::GetRecentFrames(size_t max_frames) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t n = (std::min)(max_frames, recent_size_);
+    std::vector<LatencyFrameMarkers> out;
+    out.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        out.push_back(recent_[(recent_next_ + recent_.size() - 1 - i) % recent_.size()]);
+    }
+    return out;
+}
+
+LatencyMarkerBusStats LatencyMarkerBus::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}  // namespace display_commander::latency
@@ -0,0 +1,164 @@
+// Source Code <Display Commander> // Latency marker bus core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace display_commander::latency {
+
+// Where a marker was observed. Lower values win when several sources report the same frames.
+enum class LatencyMarkerSource : uint8_t {
+    kNvapiD3D = 0,    // NvAPI_D3D_SetLatencyMarker (game, Streamline sl.reflex)
+    kNvLowLatencyVk,  // NvLL_VK_SetLatencyMarker (NvLowLatencyVk.dll)
+    kVulkanNv,        // vkSetLatencyMarkerNV (VK_NV_low_latency2)
+    kPclStatsEtw,     // PCLStatsEvent written by another module (game PCLStats, Streamline sl.pcl)
+    kInjected,        // Display Commander's own Reflex markers (ReflexProvider::SetMarker)
+    kCount
+};
+constexpr size_t kLatencyMarkerSourceCount = static_cast<size_t>(LatencyMarkerSource::kCount);
+
+const char* LatencyMarkerSourceName(LatencyMarkerSource source);
+
+enum class LatencyMarker : uint8_t {
+    kSimulationStart = 0,
+    kSimulationEnd,
+    kRenderSubmitStart,
+    kRenderSubmitEnd,
+    kPresentStart,
+    kPresentEnd,
+    kInputSample,
+    kTriggerFlash,
+    kPcLatencyPing,
+    kOutOfBandRenderSubmitStart,
+    kOutOfBandRenderSubmitEnd,
+    kOutOfBandPresentStart,
+    kOutOfBandPresentEnd,
+    kControllerInputSample,
+    kCount
+};
+constexpr size_t kLatencyMarkerCount = static_cast<size_t>(LatencyMarker::kCount);
+
+const char* LatencyMarkerName(LatencyMarker marker);
+
+// Maps a source's raw marker value (NV_LATENCY_MARKER_TYPE, NVLL_VK_LATENCY_MARKER_TYPE, VkLatencyMarkerNV or
+// PCLSTATS_LATENCY_MARKER_TYPE) onto LatencyMarker. False for values the bus does not track.
+bool NormalizeLatencyMarker(LatencyMarkerSource source, uint32_t raw_marker, LatencyMarker* marker_out);
+
+struct LatencyMarkerEvent {
+    LatencyMarkerSource source = LatencyMarkerSource::kCount;
+    uint32_t raw_marker = 0;
+    uint64_t frame_id = 0;  // In the source's own frame ID space
+    int64_t time_ns = 0;    // QPC time the marker was observed
+};
+
+// All markers of one frame from the elected source (first occurrence of each marker).
+struct LatencyFrameMarkers {
+    uint64_t frame_id = 0;
+    LatencyMarkerSource source = LatencyMarkerSource::kCount;
+    uint32_t marker_mask = 0;  // Bit per LatencyMarker seen
+    std::array<int64_t, kLatencyMarkerCount> time_ns = {};
+
+    bool Has(LatencyMarker m) const { return (marker_mask & (1u << static_cast<uint32_t>(m))) != 0; }
+    int64_t Time(LatencyMarker m) const { return Has(m) ? time_ns[static_cast<size_t>(m)] : 0; }
+};
+
+struct LatencyMarkerSourceStats {
+    uint64_t events = 0;
+    uint64_t unknown = 0;   // Raw marker value not tracked
+    uint64_t shadowed = 0;  // Dropped: a higher-priority source reports the same frames
+    uint64_t repeats = 0;   // Same marker again within one frame (first one kept)
+    uint64_t late = 0;      // Frame was already delivered
+    int64_t last_event_ns = 0;
+};
+
+struct LatencyMarkerBusStats {
+    std::array<LatencyMarkerSourceStats, kLatencyMarkerSourceCount> sources = {};
+    LatencyMarkerSource active_source = LatencyMarkerSource::kCount;
+    uint64_t frames_delivered = 0;
+    uint64_t source_switches = 0;
+    uint64_t id_resets = 0;
+};
+
+// One stream of per-frame marker records out of the marker hooks. Every hook publishes what it saw; the bus elects the
+// highest-priority source that reported within kSourceTimeoutNs, so a game that emits native Reflex markers and
+// PCLStats ETW markers (or a game plus our injected markers) yields one record per frame instead of two. A frame is
+// delivered once markers for a frame kDeliveryLagFrames newer arrive (simulation of the next frames overlaps present),
+// in frame ID order.
+//
+// Subscribers are consumers of the assembled record (frame generation pacing, debug UI). The FPS limiter keeps acting
+// on the raw marker inside the hook: it has to sleep on the marker call itself, kDeliveryLagFrames before the bus
+// would deliver that frame.
+//
+// Publish is thread-safe. Records are queued under the bus lock and handed to subscribers after it is released, by one
+// publishing thread at a time (the one that found the queue idle), so subscribers see frames in order and may take
+// their own locks or publish again (the nested records are delivered by the same loop). A subscriber can still be
+// called once for a record queued before Unsubscribe returned.
+class LatencyMarkerBus {
+   public:
+    using Subscriber = std::function<void(const LatencyFrameMarkers&)>;
+    using SubscriberId = uint32_t;
+
+    static constexpr int64_t kSourceTimeoutNs = 500'000'000;
+    static constexpr uint64_t kDeliveryLagFrames = 3;
+    static constexpr uint64_t kIdResetFrames = 1000;  // A frame ID this far behind the newest restarts tracking
+    static constexpr size_t kOpenFrameSlots = 8;
+    static constexpr size_t kRecentFrameCount = 64;
+
+    LatencyMarkerBus();
+
+    SubscriberId Subscribe(Subscriber subscriber);
+    void Unsubscribe(SubscriberId id);
+
+    void Publish(const LatencyMarkerEvent& event);
+
+    // Delivers all open frames (device teardown, end of a capture).
+    void Flush();
+
+    // Last delivered frame; false before the first one.
+    bool GetLatestFrame(LatencyFrameMarkers* frame_out) const;
+    // Delivered frames, newest first.
+    std::vector<LatencyFrameMarkers> GetRecentFrames(size_t max_frames) const;
+    LatencyMarkerBusStats GetStats() const;
+
+   private:
+    struct OpenFrame {
+        bool open = false;
+        LatencyFrameMarkers record;
+    };
+
+    void PublishLocked(const LatencyMarkerEvent& event);
+    LatencyMarkerSource ElectSourceLocked(int64_t now_ns) const;
+    void DeliverOlderThanLocked(uint64_t frame_id_limit);  // Delivers open frames with frame_id < limit
+    void DeliverAllLocked();
+    void DeliverLocked(OpenFrame& frame);  // Queues the record for DrainDeliveries
+    void DrainDeliveries(std::unique_lock<std::mutex>& lock);
+
+    using SubscriberList = std::vector<std::pair<SubscriberId, Subscriber>>;
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const SubscriberList> subscribers_;  // Copied on (un)subscribe, shared with a running delivery
+    SubscriberId next_subscriber_id_ = 1;
+
+    std::vector<LatencyFrameMarkers> pending_;   // Delivered under the lock, not yet handed to subscribers
+    std::vector<LatencyFrameMarkers> handing_;   // Owned by the draining thread
+    bool draining_ = false;
+
+    std::array<OpenFrame, kOpenFrameSlots> open_ = {};
+    uint64_t newest_frame_id_ = 0;
+    uint64_t last_delivered_frame_id_ = 0;
+
+    std::vector<LatencyFrameMarkers> recent_;  // Ring of kRecentFrameCount
+    size_t recent_next_ = 0;
+    size_t recent_size_ = 0;
+
+    LatencyMarkerBusStats stats_;
+};
+
+}  // namespace display_commander::latency
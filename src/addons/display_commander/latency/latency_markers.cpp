@@ -0,0 +1,29 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "latency_markers.hpp"
+#include "../feature/trace/trace.hpp"
+#include "../utils/timing.hpp"
+
+namespace display_commander::latency {
+
+LatencyMarkerBus& GetLatencyMarkerBus() {
+    // Leaked: marker hooks can still fire on game threads during DLL unload
+    static LatencyMarkerBus& bus = *new LatencyMarkerBus();
+    return bus;
+}
+
+void PublishLatencyMarker(LatencyMarkerSource source, uint32_t raw_marker, uint64_t frame_id) {
+    LatencyMarkerEvent event;
+    event.source = source;
+    event.raw_marker = raw_marker;
+    event.frame_id = frame_id;
+    event.time_ns = static_cast<int64_t>(utils::get_now_ns());
+    GetLatencyMarkerBus().Publish(event);
+
+    LatencyMarker marker = LatencyMarker::kCount;
+    if (display_commander::feature::trace::IsTracing() && NormalizeLatencyMarker(source, raw_marker, &marker)) {
+        display_commander::feature::trace::TraceInstant(LatencyMarkerSourceName(source), LatencyMarkerName(marker),
+                                                        event.time_ns, frame_id);
+    }
+}
+
+}  // namespace display_commander::latency
@@ -0,0 +1,17 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#pragma once
+
+#include "latency_marker_bus.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace display_commander::latency {
+
+// Process-wide marker bus fed by the Reflex / PCLStats marker hooks.
+LatencyMarkerBus& GetLatencyMarkerBus();
+
+// Publishes one marker stamped with the current QPC time. Called from the marker hooks on the game's threads.
+void PublishLatencyMarker(LatencyMarkerSource source, uint32_t raw_marker, uint64_t frame_id);
+
+}  // namespace display_commander::latency
@@ -0,0 +1,188 @@
+// Source Code <Display Commander> // PCLStats ETW event queue core (platform-neutral, no Windows includes)
+#include "pclstats_event_queue.hpp"
+
+// Libraries <Standard C++>
+#include <cstring>
+
+namespace display_commander::latency {
+
+namespace {
+
+constexpr char kPclStatsEventName[] = "PCLStatsEvent";  // Also prefixes PCLStatsEventV2
+constexpr size_t kPclStatsEventNameLen = sizeof(kPclStatsEventName) - 1;
+constexpr char kPclStatsInitName[] = "PCLStatsInit";
+constexpr size_t kPclStatsInitNameLen = sizeof(kPclStatsInitName) - 1;
+
+bool MetaContains(const PclStatsRawEvent& event, const char* name, size_t name_len) {
+    for (size_t i = 0; i + name_len <= event.meta_size; ++i) {
+        if (std::memcmp(event.meta + i, name, name_len) == 0) return true;
+    }
+    return false;
+}
+
+// Ring cached per thread; the queue is a process singleton in practice, the owner check keeps other instances apart.
+// Destroyed on thread exit, which hands the thread's ring back.
+struct ThreadRingCache {
+    const void* queue = nullptr;
+    void* ring = nullptr;                           // nullptr: all rings taken, the thread uses the shared ring
+    std::atomic<uint32_t>* owner = nullptr;         // Owner field of ring
+    std::atomic<uint64_t>* release_count = nullptr;
+    void* pending = nullptr;  // Between BeginPush and CommitPush / AbortPush: Ring or SharedSlot
+    uint32_t pending_position = 0;
+    bool pending_shared = false;
+
+    void Release() {
+        if (owner != nullptr) {
+            owner->store(0, std::memory_order_release);
+            release_count->fetch_add(1, std::memory_order_relaxed);
+        }
+        queue = nullptr;
+        ring = nullptr;
+        owner = nullptr;
+        release_count = nullptr;
+    }
+
+    ~ThreadRingCache() { Release(); }
+};
+thread_local ThreadRingCache t_ring_cache;
+
+}  // namespace
+
+uint64_t HashProviderGuid(const void* guid16) {
+    const auto* p = static_cast<const uint8_t*>(guid16);
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < 16; ++i) {
+        h = (h ^ p[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+PclStatsEventKind DecodePclStatsRawEvent(const PclStatsRawEvent& event, uint32_t* marker_out, uint64_t* frame_id_out) {
+    if (MetaContains(event, kPclStatsEventName, kPclStatsEventNameLen)) {
+        if (event.field_count < 2 || event.field_sizes[0] != sizeof(uint32_t)
+            || event.field_sizes[1] != sizeof(uint64_t)) {
+            return PclStatsEventKind::kOther;
+        }
+        std::memcpy(marker_out, event.payload, sizeof(uint32_t));
+        std::memcpy(frame_id_out, event.payload + sizeof(uint32_t), sizeof(uint64_t));
+        return PclStatsEventKind::kMarker;
+    }
+    if (MetaContains(event, kPclStatsInitName, kPclStatsInitNameLen)) {
+        return PclStatsEventKind::kInit;
+    }
+    return PclStatsEventKind::kOther;
+}
+
+PclStatsEventQueue::PclStatsEventQueue() {
+    for (size_t i = 0; i < kRingCapacity; ++i) {
+        shared_slots_[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+}
+
+PclStatsEventQueue::~PclStatsEventQueue() {
+    if (t_ring_cache.queue == this) {
+        t_ring_cache.owner = nullptr;  // Nothing to hand back to a queue that is going away
+        t_ring_cache.Release();
+    }
+}
+
+PclStatsEventQueue::Ring* PclStatsEventQueue::RingForThread(uint32_t thread_id) {
+    if (t_ring_cache.queue == this) {
+        return static_cast<Ring*>(t_ring_cache.ring);
+    }
+    t_ring_cache.Release();  // The thread moved on from another queue
+    Ring* ring = nullptr;
+    for (Ring& candidate : rings_) {
+        uint32_t expected = 0;
+        if (candidate.owner_thread.compare_exchange_strong(expected, thread_id, std::memory_order_acq_rel)) {
+            ring = &candidate;
+            break;
+        }
+    }
+    t_ring_cache.queue = this;
+    t_ring_cache.ring = ring;
+    if (ring != nullptr) {
+        t_ring_cache.owner = &ring->owner_thread;
+        t_ring_cache.release_count = &released_rings_;
+    }
+    return ring;
+}
+
+PclStatsRawEvent* PclStatsEventQueue::BeginPush(uint32_t thread_id) {
+    Ring* ring = RingForThread(thread_id);
+    if (ring == nullptr) {
+        return BeginSharedPush();
+    }
+    const uint32_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= kRingCapacity) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    t_ring_cache.pending = ring;
+    t_ring_cache.pending_shared = false;
+    return &ring->events[head & (kRingCapacity - 1)];
+}
+
+PclStatsRawEvent* PclStatsEventQueue::BeginSharedPush() {
+    uint32_t position = shared_enqueue_.load(std::memory_order_relaxed);
+    for (;;) {
+        SharedSlot& slot = shared_slots_[position & (kRingCapacity - 1)];
+        const auto diff = static_cast<int32_t>(slot.sequence.load(std::memory_order_acquire) - position);
+        if (diff == 0) {
+            if (shared_enqueue_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                t_ring_cache.pending = &slot;
+                t_ring_cache.pending_position = position;
+                t_ring_cache.pending_shared = true;
+                return &slot.event;
+            }
+        } else if (diff < 0) {
+            shared_dropped_.fetch_add(1, std::memory_order_relaxed);  // Consumer has not freed the slot yet
+            return nullptr;
+        } else {
+            position = shared_enqueue_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void PclStatsEventQueue::CommitPush() {
+    if (t_ring_cache.pending_shared) {
+        auto* slot = static_cast<SharedSlot*>(t_ring_cache.pending);
+        slot->committed = true;
+        shared_queued_.fetch_add(1, std::memory_order_relaxed);
+        slot->sequence.store(t_ring_cache.pending_position + 1, std::memory_order_release);
+    } else {
+        Ring* ring = static_cast<Ring*>(t_ring_cache.pending);
+        ring->queued.fetch_add(1, std::memory_order_relaxed);
+        ring->head.store(ring->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    t_ring_cache.pending = nullptr;
+}
+
+void PclStatsEventQueue::AbortPush() {
+    if (t_ring_cache.pending_shared) {
+        // The slot is claimed and must still be published, or the consumer would stop at it for good
+        auto* slot = static_cast<SharedSlot*>(t_ring_cache.pending);
+        slot->committed = false;
+        slot->sequence.store(t_ring_cache.pending_position + 1, std::memory_order_release);
+    }
+    t_ring_cache.pending = nullptr;
+}
+
+PclStatsEventQueueStats PclStatsEventQueue::GetStats() const {
+    PclStatsEventQueueStats stats;
+    for (const Ring& ring : rings_) {
+        stats.queued += ring.queued.load(std::memory_order_relaxed);
+        stats.dropped += ring.dropped.load(std::memory_order_relaxed);
+        if (ring.owner_thread.load(std::memory_order_relaxed) != 0) {
+            ++stats.producer_threads;
+        }
+    }
+    stats.shared_ring_events = shared_queued_.load(std::memory_order_relaxed);
+    stats.queued += stats.shared_ring_events;
+    stats.dropped += shared_dropped_.load(std::memory_order_relaxed);
+    stats.released_rings = released_rings_.load(std::memory_order_relaxed);
+    stats.drained = drained_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace display_commander::latency
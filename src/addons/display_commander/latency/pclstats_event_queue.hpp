@@ -0,0 +1,128 @@
+// Source Code <Display Commander> // PCLStats ETW event queue core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace display_commander::latency {
+
+// 64-bit hash of a 16-byte provider GUID (FNV-1a), for the cheap first compare of provider registrations.
+uint64_t HashProviderGuid(const void* guid16);
+
+// One PCLStats TraceLogging write, copied raw on the game thread. TraceLogging descriptors: [0] provider metadata,
+// [1] event metadata (event name first, then field names), [2..] field payloads.
+struct PclStatsRawEvent {
+    static constexpr size_t kMetaBytes = 48;     // Enough for the event name; longer metadata is truncated
+    static constexpr size_t kPayloadBytes = 12;  // Marker (UInt32) + FrameID (UInt64)
+
+    int64_t time_ns = 0;
+    uint32_t thread_id = 0;
+    uint16_t meta_size = 0;  // Bytes valid in meta
+    uint8_t field_count = 0;
+    uint8_t field_sizes[2] = {};  // Sizes of descriptors [2] and [3] (0 when absent)
+    uint8_t meta[kMetaBytes] = {};
+    uint8_t payload[kPayloadBytes] = {};  // Descriptor [2], then [3], each truncated to its slot
+};
+
+enum class PclStatsEventKind : uint8_t { kOther = 0, kMarker, kInit };
+
+// Decodes a raw event. kMarker fills marker / frame_id (PCLStatsEvent and PCLStatsEventV2).
+PclStatsEventKind DecodePclStatsRawEvent(const PclStatsRawEvent& event, uint32_t* marker_out, uint64_t* frame_id_out);
+
+struct PclStatsEventQueueStats {
+    uint64_t queued = 0;
+    uint64_t dropped = 0;  // Ring full: the consumer fell behind
+    uint64_t drained = 0;
+    uint32_t producer_threads = 0;    // Threads that own a ring
+    uint64_t released_rings = 0;      // Rings handed back by exiting threads
+    uint64_t shared_ring_events = 0;  // Queued through the shared ring (all per-thread rings taken)
+};
+
+// Preallocated single-producer rings, one per game thread that writes PCLStats events, drained by one consumer. The
+// producer side takes no lock and allocates nothing. A thread's ring is handed back when the thread exits, so
+// short-lived writers (thread pools, per-level workers) do not use up the kThreadRings rings. Threads beyond that
+// share a bounded multi-producer ring: a full ring drops and counts the event instead of making the writer wait.
+//
+// Producer threads other than the one destroying the queue must have exited (or stopped pushing) before the queue is
+// destroyed; in the addon the queue is a leaked process singleton.
+class PclStatsEventQueue {
+   public:
+    static constexpr size_t kRingCapacity = 256;  // Power of two
+    static constexpr size_t kThreadRings = 7;
+
+    PclStatsEventQueue();
+    ~PclStatsEventQueue();
+    PclStatsEventQueue(const PclStatsEventQueue&) = delete;
+    PclStatsEventQueue& operator=(const PclStatsEventQueue&) = delete;
+
+    // Producer. Returns the slot to fill, or nullptr when the ring is full (counted as dropped). Every non-null
+    // BeginPush must be followed by CommitPush (keep) or AbortPush (discard) on the same thread.
+    PclStatsRawEvent* BeginPush(uint32_t thread_id);
+    void CommitPush();
+    void AbortPush();
+
+    // Consumer (single thread). Calls fn for every queued event, oldest first per ring. Returns the number drained.
+    template <typename Fn>
+    size_t Drain(Fn&& fn) {
+        size_t drained = 0;
+        for (Ring& ring : rings_) {
+            const uint32_t head = ring.head.load(std::memory_order_acquire);
+            uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+            for (; tail != head; ++tail) {
+                fn(ring.events[tail & (kRingCapacity - 1)]);
+                ++drained;
+            }
+            ring.tail.store(tail, std::memory_order_release);
+        }
+        // Shared ring: stops at the first slot a producer is still filling, the rest waits for the next drain
+        for (;; ++shared_dequeue_) {
+            SharedSlot& slot = shared_slots_[shared_dequeue_ & (kRingCapacity - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != shared_dequeue_ + 1) {
+                break;
+            }
+            if (slot.committed) {
+                fn(slot.event);
+                ++drained;
+            }
+            slot.sequence.store(shared_dequeue_ + static_cast<uint32_t>(kRingCapacity), std::memory_order_release);
+        }
+        drained_.fetch_add(drained, std::memory_order_relaxed);
+        return drained;
+    }
+
+    PclStatsEventQueueStats GetStats() const;
+
+   private:
+    struct Ring {
+        std::atomic<uint32_t> owner_thread{0};  // 0 = free
+        alignas(64) std::atomic<uint32_t> head{0};
+        alignas(64) std::atomic<uint32_t> tail{0};
+        std::atomic<uint64_t> queued{0};
+        std::atomic<uint64_t> dropped{0};
+        std::array<PclStatsRawEvent, kRingCapacity> events = {};
+    };
+
+    // Bounded MPMC ring slot (Vyukov): sequence == position when free, position + 1 once written
+    struct SharedSlot {
+        std::atomic<uint32_t> sequence{0};
+        bool committed = false;  // False for an aborted push: the consumer skips the slot
+        PclStatsRawEvent event;
+    };
+
+    Ring* RingForThread(uint32_t thread_id);
+    PclStatsRawEvent* BeginSharedPush();
+
+    std::array<Ring, kThreadRings> rings_;
+    alignas(64) std::atomic<uint32_t> shared_enqueue_{0};
+    uint32_t shared_dequeue_ = 0;  // Consumer only
+    std::atomic<uint64_t> shared_queued_{0};
+    std::atomic<uint64_t> shared_dropped_{0};
+    std::atomic<uint64_t> released_rings_{0};
+    std::array<SharedSlot, kRingCapacity> shared_slots_;
+    std::atomic<uint64_t> drained_{0};
+};
+
+}  // namespace display_commander::latency
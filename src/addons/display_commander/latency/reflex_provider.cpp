@@ -5,6 +5,7 @@
 // Define the PCLStats provider (must be in exactly one .cpp)
 PCLSTATS_DEFINE()
 #include "../hooks/nvidia/pclstats_etw_hooks.hpp"
+#include "latency_markers.hpp"
 #include "../settings/main_tab_settings.hpp"
 #include "../utils/general_utils.hpp"
 #include "../utils/logging.hpp"
@@ -149,6 +150,9 @@ bool ReflexProvider::SetMarker(NV_LATENCY_MARKER_TYPE marker) {
 
     const bool result = reflex_manager_.SetMarker(marker);
     if (!result) return result;
+    display_commander::latency::PublishLatencyMarker(display_commander::latency::LatencyMarkerSource::kInjected,
+                                                     static_cast<uint32_t>(marker),
+                                                     g_global_frame_id.load(std::memory_order_acquire));
 
     const LONGLONG now_ns = utils::get_now_ns();
     switch (marker) {
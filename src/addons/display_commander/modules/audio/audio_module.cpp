@@ -8,6 +8,7 @@
 #include "ui/ui_colors.hpp"
 #include "../../settings/main_tab_settings.hpp"
 #include "../../ui/new_ui/main_new_tab.hpp"
+#include "../../ui/new_ui/settings_wrapper.hpp"
 #include "../../utils.hpp"
 #include "../../utils/detour_call_tracker.hpp"
 #include "../../utils/exponential_smooth.hpp"
@@ -420,6 +421,25 @@ void DrawAudioSettingsInternal(display_commander::ui::IImGuiWrapper& imgui) {
     if (imgui.IsItemHovered()) {
         imgui.SetTooltipEx("Mute only if app is background AND another app outputs audio.");
     }
+    if (mute_in_bg_if_other) {
+        imgui.Indent();
+        imgui.SetNextItemWidth(200.0f);
+        ::ui::new_ui::SliderIntSetting(settings::g_mainTabSettings.mute_in_background_other_audio_hold_ms,
+                                       "Unmute after silence", "%d ms", imgui);
+        if (imgui.IsItemHovered()) {
+            imgui.SetTooltipEx(
+                "How long other apps must stay silent before the game is unmuted. Short sounds (notifications, "
+                "clicks) shorter than this do not toggle the mute.");
+        }
+        OtherAudioDetectorStats other_audio_stats;
+        if (::GetOtherAppAudioStats(&other_audio_stats)) {
+            imgui.TextColored(ui::colors::TEXT_DIMMED, "Other audio: %s (sessions: %d, sampled: %d, peak: %.3f)",
+                              other_audio_stats.playing ? "playing" : "silent",
+                              static_cast<int>(other_audio_stats.sessions),
+                              static_cast<int>(other_audio_stats.sampled_sessions), other_audio_stats.max_peak);
+        }
+        imgui.Unindent();
+    }
     if (settings::g_mainTabSettings.audio_mute.GetValue()) {
         imgui.EndDisabled();
     }
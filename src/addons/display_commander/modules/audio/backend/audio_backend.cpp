@@ -1,20 +1,27 @@
 #include "audio_backend.hpp"
+#include "audio_session_cache.hpp"
+#include "other_audio_detector.hpp"
 #include <audioclient.h>
 #include <endpointvolume.h>
 #include <mmdeviceapi.h>
 #include <mmreg.h>
 #include <propvarutil.h>
+#include <memory>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 #include "addon.hpp"
 #include "globals.hpp"
 #include "settings/main_tab_settings.hpp"
 #include "utils.hpp"
 #include "utils/logging.hpp"
+#include "utils/srwlock_wrapper.hpp"
 #include "utils/timing.hpp"
 #include "audio_device_policy.hpp"
 
 #include <windows.h>
+#include <wrl/client.h>
 
 #include <Functiondiscoverykeys_devpkey.h>
 
@@ -249,10 +256,241 @@ bool SetPersistedDefaultEndpointForCurrentProcess(EDataFlow flow, const std::wst
     return true;
 }
 
+// Current-process session cache. WASAPI endpoint and session objects aggregate the free-threaded marshaler, so the
+// cached pointers are used from whichever thread calls the helpers (hotkeys, UI, volume sync, background monitor);
+// CoIncrementMTAUsage keeps COM loaded when those threads uninitialize. Callbacks only bump the cache generation and
+// stay registered for the process lifetime (the helpers run on detached threads until exit).
+AudioSessionCache& GetAudioSessionCache();
+
+class AudioSessionCacheNotifier final : public IMMNotificationClient,
+                                        public IAudioSessionNotification,
+                                        public IAudioSessionEvents {
+   public:
+    // Static instance: reference counting never frees it
+    ULONG STDMETHODCALLTYPE AddRef() override { return 1; }
+    ULONG STDMETHODCALLTYPE Release() override { return 1; }
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override {
+        if (ppv == nullptr) return E_POINTER;
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IMMNotificationClient)) {
+            *ppv = static_cast<IMMNotificationClient*>(this);
+        } else if (riid == __uuidof(IAudioSessionNotification)) {
+            *ppv = static_cast<IAudioSessionNotification*>(this);
+        } else if (riid == __uuidof(IAudioSessionEvents)) {
+            *ppv = static_cast<IAudioSessionEvents*>(this);
+        } else {
+            *ppv = nullptr;
+            return E_NOINTERFACE;
+        }
+        return S_OK;
+    }
+
+    // IMMNotificationClient
+    HRESULT STDMETHODCALLTYPE OnDeviceStateChanged(LPCWSTR /*device_id*/, DWORD /*new_state*/) override {
+        GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kDeviceStateChanged);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnDeviceAdded(LPCWSTR /*device_id*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnDeviceRemoved(LPCWSTR /*device_id*/) override {
+        GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kDeviceStateChanged);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnDefaultDeviceChanged(EDataFlow flow, ERole role, LPCWSTR /*device_id*/) override {
+        if (flow == eRender && role == eMultimedia) {
+            GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kDefaultDeviceChanged);
+        }
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnPropertyValueChanged(LPCWSTR /*device_id*/, const PROPERTYKEY /*key*/) override {
+        return S_OK;
+    }
+
+    // IAudioSessionNotification
+    HRESULT STDMETHODCALLTYPE OnSessionCreated(IAudioSessionControl* new_session) override {
+        // Other processes' sessions never affect ours; a new one of this process means the cached set is incomplete
+        Microsoft::WRL::ComPtr<IAudioSessionControl2> control2;
+        DWORD pid = 0;
+        if (new_session == nullptr || FAILED(new_session->QueryInterface(IID_PPV_ARGS(&control2)))
+            || control2->GetProcessId(&pid) != S_OK) {
+            // AUDCLNT_S_NO_SINGLE_PROCESS (cross-process session) or failure: owner unknown
+            GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kSessionCreatedUnknown);
+        } else if (pid == GetCurrentProcessId()) {
+            GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kSessionCreated);
+        }
+        return S_OK;
+    }
+
+    // IAudioSessionEvents (registered on the cached sessions)
+    HRESULT STDMETHODCALLTYPE OnDisplayNameChanged(LPCWSTR /*name*/, LPCGUID /*context*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnIconPathChanged(LPCWSTR /*path*/, LPCGUID /*context*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnSimpleVolumeChanged(float /*volume*/, BOOL /*mute*/, LPCGUID /*context*/) override {
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnChannelVolumeChanged(DWORD /*count*/, float* /*volumes*/, DWORD /*changed*/,
+                                                     LPCGUID /*context*/) override {
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnGroupingParamChanged(LPCGUID /*param*/, LPCGUID /*context*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnStateChanged(AudioSessionState state) override {
+        if (state == AudioSessionStateExpired) {
+            GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kSessionExpired);
+        }
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnSessionDisconnected(AudioSessionDisconnectReason /*reason*/) override {
+        GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kSessionDisconnected);
+        return S_OK;
+    }
+};
+
+AudioSessionCacheNotifier g_audio_session_notifier;
+
+// All sessions of the current process on the default render endpoint (a game can own more than one).
+struct WasapiProcessSessions final : AudioSessionHandle {
+    struct Session {
+        Microsoft::WRL::ComPtr<IAudioSessionControl> control;
+        Microsoft::WRL::ComPtr<ISimpleAudioVolume> simple_volume;
+        bool events_registered = false;
+    };
+
+    Microsoft::WRL::ComPtr<IMMDevice> device;
+    std::vector<Session> sessions;
+
+    ~WasapiProcessSessions() override {
+        for (Session& session : sessions) {
+            if (session.events_registered) {
+                session.control->UnregisterAudioSessionNotification(&g_audio_session_notifier);
+            }
+        }
+    }
+};
+
+class WasapiAudioSessionSource final : public IAudioSessionSource {
+   public:
+    // Runs under the cache lock on a thread with COM initialized.
+    std::shared_ptr<AudioSessionHandle> OpenProcessSession() override {
+        if (!EnsureEnumerator()) {
+            return nullptr;
+        }
+        auto result = std::make_shared<WasapiProcessSessions>();
+        HRESULT hr = enumerator_->GetDefaultAudioEndpoint(eRender, eMultimedia, &result->device);
+        if (FAILED(hr) || result->device == nullptr) {
+            return nullptr;
+        }
+        if (!EnsureSessionManager(result->device.Get())) {
+            return nullptr;
+        }
+        // Also required for OnSessionCreated to be delivered
+        Microsoft::WRL::ComPtr<IAudioSessionEnumerator> session_enumerator;
+        hr = session_manager_->GetSessionEnumerator(&session_enumerator);
+        if (FAILED(hr) || session_enumerator == nullptr) {
+            return nullptr;
+        }
+
+        const DWORD target_pid = GetCurrentProcessId();
+        int count = 0;
+        session_enumerator->GetCount(&count);
+        for (int i = 0; i < count; ++i) {
+            WasapiProcessSessions::Session session;
+            if (FAILED(session_enumerator->GetSession(i, &session.control)) || session.control == nullptr) continue;
+            Microsoft::WRL::ComPtr<IAudioSessionControl2> session_control2;
+            DWORD pid = 0;
+            if (FAILED(session.control.As(&session_control2)) || FAILED(session_control2->GetProcessId(&pid))
+                || pid != target_pid) {
+                continue;
+            }
+            if (FAILED(session.control.As(&session.simple_volume))) continue;
+            session.events_registered =
+                SUCCEEDED(session.control->RegisterAudioSessionNotification(&g_audio_session_notifier));
+            result->sessions.push_back(std::move(session));
+        }
+        if (result->sessions.empty()) {
+            return nullptr;
+        }
+        return result;
+    }
+
+   private:
+    bool EnsureEnumerator() {
+        if (enumerator_ != nullptr) {
+            return true;
+        }
+        CO_MTA_USAGE_COOKIE mta_cookie = nullptr;
+        if (FAILED(CoIncrementMTAUsage(&mta_cookie))) {
+            LogWarn("AudioSessionCache: CoIncrementMTAUsage failed");
+        }
+        HRESULT hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&enumerator_));
+        if (FAILED(hr) || enumerator_ == nullptr) {
+            enumerator_.Reset();
+            return false;
+        }
+        if (FAILED(enumerator_->RegisterEndpointNotificationCallback(&g_audio_session_notifier))) {
+            LogWarn("AudioSessionCache: RegisterEndpointNotificationCallback failed; relying on retries");
+        }
+        return true;
+    }
+
+    bool EnsureSessionManager(IMMDevice* device) {
+        LPWSTR id = nullptr;
+        std::wstring device_id;
+        if (SUCCEEDED(device->GetId(&id)) && id != nullptr) {
+            device_id.assign(id);
+            CoTaskMemFree(id);
+        }
+        if (session_manager_ != nullptr && device_id == session_manager_device_id_) {
+            return true;
+        }
+        if (session_manager_ != nullptr) {
+            session_manager_->UnregisterSessionNotification(&g_audio_session_notifier);
+            session_manager_.Reset();
+        }
+        HRESULT hr = device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, nullptr,
+                                      reinterpret_cast<void**>(session_manager_.GetAddressOf()));
+        if (FAILED(hr) || session_manager_ == nullptr) {
+            session_manager_.Reset();
+            return false;
+        }
+        if (FAILED(session_manager_->RegisterSessionNotification(&g_audio_session_notifier))) {
+            LogWarn("AudioSessionCache: RegisterSessionNotification failed; relying on retries");
+        }
+        session_manager_device_id_ = std::move(device_id);
+        return true;
+    }
+
+    Microsoft::WRL::ComPtr<IMMDeviceEnumerator> enumerator_;
+    Microsoft::WRL::ComPtr<IAudioSessionManager2> session_manager_;
+    std::wstring session_manager_device_id_;
+};
+
+// Never destroyed: releasing the sessions from static destructors would call into COM during DLL unload
+AudioSessionCache& GetAudioSessionCache() {
+    static AudioSessionCache* s_cache = new AudioSessionCache(*new WasapiAudioSessionSource());
+    return *s_cache;
+}
+
+std::shared_ptr<WasapiProcessSessions> AcquireProcessAudioSessions() {
+    return std::static_pointer_cast<WasapiProcessSessions>(GetAudioSessionCache().Acquire(utils::get_now_ns()));
+}
+
+// Runs fn on the cached sessions of this process; on failure drops the cache and retries once with a fresh lookup
+// (covers a device invalidated before its notification arrived). COM must be initialized on the calling thread.
+template <typename Fn>
+bool WithProcessAudioSessions(Fn&& fn) {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const std::shared_ptr<WasapiProcessSessions> sessions = AcquireProcessAudioSessions();
+        if (sessions == nullptr) {
+            return false;
+        }
+        if (SUCCEEDED(fn(*sessions))) {
+            return true;
+        }
+        GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kCallFailed);
+    }
+    return false;
+}
+
 }  // namespace
 
 bool SetMuteForCurrentProcess(bool mute, bool trigger_notification) {
-    const DWORD target_pid = GetCurrentProcessId();
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
     const bool did_init = SUCCEEDED(hr);
     if (!did_init && hr != RPC_E_CHANGED_MODE) {
@@ -260,49 +498,14 @@ bool SetMuteForCurrentProcess(bool mute, bool trigger_notification) {
         return false;
     }
 
-    bool success = false;
-    IMMDeviceEnumerator* device_enumerator = nullptr;
-    IMMDevice* device = nullptr;
-    IAudioSessionManager2* session_manager = nullptr;
-    IAudioSessionEnumerator* session_enumerator = nullptr;
-
-    do {
-        hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&device_enumerator));
-        if (FAILED(hr) || device_enumerator == nullptr) break;
-        hr = device_enumerator->GetDefaultAudioEndpoint(eRender, eMultimedia, &device);
-        if (FAILED(hr) || device == nullptr) break;
-        hr = device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, nullptr,
-                              reinterpret_cast<void**>(&session_manager));
-        if (FAILED(hr) || session_manager == nullptr) break;
-        hr = session_manager->GetSessionEnumerator(&session_enumerator);
-        if (FAILED(hr) || session_enumerator == nullptr) break;
-        int count = 0;
-        session_enumerator->GetCount(&count);
-        for (int i = 0; i < count; ++i) {
-            IAudioSessionControl* session_control = nullptr;
-            if (FAILED(session_enumerator->GetSession(i, &session_control)) || session_control == nullptr) continue;
-            Microsoft::WRL::ComPtr<IAudioSessionControl2> session_control2 = nullptr;
-            if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&session_control2)))
-                && session_control2 != nullptr) {
-                DWORD pid = 0;
-                session_control2->GetProcessId(&pid);
-                if (pid == target_pid) {
-                    Microsoft::WRL::ComPtr<ISimpleAudioVolume> simple_volume;
-                    if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&simple_volume)))
-                        && simple_volume != nullptr) {
-                        simple_volume->SetMute(mute ? TRUE : FALSE, nullptr);
-                        success = true;
-                    }
-                }
-            }
-            session_control->Release();
+    const bool success = WithProcessAudioSessions([mute](const WasapiProcessSessions& process_sessions) {
+        for (const WasapiProcessSessions::Session& session : process_sessions.sessions) {
+            const HRESULT hr_set = session.simple_volume->SetMute(mute ? TRUE : FALSE, nullptr);
+            if (FAILED(hr_set)) return hr_set;
         }
-    } while (false);
+        return S_OK;
+    });
 
-    if (session_enumerator != nullptr) session_enumerator->Release();
-    if (session_manager != nullptr) session_manager->Release();
-    if (device != nullptr) device->Release();
-    if (device_enumerator != nullptr) device_enumerator->Release();
     if (did_init && hr != RPC_E_CHANGED_MODE) CoUninitialize();
 
     std::ostringstream oss;
@@ -322,7 +525,315 @@ bool SetMuteForCurrentProcess(bool mute, bool trigger_notification) {
     return success;
 }
 
-bool IsOtherAppPlayingAudio() {
+bool GetCachedAudioSessionControlForCurrentProcess(unsigned int index, IAudioSessionControl** control_out) {
+    if (control_out == nullptr) {
+        return false;
+    }
+    *control_out = nullptr;
+    const std::shared_ptr<WasapiProcessSessions> process_sessions = AcquireProcessAudioSessions();
+    if (process_sessions == nullptr || index >= process_sessions->sessions.size()) {
+        return false;
+    }
+    return SUCCEEDED(process_sessions->sessions[index].control.CopyTo(control_out));
+}
+
+namespace {
+
+// Other-app audio detection for "mute in background only if other app has audio". Session state and volume arrive
+// through IAudioSessionEvents; the background monitor thread only reads meter peaks of the sessions the detector
+// reports as active and audible, instead of walking every session on a timer. Never destroyed: session callbacks can
+// still arrive while the DLL unloads.
+OtherAudioDetector& g_other_audio_detector = *new OtherAudioDetector();
+
+class OtherAudioSessionSink final : public IAudioSessionEvents {
+   public:
+    explicit OtherAudioSessionSink(uint64_t key) : key_(key) {}
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return InterlockedIncrement(&ref_count_); }
+    ULONG STDMETHODCALLTYPE Release() override {
+        const ULONG ref_count = InterlockedDecrement(&ref_count_);
+        if (ref_count == 0) {
+            delete this;
+        }
+        return ref_count;
+    }
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override {
+        if (ppv == nullptr) return E_POINTER;
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IAudioSessionEvents)) {
+            *ppv = static_cast<IAudioSessionEvents*>(this);
+            AddRef();
+            return S_OK;
+        }
+        *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnDisplayNameChanged(LPCWSTR /*name*/, LPCGUID /*context*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnIconPathChanged(LPCWSTR /*path*/, LPCGUID /*context*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnSimpleVolumeChanged(float volume, BOOL mute, LPCGUID /*context*/) override {
+        g_other_audio_detector.OnSessionVolumeChanged(key_, mute == FALSE && volume > 0.001f);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnChannelVolumeChanged(DWORD /*count*/, float* /*volumes*/, DWORD /*changed*/,
+                                                     LPCGUID /*context*/) override {
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnGroupingParamChanged(LPCGUID /*param*/, LPCGUID /*context*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnStateChanged(AudioSessionState state) override {
+        if (state == AudioSessionStateExpired) {
+            MarkEnded();
+        } else {
+            g_other_audio_detector.OnSessionStateChanged(key_, state == AudioSessionStateActive);
+        }
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnSessionDisconnected(AudioSessionDisconnectReason /*reason*/) override {
+        MarkEnded();
+        return S_OK;
+    }
+
+    // Ended sessions are unregistered by the monitor thread (unregistering from a callback deadlocks).
+    bool HasEnded() const { return ended_.load(std::memory_order_acquire); }
+
+   private:
+    void MarkEnded() {
+        ended_.store(true, std::memory_order_release);
+        g_other_audio_detector.OnSessionRemoved(key_);
+    }
+
+    LONG ref_count_ = 1;
+    const uint64_t key_;
+    std::atomic<bool> ended_{false};
+};
+
+// Owned by the background monitor thread; callbacks only queue work for it.
+class OtherAudioSessionWatcher final : public IMMNotificationClient, public IAudioSessionNotification {
+   public:
+    static constexpr int64_t kRebuildRetryNs = 2'000'000'000;
+
+    // Static instance: reference counting never frees it
+    ULONG STDMETHODCALLTYPE AddRef() override { return 1; }
+    ULONG STDMETHODCALLTYPE Release() override { return 1; }
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppv) override {
+        if (ppv == nullptr) return E_POINTER;
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IMMNotificationClient)) {
+            *ppv = static_cast<IMMNotificationClient*>(this);
+        } else if (riid == __uuidof(IAudioSessionNotification)) {
+            *ppv = static_cast<IAudioSessionNotification*>(this);
+        } else {
+            *ppv = nullptr;
+            return E_NOINTERFACE;
+        }
+        return S_OK;
+    }
+
+    // IMMNotificationClient
+    HRESULT STDMETHODCALLTYPE OnDeviceStateChanged(LPCWSTR /*device_id*/, DWORD /*new_state*/) override {
+        rebuild_.store(true, std::memory_order_release);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnDeviceAdded(LPCWSTR /*device_id*/) override { return S_OK; }
+    HRESULT STDMETHODCALLTYPE OnDeviceRemoved(LPCWSTR /*device_id*/) override {
+        rebuild_.store(true, std::memory_order_release);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnDefaultDeviceChanged(EDataFlow flow, ERole role, LPCWSTR /*device_id*/) override {
+        if (flow == eRender && role == eMultimedia) {
+            rebuild_.store(true, std::memory_order_release);
+        }
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE OnPropertyValueChanged(LPCWSTR /*device_id*/, const PROPERTYKEY /*key*/) override {
+        return S_OK;
+    }
+
+    // IAudioSessionNotification
+    HRESULT STDMETHODCALLTYPE OnSessionCreated(IAudioSessionControl* new_session) override {
+        if (new_session != nullptr) {
+            new_session->AddRef();
+            utils::SRWLockExclusive guard(pending_lock_);
+            pending_.push_back(new_session);
+        }
+        return S_OK;
+    }
+
+    // Monitor thread (COM initialized). Binds to the default endpoint on first use; returns the debounced decision.
+    bool Update(int64_t now_ns) {
+        if (rebuild_.load(std::memory_order_acquire) && now_ns - last_rebuild_attempt_ns_ >= kRebuildRetryNs) {
+            rebuild_.store(false, std::memory_order_release);
+            last_rebuild_attempt_ns_ = now_ns;
+            if (!Rebuild()) {
+                rebuild_.store(true, std::memory_order_release);
+            }
+        }
+        started_.store(true, std::memory_order_release);
+        TrackPending();
+        PruneEnded();
+        return g_other_audio_detector.Update(now_ns, [this](uint64_t key, float* peak_out) {
+            auto it = sessions_.find(key);
+            return it != sessions_.end() && it->second.meter != nullptr
+                   && SUCCEEDED(it->second.meter->GetPeakValue(peak_out));
+        });
+    }
+
+    bool IsStarted() const { return started_.load(std::memory_order_acquire); }
+
+   private:
+    struct TrackedSession {
+        Microsoft::WRL::ComPtr<IAudioSessionControl> control;
+        Microsoft::WRL::ComPtr<IAudioMeterInformation> meter;  // Session peak (QueryInterface on the control)
+        Microsoft::WRL::ComPtr<OtherAudioSessionSink> sink;
+        std::wstring instance_id;
+    };
+
+    bool Rebuild() {
+        for (auto& [key, tracked] : sessions_) {
+            tracked.control->UnregisterAudioSessionNotification(tracked.sink.Get());
+        }
+        sessions_.clear();
+        g_other_audio_detector.ClearSessions();
+        if (session_manager_ != nullptr) {
+            session_manager_->UnregisterSessionNotification(this);
+            session_manager_.Reset();
+        }
+
+        if (enumerator_ == nullptr) {
+            HRESULT hr =
+                CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&enumerator_));
+            if (FAILED(hr) || enumerator_ == nullptr) {
+                enumerator_.Reset();
+                return false;
+            }
+            enumerator_->RegisterEndpointNotificationCallback(this);
+        }
+        Microsoft::WRL::ComPtr<IMMDevice> device;
+        HRESULT hr = enumerator_->GetDefaultAudioEndpoint(eRender, eMultimedia, &device);
+        if (FAILED(hr) || device == nullptr) return false;
+        hr = device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, nullptr,
+                              reinterpret_cast<void**>(session_manager_.GetAddressOf()));
+        if (FAILED(hr) || session_manager_ == nullptr) {
+            session_manager_.Reset();
+            return false;
+        }
+        // Register before enumerating so no session falls in between (duplicates are skipped in Track)
+        session_manager_->RegisterSessionNotification(this);
+        Microsoft::WRL::ComPtr<IAudioSessionEnumerator> session_enumerator;
+        hr = session_manager_->GetSessionEnumerator(&session_enumerator);
+        if (FAILED(hr) || session_enumerator == nullptr) return false;
+        int count = 0;
+        session_enumerator->GetCount(&count);
+        for (int i = 0; i < count; ++i) {
+            Microsoft::WRL::ComPtr<IAudioSessionControl> control;
+            if (SUCCEEDED(session_enumerator->GetSession(i, &control)) && control != nullptr) {
+                Track(control.Get());
+            }
+        }
+        LogInfo("BackgroundAudio: watching %zu other-app audio sessions", sessions_.size());
+        return true;
+    }
+
+    void Track(IAudioSessionControl* control) {
+        Microsoft::WRL::ComPtr<IAudioSessionControl2> control2;
+        DWORD pid = 0;
+        if (FAILED(control->QueryInterface(IID_PPV_ARGS(&control2))) || FAILED(control2->GetProcessId(&pid))
+            || pid == 0 || pid == GetCurrentProcessId()) {
+            return;
+        }
+        LPWSTR instance_id_raw = nullptr;
+        std::wstring instance_id;
+        if (SUCCEEDED(control2->GetSessionInstanceIdentifier(&instance_id_raw)) && instance_id_raw != nullptr) {
+            instance_id.assign(instance_id_raw);
+            CoTaskMemFree(instance_id_raw);
+        }
+        for (const auto& [key, tracked] : sessions_) {
+            if (!instance_id.empty() && tracked.instance_id == instance_id) return;
+        }
+
+        TrackedSession tracked;
+        tracked.control = control;
+        tracked.instance_id = std::move(instance_id);
+        control->QueryInterface(IID_PPV_ARGS(&tracked.meter));
+        const uint64_t key = next_key_++;
+        tracked.sink.Attach(new OtherAudioSessionSink(key));
+
+        // Add, register, then refresh: a change between the first read and registration is not lost
+        g_other_audio_detector.OnSessionAdded(key, IsSessionActive(control), IsSessionAudible(control));
+        if (FAILED(control->RegisterAudioSessionNotification(tracked.sink.Get()))) {
+            g_other_audio_detector.OnSessionRemoved(key);
+            return;
+        }
+        g_other_audio_detector.OnSessionStateChanged(key, IsSessionActive(control));
+        g_other_audio_detector.OnSessionVolumeChanged(key, IsSessionAudible(control));
+        sessions_.emplace(key, std::move(tracked));
+    }
+
+    void TrackPending() {
+        std::vector<IAudioSessionControl*> pending;
+        {
+            utils::SRWLockExclusive guard(pending_lock_);
+            pending.swap(pending_);
+        }
+        for (IAudioSessionControl* control : pending) {
+            if (session_manager_ != nullptr) {
+                Track(control);
+            }
+            control->Release();
+        }
+    }
+
+    void PruneEnded() {
+        for (auto it = sessions_.begin(); it != sessions_.end();) {
+            if (it->second.sink->HasEnded()) {
+                it->second.control->UnregisterAudioSessionNotification(it->second.sink.Get());
+                it = sessions_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    static bool IsSessionActive(IAudioSessionControl* control) {
+        AudioSessionState state{};
+        return SUCCEEDED(control->GetState(&state)) && state == AudioSessionStateActive;
+    }
+
+    static bool IsSessionAudible(IAudioSessionControl* control) {
+        Microsoft::WRL::ComPtr<ISimpleAudioVolume> simple_volume;
+        float volume = 0.0f;
+        BOOL muted = FALSE;
+        return SUCCEEDED(control->QueryInterface(IID_PPV_ARGS(&simple_volume)))
+               && SUCCEEDED(simple_volume->GetMasterVolume(&volume)) && SUCCEEDED(simple_volume->GetMute(&muted))
+               && muted == FALSE && volume > 0.001f;
+    }
+
+    Microsoft::WRL::ComPtr<IMMDeviceEnumerator> enumerator_;
+    Microsoft::WRL::ComPtr<IAudioSessionManager2> session_manager_;
+    std::unordered_map<uint64_t, TrackedSession> sessions_;
+    uint64_t next_key_ = 1;
+    int64_t last_rebuild_attempt_ns_ = 0;
+    std::atomic<bool> started_{false};
+    std::atomic<bool> rebuild_{true};
+    SRWLOCK pending_lock_ = SRWLOCK_INIT;
+    std::vector<IAudioSessionControl*> pending_;  // AddRef'ed in OnSessionCreated
+};
+
+// Never destroyed: it stays registered with WASAPI for the process lifetime
+OtherAudioSessionWatcher& GetOtherAudioSessionWatcher() {
+    static OtherAudioSessionWatcher* s_watcher = new OtherAudioSessionWatcher();
+    return *s_watcher;
+}
+
+// Background monitor thread only.
+bool UpdateOtherAppAudioDetection() {
+    OtherAudioDetectorConfig config;
+    config.hold_ns =
+        static_cast<int64_t>(settings::g_mainTabSettings.mute_in_background_other_audio_hold_ms.GetValue()) * 1'000'000;
+    g_other_audio_detector.SetConfig(config);
+    return GetOtherAudioSessionWatcher().Update(utils::get_now_ns());
+}
+
+// One-shot walk for callers before the monitor thread has started the watcher.
+bool IsOtherAppSessionActiveOneShot() {
     const DWORD target_pid = GetCurrentProcessId();
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
     const bool did_init = SUCCEEDED(hr);
@@ -389,10 +900,26 @@ bool IsOtherAppPlayingAudio() {
     return other_active;
 }
 
+}  // namespace
+
+bool IsOtherAppPlayingAudio() {
+    if (GetOtherAudioSessionWatcher().IsStarted()) {
+        return g_other_audio_detector.IsPlaying();
+    }
+    return IsOtherAppSessionActiveOneShot();
+}
+
+bool GetOtherAppAudioStats(OtherAudioDetectorStats* stats_out) {
+    if (stats_out == nullptr || !GetOtherAudioSessionWatcher().IsStarted()) {
+        return false;
+    }
+    *stats_out = g_other_audio_detector.GetStats();
+    return true;
+}
+
 bool SetVolumeForCurrentProcess(float volume_0_100) {
     float clamped = (std::max)(0.0f, (std::min)(volume_0_100, 100.0f));
     const float scalar = clamped / 100.0f;
-    const DWORD target_pid = GetCurrentProcessId();
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
     const bool did_init = SUCCEEDED(hr);
     if (!did_init && hr != RPC_E_CHANGED_MODE) {
@@ -400,47 +927,14 @@ bool SetVolumeForCurrentProcess(float volume_0_100) {
         return false;
     }
 
-    bool success = false;
-    IMMDeviceEnumerator* device_enumerator = nullptr;
-    IMMDevice* device = nullptr;
-    IAudioSessionManager2* session_manager = nullptr;
-    IAudioSessionEnumerator* session_enumerator = nullptr;
-
-    do {
-        hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&device_enumerator));
-        if (FAILED(hr) || device_enumerator == nullptr) break;
-        hr = device_enumerator->GetDefaultAudioEndpoint(eRender, eMultimedia, &device);
-        if (FAILED(hr) || device == nullptr) break;
-        hr = device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, nullptr,
-                              reinterpret_cast<void**>(&session_manager));
-        if (FAILED(hr) || session_manager == nullptr) break;
-        hr = session_manager->GetSessionEnumerator(&session_enumerator);
-        if (FAILED(hr) || session_enumerator == nullptr) break;
-        int count = 0;
-        session_enumerator->GetCount(&count);
-        for (int i = 0; i < count; ++i) {
-            IAudioSessionControl* session_control = nullptr;
-            if (FAILED(session_enumerator->GetSession(i, &session_control))) continue;
-            Microsoft::WRL::ComPtr<IAudioSessionControl2> session_control2{};
-            if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&session_control2)))) {
-                DWORD pid = 0;
-                session_control2->GetProcessId(&pid);
-                if (pid == target_pid) {
-                    Microsoft::WRL::ComPtr<ISimpleAudioVolume> simple_volume{};
-                    if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&simple_volume)))) {
-                        simple_volume->SetMasterVolume(scalar, nullptr);
-                        success = true;
-                    }
-                }
-            }
-            session_control->Release();
+    const bool success = WithProcessAudioSessions([scalar](const WasapiProcessSessions& process_sessions) {
+        for (const WasapiProcessSessions::Session& session : process_sessions.sessions) {
+            const HRESULT hr_set = session.simple_volume->SetMasterVolume(scalar, nullptr);
+            if (FAILED(hr_set)) return hr_set;
         }
-    } while (false);
+        return S_OK;
+    });
 
-    if (session_enumerator != nullptr) session_enumerator->Release();
-    if (session_manager != nullptr) session_manager->Release();
-    if (device != nullptr) device->Release();
-    if (device_enumerator != nullptr) device_enumerator->Release();
     if (did_init && hr != RPC_E_CHANGED_MODE) CoUninitialize();
 
     std::ostringstream oss;
@@ -457,7 +951,6 @@ bool GetVolumeForCurrentProcess(float* volume_0_100_out) {
         return false;
     }
 
-    const DWORD target_pid = GetCurrentProcessId();
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
     const bool did_init = SUCCEEDED(hr);
     if (!did_init && hr != RPC_E_CHANGED_MODE) {
@@ -465,50 +958,15 @@ bool GetVolumeForCurrentProcess(float* volume_0_100_out) {
         return false;
     }
 
-    bool success = false;
-    IMMDeviceEnumerator* device_enumerator = nullptr;
-    IMMDevice* device = nullptr;
-    IAudioSessionManager2* session_manager = nullptr;
-    IAudioSessionEnumerator* session_enumerator = nullptr;
-
-    do {
-        hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&device_enumerator));
-        if (FAILED(hr) || device_enumerator == nullptr) break;
-        hr = device_enumerator->GetDefaultAudioEndpoint(eRender, eMultimedia, &device);
-        if (FAILED(hr) || device == nullptr) break;
-        hr = device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, nullptr,
-                              reinterpret_cast<void**>(&session_manager));
-        if (FAILED(hr) || session_manager == nullptr) break;
-        hr = session_manager->GetSessionEnumerator(&session_enumerator);
-        if (FAILED(hr) || session_enumerator == nullptr) break;
-        int count = 0;
-        session_enumerator->GetCount(&count);
-        for (int i = 0; i < count; ++i) {
-            IAudioSessionControl* session_control = nullptr;
-            if (FAILED(session_enumerator->GetSession(i, &session_control))) continue;
-            Microsoft::WRL::ComPtr<IAudioSessionControl2> session_control2{};
-            if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&session_control2)))) {
-                DWORD pid = 0;
-                session_control2->GetProcessId(&pid);
-                if (pid == target_pid) {
-                    Microsoft::WRL::ComPtr<ISimpleAudioVolume> simple_volume{};
-                    if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&simple_volume)))) {
-                        float scalar = 0.0f;
-                        if (SUCCEEDED(simple_volume->GetMasterVolume(&scalar))) {
-                            *volume_0_100_out = scalar * 100.0f;
-                            success = true;
-                        }
-                    }
-                }
-            }
-            session_control->Release();
+    const bool success = WithProcessAudioSessions([volume_0_100_out](const WasapiProcessSessions& process_sessions) {
+        float scalar = 0.0f;
+        const HRESULT hr_get = process_sessions.sessions.front().simple_volume->GetMasterVolume(&scalar);
+        if (SUCCEEDED(hr_get)) {
+            *volume_0_100_out = scalar * 100.0f;
         }
-    } while (false);
+        return hr_get;
+    });
 
-    if (session_enumerator != nullptr) session_enumerator->Release();
-    if (session_manager != nullptr) session_manager->Release();
-    if (device != nullptr) device->Release();
-    if (device_enumerator != nullptr) device_enumerator->Release();
     if (did_init && hr != RPC_E_CHANGED_MODE) CoUninitialize();
 
     return success;
@@ -678,6 +1136,7 @@ bool SetAudioOutputDeviceForCurrentProcess(const std::wstring& device_id) {
     }
 
     const bool ok = SetPersistedDefaultEndpointForCurrentProcess(eRender, full_id);
+    GetAudioSessionCache().Invalidate(AudioSessionInvalidation::kOutputDeviceOverride);
 
     std::ostringstream oss;
     oss << "AudioOutputDevice: "
@@ -695,8 +1154,12 @@ void RunBackgroundAudioMonitor() {
 
     LogInfo("BackgroundAudio: Continuous monitoring ready, starting audio management");
 
+    // COM stays initialized for the thread's lifetime: the other-app audio watcher keeps its sessions here
+    const HRESULT hr_com = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
     while (!g_shutdown.load()) {
         bool want_mute = false;
+        bool detecting_other_audio = false;
 
         // Check if manual mute is enabled - if so, always mute regardless of background state
         if (settings::g_mainTabSettings.audio_mute.GetValue()) {
@@ -723,8 +1186,9 @@ void RunBackgroundAudioMonitor() {
 
             if (is_background) {
                 if (settings::g_mainTabSettings.mute_in_background_if_other_audio.GetValue()) {
-                    // Only mute if some other app is outputting audio
-                    want_mute = IsOtherAppPlayingAudio();
+                    // Only mute if some other app is outputting audio (debounced, see OtherAudioDetector)
+                    want_mute = UpdateOtherAppAudioDetection();
+                    detecting_other_audio = true;
                 } else {
                     want_mute = true;
                 }
@@ -746,8 +1210,17 @@ void RunBackgroundAudioMonitor() {
             }
         }
 
+        if (!detecting_other_audio) {
+            g_other_audio_detector.ResetHysteresis();
+        }
+
         // Background FPS limit handling moved to fps_limiter module
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        // Peaks are sampled faster than the mute decision so the attack / hold times have a few samples
+        std::this_thread::sleep_for(std::chrono::milliseconds(detecting_other_audio ? 100 : 300));
+    }
+
+    if (SUCCEEDED(hr_com)) {
+        CoUninitialize();
     }
 }
 
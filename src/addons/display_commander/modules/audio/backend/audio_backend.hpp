@@ -1,6 +1,8 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #pragma once
 
+#include "other_audio_detector.hpp"
+
 // Libraries <Windows.h>
 #include <windows.h>
 
@@ -8,14 +10,20 @@
 #include <string>
 #include <vector>
 
+struct IAudioSessionControl;
+
 // Audio management functions
 bool SetMuteForCurrentProcess(bool mute, bool trigger_notification = true);
 bool SetVolumeForCurrentProcess(float volume_0_100);
 bool GetVolumeForCurrentProcess(float* volume_0_100_out);
 bool AdjustVolumeForCurrentProcess(float percent_change);
 void RunBackgroundAudioMonitor();
-// Returns true if any other process has an active, unmuted session with volume > 0
+// Returns true if any other process is playing audio. Once RunBackgroundAudioMonitor samples it (game in background,
+// "only if other app has audio" enabled) this is the debounced, event-driven decision; before that a one-shot walk of
+// active, unmuted sessions with volume > 0.
 bool IsOtherAppPlayingAudio();
+// Detector state for the UI; false until the background monitor has started watching sessions.
+bool GetOtherAppAudioStats(OtherAudioDetectorStats* stats_out);
 
 // System volume management functions (master volume for the audio endpoint)
 bool SetSystemVolume(float volume_0_100);
@@ -33,6 +41,10 @@ bool GetAudioOutputDevices(std::vector<std::string>& device_names_utf8, std::vec
 // Pass empty device_id to clear override and use system default.
 bool SetAudioOutputDeviceForCurrentProcess(const std::wstring& device_id);
 
+// Cached session of the current process on the default render endpoint (a process can own several; index from 0).
+// Returns an AddRef'ed control, false past the last session. COM must be initialized on the calling thread.
+bool GetCachedAudioSessionControlForCurrentProcess(unsigned int index, IAudioSessionControl** control_out);
+
 // Per-channel (e.g. left/right speaker) volume for the current process.
 // Only available when the session supports IChannelAudioVolume (typically stereo or more).
 bool GetChannelVolumeCountForCurrentProcess(unsigned int* channel_count_out);
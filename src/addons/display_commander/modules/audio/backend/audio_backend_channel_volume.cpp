@@ -19,7 +19,6 @@ bool GetChannelVolumeControlForCurrentProcess(IChannelAudioVolume** out_volume,
     *out_volume = nullptr;
     *out_count = 0;
 
-    const DWORD target_pid = GetCurrentProcessId();
     HRESULT hr = S_OK;
     bool did_init = false;
     if (!assume_com_initialized) {
@@ -31,54 +30,22 @@ bool GetChannelVolumeControlForCurrentProcess(IChannelAudioVolume** out_volume,
         }
     }
 
+    // Sessions come from the cache in audio_backend.cpp (no device / session enumeration per call)
     bool success = false;
-    IMMDeviceEnumerator* device_enumerator = nullptr;
-    IMMDevice* device = nullptr;
-    IAudioSessionManager2* session_manager = nullptr;
-    IAudioSessionEnumerator* session_enumerator = nullptr;
-
-    do {
-        hr = CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&device_enumerator));
-        if (FAILED(hr) || device_enumerator == nullptr) break;
-        hr = device_enumerator->GetDefaultAudioEndpoint(eRender, eMultimedia, &device);
-        if (FAILED(hr) || device == nullptr) break;
-        hr = device->Activate(__uuidof(IAudioSessionManager2), CLSCTX_ALL, nullptr,
-                              reinterpret_cast<void**>(&session_manager));
-        if (FAILED(hr) || session_manager == nullptr) break;
-        hr = session_manager->GetSessionEnumerator(&session_enumerator);
-        if (FAILED(hr) || session_enumerator == nullptr) break;
-        int session_count = 0;
-        session_enumerator->GetCount(&session_count);
-        for (int i = 0; i < session_count; ++i) {
-            IAudioSessionControl* session_control = nullptr;
-            if (FAILED(session_enumerator->GetSession(i, &session_control)) || session_control == nullptr) continue;
-            Microsoft::WRL::ComPtr<IAudioSessionControl2> session_control2{};
-            if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&session_control2)))) {
-                DWORD pid = 0;
-                session_control2->GetProcessId(&pid);
-                if (pid == target_pid) {
-                    Microsoft::WRL::ComPtr<IChannelAudioVolume> channel_volume{};
-                    if (SUCCEEDED(session_control->QueryInterface(IID_PPV_ARGS(&channel_volume)))
-                        && channel_volume != nullptr) {
-                        UINT n = 0;
-                        if (SUCCEEDED(channel_volume->GetChannelCount(&n)) && n > 0) {
-                            *out_count = n;
-                            channel_volume->AddRef();
-                            *out_volume = channel_volume.Get();
-                            success = true;
-                        }
-                    }
-                }
+    for (unsigned int i = 0; !success; ++i) {
+        Microsoft::WRL::ComPtr<IAudioSessionControl> session_control;
+        if (!GetCachedAudioSessionControlForCurrentProcess(i, session_control.GetAddressOf())) break;
+        Microsoft::WRL::ComPtr<IChannelAudioVolume> channel_volume{};
+        if (SUCCEEDED(session_control.As(&channel_volume)) && channel_volume != nullptr) {
+            UINT n = 0;
+            if (SUCCEEDED(channel_volume->GetChannelCount(&n)) && n > 0) {
+                *out_count = n;
+                *out_volume = channel_volume.Detach();
+                success = true;
             }
-            session_control->Release();
-            if (success) break;
         }
-    } while (false);
+    }
 
-    if (session_enumerator != nullptr) session_enumerator->Release();
-    if (session_manager != nullptr) session_manager->Release();
-    if (device != nullptr) device->Release();
-    if (device_enumerator != nullptr) device_enumerator->Release();
     if (!assume_com_initialized && did_init && hr != RPC_E_CHANGED_MODE) CoUninitialize();
 
     return success;
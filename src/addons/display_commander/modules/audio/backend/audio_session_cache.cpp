@@ -0,0 +1,75 @@
+// Source Code <Display Commander> // Audio session cache core (platform-neutral, no Windows includes)
+#include "audio_session_cache.hpp"
+
+// Libraries <standard C++>
+#include <utility>
+
+const char* AudioSessionInvalidationName(AudioSessionInvalidation reason) {
+    switch (reason) {
+        case AudioSessionInvalidation::kDefaultDeviceChanged:  return "Default device changed";
+        case AudioSessionInvalidation::kDeviceStateChanged:    return "Device state changed";
+        case AudioSessionInvalidation::kSessionCreated:        return "Session created";
+        case AudioSessionInvalidation::kSessionCreatedUnknown: return "Session created (unknown process)";
+        case AudioSessionInvalidation::kSessionDisconnected:   return "Session disconnected";
+        case AudioSessionInvalidation::kSessionExpired:        return "Session expired";
+        case AudioSessionInvalidation::kOutputDeviceOverride:  return "Output device override";
+        case AudioSessionInvalidation::kCallFailed:            return "Call failed";
+        default:                                               return "Unknown";
+    }
+}
+
+std::shared_ptr<AudioSessionHandle> AudioSessionCache::Acquire(int64_t now_ns) {
+    std::shared_ptr<AudioSessionHandle> stale;  // Released after unlocking (unregisters callbacks)
+    std::shared_ptr<AudioSessionHandle> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint64_t generation = generation_.load(std::memory_order_acquire);
+        const uint64_t probe_generation = probe_generation_.load(std::memory_order_acquire);
+        if (cached_generation_ == generation) {
+            if (handle_ != nullptr) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return handle_;
+            }
+            if (cached_probe_generation_ == probe_generation && now_ns - miss_time_ns_ < miss_retry_ns_) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+
+        stale = std::move(handle_);
+        handle_ = source_.OpenProcessSession();
+        opens_.fetch_add(1, std::memory_order_relaxed);
+        if (handle_ == nullptr) {
+            open_misses_.fetch_add(1, std::memory_order_relaxed);
+            miss_time_ns_ = now_ns;
+        }
+        // Generations read before opening: an invalidation racing the open forces another open next time
+        cached_generation_ = generation;
+        cached_probe_generation_ = probe_generation;
+        has_session_.store(handle_ != nullptr, std::memory_order_relaxed);
+        result = handle_;
+    }
+    return result;
+}
+
+void AudioSessionCache::Invalidate(AudioSessionInvalidation reason) {
+    invalidations_[static_cast<size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    if (reason == AudioSessionInvalidation::kSessionCreatedUnknown) {
+        // Possibly another app's session: only interesting while ours is missing
+        probe_generation_.fetch_add(1, std::memory_order_acq_rel);
+    } else {
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+AudioSessionCacheStats AudioSessionCache::GetStats() const {
+    AudioSessionCacheStats s;
+    s.hits = hits_.load(std::memory_order_relaxed);
+    s.opens = opens_.load(std::memory_order_relaxed);
+    s.open_misses = open_misses_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kAudioSessionInvalidationCount; ++i) {
+        s.invalidations[i] = invalidations_[i].load(std::memory_order_relaxed);
+    }
+    s.has_session = has_session_.load(std::memory_order_relaxed);
+    return s;
+}
@@ -0,0 +1,86 @@
+// Source Code <Display Commander> // Audio session cache core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <standard C++>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Why a cached session was dropped (or a cached miss re-probed).
+enum class AudioSessionInvalidation : uint8_t {
+    kDefaultDeviceChanged = 0,  // IMMNotificationClient::OnDefaultDeviceChanged (render, multimedia)
+    kDeviceStateChanged,        // IMMNotificationClient::OnDeviceStateChanged / OnDeviceRemoved
+    kSessionCreated,            // IAudioSessionNotification::OnSessionCreated for this process (the cached set of
+                                // sessions is incomplete: a game can own more than one)
+    kSessionCreatedUnknown,     // OnSessionCreated whose process could not be determined (only re-probes a miss)
+    kSessionDisconnected,       // IAudioSessionEvents::OnSessionDisconnected
+    kSessionExpired,            // IAudioSessionEvents::OnStateChanged(AudioSessionStateExpired)
+    kOutputDeviceOverride,      // Per-process output device changed from the UI
+    kCallFailed,                // A call on the cached session failed (e.g. AUDCLNT_E_DEVICE_INVALIDATED)
+    kCount
+};
+inline constexpr size_t kAudioSessionInvalidationCount = static_cast<size_t>(AudioSessionInvalidation::kCount);
+
+const char* AudioSessionInvalidationName(AudioSessionInvalidation reason);
+
+// Opaque session handle; the source that created it knows the concrete type.
+struct AudioSessionHandle {
+    virtual ~AudioSessionHandle() = default;
+};
+
+// Resolves the current process's audio session (WASAPI in the addon, scripted fakes elsewhere).
+class IAudioSessionSource {
+   public:
+    virtual ~IAudioSessionSource() = default;
+    // nullptr when the process has no session yet (the game has not opened audio) or the lookup failed.
+    virtual std::shared_ptr<AudioSessionHandle> OpenProcessSession() = 0;
+};
+
+struct AudioSessionCacheStats {
+    uint64_t hits = 0;         // Acquire served from the cache (session or remembered miss)
+    uint64_t opens = 0;        // Source lookups
+    uint64_t open_misses = 0;  // Lookups that found no session
+    std::array<uint64_t, kAudioSessionInvalidationCount> invalidations = {};
+    bool has_session = false;
+};
+
+// Keeps the session handle between calls so volume / mute helpers skip the device and session enumeration.
+// Notifications call Invalidate (lock-free, safe from WASAPI callback threads); the next Acquire reopens. A miss is
+// remembered until a session of this process (or of an unknown process) is created or miss_retry_ns passes, so a game
+// without audio is not re-enumerated on every hotkey press. Sessions of other processes are not reported.
+class AudioSessionCache {
+   public:
+    static constexpr int64_t kDefaultMissRetryNs = 2'000'000'000;
+
+    explicit AudioSessionCache(IAudioSessionSource& source, int64_t miss_retry_ns = kDefaultMissRetryNs)
+        : source_(source), miss_retry_ns_(miss_retry_ns) {}
+
+    std::shared_ptr<AudioSessionHandle> Acquire(int64_t now_ns);
+
+    // Any thread; never calls into the source.
+    void Invalidate(AudioSessionInvalidation reason);
+
+    AudioSessionCacheStats GetStats() const;
+
+   private:
+    IAudioSessionSource& source_;
+    const int64_t miss_retry_ns_;
+
+    std::atomic<uint64_t> generation_{1};        // Drops the cached session and any remembered miss
+    std::atomic<uint64_t> probe_generation_{1};  // Only re-probes a remembered miss
+
+    std::mutex mutex_;  // Serializes Acquire (the source is called under it)
+    std::shared_ptr<AudioSessionHandle> handle_;
+    uint64_t cached_generation_ = 0;
+    uint64_t cached_probe_generation_ = 0;
+    int64_t miss_time_ns_ = 0;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> opens_{0};
+    std::atomic<uint64_t> open_misses_{0};
+    std::array<std::atomic<uint64_t>, kAudioSessionInvalidationCount> invalidations_ = {};
+    std::atomic<bool> has_session_{false};
+};
@@ -0,0 +1,107 @@
+// Source Code <Display Commander> // Other-app audio detector core (platform-neutral, no Windows includes)
+#include "other_audio_detector.hpp"
+
+// Libraries <standard C++>
+#include <algorithm>
+
+void OtherAudioDetector::SetConfig(const OtherAudioDetectorConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+void OtherAudioDetector::OnSessionAdded(uint64_t key, bool active, bool audible) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_[key] = Session{active, audible};
+    ++session_events_;
+}
+
+void OtherAudioDetector::OnSessionStateChanged(uint64_t key, bool active) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+        it->second.active = active;
+    }
+    ++session_events_;
+}
+
+void OtherAudioDetector::OnSessionVolumeChanged(uint64_t key, bool audible) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+        it->second.audible = audible;
+    }
+    ++session_events_;
+}
+
+void OtherAudioDetector::OnSessionRemoved(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_.erase(key);
+    ++session_events_;
+}
+
+void OtherAudioDetector::ClearSessions() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_.clear();
+}
+
+bool OtherAudioDetector::Update(int64_t now_ns, const PeakReader& read_peak) {
+    OtherAudioDetectorConfig config;
+    sample_keys_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config = config_;
+        for (const auto& [key, session] : sessions_) {
+            if (session.active && session.audible) {
+                sample_keys_.push_back(key);
+            }
+        }
+    }
+
+    float max_peak = 0.0f;
+    for (uint64_t key : sample_keys_) {
+        float peak = 0.0f;
+        ++peak_reads_;
+        if (read_peak(key, &peak)) {
+            max_peak = (std::max)(max_peak, peak);
+        }
+    }
+    if (have_update_ && now_ns - last_update_ns_ > config.max_sample_gap_ns) {
+        ResetHysteresis();
+    }
+    last_update_ns_ = now_ns;
+
+    const bool raw = max_peak >= config.peak_threshold;
+    if (!have_update_ || raw != raw_) {
+        raw_ = raw;
+        raw_since_ns_ = now_ns;
+        have_update_ = true;
+    }
+    if (raw_ != playing_ && now_ns - raw_since_ns_ >= (raw_ ? config.attack_ns : config.hold_ns)) {
+        playing_ = raw_;
+        ++flips_;
+        playing_published_.store(playing_, std::memory_order_release);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    update_stats_.sampled_sessions = sample_keys_.size();
+    update_stats_.max_peak = max_peak;
+    update_stats_.peak_reads = peak_reads_;
+    update_stats_.flips = flips_;
+    return playing_;
+}
+
+void OtherAudioDetector::ResetHysteresis() {
+    playing_ = false;
+    raw_ = false;
+    have_update_ = false;
+    playing_published_.store(false, std::memory_order_release);
+}
+
+OtherAudioDetectorStats OtherAudioDetector::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    OtherAudioDetectorStats s = update_stats_;
+    s.sessions = sessions_.size();
+    s.session_events = session_events_;
+    s.playing = IsPlaying();
+    return s;
+}
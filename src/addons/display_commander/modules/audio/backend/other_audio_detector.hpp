@@ -0,0 +1,84 @@
+// Source Code <Display Commander> // Other-app audio detector core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <standard C++>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct OtherAudioDetectorConfig {
+    float peak_threshold = 0.01f;               // Meter peak (0..1) that counts as audible, about -40 dBFS
+    int64_t attack_ns = 400'000'000;            // Audible this long before reporting "playing"
+    int64_t hold_ns = 2'000'000'000;            // Silent this long before reporting "not playing"
+    int64_t max_sample_gap_ns = 1'000'000'000;  // Longer gaps between updates restart the hysteresis
+};
+
+struct OtherAudioDetectorStats {
+    size_t sessions = 0;          // Tracked sessions of other processes
+    size_t sampled_sessions = 0;  // Active, unmuted, volume > 0: the only ones whose peak is read
+    float max_peak = 0.0f;        // Loudest sampled peak of the last update
+    uint64_t peak_reads = 0;
+    uint64_t session_events = 0;
+    uint64_t flips = 0;           // Debounced decision changes
+    bool playing = false;
+};
+
+// Decides whether another process is playing audio. Session state comes from events (IAudioSessionEvents in the
+// addon); only sessions that are active and audible get their meter peak read, so an idle system costs nothing per
+// update. The peak signal goes through attack / hold hysteresis so a transient (notification sound, a click) does not
+// flip background muting.
+//
+// Event methods may be called from any thread (WASAPI callback threads); Update from one polling thread.
+class OtherAudioDetector {
+   public:
+    // Returns false if the peak could not be read (treated as silent).
+    using PeakReader = std::function<bool(uint64_t session_key, float* peak_out)>;
+
+    explicit OtherAudioDetector(const OtherAudioDetectorConfig& config = {}) : config_(config) {}
+
+    void SetConfig(const OtherAudioDetectorConfig& config);
+
+    void OnSessionAdded(uint64_t key, bool active, bool audible);
+    void OnSessionStateChanged(uint64_t key, bool active);
+    void OnSessionVolumeChanged(uint64_t key, bool audible);
+    void OnSessionRemoved(uint64_t key);
+    void ClearSessions();  // Default device changed: sessions are re-added by the caller
+
+    // Reads peaks of the sampled sessions (read_peak runs without the lock held), applies the hysteresis and returns
+    // the debounced decision.
+    bool Update(int64_t now_ns, const PeakReader& read_peak);
+
+    // Update thread: forgets the debounced state (monitoring paused, e.g. game back in foreground).
+    void ResetHysteresis();
+
+    bool IsPlaying() const { return playing_published_.load(std::memory_order_acquire); }
+    OtherAudioDetectorStats GetStats() const;
+
+   private:
+    struct Session {
+        bool active = false;
+        bool audible = false;  // Unmuted and volume > 0
+    };
+
+    mutable std::mutex mutex_;
+    OtherAudioDetectorConfig config_;
+    std::unordered_map<uint64_t, Session> sessions_;
+    uint64_t session_events_ = 0;
+    OtherAudioDetectorStats update_stats_;  // Published by Update under mutex_
+
+    // Update thread only
+    std::vector<uint64_t> sample_keys_;
+    bool playing_ = false;
+    bool raw_ = false;
+    int64_t raw_since_ns_ = 0;
+    int64_t last_update_ns_ = 0;
+    bool have_update_ = false;
+    uint64_t peak_reads_ = 0;
+    uint64_t flips_ = 0;
+
+    std::atomic<bool> playing_published_{false};
+};
@@ -60,6 +60,22 @@ void DrawControllerPollingRatesSection(display_commander::ui::IImGuiWrapper& img
         imgui.SetTooltipEx("Game (or addon) calls to XInputGetState(0) per second.");
     }
 
+    const auto cache_stats = display_commanderhooks::GetXInputConnectionCacheStats();
+    imgui.Text("Disconnected-slot cache: %llu probes avoided, %llu forwarded, %llu reconnects",
+               static_cast<unsigned long long>(cache_stats.avoided_probes),
+               static_cast<unsigned long long>(cache_stats.probes),
+               static_cast<unsigned long long>(cache_stats.reconnects));
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "XInputGetState/GetStateEx/GetCapabilities calls on unplugged slots answered \"not connected\" from memory.\n"
+            "Unplugged slots are re-probed every 0.1-2 s (backoff), immediately after a device arrival.\n"
+            "Invalidations (device arrival): %llu",
+            static_cast<unsigned long long>(cache_stats.invalidations));
+    }
+    imgui.Text("Cached unplugged slots: %s %s %s %s", cache_stats.cached_disconnected[0] ? "0" : "-",
+               cache_stats.cached_disconnected[1] ? "1" : "-", cache_stats.cached_disconnected[2] ? "2" : "-",
+               cache_stats.cached_disconnected[3] ? "3" : "-");
+
     imgui.Unindent();
 }
 
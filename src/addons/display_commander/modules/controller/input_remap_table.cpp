@@ -0,0 +1,94 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "input_remap_table.hpp"
+
+// Libraries <standard C++>
+#include <bit>
+
+namespace display_commander::input_remapping {
+
+void CompiledRemapTable::Add(const RemapBitEntry& entry) {
+    if (entry.kind == RemapEntryKind::kNone || !std::has_single_bit(static_cast<unsigned>(entry.source_button))) {
+        return;
+    }
+    const uint32_t bit = static_cast<uint32_t>(std::countr_zero(static_cast<unsigned>(entry.source_button)));
+    by_bit[bit] = entry;
+    mapped_mask |= entry.source_button;
+
+    GamepadRemapList& remaps = gamepad;
+    uint32_t k = 0;
+    while (k < remaps.count && remaps.source[k] != entry.source_button) {
+        ++k;
+    }
+    if (entry.kind != RemapEntryKind::kGamepad) {
+        if (k < remaps.count) {
+            // Replaced a gamepad remap: drop it, keeping the order of the others
+            for (uint32_t j = k + 1; j < remaps.count; ++j) {
+                remaps.source[j - 1] = remaps.source[j];
+                remaps.target[j - 1] = remaps.target[j];
+                remaps.clear[j - 1] = remaps.clear[j];
+                remaps.need_guide[j - 1] = remaps.need_guide[j];
+            }
+            --remaps.count;
+            // Keep the unused tail zeroed so equal configurations compare equal
+            remaps.source[remaps.count] = 0;
+            remaps.target[remaps.count] = 0;
+            remaps.clear[remaps.count] = 0;
+            remaps.need_guide[remaps.count] = 0;
+        }
+        return;
+    }
+    if (k == remaps.count) {
+        ++remaps.count;
+    }
+    remaps.source[k] = entry.source_button;
+    remaps.target[k] = entry.gamepad_target;
+    remaps.clear[k] = entry.hold ? 0 : entry.source_button;
+    remaps.need_guide[k] = entry.chord ? kRemapGuideButton : 0;
+}
+
+void StepRemapSlot(const CompiledRemapTable& table, RemapSlotState& state, uint32_t slot, uint16_t buttons,
+                   IRemapEventSink& sink) {
+    const uint16_t previous = state.previous.exchange(buttons, std::memory_order_acq_rel);
+    unsigned changed = static_cast<unsigned>((previous ^ buttons) & table.mapped_mask);
+    while (changed != 0) {
+        const uint32_t bit = static_cast<uint32_t>(std::countr_zero(changed));
+        changed &= changed - 1;
+        const uint16_t mask = static_cast<uint16_t>(1u << bit);
+        const RemapBitEntry& entry = table.by_bit[bit];
+
+        if ((buttons & mask) != 0) {
+            // Press: any other mapped press while Home is armed makes it a non-solo press
+            if (mask != kRemapGuideButton && state.guide_solo_armed.load(std::memory_order_relaxed)) {
+                state.guide_solo_other.store(true, std::memory_order_relaxed);
+            }
+            if (entry.kind == RemapEntryKind::kGuideSoloToggle) {
+                state.guide_solo_other.store((buttons & ~kRemapGuideButton) != 0, std::memory_order_relaxed);
+                state.guide_solo_armed.store(true, std::memory_order_relaxed);
+                continue;
+            }
+            if (entry.chord && (buttons & kRemapGuideButton) == 0) {
+                continue;
+            }
+            if (entry.hold) {
+                state.held.fetch_or(mask, std::memory_order_relaxed);
+            }
+            sink.OnPress(slot, entry);
+        } else {
+            if (entry.kind == RemapEntryKind::kGuideSoloToggle) {
+                // Only hold-mode, non-chord Home remaps run the release handler (as before the table)
+                if (state.guide_solo_armed.exchange(false, std::memory_order_relaxed)) {
+                    const bool other = state.guide_solo_other.exchange(false, std::memory_order_relaxed);
+                    if (entry.hold && !entry.chord) {
+                        sink.OnGuideSoloRelease(slot, entry, other);
+                    }
+                }
+                continue;
+            }
+            if ((state.held.fetch_and(static_cast<uint16_t>(~mask), std::memory_order_relaxed) & mask) != 0) {
+                sink.OnRelease(slot, entry);
+            }
+        }
+    }
+}
+
+}  // namespace display_commander::input_remapping
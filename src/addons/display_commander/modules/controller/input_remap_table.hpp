@@ -0,0 +1,96 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#pragma once
+
+// Libraries <standard C++>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace display_commander::input_remapping {
+
+// Compiled, immutable form of the InputRemapper configuration. Platform-neutral (button masks are XInput wButtons
+// bits); built on every configuration change and published as a whole, so the polling path never takes a lock.
+//
+// Per button bit (XInput has 16) the table holds what a press / release of that bit does. Button edges drive a
+// small per-slot state machine:
+//   hold      - press fires OnPress and marks the bit held; the release of a held bit fires OnRelease
+//               (key up), even if Home was let go first in chord mode.
+//   chord     - press only fires while Home (Guide) is down.
+//   Home solo - Home mapped to "display commander ui toggle": press arms, any other mapped press cancels "solo",
+//               release fires OnGuideSoloRelease with whether another button was involved (hold mode only,
+//               like the default Home chord).
+// Gamepad-to-gamepad remaps (GamepadRemapList) are applied to the state by the XInput pipeline's remap stage.
+// Turbo / autofire is handled by the XInput widget (ProcessAutofire) after remapping.
+inline constexpr uint16_t kRemapGuideButton = 0x0400;  // XINPUT_GAMEPAD_GUIDE
+inline constexpr uint32_t kRemapButtonBits = 16;
+
+enum class RemapEntryKind : uint8_t { kNone = 0, kKeyboard, kGamepad, kAction, kGuideSoloToggle };
+
+struct RemapBitEntry {
+    RemapEntryKind kind = RemapEntryKind::kNone;
+    bool hold = false;
+    bool chord = false;
+    uint16_t source_button = 0;
+    uint16_t gamepad_target = 0;
+    int keyboard_vk = 0;
+    int input_method = 0;  // KeyboardInputMethod
+    std::string keyboard_name;
+    std::string action_name;
+};
+
+// Gamepad-to-gamepad remaps in configuration order (later remaps see buttons added by earlier ones). Plain values:
+// the XInput transform pipeline embeds a copy as its remap stage.
+struct GamepadRemapList {
+    std::array<uint16_t, kRemapButtonBits> source = {};
+    std::array<uint16_t, kRemapButtonBits> target = {};
+    std::array<uint16_t, kRemapButtonBits> clear = {};       // source for one-shot (non-hold) remaps, else 0
+    std::array<uint16_t, kRemapButtonBits> need_guide = {};  // kRemapGuideButton for chord remaps, else 0
+    uint32_t count = 0;
+
+    // Fixed pass over the remaps; returns the new wButtons.
+    uint16_t Apply(uint16_t buttons) const {
+        for (uint32_t k = 0; k < count; ++k) {
+            const bool fire = (buttons & source[k]) != 0 && (buttons & need_guide[k]) == need_guide[k];
+            const uint16_t mask = static_cast<uint16_t>(0u - static_cast<unsigned>(fire));
+            buttons = static_cast<uint16_t>((buttons | (target[k] & mask)) & ~(clear[k] & mask));
+        }
+        return buttons;
+    }
+
+    bool operator==(const GamepadRemapList&) const = default;
+};
+
+struct CompiledRemapTable {
+    std::array<RemapBitEntry, kRemapButtonBits> by_bit;
+    uint16_t mapped_mask = 0;  // Bits with an enabled remap
+    GamepadRemapList gamepad;
+
+    // Add an enabled single-button remap (later adds for the same bit replace earlier ones). Ignores other masks.
+    void Add(const RemapBitEntry& entry);
+
+    uint16_t ApplyGamepadRemaps(uint16_t buttons) const { return gamepad.Apply(buttons); }
+};
+
+// Receives the edge events of StepRemapSlot.
+class IRemapEventSink {
+   public:
+    virtual ~IRemapEventSink() = default;
+    virtual void OnPress(uint32_t slot, const RemapBitEntry& entry) = 0;
+    virtual void OnRelease(uint32_t slot, const RemapBitEntry& entry) = 0;
+    virtual void OnGuideSoloRelease(uint32_t slot, const RemapBitEntry& entry, bool other_button_pressed) = 0;
+};
+
+// Per-controller edge state. Atomics so concurrent polls of one slot each see an edge exactly once.
+struct RemapSlotState {
+    std::atomic<uint16_t> previous{0};
+    std::atomic<uint16_t> held{0};
+    std::atomic<bool> guide_solo_armed{false};
+    std::atomic<bool> guide_solo_other{false};
+};
+
+// Diff buttons against the slot's previous buttons and dispatch press/release of mapped bits (ascending bit order).
+void StepRemapSlot(const CompiledRemapTable& table, RemapSlotState& state, uint32_t slot, uint16_t buttons,
+                   IRemapEventSink& sink);
+
+}  // namespace display_commander::input_remapping
@@ -12,18 +12,16 @@
 #include "../../utils/logging.hpp"
 #include "../../utils/srwlock_wrapper.hpp"
 #include "../../utils/timing.hpp"
+#include "xinput_hooks.hpp"
 #include "xinput_widget.hpp"
 
 // Libraries <ReShade> / <imgui>
 #include <reshade.hpp>
 
-namespace display_commander::input_remapping {
+// Libraries <standard C++>
+#include <bit>
 
-// Monotonic time in ms (QPC via utils::get_time_ns; uses QPC original when time-slowdown is active).
-static ULONGLONG GetMonotonicTimeMs() {
-    const LONGLONG ns = utils::get_time_ns();
-    return (ns > 0) ? static_cast<ULONGLONG>(ns / utils::NS_TO_MS) : 0;
-}
+namespace display_commander::input_remapping {
 
 InputRemapper& InputRemapper::get_instance() {
     static InputRemapper instance;
@@ -32,14 +30,7 @@ InputRemapper& InputRemapper::get_instance() {
 
 InputRemapper::InputRemapper() {
     // SRWLOCK is statically initialized, no explicit initialization needed
-
-    // Initialize button state tracking
-    for (int i = 0; i < XUSER_MAX_COUNT; ++i) {
-        _previous_button_states[i].store(0);
-        _current_button_states[i].store(0);
-        _guide_solo_candidate[i].store(false);
-        _guide_other_button_pressed[i].store(false);
-    }
+    _compiled_table.store(std::make_shared<const CompiledRemapTable>());
 }
 
 InputRemapper::~InputRemapper() {
@@ -79,33 +70,51 @@ void InputRemapper::cleanup() {
     LogInfo("InputRemapper::cleanup() - Input remapping cleanup complete");
 }
 
-void InputRemapper::process_gamepad_input(DWORD user_index, XINPUT_STATE* state) {
-    if (!_remapping_enabled.load() || state == nullptr || user_index >= XUSER_MAX_COUNT) {
+void InputRemapper::process_gamepad_input(DWORD user_index, WORD buttons) {
+    if (!_remapping_enabled.load(std::memory_order_relaxed) || user_index >= XUSER_MAX_COUNT) {
         return;
     }
 
-    // Update button states
-    update_button_states(user_index, state->Gamepad.wButtons);
-
-    // Process button changes
-    WORD previous = _previous_button_states[user_index].load();
-    WORD current = _current_button_states[user_index].load();
-    WORD changed = previous ^ current;
+    // Keyboard / action remaps fire on button edges (hold, chord and Home-solo state machines)
+    const std::shared_ptr<const CompiledRemapTable> table = _compiled_table.load(std::memory_order_acquire);
+    StepRemapSlot(*table, _slot_states[user_index], user_index, buttons, *this);
+}
 
-    // Check each button for changes
-    for (int i = 0; i < 16; ++i) {
-        WORD button_mask = 1 << i;
-        if ((changed & button_mask) != 0) {
-            if ((current & button_mask) != 0) {
-                handle_button_press(button_mask, user_index, current);
-            } else {
-                handle_button_release(button_mask, user_index, current);
-            }
+void InputRemapper::publish_compiled_table() {
+    auto table = std::make_shared<CompiledRemapTable>();
+    for (const auto& remap : _remappings) {
+        if (!remap.enabled) {
+            continue;
+        }
+        RemapBitEntry entry;
+        entry.hold = remap.hold_mode;
+        entry.chord = remap.chord_mode;
+        entry.source_button = remap.gamepad_button;
+        switch (remap.remap_type) {
+            case RemapType::Keyboard:
+                entry.kind = RemapEntryKind::kKeyboard;
+                entry.keyboard_vk = remap.keyboard_vk;
+                entry.input_method = static_cast<int>(remap.input_method);
+                entry.keyboard_name = remap.keyboard_name;
+                break;
+            case RemapType::Gamepad:
+                entry.kind = RemapEntryKind::kGamepad;
+                entry.gamepad_target = remap.gamepad_target_button;
+                break;
+            case RemapType::Action:
+                // Home mapped to the UI toggle fires on release, optionally only when pressed alone
+                entry.kind = (remap.gamepad_button == XINPUT_GAMEPAD_GUIDE
+                              && remap.action_name == "display commander ui toggle")
+                                 ? RemapEntryKind::kGuideSoloToggle
+                                 : RemapEntryKind::kAction;
+                entry.action_name = remap.action_name;
+                break;
+            case RemapType::Count: continue;
         }
+        table->Add(entry);
     }
-
-    // Apply gamepad-to-gamepad remapping (modifies state)
-    apply_gamepad_remapping(user_index, state);
+    _compiled_table.store(std::move(table), std::memory_order_release);
+    display_commanderhooks::SyncXInputPipeline();
 }
 
 void InputRemapper::add_default_chord_type(DefaultChordType chord_type) {
@@ -184,6 +193,7 @@ void InputRemapper::add_default_chord_type(DefaultChordType chord_type) {
         remap.is_default_chord = true;
         _remappings.push_back(remap);
         _button_to_remap_index[button] = _remappings.size() - 1;
+        publish_compiled_table();
         save_settings();
         LogInfo("InputRemapper::add_default_chord_type() - Added default chord: %s", log_name);
     } else {
@@ -192,6 +202,7 @@ void InputRemapper::add_default_chord_type(DefaultChordType chord_type) {
         if (idx < _remappings.size() && _remappings[idx].is_default_chord) {
             // Re-enable if it was previously a default chord but disabled
             _remappings[idx].enabled = true;
+            publish_compiled_table();
             save_settings();
             LogInfo("InputRemapper::add_default_chord_type() - Re-enabled default chord: %s", log_name);
         }
@@ -238,6 +249,7 @@ void InputRemapper::remove_default_chord_type(DefaultChordType chord_type) {
                 }
             }
 
+            publish_compiled_table();
             save_settings();
             LogInfo("InputRemapper::remove_default_chord_type() - Removed default chord for button 0x%04X", button);
         }
@@ -291,6 +303,7 @@ void InputRemapper::add_button_remap(const ButtonRemap& remap) {
         _remappings.push_back(remap);
         _button_to_remap_index[remap.gamepad_button] = _remappings.size() - 1;
     }
+    publish_compiled_table();
 
     // Auto-save settings when remappings change
     save_settings();
@@ -315,6 +328,7 @@ void InputRemapper::remove_button_remap(WORD gamepad_button) {
             }
         }
     }
+    publish_compiled_table();
 
     // Auto-save settings when remappings change
     save_settings();
@@ -326,6 +340,7 @@ void InputRemapper::clear_all_remaps() {
     utils::SRWLockExclusive lock(_srwlock);
     _remappings.clear();
     _button_to_remap_index.clear();
+    publish_compiled_table();
 
     // Auto-save settings when remappings change
     save_settings();
@@ -335,6 +350,7 @@ void InputRemapper::clear_all_remaps() {
 
 void InputRemapper::set_remapping_enabled(bool enabled) {
     _remapping_enabled.store(enabled);
+    display_commanderhooks::SyncXInputPipeline();
 
     // Save the setting to config immediately
     display_commander::config::set_config_value("DisplayCommander.InputRemapping", "Enabled", enabled);
@@ -361,6 +377,19 @@ const ButtonRemap* InputRemapper::get_button_remap(WORD gamepad_button) const {
     return (it != _button_to_remap_index.end()) ? &_remappings[it->second] : nullptr;
 }
 
+uint64_t InputRemapper::get_trigger_count(WORD gamepad_button) const {
+    if (!std::has_single_bit(static_cast<unsigned>(gamepad_button))) {
+        return 0;
+    }
+    return _trigger_counts[std::countr_zero(static_cast<unsigned>(gamepad_button))].load(std::memory_order_relaxed);
+}
+
+void InputRemapper::reset_trigger_counts() {
+    for (auto& count : _trigger_counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
 void InputRemapper::update_remap(WORD gamepad_button, int keyboard_vk, const std::string& keyboard_name,
                                  KeyboardInputMethod method, bool hold_mode, bool chord_mode) {
     ButtonRemap remap(gamepad_button, keyboard_vk, keyboard_name, true, method, hold_mode, chord_mode);
@@ -480,6 +509,7 @@ void InputRemapper::load_settings() {
         }
     }
 
+    display_commanderhooks::SyncXInputPipeline();
     LogInfo("InputRemapper::load_settings() - Loaded %zu remappings", _remappings.size());
 }
 
@@ -611,201 +641,89 @@ std::string InputRemapper::get_button_name(WORD button) const {
 
 HWND InputRemapper::get_active_window() const { return display_commanderhooks::GetForegroundWindow_Direct(); }
 
-void InputRemapper::update_button_states(DWORD user_index, WORD button_state) {
-    if (user_index >= XUSER_MAX_COUNT) return;
-
-    _previous_button_states[user_index].store(_current_button_states[user_index].load());
-    _current_button_states[user_index].store(button_state);
-}
-
-void InputRemapper::handle_button_press(WORD gamepad_button, DWORD user_index, WORD current_button_state) {
-    ButtonRemap* remap = const_cast<ButtonRemap*>(get_button_remap(gamepad_button));
-    if (!remap || !remap->enabled) return;
-
-    // If Home-based Display Commander UI solo toggle is pending, any other button press cancels "solo" state
-    if (gamepad_button != XINPUT_GAMEPAD_GUIDE && user_index < XUSER_MAX_COUNT) {
-        if (_guide_solo_candidate[user_index].load()) {
-            _guide_other_button_pressed[user_index].store(true);
-        }
-    }
-
-    // Special handling for Home button mapped to Display Commander UI toggle:
-    // - We want to trigger the action on Home RELEASE, optionally only if no other buttons were pressed.
-    // - So we do NOT execute the action here on press; we just start tracking a potential solo press.
-    if (remap->remap_type == RemapType::Action && remap->action_name == "display commander ui toggle"
-        && gamepad_button == XINPUT_GAMEPAD_GUIDE && user_index < XUSER_MAX_COUNT) {
-        _guide_solo_candidate[user_index].store(true);
-
-        // If any other button is currently held down, this cannot be a "solo" press
-        const WORD guide_mask = XINPUT_GAMEPAD_GUIDE;
-        WORD other_down = current_button_state & static_cast<WORD>(~guide_mask);
-        _guide_other_button_pressed[user_index].store(other_down != 0);
-        return;
-    }
-
-    // Check chord mode: if enabled, home button must also be pressed
-    if (remap->chord_mode) {
-        if ((current_button_state & XINPUT_GAMEPAD_GUIDE) == 0) {
-            // Home button not pressed, ignore this remapping
-            return;
-        }
+bool InputRemapper::send_keyboard_input(const RemapBitEntry& entry, bool key_down) {
+    switch (static_cast<KeyboardInputMethod>(entry.input_method)) {
+        case KeyboardInputMethod::SendInput:   return send_keyboard_input_sendinput(entry.keyboard_vk, key_down);
+        case KeyboardInputMethod::KeybdEvent:  return send_keyboard_input_keybdevent(entry.keyboard_vk, key_down);
+        case KeyboardInputMethod::SendMessage: return send_keyboard_input_sendmessage(entry.keyboard_vk, key_down);
+        case KeyboardInputMethod::PostMessage: return send_keyboard_input_postmessage(entry.keyboard_vk, key_down);
+        case KeyboardInputMethod::Count:       break;
     }
+    return false;
+}
 
-    remap->is_pressed.store(true);
-    remap->last_press_time.store(GetMonotonicTimeMs());
-
+void InputRemapper::OnPress(uint32_t slot, const RemapBitEntry& entry) {
     bool success = false;
 
     // Handle different remap types
-    switch (remap->remap_type) {
-        case RemapType::Keyboard: {
-            // Send keyboard input
-            switch (remap->input_method) {
-                case KeyboardInputMethod::SendInput:
-                    success = send_keyboard_input_sendinput(remap->keyboard_vk, true);
-                    break;
-                case KeyboardInputMethod::KeybdEvent:
-                    success = send_keyboard_input_keybdevent(remap->keyboard_vk, true);
-                    break;
-                case KeyboardInputMethod::SendMessage:
-                    success = send_keyboard_input_sendmessage(remap->keyboard_vk, true);
-                    break;
-                case KeyboardInputMethod::PostMessage:
-                    success = send_keyboard_input_postmessage(remap->keyboard_vk, true);
-                    break;
-                case KeyboardInputMethod::Count:
-                    // Should never happen
-                    break;
-            }
-
+    switch (entry.kind) {
+        case RemapEntryKind::kKeyboard:
+            success = send_keyboard_input(entry, true);
             if (success) {
-                LogInfo("InputRemapper::handle_button_press() - Mapped %s to keyboard %s (Controller %lu)",
-                        get_button_name(gamepad_button).c_str(), remap->keyboard_name.c_str(), user_index);
+                LogInfo("InputRemapper::OnPress() - Mapped %s to keyboard %s (Controller %u)",
+                        get_button_name(entry.source_button).c_str(), entry.keyboard_name.c_str(), slot);
             } else {
-                LogError("InputRemapper::handle_button_press() - Failed to send keyboard input for %s",
-                         remap->keyboard_name.c_str());
+                LogError("InputRemapper::OnPress() - Failed to send keyboard input for %s",
+                         entry.keyboard_name.c_str());
             }
             break;
-        }
-        case RemapType::Gamepad:
-            // Gamepad remapping is handled in apply_gamepad_remapping
-            // Just mark as success for logging
+        case RemapEntryKind::kGamepad:
+            // Gamepad remapping itself is applied by the remap stage of the XInput pipeline
             success = true;
-            LogInfo("InputRemapper::handle_button_press() - Mapped %s to gamepad %s (Controller %lu)",
-                    get_button_name(gamepad_button).c_str(), get_button_name(remap->gamepad_target_button).c_str(),
-                    user_index);
+            LogInfo("InputRemapper::OnPress() - Mapped %s to gamepad %s (Controller %u)",
+                    get_button_name(entry.source_button).c_str(), get_button_name(entry.gamepad_target).c_str(),
+                    slot);
             break;
-        case RemapType::Action:
-            // Execute action
-            execute_action(remap->action_name);
+        case RemapEntryKind::kAction:
+            execute_action(entry.action_name);
             success = true;
-            LogInfo("InputRemapper::handle_button_press() - Mapped %s to action %s (Controller %lu)",
-                    get_button_name(gamepad_button).c_str(), remap->action_name.c_str(), user_index);
-            break;
-        case RemapType::Count:
-            // Should never happen
+            LogInfo("InputRemapper::OnPress() - Mapped %s to action %s (Controller %u)",
+                    get_button_name(entry.source_button).c_str(), entry.action_name.c_str(), slot);
             break;
+        case RemapEntryKind::kGuideSoloToggle:
+        case RemapEntryKind::kNone: break;
     }
 
     if (success) {
-        // Increment trigger counter
-        increment_trigger_count(gamepad_button);
+        _trigger_counts[std::countr_zero(static_cast<unsigned>(entry.source_button))].fetch_add(
+            1, std::memory_order_relaxed);
     }
 }
 
-void InputRemapper::handle_button_release(WORD gamepad_button, DWORD user_index, WORD current_button_state) {
-    ButtonRemap* remap = const_cast<ButtonRemap*>(get_button_remap(gamepad_button));
-    if (!remap || !remap->enabled || !remap->hold_mode) return;
-
-    // Check chord mode: if enabled, home button must also be pressed (or was pressed when button was released)
-    // For release, we check if home button is still pressed or if it was pressed when the button was held
-    if (remap->chord_mode) {
-        if ((current_button_state & XINPUT_GAMEPAD_GUIDE) == 0) {
-            // Home button not pressed, ignore this remapping release
-            return;
-        }
-    }
-
-    remap->is_pressed.store(false);
-
-    bool success = false;
-
-    // Handle different remap types
-    switch (remap->remap_type) {
-        case RemapType::Keyboard: {
-            // Send keyboard release
-            switch (remap->input_method) {
-                case KeyboardInputMethod::SendInput:
-                    success = send_keyboard_input_sendinput(remap->keyboard_vk, false);
-                    break;
-                case KeyboardInputMethod::KeybdEvent:
-                    success = send_keyboard_input_keybdevent(remap->keyboard_vk, false);
-                    break;
-                case KeyboardInputMethod::SendMessage:
-                    success = send_keyboard_input_sendmessage(remap->keyboard_vk, false);
-                    break;
-                case KeyboardInputMethod::PostMessage:
-                    success = send_keyboard_input_postmessage(remap->keyboard_vk, false);
-                    break;
-                case KeyboardInputMethod::Count:
-                    // Should never happen
-                    break;
-            }
-
-            if (success) {
-                LogInfo("InputRemapper::handle_button_release() - Released keyboard %s (Controller %lu)",
-                        remap->keyboard_name.c_str(), user_index);
+void InputRemapper::OnRelease(uint32_t slot, const RemapBitEntry& entry) {
+    switch (entry.kind) {
+        case RemapEntryKind::kKeyboard:
+            if (send_keyboard_input(entry, false)) {
+                LogInfo("InputRemapper::OnRelease() - Released keyboard %s (Controller %u)",
+                        entry.keyboard_name.c_str(), slot);
             }
             break;
-        }
-        case RemapType::Gamepad:
-            // Gamepad remapping release is handled in apply_gamepad_remapping
-            // Just mark as success for logging
-            success = true;
-            LogInfo("InputRemapper::handle_button_release() - Released gamepad %s (Controller %lu)",
-                    get_button_name(remap->gamepad_target_button).c_str(), user_index);
-            break;
-        case RemapType::Action:
-            // Special handling for Home-based Display Commander UI toggle:
-            // - Trigger on Home RELEASE
-            // - Optionally require that no other buttons were pressed while Home was held
-            if (remap->action_name == "display commander ui toggle" && gamepad_button == XINPUT_GAMEPAD_GUIDE
-                && user_index < XUSER_MAX_COUNT) {
-                bool candidate_active = _guide_solo_candidate[user_index].load();
-                bool other_pressed = _guide_other_button_pressed[user_index].load();
-
-                // Clear tracking state
-                _guide_solo_candidate[user_index].store(false);
-                _guide_other_button_pressed[user_index].store(false);
-
-                if (candidate_active) {
-                    bool require_solo = settings::g_mainTabSettings.guide_button_solo_ui_toggle_only.GetValue();
-
-                    if (!require_solo || !other_pressed) {
-                        execute_action(remap->action_name);
-                        success = true;
-                        LogInfo(
-                            "InputRemapper::handle_button_release() - Home solo Display Commander UI toggle "
-                            "(Controller %lu)",
-                            user_index);
-                    }
-                }
-            } else {
-                // Other actions typically don't need release handling
-                success = true;
-            }
+        case RemapEntryKind::kGamepad:
+            LogInfo("InputRemapper::OnRelease() - Released gamepad %s (Controller %u)",
+                    get_button_name(entry.gamepad_target).c_str(), slot);
             break;
-        case RemapType::Count:
-            // Should never happen
+        default:
+            // Actions fire on press only
             break;
     }
 }
 
+void InputRemapper::OnGuideSoloRelease(uint32_t slot, const RemapBitEntry& entry, bool other_button_pressed) {
+    const bool require_solo = settings::g_mainTabSettings.guide_button_solo_ui_toggle_only.GetValue();
+    if (require_solo && other_button_pressed) {
+        return;
+    }
+    execute_action(entry.action_name);
+    _trigger_counts[std::countr_zero(static_cast<unsigned>(entry.source_button))].fetch_add(
+        1, std::memory_order_relaxed);
+    LogInfo("InputRemapper::OnGuideSoloRelease() - Home solo Display Commander UI toggle (Controller %u)", slot);
+}
+
 // Global functions
 void initialize_input_remapping() { InputRemapper::get_instance().initialize(); }
 
-void process_gamepad_input_for_remapping(DWORD user_index, XINPUT_STATE* state) {
-    InputRemapper::get_instance().process_gamepad_input(user_index, state);
+void process_gamepad_input_for_remapping(DWORD user_index, WORD buttons) {
+    InputRemapper::get_instance().process_gamepad_input(user_index, buttons);
 }
 
 // Utility functions
@@ -905,52 +823,6 @@ std::vector<std::string> get_available_keyboard_keys() {
             "Page Down"};
 }
 
-void InputRemapper::increment_trigger_count(WORD gamepad_button) {
-    ButtonRemap* remap = const_cast<ButtonRemap*>(get_button_remap(gamepad_button));
-    if (remap) {
-        remap->trigger_count.fetch_add(1);
-    }
-}
-
-void InputRemapper::apply_gamepad_remapping(DWORD user_index, XINPUT_STATE* state) {
-    if (!state || user_index >= XUSER_MAX_COUNT) {
-        return;
-    }
-
-    utils::SRWLockShared lock(_srwlock);
-
-    // Apply all gamepad-to-gamepad remappings
-    for (const auto& remap : _remappings) {
-        if (!remap.enabled || remap.remap_type != RemapType::Gamepad) {
-            continue;
-        }
-
-        // Check chord mode: if enabled, home button must also be pressed
-        if (remap.chord_mode) {
-            if ((state->Gamepad.wButtons & XINPUT_GAMEPAD_GUIDE) == 0) {
-                // Home button not pressed, skip this remapping
-                continue;
-            }
-        }
-
-        // Check if source button is pressed
-        if ((state->Gamepad.wButtons & remap.gamepad_button) != 0) {
-            // Add target button to state
-            state->Gamepad.wButtons |= remap.gamepad_target_button;
-
-            // If hold_mode is false, remove source button (one-time press)
-            if (!remap.hold_mode) {
-                state->Gamepad.wButtons &= ~remap.gamepad_button;
-            }
-        } else if (remap.hold_mode) {
-            // If hold_mode is true and source button is released, remove target button
-            // (This is handled by button state tracking, but we ensure consistency here)
-            // Note: We can't easily detect release here without state tracking
-            // The release will be handled by handle_button_release
-        }
-    }
-}
-
 void InputRemapper::execute_action(const std::string& action_name) {
     // Helper function to trigger generic action notification
     auto trigger_action_notification = [](const std::string& name) {
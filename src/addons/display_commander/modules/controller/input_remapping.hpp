@@ -4,6 +4,7 @@
 // Libraries <standard C++>
 #include <array>
 #include <atomic>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,8 @@
 // Libraries <Windows> — XInput API
 #include <XInput.h>
 
+// Source Code <Display Commander>
+#include "input_remap_table.hpp"
 
 // Guide button constant (not defined in standard XInput headers)
 #ifndef XINPUT_GAMEPAD_GUIDE
@@ -73,9 +76,6 @@ struct ButtonRemap {
     bool hold_mode;                            // If true, holds key/button while button pressed
     bool chord_mode;                           // If true, remapping only works when home button is also pressed
     bool is_default_chord;                     // If true, this remap was added by default chords feature
-    std::atomic<bool> is_pressed{false};       // Current press state
-    std::atomic<ULONGLONG> last_press_time{0}; // Last press timestamp
-    std::atomic<uint64_t> trigger_count{0};    // Number of times this remapping was triggered
 
     ButtonRemap() = default;
 
@@ -96,41 +96,12 @@ struct ButtonRemap {
         : gamepad_button(btn), remap_type(RemapType::Action), keyboard_vk(0), keyboard_name(""),
           gamepad_target_button(0), action_name(action), enabled(en),
           input_method(KeyboardInputMethod::SendInput), hold_mode(hold), chord_mode(chord), is_default_chord(false) {}
-
-    // Copy constructor
-    ButtonRemap(const ButtonRemap &other)
-        : gamepad_button(other.gamepad_button), remap_type(other.remap_type),
-          keyboard_vk(other.keyboard_vk), keyboard_name(other.keyboard_name),
-          gamepad_target_button(other.gamepad_target_button), action_name(other.action_name),
-          enabled(other.enabled), input_method(other.input_method), hold_mode(other.hold_mode),
-          chord_mode(other.chord_mode), is_default_chord(other.is_default_chord),
-          is_pressed(other.is_pressed.load()), last_press_time(other.last_press_time.load()),
-          trigger_count(other.trigger_count.load()) {}
-
-    // Assignment operator
-    ButtonRemap &operator=(const ButtonRemap &other) {
-        if (this != &other) {
-            gamepad_button = other.gamepad_button;
-            remap_type = other.remap_type;
-            keyboard_vk = other.keyboard_vk;
-            keyboard_name = other.keyboard_name;
-            gamepad_target_button = other.gamepad_target_button;
-            action_name = other.action_name;
-            enabled = other.enabled;
-            input_method = other.input_method;
-            hold_mode = other.hold_mode;
-            chord_mode = other.chord_mode;
-            is_default_chord = other.is_default_chord;
-            is_pressed.store(other.is_pressed.load());
-            last_press_time.store(other.last_press_time.load());
-            trigger_count.store(other.trigger_count.load());
-        }
-        return *this;
-    }
 };
 
-// Main remapping manager class
-class InputRemapper {
+// Main remapping manager class.
+// _remappings is the editable configuration (UI thread, under _srwlock); every change recompiles it into a
+// CompiledRemapTable that the XInput polling path reads without locking.
+class InputRemapper : private IRemapEventSink {
   public:
     InputRemapper();
     ~InputRemapper();
@@ -141,8 +112,9 @@ class InputRemapper {
     // Cleanup the remapping system
     void cleanup();
 
-    // Process gamepad input and apply remappings
-    void process_gamepad_input(DWORD user_index, XINPUT_STATE *state);
+    // Fire keyboard / action remaps on button edges. Gamepad-to-gamepad remaps are a stage of the XInput pipeline;
+    // buttons are the state as it entered that stage.
+    void process_gamepad_input(DWORD user_index, WORD buttons);
 
     // Add/remove button remappings
     void add_button_remap(const ButtonRemap &remap);
@@ -153,6 +125,9 @@ class InputRemapper {
     void set_remapping_enabled(bool enabled);
     bool is_remapping_enabled() const { return _remapping_enabled.load(); }
 
+    // Gamepad-to-gamepad remaps of the compiled table (the XInput pipeline's remap stage)
+    GamepadRemapList get_gamepad_remaps() const { return _compiled_table.load(std::memory_order_acquire)->gamepad; }
+
     // Block gamepad input to game when home button is pressed (prevents accidental shortcuts)
     void set_block_input_on_home_button(bool enabled);
     bool is_block_input_on_home_button() const { return _block_input_on_home_button.load(); }
@@ -167,6 +142,10 @@ class InputRemapper {
     // Get remapping for specific button
     const ButtonRemap *get_button_remap(WORD gamepad_button) const;
 
+    // Number of times the remap of a source button fired (press), kept across remap edits
+    uint64_t get_trigger_count(WORD gamepad_button) const;
+    void reset_trigger_counts();
+
     // Update remapping settings
     void update_remap(WORD gamepad_button, int keyboard_vk, const std::string &keyboard_name,
                       KeyboardInputMethod method, bool hold_mode, bool chord_mode = false);
@@ -201,16 +180,14 @@ class InputRemapper {
     std::string get_button_name(WORD button) const;
     HWND get_active_window() const;
 
-    // Trigger counter functions
-    void increment_trigger_count(WORD gamepad_button);
+    // Rebuild the compiled table from _remappings and publish it. Caller holds _srwlock exclusively.
+    void publish_compiled_table();
 
-    // Button state tracking
-    void update_button_states(DWORD user_index, WORD button_state);
-    void handle_button_press(WORD gamepad_button, DWORD user_index, WORD current_button_state);
-    void handle_button_release(WORD gamepad_button, DWORD user_index, WORD current_button_state);
-
-    // Gamepad remapping - modify XINPUT_STATE
-    void apply_gamepad_remapping(DWORD user_index, XINPUT_STATE *state);
+    // IRemapEventSink: button edges from StepRemapSlot (polling thread)
+    void OnPress(uint32_t slot, const RemapBitEntry &entry) override;
+    void OnRelease(uint32_t slot, const RemapBitEntry &entry) override;
+    void OnGuideSoloRelease(uint32_t slot, const RemapBitEntry &entry, bool other_button_pressed) override;
+    bool send_keyboard_input(const RemapBitEntry &entry, bool key_down);
 
     // Action execution
     void execute_action(const std::string &action_name);
@@ -225,13 +202,14 @@ class InputRemapper {
     std::vector<ButtonRemap> _remappings;
     std::unordered_map<WORD, size_t> _button_to_remap_index;
 
-    // Button state tracking for each controller
-    std::array<std::atomic<WORD>, XUSER_MAX_COUNT> _previous_button_states;
-    std::array<std::atomic<WORD>, XUSER_MAX_COUNT> _current_button_states;
+    // Compiled configuration (RCU: replaced as a whole, never modified after publish)
+    std::atomic<std::shared_ptr<const CompiledRemapTable>> _compiled_table;
+
+    // Button edge / hold / Home-solo state for each controller
+    std::array<RemapSlotState, XUSER_MAX_COUNT> _slot_states;
 
-    // Guide solo-press tracking for Display Commander UI toggle
-    std::array<std::atomic<bool>, XUSER_MAX_COUNT> _guide_solo_candidate;
-    std::array<std::atomic<bool>, XUSER_MAX_COUNT> _guide_other_button_pressed;
+    // Trigger counters per source button bit
+    std::array<std::atomic<uint64_t>, kRemapButtonBits> _trigger_counts{};
 
     // Thread safety
     mutable SRWLOCK _srwlock = SRWLOCK_INIT;
@@ -239,7 +217,7 @@ class InputRemapper {
 
 // Global functions for integration
 void initialize_input_remapping();
-void process_gamepad_input_for_remapping(DWORD user_index, XINPUT_STATE *state);
+void process_gamepad_input_for_remapping(DWORD user_index, WORD buttons);
 
 // Utility functions
 std::string get_keyboard_input_method_name(KeyboardInputMethod method);
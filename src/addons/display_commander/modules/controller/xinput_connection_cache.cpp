@@ -0,0 +1,74 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "xinput_connection_cache.hpp"
+
+// Libraries <standard C++>
+#include <algorithm>
+
+namespace display_commanderhooks {
+
+bool XInputConnectionCache::ServeFromCache(uint32_t slot, int64_t now_ns) {
+    if (slot >= kSlotCount) {
+        return false;
+    }
+    const Slot& s = slots_[slot];
+    if (!s.disconnected.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (now_ns >= s.next_probe_ns.load(std::memory_order_relaxed)) {
+        return false;  // Due for a re-probe
+    }
+    avoided_probes_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void XInputConnectionCache::RecordProbe(uint32_t slot, bool connected, int64_t now_ns, uint32_t epoch) {
+    probes_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= kSlotCount) {
+        return;
+    }
+    Slot& s = slots_[slot];
+    if (connected) {
+        if (s.disconnected.exchange(false, std::memory_order_acq_rel)) {
+            reconnects_.fetch_add(1, std::memory_order_relaxed);
+        }
+        s.backoff_ns.store(0, std::memory_order_relaxed);
+        return;
+    }
+    if (epoch != epoch_.load(std::memory_order_acquire)) {
+        // Device arrived while this probe was in flight: stay uncached so the next call probes again
+        return;
+    }
+    // Concurrent probes of the same slot may both double the backoff; harmless, it is clamped.
+    const int64_t prev = s.backoff_ns.load(std::memory_order_relaxed);
+    const int64_t backoff = (prev <= 0) ? kMinBackoffNs : (std::min)(prev * 2, kMaxBackoffNs);
+    s.backoff_ns.store(backoff, std::memory_order_relaxed);
+    s.next_probe_ns.store(now_ns + backoff, std::memory_order_relaxed);
+    s.disconnected.store(true, std::memory_order_release);
+    if (epoch != epoch_.load(std::memory_order_acquire)) {
+        s.disconnected.store(false, std::memory_order_release);  // Lost a race with Invalidate()
+    }
+}
+
+void XInputConnectionCache::Invalidate() {
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+    for (Slot& s : slots_) {
+        s.disconnected.store(false, std::memory_order_release);
+        s.backoff_ns.store(0, std::memory_order_relaxed);
+    }
+    invalidations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+XInputConnectionCache::Stats XInputConnectionCache::GetStats() const {
+    Stats stats;
+    stats.probes = probes_.load(std::memory_order_relaxed);
+    stats.avoided_probes = avoided_probes_.load(std::memory_order_relaxed);
+    stats.reconnects = reconnects_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < kSlotCount; ++i) {
+        stats.cached_disconnected[i] = slots_[i].disconnected.load(std::memory_order_relaxed);
+        stats.backoff_ns[i] = slots_[i].backoff_ns.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+}  // namespace display_commanderhooks
@@ -0,0 +1,64 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#pragma once
+
+// Libraries <standard C++>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace display_commanderhooks {
+
+// Negative-result cache for XInput user slots.
+// Games poll all four slots every frame; on an empty slot the real XInputGetState is a device probe that only
+// returns ERROR_DEVICE_NOT_CONNECTED. Once a slot probes as disconnected, callers are answered from memory and the
+// slot is re-probed on an exponential backoff (kMinBackoffNs doubling up to kMaxBackoffNs). Invalidate() (device
+// arrival notifications) makes every slot probe again on its next call.
+// Reconnect latency bound: a pad is seen by the first poll after min(backoff, next Invalidate()), i.e. within
+// kMaxBackoffNs plus one game poll interval even when no notification arrives.
+// Lock-free, callable from any thread; time is passed in (ns) so it can run on a virtual clock. Platform-neutral.
+class XInputConnectionCache {
+   public:
+    static constexpr uint32_t kSlotCount = 4;  // XUSER_MAX_COUNT
+    static constexpr int64_t kMinBackoffNs = 100 * 1000000LL;
+    static constexpr int64_t kMaxBackoffNs = 2000 * 1000000LL;
+
+    struct Stats {
+        uint64_t probes = 0;          // Calls forwarded to the real XInput function
+        uint64_t avoided_probes = 0;  // Calls answered "not connected" from the cache
+        uint64_t reconnects = 0;      // Disconnected -> connected transitions
+        uint64_t invalidations = 0;   // Invalidate() calls
+        std::array<bool, kSlotCount> cached_disconnected = {};
+        std::array<int64_t, kSlotCount> backoff_ns = {};
+    };
+
+    // Value of the invalidation epoch; read before probing and pass to RecordProbe.
+    uint32_t Epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    // True if slot is known disconnected and not due for a re-probe: caller returns "not connected" without probing.
+    // Slots outside [0, kSlotCount) are never cached.
+    bool ServeFromCache(uint32_t slot, int64_t now_ns);
+
+    // Record the outcome of a real probe started at epoch. A probe that raced with Invalidate() does not back off.
+    void RecordProbe(uint32_t slot, bool connected, int64_t now_ns, uint32_t epoch);
+
+    // Device arrival (WM_DEVICECHANGE, WM_INPUT_DEVICE_CHANGE): drop all negative entries.
+    void Invalidate();
+
+    Stats GetStats() const;
+
+   private:
+    struct Slot {
+        std::atomic<bool> disconnected{false};
+        std::atomic<int64_t> next_probe_ns{0};
+        std::atomic<int64_t> backoff_ns{0};
+    };
+
+    std::array<Slot, kSlotCount> slots_;
+    std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint64_t> probes_{0};
+    std::atomic<uint64_t> avoided_probes_{0};
+    std::atomic<uint64_t> reconnects_{0};
+    std::atomic<uint64_t> invalidations_{0};
+};
+
+}  // namespace display_commanderhooks
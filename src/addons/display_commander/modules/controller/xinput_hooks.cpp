@@ -2,6 +2,7 @@
 #include "xinput_hooks.hpp"
 
 // Source Code <Display Commander>
+#include "../../feature/input_latency/input_latency.hpp"
 #include "../../globals.hpp"
 #include "../../hooks/hook_suppression_manager.hpp"
 #include "../../hooks/windows_hooks/windows_message_hooks.hpp"
@@ -10,8 +11,12 @@
 #include "../../utils/detour_call_tracker.hpp"
 #include "../../utils/general_utils.hpp"
 #include "../../utils/logging.hpp"
+#include "../../utils/srwlock_registry.hpp"
+#include "../../utils/srwlock_wrapper.hpp"
 #include "../../utils/timing.hpp"
 #include "input_remapping.hpp"
+#include "xinput_connection_cache.hpp"
+#include "xinput_pipeline.hpp"
 #include "xinput_widget.hpp"
 
 // Libraries <MinHook>
@@ -20,7 +25,6 @@
 // Libraries <standard C++>
 #include <array>
 #include <cmath>
-#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -69,12 +73,22 @@ static std::atomic<std::uint64_t> g_getstate_userindex0_calls{0};
 // Last XInputGetState_Detour_Impl duration (ns) when dwUserIndex == 0; 0 if not yet measured
 static std::atomic<std::uint64_t> g_getstate_userindex0_last_duration_ns{0};
 
+// Slots known to be unplugged are answered from memory instead of probing the device every poll
+static XInputConnectionCache g_connection_cache;
+
+// Feed a real probe result into the connection cache (other errors leave the slot state unchanged)
+static void RecordConnectionProbe(DWORD dwUserIndex, DWORD result, LONGLONG probe_start_ns, uint32_t cache_epoch) {
+    if (result == ERROR_SUCCESS || result == ERROR_DEVICE_NOT_CONNECTED) {
+        g_connection_cache.RecordProbe(dwUserIndex, result == ERROR_SUCCESS, probe_start_ns, cache_epoch);
+    }
+}
+
 // RAII: on destruction calls lambda with elapsed time in nanoseconds
 struct ScopedDurationReporter {
     std::uint64_t start_ns;
-    std::function<void(std::uint64_t)> on_exit;
-    explicit ScopedDurationReporter(std::function<void(std::uint64_t)> fn)
-        : start_ns(static_cast<std::uint64_t>(utils::get_now_ns())), on_exit(std::move(fn)) {}
+    void (*on_exit)(std::uint64_t);
+    explicit ScopedDurationReporter(void (*fn)(std::uint64_t))
+        : start_ns(static_cast<std::uint64_t>(utils::get_now_ns())), on_exit(fn) {}
     ~ScopedDurationReporter() {
         if (on_exit) {
             on_exit(static_cast<std::uint64_t>(utils::get_now_ns()) - start_ns);
@@ -213,195 +227,192 @@ void EnsureXInputSetStateForTest() {
     }
 }
 
-float recenter(float value, float center) {
-    auto new_value = value - center;
-
-    return new_value / (1 + abs(center));
-}
-
-// Helper function to apply stick mapping and center calibration (reads params from shared_state)
-void ApplyThumbstickProcessing(
-    XINPUT_STATE* pState,
-    const std::shared_ptr<display_commander::widgets::xinput_widget::XInputSharedState>& shared_state) {
-    if (!pState || !shared_state) return;
-
-    float left_center_x = shared_state->left_stick_center_x.load();
-    float left_center_y = shared_state->left_stick_center_y.load();
-    float right_center_x = shared_state->right_stick_center_x.load();
-    float right_center_y = shared_state->right_stick_center_y.load();
-    bool left_circular = shared_state->left_stick_circular.load();
-    bool right_circular = shared_state->right_stick_circular.load();
-    bool left_same_axes = shared_state->left_stick_same_axes.load();
-    bool right_same_axes = shared_state->right_stick_same_axes.load();
-
-    float lmin_in_x = shared_state->left_stick_x_min_input.load();
-    float lmax_in_x = shared_state->left_stick_x_max_input.load();
-    float lmin_out_x = shared_state->left_stick_x_min_output.load();
-    float lmax_out_x = shared_state->left_stick_x_max_output.load();
-    float lmin_in_y = shared_state->left_stick_y_min_input.load();
-    float lmax_in_y = shared_state->left_stick_y_max_input.load();
-    float lmin_out_y = shared_state->left_stick_y_min_output.load();
-    float lmax_out_y = shared_state->left_stick_y_max_output.load();
-    if (left_same_axes) {
-        lmin_in_y = lmin_in_x;
-        lmax_in_y = lmax_in_x;
-        lmin_out_y = lmin_out_x;
-        lmax_out_y = lmax_out_x;
-    }
-
-    float rmin_in_x = shared_state->right_stick_x_min_input.load();
-    float rmax_in_x = shared_state->right_stick_x_max_input.load();
-    float rmin_out_x = shared_state->right_stick_x_min_output.load();
-    float rmax_out_x = shared_state->right_stick_x_max_output.load();
-    float rmin_in_y = shared_state->right_stick_y_min_input.load();
-    float rmax_in_y = shared_state->right_stick_y_max_input.load();
-    float rmin_out_y = shared_state->right_stick_y_min_output.load();
-    float rmax_out_y = shared_state->right_stick_y_max_output.load();
-    if (right_same_axes) {
-        rmin_in_y = rmin_in_x;
-        rmax_in_y = rmax_in_x;
-        rmin_out_y = rmin_out_x;
-        rmax_out_y = rmax_out_x;
-    }
-
-    float lx = ShortToFloat(pState->Gamepad.sThumbLX);
-    float ly = ShortToFloat(pState->Gamepad.sThumbLY);
-    lx = recenter(lx, left_center_x);
-    ly = recenter(ly, left_center_y);
-    if (left_circular) {
-        ProcessStickInputRadial(lx, ly, lmin_in_x, lmax_in_x, lmin_out_x, lmax_out_x);
+// Published pipeline, guarded by utils::g_xinput_pipeline_lock; version bumped after each publish
+static XInputPipeline g_published_pipeline;
+static std::atomic<uint32_t> g_published_version{0};
+
+// Compile and publish params if they differ from the published pipeline. Returns true if a new one was published.
+static bool PublishXInputPipeline(const XInputPipelineParams& params) {
+    utils::SRWLockExclusive lock(utils::g_xinput_pipeline_lock);
+    if (g_published_version.load(std::memory_order_relaxed) != 0 && g_published_pipeline.params == params) {
+        return false;
+    }
+    g_published_pipeline = CompileXInputPipeline(params);
+    g_published_version.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+// Calling thread's copy of the published pipeline; refreshed only when the version changes (one atomic load per
+// call otherwise). Before the first publish this is an empty chain.
+static const XInputPipeline& GetXInputPipelineForThread() {
+    thread_local XInputPipeline t_pipeline;
+    thread_local uint32_t t_version = 0;
+    if (g_published_version.load(std::memory_order_acquire) != t_version) {
+        utils::SRWLockShared lock(utils::g_xinput_pipeline_lock);
+        t_pipeline = g_published_pipeline;
+        t_version = g_published_version.load(std::memory_order_relaxed);
+    }
+    return t_pipeline;
+}
+
+// Snapshot of the shared-state settings consumed by the compiled transform chain
+static XInputPipelineParams ReadXInputPipelineParams(
+    const display_commander::widgets::xinput_widget::XInputSharedState& shared_state) {
+    XInputPipelineParams params;
+    params.override_lx = shared_state.override_state.left_stick_x.load();
+    params.override_ly = shared_state.override_state.left_stick_y.load();
+    params.override_rx = shared_state.override_state.right_stick_x.load();
+    params.override_ry = shared_state.override_state.right_stick_y.load();
+    params.override_buttons = shared_state.override_state.buttons_pressed_mask.load();
+    params.swap_a_b = shared_state.swap_a_b_buttons.load();
+
+    XInputStickParams& left = params.left;
+    left.center_x = shared_state.left_stick_center_x.load();
+    left.center_y = shared_state.left_stick_center_y.load();
+    left.circular = shared_state.left_stick_circular.load();
+    left.min_in_x = shared_state.left_stick_x_min_input.load();
+    left.max_in_x = shared_state.left_stick_x_max_input.load();
+    left.min_out_x = shared_state.left_stick_x_min_output.load();
+    left.max_out_x = shared_state.left_stick_x_max_output.load();
+    if (shared_state.left_stick_same_axes.load()) {
+        left.min_in_y = left.min_in_x;
+        left.max_in_y = left.max_in_x;
+        left.min_out_y = left.min_out_x;
+        left.max_out_y = left.max_out_x;
     } else {
-        ProcessStickInputSquare(lx, ly, lmin_in_x, lmax_in_x, lmin_out_x, lmax_out_x, lmin_in_y, lmax_in_y, lmin_out_y,
-                                lmax_out_y);
-    }
-    pState->Gamepad.sThumbLX = FloatToShort(lx);
-    pState->Gamepad.sThumbLY = FloatToShort(ly);
-
-    float rx = ShortToFloat(pState->Gamepad.sThumbRX);
-    float ry = ShortToFloat(pState->Gamepad.sThumbRY);
-    rx = recenter(rx, right_center_x);
-    ry = recenter(ry, right_center_y);
-    if (right_circular) {
-        ProcessStickInputRadial(rx, ry, rmin_in_x, rmax_in_x, rmin_out_x, rmax_out_x);
+        left.min_in_y = shared_state.left_stick_y_min_input.load();
+        left.max_in_y = shared_state.left_stick_y_max_input.load();
+        left.min_out_y = shared_state.left_stick_y_min_output.load();
+        left.max_out_y = shared_state.left_stick_y_max_output.load();
+    }
+
+    XInputStickParams& right = params.right;
+    right.center_x = shared_state.right_stick_center_x.load();
+    right.center_y = shared_state.right_stick_center_y.load();
+    right.circular = shared_state.right_stick_circular.load();
+    right.min_in_x = shared_state.right_stick_x_min_input.load();
+    right.max_in_x = shared_state.right_stick_x_max_input.load();
+    right.min_out_x = shared_state.right_stick_x_min_output.load();
+    right.max_out_x = shared_state.right_stick_x_max_output.load();
+    if (shared_state.right_stick_same_axes.load()) {
+        right.min_in_y = right.min_in_x;
+        right.max_in_y = right.max_in_x;
+        right.min_out_y = right.min_out_x;
+        right.max_out_y = right.max_out_x;
     } else {
-        ProcessStickInputSquare(rx, ry, rmin_in_x, rmax_in_x, rmin_out_x, rmax_out_x, rmin_in_y, rmax_in_y, rmin_out_y,
-                                rmax_out_y);
+        right.min_in_y = shared_state.right_stick_y_min_input.load();
+        right.max_in_y = shared_state.right_stick_y_max_input.load();
+        right.min_out_y = shared_state.right_stick_y_min_output.load();
+        right.max_out_y = shared_state.right_stick_y_max_output.load();
+    }
+
+    const auto& remapper = display_commander::input_remapping::InputRemapper::get_instance();
+    params.remap = remapper.is_remapping_enabled();
+    if (params.remap) {
+        params.gamepad_remaps = remapper.get_gamepad_remaps();
+    }
+    return params;
+}
+
+void SyncXInputPipeline() {
+    if (PublishXInputPipeline(ReadXInputPipelineParams(
+            display_commander::widgets::xinput_widget::XInputWidget::GetSharedStateRef()))) {
+        LogDebug("XInput pipeline recompiled (%u transforms)",
+                 static_cast<unsigned>(GetXInputPipelineForThread().transform_count));
     }
-    pState->Gamepad.sThumbRX = FloatToShort(rx);
-    pState->Gamepad.sThumbRY = FloatToShort(ry);
 }
 
 // Helper function containing shared logic for XInputGetState and XInputGetStateEx
-static DWORD ProcessXInputGetState(DWORD dwUserIndex, XINPUT_STATE* pState, std::atomic<uint64_t>& update_ns_field,
-                                   const char* error_function_name,
-                                   const std::function<DWORD(DWORD, XINPUT_STATE*)>& call_original_func) {
-    // Note pState may be null if caller wants to check if device is connected
+static DWORD ProcessXInputGetState(DWORD dwUserIndex, XINPUT_STATE* pState,
+                                   display_commander::widgets::xinput_widget::XInputSharedState& shared_state,
+                                   std::atomic<uint64_t>& update_ns_field, const char* error_function_name,
+                                   XInputGetState_pfn call_original) {
     // Measure timing for smooth call rate calculation
-    auto shared_state = display_commander::widgets::xinput_widget::XInputWidget::GetSharedState();
-    if (shared_state && dwUserIndex == 0) {
+    if (dwUserIndex == 0) {
         uint64_t current_time_ns = utils::get_now_ns();
-        uint64_t last_call_time = shared_state->last_xinput_call_time_ns.load();
+        uint64_t last_call_time = shared_state.last_xinput_call_time_ns.load(std::memory_order_relaxed);
 
         if (last_call_time > 0) {
             uint64_t time_since_last_call_ns = current_time_ns - last_call_time;
             // Only update if time since last call is reasonable (ignore if > 1000ms)
             if (time_since_last_call_ns < 1 * utils::SEC_TO_NS) {  // 1 second in nanoseconds
-                uint64_t old_update_ns = update_ns_field.load();
+                uint64_t old_update_ns = update_ns_field.load(std::memory_order_relaxed);
                 uint64_t new_update_ns = UpdateRollingAverage(time_since_last_call_ns, old_update_ns);
-                update_ns_field.store(new_update_ns);
+                update_ns_field.store(new_update_ns, std::memory_order_relaxed);
             }
         }
-        shared_state->last_xinput_call_time_ns.store(current_time_ns);
+        shared_state.last_xinput_call_time_ns.store(current_time_ns, std::memory_order_relaxed);
     }
 
-    DWORD result = call_original_func(dwUserIndex, pState);
+    const uint32_t cache_epoch = g_connection_cache.Epoch();
+    const LONGLONG probe_start_ns = utils::get_now_ns();
+    if (g_connection_cache.ServeFromCache(dwUserIndex, probe_start_ns)) {
+        // Shared state already shows this slot as Unconnected (set by the probe that populated the cache)
+        return ERROR_DEVICE_NOT_CONNECTED;
+    }
+
+    DWORD result = (call_original != nullptr) ? call_original(dwUserIndex, pState) : ERROR_DEVICE_NOT_CONNECTED;
+    RecordConnectionProbe(dwUserIndex, result, probe_start_ns, cache_epoch);
     // Note pState may be null if caller wants to check if device is connected
     if (pState == nullptr) {
         return result;
     }
 
-    // Override packet number with our tracked value just before returning
-    if (dwUserIndex < 4 && pState != nullptr) {
-        // If we spoofed the connection, increment our tracked packet number
-        g_packet_numbers[dwUserIndex]++;
-        // Always override with our tracked packet number
-        pState->dwPacketNumber = g_packet_numbers[dwUserIndex];
-    }
-
-    // Apply A/B button swapping if enabled
     if (result == ERROR_SUCCESS) {
-        // Mark controller as connected in shared state
-        if (shared_state && dwUserIndex < XUSER_MAX_COUNT) {
-            shared_state->controller_connected[dwUserIndex] =
+        // Input latency: stamp real controller changes (raw state, before our packet number and transforms)
+        const XINPUT_GAMEPAD& raw = pState->Gamepad;
+        display_commander::feature::input_latency::ReportPadPoll(
+            dwUserIndex, pState->dwPacketNumber,
+            display_commander::feature::input_latency::PadChangeDetector::PackState(
+                raw.wButtons, raw.bLeftTrigger, raw.bRightTrigger, raw.sThumbLX, raw.sThumbLY, raw.sThumbRX,
+                raw.sThumbRY),
+            probe_start_ns);
+        if (dwUserIndex < XUSER_MAX_COUNT) {
+            // Always override with our tracked packet number
+            pState->dwPacketNumber = ++g_packet_numbers[dwUserIndex];
+            // Mark controller as connected in shared state
+            shared_state.controller_connected[dwUserIndex] =
                 display_commander::widgets::xinput_widget::ControllerState::Connected;
         }
         // Store the frame ID when XInput is successfully detected
-        uint64_t current_frame_id = g_global_frame_id.load();
-        g_last_xinput_detected_frame_id.store(current_frame_id);
-
-        auto shared_state = display_commander::widgets::xinput_widget::XInputWidget::GetSharedState();
+        const uint64_t detected_frame_id = g_global_frame_id.load();
+        const uint64_t previous_frame_id = g_last_xinput_detected_frame_id.exchange(detected_frame_id);
+        if (previous_frame_id == 0 || detected_frame_id >= previous_frame_id + kXInputDetectionWindowFrames) {
+            // Newly detected: mouse blocking "when XInput detected" starts now, not on the next monitoring pass
+            RefreshMessageSuppressionFilter();
+        }
 
         // Store original state for UI tracking (before any modifications)
         XINPUT_STATE original_state = *pState;
 
-        // Apply override state if set (check before suppression)
-        if (shared_state) {
-            float override_lx = shared_state->override_state.left_stick_x.load();
-            float override_ly = shared_state->override_state.left_stick_y.load();
-            float override_rx = shared_state->override_state.right_stick_x.load();
-            float override_ry = shared_state->override_state.right_stick_y.load();
-            WORD override_buttons = shared_state->override_state.buttons_pressed_mask.load();
-
-            // Apply stick overrides (INFINITY means not overridden)
-            if (!std::isinf(override_lx)) {
-                pState->Gamepad.sThumbLX = FloatToShort(override_lx);
-            }
-            if (!std::isinf(override_ly)) {
-                pState->Gamepad.sThumbLY = FloatToShort(override_ly);
-            }
-            if (!std::isinf(override_rx)) {
-                pState->Gamepad.sThumbRX = FloatToShort(override_rx);
-            }
-            if (!std::isinf(override_ry)) {
-                pState->Gamepad.sThumbRY = FloatToShort(override_ry);
-            }
-
-            // Apply button override (mask 0 means no override)
-            if (override_buttons != 0) {
-                pState->Gamepad.wButtons |= override_buttons;
-            }
+        // Override, A/B swap, stick recenter + response curve, gamepad remaps: compiled when settings change
+        if (g_published_version.load(std::memory_order_acquire) == 0) {
+            SyncXInputPipeline();
         }
-
-        // Process input normally
-        if (shared_state && shared_state->swap_a_b_buttons.load()) {
-            // Swap A and B buttons
-            WORD original_buttons = pState->Gamepad.wButtons;
-            WORD swapped_buttons = original_buttons;
-
-            // If A is pressed, set B instead
-            if (original_buttons & XINPUT_GAMEPAD_A) {
-                swapped_buttons |= XINPUT_GAMEPAD_B;
-                swapped_buttons &= ~XINPUT_GAMEPAD_A;
-                LogInfo("XXX A/B Swap: A pressed -> B set (Controller %lu)", dwUserIndex);
-            }
-            // If B is pressed, set A instead
-            if (original_buttons & XINPUT_GAMEPAD_B) {
-                swapped_buttons |= XINPUT_GAMEPAD_A;
-                swapped_buttons &= ~XINPUT_GAMEPAD_B;
-                LogInfo("XXX A/B Swap: B pressed -> A set (Controller %lu)", dwUserIndex);
-            }
-
-            pState->Gamepad.wButtons = swapped_buttons;
+        const XInputPipeline& pipeline = GetXInputPipelineForThread();
+        XInputPadState pad;
+        pad.buttons = pState->Gamepad.wButtons;
+        pad.left_trigger = pState->Gamepad.bLeftTrigger;
+        pad.right_trigger = pState->Gamepad.bRightTrigger;
+        pad.thumb_lx = pState->Gamepad.sThumbLX;
+        pad.thumb_ly = pState->Gamepad.sThumbLY;
+        pad.thumb_rx = pState->Gamepad.sThumbRX;
+        pad.thumb_ry = pState->Gamepad.sThumbRY;
+        pipeline.Apply(pad);
+        pState->Gamepad.wButtons = pad.buttons;
+        pState->Gamepad.bLeftTrigger = pad.left_trigger;
+        pState->Gamepad.bRightTrigger = pad.right_trigger;
+        pState->Gamepad.sThumbLX = pad.thumb_lx;
+        pState->Gamepad.sThumbLY = pad.thumb_ly;
+        pState->Gamepad.sThumbRX = pad.thumb_rx;
+        pState->Gamepad.sThumbRY = pad.thumb_ry;
+
+        // Keyboard / action remaps fire on the button edges seen by the remap stage
+        if (pipeline.params.remap) {
+            display_commander::input_remapping::process_gamepad_input_for_remapping(dwUserIndex,
+                                                                                    pad.buttons_before_remap);
         }
 
-        // Apply stick mapping and center calibration
-        if (shared_state) {
-            ApplyThumbstickProcessing(pState, shared_state);
-        }
-
-        // Process input remapping before updating state
-        display_commander::input_remapping::process_gamepad_input_for_remapping(dwUserIndex, pState);
-
         // Block gamepad input to game when home button is pressed (if enabled)
         // This prevents accidental button presses while using shortcuts
         auto& remapper = display_commander::input_remapping::InputRemapper::get_instance();
@@ -426,8 +437,8 @@ static DWORD ProcessXInputGetState(DWORD dwUserIndex, XINPUT_STATE* pState, std:
 
         // Check if gamepad input should be suppressed - zero out all input if so
         // (includes test checkbox: zeroes output for XInputGetState detours)
-        bool suppress_output = display_commanderhooks::ShouldBlockGamepadInput()
-                               || (shared_state && shared_state->test_gamepad_suppression.load());
+        bool suppress_output =
+            display_commanderhooks::ShouldBlockGamepadInput() || shared_state.test_gamepad_suppression.load();
         if (suppress_output) {
             // Clear all buttons
             pState->Gamepad.wButtons = 0;
@@ -447,11 +458,8 @@ static DWORD ProcessXInputGetState(DWORD dwUserIndex, XINPUT_STATE* pState, std:
     } else {
         // Mark controller as disconnected in shared state
         if (dwUserIndex < XUSER_MAX_COUNT) {
-            auto shared_state = display_commander::widgets::xinput_widget::XInputWidget::GetSharedState();
-            if (shared_state) {
-                shared_state->controller_connected[dwUserIndex] =
-                    display_commander::widgets::xinput_widget::ControllerState::Unconnected;
-            }
+            shared_state.controller_connected[dwUserIndex] =
+                display_commander::widgets::xinput_widget::ControllerState::Unconnected;
         }
         if (dwUserIndex == 0) {
             LogErrorThrottled(10, "XXX XInput Controller %lu: %s failed with error %lu (Perhaps disable steam input?)",
@@ -477,38 +485,17 @@ static DWORD WINAPI XInputGetState_Detour_Impl(size_t module_index, DWORD dwUser
         return ERROR_INVALID_PARAMETER;
     }
 
-    // Get shared state for timing field access
-    auto shared_state = display_commander::widgets::xinput_widget::XInputWidget::GetSharedState();
-    if (!shared_state) {
-        return ERROR_DEVICE_NOT_CONNECTED;
+    // Original function for the specific module: prefer XInputGetStateEx, fall back to XInputGetState
+    XInputGetState_pfn call_original = nullptr;
+    if (module_index < original_xinput_get_state_ex_procs.size()) {
+        call_original = original_xinput_get_state_ex_procs[module_index];
+    }
+    if (call_original == nullptr && module_index < original_xinput_get_state_procs.size()) {
+        call_original = original_xinput_get_state_procs[module_index];
     }
 
-    // Lambda to call original function for the specific module, with sensible fallbacks
-    auto call_original = [module_index](DWORD user_index, XINPUT_STATE* state) -> DWORD {
-        XInputGetStateEx_pfn get_state_ex = nullptr;
-        XInputGetState_pfn get_state = nullptr;
-
-        if (module_index < original_xinput_get_state_ex_procs.size()) {
-            get_state_ex = original_xinput_get_state_ex_procs[module_index];
-        }
-        if (module_index < original_xinput_get_state_procs.size()) {
-            get_state = original_xinput_get_state_procs[module_index];
-        }
-
-        // Prefer the module-specific XInputGetStateEx if available
-        if (get_state_ex != nullptr) {
-            return get_state_ex(user_index, state);
-        }
-
-        // Fallback to the module-specific XInputGetState if available
-        if (get_state != nullptr) {
-            return get_state(user_index, state);
-        }
-
-        return ERROR_DEVICE_NOT_CONNECTED;
-    };
-
-    return ProcessXInputGetState(dwUserIndex, pState, shared_state->xinput_getstate_update_ns, "GetState",
+    auto& shared_state = display_commander::widgets::xinput_widget::XInputWidget::GetSharedStateRef();
+    return ProcessXInputGetState(dwUserIndex, pState, shared_state, shared_state.xinput_getstate_update_ns, "GetState",
                                  call_original);
 }
 
@@ -518,30 +505,14 @@ static DWORD WINAPI XInputGetStateEx_Detour_Impl(size_t module_index, DWORD dwUs
         return ERROR_INVALID_PARAMETER;
     }
 
-    // Get shared state for timing field access
-    auto shared_state = display_commander::widgets::xinput_widget::XInputWidget::GetSharedState();
-    if (!shared_state) {
-        return ERROR_DEVICE_NOT_CONNECTED;
+    XInputGetStateEx_pfn call_original = nullptr;
+    if (module_index < original_xinput_get_state_ex_procs.size()) {
+        call_original = original_xinput_get_state_ex_procs[module_index];
     }
 
-    // Lambda to call original function for the specific module, with sensible fallbacks
-    auto call_original = [module_index](DWORD user_index, XINPUT_STATE* state) -> DWORD {
-        XInputGetStateEx_pfn get_state_ex = nullptr;
-
-        if (module_index < original_xinput_get_state_ex_procs.size()) {
-            get_state_ex = original_xinput_get_state_ex_procs[module_index];
-        }
-
-        // Prefer the module-specific XInputGetStateEx if available
-        if (get_state_ex != nullptr) {
-            return get_state_ex(user_index, state);
-        }
-
-        return ERROR_DEVICE_NOT_CONNECTED;
-    };
-
-    return ProcessXInputGetState(dwUserIndex, pState, shared_state->xinput_getstateex_update_ns, "GetStateEx",
-                                 call_original);
+    auto& shared_state = display_commander::widgets::xinput_widget::XInputWidget::GetSharedStateRef();
+    return ProcessXInputGetState(dwUserIndex, pState, shared_state, shared_state.xinput_getstateex_update_ns,
+                                 "GetStateEx", call_original);
 }
 
 static DWORD WINAPI XInputSetState_Detour_Impl(size_t module_index, DWORD dwUserIndex, XINPUT_VIBRATION* pVibration) {
@@ -619,7 +590,14 @@ static DWORD WINAPI XInputGetCapabilities_Detour_Impl(size_t module_index, DWORD
         return ERROR_DEVICE_NOT_CONNECTED;
     }
 
+    const uint32_t cache_epoch = g_connection_cache.Epoch();
+    const LONGLONG probe_start_ns = utils::get_now_ns();
+    if (g_connection_cache.ServeFromCache(dwUserIndex, probe_start_ns)) {
+        return ERROR_DEVICE_NOT_CONNECTED;
+    }
+
     DWORD result = get_capabilities(dwUserIndex, dwFlags, pCapabilities);
+    RecordConnectionProbe(dwUserIndex, result, probe_start_ns, cache_epoch);
 
     return result;
 }
@@ -632,6 +610,10 @@ std::uint64_t GetXInputGetStateUserIndexZeroLastDurationNs() {
     return g_getstate_userindex0_last_duration_ns.load(std::memory_order_relaxed);
 }
 
+void InvalidateXInputConnectionCache() { g_connection_cache.Invalidate(); }
+
+XInputConnectionCache::Stats GetXInputConnectionCacheStats() { return g_connection_cache.GetStats(); }
+
 bool IsXInputHooksInstalled() { return g_xinput_hooks_installed.load(std::memory_order_relaxed); }
 
 bool InstallXInputHooks(HMODULE xinput_module) {
@@ -1,9 +1,11 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #pragma once
 
+// Source Code <Display Commander>
+#include "xinput_connection_cache.hpp"
+
 // Libraries <standard C++>
 #include <cstdint>
-#include <memory>
 
 // Libraries <Windows.h>
 #include <Windows.h>
@@ -11,14 +13,6 @@
 // Libraries <Windows> — XInput API
 #include <XInput.h>
 
-namespace display_commander {
-namespace widgets {
-namespace xinput_widget {
-struct XInputSharedState;
-}  // namespace xinput_widget
-}  // namespace widgets
-}  // namespace display_commander
-
 namespace display_commanderhooks {
 
 // Function pointer types
@@ -54,9 +48,14 @@ std::uint64_t GetXInputGetStateUserIndexZeroCallCount();
 // Last duration (ns) of XInputGetState_Detour_Impl when dwUserIndex=0; 0 if not yet measured
 std::uint64_t GetXInputGetStateUserIndexZeroLastDurationNs();
 
-// Helper: apply stick mapping and center calibration (reads all params from shared_state)
-void ApplyThumbstickProcessing(
-    XINPUT_STATE* pState,
-    const std::shared_ptr<display_commander::widgets::xinput_widget::XInputSharedState>& shared_state);
+// Device arrival (WM_DEVICECHANGE / WM_INPUT_DEVICE_CHANGE): re-probe all slots cached as disconnected
+void InvalidateXInputConnectionCache();
+
+// Counters of the disconnected-slot cache used by the GetState/GetStateEx/GetCapabilities detours
+XInputConnectionCache::Stats GetXInputConnectionCacheStats();
+
+// Recompile the GetState transform chain (override, A/B swap, stick mapping, gamepad remaps) if the XInput or
+// remapping settings changed. Call after writing them; the detours pick the new chain up on their next poll.
+void SyncXInputPipeline();
 
 }  // namespace display_commanderhooks
@@ -0,0 +1,104 @@
+// Source Code <Display Commander> // XInput transform pipeline (platform-neutral, no Windows includes)
+#include "xinput_pipeline.hpp"
+
+// Source Code <Display Commander>
+#include "../../utils/stick_mapping.hpp"
+
+namespace display_commanderhooks {
+
+namespace {
+
+float Recenter(float value, float center) { return (value - center) / (1 + std::abs(center)); }
+
+void ApplyOverride(const XInputPipelineParams& params, XInputPadState& pad) {
+    // INFINITY means not overridden
+    if (!std::isinf(params.override_lx)) {
+        pad.thumb_lx = FloatToShort(params.override_lx);
+    }
+    if (!std::isinf(params.override_ly)) {
+        pad.thumb_ly = FloatToShort(params.override_ly);
+    }
+    if (!std::isinf(params.override_rx)) {
+        pad.thumb_rx = FloatToShort(params.override_rx);
+    }
+    if (!std::isinf(params.override_ry)) {
+        pad.thumb_ry = FloatToShort(params.override_ry);
+    }
+    pad.buttons |= params.override_buttons;
+}
+
+// A reports as B and B as A (both held stays both held)
+void ApplySwapAB(const XInputPipelineParams& /*params*/, XInputPadState& pad) {
+    const uint16_t buttons = pad.buttons;
+    const uint16_t a = (buttons & kXInputButtonA) != 0 ? kXInputButtonB : 0;
+    const uint16_t b = (buttons & kXInputButtonB) != 0 ? kXInputButtonA : 0;
+    pad.buttons = static_cast<uint16_t>((buttons & ~(kXInputButtonA | kXInputButtonB)) | a | b);
+}
+
+// Recenter + response curve (deadzone, anti-deadzone, max output) for one stick
+template <bool kCircular>
+void ApplyStick(const XInputStickParams& stick, int16_t& sx, int16_t& sy) {
+    float x = Recenter(ShortToFloat(sx), stick.center_x);
+    float y = Recenter(ShortToFloat(sy), stick.center_y);
+    if constexpr (kCircular) {
+        ProcessStickInputRadial(x, y, stick.min_in_x, stick.max_in_x, stick.min_out_x, stick.max_out_x);
+    } else {
+        ProcessStickInputSquare(x, y, stick.min_in_x, stick.max_in_x, stick.min_out_x, stick.max_out_x,
+                                stick.min_in_y, stick.max_in_y, stick.min_out_y, stick.max_out_y);
+    }
+    sx = FloatToShort(x);
+    sy = FloatToShort(y);
+}
+
+template <bool kCircular>
+void ApplyLeftStick(const XInputPipelineParams& params, XInputPadState& pad) {
+    ApplyStick<kCircular>(params.left, pad.thumb_lx, pad.thumb_ly);
+}
+
+template <bool kCircular>
+void ApplyRightStick(const XInputPipelineParams& params, XInputPadState& pad) {
+    ApplyStick<kCircular>(params.right, pad.thumb_rx, pad.thumb_ry);
+}
+
+void ApplyRemap(const XInputPipelineParams& params, XInputPadState& pad) {
+    pad.buttons_before_remap = pad.buttons;
+    pad.buttons = params.gamepad_remaps.Apply(pad.buttons);
+}
+
+void AddTransform(XInputPipeline& pipeline, XInputPipeline::TransformFn fn, const char* name) {
+    pipeline.transforms[pipeline.transform_count] = fn;
+    pipeline.transform_names[pipeline.transform_count] = name;
+    ++pipeline.transform_count;
+}
+
+}  // namespace
+
+XInputPipeline CompileXInputPipeline(const XInputPipelineParams& params) {
+    XInputPipeline pipeline;
+    pipeline.params = params;
+    if (!std::isinf(params.override_lx) || !std::isinf(params.override_ly) || !std::isinf(params.override_rx)
+        || !std::isinf(params.override_ry) || params.override_buttons != 0) {
+        AddTransform(pipeline, ApplyOverride, "override");
+    }
+    if (params.swap_a_b) {
+        AddTransform(pipeline, ApplySwapAB, "swap_a_b");
+    }
+    // Stick stages always run: even default mapping clamps the stick to the unit circle / range
+    if (params.left.circular) {
+        AddTransform(pipeline, ApplyLeftStick<true>, "left_stick_radial");
+    } else {
+        AddTransform(pipeline, ApplyLeftStick<false>, "left_stick_square");
+    }
+    if (params.right.circular) {
+        AddTransform(pipeline, ApplyRightStick<true>, "right_stick_radial");
+    } else {
+        AddTransform(pipeline, ApplyRightStick<false>, "right_stick_square");
+    }
+    // Present whenever remapping is on (it also records the buttons for keyboard / action remap edges)
+    if (params.remap) {
+        AddTransform(pipeline, ApplyRemap, "gamepad_remap");
+    }
+    return pipeline;
+}
+
+}  // namespace display_commanderhooks
@@ -0,0 +1,88 @@
+// Source Code <Display Commander> // XInput transform pipeline (platform-neutral, no Windows includes)
+#pragma once
+
+// Source Code <Display Commander>
+#include "input_remap_table.hpp"
+
+// Libraries <Standard C++>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace display_commanderhooks {
+
+// XINPUT_GAMEPAD bits used by the pipeline
+inline constexpr uint16_t kXInputButtonA = 0x1000;
+inline constexpr uint16_t kXInputButtonB = 0x2000;
+
+// XINPUT_GAMEPAD fields the pipeline transforms, plus the buttons as they entered the remap stage (set by that
+// stage; the edge state machine for keyboard / action remaps runs on them, not on what gamepad remaps produced).
+struct XInputPadState {
+    uint16_t buttons = 0;
+    uint8_t left_trigger = 0;
+    uint8_t right_trigger = 0;
+    int16_t thumb_lx = 0;
+    int16_t thumb_ly = 0;
+    int16_t thumb_rx = 0;
+    int16_t thumb_ry = 0;
+    uint16_t buttons_before_remap = 0;
+};
+
+// Plain-value copy of the XInput settings that shape the game-visible state (read from XInputSharedState).
+struct XInputStickParams {
+    float center_x = 0.0f;
+    float center_y = 0.0f;
+    // Response curve: input [min_in, max_in] -> output [min_out, max_out]; Y equals X when "same axes" is set
+    float min_in_x = 0.0f;
+    float max_in_x = 1.0f;
+    float min_out_x = 0.0f;
+    float max_out_x = 1.0f;
+    float min_in_y = 0.0f;
+    float max_in_y = 1.0f;
+    float min_out_y = 0.0f;
+    float max_out_y = 1.0f;
+    bool circular = true;
+
+    bool operator==(const XInputStickParams&) const = default;
+};
+
+struct XInputPipelineParams {
+    // Override: INFINITY = stick axis not overridden, 0 = no buttons forced
+    float override_lx = INFINITY;
+    float override_ly = INFINITY;
+    float override_rx = INFINITY;
+    float override_ry = INFINITY;
+    uint16_t override_buttons = 0;
+    bool swap_a_b = false;
+    XInputStickParams left;
+    XInputStickParams right;
+    // Input remapping enabled: gamepad-to-gamepad remaps of the InputRemapper's compiled table
+    bool remap = false;
+    display_commander::input_remapping::GamepadRemapList gamepad_remaps;
+
+    bool operator==(const XInputPipelineParams&) const = default;
+};
+
+// Transform chain compiled from XInputPipelineParams when settings change. Only stages that can change the state
+// are included and stick stages are specialized (radial / square), so a poll is a few direct calls with no
+// settings loads, branches on settings or allocations. Order matches the original GetState processing:
+// override -> A/B swap -> left stick (recenter, deadzone, response curve) -> right stick -> gamepad remap.
+struct XInputPipeline {
+    using TransformFn = void (*)(const XInputPipelineParams& params, XInputPadState& pad);
+    static constexpr size_t kMaxTransforms = 5;
+
+    XInputPipelineParams params;
+    std::array<TransformFn, kMaxTransforms> transforms = {};
+    std::array<const char*, kMaxTransforms> transform_names = {};
+    uint32_t transform_count = 0;
+
+    void Apply(XInputPadState& pad) const {
+        for (uint32_t i = 0; i < transform_count; ++i) {
+            transforms[i](params, pad);
+        }
+    }
+};
+
+XInputPipeline CompileXInputPipeline(const XInputPipelineParams& params);
+
+}  // namespace display_commanderhooks
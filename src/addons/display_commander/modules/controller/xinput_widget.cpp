@@ -1322,6 +1322,8 @@ void XInputWidget::LoadSettings() {
             }
         }
     }
+
+    display_commanderhooks::SyncXInputPipeline();
 }
 
 void XInputWidget::SaveSettings() {
@@ -1436,10 +1438,15 @@ void XInputWidget::SaveSettings() {
 
     display_commander::config::set_config_value("DisplayCommander.XInputWidget", "AutofireTriggers",
                                                 autofire_triggers_str);
+
+    // Every settings edit ends here: stick / A-B swap changes take effect through the compiled GetState pipeline
+    display_commanderhooks::SyncXInputPipeline();
 }
 
 std::shared_ptr<XInputSharedState> XInputWidget::GetSharedState() { return g_shared_state; }
 
+XInputSharedState& XInputWidget::GetSharedStateRef() { return *g_shared_state; }
+
 void XInputWidget::DrawIfReady(display_commander::ui::IImGuiWrapper& imgui) {
     if (g_xinput_widget) {
         g_xinput_widget->OnDraw(imgui);
@@ -227,6 +227,8 @@ class XInputWidget {
 
     // Get the shared state (thread-safe)
     static std::shared_ptr<XInputSharedState> GetSharedState();
+    // Same state without a shared_ptr copy (hot paths); g_shared_state lives for the whole process
+    static XInputSharedState& GetSharedStateRef();
 
     /** Draw the XInput settings panel if `InitializeXInputWidget` has run; no-op otherwise. */
     static void DrawIfReady(display_commander::ui::IImGuiWrapper& imgui);
@@ -21,7 +21,9 @@ HotkeysTabSettings::HotkeysTabSettings()
       hotkey_win_left("HotkeyWinLeft", "win left", "DisplayCommander"),
       hotkey_win_right("HotkeyWinRight", "win right", "DisplayCommander"),
       hotkey_move_to_primary("HotkeyMoveToPrimary", "numpad+", "DisplayCommander"),
-      hotkey_move_to_secondary("HotkeyMoveToSecondary", "numpad-", "DisplayCommander") {}
+      hotkey_move_to_secondary("HotkeyMoveToSecondary", "numpad-", "DisplayCommander"),
+      hotkey_frame_capture("HotkeyFrameCapture", "", "DisplayCommander"),
+      hotkey_trace_capture("HotkeyTraceCapture", "", "DisplayCommander") {}
 
 void HotkeysTabSettings::LoadAll() {
     // Get all settings for smart logging
@@ -48,7 +50,9 @@ std::vector<ui::new_ui::SettingBase*> HotkeysTabSettings::GetAllSettings() {
             &hotkey_system_volume_up, &hotkey_system_volume_down, &hotkey_win_down, &hotkey_win_up, &hotkey_win_left,
             &hotkey_win_right,
             &hotkey_move_to_primary,
-            &hotkey_move_to_secondary};
+            &hotkey_move_to_secondary,
+            &hotkey_frame_capture,
+            &hotkey_trace_capture};
 }
 
 }  // namespace settings
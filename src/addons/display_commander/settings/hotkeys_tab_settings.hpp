@@ -46,6 +46,10 @@ class HotkeysTabSettings {
     StringSetting hotkey_move_to_primary;
     StringSetting hotkey_move_to_secondary;
 
+    // Diagnostics
+    StringSetting hotkey_frame_capture;
+    StringSetting hotkey_trace_capture;
+
     // Get all settings for bulk operations
     std::vector<SettingBase*> GetAllSettings();
 };
@@ -24,13 +24,15 @@ MainTabSettings::MainTabSettings()
                           "DisplayCommander"),
       alignment("alignment", 0, {"Center", "Top Left", "Top Right", "Bottom Left", "Bottom Right"}, "DisplayCommander"),
       fps_limiter_enabled("fps_limiter_enabled", true, "DisplayCommander"),
-      fps_limiter_mode("fps_limiter_mode", 0, {"Default", "Reflex (low latency)"}, "DisplayCommander"),
+      fps_limiter_mode("fps_limiter_mode", 0, {"Default", "Reflex (low latency)", "VBlank phase lock"},
+                       "DisplayCommander"),
       fps_limit("fps_limit", 0.0f, 0.0f, 1000.0f, "DisplayCommander", true),
       fps_limit_background("fps_limit_background", 60.0f, 0.0f, 1000.0f, "DisplayCommander", true),
       background_fps_enabled("background_fps_enabled", false, "DisplayCommander"),
       fps_limiter_fg2_enabled("fps_limiter_fg2_enabled", false, "DisplayCommander"),
       fps_limiter_fg2_target_boost_percent("fps_limiter_fg2_target_boost_percent", 0.3f, -3.0f, 3.0f,
                                            "DisplayCommander"),
+      fps_limiter_fg_pacing_model("fps_limiter_fg_pacing_model", true, "DisplayCommander"),
       suppress_reflex_sleep("suppress_reflex_sleep", false, "DisplayCommander"),
       inject_reflex("inject_reflex", false, "DisplayCommander"),
       onpresent_sync_low_latency_ratio(
@@ -39,6 +41,13 @@ MainTabSettings::MainTabSettings()
            "62.5% Display / 37.5% Input", "50% Display / 50% Input", "37.5% Display / 62.5% Input",
            "25% Display / 75% Input", "12.5% Display / 87.5% Input", "0% Display / 100% Input"},
           "DisplayCommander"),  // Default to 100% Display / 0% Input (current behavior)
+      onpresent_sync_adaptive_bias_enabled("onpresent_sync_adaptive_bias_enabled", false, "DisplayCommander"),
+      onpresent_sync_adaptive_bias_target("onpresent_sync_adaptive_bias_target", 0,
+                                          {"Late frames (%)", "Frame time deviation (ms)"}, "DisplayCommander"),
+      onpresent_sync_adaptive_bias_late_pct("onpresent_sync_adaptive_bias_late_pct", 2.0f, 0.5f, 25.0f,
+                                            "DisplayCommander"),
+      onpresent_sync_adaptive_bias_deviation_ms("onpresent_sync_adaptive_bias_deviation_ms", 0.5f, 0.05f, 5.0f,
+                                                "DisplayCommander"),
       onpresent_reflex_mode("onpresent_reflex_mode", static_cast<int>(OnPresentReflexMode::kLowLatency),
                             {"Low latency", "Low Latency + boost (can cause issues)", "Off", "Game Defaults"}, "DisplayCommander"),
       reflex_limiter_reflex_mode("reflex_limiter_reflex_mode", static_cast<int>(OnPresentReflexMode::kLowLatency),
@@ -64,11 +73,16 @@ MainTabSettings::MainTabSettings()
       delay_present_start_after_sim_enabled("delay_present_start_after_sim_enabled_doff", false, "DisplayCommander"),
       delay_present_start_frames("delay_present_start_frames", 1.0f, 0.0f, 3.0f, "DisplayCommander"),
       safe_mode_fps_limiter("safe_mode_fps_limiter", false, "DisplayCommander"),
+      vblank_lock_offset_ms("vblank_lock_offset_ms", 1.0f, 0.0f, 10.0f, "DisplayCommander"),
+      vblank_lock_tear_line_enabled("vblank_lock_tear_line_enabled", false, "DisplayCommander"),
+      vblank_lock_tear_line_percent("vblank_lock_tear_line_percent", 5.0f, 0.0f, 100.0f, "DisplayCommander"),
       selected_reshade_runtime_index("selected_reshade_runtime_index", 0, 0, 31, "DisplayCommander"),
       prevent_tearing("prevent_tearing", false, "DisplayCommander"),
       audio_mute("audio_mute", false, "DisplayCommander"),
       mute_in_background("mute_in_background", false, "DisplayCommander"),
       mute_in_background_if_other_audio("mute_in_background_if_other_audio", false, "DisplayCommander"),
+      mute_in_background_other_audio_hold_ms("mute_in_background_other_audio_hold_ms", 2000, 0, 10000,
+                                             "DisplayCommander"),
       enable_default_chords("enable_default_chords", true, "DisplayCommander"),
       guide_button_solo_ui_toggle_only("guide_button_solo_ui_toggle_only", true, "DisplayCommander"),
       keyboard_input_blocking("keyboard_input_blocking", static_cast<int>(InputBlockingMode::kEnabledInBackground),
@@ -121,6 +135,14 @@ MainTabSettings::MainTabSettings()
       show_driver_dlss_rr_preset("show_driver_dlss_rr_preset", false, "DisplayCommander"),
       show_fps_limiter_src("show_fps_limiter_src", false, "DisplayCommander"),
       show_fps_limiter_late_frames_pct("show_fps_limiter_late_frames_pct", false, "DisplayCommander"),
+      show_overlay_adaptive_delay_bias("show_overlay_adaptive_delay_bias", false, "DisplayCommander"),
+      show_overlay_fg_pacing("show_overlay_fg_pacing", false, "DisplayCommander"),
+      show_overlay_hitches("show_overlay_hitches", false, "DisplayCommander"),
+      hitch_threshold_multiplier("hitch_threshold_multiplier", 2.0f, 1.5f, 5.0f, "DisplayCommander"),
+      frame_capture_duration_seconds("frame_capture_duration_seconds", 60, 0, 3600, "DisplayCommander"),
+      trace_duration_seconds("trace_duration_seconds", 10, 0, 300, "DisplayCommander"),
+      trace_detour_sites("trace_detour_sites", "Present", "DisplayCommander"),
+      show_overlay_bound_state("show_overlay_bound_state", false, "DisplayCommander"),
       show_playtime("show_playtime", false, "DisplayCommander"),
       show_overlay_vu_bars("show_overlay_vu_bars", false, "DisplayCommander"),
       show_overlay_vram("show_overlay_vram", false, "DisplayCommander"),
@@ -171,9 +193,14 @@ MainTabSettings::MainTabSettings()
         &background_fps_enabled,
         &fps_limiter_fg2_enabled,
         &fps_limiter_fg2_target_boost_percent,
+        &fps_limiter_fg_pacing_model,
         &suppress_reflex_sleep,
         &inject_reflex,
         &onpresent_sync_low_latency_ratio,
+        &onpresent_sync_adaptive_bias_enabled,
+        &onpresent_sync_adaptive_bias_target,
+        &onpresent_sync_adaptive_bias_late_pct,
+        &onpresent_sync_adaptive_bias_deviation_ms,
         &onpresent_reflex_mode,
         &reflex_limiter_reflex_mode,
         &reflex_disabled_limiter_mode,
@@ -186,11 +213,15 @@ MainTabSettings::MainTabSettings()
         &delay_present_start_after_sim_enabled,
         &delay_present_start_frames,
         &safe_mode_fps_limiter,
+        &vblank_lock_offset_ms,
+        &vblank_lock_tear_line_enabled,
+        &vblank_lock_tear_line_percent,
         &selected_reshade_runtime_index,
         &prevent_tearing,
         &audio_mute,
         &mute_in_background,
         &mute_in_background_if_other_audio,
+        &mute_in_background_other_audio_hold_ms,
         &enable_default_chords,
         &guide_button_solo_ui_toggle_only,
         &keyboard_input_blocking,
@@ -235,6 +266,14 @@ MainTabSettings::MainTabSettings()
         &show_driver_dlss_rr_preset,
         &show_fps_limiter_src,
         &show_fps_limiter_late_frames_pct,
+        &show_overlay_adaptive_delay_bias,
+        &show_overlay_fg_pacing,
+        &show_overlay_hitches,
+        &hitch_threshold_multiplier,
+        &frame_capture_duration_seconds,
+        &trace_duration_seconds,
+        &trace_detour_sites,
+        &show_overlay_bound_state,
         &show_playtime,
         &show_overlay_vu_bars,
         &show_overlay_vram,
@@ -46,10 +46,19 @@ class MainTabSettings {
     ui::new_ui::BoolSetting fps_limiter_fg2_enabled;
     /** Extra target FPS for FG2 limiter as percent of main cap (0-10). Default 1%. */
     ui::new_ui::FloatSetting fps_limiter_fg2_target_boost_percent;
+    /** Frame generation aware limiter: divide by the multiplier measured from real vs output presents once stable,
+     * instead of DLSS-G MultiFrameCount. Default on. */
+    ui::new_ui::BoolSetting fps_limiter_fg_pacing_model;
     ui::new_ui::BoolSetting suppress_reflex_sleep;
     /** When true and native Reflex is not active, addon injects Reflex (sleep + markers). Default false. */
     ui::new_ui::BoolSetting inject_reflex;
     ui::new_ui::ComboSetting onpresent_sync_low_latency_ratio;
+    /** OnPresentSync: PI controller adjusts delay_bias per frame (starts from onpresent_sync_low_latency_ratio). */
+    ui::new_ui::BoolSetting onpresent_sync_adaptive_bias_enabled;
+    /** Adaptive delay_bias target: 0 = late frames (%), 1 = frame time deviation (ms RMS). */
+    ui::new_ui::ComboSetting onpresent_sync_adaptive_bias_target;
+    ui::new_ui::FloatSetting onpresent_sync_adaptive_bias_late_pct;
+    ui::new_ui::FloatSetting onpresent_sync_adaptive_bias_deviation_ms;
     ui::new_ui::ComboSettingEnum<OnPresentReflexMode> onpresent_reflex_mode;
     ui::new_ui::ComboSettingEnum<OnPresentReflexMode> reflex_limiter_reflex_mode;  // Used when FPS limiter is Reflex
     ui::new_ui::ComboSettingEnum<OnPresentReflexMode>
@@ -66,6 +75,12 @@ class MainTabSettings {
     ui::new_ui::BoolSetting delay_present_start_after_sim_enabled;
     ui::new_ui::FloatSetting delay_present_start_frames;
     ui::new_ui::BoolSetting safe_mode_fps_limiter;
+    /** VBlank phase lock limiter: present this long before the target vblank (covers present -> flip latency). */
+    ui::new_ui::FloatSetting vblank_lock_offset_ms;
+    /** VBlank phase lock limiter with VSync off: also place the tear line at vblank_lock_tear_line_percent. */
+    ui::new_ui::BoolSetting vblank_lock_tear_line_enabled;
+    /** Tear line position in percent of the screen height (0 = top, 100 = bottom). */
+    ui::new_ui::FloatSetting vblank_lock_tear_line_percent;
     /** Selected ReShade runtime index (0 = first). When multiple runtimes exist, non-zero selects that runtime. */
     ui::new_ui::IntSetting selected_reshade_runtime_index;
 
@@ -76,6 +91,7 @@ class MainTabSettings {
     ui::new_ui::BoolSetting audio_mute;
     ui::new_ui::BoolSetting mute_in_background;
     ui::new_ui::BoolSetting mute_in_background_if_other_audio;
+    ui::new_ui::IntSetting mute_in_background_other_audio_hold_ms;  // Silence before unmuting (transient sounds)
 
     // Input Remapping Settings
     ui::new_ui::BoolSetting enable_default_chords;
@@ -146,6 +162,20 @@ class MainTabSettings {
     ui::new_ui::BoolSetting show_fps_limiter_src;
     /** Show percentage of recent frames where OnPresentSync FPS limiter started late. */
     ui::new_ui::BoolSetting show_fps_limiter_late_frames_pct;
+    ui::new_ui::BoolSetting show_overlay_adaptive_delay_bias;
+    ui::new_ui::BoolSetting show_overlay_fg_pacing;
+    /** Hitch count and rate (per minute) on the OSD (feature/hitch). */
+    ui::new_ui::BoolSetting show_overlay_hitches;
+    /** Hitch detector: a frame is a hitch above this multiple of the rolling median frame time. Default 2x. */
+    ui::new_ui::FloatSetting hitch_threshold_multiplier;
+    /** Frame capture (feature/frame_capture): stop after this many seconds; 0 = until stopped. */
+    ui::new_ui::IntSetting frame_capture_duration_seconds;
+    /** Trace export (feature/trace): stop after this many seconds; 0 = until stopped. */
+    ui::new_ui::IntSetting trace_duration_seconds;
+    /** Trace export: CALL_GUARD sites traced as spans (comma-separated substrings of "Function:line"). */
+    ui::new_ui::StringSetting trace_detour_sites;
+    /** Show rolling CPU/GPU bound classification with confidence on the OSD (feature/frame_bound). */
+    ui::new_ui::BoolSetting show_overlay_bound_state;
     ui::new_ui::BoolSetting show_playtime;
     ui::new_ui::BoolSetting show_overlay_vu_bars;
     /** DXGI GPU video memory used / budget on the OSD. */
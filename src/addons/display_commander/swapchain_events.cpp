@@ -1,4 +1,11 @@
 #include "config/display_commander_config.hpp"
+#include "feature/adaptive_delay_bias/adaptive_delay_bias.hpp"
+#include "feature/fg_pacing/fg_pacing.hpp"
+#include "feature/frame_bound/frame_bound.hpp"
+#include "feature/frame_capture/frame_capture.hpp"
+#include "feature/hitch/hitch.hpp"
+#include "feature/trace/trace.hpp"
+#include "feature/vblank_lock/vblank_lock.hpp"
 #include "features/smooth_motion/smooth_motion.hpp"
 #include "globals.hpp"
 #include "hooks/dxgi/dxgi_gpu_completion.hpp"
@@ -410,6 +417,7 @@ void RecordFrameTime(FrameTimeMode reason) {
     if (dt > 0.0) {
         PerfSample sample{.dt = static_cast<float>(dt)};
         g_perf_ring.Record(sample);
+        display_commander::feature::hitch::RecordHitchFrame(now_ns, now_ns - previous_ns);
         previous_ns = now_ns;
     }
 }
@@ -706,8 +714,21 @@ bool OnCreateSwapchainCapture(reshade::api::device_api api, reshade::api::swapch
 
 void OnDestroySwapchain(reshade::api::swapchain* swapchain, bool resize) {
     CALL_GUARD_NO_TS();
-    (void)resize;
-    (void)swapchain;
+    if (swapchain == nullptr || resize) {
+        return;
+    }
+    display_commander::feature::vblank_lock::ForgetVblankSwapchain(
+        static_cast<uint64_t>(reinterpret_cast<uintptr_t>(swapchain->get_hwnd())));
+    // Release the per-swapchain GPU completion fence ring (keyed by IDXGISwapChain*, which may be reused).
+    const reshade::api::device_api api = swapchain->get_device()->get_api();
+    if (api == reshade::api::device_api::d3d12 || api == reshade::api::device_api::d3d11
+        || api == reshade::api::device_api::d3d10) {
+        Microsoft::WRL::ComPtr<IDXGISwapChain> dxgi_swapchain;
+        auto* unknown = reinterpret_cast<IUnknown*>(swapchain->get_native());
+        if (unknown != nullptr && SUCCEEDED(unknown->QueryInterface(IID_PPV_ARGS(&dxgi_swapchain)))) {
+            display_commanderhooks::dxgi::ReleaseGPUCompletionForSwapchain(dxgi_swapchain.Get());
+        }
+    }
 }
 
 void OnInitSwapchain(reshade::api::swapchain* swapchain, bool resize) {
@@ -935,6 +956,8 @@ void OnPresentUpdateAfter2(bool frame_generation_aware) {
         next_fd.sleep_post_present_start_time_ns.store(0);
         next_fd.sleep_post_present_end_time_ns.store(0);
     }
+    display_commander::feature::frame_capture::RecordFrameCaptureFrame(current_frame_id);
+    display_commander::feature::trace::RecordTraceFrame(current_frame_id);
 
     g_global_frame_id.fetch_add(1);
     const LONGLONG now_real_ns = utils::get_real_time_ns();
@@ -983,6 +1006,7 @@ static OnPresentReflexMode GetEffectiveReflexMode() {
     // Use selected FPS limiter mode only (not checkbox). Reflex setting applies in all modes even when limiter off.
     switch (s_fps_limiter_mode.load()) {
         case FpsLimiterMode::kOnPresentSync:
+        case FpsLimiterMode::kVblankLocked:
             return static_cast<OnPresentReflexMode>(settings::g_mainTabSettings.onpresent_reflex_mode.GetValue());
         case FpsLimiterMode::kReflex:
             return static_cast<OnPresentReflexMode>(settings::g_mainTabSettings.reflex_limiter_reflex_mode.GetValue());
@@ -1027,9 +1051,11 @@ bool GetReflexSleepEnabled() {
         // true if not native nvapi_d3d_sleep in last 1s
         return g_nvapi_last_sleep_timestamp_ns.load() < utils::get_now_ns() - 1 * utils::SEC_TO_NS;
     }
-    if (s_fps_limiter_mode.load() == FpsLimiterMode::kOnPresentSync) {
-        // true if not native nvapi_d3d_sleep in last 1s
-        return g_nvapi_last_sleep_timestamp_ns.load() < utils::get_now_ns() - 1 * utils::SEC_TO_NS;
+    if (s_fps_limiter_mode.load() == FpsLimiterMode::kOnPresentSync
+        || s_fps_limiter_mode.load() == FpsLimiterMode::kVblankLocked) {
+        // true if not native nvapi_d3d_sleep in last 1s, unless Reflex auto-configure paused it (CPU-bound)
+        return g_nvapi_last_sleep_timestamp_ns.load() < utils::get_now_ns() - 1 * utils::SEC_TO_NS
+               && display_commander::feature::frame_bound::IsInjectedReflexSleepRecommended();
     }
     return false;
 }
@@ -1126,8 +1152,11 @@ void HandleFpsLimiterPre(bool from_present_detour, bool frame_generation_aware =
     if (frame_generation_aware) {
         CALL_GUARD(start_time_ns);
 
-        if (ngx_lite_snapshot.fg_mode >= 2) {
-            target_fps /= static_cast<float>(ngx_lite_snapshot.fg_mode);
+        // Limit on the real frame cadence: measured multiplier once stable, else DLSS-G MultiFrameCount
+        const int fg_multiplier =
+            display_commander::feature::fg_pacing::GetFgPacingMultiplier(ngx_lite_snapshot.fg_mode);
+        if (fg_multiplier >= 2) {
+            target_fps /= static_cast<float>(fg_multiplier);
         }
         static float last_target_fps = -1.0f;  // unset
 
@@ -1188,6 +1217,8 @@ void HandleFpsLimiterPre(bool from_present_detour, bool frame_generation_aware =
                 float delay_bias = GetDelayBiasFromRatio(ratio_index);
 
                 if (target_fps >= 1.0f) {
+                    // Adaptive: closed-loop bias, started from the ratio selector
+                    delay_bias = display_commander::feature::adaptive_delay_bias::GetAdaptiveDelayBias(delay_bias);
                     CALL_GUARD(start_time_ns);
                     // Calculate frame time
                     float adjusted_target_fps = target_fps;
@@ -1239,6 +1270,8 @@ void HandleFpsLimiterPre(bool from_present_detour, bool frame_generation_aware =
                         was_late = true;
                     }
                     RecordFpsLimiterLateFrameSample(start_time_ns, was_late);
+                    display_commander::feature::adaptive_delay_bias::RecordAdaptiveDelayBiasFrame(
+                        ideal_frame_start_ns, frame_time_ns, was_late);
                     CALL_GUARD(start_time_ns);
                     // Record when frame processing actually started
                     g_onpresent_sync_frame_start_ns.store(ideal_frame_start_ns);
@@ -1251,6 +1284,27 @@ void HandleFpsLimiterPre(bool from_present_detour, bool frame_generation_aware =
 
                 break;
             }
+            case FpsLimiterMode::kVblankLocked: {
+                // Release present a fixed lead before the vblank this frame is scheduled for
+                if (target_fps >= 1.0f) {
+                    CALL_GUARD(start_time_ns);
+                    namespace vblank_lock = display_commander::feature::vblank_lock;
+                    vblank_lock::VblankTarget target;
+                    if (!vblank_lock::ScheduleVblankLockedPresent(start_time_ns, target_fps, &target)) {
+                        // Display timing not locked yet: space frames by frame time meanwhile (per swapchain)
+                        const auto swapchain_key =
+                            static_cast<uint64_t>(reinterpret_cast<uintptr_t>(g_last_swapchain_hwnd.load()));
+                        target = vblank_lock::ScheduleVblankFallbackPresent(swapchain_key, start_time_ns, target_fps);
+                    }
+                    if (target.release_ns > start_time_ns) {
+                        constexpr LONGLONG k_fps_limiter_max_wait_ns = 100 * utils::NS_TO_MS;
+                        utils::wait_until_ns((std::min)(target.release_ns, start_time_ns + k_fps_limiter_max_wait_ns));
+                    }
+                    late_amount_ns.store(target.late_ns);
+                    RecordFpsLimiterLateFrameSample(start_time_ns, target.late_ns > 0);
+                }
+                break;
+            }
         }
     }
     {
@@ -5,6 +5,8 @@
 #include "display_settings.hpp"
 #include "display/display_cache.hpp"
 #include "dxgi/vram_info.hpp"
+#include "feature/adaptive_delay_bias/adaptive_delay_bias.hpp"
+#include "feature/vblank_lock/vblank_lock.hpp"
 #include "globals.hpp"
 #include "hooks/nvidia/ngx_hooks.hpp"
 #include "latency/reflex_provider.hpp"
@@ -135,11 +135,60 @@ void DrawDxgiNativeReflexStatusOnSameLine(display_commander::ui::IImGuiWrapper&
 
 static void DrawDisplaySettings_FpsLimiterAdvanced(display_commander::ui::IImGuiWrapper& imgui,
                                                   float fps_limiter_checkbox_column_gutter);
+static void DrawDisplaySettings_FpsLimiterAdaptiveDelayBias(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace adaptive = display_commander::feature::adaptive_delay_bias;
+    if (CheckboxSetting(settings::g_mainTabSettings.onpresent_sync_adaptive_bias_enabled, "Adaptive ratio", imgui)) {
+    }
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "Adjust the Display / Input ratio every frame (PI controller).\n\n"
+            "Moves toward more input (lower latency) while late frames / frame time deviation stay below the "
+            "target, and back toward display when load spikes push them above it.\n"
+            "Starts from the Display / Input Ratio selected above.");
+    }
+    if (!settings::g_mainTabSettings.onpresent_sync_adaptive_bias_enabled.GetValue()) {
+        return;
+    }
+    imgui.Indent();
+    if (ComboSettingWrapper(settings::g_mainTabSettings.onpresent_sync_adaptive_bias_target, "Hold", imgui, 300.f)) {
+    }
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "Late frames: share of frames that started after their paced start time.\n"
+            "Frame time deviation: RMS difference between frame start spacing and the target frame time.");
+    }
+    if (settings::g_mainTabSettings.onpresent_sync_adaptive_bias_target.GetValue()
+        == static_cast<int>(adaptive::DelayBiasControlTarget::kFrameTimeDeviation)) {
+        SliderFloatSetting(settings::g_mainTabSettings.onpresent_sync_adaptive_bias_deviation_ms, "Target deviation",
+                           "%.2f ms", imgui);
+    } else {
+        SliderFloatSetting(settings::g_mainTabSettings.onpresent_sync_adaptive_bias_late_pct, "Target late frames",
+                           "%.1f%%", imgui);
+    }
+    const adaptive::AdaptiveDelayBiasStatus status = adaptive::GetAdaptiveDelayBiasStatus();
+    if (status.enabled) {
+        const char* unit =
+            status.controller.target == adaptive::DelayBiasControlTarget::kFrameTimeDeviation ? "ms" : "%";
+        imgui.TextColored(ui::colors::TEXT_DIMMED, "Bias %.3f (%.0f%% Input) | measured %.2f %s / target %.2f %s%s",
+                          status.controller.output, status.controller.output * 100.0, status.controller.measurement,
+                          unit, status.controller.setpoint, unit, status.controller.saturated ? " | saturated" : "");
+        if (imgui.IsItemHovered()) {
+            imgui.SetTooltipEx("Error %.2f (normalized)\nP %.3f + I %.3f\nFrames: %llu", status.controller.error,
+                               status.controller.proportional, status.controller.integral,
+                               static_cast<unsigned long long>(status.controller.frames));
+        }
+    } else {
+        imgui.TextColored(ui::colors::TEXT_DIMMED, "Waiting for limited frames");
+    }
+    imgui.Unindent();
+}
+
 static void DrawDisplaySettings_FpsLimiterOnPresentSync(display_commander::ui::IImGuiWrapper& imgui,
                                                         const std::function<void()>& drawPclStatsCheckbox,
                                                         float fps_limiter_checkbox_column_gutter);
 static void DrawDisplaySettings_FpsLimiterReflex(display_commander::ui::IImGuiWrapper& imgui,
                                                  const std::function<void()>& drawPclStatsCheckbox);
+static void DrawDisplaySettings_FpsLimiterVblankLock(display_commander::ui::IImGuiWrapper& imgui);
 
 void DrawQuickFpsLimitChanger(display_commander::ui::IImGuiWrapper& imgui) {
     (void)imgui;
@@ -261,11 +310,12 @@ void DrawDisplaySettings_FpsLimiter(display_commander::ui::IImGuiWrapper& imgui)
     CALL_GUARD_NO_TS();
     imgui.Spacing();
 
-    const char* mode_items[] = {"DC's fps limiter", "NVIDIA Reflex (DX11/DX12 only, Vulkan requires native reflex)"};
+    const char* mode_items[] = {"DC's fps limiter", "NVIDIA Reflex (DX11/DX12 only, Vulkan requires native reflex)",
+                                "VBlank phase lock (fixed refresh)"};
 
     int current_item = settings::g_mainTabSettings.fps_limiter_mode.GetValue();
-    if (current_item < 0 || current_item > 1) {
-        current_item = (current_item < 0) ? 0 : 1;
+    if (current_item < 0 || current_item > 2) {
+        current_item = (current_item < 0) ? 0 : 2;
         settings::g_mainTabSettings.fps_limiter_mode.SetValue(current_item);
         s_fps_limiter_mode.store(static_cast<FpsLimiterMode>(current_item));
     }
@@ -351,7 +401,7 @@ void DrawDisplaySettings_FpsLimiter(display_commander::ui::IImGuiWrapper& imgui)
         imgui.BeginDisabled();
     }
     imgui.SetNextItemWidth(get_fps_limiter_control_width());
-    if (imgui.Combo("FPS Limiter Mode", &current_item, mode_items, 2)) {
+    if (imgui.Combo("FPS Limiter Mode", &current_item, mode_items, 3)) {
         settings::g_mainTabSettings.fps_limiter_mode.SetValue(current_item);
         s_fps_limiter_mode.store(static_cast<FpsLimiterMode>(current_item));
         FpsLimiterMode mode = s_fps_limiter_mode.load();
@@ -360,6 +410,8 @@ void DrawDisplaySettings_FpsLimiter(display_commander::ui::IImGuiWrapper& imgui)
             settings::g_advancedTabSettings.reflex_auto_configure.SetValue(true);
         } else if (mode == FpsLimiterMode::kOnPresentSync) {
             LogInfo("FPS Limiter: OnPresent Frame Synchronizer");
+        } else if (mode == FpsLimiterMode::kVblankLocked) {
+            LogInfo("FPS Limiter: VBlank phase lock");
         }
 
         if (mode == FpsLimiterMode::kReflex && prev_item != static_cast<int>(FpsLimiterMode::kReflex)) {
@@ -371,6 +423,8 @@ void DrawDisplaySettings_FpsLimiter(display_commander::ui::IImGuiWrapper& imgui)
             "Choose limiter mode (when FPS limiter is enabled):\n"
             "Default - Various presets.\n"
             "Reflex - NVIDIA Reflex library.\n"
+            "VBlank phase lock - Presents a fixed time before the display's vblank (fixed refresh displays; the limit\n"
+            "  snaps to refresh rate / N).\n"
             "\n"
             " FPS limiter source: %s",
             GetChosenFpsLimiterSiteName());
@@ -620,6 +674,8 @@ static void DrawDisplaySettings_FpsLimiterOnPresentSync(display_commander::ui::I
 
                 imgui.End();
             }
+
+            DrawDisplaySettings_FpsLimiterAdaptiveDelayBias(imgui);
         }
     }
 
@@ -863,6 +919,54 @@ static void DrawDisplaySettings_FpsLimiterReflex(display_commander::ui::IImGuiWr
     }
 }
 
+static void DrawDisplaySettings_FpsLimiterVblankLock(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace vblank_lock = display_commander::feature::vblank_lock;
+    const vblank_lock::VblankLockStatus status = vblank_lock::GetVblankLockStatus();
+    if (status.sampler_error != nullptr) {
+        imgui.TextColored(ui::colors::TEXT_WARNING, ICON_FK_WARNING " VBlank sampling failed: %s",
+                          status.sampler_error);
+    } else if (status.lock.locked) {
+        imgui.TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f),
+                          ICON_FK_OK " Locked: %.3f Hz, every %u refresh(es), phase error %.0f us, missed vblanks %llu",
+                          status.lock.period_ms > 0.0 ? 1000.0 / status.lock.period_ms : 0.0, status.interval_vblanks,
+                          status.lock.phase_error_rms_us,
+                          static_cast<unsigned long long>(status.scheduler.missed_vblanks));
+    } else {
+        imgui.TextColored(ui::colors::TEXT_WARNING, "Locking to the display's vblank...");
+    }
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "The display's vblank phase and period are measured from D3DKMT vblank waits and scanline reads on a "
+            "background thread; the estimate follows the display clock, so it does not drift.\n"
+            "The FPS limit is rounded to the refresh rate divided by a whole number. Until the lock is acquired, "
+            "frames are spaced by frame time.\n"
+            "Missed vblanks: frames that were ready too late for their planned refresh.");
+    }
+    imgui.SetNextItemWidth(kFpsLimiterItemWidth);
+    SliderFloatSetting(settings::g_mainTabSettings.vblank_lock_offset_ms, "Present offset before vblank", "%.2f ms",
+                       imgui);
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "How long before vblank present is issued. It must cover present -> flip latency; raise it if frames "
+            "show up one refresh late (missed vblanks), lower it for less latency.");
+    }
+    CheckboxSetting(settings::g_mainTabSettings.vblank_lock_tear_line_enabled, "Tear line targeting", imgui);
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "For VSync off / tearing presents: also shift present so the tear line lands at a fixed screen height "
+            "instead of wandering. Put it near the top or bottom edge where it is least visible.");
+    }
+    if (settings::g_mainTabSettings.vblank_lock_tear_line_enabled.GetValue()) {
+        imgui.SameLine();
+        imgui.SetNextItemWidth(300.0f);
+        SliderFloatSetting(settings::g_mainTabSettings.vblank_lock_tear_line_percent, "Tear line", "%.0f%% of height",
+                           imgui);
+        if (imgui.IsItemHovered()) {
+            imgui.SetTooltipEx("0%% = top edge, 100%% = bottom edge (vblank).");
+        }
+    }
+}
+
 static void DrawDisplaySettings_FpsLimiterAdvanced(display_commander::ui::IImGuiWrapper& imgui,
                                                   float fps_limiter_checkbox_column_gutter) {
     (void)imgui;
@@ -944,7 +1048,7 @@ static void DrawDisplaySettings_FpsLimiterAdvanced(display_commander::ui::IImGui
         //PushFpsLimiterSliderColumnAlign(imgui, fps_limiter_checkbox_column_gutter, true);
         const FpsLimiterMode mode = static_cast<FpsLimiterMode>(current_item);
         bool combo_changed = false;
-        if (mode == FpsLimiterMode::kOnPresentSync) {
+        if (mode == FpsLimiterMode::kOnPresentSync || mode == FpsLimiterMode::kVblankLocked) {
             combo_changed =
                 ComboSettingEnumWrapper(settings::g_mainTabSettings.onpresent_reflex_mode, "Reflex", imgui, 600.f);
         } else if (mode == FpsLimiterMode::kReflex) {
@@ -956,9 +1060,10 @@ static void DrawDisplaySettings_FpsLimiterAdvanced(display_commander::ui::IImGui
         }
         (void)combo_changed;
         if (imgui.IsItemHovered()) {
-            const char* context = (mode == FpsLimiterMode::kOnPresentSync) ? "On Present Sync"
-                                  : (mode == FpsLimiterMode::kReflex)      ? "Reflex FPS limiter"
-                                                                           : "FPS limiter off";
+            const char* context = (mode == FpsLimiterMode::kOnPresentSync)  ? "On Present Sync"
+                                  : (mode == FpsLimiterMode::kReflex)       ? "Reflex FPS limiter"
+                                  : (mode == FpsLimiterMode::kVblankLocked) ? "VBlank phase lock"
+                                                                            : "FPS limiter off";
             std::string tooltip =
                 std::string("NVIDIA Reflex (used for ") + context + ").\n\n"
                 + "Low latency: Enables Reflex Low Latency Mode (default).\n"
@@ -999,6 +1104,10 @@ static void DrawDisplaySettings_FpsLimiterAdvanced(display_commander::ui::IImGui
     if (current_item == static_cast<int>(FpsLimiterMode::kReflex)) {
         DrawDisplaySettings_FpsLimiterReflex(imgui, DrawPclStatsCheckbox);
     }
+
+    if (current_item == static_cast<int>(FpsLimiterMode::kVblankLocked)) {
+        DrawDisplaySettings_FpsLimiterVblankLock(imgui);
+    }
 }
 
 }  // namespace ui::new_ui
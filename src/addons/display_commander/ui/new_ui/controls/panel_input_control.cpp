@@ -28,8 +28,10 @@ void DrawMainTabOptionalPanelInputControl(display_commander::ui::IImGuiWrapper&
         // setwidth for each combo
         const float combo_width = 400;
         imgui.SetNextItemWidth(combo_width);
-        ui::new_ui::ComboSettingEnumWrapper(settings::g_mainTabSettings.keyboard_input_blocking, "##Keyboard",
-                                                imgui);
+        if (ui::new_ui::ComboSettingEnumWrapper(settings::g_mainTabSettings.keyboard_input_blocking, "##Keyboard",
+                                                imgui)) {
+            display_commanderhooks::RefreshMessageSuppressionFilter();
+        }
         if (imgui.IsItemHovered()) {
             imgui.SetTooltipEx("Controls keyboard input blocking behavior.");
         }
@@ -37,7 +39,9 @@ void DrawMainTabOptionalPanelInputControl(display_commander::ui::IImGuiWrapper&
         imgui.NextColumn();
 
         imgui.SetNextItemWidth(combo_width);
-        ui::new_ui::ComboSettingEnumWrapper(settings::g_mainTabSettings.mouse_input_blocking, "##Mouse", imgui);
+        if (ui::new_ui::ComboSettingEnumWrapper(settings::g_mainTabSettings.mouse_input_blocking, "##Mouse", imgui)) {
+            display_commanderhooks::RefreshMessageSuppressionFilter();
+        }
         if (imgui.IsItemHovered()) {
             imgui.SetTooltipEx("Controls mouse input blocking behavior.");
         }
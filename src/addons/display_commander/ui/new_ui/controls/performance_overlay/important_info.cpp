@@ -1,7 +1,9 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 // Headers <Display Commander>
 #include "performance_overlay_internal.hpp"
+#include "feature/frame_capture/frame_capture.hpp"
 #include "features/smooth_motion/smooth_motion.hpp"
+#include "hooks/dxgi/dxgi_gpu_completion.hpp"
 #include "hooks/nvidia/ngx_hooks.hpp"
 #include "nvapi/nvapi_init.hpp"
 #include "swapchain_events.hpp"
@@ -114,6 +116,16 @@ static void DrawImportantInfo_FrameTimeGraphContent(display_commander::ui::IImGu
             imgui.PopStyleColor();
             imgui.SameLine();
             imgui.TextColored(ui::colors::TEXT_SUCCESS, "GPU Fence Active");
+            const auto gpu_stats = display_commanderhooks::dxgi::GetGPUCompletionStats();
+            imgui.SameLine();
+            imgui.TextColored(ui::colors::TEXT_VALUE, "(in flight: %zu, completed: %llu, skipped: %llu)",
+                              gpu_stats.in_flight, static_cast<unsigned long long>(gpu_stats.completed),
+                              static_cast<unsigned long long>(gpu_stats.dropped_ring_full + gpu_stats.signal_failures));
+            if (imgui.IsItemHovered()) {
+                imgui.SetTooltipEx(
+                    "Per-swapchain fence ring: frames waiting for the GPU, frames whose GPU completion was stamped, "
+                    "and frames skipped because the ring was full or the fence signal failed.");
+            }
             imgui.Unindent();
         }
     }
@@ -274,6 +286,51 @@ static void DrawImportantInfo_OverlayControls(display_commander::ui::IImGuiWrapp
         }
         imgui.NextColumn();
 
+        bool show_overlay_adaptive_delay_bias = settings::g_mainTabSettings.show_overlay_adaptive_delay_bias.GetValue();
+        if (imgui.Checkbox("Adaptive bias", &show_overlay_adaptive_delay_bias)) {
+            settings::g_mainTabSettings.show_overlay_adaptive_delay_bias.SetValue(show_overlay_adaptive_delay_bias);
+        }
+        if (imgui.IsItemHovered()) {
+            imgui.SetTooltipEx(
+                "Shows the adaptive delay_bias controller state: output bias, measured late frames / deviation vs "
+                "target, and the normalized error.");
+        }
+        imgui.NextColumn();
+
+        bool show_overlay_fg_pacing = settings::g_mainTabSettings.show_overlay_fg_pacing.GetValue();
+        if (imgui.Checkbox("FG pacing", &show_overlay_fg_pacing)) {
+            settings::g_mainTabSettings.show_overlay_fg_pacing.SetValue(show_overlay_fg_pacing);
+        }
+        if (imgui.IsItemHovered()) {
+            imgui.SetTooltipEx(
+                "Shows real vs output (frame generation) frame cadence with their variance, outputs per real frame "
+                "and the output pacing error.");
+        }
+        imgui.NextColumn();
+
+        bool show_overlay_hitches = settings::g_mainTabSettings.show_overlay_hitches.GetValue();
+        if (imgui.Checkbox("Hitches", &show_overlay_hitches)) {
+            settings::g_mainTabSettings.show_overlay_hitches.SetValue(show_overlay_hitches);
+        }
+        if (imgui.IsItemHovered()) {
+            imgui.SetTooltipEx(
+                "Shows the session hitch count and rate, and the last hitch with its likely cause (module load, "
+                "display mode change, background transition, config save, log burst or FPS limiter late).");
+        }
+        imgui.NextColumn();
+
+        bool show_overlay_bound_state = settings::g_mainTabSettings.show_overlay_bound_state.GetValue();
+        if (imgui.Checkbox("CPU/GPU bound", &show_overlay_bound_state)) {
+            settings::g_mainTabSettings.show_overlay_bound_state.SetValue(show_overlay_bound_state);
+        }
+        if (imgui.IsItemHovered()) {
+            imgui.SetTooltipEx(
+                "Shows whether the game is currently CPU-bound, GPU-bound or paced by the FPS limiter, with a "
+                "confidence. Derived from present, submit and GPU completion timestamps of the last 128 frames "
+                "(GPU completion requires Enqueue GPU Completion on D3D11/D3D12).");
+        }
+        imgui.NextColumn();
+
         bool show_native_fps = settings::g_mainTabSettings.show_native_fps.GetValue();
         const bool native_reflex_active = IsNativeReflexActive();
         if (!native_reflex_active) {
@@ -584,6 +641,71 @@ static void DrawImportantInfo_OverlayControls(display_commander::ui::IImGuiWrapp
     }
 }
 
+static void DrawImportantInfo_FrameCaptureContent(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace frame_capture = display_commander::feature::frame_capture;
+    const frame_capture::FrameCaptureStatus status = frame_capture::GetFrameCaptureStatus();
+    if (status.active) {
+        if (imgui.Button(ICON_FK_CANCEL " Stop capture")) {
+            frame_capture::StopFrameCapture();
+        }
+        imgui.SameLine();
+        imgui.TextColored(ui::colors::TEXT_WARNING, "Recording: %llu frames, %.1f s",
+                          static_cast<unsigned long long>(status.frames), status.elapsed_s);
+        if (status.duration_s > 0) {
+            imgui.SameLine();
+            imgui.TextDisabled("(stops at %d s)", status.duration_s);
+        }
+    } else {
+        if (status.finalizing) {
+            imgui.BeginDisabled();
+        }
+        if (imgui.Button("Start capture")) {
+            frame_capture::StartFrameCapture(settings::g_mainTabSettings.frame_capture_duration_seconds.GetValue());
+        }
+        if (status.finalizing) {
+            imgui.EndDisabled();
+            imgui.SameLine();
+            imgui.TextDisabled("Writing CSV...");
+        }
+    }
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "Records per-frame timing (FrameData timestamps, FPS limiter sleep and late amount, Reflex PC latency, "
+            "frame generation mode) into a memory-mapped .dcfc file. On stop it is converted to a PresentMon-style "
+            "CSV and a summary (average, 1%% / 0.1%% lows, percentiles) in the frame_captures folder. A hotkey can "
+            "be bound in the Hotkeys tab.");
+    }
+    SliderIntSetting(settings::g_mainTabSettings.frame_capture_duration_seconds, "Capture duration",
+                     settings::g_mainTabSettings.frame_capture_duration_seconds.GetValue() == 0 ? "Until stopped"
+                                                                                               : "%d s",
+                     imgui);
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx("Stop the capture automatically after this many seconds (0 = until stopped).");
+    }
+
+    if (status.path.empty()) {
+        return;
+    }
+    if (!status.error.empty()) {
+        imgui.TextColored(ui::colors::TEXT_ERROR, "%s", status.error.c_str());
+    }
+    if (status.dropped > 0) {
+        imgui.TextColored(ui::colors::TEXT_WARNING, "%llu frames dropped (file full)",
+                          static_cast<unsigned long long>(status.dropped));
+    }
+    if (status.active || !status.has_summary) {
+        imgui.TextDisabled("%s", status.path.c_str());
+        return;
+    }
+    const frame_capture::FrameCaptureSummary& summary = status.summary;
+    imgui.Text("Last capture: %llu frames, %.1f s, avg %.1f FPS, 1%% low %.1f FPS, 0.1%% low %.1f FPS",
+               static_cast<unsigned long long>(summary.frames), summary.duration_s, summary.avg_fps,
+               summary.low_1pct_fps, summary.low_01pct_fps);
+    imgui.Text("Frame time p50 %.2f / p99 %.2f / max %.2f ms", summary.p50_frame_ms, summary.p99_frame_ms,
+               summary.max_frame_ms);
+    imgui.TextDisabled("%s", status.csv_path.c_str());
+}
+
 }  // namespace
 
 void DrawImportantInfo(display_commander::ui::IImGuiWrapper& imgui) {
@@ -604,6 +726,15 @@ void DrawImportantInfo(display_commander::ui::IImGuiWrapper& imgui) {
         DrawImportantInfo_FrameTimeGraphContent(imgui);
         imgui.Unindent();
     }
+
+    ui::colors::PushHeader2Colors(&imgui);
+    const bool frame_capture_open = imgui.CollapsingHeader("Frame Capture", ImGuiTreeNodeFlags_None);
+    ui::colors::PopCollapsingHeaderColors(&imgui);
+    if (frame_capture_open) {
+        imgui.Indent();
+        DrawImportantInfo_FrameCaptureContent(imgui);
+        imgui.Unindent();
+    }
     imgui.Unindent();
 }
 
@@ -3,7 +3,12 @@
 #include "performance_overlay_internal.hpp"
 #include "dxgi/vram_info.hpp"
 #include "features/nvidia_profile_inspector/nvidia_profile_inspector.hpp"
+#include "feature/adaptive_delay_bias/adaptive_delay_bias.hpp"
 #include "feature/cpu_telemetry/cpu_telemetry.hpp"
+#include "feature/fg_pacing/fg_pacing.hpp"
+#include "feature/frame_bound/frame_bound.hpp"
+#include "feature/hitch/hitch.hpp"
+#include "feature/latency_estimate/latency_estimate.hpp"
 #include "globals.hpp"
 #include "hooks/nvidia/ngx_hooks.hpp"
 #include "latency/reflex_provider.hpp"
@@ -231,6 +236,10 @@ void DrawPerformanceOverlayContent(display_commander::ui::IImGuiWrapper& imgui,
     bool show_driver_dlss_rr_preset = settings::g_mainTabSettings.show_driver_dlss_rr_preset.GetValue();
     bool show_fps_limiter_src = settings::g_mainTabSettings.show_fps_limiter_src.GetValue();
     bool show_fps_limiter_late_frames_pct = settings::g_mainTabSettings.show_fps_limiter_late_frames_pct.GetValue();
+    bool show_overlay_adaptive_delay_bias = settings::g_mainTabSettings.show_overlay_adaptive_delay_bias.GetValue();
+    bool show_overlay_fg_pacing = settings::g_mainTabSettings.show_overlay_fg_pacing.GetValue();
+    bool show_overlay_hitches = settings::g_mainTabSettings.show_overlay_hitches.GetValue();
+    bool show_overlay_bound_state = settings::g_mainTabSettings.show_overlay_bound_state.GetValue();
     bool show_overlay_vram = settings::g_mainTabSettings.show_overlay_vram.GetValue();
     bool show_overlay_ram = settings::g_mainTabSettings.show_overlay_ram.GetValue();
     bool show_overlay_nvapi_sim_duration = settings::g_mainTabSettings.show_overlay_nvapi_sim_duration.GetValue();
@@ -284,6 +293,18 @@ void DrawPerformanceOverlayContent(display_commander::ui::IImGuiWrapper& imgui,
     if (show_fps_limiter_late_frames_pct) {
         table1_any = true;
     }
+    if (show_overlay_adaptive_delay_bias) {
+        table1_any = true;
+    }
+    if (show_overlay_fg_pacing) {
+        table1_any = true;
+    }
+    if (show_overlay_hitches) {
+        table1_any = true;
+    }
+    if (show_overlay_bound_state) {
+        table1_any = true;
+    }
     if (show_flip_status) {
         table1_any = true;
     }
@@ -352,6 +373,80 @@ void DrawPerformanceOverlayContent(display_commander::ui::IImGuiWrapper& imgui,
                     "Not enough OnPresentSync limiter samples yet.", "%s", "N/A");
             }
         }
+        if (show_overlay_adaptive_delay_bias) {
+            namespace adaptive = display_commander::feature::adaptive_delay_bias;
+            const adaptive::AdaptiveDelayBiasStatus status = adaptive::GetAdaptiveDelayBiasStatus();
+            if (status.enabled) {
+                const char* unit =
+                    status.controller.target == adaptive::DelayBiasControlTarget::kFrameTimeDeviation ? "ms" : "%";
+                OverlayTableRow_Text(
+                    imgui, label_mode, "Bias", "Adaptive delay bias", show_tooltips,
+                    "OnPresentSync delay_bias from the adaptive controller (0 = display, 1 = input), then the "
+                    "measured value vs target. Error > 0 means room to lower latency; * = output saturated.",
+                    "%.2f%s (%.2f/%.2f %s, e %.2f)", status.controller.output, status.controller.saturated ? "*" : "",
+                    status.controller.measurement, status.controller.setpoint, unit, status.controller.error);
+            } else {
+                OverlayTableRow_TextColored(imgui, label_mode, "Bias", "Adaptive delay bias", ui::colors::TEXT_DIMMED,
+                                            show_tooltips,
+                                            "Adaptive ratio is off, or the OnPresentSync limiter is not pacing frames.",
+                                            "%s", "N/A");
+            }
+        }
+        if (show_overlay_fg_pacing) {
+            namespace fg_pacing = display_commander::feature::fg_pacing;
+            const fg_pacing::FgPacingStatus status = fg_pacing::GetFgPacingStatus();
+            if (status.outputs_recent && status.stats.valid) {
+                OverlayTableRow_Text(
+                    imgui, label_mode, "FG pace", "Frame generation pacing", show_tooltips,
+                    "Real (rendered) frame interval and output (real + generated) present interval with their "
+                    "standard deviation, and outputs per real frame (* = not a stable integer). Output pacing "
+                    "error: RMS distance of output intervals from an even split of the real interval.",
+                    "%.1fx%s real %.2f+-%.2f / out %.2f+-%.2f ms (err %.2f)", status.stats.observed_multiplier,
+                    status.stats.locked_multiplier > 0 ? "" : "*", status.stats.real_interval_ms,
+                    status.stats.real_stddev_ms, status.stats.output_interval_ms, status.stats.output_stddev_ms,
+                    status.stats.output_pacing_error_ms);
+            } else {
+                OverlayTableRow_TextColored(imgui, label_mode, "FG pace", "Frame generation pacing",
+                                            ui::colors::TEXT_DIMMED, show_tooltips,
+                                            "Needs swap chain presents plus Present start markers or Streamline "
+                                            "proxy presents for real frames.",
+                                            "%s", "N/A");
+            }
+        }
+        if (show_overlay_hitches) {
+            namespace hitch = display_commander::feature::hitch;
+            const hitch::HitchStatus status = hitch::GetHitchStatus();
+            if (status.stats.hitches > 0) {
+                OverlayTableRow_Text(
+                    imgui, label_mode, "Hitch", "Hitches", show_tooltips,
+                    "Frames above the hitch threshold (multiple of the rolling median frame time) this session, "
+                    "hitches per minute of play, and the last hitch with its most likely cause. Full list: Debug > "
+                    "Monitoring.",
+                    "%llu (%.1f/min) last %.0f ms: %s", static_cast<unsigned long long>(status.stats.hitches),
+                    status.stats.hitches_per_minute, status.last_hitch.frame_time_ms,
+                    hitch::HitchCauseName(status.last_hitch.primary_cause));
+            } else {
+                OverlayTableRow_TextColored(imgui, label_mode, "Hitch", "Hitches", ui::colors::TEXT_DIMMED,
+                                            show_tooltips, "No frame above the hitch threshold this session.", "%s",
+                                            status.stats.frames > 0 ? "0" : "N/A");
+            }
+        }
+        if (show_overlay_bound_state) {
+            const display_commander::feature::frame_bound::BoundAnalysis bound =
+                display_commander::feature::frame_bound::GetLatestBoundAnalysis();
+            if (bound.state != display_commander::feature::frame_bound::BoundState::kUnknown) {
+                OverlayTableRow_Text(
+                    imgui, label_mode, "Bound", "CPU/GPU bound", show_tooltips,
+                    "Rolling classification over the last 128 frames. CPU busy excludes FPS limiter sleep and time "
+                    "blocked in Present; GPU busy comes from GPU completion fences.",
+                    "%s %.0f%% (CPU %.1f / GPU %.1f ms)",
+                    display_commander::feature::frame_bound::BoundStateName(bound.state), bound.confidence * 100.0f,
+                    bound.cpu_busy_ms, bound.gpu_busy_ms);
+            } else {
+                OverlayTableRow_TextColored(imgui, label_mode, "Bound", "CPU/GPU bound", ui::colors::TEXT_DIMMED,
+                                            show_tooltips, "Not enough frames analyzed yet.", "%s", "N/A");
+            }
+        }
         if (show_flip_status) {
             auto desc_ptr = g_last_swapchain_desc_post.load();
             if (desc_ptr != nullptr) {
@@ -592,9 +687,11 @@ void DrawPerformanceOverlayContent(display_commander::ui::IImGuiWrapper& imgui,
         OverlayScalarTableBegin(imgui);
 
         if (show_gpu_measurement) {
+            bool drew_reflex_latency = false;
             if (have_nv_latency_params) {
                 ReflexProvider::NvapiLatencyMetrics metrics{};
                 if (ReflexProvider::MetricsFromLatencyParams(nv_latency_params, metrics)) {
+                    drew_reflex_latency = true;
                     double pcl_latency_ms_estimate = metrics.pc_latency_ms + metrics.gpu_frame_time_ms / 2.0;
                     const DLSSGSummaryLite dlss_lite = GetDLSSGSummaryLite();
                     const int fg_mode = dlss_lite.fg_mode;
@@ -607,6 +704,19 @@ void DrawPerformanceOverlayContent(display_commander::ui::IImGuiWrapper& imgui,
                         pcl_latency_ms_estimate);
                 }
             }
+            if (!drew_reflex_latency) {
+                // No Reflex (other vendors, games without markers): software estimate from the frame timeline
+                const display_commander::feature::latency_estimate::LatencyEstimatorStats est =
+                    display_commander::feature::latency_estimate::GetLatestLatencyEstimateStats();
+                if (est.window_frames > 0) {
+                    OverlayTableRow_Text(
+                        imgui, label_mode, "Lat.", "Latency", show_tooltips,
+                        "Estimated latency without Reflex: simulation start to present, GPU done and start of scanout "
+                        "(last 1 s). The range bounds the modeled parts (GPU completion when not measured, wait for "
+                        "the next refresh).",
+                        "~%.1f ms (%.0f-%.0f)", est.total_ms, est.total_low_ms, est.total_high_ms);
+                }
+            }
         }
 
         if (show_cpu_usage) {
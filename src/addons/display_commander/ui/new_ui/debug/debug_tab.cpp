@@ -3,6 +3,7 @@
 #include "../../../globals.hpp"
 #include "display_config_debug_tab.hpp"
 #include "fps_limiter_debug_tab.hpp"
+#include "monitoring_debug_tab.hpp"
 #include "ngx_counters_tab.hpp"
 #include "nvidia_profile_inspector_tab.hpp"
 #include "reflex_pclstats_tab.hpp"
@@ -55,6 +56,11 @@ void DrawDebugTab(display_commander::ui::IImGuiWrapper& imgui) {
         DrawNGXCountersTab(imgui);
         imgui.EndTabItem();
     }
+    if (imgui.BeginTabItem("Monitoring", nullptr, 0)) {
+        g_rendering_ui_section.store("ui:tab:debug_monitoring", std::memory_order_release);
+        DrawMonitoringDebugTab(imgui);
+        imgui.EndTabItem();
+    }
     if (imgui.BeginTabItem("NVIDIA profile", nullptr, 0)) {
         g_rendering_ui_section.store("ui:tab:debug_nvidia_profile", std::memory_order_release);
         DrawNvidiaProfileInspectorTab(imgui);
@@ -1,8 +1,12 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #include "fps_limiter_debug_tab.hpp"
+#include "../../../feature/fg_pacing/fg_pacing.hpp"
+#include "../../../feature/vblank_lock/vblank_lock.hpp"
 #include "../../../globals.hpp"
+#include "../../../settings/main_tab_settings.hpp"
 #include "../../../swapchain_events.hpp"
 #include "../../../utils/timing.hpp"
+#include "../settings_wrapper.hpp"
 
 // Libraries <ReShade> / <imgui>
 #include <imgui.h>
@@ -40,11 +44,70 @@ const char* FpsLimiterModeLabel(FpsLimiterMode m) {
             return "OnPresentSync";
         case FpsLimiterMode::kReflex:
             return "Reflex";
+        case FpsLimiterMode::kVblankLocked:
+            return "VBlankLock";
         default:
             return "?";
     }
 }
 
+// Live phase lock state, plus a replay of the same lock / scheduler against a synthetic display at this refresh rate
+void DrawVblankLockSection(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace vblank_lock = display_commander::feature::vblank_lock;
+    imgui.Separator();
+    imgui.Spacing();
+    imgui.TextUnformatted("VBlank phase lock");
+    const vblank_lock::VblankLockStatus status = vblank_lock::GetVblankLockStatus();
+    if (status.sampler_error != nullptr) {
+        imgui.Text("Sampler: %s", status.sampler_error);
+    } else {
+        imgui.Text("Sampler: %s, %s", status.sampler_running ? "running" : "idle",
+                   status.lock.locked ? "locked" : "not locked");
+    }
+    imgui.Text("Period %.4f ms (nominal %.4f ms, drift %.0f ppm), line %.3f us, lines %u / %u",
+               status.lock.period_ms, status.lock.nominal_period_ms, status.lock.drift_ppm, status.lock.line_time_us,
+               status.lock.active_lines, status.lock.total_lines);
+    imgui.Text("Phase error rms %.1f us (last %.1f us), wait wake-up %.1f us", status.lock.phase_error_rms_us,
+               status.lock.last_phase_error_us, status.lock.wait_latency_us);
+    imgui.Text("Readings: %llu waits, %llu scanlines, %llu outliers, %llu relocks",
+               static_cast<unsigned long long>(status.lock.wait_observations),
+               static_cast<unsigned long long>(status.lock.scanline_observations),
+               static_cast<unsigned long long>(status.lock.outliers),
+               static_cast<unsigned long long>(status.lock.relocks));
+    imgui.Text("Schedule: every %u refresh(es), lead %.2f ms; frames %llu, late %llu, missed vblanks %llu, "
+               "unlocked %llu",
+               status.interval_vblanks, status.lead_ms, static_cast<unsigned long long>(status.scheduler.frames),
+               static_cast<unsigned long long>(status.scheduler.late_frames),
+               static_cast<unsigned long long>(status.scheduler.missed_vblanks),
+               static_cast<unsigned long long>(status.scheduler.unlocked_frames));
+}
+
+void DrawFgPacingSection(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace fg_pacing = display_commander::feature::fg_pacing;
+    imgui.Separator();
+    imgui.Spacing();
+    imgui.TextUnformatted("Frame generation pacing model");
+    CheckboxSetting(settings::g_mainTabSettings.fps_limiter_fg_pacing_model, "Limit on measured multiplier", imgui);
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "Frame generation aware limiter: once the model has a stable outputs-per-real-frame count, divide the "
+            "FPS limit by it instead of DLSS-G MultiFrameCount (covers unknown and dynamic multi frame generation).");
+    }
+    const fg_pacing::FgPacingStatus status = fg_pacing::GetFgPacingStatus();
+    const fg_pacing::FgPacingStats& stats = status.stats;
+    imgui.Text("Real frames from: %s; output presents %s", fg_pacing::FgRealFrameSourceName(status.source),
+               status.outputs_recent ? "recent" : "not seen in the last second");
+    imgui.Text("Multiplier: observed %.3f, locked %d, fg_mode %d, limiter divides by %d", stats.observed_multiplier,
+               stats.locked_multiplier, status.fg_mode, status.limiter_multiplier);
+    imgui.Text("Real cadence %.3f ms (sd %.3f ms), output cadence %.3f ms (sd %.3f ms)", stats.real_interval_ms,
+               stats.real_stddev_ms, stats.output_interval_ms, stats.output_stddev_ms);
+    imgui.Text("Output pacing error %.3f ms rms, irregular real frames %.1f%%", stats.output_pacing_error_ms,
+               stats.irregular_pct);
+    imgui.Text("Counts: %llu real, %llu output, %llu unattributed", static_cast<unsigned long long>(stats.real_frames),
+               static_cast<unsigned long long>(stats.output_presents),
+               static_cast<unsigned long long>(stats.unattributed_frames));
+}
+
 void DrawRatesRow(display_commander::ui::IImGuiWrapper& imgui, const char* label, double calls_per_sec) {
     imgui.TableNextRow();
     imgui.TableNextColumn();
@@ -303,6 +366,10 @@ void DrawFpsLimiterDebugTab(display_commander::ui::IImGuiWrapper& imgui) {
         "Totals: pre=%" PRIu64 " active=%" PRIu64 " post=%" PRIu64 " (raw fetch_add counts).",
         static_cast<unsigned long long>(pre_total), static_cast<unsigned long long>(active_total),
         static_cast<unsigned long long>(post_total));
+
+    imgui.Spacing();
+    DrawVblankLockSection(imgui);
+    DrawFgPacingSection(imgui);
 }
 
 }  // namespace ui::new_ui::debug
@@ -0,0 +1,346 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "monitoring_debug_tab.hpp"
+#include "../../../continuous_monitoring.hpp"
+#include "../../../display/display_cache.hpp"
+#include "../../../feature/foreground/foreground.hpp"
+#include "../../../feature/hitch/hitch.hpp"
+#include "../../../feature/input_latency/input_latency.hpp"
+#include "../../../feature/latency_estimate/latency_estimate.hpp"
+#include "../../../feature/trace/trace.hpp"
+#include "../../../hooks/windows_hooks/windows_message_hooks.hpp"
+#include "../../../settings/main_tab_settings.hpp"
+#include "../../../utils/timing.hpp"
+#include "../settings_wrapper.hpp"
+
+// Libraries <ReShade> / <imgui>
+#include <imgui.h>
+
+// Libraries <standard C++>
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ui::new_ui::debug {
+
+namespace {
+
+double NsToMs(int64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+void DrawForegroundTracking(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace fg = display_commander::feature::foreground;
+    const fg::ForegroundTrackerStats s = fg::GetForegroundTrackerStats();
+    imgui.TextUnformatted("Foreground tracking");
+    imgui.Text("Transitions: %" PRIu64 " (poll corrections %" PRIu64 ", stale events %" PRIu64
+               ", deferred polls %" PRIu64 ")",
+               s.transitions, s.poll_corrections, s.stale_events, s.deferred_polls);
+    imgui.Text("Events: WinEvent %" PRIu64 ", window proc %" PRIu64 ", poll %" PRIu64,
+               s.events[static_cast<size_t>(fg::ForegroundEventSource::kWinEvent)],
+               s.events[static_cast<size_t>(fg::ForegroundEventSource::kWindowProc)],
+               s.events[static_cast<size_t>(fg::ForegroundEventSource::kPoll)]);
+    imgui.Text("Focus change -> state update: last %.3f ms, avg %.3f ms, max %.3f ms (%" PRIu64 " samples)",
+               NsToMs(s.last_latency_ns), NsToMs(s.avg_latency_ns), NsToMs(s.max_latency_ns), s.latency_samples);
+}
+
+void DrawDisplayCacheRefresh(display_commander::ui::IImGuiWrapper& imgui) {
+    const display_cache::DisplayCacheRefreshStats s = display_cache::g_displayCache.GetRefreshStats();
+    imgui.TextUnformatted("Display cache");
+    imgui.Text("Refreshes: %" PRIu64 " (published %" PRIu64 ", full %" PRIu64 "), displays re-enumerated %" PRIu64,
+               s.refreshes, s.published, s.full_refreshes, s.displays_enumerated);
+    imgui.Text("Refresh time: last %.3f ms, max %.3f ms", static_cast<double>(s.last_refresh_us) / 1000.0,
+               static_cast<double>(s.max_refresh_us) / 1000.0);
+}
+
+void DrawKeyboardTracking(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace kt = display_commanderhooks::keyboard_tracker;
+    const kt::KeyboardTrackerStats s = kt::GetKeyboardTrackerStats();
+    imgui.TextUnformatted("Keyboard tracking");
+    imgui.Text("Key edges: message %" PRIu64 ", raw input %" PRIu64 ", poll corrections %" PRIu64
+               " (queue overflows %" PRIu64 ")",
+               s.edges[static_cast<size_t>(kt::KeyEdgeSource::kMessage)],
+               s.edges[static_cast<size_t>(kt::KeyEdgeSource::kRawInput)],
+               s.edges[static_cast<size_t>(kt::KeyEdgeSource::kPoll)], s.queue_overflows);
+    imgui.Text("Key down -> hotkey action: last %.3f ms, avg %.3f ms, max %.3f ms (%" PRIu64 " samples)",
+               NsToMs(s.last_response_ns), NsToMs(s.avg_response_ns), NsToMs(s.max_response_ns),
+               s.hotkey_responses);
+}
+
+void DrawMessageSuppression(display_commander::ui::IImGuiWrapper& imgui) {
+    const display_commanderhooks::MessageSuppressionStats s = display_commanderhooks::GetMessageSuppressionStats();
+    imgui.TextUnformatted("Message suppression (input blocking)");
+    std::string blocked;
+    for (size_t i = 0; i < display_commanderhooks::kMessageClassCount; ++i) {
+        const auto cls = static_cast<display_commanderhooks::MessageClass>(i);
+        if ((s.blocked_classes & display_commanderhooks::MessageClassBit(cls)) != 0) {
+            blocked += blocked.empty() ? "" : ", ";
+            blocked += display_commanderhooks::MessageClassName(cls);
+        }
+    }
+    imgui.Text("Blocked now: %s (filter rebuilds %" PRIu64 ")", blocked.empty() ? "none" : blocked.c_str(),
+               s.rebuilds);
+    for (size_t i = 0; i < display_commanderhooks::kMessageClassCount; ++i) {
+        if (s.suppressed[i] == 0) {
+            continue;
+        }
+        imgui.Text("  %s: %" PRIu64 " suppressed",
+                   display_commanderhooks::MessageClassName(static_cast<display_commanderhooks::MessageClass>(i)),
+                   s.suppressed[i]);
+    }
+}
+
+void DrawInputLatency(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace il = display_commander::feature::input_latency;
+    const il::InputLatencyStats s = il::GetLatestInputLatencyStats();
+    imgui.TextUnformatted("Input latency (input change -> present of the first frame simulated after it)");
+    imgui.SameLine();
+    if (imgui.SmallButton("Reset##input_latency")) {
+        il::RequestInputLatencyReset();
+    }
+    imgui.Text("Frames attributed: %" PRIu64, s.frames);
+    for (size_t i = 0; i < il::kInputSourceCount; ++i) {
+        const il::InputLatencySourceStats& src = s.sources[i];
+        const char* name = il::InputSourceName(static_cast<il::InputSource>(i));
+        imgui.Text("%s: %" PRIu64 " samples (events %" PRIu64 ", coalesced %" PRIu64 ", stale %" PRIu64
+                   ", dropped %" PRIu64 ")",
+                   name, src.samples, src.events, src.coalesced, src.stale, src.dropped);
+        if (src.samples == 0) {
+            continue;
+        }
+        imgui.Text("  last %.1f ms, avg %.1f ms, p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, min %.1f / max %.1f ms",
+                   src.last_ms, src.avg_ms, src.p50_ms, src.p95_ms, src.p99_ms, src.min_ms, src.max_ms);
+        std::array<float, il::kHistogramBucketCount> values = {};
+        float peak = 0.0f;
+        for (size_t b = 0; b < values.size(); ++b) {
+            values[b] = static_cast<float>(src.histogram[b]);
+            peak = (std::max)(peak, values[b]);
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "##input_latency_histogram_%zu", i);
+        imgui.PlotLines(label, values.data(), static_cast<int>(values.size()), 0, "0-127 ms (1 ms buckets)", 0.0f,
+                        peak, ImVec2(0.0f, 60.0f));
+    }
+}
+
+void DrawLatencyEstimate(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace le = display_commander::feature::latency_estimate;
+    const le::LatencyEstimatorStats s = le::GetLatestLatencyEstimateStats();
+    imgui.TextUnformatted("Software latency estimate (sim start -> present -> GPU done -> scanout, last 1 s)");
+    imgui.SameLine();
+    if (imgui.SmallButton("Reset##latency_estimate")) {
+        le::RequestLatencyEstimateReset();
+    }
+    imgui.Text("Frames: %" PRIu64 " (skipped %" PRIu64 ", GPU measured %" PRIu64 "), window %" PRIu64, s.frames,
+               s.skipped, s.gpu_measured_frames, s.window_frames);
+    imgui.Text("Frame interval %.2f ms, refresh period %.2f ms%s", s.frame_interval_ms, s.refresh_period_ms,
+               s.vrr_active ? " (VRR)" : "");
+    if (s.window_frames == 0) {
+        return;
+    }
+    imgui.Text("  sim -> present %.2f ms (limiter sleep %.2f), present -> GPU done %.2f, GPU done -> scanout %.2f",
+               s.sim_to_present_ms, s.limiter_sleep_ms, s.present_to_gpu_done_ms, s.gpu_done_to_scanout_ms);
+    imgui.Text("  PC latency %.2f ms [%.2f .. %.2f]", s.pc_latency_ms, s.pc_latency_low_ms, s.pc_latency_high_ms);
+    imgui.Text("  Total %.2f ms [%.2f .. %.2f], p50 %.2f, p95 %.2f", s.total_ms, s.total_low_ms, s.total_high_ms,
+               s.total_p50_ms, s.total_p95_ms);
+    if (s.validations > 0) {
+        imgui.Text("  vs Reflex PC latency: %" PRIu64 " checks, last %.2f ms, bias %+.2f ms, mean |error| %.2f ms, "
+                   "%.0f%% within bounds",
+                   s.validations, s.last_reference_ms, s.mean_error_ms, s.mean_abs_error_ms, s.within_bounds_pct);
+    }
+}
+
+void DrawHitches(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace hitch = display_commander::feature::hitch;
+    const hitch::HitchStatus status = hitch::GetHitchStatus();
+    imgui.TextUnformatted("Hitches (frames above multiplier x rolling median, tagged with overlapping events)");
+    imgui.SameLine();
+    if (imgui.SmallButton("Clear##hitches")) {
+        hitch::ClearHitches();
+    }
+    SliderFloatSetting(settings::g_mainTabSettings.hitch_threshold_multiplier, "Hitch threshold", "%.1fx median",
+                       imgui);
+    const hitch::HitchSessionStats& s = status.stats;
+    imgui.Text("Frames: %" PRIu64 ", hitches: %" PRIu64 " (%.2f%% of frames), %.1f per minute over %.0f s", s.frames,
+               s.hitches, s.hitch_frame_pct, s.hitches_per_minute, s.session_seconds);
+    imgui.Text("Median frame %.2f ms, threshold %.2f ms, worst %.1f ms", s.median_ms, status.threshold_ms,
+               s.worst_frame_ms);
+    std::string causes = "By cause:";
+    char part[64];
+    for (size_t i = 0; i < hitch::kHitchCauseCount; ++i) {
+        snprintf(part, sizeof(part), " %s %" PRIu64 ",", hitch::HitchCauseName(static_cast<hitch::HitchCause>(i)),
+                 s.by_primary_cause[i]);
+        causes += part;
+    }
+    snprintf(part, sizeof(part), " unattributed %" PRIu64, s.unattributed);
+    causes += part;
+    imgui.TextWrapped("%s", causes.c_str());
+    if (s.hitches == 0) {
+        return;
+    }
+
+    const std::vector<hitch::HitchRecord> hitches = hitch::GetRecentHitches();
+    const int64_t now_ns = utils::get_now_ns();
+    constexpr int kCols = 5;
+    if (imgui.BeginTable("monitoring_hitches", kCols,
+                         ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                         ImVec2(0.0f, 240.0f))) {
+        imgui.TableSetupScrollFreeze(0, 1);
+        imgui.TableSetupColumn("Age");
+        imgui.TableSetupColumn("Frame");
+        imgui.TableSetupColumn("Median / threshold");
+        imgui.TableSetupColumn("Cause");
+        imgui.TableSetupColumn("Evidence");
+        imgui.TableHeadersRow();
+
+        for (const hitch::HitchRecord& record : hitches) {
+            imgui.TableNextRow();
+            imgui.TableNextColumn();
+            imgui.Text("%.1f s", NsToMs(now_ns - record.frame_end_ns) / 1000.0);
+            imgui.TableNextColumn();
+            imgui.Text("#%" PRIu64 " %.1f ms", record.frame_index, record.frame_time_ms);
+            imgui.TableNextColumn();
+            imgui.Text("%.1f / %.1f ms", record.median_ms, record.threshold_ms);
+            imgui.TableNextColumn();
+            imgui.TextUnformatted(hitch::HitchCauseName(record.primary_cause));
+            imgui.TableNextColumn();
+            std::string evidence;
+            for (uint32_t i = 0; i < record.evidence_count; ++i) {
+                const hitch::HitchEvidence& e = record.evidence[i];
+                char item[128];
+                snprintf(item, sizeof(item), "%s%s %s (%.1f ms)", i > 0 ? "; " : "", hitch::HitchCauseName(e.cause),
+                         e.detail.data(), NsToMs(e.duration_ns));
+                evidence += item;
+            }
+            imgui.TextUnformatted(evidence.empty() ? "-" : evidence.c_str());
+        }
+        imgui.EndTable();
+    }
+}
+
+void DrawTraceExport(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace trace = display_commander::feature::trace;
+    const trace::TraceStatus status = trace::GetTraceStatus();
+    imgui.TextUnformatted("Trace export (Chrome JSON: Perfetto UI / chrome://tracing)");
+    imgui.SameLine();
+    if (status.active) {
+        if (imgui.SmallButton("Stop##trace")) {
+            trace::StopTrace();
+        }
+    } else {
+        if (status.writing) {
+            imgui.BeginDisabled();
+        }
+        if (imgui.SmallButton("Start##trace")) {
+            trace::StartTrace(settings::g_mainTabSettings.trace_duration_seconds.GetValue());
+        }
+        if (status.writing) {
+            imgui.EndDisabled();
+        }
+    }
+    SliderIntSetting(settings::g_mainTabSettings.trace_duration_seconds, "Trace duration",
+                     settings::g_mainTabSettings.trace_duration_seconds.GetValue() == 0 ? "Until stopped" : "%d s",
+                     imgui);
+
+    // Applied at the next start (sites are resolved when the trace begins)
+    char sites[256];
+    strncpy_s(sites, sizeof(sites), settings::g_mainTabSettings.trace_detour_sites.GetValue().c_str(), _TRUNCATE);
+    if (imgui.InputText("Traced detour sites", sites, sizeof(sites))) {
+        settings::g_mainTabSettings.trace_detour_sites.SetValue(sites);
+    }
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltipEx(
+            "Comma-separated substrings of CALL_GUARD keys (\"Function:line\", see the detour call list). Matching "
+            "sites are recorded as spans on the calling thread; empty = none. Applied when a trace starts.");
+    }
+
+    if (status.active || status.writing) {
+        imgui.Text("%s: %zu / %zu events, %.1f s", status.active ? "Recording" : "Writing JSON", status.events,
+                   status.capacity, status.elapsed_s);
+    }
+    if (status.dropped > 0) {
+        imgui.Text("Dropped: %" PRIu64 " events (buffer full)", status.dropped);
+    }
+    if (!status.error.empty()) {
+        imgui.TextWrapped("Error: %s", status.error.c_str());
+    }
+    if (!status.path.empty()) {
+        imgui.TextWrapped("%s", status.path.c_str());
+    }
+}
+
+}  // namespace
+
+void DrawMonitoringDebugTab(display_commander::ui::IImGuiWrapper& imgui) {
+    imgui.TextWrapped(
+        "Continuous monitoring thread tasks (timer wheel). Durations are wall time per run; start delay is the worst "
+        "lateness vs. the scheduled tick. Overruns: run longer than its period or started a full period late. "
+        "Snapshot refreshes once per second.");
+    imgui.Spacing();
+
+    DrawForegroundTracking(imgui);
+    imgui.Spacing();
+    DrawDisplayCacheRefresh(imgui);
+    imgui.Spacing();
+    DrawKeyboardTracking(imgui);
+    imgui.Spacing();
+    DrawMessageSuppression(imgui);
+    imgui.Spacing();
+    DrawInputLatency(imgui);
+    imgui.Spacing();
+    DrawLatencyEstimate(imgui);
+    imgui.Spacing();
+    DrawHitches(imgui);
+    imgui.Spacing();
+    DrawTraceExport(imgui);
+    imgui.Spacing();
+
+    const auto stats = continuous_monitoring::GetSchedulerStats();
+    if (stats == nullptr) {
+        imgui.TextUnformatted("Monitoring thread not running (or no snapshot yet).");
+        return;
+    }
+    imgui.Text("Thread wake-ups: %.1f /s (total %" PRIu64 ")", stats->wakeups_per_sec, stats->wakeups);
+    imgui.Spacing();
+
+    constexpr int kCols = 8;
+    if (imgui.BeginTable("monitoring_scheduler_tasks", kCols, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        imgui.TableSetupColumn("Task");
+        imgui.TableSetupColumn("Period");
+        imgui.TableSetupColumn("Runs (requested)");
+        imgui.TableSetupColumn("Last");
+        imgui.TableSetupColumn("Avg");
+        imgui.TableSetupColumn("Max");
+        imgui.TableSetupColumn("Max start delay");
+        imgui.TableSetupColumn("Overruns");
+        imgui.TableHeadersRow();
+
+        for (const auto& task : stats->tasks) {
+            imgui.TableNextRow();
+            imgui.TableNextColumn();
+            imgui.Text("%s%s", task.name != nullptr ? task.name : "?", task.active ? "" : " (done)");
+            imgui.TableNextColumn();
+            if (task.period_ns > 0) {
+                imgui.Text("%.0f ms", NsToMs(task.period_ns));
+            } else {
+                imgui.TextUnformatted("-");
+            }
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64 " (%" PRIu64 ")", task.runs, task.triggered_runs);
+            imgui.TableNextColumn();
+            imgui.Text("%.3f ms", NsToMs(task.last_duration_ns));
+            imgui.TableNextColumn();
+            imgui.Text("%.3f ms", NsToMs(task.avg_duration_ns));
+            imgui.TableNextColumn();
+            imgui.Text("%.3f ms", NsToMs(task.max_duration_ns));
+            imgui.TableNextColumn();
+            imgui.Text("%.3f ms", NsToMs(task.max_start_delay_ns));
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64, task.overruns);
+        }
+        imgui.EndTable();
+    }
+}
+
+}  // namespace ui::new_ui::debug
@@ -1,7 +1,9 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #include "reflex_pclstats_tab.hpp"
+#include "../../../feature/reflex_latency/reflex_latency.hpp"
 #include "../../../globals.hpp"
 #include "../../../hooks/nvidia/pclstats_etw_hooks.hpp"
+#include "../../../latency/latency_markers.hpp"
 #include "../../../latency/reflex_provider.hpp"
 #include "../../../settings/main_tab_settings.hpp"
 #include "../../../utils/string_utils.hpp"
@@ -202,6 +204,127 @@ uint64_t FirstNonzeroPipelineStampNs(const NvapiLatencyFrame& fr) {
     return 0;
 }
 
+void DrawReflexLatencyHistory(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace rl = display_commander::feature::reflex_latency;
+    static int s_window_index = static_cast<int>(rl::ReflexStatsWindow::k10s);
+    static const char* const kWindowLabels[] = {"1 s", "10 s", "Session"};
+
+    imgui.TextColored(ImVec4{0.85f, 0.85f, 0.85f, 1.0f}, "Latency history (continuous, by frameID)");
+    imgui.Indent();
+    const rl::ReflexFrameHistoryStats stats = rl::GetReflexFrameHistory().GetStats();
+    imgui.Text("Polls: %" PRIu64 "  Frames: %" PRIu64 "  Duplicates: %" PRIu64 "  Newest frameID: %" PRIu64,
+               stats.polls, stats.frames, stats.duplicates, stats.newest_frame_id);
+    imgui.Text("Frame interval: %.2f ms  Poll interval: %.0f ms", stats.frame_interval_ms,
+               static_cast<double>(stats.recommended_poll_interval_ns) / 1e6);
+    if (stats.overruns > 0 || stats.id_resets > 0) {
+        imgui.TextColored(::ui::colors::TEXT_DIMMED,
+                          "Overruns (frames possibly lost): %" PRIu64 "  ID resets: %" PRIu64, stats.overruns,
+                          stats.id_resets);
+    }
+
+    imgui.SetNextItemWidth(120.0f);
+    imgui.Combo("Window", &s_window_index, kWindowLabels, static_cast<int>(rl::kReflexStatsWindowCount));
+    imgui.SameLine();
+    if (imgui.Button("Reset history")) {
+        rl::RequestReflexFrameHistoryReset();
+    }
+
+    if (imgui.BeginTable("reflex_latency_history", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        imgui.TableSetupColumn("Stage");
+        imgui.TableSetupColumn("Samples");
+        imgui.TableSetupColumn("Avg ms");
+        imgui.TableSetupColumn("P50 ms");
+        imgui.TableSetupColumn("P90 ms");
+        imgui.TableSetupColumn("P99 ms");
+        imgui.TableSetupColumn("Max ms");
+        imgui.TableHeadersRow();
+        for (std::size_t i = 0; i < rl::kReflexStageCount; ++i) {
+            const rl::ReflexStageStats& st = stats.stages[static_cast<std::size_t>(s_window_index)][i];
+            imgui.TableNextRow();
+            imgui.TableNextColumn();
+            imgui.TextUnformatted(rl::ReflexStageName(static_cast<rl::ReflexStage>(i)));
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64, st.samples);
+            if (st.samples == 0) {
+                continue;
+            }
+            imgui.TableNextColumn();
+            imgui.Text("%.3f", st.avg_ms);
+            imgui.TableNextColumn();
+            imgui.Text("%.3f", st.p50_ms);
+            imgui.TableNextColumn();
+            imgui.Text("%.3f", st.p90_ms);
+            imgui.TableNextColumn();
+            imgui.Text("%.3f", st.p99_ms);
+            imgui.TableNextColumn();
+            imgui.Text("%.3f", st.max_ms);
+        }
+        imgui.EndTable();
+    }
+    imgui.Unindent();
+}
+
+void DrawLatencyMarkerBus(display_commander::ui::IImGuiWrapper& imgui) {
+    namespace lat = display_commander::latency;
+
+    imgui.TextColored(ImVec4{0.85f, 0.85f, 0.85f, 1.0f}, "Latency marker bus (one stream across marker sources)");
+    imgui.Indent();
+    const lat::LatencyMarkerBus& bus = lat::GetLatencyMarkerBus();
+    const lat::LatencyMarkerBusStats stats = bus.GetStats();
+    imgui.Text("Active source: %s  Frames: %" PRIu64 "  Source switches: %" PRIu64 "  ID resets: %" PRIu64,
+               lat::LatencyMarkerSourceName(stats.active_source), stats.frames_delivered, stats.source_switches,
+               stats.id_resets);
+
+    if (imgui.BeginTable("latency_marker_bus_sources", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        imgui.TableSetupColumn("Source");
+        imgui.TableSetupColumn("Events");
+        imgui.TableSetupColumn("Shadowed");
+        imgui.TableSetupColumn("Repeats");
+        imgui.TableSetupColumn("Late");
+        imgui.TableSetupColumn("Unknown");
+        imgui.TableHeadersRow();
+        for (std::size_t i = 0; i < lat::kLatencyMarkerSourceCount; ++i) {
+            const lat::LatencyMarkerSourceStats& s = stats.sources[i];
+            imgui.TableNextRow();
+            imgui.TableNextColumn();
+            imgui.TextUnformatted(lat::LatencyMarkerSourceName(static_cast<lat::LatencyMarkerSource>(i)));
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64, s.events);
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64, s.shadowed);
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64, s.repeats);
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64, s.late);
+            imgui.TableNextColumn();
+            imgui.Text("%" PRIu64, s.unknown);
+        }
+        imgui.EndTable();
+    }
+
+    lat::LatencyFrameMarkers frame{};
+    if (!bus.GetLatestFrame(&frame)) {
+        imgui.TextColored(::ui::colors::TEXT_DIMMED, "No frame delivered yet.");
+    } else {
+        imgui.Text("Latest frame %" PRIu64 " (%s), ms after SIMULATION_START:", frame.frame_id,
+                   lat::LatencyMarkerSourceName(frame.source));
+        const int64_t origin_ns = frame.Time(lat::LatencyMarker::kSimulationStart);
+        for (std::size_t i = 0; i < lat::kLatencyMarkerCount; ++i) {
+            const auto m = static_cast<lat::LatencyMarker>(i);
+            if (!frame.Has(m)) {
+                continue;
+            }
+            if (origin_ns != 0) {
+                imgui.Text("  %-32s %+.3f", lat::LatencyMarkerName(m),
+                           static_cast<double>(frame.Time(m) - origin_ns) / 1e6);
+            } else {
+                imgui.Text("  %s", lat::LatencyMarkerName(m));
+            }
+        }
+    }
+    imgui.Unindent();
+}
+
 }  // namespace
 
 void DrawReflexPclstatsTab(display_commander::ui::IImGuiWrapper& imgui) {
@@ -272,6 +395,14 @@ void DrawReflexPclstatsTab(display_commander::ui::IImGuiWrapper& imgui) {
     }
     imgui.Text("Foreign PCLStats init observed: %s (skips DC PCLSTATS_INIT)",
                PclStatsForeignInitObserved() ? "yes" : "no");
+    const PclStatsEtwInterceptStats etw = GetPclStatsEtwInterceptStats();
+    imgui.Text("Foreign EventWriteTransfer: forwarded %" PRIu64 ", PCLStats matched %" PRIu64 " (%u registration(s))",
+               etw.forwarded, etw.matched, etw.foreign_registrations);
+    imgui.Text("Queued %" PRIu64 " on %u thread(s), pending %" PRIu64 ", markers %" PRIu64 ", other %" PRIu64,
+               etw.queued, etw.producer_threads, etw.pending, etw.decoded_markers, etw.decoded_other);
+    if (etw.dropped > 0) {
+        imgui.TextColored(::ui::colors::TEXT_DIMMED, "Dropped (ring full / unreadable): %" PRIu64, etw.dropped);
+    }
     const bool pcl_user = settings::g_mainTabSettings.pcl_stats_enabled.GetValue();
     imgui.Text("Setting \"PCL stats for injected reflex\": %s", pcl_user ? "on" : "off");
     imgui.Text("PCLStats initialized: %s", ReflexProvider::IsPCLStatsInitialized() ? "yes" : "no");
@@ -380,6 +511,18 @@ void DrawReflexPclstatsTab(display_commander::ui::IImGuiWrapper& imgui) {
     imgui.Separator();
     imgui.Spacing();
 
+    DrawReflexLatencyHistory(imgui);
+
+    imgui.Spacing();
+    imgui.Separator();
+    imgui.Spacing();
+
+    DrawLatencyMarkerBus(imgui);
+
+    imgui.Spacing();
+    imgui.Separator();
+    imgui.Spacing();
+
     imgui.TextColored(ImVec4{0.85f, 0.85f, 0.85f, 1.0f}, "Recent NVAPI frame reports (up to 10)");
     imgui.Indent();
     static std::vector<ReflexProvider::NvapiLatencyFrame> s_frames;
@@ -1,15 +1,100 @@
 // Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
 #include "window_messages_tab.hpp"
 #include "../../../hooks/windows_hooks/window_proc_hooks.hpp"
+#include "../../../utils/general_utils.hpp"
+#include "../../ui_colors.hpp"
 
 // Libraries <ReShade> / <imgui>
 #include <imgui.h>
 
 // Libraries <standard C++>
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
 #include <vector>
 
 namespace ui::new_ui::debug {
 
+namespace {
+
+constexpr size_t kMaxDisplayedRows = 1000;  // Export always writes the full (filtered) capture
+constexpr const char* kDepthLabels[] = {"64", "256", "1024", "4096"};
+constexpr size_t kDepthValues[] = {64, 256, 1024, 4096};
+
+char s_name_filter[64] = {};
+bool s_suppressed_only = false;
+bool s_input_only = false;
+std::string s_last_export_path;
+std::string s_last_export_error;
+
+bool IsInputMessage(uint32_t message_id) {
+    return message_id == 0x00FF                                // WM_INPUT
+           || (message_id >= 0x0100 && message_id <= 0x0109)   // WM_KEYFIRST..WM_UNICHAR
+           || (message_id >= 0x0200 && message_id <= 0x020E);  // WM_MOUSEFIRST..WM_MOUSEHWHEEL
+}
+
+// Case-insensitive substring of the message name, or exact id when the filter is a number ("0x0100" / "256").
+bool MatchesNameFilter(uint32_t message_id, const char* name, const char* filter) {
+    if (filter[0] == '\0') {
+        return true;
+    }
+    char* end = nullptr;
+    const unsigned long id = strtoul(filter, &end, 0);
+    if (end != filter && *end == '\0') {
+        return id == message_id;
+    }
+    for (const char* n = name; *n != '\0'; ++n) {
+        size_t i = 0;
+        while (filter[i] != '\0' && n[i] != '\0'
+               && std::tolower(static_cast<unsigned char>(n[i]))
+                      == std::tolower(static_cast<unsigned char>(filter[i]))) {
+            ++i;
+        }
+        if (filter[i] == '\0') {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ExportCsv(const std::vector<display_commanderhooks::WindowMessageRecord>& messages) {
+    s_last_export_path.clear();
+    s_last_export_error.clear();
+    std::error_code ec;
+    const std::filesystem::path folder = GetDisplayCommanderAppDataFolder() / "window_messages";
+    std::filesystem::create_directories(folder, ec);
+
+    char file_name[64] = "window_messages.csv";
+    const std::time_t raw_time = std::time(nullptr);
+    std::tm time_info = {};
+    if (localtime_s(&time_info, &raw_time) == 0) {
+        strftime(file_name, sizeof(file_name), "window_messages_%Y%m%d_%H%M%S.csv", &time_info);
+    }
+    const std::filesystem::path path = folder / file_name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        s_last_export_error = "Cannot open " + path.string();
+        return false;
+    }
+    const std::string csv = display_commanderhooks::FormatWindowMessagesCsv(
+        messages, [](uint32_t message_id) { return display_commanderhooks::GetWindowMessageName(message_id); });
+    file.write(csv.data(), static_cast<std::streamsize>(csv.size()));
+    if (!file) {
+        s_last_export_error = "Write failed: " + path.string();
+        return false;
+    }
+    s_last_export_path = path.string();
+    return true;
+}
+
+}  // namespace
+
 void DrawWindowMessagesTab(display_commander::ui::IImGuiWrapper& imgui) {
     bool filter_14fe = display_commanderhooks::GetDebugHistoryFilterEnabledForMessage(0x14FE);
     if (imgui.Checkbox("Filter 0x14FE", &filter_14fe)) {
@@ -33,27 +118,114 @@ void DrawWindowMessagesTab(display_commander::ui::IImGuiWrapper& imgui) {
 
     imgui.Separator();
 
-    const std::vector<display_commanderhooks::WindowMessageRecord> messages =
+    const size_t depth = display_commanderhooks::GetWindowMessageHistoryDepth();
+    int depth_index = 0;
+    for (int i = 0; i < static_cast<int>(std::size(kDepthValues)); ++i) {
+        if (kDepthValues[i] == depth) {
+            depth_index = i;
+        }
+    }
+    imgui.SetNextItemWidth(120.0f);
+    if (imgui.Combo("History depth", &depth_index, kDepthLabels, static_cast<int>(std::size(kDepthLabels)))) {
+        display_commanderhooks::SetWindowMessageHistoryDepth(kDepthValues[depth_index]);
+    }
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltip("Messages kept by ProcessWindowMessage. Changing the depth clears the history.");
+    }
+
+    imgui.SetNextItemWidth(200.0f);
+    imgui.InputTextWithHint("Message filter", "name or id (WM_KEY, 0x0100)", s_name_filter, sizeof(s_name_filter));
+    imgui.Checkbox("Suppressed only", &s_suppressed_only);
+    imgui.SameLine();
+    imgui.Checkbox("Input messages only", &s_input_only);
+
+    const std::vector<display_commanderhooks::WindowMessageRecord> all_messages =
         display_commanderhooks::GetRecentWindowMessagesSnapshot();
+    std::vector<display_commanderhooks::WindowMessageRecord> messages;
+    messages.reserve(all_messages.size());
+    for (const display_commanderhooks::WindowMessageRecord& r : all_messages) {
+        if (s_suppressed_only && r.suppressed == display_commanderhooks::MessageSuppression::kNone) {
+            continue;
+        }
+        if (s_input_only && !IsInputMessage(r.message_id)) {
+            continue;
+        }
+        if (!MatchesNameFilter(r.message_id, display_commanderhooks::GetWindowMessageName(r.message_id),
+                               s_name_filter)) {
+            continue;
+        }
+        messages.push_back(r);
+    }
 
-    imgui.Text("Last 50 ProcessWindowMessage entries");
-    imgui.Text("Captured: %d", static_cast<int>(messages.size()));
+    imgui.Text("Captured: %d / %d (shown: %d)", static_cast<int>(all_messages.size()), static_cast<int>(depth),
+               static_cast<int>(messages.size()));
+    const uint64_t dropped = display_commanderhooks::GetWindowMessageHistoryDroppedCount();
+    if (dropped > 0) {
+        imgui.SameLine();
+        imgui.TextColored(::ui::colors::TEXT_DIMMED, "(dropped under contention: %" PRIu64 ")", dropped);
+    }
 
     if (imgui.Button("Clear")) {
         display_commanderhooks::ClearRecentWindowMessages();
     }
+    imgui.SameLine();
+    if (imgui.Button("Export CSV")) {
+        ExportCsv(messages);
+    }
+    if (imgui.IsItemHovered()) {
+        imgui.SetTooltip("Writes the shown (filtered) messages, oldest first, to %%LocalAppData%%\\Programs\\"
+                         "Display_Commander\\window_messages.");
+    }
+    if (!s_last_export_path.empty()) {
+        imgui.TextColored(::ui::colors::TEXT_DIMMED, "Exported: %s", s_last_export_path.c_str());
+    } else if (!s_last_export_error.empty()) {
+        imgui.TextColored(::ui::colors::TEXT_DIMMED, "Export failed: %s", s_last_export_error.c_str());
+    }
 
     imgui.Separator();
 
     if (messages.empty()) {
-        imgui.Text("No messages captured yet.");
+        imgui.TextUnformatted(all_messages.empty() ? "No messages captured yet." : "No messages match the filters.");
         return;
     }
 
-    for (size_t i = 0; i < messages.size(); ++i) {
-        const UINT message_id = messages[i].message_id;
-        const char* message_name = display_commanderhooks::GetWindowMessageName(message_id);
-        imgui.Text("%02d. %s (0x%04X / %u)", static_cast<int>(i + 1), message_name, message_id, message_id);
+    const int64_t newest_ns = messages.front().time_ns;
+    const size_t rows = (std::min)(messages.size(), kMaxDisplayedRows);
+    if (rows < messages.size()) {
+        imgui.TextColored(::ui::colors::TEXT_DIMMED, "Showing newest %d; export for the full capture.",
+                          static_cast<int>(rows));
+    }
+    if (imgui.BeginTable("window_messages", 7,
+                         ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                         ImVec2(0.0f, 400.0f))) {
+        imgui.TableSetupScrollFreeze(0, 1);
+        imgui.TableSetupColumn("Age (ms)");
+        imgui.TableSetupColumn("Message");
+        imgui.TableSetupColumn("HWND");
+        imgui.TableSetupColumn("wParam");
+        imgui.TableSetupColumn("lParam");
+        imgui.TableSetupColumn("Thread");
+        imgui.TableSetupColumn("Suppressed");
+        imgui.TableHeadersRow();
+        for (size_t i = 0; i < rows; ++i) {
+            const display_commanderhooks::WindowMessageRecord& r = messages[i];
+            imgui.TableNextRow();
+            imgui.TableNextColumn();
+            imgui.Text("%.3f", static_cast<double>(newest_ns - r.time_ns) / 1e6);
+            imgui.TableNextColumn();
+            imgui.Text("%s (0x%04X)", display_commanderhooks::GetWindowMessageName(r.message_id), r.message_id);
+            imgui.TableNextColumn();
+            imgui.Text("0x%" PRIxPTR, r.hwnd);
+            imgui.TableNextColumn();
+            imgui.Text("0x%" PRIxPTR, r.wparam);
+            imgui.TableNextColumn();
+            imgui.Text("0x%" PRIxPTR, static_cast<uintptr_t>(r.lparam));
+            imgui.TableNextColumn();
+            imgui.Text("%u", r.thread_id);
+            imgui.TableNextColumn();
+            imgui.TextUnformatted(display_commanderhooks::MessageSuppressionName(r.suppressed));
+        }
+        imgui.EndTable();
     }
 }
 
@@ -0,0 +1,380 @@
+// Source Code <Display Commander> // Compiled hotkey matcher core (platform-neutral, no Windows includes)
+#include "hotkey_matcher.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <utility>
+
+namespace ui::new_ui {
+
+namespace {
+
+// Virtual-key codes (winuser.h) used for modifier handling
+constexpr int kVkShift = 0x10;
+constexpr int kVkControl = 0x11;
+constexpr int kVkMenu = 0x12;
+constexpr int kVkLWin = 0x5B;
+constexpr int kVkRWin = 0x5C;
+constexpr int kVkLShift = 0xA0;  // ..0xA5 = VK_RMENU
+
+bool BitmapHas(const HotkeyKeyBitmap& keys, int vk) {
+    return vk >= 0 && vk < 256 && (keys[static_cast<size_t>(vk) >> 6] & (1ull << (vk & 63))) != 0;
+}
+
+void BitmapSet(HotkeyKeyBitmap& keys, int vk) { keys[static_cast<size_t>(vk) >> 6] |= 1ull << (vk & 63); }
+
+std::string ToLower(std::string_view text) {
+    std::string out(text);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+std::string_view Trim(std::string_view text) {
+    const size_t first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+uint8_t ModifierFromToken(const std::string& token) {
+    if (token == "ctrl" || token == "control") return kHotkeyModCtrl;
+    if (token == "shift") return kHotkeyModShift;
+    if (token == "alt") return kHotkeyModAlt;
+    if (token == "win" || token == "windows") return kHotkeyModWin;
+    return 0;
+}
+
+bool AddStepToken(const std::string& token, HotkeyKeyResolver resolve, HotkeyStep& step,
+                  std::array<bool, 256>& keys, std::string* error) {
+    if (const uint8_t modifier = ModifierFromToken(token); modifier != 0) {
+        step.modifiers |= modifier;
+        return true;
+    }
+    const int vk = resolve != nullptr ? resolve(token) : 0;
+    if (vk <= 0 || vk > 255) {
+        if (error != nullptr) *error = "unknown key '" + token + "'";
+        return false;
+    }
+    if (IsHotkeyModifierKey(vk)) {
+        if (error != nullptr) *error = "'" + token + "' is a modifier, use ctrl / shift / alt / win";
+        return false;
+    }
+    keys[static_cast<size_t>(vk)] = true;
+    return true;
+}
+
+bool ParseStep(std::string_view text, HotkeyKeyResolver resolve, HotkeyStep& step, std::string* error) {
+    std::array<bool, 256> keys = {};
+    size_t pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) ++pos;
+        size_t end = pos;
+        while (end < text.size() && text[end] != ' ' && text[end] != '\t') ++end;
+        if (end == pos) break;
+        const std::string word = ToLower(text.substr(pos, end - pos));
+        pos = end;
+
+        // "numpad+" is a key; "ctrl+shift+d" is three tokens
+        if (word.find('+') == std::string::npos || ModifierFromToken(word) != 0
+            || (resolve != nullptr && resolve(word) != 0)) {
+            if (!AddStepToken(word, resolve, step, keys, error)) return false;
+            continue;
+        }
+        size_t start = 0;
+        while (start <= word.size()) {
+            size_t plus = word.find('+', start);
+            if (plus == std::string::npos) plus = word.size();
+            // A trailing '+' belongs to the key before it ("alt+numpad+")
+            if (plus + 1 == word.size() && plus > start && resolve != nullptr && resolve(word.substr(start)) != 0) {
+                plus = word.size();
+            }
+            if (plus > start && !AddStepToken(word.substr(start, plus - start), resolve, step, keys, error)) {
+                return false;
+            }
+            start = plus + 1;
+        }
+    }
+
+    for (int vk = 0; vk < 256; ++vk) {
+        if (!keys[static_cast<size_t>(vk)]) continue;
+        if (step.key_count == kMaxHotkeyChordKeys) {
+            if (error != nullptr) *error = "more than " + std::to_string(kMaxHotkeyChordKeys) + " keys in one step";
+            return false;
+        }
+        step.keys[step.key_count++] = static_cast<uint8_t>(vk);
+    }
+    if (step.key_count == 0) {
+        if (error != nullptr) *error = "step without a key";
+        return false;
+    }
+    return true;
+}
+
+bool IsValidStep(const HotkeyStep& step) {
+    if (step.key_count == 0 || step.key_count > kMaxHotkeyChordKeys) return false;
+    for (size_t i = 0; i < step.key_count; ++i) {
+        if (step.keys[i] == 0 || IsHotkeyModifierKey(step.keys[i]) || (i > 0 && step.keys[i] <= step.keys[i - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Trie used while compiling; flattened into the matcher's arrays afterwards.
+struct BuildNode {
+    std::map<HotkeyStep, uint32_t> children;
+    std::vector<uint32_t> terminals;  // Binding indices ending here
+    std::vector<uint32_t> below;      // Binding indices ending strictly below
+};
+
+}  // namespace
+
+bool IsHotkeyModifierKey(int vk) {
+    return vk == kVkShift || vk == kVkControl || vk == kVkMenu || vk == kVkLWin || vk == kVkRWin
+           || (vk >= kVkLShift && vk <= kVkLShift + 5);
+}
+
+uint8_t HotkeyModifiersFromBitmap(const HotkeyKeyBitmap& keys) {
+    uint8_t modifiers = 0;
+    if (BitmapHas(keys, kVkControl)) modifiers |= kHotkeyModCtrl;
+    if (BitmapHas(keys, kVkShift)) modifiers |= kHotkeyModShift;
+    if (BitmapHas(keys, kVkMenu)) modifiers |= kHotkeyModAlt;
+    if (BitmapHas(keys, kVkLWin) || BitmapHas(keys, kVkRWin)) modifiers |= kHotkeyModWin;
+    return modifiers;
+}
+
+bool ParseHotkeyBinding(std::string_view text, HotkeyKeyResolver resolve, std::vector<HotkeyStep>& steps,
+                        std::string* error) {
+    steps.clear();
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string_view::npos) comma = text.size();
+        const std::string_view part = Trim(text.substr(start, comma - start));
+        start = comma + 1;
+        if (part.empty()) {
+            if (error != nullptr) *error = "empty step";
+            steps.clear();
+            return false;
+        }
+        if (steps.size() == kMaxHotkeySequenceSteps) {
+            if (error != nullptr) *error = "more than " + std::to_string(kMaxHotkeySequenceSteps) + " steps";
+            steps.clear();
+            return false;
+        }
+        HotkeyStep step;
+        if (!ParseStep(part, resolve, step, error)) {
+            steps.clear();
+            return false;
+        }
+        steps.push_back(step);
+    }
+    return true;
+}
+
+std::string FormatHotkeyBinding(const std::vector<HotkeyStep>& steps, HotkeyKeyNamer name, char key_separator) {
+    std::string out;
+    for (const HotkeyStep& step : steps) {
+        if (!out.empty()) out += ", ";
+        std::string part;
+        const auto append = [&](const std::string& token) {
+            if (!part.empty()) part += key_separator;
+            part += token;
+        };
+        if ((step.modifiers & kHotkeyModCtrl) != 0) append("ctrl");
+        if ((step.modifiers & kHotkeyModShift) != 0) append("shift");
+        if ((step.modifiers & kHotkeyModAlt) != 0) append("alt");
+        if ((step.modifiers & kHotkeyModWin) != 0) append("win");
+        for (size_t i = 0; i < step.key_count; ++i) {
+            append(name != nullptr ? name(step.keys[i]) : "key" + std::to_string(step.keys[i]));
+        }
+        out += part;
+    }
+    return out;
+}
+
+const char* HotkeyConflictKindName(HotkeyConflictKind kind) {
+    switch (kind) {
+        case HotkeyConflictKind::kInvalid:            return "invalid binding";
+        case HotkeyConflictKind::kDuplicate:          return "duplicate of";
+        case HotkeyConflictKind::kShadowedByPrefix:   return "never fires, shadowed by prefix";
+        case HotkeyConflictKind::kShadowsLonger:      return "would shadow longer binding";
+        case HotkeyConflictKind::kSharedAcrossGroups: return "shares its keys with";
+        case HotkeyConflictKind::kPrefixAcrossGroups: return "overlaps with sequence";
+        default:                                      return "unknown";
+    }
+}
+
+CompiledHotkeyMatcher CompiledHotkeyMatcher::Compile(const std::vector<HotkeyBindingSpec>& bindings) {
+    CompiledHotkeyMatcher matcher;
+    std::vector<BuildNode> build(1);
+    std::vector<HotkeyDiagnostic> warnings;
+
+    for (uint32_t index = 0; index < bindings.size(); ++index) {
+        const HotkeyBindingSpec& spec = bindings[index];
+        const auto report = [&](HotkeyConflictKind kind, uint32_t other) {
+            HotkeyDiagnostic d;
+            d.kind = kind;
+            d.action = spec.action;
+            d.other_action = other < bindings.size() ? bindings[other].action : UINT32_MAX;
+            if (d.IsError()) {
+                matcher.diagnostics_.push_back(d);
+            } else {
+                warnings.push_back(d);
+            }
+        };
+        if (spec.steps.empty() || spec.steps.size() > kMaxHotkeySequenceSteps
+            || !std::all_of(spec.steps.begin(), spec.steps.end(), IsValidStep)) {
+            report(HotkeyConflictKind::kInvalid, UINT32_MAX);
+            continue;
+        }
+
+        // Dry walk along the existing path: decide before the trie is touched
+        warnings.clear();
+        bool rejected = false;
+        bool full_path = false;
+        uint32_t node = 0;
+        for (size_t depth = 0; depth < spec.steps.size() && !rejected; ++depth) {
+            const auto it = build[node].children.find(spec.steps[depth]);
+            if (it == build[node].children.end()) break;
+            node = it->second;
+            if (depth + 1 == spec.steps.size()) {
+                full_path = true;
+                break;
+            }
+            for (const uint32_t other : build[node].terminals) {
+                if (bindings[other].group == spec.group) {
+                    report(HotkeyConflictKind::kShadowedByPrefix, other);
+                    rejected = true;
+                    break;
+                }
+                report(HotkeyConflictKind::kPrefixAcrossGroups, other);
+            }
+        }
+        if (full_path) {
+            for (const uint32_t other : build[node].terminals) {
+                if (bindings[other].group == spec.group) {
+                    report(HotkeyConflictKind::kDuplicate, other);
+                    rejected = true;
+                    break;
+                }
+                report(HotkeyConflictKind::kSharedAcrossGroups, other);
+            }
+        }
+        if (full_path && !rejected) {
+            for (const uint32_t other : build[node].below) {
+                if (bindings[other].group == spec.group) {
+                    report(HotkeyConflictKind::kShadowsLonger, other);
+                    rejected = true;
+                    break;
+                }
+                report(HotkeyConflictKind::kPrefixAcrossGroups, other);
+            }
+        }
+        if (rejected) {
+            continue;
+        }
+        matcher.diagnostics_.insert(matcher.diagnostics_.end(), warnings.begin(), warnings.end());
+        warnings.clear();
+
+        node = 0;
+        for (const HotkeyStep& step : spec.steps) {
+            build[node].below.push_back(index);
+            const auto it = build[node].children.find(step);
+            if (it != build[node].children.end()) {
+                node = it->second;
+                continue;
+            }
+            const uint32_t child = static_cast<uint32_t>(build.size());
+            build[node].children.emplace(step, child);
+            build.emplace_back();
+            node = child;
+        }
+        build[node].terminals.push_back(index);
+        ++matcher.binding_count_;
+    }
+
+    // Flatten (build indices are kept: node 0 stays the root)
+    matcher.nodes_.resize(build.size());
+    for (uint32_t n = 0; n < build.size(); ++n) {
+        Node& out = matcher.nodes_[n];
+        out.first_action = static_cast<uint32_t>(matcher.actions_.size());
+        for (const uint32_t index : build[n].terminals) {
+            matcher.actions_.push_back(bindings[index].action);
+        }
+        out.action_count = static_cast<uint32_t>(matcher.actions_.size()) - out.first_action;
+
+        out.first_transition = static_cast<uint32_t>(matcher.transitions_.size());
+        for (const auto& [step, child] : build[n].children) {
+            for (size_t k = 0; k < step.key_count; ++k) {
+                Transition t;
+                t.vk = step.keys[k];
+                t.modifiers = step.modifiers;
+                t.target = child;
+                for (size_t r = 0; r < step.key_count; ++r) {
+                    if (r != k) t.required[t.required_count++] = step.keys[r];
+                }
+                BitmapSet(matcher.used_keys_, step.keys[k]);
+                matcher.transitions_.push_back(t);
+            }
+        }
+        out.transition_count = static_cast<uint32_t>(matcher.transitions_.size()) - out.first_transition;
+        std::sort(matcher.transitions_.begin() + out.first_transition, matcher.transitions_.end(),
+                  [](const Transition& a, const Transition& b) {
+                      return a.vk != b.vk ? a.vk < b.vk : a.required_count > b.required_count;
+                  });
+    }
+    return matcher;
+}
+
+uint32_t CompiledHotkeyMatcher::FindTransition(uint32_t node, uint8_t vk, uint8_t modifiers,
+                                               const HotkeyKeyBitmap& held) const {
+    const Node& n = nodes_[node];
+    const auto begin = transitions_.begin() + n.first_transition;
+    const auto end = begin + n.transition_count;
+    auto it = std::lower_bound(begin, end, vk, [](const Transition& t, uint8_t key) { return t.vk < key; });
+    for (; it != end && it->vk == vk; ++it) {
+        if (it->modifiers != modifiers) continue;
+        bool held_all = true;
+        for (size_t r = 0; r < it->required_count && held_all; ++r) {
+            held_all = BitmapHas(held, it->required[r]);
+        }
+        if (held_all) return it->target;
+    }
+    return kNoNode;
+}
+
+std::span<const uint32_t> CompiledHotkeyMatcher::OnKeyDown(HotkeyMatchState& state, int vk,
+                                                           const HotkeyKeyBitmap& held, int64_t now_ns) const {
+    if (nodes_.empty() || vk <= 0 || vk > 255 || IsHotkeyModifierKey(vk)) {
+        return {};
+    }
+    if (state.node >= nodes_.size() || (state.node != 0 && now_ns - state.step_time_ns > kHotkeySequenceTimeoutNs)) {
+        state.node = 0;
+    }
+    const uint8_t key = static_cast<uint8_t>(vk);
+    const uint8_t modifiers = HotkeyModifiersFromBitmap(held);
+    uint32_t target = FindTransition(state.node, key, modifiers, held);
+    if (target == kNoNode && state.node != 0) {
+        // Sequence broken: the key may still start something from the root
+        state.node = 0;
+        target = FindTransition(0, key, modifiers, held);
+    }
+    if (target == kNoNode) {
+        return {};
+    }
+    const Node& n = nodes_[target];
+    if (n.transition_count > 0) {
+        state.node = target;
+        state.step_time_ns = now_ns;
+    } else {
+        state.node = 0;
+    }
+    return {actions_.data() + n.first_action, n.action_count};
+}
+
+}  // namespace ui::new_ui
@@ -0,0 +1,141 @@
+// Source Code <Display Commander> // Compiled hotkey matcher core (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ui::new_ui {
+
+inline constexpr uint8_t kHotkeyModCtrl = 1u << 0;
+inline constexpr uint8_t kHotkeyModShift = 1u << 1;
+inline constexpr uint8_t kHotkeyModAlt = 1u << 2;
+inline constexpr uint8_t kHotkeyModWin = 1u << 3;
+
+inline constexpr size_t kMaxHotkeyChordKeys = 4;      // Non-modifier keys held together in one step
+inline constexpr size_t kMaxHotkeySequenceSteps = 4;  // Steps pressed one after another ("ctrl k, ctrl s")
+inline constexpr int64_t kHotkeySequenceTimeoutNs = 1'000'000'000;  // Max gap between two steps of a sequence
+
+// 256-bit virtual-key set (bit vk of word vk / 64)
+using HotkeyKeyBitmap = std::array<uint64_t, 4>;
+
+// One step of a binding: exact modifier set plus 1..kMaxHotkeyChordKeys keys that must all be down.
+struct HotkeyStep {
+    uint8_t modifiers = 0;                               // kHotkeyMod* flags
+    uint8_t key_count = 0;                               // Keys used in `keys`
+    std::array<uint8_t, kMaxHotkeyChordKeys> keys = {};  // Ascending, distinct, no modifier keys; unused = 0
+
+    auto operator<=>(const HotkeyStep&) const = default;
+};
+
+// VK_SHIFT / VK_CONTROL / VK_MENU / VK_LWIN / VK_RWIN and their left / right variants.
+bool IsHotkeyModifierKey(int vk);
+
+// kHotkeyMod* flags of the generic modifier keys (either Windows key) in a key set.
+uint8_t HotkeyModifiersFromBitmap(const HotkeyKeyBitmap& keys);
+
+// Lower-case key token -> virtual key (1..255), 0 if unknown.
+using HotkeyKeyResolver = int (*)(std::string_view token);
+// Virtual key -> display name.
+using HotkeyKeyNamer = std::string (*)(int vk);
+
+// Parses "ctrl shift d", "ctrl+shift+d", chords ("a s": both held) and sequences ("ctrl k, ctrl s"). Tokens are
+// separated by spaces or '+' (a token the resolver knows as a whole, like "numpad+", is kept), steps by ','.
+// Returns false with a message in *error (if not null) when a token or step is invalid.
+bool ParseHotkeyBinding(std::string_view text, HotkeyKeyResolver resolve, std::vector<HotkeyStep>& steps,
+                        std::string* error);
+
+// Inverse of ParseHotkeyBinding; key_separator is ' ' (config form) or '+' (display form).
+std::string FormatHotkeyBinding(const std::vector<HotkeyStep>& steps, HotkeyKeyNamer name, char key_separator);
+
+struct HotkeyBindingSpec {
+    uint32_t action = 0;  // Caller id reported when the binding fires (e.g. definition index)
+    uint32_t group = 0;   // Exclusive group: bindings of one group must not overlap
+    std::vector<HotkeyStep> steps;
+};
+
+enum class HotkeyConflictKind : uint8_t {
+    kInvalid = 0,         // Error: no steps, too many steps / chord keys, or a modifier used as key; dropped
+    kDuplicate,           // Error: same steps as `other` in the same group; dropped
+    kShadowedByPrefix,    // Error: `other` (same group) is a prefix and always fires first; dropped
+    kShadowsLonger,       // Error: prefix of `other` (same group), which could never fire; dropped
+    kSharedAcrossGroups,  // Warning: same steps as `other` in another group; both fire
+    kPrefixAcrossGroups,  // Warning: prefix relation with `other` in another group; the shorter fires, the longer
+                          // still completes
+};
+
+struct HotkeyDiagnostic {
+    HotkeyConflictKind kind = HotkeyConflictKind::kInvalid;
+    uint32_t action = 0;                 // Binding the diagnostic is about
+    uint32_t other_action = UINT32_MAX;  // Binding it conflicts with (UINT32_MAX for kInvalid)
+
+    bool IsError() const {
+        return kind != HotkeyConflictKind::kSharedAcrossGroups && kind != HotkeyConflictKind::kPrefixAcrossGroups;
+    }
+};
+
+const char* HotkeyConflictKindName(HotkeyConflictKind kind);
+
+// Sequence progress of one consumer.
+struct HotkeyMatchState {
+    uint32_t node = 0;  // 0 = root (no sequence in progress)
+    int64_t step_time_ns = 0;
+};
+
+// Bindings compiled into a trie over key-down events. Conflicts are resolved once, at compile time (earlier bindings
+// win), so matching is a binary search in the current node's transitions per key-down and needs no allocation.
+//
+// A chord step has one transition per member key (the others must already be held), so it fires on whichever key
+// goes down last. Among transitions for the same key the most specific (most held keys required) wins; modifiers
+// must match exactly, other held keys are ignored.
+class CompiledHotkeyMatcher {
+   public:
+    static CompiledHotkeyMatcher Compile(const std::vector<HotkeyBindingSpec>& bindings);
+
+    // held: keys down when vk went down (including vk). Returns the actions of the binding(s) completed by this
+    // key-down (empty otherwise). Modifier keys never advance or reset a sequence.
+    std::span<const uint32_t> OnKeyDown(HotkeyMatchState& state, int vk, const HotkeyKeyBitmap& held,
+                                        int64_t now_ns) const;
+
+    const std::vector<HotkeyDiagnostic>& GetDiagnostics() const { return diagnostics_; }
+    // Every key some binding can trigger or requires (modifiers excluded).
+    const HotkeyKeyBitmap& GetUsedKeys() const { return used_keys_; }
+    size_t GetBindingCount() const { return binding_count_; }
+    size_t GetNodeCount() const { return nodes_.size(); }
+    size_t GetTransitionCount() const { return transitions_.size(); }
+
+   private:
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    struct Node {
+        uint32_t first_transition = 0;
+        uint32_t transition_count = 0;
+        uint32_t first_action = 0;
+        uint32_t action_count = 0;
+    };
+
+    struct Transition {
+        uint8_t vk = 0;
+        uint8_t modifiers = 0;
+        uint8_t required_count = 0;
+        std::array<uint8_t, kMaxHotkeyChordKeys - 1> required = {};  // Other chord keys that must be held
+        uint32_t target = 0;
+    };
+
+    uint32_t FindTransition(uint32_t node, uint8_t vk, uint8_t modifiers, const HotkeyKeyBitmap& held) const;
+
+    std::vector<Node> nodes_;              // nodes_[0] = root
+    std::vector<Transition> transitions_;  // Per node sorted by vk, then most required keys first
+    std::vector<uint32_t> actions_;
+    std::vector<HotkeyDiagnostic> diagnostics_;
+    HotkeyKeyBitmap used_keys_ = {};
+    size_t binding_count_ = 0;
+};
+
+}  // namespace ui::new_ui
@@ -17,13 +17,17 @@
 #include "../../utils/timing.hpp"
 #include "../imgui_wrapper_base.hpp"
 #include "../../display/display_cache.hpp"
+#include "../../feature/frame_capture/frame_capture.hpp"
+#include "../../feature/trace/trace.hpp"
 #include "imgui.h"
 #include "settings_wrapper.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -88,6 +92,46 @@ static std::string VkToReadableName(int vk) {
     return "key" + std::to_string(vk);
 }
 
+// Lower-case key name -> VK (names from the table, or "key<N>"); 0 if unknown
+static int VkFromKeyName(const std::string& name) {
+    for (int vk = 0; vk < 256; ++vk) {
+        for (const std::string& s : g_vk_to_strings[vk]) {
+            std::string sl = s;
+            std::transform(sl.begin(), sl.end(), sl.begin(), ::tolower);
+            if (sl == name) {
+                return vk;
+            }
+        }
+    }
+    if (name.size() >= 4 && name.substr(0, 3) == "key") {
+        try {
+            int vk = std::stoi(name.substr(3));
+            if (vk >= 1 && vk <= 255) return vk;
+        } catch (...) {
+        }
+    }
+    return 0;
+}
+
+// HotkeyKeyResolver for ParseHotkeyBinding
+static int ResolveKeyToken(std::string_view token) { return VkFromKeyName(std::string(token)); }
+
+// True for bindings the single key_code + modifier fields cannot represent (chords, sequences)
+static bool IsMultiKeyHotkey(const ParsedHotkey& p) {
+    return p.steps.size() > 1 || (p.steps.size() == 1 && p.steps[0].key_count > 1);
+}
+
+// Steps of a binding; a single key becomes one step
+static std::vector<HotkeyStep> HotkeyStepsOf(const ParsedHotkey& p) {
+    if (!p.steps.empty()) return p.steps;
+    HotkeyStep step;
+    step.modifiers = static_cast<uint8_t>((p.ctrl ? kHotkeyModCtrl : 0) | (p.shift ? kHotkeyModShift : 0)
+                                          | (p.alt ? kHotkeyModAlt : 0) | (p.win ? kHotkeyModWin : 0));
+    step.key_count = 1;
+    step.keys[0] = static_cast<uint8_t>(p.key_code);
+    return {step};
+}
+
 // Parse readable space-separated format: "ctrl a", "alt numpad+", "numpad+"
 static ParsedHotkey ParseReadableHotkeyString(const std::string& value) {
     ParsedHotkey p;
@@ -112,23 +156,8 @@ static ParsedHotkey ParseReadableHotkeyString(const std::string& value) {
             p.win = true;
         } else {
             // Key: look up in VK table (case-insensitive)
-            for (int vk = 0; vk < 256; ++vk) {
-                for (const std::string& s : g_vk_to_strings[vk]) {
-                    std::string sl = s;
-                    std::transform(sl.begin(), sl.end(), sl.begin(), ::tolower);
-                    if (sl == t) {
-                        p.key_code = vk;
-                        break;
-                    }
-                }
-                if (p.key_code != 0) break;
-            }
-            if (p.key_code == 0 && t.size() >= 4 && t.substr(0, 3) == "key") {
-                try {
-                    int vk = std::stoi(t.substr(3));
-                    if (vk >= 1 && vk <= 255) p.key_code = vk;
-                } catch (...) {
-                }
+            if (const int vk = VkFromKeyName(t); vk != 0) {
+                p.key_code = vk;
             }
         }
     }
@@ -137,6 +166,7 @@ static ParsedHotkey ParseReadableHotkeyString(const std::string& value) {
 
 std::string SerializeHotkeyToConfigString(const ParsedHotkey& p) {
     if (!p.IsValid()) return "";
+    if (IsMultiKeyHotkey(p)) return FormatHotkeyBinding(p.steps, VkToReadableName, ' ');
     std::ostringstream oss;
     bool first = true;
     if (p.ctrl) {
@@ -167,6 +197,20 @@ std::string SerializeHotkeyToConfigString(const ParsedHotkey& p) {
 ParsedHotkey DeserializeHotkeyFromConfigString(const std::string& value) {
     ParsedHotkey p;
     if (value.empty()) return p;
+    // Chord "a s" / sequence "ctrl k, ctrl s"
+    std::vector<HotkeyStep> steps;
+    if (ParseHotkeyBinding(value, ResolveKeyToken, steps, nullptr)
+        && (steps.size() > 1 || steps[0].key_count > 1)) {
+        const HotkeyStep& last = steps.back();
+        p.key_code = last.keys[last.key_count - 1];
+        p.ctrl = (last.modifiers & kHotkeyModCtrl) != 0;
+        p.shift = (last.modifiers & kHotkeyModShift) != 0;
+        p.alt = (last.modifiers & kHotkeyModAlt) != 0;
+        p.win = (last.modifiers & kHotkeyModWin) != 0;
+        p.steps = std::move(steps);
+        p.original_string = value;
+        return p;
+    }
     // Readable format: "ctrl a", "alt numpad+", "numpad+"
     p = ParseReadableHotkeyString(value);
     if (p.IsValid()) return p;
@@ -183,6 +227,90 @@ struct ModuleHotkeyBinding {
 };
 std::vector<ModuleHotkeyBinding> g_module_hotkey_bindings;
 
+// g_hotkey_definitions compiled for ProcessHotkeys (continuous monitoring thread); recompiled only when a binding or
+// the module set changes
+CompiledHotkeyMatcher g_hotkey_matcher;
+std::string g_hotkey_matcher_signature;
+HotkeyMatchState g_hotkey_match_state;
+std::atomic<bool> g_hotkey_bindings_dirty{true};
+// Diagnostics of the last compile, formatted for the Hotkeys tab
+std::atomic<std::shared_ptr<const std::vector<std::string>>> g_hotkey_conflicts{nullptr};
+
+bool IsModuleHotkeyDisabled(size_t definition_index) {
+    for (const ModuleHotkeyBinding& binding : g_module_hotkey_bindings) {
+        if (binding.definition_index == definition_index) {
+            return !modules::IsModuleEnabled(binding.module_id);
+        }
+    }
+    return false;
+}
+
+void RebuildHotkeyMatcherIfChanged() {
+    std::string signature;
+    for (const HotkeyDefinition& def : g_hotkey_definitions) {
+        signature += def.id;
+        signature += '=';
+        signature += SerializeHotkeyToConfigString(def.parsed);
+        signature += '\n';
+    }
+    if (signature == g_hotkey_matcher_signature) {
+        return;
+    }
+    g_hotkey_matcher_signature = std::move(signature);
+
+    // Exclusive groups: built-in hotkeys are group 0, each module has its own group
+    std::vector<std::string> module_groups;
+    std::vector<HotkeyBindingSpec> specs;
+    specs.reserve(g_hotkey_definitions.size());
+    for (size_t i = 0; i < g_hotkey_definitions.size(); ++i) {
+        const HotkeyDefinition& def = g_hotkey_definitions[i];
+        if (!def.parsed.IsValid()) {
+            continue;
+        }
+        HotkeyBindingSpec spec;
+        spec.action = static_cast<uint32_t>(i);
+        for (const ModuleHotkeyBinding& binding : g_module_hotkey_bindings) {
+            if (binding.definition_index != i) {
+                continue;
+            }
+            const auto it = std::find(module_groups.begin(), module_groups.end(), binding.module_id);
+            spec.group = static_cast<uint32_t>(it - module_groups.begin()) + 1;
+            if (it == module_groups.end()) {
+                module_groups.push_back(binding.module_id);
+            }
+            break;
+        }
+        spec.steps = HotkeyStepsOf(def.parsed);
+        specs.push_back(std::move(spec));
+    }
+    g_hotkey_matcher = CompiledHotkeyMatcher::Compile(specs);
+    g_hotkey_match_state = {};
+
+    // Polling reconciliation only covers keys that were checked once
+    const HotkeyKeyBitmap& used_keys = g_hotkey_matcher.GetUsedKeys();
+    for (int vk = 0; vk < 256; ++vk) {
+        if ((used_keys[static_cast<size_t>(vk) >> 6] & (1ull << (vk & 63))) != 0) {
+            display_commanderhooks::keyboard_tracker::IsKeyDown(vk);
+        }
+    }
+
+    auto conflicts = std::make_shared<std::vector<std::string>>();
+    for (const HotkeyDiagnostic& d : g_hotkey_matcher.GetDiagnostics()) {
+        std::string line = g_hotkey_definitions[d.action].name + ": " + HotkeyConflictKindName(d.kind);
+        if (d.other_action < g_hotkey_definitions.size()) {
+            line += " '" + g_hotkey_definitions[d.other_action].name + "'";
+        }
+        line += " (" + FormatHotkeyString(g_hotkey_definitions[d.action].parsed) + ")";
+        if (d.IsError()) {
+            LogWarn("Hotkey conflict: %s - binding disabled", line.c_str());
+        } else {
+            LogInfo("Hotkey overlap: %s", line.c_str());
+        }
+        conflicts->push_back(std::move(line));
+    }
+    g_hotkey_conflicts.store(std::move(conflicts), std::memory_order_release);
+}
+
 std::string NormalizeModuleHotkeyKeyPart(std::string_view text) {
     std::string out;
     out.reserve(text.size());
@@ -263,6 +391,7 @@ void DrawHotkeyEntry(display_commander::ui::IImGuiWrapper& imgui, HotkeyDefiniti
         save_value(SerializeHotkeyToConfigString(s_captured_parsed));
         def.parsed = s_captured_parsed;
         def.parsed.original_string = FormatHotkeyString(s_captured_parsed);
+        g_hotkey_bindings_dirty.store(true, std::memory_order_release);
         s_capture_pending = false;
         s_captured_for_index = -1;
     }
@@ -278,6 +407,7 @@ void DrawHotkeyEntry(display_commander::ui::IImGuiWrapper& imgui, HotkeyDefiniti
             std::string new_value(buffer);
             save_value(new_value);
             def.parsed = DeserializeHotkeyFromConfigString(new_value);
+            g_hotkey_bindings_dirty.store(true, std::memory_order_release);
         }
     }
 
@@ -318,6 +448,7 @@ void DrawHotkeyEntry(display_commander::ui::IImGuiWrapper& imgui, HotkeyDefiniti
         if (imgui.Button(("Reset##" + def.id).c_str())) {
             save_value(def.default_shortcut);
             def.parsed = DeserializeHotkeyFromConfigString(def.default_shortcut);
+            g_hotkey_bindings_dirty.store(true, std::memory_order_release);
         }
     }
 }
@@ -345,6 +476,7 @@ void InitializeHotkeyDefinitions() {
              bool current_state = s_input_blocking_toggle.load();
              bool new_state = !current_state;
              s_input_blocking_toggle.store(new_state);
+             display_commanderhooks::RefreshMessageSuppressionFilter();
              std::ostringstream oss;
              oss << "Input Blocking " << (new_state ? "enabled" : "disabled") << " via hotkey";
              LogInfo(oss.str().c_str());
@@ -501,7 +633,14 @@ void InitializeHotkeyDefinitions() {
              settings::g_mainTabSettings.selected_extended_display_device_id.SetValue(secondary_id);
              settings::g_mainTabSettings.target_extended_display_device_id.SetValue(secondary_id);
              LogInfo("Move to secondary: target display set to secondary monitor.");
-         }}};
+         }},
+        {"frame_capture", "Frame capture (start/stop)", "",
+         "Start or stop a frame-timing capture (.dcfc + PresentMon-style CSV in the frame_captures folder).",
+         []() { display_commander::feature::frame_capture::ToggleFrameCapture(); }},
+        {"trace_capture", "Trace export (start/stop)", "",
+         "Start or stop a Chrome trace (.json for Perfetto UI / chrome://tracing) of frame phases, latency markers, "
+         "detour spans, monitoring tasks and log flushes.",
+         []() { display_commander::feature::trace::ToggleTrace(); }}};
 
     // Map settings to definitions
     auto& settings = settings::g_hotkeysTabSettings;
@@ -527,6 +666,10 @@ void InitializeHotkeyDefinitions() {
             DeserializeHotkeyFromConfigString(settings.hotkey_move_to_primary.GetValue());
         g_hotkey_definitions[static_cast<size_t>(HotkeyId::MoveToSecondary)].parsed =
             DeserializeHotkeyFromConfigString(settings.hotkey_move_to_secondary.GetValue());
+        g_hotkey_definitions[static_cast<size_t>(HotkeyId::FrameCapture)].parsed =
+            DeserializeHotkeyFromConfigString(settings.hotkey_frame_capture.GetValue());
+        g_hotkey_definitions[static_cast<size_t>(HotkeyId::TraceCapture)].parsed =
+            DeserializeHotkeyFromConfigString(settings.hotkey_trace_capture.GetValue());
     }
 
     g_module_hotkey_bindings.clear();
@@ -629,6 +772,9 @@ std::string FormatHotkeyString(const ParsedHotkey& hotkey) {
     if (!hotkey.IsValid()) {
         return "";
     }
+    if (IsMultiKeyHotkey(hotkey)) {
+        return FormatHotkeyBinding(hotkey.steps, VkToReadableName, '+');
+    }
 
     std::ostringstream oss;
     bool first = true;
@@ -702,6 +848,10 @@ void SyncHotkeySettingsFromParsed() {
         SerializeHotkeyToConfigString(g_hotkey_definitions[static_cast<size_t>(HotkeyId::MoveToPrimary)].parsed));
     s.hotkey_move_to_secondary.SetValue(
         SerializeHotkeyToConfigString(g_hotkey_definitions[static_cast<size_t>(HotkeyId::MoveToSecondary)].parsed));
+    s.hotkey_frame_capture.SetValue(
+        SerializeHotkeyToConfigString(g_hotkey_definitions[static_cast<size_t>(HotkeyId::FrameCapture)].parsed));
+    s.hotkey_trace_capture.SetValue(
+        SerializeHotkeyToConfigString(g_hotkey_definitions[static_cast<size_t>(HotkeyId::TraceCapture)].parsed));
 
     for (const ModuleHotkeyBinding& binding : g_module_hotkey_bindings) {
         if (binding.definition_index >= g_hotkey_definitions.size()) {
@@ -761,6 +911,8 @@ void DrawHotkeysTab(display_commander::ui::IImGuiWrapper& imgui) {
                     case HotkeyId::WinRight: setting_ptr = &settings.hotkey_win_right; break;
                     case HotkeyId::MoveToPrimary: setting_ptr = &settings.hotkey_move_to_primary; break;
                     case HotkeyId::MoveToSecondary: setting_ptr = &settings.hotkey_move_to_secondary; break;
+                    case HotkeyId::FrameCapture: setting_ptr = &settings.hotkey_frame_capture; break;
+                    case HotkeyId::TraceCapture: setting_ptr = &settings.hotkey_trace_capture; break;
                     default: setting_ptr = nullptr; break;
                 }
                     if (setting_ptr != nullptr) {
@@ -787,6 +939,20 @@ void DrawHotkeysTab(display_commander::ui::IImGuiWrapper& imgui) {
         imgui.TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Format: ctrl+shift+key");
         imgui.TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Empty string = disabled");
         imgui.TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Example: \"ctrl a\", \"alt numpad+\"");
+        imgui.TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                          "Chord (keys held together): \"a s\"; sequence (within 1 s): \"ctrl k, ctrl s\"");
+
+        const std::shared_ptr<const std::vector<std::string>> conflicts =
+            g_hotkey_conflicts.load(std::memory_order_acquire);
+        if (conflicts && !conflicts->empty()) {
+            imgui.Spacing();
+            ui::colors::PushIconColor(&imgui, ui::colors::ICON_WARNING);
+            imgui.Text(ICON_FK_WARNING " Binding conflicts (earlier binding wins):");
+            ui::colors::PopIconColor(&imgui);
+            for (const std::string& line : *conflicts) {
+                imgui.BulletText("%s", line.c_str());
+            }
+        }
     }
 
     // Debug Information Section
@@ -898,7 +1064,8 @@ void DrawHotkeysTab(display_commander::ui::IImGuiWrapper& imgui) {
 
 bool IsCapturingHotkey() { return s_capturing_hotkey_index >= 0; }
 
-// Process all hotkeys (call from continuous monitoring loop, same thread as keyboard_tracker::Update)
+// Process all hotkeys (call from continuous monitoring loop, same thread as keyboard_tracker::Update; the task is also
+// requested on every key-down edge, so a press is handled without waiting for the next tick)
 void ProcessHotkeys() {
     if (IsCapturingHotkey()) {
         // Prime all keys 0-255 so keyboard_tracker::Update() will track them next run
@@ -936,6 +1103,10 @@ void ProcessHotkeys() {
     if (last_dynamic_refresh_ns == 0 || now_for_refresh - last_dynamic_refresh_ns > utils::SEC_TO_NS) {
         InitializeHotkeyDefinitions();
         last_dynamic_refresh_ns = now_for_refresh;
+        g_hotkey_bindings_dirty.store(true, std::memory_order_release);
+    }
+    if (g_hotkey_bindings_dirty.exchange(false, std::memory_order_acq_rel)) {
+        RebuildHotkeyMatcherIfChanged();
     }
 
     // Update debug info - always track when this function is called
@@ -985,7 +1156,7 @@ void ProcessHotkeys() {
     g_hotkey_debug_info.last_block_reason = "";
 
     // Win+Down / Win+Up / Win+Left / Win+Right are handled by configurable hotkeys (see definitions with id win_down,
-    // win_up, win_left, win_right) and processed in the generic loop below.
+    // win_up, win_left, win_right) and matched with all other bindings below.
 
     // Allow hotkeys if game in foreground or overlay UI open
     if (!allow_hotkeys) {
@@ -1003,6 +1174,7 @@ void ProcessHotkeys() {
                 break;
             }
         }
+        g_hotkey_match_state = {};
         if (game_hwnd == nullptr) {
             g_hotkey_debug_info.last_block_reason = "No game window detected (swapchain not initialized)";
         } else {
@@ -1011,49 +1183,20 @@ void ProcessHotkeys() {
         return;
     }
 
-    // Process each hotkey definition
-    for (size_t i = 0; i < g_hotkey_definitions.size(); ++i) {
-        auto& def = g_hotkey_definitions[i];
-        bool skip_module_hotkey = false;
-        for (const ModuleHotkeyBinding& binding : g_module_hotkey_bindings) {
-            if (binding.definition_index == i && !modules::IsModuleEnabled(binding.module_id)) {
-                skip_module_hotkey = true;
-                break;
+    // Feed this pass's key-downs, in arrival order, through the compiled matcher (one lookup per key-down instead of
+    // checking every definition)
+    for (const display_commanderhooks::keyboard_tracker::KeyPress& press :
+         display_commanderhooks::keyboard_tracker::GetFramePresses()) {
+        for (const uint32_t index :
+             g_hotkey_matcher.OnKeyDown(g_hotkey_match_state, press.vk, press.held, press.time_ns)) {
+            if (index >= g_hotkey_definitions.size() || IsModuleHotkeyDisabled(index)) {
+                continue;
+            }
+            const auto& def = g_hotkey_definitions[index];
+            if (def.action) {
+                def.action();
+                display_commanderhooks::keyboard_tracker::ReportHotkeyHandled(press.vk);
             }
-        }
-        if (skip_module_hotkey) {
-            continue;
-        }
-
-        if (!def.parsed.IsValid() || def.parsed.IsEmpty()) {
-            continue;
-        }
-
-        const auto& hotkey = def.parsed;
-
-        // Check if the key was pressed
-        bool key_pressed = display_commanderhooks::keyboard_tracker::IsKeyPressed(hotkey.key_code);
-        if (!key_pressed) {
-            continue;
-        }
-
-        // Check modifier states (must match exactly - if hotkey requires modifier, it must be pressed; if not, it must
-        // not be pressed)
-        bool ctrl_down = display_commanderhooks::keyboard_tracker::IsKeyDown(VK_CONTROL);
-        bool shift_down = display_commanderhooks::keyboard_tracker::IsKeyDown(VK_SHIFT);
-        bool alt_down = display_commanderhooks::keyboard_tracker::IsKeyDown(VK_MENU);
-        bool win_down = display_commanderhooks::keyboard_tracker::IsKeyDown(VK_LWIN)
-                        || display_commanderhooks::keyboard_tracker::IsKeyDown(VK_RWIN);
-
-        // Check if modifiers match exactly
-        if (hotkey.ctrl != ctrl_down) continue;
-        if (hotkey.shift != shift_down) continue;
-        if (hotkey.alt != alt_down) continue;
-        if (hotkey.win != win_down) continue;
-
-        // All conditions met - execute the action
-        if (def.action) {
-            def.action();
         }
     }
 }
@@ -6,6 +6,8 @@ struct IImGuiWrapper;
 }  // namespace ui
 }  // namespace display_commander
 
+#include "hotkey_matcher.hpp"
+
 #include <array>
 #include <functional>
 #include <string>
@@ -31,6 +33,8 @@ enum class HotkeyId : int {
     WinRight,
     MoveToPrimary,
     MoveToSecondary,
+    FrameCapture,
+    TraceCapture,
     Count
 };
 
@@ -44,6 +48,9 @@ struct ParsedHotkey {
     bool alt = false;             // Alt modifier
     bool win = false;             // Windows key modifier
     std::string original_string;  // Original string (for legacy/display; prefer FormatHotkeyString)
+    // Chord / sequence binding ("a s", "ctrl k, ctrl s"); empty for a single key. key_code and modifiers then hold
+    // the last key of the last step.
+    std::vector<HotkeyStep> steps;
 
     bool IsValid() const { return key_code != 0; }
     bool IsEmpty() const { return key_code == 0 && !ctrl && !shift && !alt && !win; }
@@ -61,7 +68,8 @@ struct HotkeyDefinition {
     bool enabled = true;  // Whether this hotkey is enabled
 };
 
-// Parse a shortcut string like "ctrl+t" or "ctrl+shift+backspace"
+// Parse a shortcut string like "ctrl+t" or "ctrl+shift+backspace" (single key; see ParseHotkeyBinding for chords and
+// sequences)
 ParsedHotkey ParseHotkeyString(const std::string& shortcut);
 
 // Format a parsed hotkey back to a string (primary display form; no parsing needed)
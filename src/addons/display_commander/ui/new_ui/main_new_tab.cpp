@@ -193,11 +193,11 @@ void InitMainNewTab() {
 
         settings_loaded_once = true;
 
-        // FPS limiter: enabled checkbox + mode (0=OnPresentSync, 1=Reflex; clamp to 0-1)
+        // FPS limiter: enabled checkbox + mode (0=OnPresentSync, 1=Reflex, 2=VBlank phase lock; clamp to 0-2)
         s_fps_limiter_enabled.store(settings::g_mainTabSettings.fps_limiter_enabled.GetValue());
         int mode_val = settings::g_mainTabSettings.fps_limiter_mode.GetValue();
-        if (mode_val < 0 || mode_val > 1) {
-            mode_val = (mode_val < 0) ? 0 : 1;
+        if (mode_val < 0 || mode_val > 2) {
+            mode_val = (mode_val < 0) ? 0 : 2;
             settings::g_mainTabSettings.fps_limiter_mode.SetValue(mode_val);
         }
         s_fps_limiter_mode.store(static_cast<FpsLimiterMode>(mode_val));
@@ -1,11 +1,15 @@
 #include "detour_call_tracker.hpp"
 #include "srwlock_registry.hpp"
 #include "srwlock_wrapper.hpp"
+#include "timing.hpp"
+#include "../feature/trace/trace.hpp"
 #include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
@@ -15,20 +19,52 @@ namespace {
 Entry g_entries[MAX_ENTRIES];
 std::atomic<uint64_t> g_used_entries{0};
 
+// SetTracedSites filter: substrings split at ',' (nullptr = none). Each filter is published once and never changed
+// or freed, so a site's first call matches its key without a lock; SetTracedSites runs a few times per trace.
+using TracedSiteFilters = std::vector<std::string>;
+std::atomic<const TracedSiteFilters*> g_traced_site_filters{nullptr};
+std::mutex g_traced_sites_mutex;  // Serializes SetTracedSites
+std::vector<std::unique_ptr<const TracedSiteFilters>> g_traced_site_filter_sets;  // Under g_traced_sites_mutex
+
+bool MatchesTracedSites(const TracedSiteFilters* filters, const char* key) {
+    if (filters == nullptr || key == nullptr) {
+        return false;
+    }
+    for (const std::string& filter : *filters) {
+        if (std::strstr(key, filter.c_str()) != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // anonymous namespace
 
 uint32_t AllocateEntryIndex(const char* key) {
-    uint64_t idx = g_used_entries.fetch_add(1, std::memory_order_relaxed);
+    // seq_cst with the key store and filter loads below: SetTracedSites stores the filter, then loads the count and
+    // the keys, so either it sees this entry or this call sees its filter.
+    uint64_t idx = g_used_entries.fetch_add(1);
     if (idx >= MAX_ENTRIES) {
         return 0;
     }
     Entry& e = g_entries[static_cast<size_t>(idx)];
-    e.key = key;
     e.inprogress_cnt.store(0, std::memory_order_relaxed);
     e.total_cnt.store(0, std::memory_order_relaxed);
     e.last_call_ns.store(0, std::memory_order_relaxed);
     e.prev_call_ns.store(0, std::memory_order_relaxed);
     e.context[0] = '\0';
+    e.key.store(key);
+    // No lock here (first call of a detour). Re-check after storing: a SetTracedSites that ran in between may have
+    // stored its result before this one.
+    const TracedSiteFilters* filters = g_traced_site_filters.load();
+    for (;;) {
+        e.traced.store(MatchesTracedSites(filters, key));
+        const TracedSiteFilters* latest = g_traced_site_filters.load();
+        if (latest == filters) {
+            break;
+        }
+        filters = latest;
+    }
     return static_cast<uint32_t>(idx);
 }
 
@@ -43,7 +79,8 @@ void SetCallSiteContextByKey(const char* key, const char* fmt, ...) {
     size_t limit = (std::min)(static_cast<uint64_t>(MAX_ENTRIES), used);
     for (size_t i = 0; i < limit; ++i) {
         Entry& e = g_entries[i];
-        if (e.key != nullptr && std::strcmp(e.key, key) == 0) {
+        const char* entry_key = e.key.load(std::memory_order_acquire);
+        if (entry_key != nullptr && std::strcmp(entry_key, key) == 0) {
             (void)std::vsnprintf(e.context, CONTEXT_SIZE, fmt, args);
             break;
         }
@@ -51,6 +88,42 @@ void SetCallSiteContextByKey(const char* key, const char* fmt, ...) {
     va_end(args);
 }
 
+void SetTracedSites(const std::string& filter) {
+    std::lock_guard<std::mutex> lock(g_traced_sites_mutex);
+    auto filters = std::make_unique<TracedSiteFilters>();
+    size_t begin = 0;
+    while (begin <= filter.size()) {
+        size_t end = filter.find(',', begin);
+        if (end == std::string::npos) {
+            end = filter.size();
+        }
+        size_t first = begin;
+        size_t last = end;
+        while (first < last && filter[first] == ' ') {
+            ++first;
+        }
+        while (last > first && filter[last - 1] == ' ') {
+            --last;
+        }
+        if (last > first) {
+            filters->push_back(filter.substr(first, last - first));
+        }
+        begin = end + 1;
+    }
+    const TracedSiteFilters* published = nullptr;
+    if (!filters->empty()) {
+        published = filters.get();
+        g_traced_site_filter_sets.push_back(std::move(filters));
+    }
+    g_traced_site_filters.store(published);
+    // Entries whose key is not stored yet match the new filter in AllocateEntryIndex
+    const uint64_t used = g_used_entries.load();
+    const size_t limit = (std::min)(static_cast<uint64_t>(MAX_ENTRIES), used);
+    for (size_t i = 0; i < limit; ++i) {
+        g_entries[i].traced.store(MatchesTracedSites(published, g_entries[i].key.load()));
+    }
+}
+
 void RecordCallNoGuard(uint32_t entry_index, uint64_t timestamp_ns) {
     if (entry_index >= MAX_ENTRIES) {
         return;
@@ -71,10 +144,17 @@ DetourCallGuard::DetourCallGuard(uint32_t entry_index, uint64_t timestamp_ns)
     entry_->total_cnt.fetch_add(1, std::memory_order_relaxed);
     uint64_t prev = entry_->last_call_ns.exchange(timestamp_ns, std::memory_order_relaxed);
     entry_->prev_call_ns.store(prev, std::memory_order_relaxed);
+    if (entry_->traced.load(std::memory_order_relaxed)) {
+        trace_start_ns_ = utils::get_now_ns();
+    }
 }
 
 DetourCallGuard::~DetourCallGuard() {
     if (entry_ != nullptr) {
+        if (trace_start_ns_ != 0) {
+            display_commander::feature::trace::TraceSpan("detour", entry_->key.load(std::memory_order_acquire),
+                                                         trace_start_ns_, utils::get_now_ns());
+        }
         entry_->inprogress_cnt.fetch_sub(1, std::memory_order_release);
     }
 }
@@ -97,7 +177,8 @@ std::string FormatUndestroyedGuards(uint64_t crash_timestamp_ns) {
         if (e.inprogress_cnt.load(std::memory_order_acquire) == 0) {
             continue;
         }
-        list.push_back({e.key, e.context, e.last_call_ns.load(std::memory_order_acquire),
+        list.push_back({e.key.load(std::memory_order_acquire), e.context,
+                        e.last_call_ns.load(std::memory_order_acquire),
                         e.prev_call_ns.load(std::memory_order_acquire)});
     }
 
@@ -161,7 +242,7 @@ std::string FormatDetourCallsByTime(uint64_t crash_timestamp_ns, size_t max_coun
     for (size_t i = 0; i < n; ++i) {
         const IndexAndTime& it = by_time[i];
         Entry& e = g_entries[it.index];
-        const char* key = e.key;
+        const char* key = e.key.load(std::memory_order_acquire);
         uint64_t last_ns = it.last_call_ns;
         int64_t time_diff_ns = static_cast<int64_t>(crash_timestamp_ns) - static_cast<int64_t>(last_ns);
         double time_diff_ms = static_cast<double>(time_diff_ns) / 1000000.0;
@@ -229,7 +310,7 @@ std::string FormatAllLatestCalls(uint64_t now_ns) {
     for (size_t i = 0; i < by_time.size(); ++i) {
         const IndexAndTime& it = by_time[i];
         Entry& e = g_entries[it.index];
-        const char* key = e.key;
+        const char* key = e.key.load(std::memory_order_acquire);
         uint64_t last_ns = it.last_call_ns;
         int64_t ago_ns = static_cast<int64_t>(now_ns) - static_cast<int64_t>(last_ns);
         double ago_ms = static_cast<double>(ago_ns) / 1000000.0;
@@ -15,11 +15,12 @@ constexpr size_t CONTEXT_SIZE = 96;
 
 // One entry per call site. Index is assigned once via AllocateEntryIndex (static in macro).
 struct Entry {
-    const char* key{nullptr};
+    std::atomic<const char*> key{nullptr};  // Stored last by AllocateEntryIndex; readers load with acquire
     std::atomic<uint64_t> inprogress_cnt{0};
     std::atomic<uint64_t> total_cnt{0};
     std::atomic<uint64_t> last_call_ns{0};
     std::atomic<uint64_t> prev_call_ns{0};  // second-to-last call; interval = last_call_ns - prev_call_ns
+    std::atomic<bool> traced{false};        // Selected for trace export (SetTracedSites)
     char context[CONTEXT_SIZE]{};
 };
 
@@ -35,6 +36,10 @@ void RecordCallNoGuard(uint32_t entry_index, uint64_t timestamp_ns);
 // crash report. Thread-safe. Use DETOUR_SET_CONTEXT_AT(line, fmt, ...) with the line number of CALL_GUARD.
 void SetCallSiteContextByKey(const char* key, const char* fmt, ...);
 
+// Trace export (feature/trace): call sites whose key contains one of the comma-separated substrings in filter
+// (e.g. "Present,SetLatencyMarker") record a span per call. Also applies to sites first hit later. Empty = none.
+void SetTracedSites(const std::string& filter);
+
 // RAII guard: on construction increments entry's inprogress_cnt, total_cnt, sets last_call_ns;
 // on destruction decrements inprogress_cnt. If destructor never runs (crash), inprogress_cnt stays > 0.
 class DetourCallGuard {
@@ -50,6 +55,7 @@ class DetourCallGuard {
    private:
     uint32_t entry_index_;
     Entry* entry_{nullptr};
+    int64_t trace_start_ns_{0};  // Non-zero when this call is traced
 };
 
 // --- Crash reporting: iterate entries 0 .. used_entries-1 ---
@@ -3,6 +3,8 @@
 #include "log_path_privacy.hpp"
 #include "srwlock_wrapper.hpp"
 #include "timing.hpp"
+#include "../feature/hitch/hitch.hpp"
+#include "../feature/trace/trace.hpp"
 #include "../globals.hpp"
 
 #include <cstdarg>
@@ -101,6 +103,7 @@ void DisplayCommanderLogger::Log(LogLevel level, const std::string& message) {
         queue_.push_back(std::move(formatted_message));
         WakeConditionVariable(&queue_cv_);
     }
+    display_commander::feature::hitch::RecordHitchLogLine(utils::get_now_ns());
 }
 
 void DisplayCommanderLogger::LogDebug(const std::string& message) { Log(LogLevel::Debug, message); }
@@ -164,7 +167,14 @@ void DisplayCommanderLogger::WriterLoop() {
 
         if (msg == kFlushSentinel) {
             if (log_file_.is_open()) {
+                const bool tracing = display_commander::feature::trace::IsTracing();
+                const LONGLONG flush_start_ns = tracing ? utils::get_now_ns() : 0;
                 log_file_.flush();
+                if (tracing) {
+                    display_commander::feature::trace::SetTraceThreadName("Logger");
+                    display_commander::feature::trace::TraceSpan("logger", "Log flush", flush_start_ns,
+                                                                 utils::get_now_ns());
+                }
             }
         } else {
             WriteToFile(msg);
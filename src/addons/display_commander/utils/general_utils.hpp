@@ -3,6 +3,7 @@
 #include "../settings/main_tab_settings.hpp"
 #include "../globals.hpp"
 #include "logging.hpp"
+#include "stick_mapping.hpp"
 
 #define ImTextureID ImU64
 #define WIN32_LEAN_AND_MEAN
@@ -36,19 +37,6 @@ RECT RectFromWH(int width, int height);
 AspectRatio GetAspectByIndex(int index);
 int GetAspectWidthValue(int display_width);
 
-// XInput processing functions
-// Map one signed axis: input [min_input, max_input] -> output [min_output, max_output] (0-1 ranges)
-float MapStickAxisValue(float value, float min_input, float max_input, float min_output, float max_output);
-// Radial: one mapping applied to magnitude
-void ProcessStickInputRadial(float& x, float& y, float min_input, float max_input, float min_output, float max_output);
-// Square: separate mapping per axis
-void ProcessStickInputSquare(float& x, float& y, float min_in_x, float max_in_x, float min_out_x, float max_out_x,
-                             float min_in_y, float max_in_y, float min_out_y, float max_out_y);
-
-// XInput thumbstick scaling helpers (handles asymmetric SHORT range: -32768 to 32767)
-float ShortToFloat(SHORT value);
-SHORT FloatToShort(float value);
-
 // DLL version information
 std::string GetDLLVersionString(const std::wstring& dllPath);
 // ProductName from version resource (UTF-8), empty if absent or on error
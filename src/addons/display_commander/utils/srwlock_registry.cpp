@@ -25,6 +25,10 @@ SRWLOCK g_dinput_device_hooks_mutex = SRWLOCK_INIT;
 SRWLOCK g_wndproc_map_lock = SRWLOCK_INIT;
 SRWLOCK g_continuous_monitoring_loop_lock = SRWLOCK_INIT;
 SRWLOCK g_proxy_getproc_logged_srwlock = SRWLOCK_INIT;
+SRWLOCK g_gpu_completion_trackers_lock = SRWLOCK_INIT;
+SRWLOCK g_foreground_tracker_lock = SRWLOCK_INIT;
+SRWLOCK g_display_cache_refresh_lock = SRWLOCK_INIT;
+SRWLOCK g_xinput_pipeline_lock = SRWLOCK_INIT;
 
 namespace {
 
@@ -53,6 +57,10 @@ void LogAllSrwlockStatus() {
     LogOne("wndproc_map", TryIsSRWLockHeld(g_wndproc_map_lock));
     LogOne("continuous_monitoring_loop", TryIsSRWLockHeld(g_continuous_monitoring_loop_lock));
     LogOne("proxy_getproc_logged", TryIsSRWLockHeld(g_proxy_getproc_logged_srwlock));
+    LogOne("gpu_completion_trackers", TryIsSRWLockHeld(g_gpu_completion_trackers_lock));
+    LogOne("foreground_tracker", TryIsSRWLockHeld(g_foreground_tracker_lock));
+    LogOne("display_cache_refresh", TryIsSRWLockHeld(g_display_cache_refresh_lock));
+    LogOne("xinput_pipeline", TryIsSRWLockHeld(g_xinput_pipeline_lock));
 }
 
 }  // namespace utils
@@ -27,6 +27,10 @@ extern SRWLOCK g_dinput_device_hooks_mutex;
 extern SRWLOCK g_wndproc_map_lock;
 extern SRWLOCK g_continuous_monitoring_loop_lock;  // held shared while CM loop body runs; FreeLibrary waits exclusive
 extern SRWLOCK g_proxy_getproc_logged_srwlock;  // GetProcAddress detour: set of logged proc names (our proxy, found)
+extern SRWLOCK g_gpu_completion_trackers_lock;  // per-swapchain GPU completion fence rings (dxgi_gpu_completion.cpp)
+extern SRWLOCK g_foreground_tracker_lock;  // foreground/background state machine (feature/foreground)
+extern SRWLOCK g_display_cache_refresh_lock;  // serializes DisplayCache::Refresh (readers use the published snapshot)
+extern SRWLOCK g_xinput_pipeline_lock;  // published compiled XInput transform chain (modules/controller/xinput_pipeline)
 
 // Logs status of registry locks above plus logger queue_lock and swapchain_tracking
 // to the addon log. HELD = lock is in use; free = not held. Call from stuck-detection.
@@ -0,0 +1,68 @@
+// Source Code <Display Commander> // Stick response mapping (platform-neutral, no Windows includes)
+#include "stick_mapping.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+
+// Map one signed axis: input [min_input, max_input] -> output [min_output, max_output]; below min_input -> 0
+float MapStickAxisValue(float value, float min_input, float max_input, float min_output, float max_output) {
+    float abs_val = std::abs(value);
+    float sign_val = (value >= 0.0f) ? 1.0f : -1.0f;
+    if (abs_val <= min_input) return 0.0f;
+    if (max_input <= min_input) return 0.0f;  // avoid div by zero
+    if (abs_val >= max_input) return sign_val * max_output;
+    float t = (abs_val - min_input) / (max_input - min_input);
+    return sign_val * (min_output + t * (max_output - min_output));
+}
+
+// Process stick input with radial mapping (one mapping applied to magnitude)
+void ProcessStickInputRadial(float& x, float& y, float min_input, float max_input, float min_output, float max_output) {
+    float magnitude = std::sqrt(x * x + y * y);
+    if (magnitude < 0.0001f) {
+        x = 0.0f;
+        y = 0.0f;
+        return;
+    }
+    // Map magnitude [min_input, max_input] -> [min_output, max_output]
+    float out_mag;
+    if (magnitude <= min_input) {
+        out_mag = 0.0f;
+    } else if (max_input <= min_input) {
+        out_mag = 0.0f;
+    } else if (magnitude >= max_input) {
+        out_mag = max_output;
+    } else {
+        float t = (magnitude - min_input) / (max_input - min_input);
+        out_mag = min_output + t * (max_output - min_output);
+    }
+    out_mag = std::clamp(out_mag, 0.0f, 1.0f);
+    float scale = out_mag / magnitude;
+    x = x * scale;
+    y = y * scale;
+}
+
+// Process stick input with square mapping (separate min/max input and min/max output per axis)
+void ProcessStickInputSquare(float& x, float& y, float min_in_x, float max_in_x, float min_out_x, float max_out_x,
+                             float min_in_y, float max_in_y, float min_out_y, float max_out_y) {
+    x = MapStickAxisValue(x, min_in_x, max_in_x, min_out_x, max_out_x);
+    y = MapStickAxisValue(y, min_in_y, max_in_y, min_out_y, max_out_y);
+}
+
+// XInput thumbstick scaling helpers (handles asymmetric SHORT range: -32768 to 32767)
+float ShortToFloat(int16_t value) {
+    // Proper linear mapping from [-32768, 32767] to [-1.0f, 1.0f]
+    // Using the full range: 32767 - (-32768) = 65535
+    // Center point: (32767 + (-32768)) / 2 = -0.5
+    // So we map: (value - (-32768)) / 65535 * 2.0f - 1.0f
+    return (static_cast<float>(value) - (-32768.0f)) / 65535.0f * 2.0f - 1.0f;
+}
+
+int16_t FloatToShort(float value) {
+    // Clamp to valid range
+    value = std::clamp(value, -1.0f, 1.0f);
+
+    // Inverse mapping from [-1.0f, 1.0f] to [-32768, 32767]
+    // (value + 1.0f) / 2.0f * 65535.0f + (-32768.0f)
+    return static_cast<int16_t>((value + 1.0f) / 2.0f * 65535.0f + (-32768.0f));
+}
@@ -0,0 +1,18 @@
+// Source Code <Display Commander> // Stick response mapping (platform-neutral, no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+// XInput processing functions
+// Map one signed axis: input [min_input, max_input] -> output [min_output, max_output] (0-1 ranges)
+float MapStickAxisValue(float value, float min_input, float max_input, float min_output, float max_output);
+// Radial: one mapping applied to magnitude
+void ProcessStickInputRadial(float& x, float& y, float min_input, float max_input, float min_output, float max_output);
+// Square: separate mapping per axis
+void ProcessStickInputSquare(float& x, float& y, float min_in_x, float max_in_x, float min_out_x, float max_out_x,
+                             float min_in_y, float max_in_y, float min_out_y, float max_out_y);
+
+// XInput thumbstick scaling helpers (handles asymmetric SHORT range: -32768 to 32767)
+float ShortToFloat(int16_t value);
+int16_t FloatToShort(float value);
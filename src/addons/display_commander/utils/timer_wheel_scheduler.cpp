@@ -0,0 +1,356 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#include "timer_wheel_scheduler.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <utility>
+
+namespace utils {
+
+struct TimerWheelScheduler::Task {
+    const char* name = nullptr;
+    TaskFn fn;
+    int64_t period_ns = 0;
+    int64_t deadline_ns = 0;
+    uint64_t deadline_tick = 0;
+    int level = -1;  // -1 = not in wheel, kLevels = overflow list
+    bool active = false;
+    uint32_t generation = 0;  // Bumped by Cancel/Reschedule/SetPeriod (detects re-arm from inside the task)
+    std::atomic<bool> triggered{false};
+
+    std::atomic<uint64_t> runs{0};
+    std::atomic<uint64_t> triggered_runs{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<int64_t> last_duration_ns{0};
+    std::atomic<int64_t> max_duration_ns{0};
+    std::atomic<int64_t> total_duration_ns{0};
+    std::atomic<int64_t> max_start_delay_ns{0};
+};
+
+TimerWheelScheduler::TimerWheelScheduler(int64_t epoch_ns, ClockFn clock) : epoch_ns_(epoch_ns), clock_(clock) {}
+
+TimerWheelScheduler::~TimerWheelScheduler() = default;
+
+uint64_t TimerWheelScheduler::TickForNs(int64_t ns) const {
+    if (ns <= epoch_ns_) {
+        return 0;
+    }
+    return static_cast<uint64_t>((ns - epoch_ns_ + kTickNs - 1) / kTickNs);
+}
+
+TimerWheelScheduler::TaskId TimerWheelScheduler::AddTask(const char* name, int64_t period_ns,
+                                                         int64_t first_deadline_ns, bool armed, TaskFn fn) {
+    auto task = std::make_unique<Task>();
+    task->name = name;
+    task->fn = std::move(fn);
+    task->period_ns = period_ns;
+    task->active = true;
+    const TaskId id = static_cast<TaskId>(tasks_.size());
+    tasks_.push_back(std::move(task));
+    if (armed) {
+        Reschedule(id, first_deadline_ns);
+    }
+    return id;
+}
+
+TimerWheelScheduler::TaskId TimerWheelScheduler::AddPeriodic(const char* name, int64_t period_ns, TaskFn fn,
+                                                             int64_t first_delay_ns) {
+    if (period_ns <= 0) {
+        return kInvalidTask;
+    }
+    const int64_t delay = first_delay_ns >= 0 ? first_delay_ns : period_ns;
+    return AddTask(name, period_ns, epoch_ns_ + delay, true, std::move(fn));
+}
+
+TimerWheelScheduler::TaskId TimerWheelScheduler::AddOneShot(const char* name, int64_t delay_ns, TaskFn fn) {
+    return AddTask(name, 0, epoch_ns_ + (std::max)(delay_ns, int64_t{0}), true, std::move(fn));
+}
+
+TimerWheelScheduler::TaskId TimerWheelScheduler::AddEventTask(const char* name, TaskFn fn) {
+    return AddTask(name, 0, 0, false, std::move(fn));
+}
+
+void TimerWheelScheduler::Trigger(TaskId id) {
+    if (id >= tasks_.size()) {
+        return;
+    }
+    tasks_[id]->triggered.store(true, std::memory_order_release);
+    any_triggered_.store(true, std::memory_order_release);
+    if (wake_) {
+        wake_();
+    }
+}
+
+void TimerWheelScheduler::Cancel(TaskId id) {
+    if (id >= tasks_.size()) {
+        return;
+    }
+    Unlink(id);
+    Task& t = *tasks_[id];
+    t.active = false;
+    t.generation++;
+}
+
+void TimerWheelScheduler::Reschedule(TaskId id, int64_t deadline_ns) {
+    if (id >= tasks_.size()) {
+        return;
+    }
+    Unlink(id);
+    Task& t = *tasks_[id];
+    t.active = true;
+    t.generation++;
+    t.deadline_ns = deadline_ns;
+    t.deadline_tick = TickForNs(deadline_ns);
+    Insert(id);
+}
+
+void TimerWheelScheduler::SetPeriod(TaskId id, int64_t period_ns, int64_t now_ns) {
+    if (id >= tasks_.size() || period_ns <= 0) {
+        return;
+    }
+    tasks_[id]->period_ns = period_ns;
+    Reschedule(id, now_ns + period_ns);
+}
+
+void TimerWheelScheduler::Insert(TaskId id) {
+    Task& t = *tasks_[id];
+    if (t.deadline_tick < current_tick_) {
+        t.deadline_tick = current_tick_;
+    }
+    const uint64_t dt = t.deadline_tick;
+    int level = kLevels;
+    for (int l = 0; l < kLevels; ++l) {
+        const int shift = kBits * (l + 1);
+        if ((dt >> shift) == (current_tick_ >> shift)) {
+            level = l;
+            break;
+        }
+    }
+    t.level = level;
+    if (level == kLevels) {
+        overflow_.push_back(id);
+        return;
+    }
+    wheel_[level][(dt >> (kBits * level)) & kMask].push_back(id);
+    level_count_[level]++;
+}
+
+void TimerWheelScheduler::Unlink(TaskId id) {
+    Task& t = *tasks_[id];
+    if (t.level < 0) {
+        return;
+    }
+    std::vector<TaskId>& v =
+        (t.level == kLevels) ? overflow_ : wheel_[t.level][(t.deadline_tick >> (kBits * t.level)) & kMask];
+    auto it = std::find(v.begin(), v.end(), id);
+    if (it != v.end()) {
+        *it = v.back();
+        v.pop_back();
+        if (t.level < kLevels) {
+            level_count_[t.level]--;
+        }
+    }
+    t.level = -1;
+}
+
+void TimerWheelScheduler::Cascade(int level) {
+    std::vector<TaskId> moved;
+    if (level == kLevels) {
+        moved.swap(overflow_);
+    } else {
+        moved.swap(wheel_[level][(current_tick_ >> (kBits * level)) & kMask]);
+        level_count_[level] -= moved.size();
+    }
+    for (TaskId id : moved) {
+        tasks_[id]->level = -1;
+        Insert(id);
+    }
+}
+
+void TimerWheelScheduler::CollectSlot(uint64_t tick, std::vector<TaskId>& due) {
+    std::vector<TaskId>& slot = wheel_[0][tick & kMask];
+    for (size_t i = 0; i < slot.size();) {
+        const TaskId id = slot[i];
+        if (tasks_[id]->deadline_tick <= tick) {
+            due.push_back(id);
+            slot[i] = slot.back();
+            slot.pop_back();
+            level_count_[0]--;
+            tasks_[id]->level = -1;
+        } else {
+            ++i;
+        }
+    }
+}
+
+size_t TimerWheelScheduler::RunDue(int64_t now_ns) {
+    // Ticks that have fully elapsed (floor): a task at tick T runs once now_ns >= epoch + T * kTickNs.
+    const uint64_t now_tick = now_ns <= epoch_ns_ ? 0 : static_cast<uint64_t>((now_ns - epoch_ns_) / kTickNs);
+    std::vector<TaskId>& due = due_scratch_;
+    due.clear();
+
+    CollectSlot(current_tick_, due);
+    while (current_tick_ < now_tick) {
+        // Skip empty stretches instead of stepping every 1 ms tick across long sleeps.
+        if (level_count_[0] == 0) {
+            uint64_t skip_to = current_tick_ | kMask;
+            if (level_count_[1] == 0) {
+                skip_to = current_tick_ | ((uint64_t{1} << (2 * kBits)) - 1);
+                if (level_count_[2] == 0) {
+                    skip_to = overflow_.empty() ? now_tick : (current_tick_ | ((uint64_t{1} << (3 * kBits)) - 1));
+                }
+            }
+            if (skip_to >= now_tick) {
+                current_tick_ = now_tick;
+                break;
+            }
+            current_tick_ = skip_to;
+        }
+        ++current_tick_;
+        if ((current_tick_ & kMask) == 0) {
+            if ((current_tick_ & ((uint64_t{1} << (2 * kBits)) - 1)) == 0) {
+                if ((current_tick_ & ((uint64_t{1} << (3 * kBits)) - 1)) == 0) {
+                    Cascade(kLevels);
+                }
+                Cascade(2);
+            }
+            Cascade(1);
+        }
+        CollectSlot(current_tick_, due);
+    }
+
+    std::sort(due.begin(), due.end(),
+              [this](TaskId a, TaskId b) { return tasks_[a]->deadline_ns < tasks_[b]->deadline_ns; });
+
+    size_t ran = 0;
+    for (TaskId id : due) {
+        Task& t = *tasks_[id];
+        if (!t.active) {
+            continue;
+        }
+        // A scheduled run also satisfies a pending trigger.
+        t.triggered.store(false, std::memory_order_relaxed);
+        RunTask(id, now_ns, false);
+        ++ran;
+    }
+
+    if (any_triggered_.exchange(false, std::memory_order_acq_rel)) {
+        for (TaskId id = 0; id < tasks_.size(); ++id) {
+            Task& t = *tasks_[id];
+            if (t.triggered.exchange(false, std::memory_order_acq_rel) && t.active) {
+                RunTask(id, now_ns, true);
+                ++ran;
+            }
+        }
+    }
+    return ran;
+}
+
+void TimerWheelScheduler::RunTask(TaskId id, int64_t now_ns, bool triggered) {
+    Task& t = *tasks_[id];
+    const uint32_t generation = t.generation;
+    const int64_t scheduled_ns = t.deadline_ns;
+
+    const int64_t start_ns = clock_ != nullptr ? clock_() : now_ns;
+    t.fn();
+    const int64_t end_ns = clock_ != nullptr ? clock_() : now_ns;
+    const int64_t duration_ns = end_ns - start_ns;
+    if (observer_ != nullptr) {
+        observer_(t.name, start_ns, end_ns);
+    }
+
+    t.runs.fetch_add(1, std::memory_order_relaxed);
+    t.last_duration_ns.store(duration_ns, std::memory_order_relaxed);
+    t.total_duration_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+    if (duration_ns > t.max_duration_ns.load(std::memory_order_relaxed)) {
+        t.max_duration_ns.store(duration_ns, std::memory_order_relaxed);
+    }
+    if (triggered) {
+        t.triggered_runs.fetch_add(1, std::memory_order_relaxed);
+        return;  // Event run: scheduled deadline (if any) is unchanged
+    }
+
+    const int64_t start_delay_ns = now_ns - scheduled_ns;
+    if (start_delay_ns > t.max_start_delay_ns.load(std::memory_order_relaxed)) {
+        t.max_start_delay_ns.store(start_delay_ns, std::memory_order_relaxed);
+    }
+
+    if (t.generation != generation) {
+        return;  // Task cancelled or re-armed itself
+    }
+    if (t.period_ns <= 0) {
+        t.active = false;  // One-shot done
+        return;
+    }
+    bool overrun = duration_ns > t.period_ns;
+    int64_t next_ns = scheduled_ns + t.period_ns;
+    if (next_ns <= now_ns) {
+        // Missed at least one period: do not burst-run to catch up.
+        overrun = true;
+        next_ns = now_ns + t.period_ns;
+    }
+    if (overrun) {
+        t.overruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    t.deadline_ns = next_ns;
+    t.deadline_tick = TickForNs(next_ns);
+    Insert(id);
+}
+
+int64_t TimerWheelScheduler::NextDeadlineNs() const {
+    if (any_triggered_.load(std::memory_order_acquire)) {
+        return 0;
+    }
+    auto min_tick_in = [this](const std::vector<TaskId>& v) {
+        uint64_t best = UINT64_MAX;
+        for (TaskId id : v) {
+            best = (std::min)(best, tasks_[id]->deadline_tick);
+        }
+        return best;
+    };
+    uint64_t tick = UINT64_MAX;
+    for (int level = 0; level < kLevels && tick == UINT64_MAX; ++level) {
+        if (level_count_[level] == 0) {
+            continue;
+        }
+        // Level 0 includes the current tick; higher levels only hold later blocks (current slot already cascaded).
+        const uint64_t first = ((current_tick_ >> (kBits * level)) & kMask) + (level == 0 ? 0 : 1);
+        for (uint64_t s = first; s < static_cast<uint64_t>(kSlots); ++s) {
+            if (!wheel_[level][s].empty()) {
+                tick = min_tick_in(wheel_[level][s]);
+                break;
+            }
+        }
+    }
+    if (tick == UINT64_MAX && !overflow_.empty()) {
+        tick = min_tick_in(overflow_);
+    }
+    if (tick == UINT64_MAX) {
+        return kNoDeadline;
+    }
+    return epoch_ns_ + static_cast<int64_t>(tick) * kTickNs;
+}
+
+std::vector<TimerWheelScheduler::TaskStats> TimerWheelScheduler::GetStats() const {
+    std::vector<TaskStats> out;
+    out.reserve(tasks_.size());
+    for (const auto& p : tasks_) {
+        const Task& t = *p;
+        TaskStats s;
+        s.name = t.name;
+        s.period_ns = t.period_ns;
+        s.runs = t.runs.load(std::memory_order_relaxed);
+        s.triggered_runs = t.triggered_runs.load(std::memory_order_relaxed);
+        s.overruns = t.overruns.load(std::memory_order_relaxed);
+        s.last_duration_ns = t.last_duration_ns.load(std::memory_order_relaxed);
+        s.max_duration_ns = t.max_duration_ns.load(std::memory_order_relaxed);
+        s.avg_duration_ns =
+            s.runs > 0 ? t.total_duration_ns.load(std::memory_order_relaxed) / static_cast<int64_t>(s.runs) : 0;
+        s.max_start_delay_ns = t.max_start_delay_ns.load(std::memory_order_relaxed);
+        s.active = t.active;
+        out.push_back(s);
+    }
+    return out;
+}
+
+}  // namespace utils
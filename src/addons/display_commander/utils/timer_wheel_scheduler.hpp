@@ -0,0 +1,122 @@
+// Source Code <Display Commander> // follow this order for includes in all files + add this comment at the top
+#pragma once
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace utils {
+
+// Hierarchical timer wheel for background worker threads (continuous monitoring).
+// Three levels of 64 slots with 1 ms ticks (64 ms / 4.1 s / 262 s) plus an overflow list. Tasks are periodic,
+// one-shot or event-only; Trigger() makes a task due immediately from any thread and wakes the owner.
+// Time is passed in explicitly (ns) so the scheduler can run on a virtual clock. Platform-neutral.
+//
+// Threading: AddPeriodic/AddOneShot/AddEventTask before the owning thread starts calling RunDue.
+// RunDue/NextDeadlineNs/Cancel/Reschedule/GetStats are owner-thread only; Trigger and GetWakeupCount are
+// thread-safe. Other threads read stats from a snapshot the owner publishes (see continuous_monitoring).
+class TimerWheelScheduler {
+   public:
+    using TaskId = uint32_t;
+    using TaskFn = std::function<void()>;
+    using ClockFn = int64_t (*)();
+    // Called after every task run with the name and clock times around it (e.g. trace export).
+    using TaskObserverFn = void (*)(const char* name, int64_t start_ns, int64_t end_ns);
+
+    static constexpr TaskId kInvalidTask = 0xFFFFFFFFu;
+    static constexpr int64_t kTickNs = 1000000;  // 1 ms
+    static constexpr int64_t kNoDeadline = INT64_MAX;
+
+    struct TaskStats {
+        const char* name = nullptr;
+        int64_t period_ns = 0;  // 0 for one-shot / event-only
+        uint64_t runs = 0;
+        uint64_t triggered_runs = 0;  // Runs caused by Trigger()
+        uint64_t overruns = 0;        // Ran longer than its period, or started more than one period late
+        int64_t last_duration_ns = 0;
+        int64_t max_duration_ns = 0;
+        int64_t avg_duration_ns = 0;
+        int64_t max_start_delay_ns = 0;  // Worst lateness vs. scheduled deadline (jitter)
+        bool active = false;
+    };
+
+    // clock measures task durations; now_ns passed to RunDue drives scheduling. epoch_ns = time of tick 0.
+    TimerWheelScheduler(int64_t epoch_ns, ClockFn clock);
+    ~TimerWheelScheduler();
+
+    TimerWheelScheduler(const TimerWheelScheduler&) = delete;
+    TimerWheelScheduler& operator=(const TimerWheelScheduler&) = delete;
+
+    // Called from Trigger() (any thread) so the owner can stop waiting, e.g. SetEvent.
+    void SetWakeCallback(std::function<void()> wake) { wake_ = std::move(wake); }
+
+    // Before the owning thread starts calling RunDue.
+    void SetTaskObserver(TaskObserverFn observer) { observer_ = observer; }
+
+    // Periodic task, first run at epoch + first_delay_ns (defaults to one period).
+    TaskId AddPeriodic(const char* name, int64_t period_ns, TaskFn fn, int64_t first_delay_ns = -1);
+    // One-shot task at epoch + delay_ns; becomes inactive after it runs (Reschedule to re-arm).
+    TaskId AddOneShot(const char* name, int64_t delay_ns, TaskFn fn);
+    // Task that only runs when Trigger()ed.
+    TaskId AddEventTask(const char* name, TaskFn fn);
+
+    // Any thread: run task on the next RunDue pass and wake the owner.
+    void Trigger(TaskId id);
+
+    // Owner thread: stop a task (stays registered for stats).
+    void Cancel(TaskId id);
+    // Owner thread: (re)arm task to run at absolute time deadline_ns; period unchanged.
+    void Reschedule(TaskId id, int64_t deadline_ns);
+    // Owner thread: change period of a periodic task; next run at now_ns + period_ns.
+    void SetPeriod(TaskId id, int64_t period_ns, int64_t now_ns);
+
+    // Owner thread: advance the wheel to now_ns and run all due / triggered tasks in deadline order.
+    // Returns number of tasks run.
+    size_t RunDue(int64_t now_ns);
+
+    // Owner thread: absolute time of the earliest scheduled task (kNoDeadline when none), 0 if a trigger is pending.
+    int64_t NextDeadlineNs() const;
+
+    // Owner-thread bookkeeping: count a wake-up of the owning thread (for wakeups/s diagnostics).
+    void NoteWakeup() { wakeups_.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t GetWakeupCount() const { return wakeups_.load(std::memory_order_relaxed); }
+
+    // Owner thread (e.g. from a task): snapshot of per-task runtime accounting. Reads the non-atomic active and
+    // period fields that Cancel/Reschedule/RunDue write, so it must not race with them.
+    std::vector<TaskStats> GetStats() const;
+
+   private:
+    static constexpr int kBits = 6;
+    static constexpr int kSlots = 1 << kBits;
+    static constexpr uint64_t kMask = kSlots - 1;
+    static constexpr int kLevels = 3;
+
+    struct Task;
+
+    uint64_t TickForNs(int64_t ns) const;  // Rounds up (never run early)
+    void Insert(TaskId id);
+    void Unlink(TaskId id);
+    void Cascade(int level);
+    void CollectSlot(uint64_t tick, std::vector<TaskId>& due);
+    TaskId AddTask(const char* name, int64_t period_ns, int64_t first_deadline_ns, bool armed, TaskFn fn);
+    void RunTask(TaskId id, int64_t now_ns, bool triggered);
+
+    int64_t epoch_ns_ = 0;
+    ClockFn clock_ = nullptr;
+    TaskObserverFn observer_ = nullptr;
+    uint64_t current_tick_ = 0;
+    std::vector<std::unique_ptr<Task>> tasks_;
+    std::vector<TaskId> wheel_[kLevels][kSlots];
+    std::vector<TaskId> overflow_;
+    size_t level_count_[kLevels] = {};
+    std::atomic<bool> any_triggered_{false};
+    std::atomic<uint64_t> wakeups_{0};
+    std::function<void()> wake_;
+    std::vector<TaskId> due_scratch_;
+};
+
+}  // namespace utils
@@ -0,0 +1,214 @@
+// Source Code <Display Commander> // Audio session cache tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "modules/audio/backend/audio_session_cache.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kMs = 1000000;
+
+struct FakeSession final : AudioSessionHandle {
+    explicit FakeSession(int id, std::atomic<int>& alive) : id(id), alive(alive) { alive.fetch_add(1); }
+    ~FakeSession() override { alive.fetch_sub(1); }
+    int id;
+    std::atomic<int>& alive;
+};
+
+// Scripted WASAPI: the process has `session_count` sessions (0 = game has not opened audio yet).
+class FakeSessionSource final : public IAudioSessionSource {
+   public:
+    std::shared_ptr<AudioSessionHandle> OpenProcessSession() override {
+        opens.fetch_add(1);
+        if (on_open) {
+            on_open();
+        }
+        if (session_count.load() == 0) {
+            return nullptr;
+        }
+        return std::make_shared<FakeSession>(next_id.fetch_add(1), alive);
+    }
+
+    std::atomic<int> session_count{0};
+    std::atomic<int> opens{0};
+    std::atomic<int> next_id{1};
+    std::atomic<int> alive{0};
+    void (*on_open)() = nullptr;
+};
+
+int SessionId(const std::shared_ptr<AudioSessionHandle>& handle) {
+    return handle != nullptr ? static_cast<const FakeSession&>(*handle).id : 0;
+}
+
+DC_TEST(SessionIsOpenedOnceAndServedFromCache) {
+    FakeSessionSource source;
+    source.session_count = 1;
+    AudioSessionCache cache(source);
+    const int first = SessionId(cache.Acquire(0));
+    CHECK(first != 0);
+    for (int i = 1; i < 100; ++i) {
+        CHECK_EQ(SessionId(cache.Acquire(i * kMs)), first);
+    }
+    CHECK_EQ(source.opens.load(), 1);
+    const AudioSessionCacheStats stats = cache.GetStats();
+    CHECK_EQ(stats.opens, 1u);
+    CHECK_EQ(stats.hits, 99u);
+    CHECK(stats.has_session);
+}
+
+DC_TEST(MissIsRememberedUntilRetryInterval) {
+    FakeSessionSource source;
+    AudioSessionCache cache(source, 500 * kMs);
+    CHECK(cache.Acquire(0) == nullptr);
+    CHECK(cache.Acquire(100 * kMs) == nullptr);
+    CHECK(cache.Acquire(499 * kMs) == nullptr);
+    CHECK_EQ(source.opens.load(), 1);
+    source.session_count = 1;  // Game opened audio without a notification reaching us
+    CHECK(cache.Acquire(500 * kMs) != nullptr);
+    CHECK_EQ(source.opens.load(), 2);
+    const AudioSessionCacheStats stats = cache.GetStats();
+    CHECK_EQ(stats.open_misses, 1u);
+    CHECK_EQ(stats.hits, 2u);
+}
+
+DC_TEST(OwnSessionCreatedDropsCachedSession) {
+    FakeSessionSource source;
+    source.session_count = 1;
+    AudioSessionCache cache(source);
+    const int first = SessionId(cache.Acquire(0));
+    // The game opens a second stream: the cached set misses it
+    source.session_count = 2;
+    cache.Invalidate(AudioSessionInvalidation::kSessionCreated);
+    const int second = SessionId(cache.Acquire(1 * kMs));
+    CHECK(second != first);
+    CHECK_EQ(source.opens.load(), 2);
+    CHECK_EQ(source.alive.load(), 1);  // The stale set was released
+    CHECK_EQ(cache.GetStats().invalidations[static_cast<size_t>(AudioSessionInvalidation::kSessionCreated)], 1u);
+}
+
+DC_TEST(OwnSessionCreatedEndsRememberedMiss) {
+    FakeSessionSource source;
+    AudioSessionCache cache(source);
+    CHECK(cache.Acquire(0) == nullptr);
+    source.session_count = 1;
+    cache.Invalidate(AudioSessionInvalidation::kSessionCreated);
+    CHECK(cache.Acquire(1 * kMs) != nullptr);  // Well before the retry interval
+}
+
+DC_TEST(UnknownSessionCreatedOnlyReprobesMiss) {
+    FakeSessionSource source;
+    source.session_count = 1;
+    AudioSessionCache cache(source);
+    const int first = SessionId(cache.Acquire(0));
+    cache.Invalidate(AudioSessionInvalidation::kSessionCreatedUnknown);
+    CHECK_EQ(SessionId(cache.Acquire(1 * kMs)), first);  // Cached session kept
+    CHECK_EQ(source.opens.load(), 1);
+
+    FakeSessionSource empty_source;
+    AudioSessionCache miss_cache(empty_source);
+    CHECK(miss_cache.Acquire(0) == nullptr);
+    empty_source.session_count = 1;
+    miss_cache.Invalidate(AudioSessionInvalidation::kSessionCreatedUnknown);
+    CHECK(miss_cache.Acquire(1 * kMs) != nullptr);
+    CHECK_EQ(empty_source.opens.load(), 2);
+}
+
+DC_TEST(DeviceAndSessionEventsDropCachedSession) {
+    for (const AudioSessionInvalidation reason :
+         {AudioSessionInvalidation::kDefaultDeviceChanged, AudioSessionInvalidation::kDeviceStateChanged,
+          AudioSessionInvalidation::kSessionDisconnected, AudioSessionInvalidation::kSessionExpired,
+          AudioSessionInvalidation::kOutputDeviceOverride, AudioSessionInvalidation::kCallFailed}) {
+        FakeSessionSource source;
+        source.session_count = 1;
+        AudioSessionCache cache(source);
+        const int first = SessionId(cache.Acquire(0));
+        cache.Invalidate(reason);
+        CHECK(SessionId(cache.Acquire(1 * kMs)) != first);
+        CHECK_EQ(source.opens.load(), 2);
+        CHECK_EQ(cache.GetStats().invalidations[static_cast<size_t>(reason)], 1u);
+    }
+}
+
+DC_TEST(SessionLostAfterInvalidationBecomesMiss) {
+    FakeSessionSource source;
+    source.session_count = 1;
+    AudioSessionCache cache(source);
+    CHECK(cache.Acquire(0) != nullptr);
+    source.session_count = 0;
+    cache.Invalidate(AudioSessionInvalidation::kSessionExpired);
+    CHECK(cache.Acquire(1 * kMs) == nullptr);
+    CHECK(!cache.GetStats().has_session);
+    CHECK(cache.Acquire(2 * kMs) == nullptr);
+    CHECK_EQ(source.opens.load(), 2);
+    CHECK_EQ(source.alive.load(), 0);
+}
+
+// Invalidation racing the open (device change while enumerating): the next Acquire must open again.
+FakeSessionSource* g_racing_source = nullptr;
+AudioSessionCache* g_racing_cache = nullptr;
+
+DC_TEST(InvalidationDuringOpenForcesReopen) {
+    FakeSessionSource source;
+    source.session_count = 1;
+    AudioSessionCache cache(source);
+    g_racing_source = &source;
+    g_racing_cache = &cache;
+    source.on_open = [] {
+        g_racing_source->on_open = nullptr;  // Once
+        g_racing_cache->Invalidate(AudioSessionInvalidation::kDefaultDeviceChanged);
+    };
+    const int first = SessionId(cache.Acquire(0));
+    const int second = SessionId(cache.Acquire(1 * kMs));
+    CHECK(first != second);
+    CHECK_EQ(SessionId(cache.Acquire(2 * kMs)), second);
+    CHECK_EQ(source.opens.load(), 2);
+}
+
+DC_TEST(ConcurrentAcquireAndInvalidate) {
+    FakeSessionSource source;
+    source.session_count = 1;
+    AudioSessionCache cache(source);
+    std::atomic<bool> stop{false};
+    std::atomic<int> null_results{0};
+    std::vector<std::thread> users;
+    for (int t = 0; t < 3; ++t) {
+        users.emplace_back([&] {
+            int64_t now = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (cache.Acquire(now++) == nullptr) {
+                    null_results.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        cache.Invalidate(i % 2 == 0 ? AudioSessionInvalidation::kSessionCreated
+                                    : AudioSessionInvalidation::kDefaultDeviceChanged);
+    }
+    stop.store(true);
+    for (auto& user : users) {
+        user.join();
+    }
+    CHECK_EQ(null_results.load(), 0);
+    CHECK(cache.Acquire(INT64_MAX / 2) != nullptr);
+    CHECK_EQ(source.alive.load(), 1);  // Only the cached handle is left
+    const AudioSessionCacheStats stats = cache.GetStats();
+    CHECK_EQ(static_cast<int>(stats.opens), source.opens.load());
+}
+
+DC_TEST(InvalidationNamesAreDistinct) {
+    for (size_t i = 0; i < kAudioSessionInvalidationCount; ++i) {
+        for (size_t j = i + 1; j < kAudioSessionInvalidationCount; ++j) {
+            CHECK(std::string_view(AudioSessionInvalidationName(static_cast<AudioSessionInvalidation>(i)))
+                  != AudioSessionInvalidationName(static_cast<AudioSessionInvalidation>(j)));
+        }
+    }
+}
+
+}  // namespace
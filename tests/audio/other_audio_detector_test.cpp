@@ -0,0 +1,245 @@
+// Source Code <Display Commander> // Other-app audio detector tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "modules/audio/backend/other_audio_detector.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kMs = 1000000;
+constexpr int64_t kTick = 100 * kMs;  // Update interval of the background monitor
+
+// Scripted meters: peak per session key; keys without an entry fail to read.
+struct FakeMeters {
+    std::unordered_map<uint64_t, float> peaks;
+    std::vector<uint64_t> reads;
+
+    OtherAudioDetector::PeakReader Reader() {
+        return [this](uint64_t key, float* peak_out) {
+            reads.push_back(key);
+            const auto it = peaks.find(key);
+            if (it == peaks.end()) {
+                return false;
+            }
+            *peak_out = it->second;
+            return true;
+        };
+    }
+};
+
+// Runs updates every kTick from `from` (inclusive) to `to` (exclusive); returns the decision after the last one.
+bool RunUpdates(OtherAudioDetector& detector, FakeMeters& meters, int64_t from, int64_t to) {
+    bool playing = detector.IsPlaying();
+    for (int64_t now = from; now < to; now += kTick) {
+        playing = detector.Update(now, meters.Reader());
+    }
+    return playing;
+}
+
+DC_TEST(IdleSystemReadsNoPeaks) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, false, true);   // Inactive
+    detector.OnSessionAdded(2, true, false);   // Muted
+    detector.OnSessionAdded(3, false, false);  // Both
+    RunUpdates(detector, meters, 0, 5000 * kMs);
+    CHECK(meters.reads.empty());
+    const OtherAudioDetectorStats stats = detector.GetStats();
+    CHECK_EQ(stats.sessions, 3u);
+    CHECK_EQ(stats.sampled_sessions, 0u);
+    CHECK_EQ(stats.peak_reads, 0u);
+    CHECK(!stats.playing);
+}
+
+DC_TEST(OnlyActiveAudibleSessionsAreSampled) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    detector.OnSessionAdded(2, true, false);
+    detector.OnSessionAdded(3, false, true);
+    meters.peaks = {{1, 0.0f}, {2, 0.5f}, {3, 0.5f}};
+    detector.Update(0, meters.Reader());
+    CHECK(meters.reads == std::vector<uint64_t>{1});
+
+    // Events move sessions in and out of the sampled set
+    detector.OnSessionVolumeChanged(2, true);
+    detector.OnSessionStateChanged(1, false);
+    meters.reads.clear();
+    detector.Update(kTick, meters.Reader());
+    CHECK(meters.reads == std::vector<uint64_t>{2});
+
+    detector.OnSessionRemoved(2);
+    meters.reads.clear();
+    detector.Update(2 * kTick, meters.Reader());
+    CHECK(meters.reads.empty());
+    // Events for unknown sessions are counted but change nothing
+    detector.OnSessionStateChanged(42, true);
+    CHECK_EQ(detector.GetStats().sessions, 2u);
+    CHECK_EQ(detector.GetStats().session_events, 7u);
+}
+
+DC_TEST(SustainedAudioFlipsAfterAttack) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    meters.peaks[1] = 0.2f;
+    // Attack is 400 ms: audible at 0..300 ms is not enough, 400 ms is
+    CHECK(!RunUpdates(detector, meters, 0, 400 * kMs));
+    CHECK(detector.Update(400 * kMs, meters.Reader()));
+    CHECK(detector.IsPlaying());
+    CHECK_EQ(detector.GetStats().flips, 1u);
+}
+
+DC_TEST(TransientDoesNotFlip) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    meters.peaks[1] = 0.0f;
+    RunUpdates(detector, meters, 0, 1000 * kMs);
+    // Notification sound: 300 ms audible
+    meters.peaks[1] = 0.8f;
+    RunUpdates(detector, meters, 1000 * kMs, 1300 * kMs);
+    meters.peaks[1] = 0.0f;
+    CHECK(!RunUpdates(detector, meters, 1300 * kMs, 5000 * kMs));
+    CHECK_EQ(detector.GetStats().flips, 0u);
+}
+
+DC_TEST(ShortSilenceHoldsPlaying) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    meters.peaks[1] = 0.3f;
+    CHECK(RunUpdates(detector, meters, 0, 1000 * kMs));
+    // Quiet passage between tracks: 1.5 s < 2 s hold
+    meters.peaks[1] = 0.001f;
+    CHECK(RunUpdates(detector, meters, 1000 * kMs, 2500 * kMs));
+    meters.peaks[1] = 0.3f;
+    CHECK(RunUpdates(detector, meters, 2500 * kMs, 3000 * kMs));
+    // Music stops
+    meters.peaks[1] = 0.0f;
+    CHECK(RunUpdates(detector, meters, 3000 * kMs, 4900 * kMs));
+    CHECK(!detector.Update(5000 * kMs, meters.Reader()));
+    CHECK_EQ(detector.GetStats().flips, 2u);
+}
+
+DC_TEST(ThresholdIsInclusiveAndLoudestSessionWins) {
+    OtherAudioDetectorConfig config;
+    config.peak_threshold = 0.05f;
+    config.attack_ns = 0;
+    OtherAudioDetector detector(config);
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    detector.OnSessionAdded(2, true, true);
+    meters.peaks = {{1, 0.01f}, {2, 0.049f}};
+    CHECK(!detector.Update(0, meters.Reader()));
+    meters.peaks[2] = 0.05f;
+    CHECK(detector.Update(kTick, meters.Reader()));
+    CHECK_NEAR(detector.GetStats().max_peak, 0.05f, 1e-6);
+}
+
+DC_TEST(FailedPeakReadCountsAsSilent) {
+    OtherAudioDetectorConfig config;
+    config.attack_ns = 0;
+    OtherAudioDetector detector(config);
+    FakeMeters meters;  // No peak entries: every read fails
+    detector.OnSessionAdded(7, true, true);
+    CHECK(!RunUpdates(detector, meters, 0, 1000 * kMs));
+    CHECK_EQ(detector.GetStats().peak_reads, 10u);
+}
+
+DC_TEST(UpdateGapRestartsHysteresis) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    meters.peaks[1] = 0.3f;
+    CHECK(!RunUpdates(detector, meters, 0, 300 * kMs));
+    // Monitor paused for 3 s: the audible run restarts, attack counts again
+    CHECK(!detector.Update(3300 * kMs, meters.Reader()));
+    CHECK(!RunUpdates(detector, meters, 3400 * kMs, 3700 * kMs));
+    CHECK(detector.Update(3700 * kMs, meters.Reader()));
+
+    // Gap while playing drops the decision until attack passes again
+    CHECK(!detector.Update(6000 * kMs, meters.Reader()));
+}
+
+DC_TEST(ResetHysteresisClearsDecision) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    meters.peaks[1] = 0.3f;
+    CHECK(RunUpdates(detector, meters, 0, 1000 * kMs));
+    detector.ResetHysteresis();
+    CHECK(!detector.IsPlaying());
+    CHECK(!detector.Update(1000 * kMs, meters.Reader()));
+    CHECK(detector.Update(1400 * kMs, meters.Reader()));
+}
+
+DC_TEST(ClearSessionsStopsSampling) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    detector.OnSessionAdded(2, true, true);
+    meters.peaks = {{1, 0.3f}, {2, 0.3f}};
+    RunUpdates(detector, meters, 0, 1000 * kMs);
+    detector.ClearSessions();  // Default device changed
+    meters.reads.clear();
+    RunUpdates(detector, meters, 1000 * kMs, 4000 * kMs);
+    CHECK(meters.reads.empty());
+    CHECK(!detector.IsPlaying());
+    CHECK_EQ(detector.GetStats().sessions, 0u);
+}
+
+DC_TEST(SetConfigAppliesOnNextUpdate) {
+    OtherAudioDetector detector;
+    FakeMeters meters;
+    detector.OnSessionAdded(1, true, true);
+    meters.peaks[1] = 0.005f;  // Below the default threshold
+    CHECK(!RunUpdates(detector, meters, 0, 1000 * kMs));
+    OtherAudioDetectorConfig config;
+    config.peak_threshold = 0.001f;
+    config.attack_ns = 200 * kMs;
+    detector.SetConfig(config);
+    CHECK(!detector.Update(1000 * kMs, meters.Reader()));
+    CHECK(!detector.Update(1100 * kMs, meters.Reader()));
+    CHECK(detector.Update(1200 * kMs, meters.Reader()));
+}
+
+DC_TEST(ConcurrentSessionEventsAndUpdates) {
+    OtherAudioDetector detector;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> started{false};
+    std::thread events([&] {
+        uint64_t key = 0;
+        started.store(true);
+        while (!stop.load(std::memory_order_relaxed)) {
+            detector.OnSessionAdded(key % 64, true, true);
+            detector.OnSessionVolumeChanged((key + 7) % 64, key % 3 != 0);
+            detector.OnSessionStateChanged((key + 13) % 64, key % 5 != 0);
+            if (key % 4 == 0) {
+                detector.OnSessionRemoved((key + 31) % 64);
+            }
+            ++key;
+        }
+    });
+    const auto read_peak = [](uint64_t key, float* peak_out) {
+        *peak_out = key % 2 == 0 ? 0.5f : 0.0f;
+        return true;
+    };
+    while (!started.load()) {
+    }
+    for (int64_t i = 0; i < 20000; ++i) {
+        detector.Update(i * kMs, read_peak);
+    }
+    stop.store(true);
+    events.join();
+    const OtherAudioDetectorStats stats = detector.GetStats();
+    CHECK(stats.sessions <= 64u);
+    CHECK(stats.session_events > 0u);
+}
+
+}  // namespace
@@ -0,0 +1,374 @@
+// Source Code <Display Commander> // InputRemapper table tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "modules/controller/input_remap_table.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::input_remapping;
+
+constexpr uint32_t kSlots = 4;
+
+enum class RefType { kKeyboard, kGamepad, kAction };
+
+// One InputRemapper::ButtonRemap, as stored in _remappings
+struct RefRemap {
+    uint16_t button = 0;
+    RefType type = RefType::kKeyboard;
+    uint16_t target = 0;
+    std::string action;
+    bool enabled = true;
+    bool hold = false;
+    bool chord = false;
+};
+
+struct Event {
+    char kind;  // 'P' press, 'R' release, 'G' Home solo release
+    uint32_t slot;
+    uint16_t button;
+    bool other;
+
+    bool operator==(const Event& o) const {
+        return kind == o.kind && slot == o.slot && button == o.button && other == o.other;
+    }
+};
+
+bool IsGuideSolo(const RefRemap& r) {
+    return r.type == RefType::kAction && r.button == kRemapGuideButton && r.action == "display commander ui toggle";
+}
+
+// The remap path before the compiled table (update_button_states, handle_button_press / _release and
+// apply_gamepad_remapping), transcribed without the Windows types. Keyboard / gamepad / action side effects become
+// events; the Home solo toggle reports whether another mapped button was involved.
+class LegacyRemapper {
+   public:
+    explicit LegacyRemapper(std::vector<RefRemap> remaps) : remaps_(std::move(remaps)) {}
+
+    uint16_t Poll(uint32_t slot, uint16_t buttons, std::vector<Event>* events) {
+        const uint16_t previous = previous_[slot];
+        previous_[slot] = buttons;
+        const uint16_t changed = previous ^ buttons;
+        for (int i = 0; i < 16; ++i) {
+            const auto mask = static_cast<uint16_t>(1u << i);
+            if ((changed & mask) == 0) {
+                continue;
+            }
+            if ((buttons & mask) != 0) {
+                Press(mask, slot, buttons, events);
+            } else {
+                Release(mask, slot, buttons, events);
+            }
+        }
+        for (const RefRemap& r : remaps_) {
+            if (!r.enabled || r.type != RefType::kGamepad) {
+                continue;
+            }
+            if (r.chord && (buttons & kRemapGuideButton) == 0) {
+                continue;
+            }
+            if ((buttons & r.button) != 0) {
+                buttons |= r.target;
+                if (!r.hold) {
+                    buttons &= static_cast<uint16_t>(~r.button);
+                }
+            }
+        }
+        return buttons;
+    }
+
+   private:
+    const RefRemap* Find(uint16_t button) const {
+        for (const RefRemap& r : remaps_) {
+            if (r.button == button) {
+                return &r;
+            }
+        }
+        return nullptr;
+    }
+
+    void Press(uint16_t mask, uint32_t slot, uint16_t current, std::vector<Event>* events) {
+        const RefRemap* r = Find(mask);
+        if (r == nullptr || !r->enabled) {
+            return;
+        }
+        if (mask != kRemapGuideButton && solo_candidate_[slot]) {
+            solo_other_[slot] = true;
+        }
+        if (IsGuideSolo(*r)) {
+            solo_candidate_[slot] = true;
+            solo_other_[slot] = (current & static_cast<uint16_t>(~kRemapGuideButton)) != 0;
+            return;
+        }
+        if (r->chord && (current & kRemapGuideButton) == 0) {
+            return;
+        }
+        events->push_back({'P', slot, mask, false});
+    }
+
+    void Release(uint16_t mask, uint32_t slot, uint16_t current, std::vector<Event>* events) {
+        const RefRemap* r = Find(mask);
+        if (r == nullptr || !r->enabled || !r->hold) {
+            return;
+        }
+        if (r->chord && (current & kRemapGuideButton) == 0) {
+            return;
+        }
+        if (IsGuideSolo(*r)) {
+            const bool candidate = solo_candidate_[slot];
+            const bool other = solo_other_[slot];
+            solo_candidate_[slot] = false;
+            solo_other_[slot] = false;
+            if (candidate) {
+                events->push_back({'G', slot, mask, other});
+            }
+            return;
+        }
+        events->push_back({'R', slot, mask, false});
+    }
+
+    std::vector<RefRemap> remaps_;
+    uint16_t previous_[kSlots] = {};
+    bool solo_candidate_[kSlots] = {};
+    bool solo_other_[kSlots] = {};
+};
+
+class RecordingSink : public IRemapEventSink {
+   public:
+    explicit RecordingSink(std::vector<Event>* events) : events_(events) {}
+    void OnPress(uint32_t slot, const RemapBitEntry& entry) override {
+        events_->push_back({'P', slot, entry.source_button, false});
+    }
+    void OnRelease(uint32_t slot, const RemapBitEntry& entry) override {
+        events_->push_back({'R', slot, entry.source_button, false});
+    }
+    void OnGuideSoloRelease(uint32_t slot, const RemapBitEntry& entry, bool other_button_pressed) override {
+        events_->push_back({'G', slot, entry.source_button, other_button_pressed});
+    }
+
+   private:
+    std::vector<Event>* events_;
+};
+
+// Same conversion as InputRemapper::publish_compiled_table
+CompiledRemapTable Compile(const std::vector<RefRemap>& remaps) {
+    CompiledRemapTable table;
+    for (const RefRemap& r : remaps) {
+        if (!r.enabled) {
+            continue;
+        }
+        RemapBitEntry entry;
+        entry.hold = r.hold;
+        entry.chord = r.chord;
+        entry.source_button = r.button;
+        switch (r.type) {
+            case RefType::kKeyboard: entry.kind = RemapEntryKind::kKeyboard; break;
+            case RefType::kGamepad:
+                entry.kind = RemapEntryKind::kGamepad;
+                entry.gamepad_target = r.target;
+                break;
+            case RefType::kAction:
+                entry.kind = IsGuideSolo(r) ? RemapEntryKind::kGuideSoloToggle : RemapEntryKind::kAction;
+                entry.action_name = r.action;
+                break;
+        }
+        table.Add(entry);
+    }
+    return table;
+}
+
+// add_button_remap: a remap for a button already in the list replaces it in place
+std::vector<RefRemap> RandomConfig(std::mt19937& rng) {
+    std::vector<RefRemap> remaps;
+    const int count = static_cast<int>(rng() % 9);
+    for (int i = 0; i < count; ++i) {
+        RefRemap r;
+        // Bias towards Home and a handful of buttons so chords and replacements are common
+        r.button = (rng() % 4 == 0) ? kRemapGuideButton : static_cast<uint16_t>(1u << (rng() % 16));
+        r.type = static_cast<RefType>(rng() % 3);
+        r.target = static_cast<uint16_t>(1u << (rng() % 16));
+        r.action = (rng() % 2 == 0) ? "display commander ui toggle" : "screenshot";
+        r.enabled = rng() % 5 != 0;
+        r.hold = rng() % 2 == 0;
+        r.chord = rng() % 3 == 0;
+        bool replaced = false;
+        for (RefRemap& existing : remaps) {
+            if (existing.button == r.button) {
+                existing = r;
+                replaced = true;
+            }
+        }
+        if (!replaced) {
+            remaps.push_back(r);
+        }
+    }
+    return remaps;
+}
+
+uint16_t RandomButtons(std::mt19937& rng, uint16_t previous) {
+    // Mostly small changes to the previous state, sometimes a completely new state
+    if (rng() % 8 == 0) {
+        return static_cast<uint16_t>(rng() & 0xFFFF);
+    }
+    const int flips = static_cast<int>(rng() % 3);
+    for (int i = 0; i < flips; ++i) {
+        previous ^= (rng() % 3 == 0) ? kRemapGuideButton : static_cast<uint16_t>(1u << (rng() % 16));
+    }
+    return previous;
+}
+
+bool IsChordBit(const std::vector<RefRemap>& remaps, uint16_t button) {
+    for (const RefRemap& r : remaps) {
+        if (r.button == button && r.enabled && r.chord) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Chord remap releases intentionally differ: the old path released only while Home was still down (and also for
+// presses it had filtered), the table releases exactly the presses it fired.
+std::vector<Event> WithoutChordReleases(const std::vector<Event>& events, const std::vector<RefRemap>& remaps) {
+    std::vector<Event> out;
+    for (const Event& e : events) {
+        if (!(e.kind == 'R' && IsChordBit(remaps, e.button))) {
+            out.push_back(e);
+        }
+    }
+    return out;
+}
+
+DC_TEST(TableMatchesLegacyRemapPath) {
+    std::mt19937 rng(1234);
+    for (int config = 0; config < 2000; ++config) {
+        const std::vector<RefRemap> remaps = RandomConfig(rng);
+        LegacyRemapper legacy(remaps);
+        const CompiledRemapTable table = Compile(remaps);
+        RemapSlotState states[kSlots];
+        uint16_t buttons[kSlots] = {};
+
+        std::vector<Event> legacy_events;
+        std::vector<Event> table_events;
+        RecordingSink sink(&table_events);
+        for (int poll = 0; poll < 400; ++poll) {
+            const auto slot = static_cast<uint32_t>(rng() % kSlots);
+            buttons[slot] = RandomButtons(rng, buttons[slot]);
+            const uint16_t legacy_out = legacy.Poll(slot, buttons[slot], &legacy_events);
+            StepRemapSlot(table, states[slot], slot, buttons[slot], sink);
+            const uint16_t table_out = table.ApplyGamepadRemaps(buttons[slot]);
+            REQUIRE(legacy_out == table_out);
+        }
+        REQUIRE(WithoutChordReleases(legacy_events, remaps) == WithoutChordReleases(table_events, remaps));
+    }
+}
+
+DC_TEST(ChordReleaseFollowsFiredPress) {
+    RefRemap r;
+    r.button = 0x1000;  // A
+    r.hold = true;
+    r.chord = true;
+    const CompiledRemapTable table = Compile({r});
+    RemapSlotState state;
+    std::vector<Event> events;
+    RecordingSink sink(&events);
+
+    StepRemapSlot(table, state, 0, 0x1000, sink);  // A without Home: filtered
+    StepRemapSlot(table, state, 0, kRemapGuideButton, sink);  // A up with Home down: nothing was pressed
+    CHECK(events.empty());
+
+    StepRemapSlot(table, state, 0, kRemapGuideButton | 0x1000, sink);  // Home + A: press
+    StepRemapSlot(table, state, 0, 0x1000, sink);  // Home let go first
+    StepRemapSlot(table, state, 0, 0, sink);  // A up: the held key is released
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].kind == 'P');
+    CHECK(events[1].kind == 'R');
+}
+
+DC_TEST(GuideSoloRequiresHoldLikeLegacy) {
+    RefRemap r;
+    r.button = kRemapGuideButton;
+    r.type = RefType::kAction;
+    r.action = "display commander ui toggle";
+    for (const bool hold : {false, true}) {
+        r.hold = hold;
+        const CompiledRemapTable table = Compile({r});
+        RemapSlotState state;
+        std::vector<Event> events;
+        RecordingSink sink(&events);
+        StepRemapSlot(table, state, 0, kRemapGuideButton, sink);
+        StepRemapSlot(table, state, 0, 0, sink);
+        CHECK_EQ(events.size(), hold ? 1u : 0u);
+    }
+}
+
+DC_TEST(GamepadRemapOrderAndReplacement) {
+    CompiledRemapTable table;
+    RemapBitEntry a_to_b;
+    a_to_b.kind = RemapEntryKind::kGamepad;
+    a_to_b.source_button = 0x1000;
+    a_to_b.gamepad_target = 0x2000;
+    RemapBitEntry b_to_x = a_to_b;
+    b_to_x.source_button = 0x2000;
+    b_to_x.gamepad_target = 0x4000;
+    table.Add(a_to_b);
+    table.Add(b_to_x);
+    // Later remaps see buttons added by earlier ones; one-shot remaps clear their source
+    CHECK_EQ(table.ApplyGamepadRemaps(0x1000), 0x4000);
+
+    RemapBitEntry a_to_key;
+    a_to_key.kind = RemapEntryKind::kKeyboard;
+    a_to_key.source_button = 0x1000;
+    table.Add(a_to_key);
+    CHECK_EQ(table.gamepad.count, 1u);
+    CHECK_EQ(table.ApplyGamepadRemaps(0x1000), 0x1000);
+    CHECK_EQ(table.ApplyGamepadRemaps(0x2000), 0x4000);
+}
+
+DC_TEST(BenchmarkTableVersusLegacyWalk) {
+    std::mt19937 rng(99);
+    std::vector<RefRemap> remaps;
+    for (int i = 0; i < 8; ++i) {
+        RefRemap r;
+        r.button = static_cast<uint16_t>(1u << (i * 2));
+        r.type = i % 2 == 0 ? RefType::kGamepad : RefType::kKeyboard;
+        r.target = static_cast<uint16_t>(1u << (i * 2 + 1));
+        r.hold = true;
+        r.chord = i % 3 == 0;
+        remaps.push_back(r);
+    }
+    std::vector<uint16_t> stream(4096);
+    uint16_t buttons = 0;
+    for (uint16_t& b : stream) {
+        buttons = RandomButtons(rng, buttons);
+        b = buttons;
+    }
+
+    LegacyRemapper legacy(remaps);
+    std::vector<Event> events;
+    events.reserve(1 << 20);
+    const double legacy_ns = dc_test::MeasureNsPerOp(200000, [&](size_t i) {
+        if (events.size() > (1u << 19)) {
+            events.clear();
+        }
+        dc_test::Consume(legacy.Poll(0, stream[i % stream.size()], &events));
+    });
+
+    const CompiledRemapTable table = Compile(remaps);
+    RemapSlotState state;
+    RecordingSink sink(&events);
+    const double table_ns = dc_test::MeasureNsPerOp(200000, [&](size_t i) {
+        if (events.size() > (1u << 19)) {
+            events.clear();
+        }
+        StepRemapSlot(table, state, 0, stream[i % stream.size()], sink);
+        dc_test::Consume(table.ApplyGamepadRemaps(stream[i % stream.size()]));
+    });
+    dc_test::ReportBenchmark("legacy remap walk (no lock)", legacy_ns);
+    dc_test::ReportBenchmark("compiled remap table", table_ns);
+}
+
+}  // namespace
@@ -0,0 +1,181 @@
+// Source Code <Display Commander> // XInput connection cache tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "modules/controller/xinput_connection_cache.hpp"
+
+// Libraries <Standard C++>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using display_commanderhooks::XInputConnectionCache;
+
+constexpr int64_t kMs = 1000000;
+
+// Fake XInput: a pad plugs into a slot at a scripted time; counts the device probes that reach it.
+struct FakeXInput {
+    std::array<int64_t, XInputConnectionCache::kSlotCount> connect_at_ns = {INT64_MAX, INT64_MAX, INT64_MAX,
+                                                                             INT64_MAX};
+    uint64_t probes = 0;
+
+    bool Probe(uint32_t slot, int64_t now_ns) {
+        ++probes;
+        return slot < connect_at_ns.size() && now_ns >= connect_at_ns[slot];
+    }
+};
+
+// XInputGetState_Detour's use of the cache.
+bool GetState(XInputConnectionCache& cache, FakeXInput& xinput, uint32_t slot, int64_t now_ns) {
+    if (cache.ServeFromCache(slot, now_ns)) {
+        return false;
+    }
+    const uint32_t epoch = cache.Epoch();
+    const bool connected = xinput.Probe(slot, now_ns);
+    cache.RecordProbe(slot, connected, now_ns, epoch);
+    return connected;
+}
+
+DC_TEST(BackoffDoublesUpToMaximum) {
+    XInputConnectionCache cache;
+    FakeXInput xinput;
+    std::vector<int64_t> probe_times;
+    for (int64_t now = 0; now <= 10000 * kMs; now += kMs) {
+        const uint64_t before = xinput.probes;
+        GetState(cache, xinput, 2, now);
+        if (xinput.probes != before) {
+            probe_times.push_back(now);
+        }
+    }
+    // 0, +100, +200, +400, +800, +1600, then every 2000 ms
+    const std::vector<int64_t> expected = {0,           100 * kMs,  300 * kMs,  700 * kMs,
+                                           1500 * kMs,  3100 * kMs, 5100 * kMs, 7100 * kMs,
+                                           9100 * kMs};
+    CHECK((probe_times == expected));
+    CHECK_EQ(cache.GetStats().backoff_ns[2], XInputConnectionCache::kMaxBackoffNs);
+}
+
+// A game polling all four slots at 60 Hz with one pad connected: the three empty slots stop hitting the device.
+DC_TEST(GamePollingEmptySlotsAvoidsProbes) {
+    XInputConnectionCache cache;
+    FakeXInput xinput;
+    xinput.connect_at_ns[0] = 0;
+    const int64_t frame_ns = 16666667;
+    int frames = 0;
+    for (int64_t now = 0; now < 60 * 1000 * kMs; now += frame_ns, ++frames) {
+        for (uint32_t slot = 0; slot < XInputConnectionCache::kSlotCount; ++slot) {
+            CHECK_EQ(GetState(cache, xinput, slot, now), slot == 0);
+        }
+    }
+    const XInputConnectionCache::Stats stats = cache.GetStats();
+    // Connected slot: every frame. Empty slots: ~35 probes each over the minute instead of 3600.
+    CHECK(xinput.probes < static_cast<uint64_t>(frames) + 3 * 40);
+    CHECK_EQ(stats.probes, xinput.probes);
+    CHECK_EQ(stats.avoided_probes + stats.probes, static_cast<uint64_t>(frames) * 4);
+    CHECK(!stats.cached_disconnected[0]);
+    CHECK(stats.cached_disconnected[3]);
+}
+
+// Without any notification a pad is found within kMaxBackoffNs plus one poll interval of plugging in.
+DC_TEST(ReconnectLatencyBoundWithoutNotification) {
+    const int64_t frame_ns = 16666667;
+    for (int64_t plug_at = 50 * kMs; plug_at < 20000 * kMs; plug_at += 777 * kMs) {
+        XInputConnectionCache cache;
+        FakeXInput xinput;
+        xinput.connect_at_ns[1] = plug_at;
+        int64_t seen_at = -1;
+        for (int64_t now = 0; now < plug_at + 5000 * kMs; now += frame_ns) {
+            if (GetState(cache, xinput, 1, now)) {
+                seen_at = now;
+                break;
+            }
+        }
+        REQUIRE(seen_at >= 0);
+        CHECK(seen_at - plug_at <= XInputConnectionCache::kMaxBackoffNs + frame_ns);
+        CHECK_EQ(cache.GetStats().reconnects, 1u);
+    }
+}
+
+DC_TEST(InvalidateMakesNextCallProbe) {
+    XInputConnectionCache cache;
+    FakeXInput xinput;
+    for (int64_t now = 0; now < 5000 * kMs; now += 10 * kMs) {
+        GetState(cache, xinput, 0, now);
+    }
+    CHECK(cache.ServeFromCache(0, 5000 * kMs));
+    xinput.connect_at_ns[0] = 5001 * kMs;
+    cache.Invalidate();  // WM_DEVICECHANGE / DBT_DEVICEARRIVAL
+    CHECK(GetState(cache, xinput, 0, 5001 * kMs));
+    const XInputConnectionCache::Stats stats = cache.GetStats();
+    CHECK_EQ(stats.invalidations, 1u);
+    CHECK_EQ(stats.backoff_ns[0], 0);
+}
+
+// A probe that started before Invalidate() and reports "not connected" afterwards must not re-cache the slot.
+DC_TEST(ProbeRacingInvalidateDoesNotCache) {
+    XInputConnectionCache cache;
+    const uint32_t epoch = cache.Epoch();
+    cache.Invalidate();
+    cache.RecordProbe(3, false, 100 * kMs, epoch);
+    CHECK(!cache.ServeFromCache(3, 101 * kMs));
+    CHECK(!cache.GetStats().cached_disconnected[3]);
+
+    cache.RecordProbe(3, false, 102 * kMs, cache.Epoch());
+    CHECK(cache.ServeFromCache(3, 103 * kMs));
+}
+
+DC_TEST(SlotsOutsideRangeAreNeverCached) {
+    XInputConnectionCache cache;
+    cache.RecordProbe(7, false, 0, cache.Epoch());
+    CHECK(!cache.ServeFromCache(7, 1));
+    CHECK_EQ(cache.GetStats().probes, 1u);
+}
+
+// Game threads polling while device notifications invalidate: every answer from the cache is for a slot that was
+// disconnected at some point, and a connected pad is never reported missing after the last invalidation.
+DC_TEST(ConcurrentPollersAndInvalidations) {
+    XInputConnectionCache cache;
+    std::atomic<bool> pad_connected{false};
+    std::atomic<bool> stop{false};
+    std::atomic<int64_t> clock{0};
+    std::atomic<uint64_t> wrong_after_connect{0};
+    std::atomic<bool> connected_and_invalidated{false};
+
+    std::vector<std::thread> pollers;
+    for (int t = 0; t < 3; ++t) {
+        pollers.emplace_back([&] {
+            while (!stop.load(std::memory_order_acquire)) {
+                const int64_t now = clock.fetch_add(kMs / 10, std::memory_order_relaxed);
+                const bool settled = connected_and_invalidated.load(std::memory_order_acquire);
+                bool result = false;
+                if (!cache.ServeFromCache(0, now)) {
+                    const uint32_t epoch = cache.Epoch();
+                    result = pad_connected.load(std::memory_order_acquire);
+                    cache.RecordProbe(0, result, now, epoch);
+                }
+                if (settled && !result) {
+                    wrong_after_connect.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        cache.Invalidate();
+        std::this_thread::yield();
+    }
+    pad_connected.store(true, std::memory_order_release);
+    cache.Invalidate();
+    connected_and_invalidated.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stop.store(true, std::memory_order_release);
+    for (std::thread& t : pollers) {
+        t.join();
+    }
+    CHECK_EQ(wrong_after_connect.load(), 0u);
+    CHECK_EQ(cache.GetStats().invalidations, 2001u);
+}
+
+}  // namespace
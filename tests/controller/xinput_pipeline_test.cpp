@@ -0,0 +1,443 @@
+// Source Code <Display Commander> // XInput transform pipeline tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "modules/controller/xinput_pipeline.hpp"
+#include "utils/stick_mapping.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace display_commanderhooks;
+using display_commander::input_remapping::CompiledRemapTable;
+using display_commander::input_remapping::RemapBitEntry;
+using display_commander::input_remapping::RemapEntryKind;
+
+constexpr uint16_t kDpadUp = 0x0001;
+constexpr uint16_t kStart = 0x0010;
+constexpr uint16_t kGuide = 0x0400;
+constexpr uint16_t kX = 0x4000;
+constexpr uint16_t kY = 0x8000;
+
+XInputPadState Pad(uint16_t buttons, int16_t lx = 0, int16_t ly = 0, int16_t rx = 0, int16_t ry = 0) {
+    XInputPadState pad;
+    pad.buttons = buttons;
+    pad.thumb_lx = lx;
+    pad.thumb_ly = ly;
+    pad.thumb_rx = rx;
+    pad.thumb_ry = ry;
+    pad.left_trigger = 17;
+    pad.right_trigger = 230;
+    return pad;
+}
+
+XInputPadState Run(const XInputPipelineParams& params, XInputPadState pad) {
+    CompileXInputPipeline(params).Apply(pad);
+    return pad;
+}
+
+std::vector<std::string> StageNames(const XInputPipeline& pipeline) {
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < pipeline.transform_count; ++i) {
+        names.emplace_back(pipeline.transform_names[i]);
+    }
+    return names;
+}
+
+RemapBitEntry GamepadRemap(uint16_t source, uint16_t target, bool hold, bool chord) {
+    RemapBitEntry entry;
+    entry.kind = RemapEntryKind::kGamepad;
+    entry.source_button = source;
+    entry.gamepad_target = target;
+    entry.hold = hold;
+    entry.chord = chord;
+    return entry;
+}
+
+// A -> X (hold), B -> Y (one-shot: B is cleared), D-pad up -> Start only with Home held
+display_commander::input_remapping::GamepadRemapList SampleRemaps() {
+    CompiledRemapTable table;
+    table.Add(GamepadRemap(kXInputButtonA, kX, true, false));
+    table.Add(GamepadRemap(kXInputButtonB, kY, false, false));
+    table.Add(GamepadRemap(kDpadUp, kStart, true, true));
+    return table.gamepad;
+}
+
+DC_TEST(CompiledStagesFollowSettings) {
+    XInputPipelineParams params;
+    CHECK((StageNames(CompileXInputPipeline(params))
+           == std::vector<std::string>{"left_stick_radial", "right_stick_radial"}));
+
+    params.override_buttons = kStart;
+    params.swap_a_b = true;
+    params.right.circular = false;
+    params.remap = true;
+    CHECK((StageNames(CompileXInputPipeline(params))
+           == std::vector<std::string>{"override", "swap_a_b", "left_stick_radial", "right_stick_square",
+                                       "gamepad_remap"}));
+
+    XInputPipelineParams stick_override;
+    stick_override.override_ry = 0.0f;
+    CHECK_EQ(CompileXInputPipeline(stick_override).transform_count, 3u);
+}
+
+DC_TEST(GoldenSwapAB) {
+    XInputPipelineParams params;
+    params.swap_a_b = true;
+    CHECK_EQ(Run(params, Pad(kXInputButtonA)).buttons, kXInputButtonB);
+    CHECK_EQ(Run(params, Pad(kXInputButtonB)).buttons, kXInputButtonA);
+    CHECK_EQ(Run(params, Pad(kXInputButtonA | kXInputButtonB)).buttons, kXInputButtonA | kXInputButtonB);
+    CHECK_EQ(Run(params, Pad(kXInputButtonA | kX | kDpadUp)).buttons, kXInputButtonB | kX | kDpadUp);
+    CHECK_EQ(Run(params, Pad(kX)).buttons, kX);
+    CHECK_EQ(Run(params, Pad(0)).buttons, 0);
+}
+
+DC_TEST(GoldenOverride) {
+    XInputPipelineParams params;
+    params.override_lx = -1.0f;
+    params.override_ly = 0.0f;
+    params.override_rx = 0.5f;
+    params.override_buttons = kStart;
+    const XInputPadState out = Run(params, Pad(kXInputButtonA, 20000, 20000, -20000, 12345));
+    CHECK_EQ(out.buttons, kXInputButtonA | kStart);
+    CHECK_NEAR(out.thumb_lx, -32768, 1);
+    CHECK_NEAR(out.thumb_ly, 0, 1);
+    CHECK_NEAR(out.thumb_rx, 16383, 1);
+    CHECK_NEAR(out.thumb_ry, 12345, 1);  // Not overridden: only the default stick stage
+    // Overridden sticks still go through the stick stage: (1, 1) is clamped to the unit circle
+    params.override_ly = 1.0f;
+    const XInputPadState clamped = Run(params, Pad(0));
+    CHECK_NEAR(clamped.thumb_lx, -23170, 2);
+    CHECK_NEAR(clamped.thumb_ly, 23170, 2);
+    CHECK_EQ(out.left_trigger, 17);
+    CHECK_EQ(out.right_trigger, 230);
+}
+
+// Default mapping is the identity inside the unit circle (within one step of rounding) and clamps outside it.
+DC_TEST(GoldenDefaultSticks) {
+    const XInputPipelineParams params;
+    const int16_t values[] = {-32768, -20000, -1, 0, 1, 77, 9000, 23170, 32767};
+    for (int16_t x : values) {
+        for (int16_t y : values) {
+            const float fx = ShortToFloat(x);
+            const float fy = ShortToFloat(y);
+            const XInputPadState out = Run(params, Pad(0, x, y, y, x));
+            if (fx * fx + fy * fy <= 0.999f) {
+                CHECK_NEAR(out.thumb_lx, x, 1);
+                CHECK_NEAR(out.thumb_ly, y, 1);
+                CHECK_NEAR(out.thumb_rx, y, 1);
+                CHECK_NEAR(out.thumb_ry, x, 1);
+            } else {
+                const double mag = std::hypot(static_cast<double>(out.thumb_lx), static_cast<double>(out.thumb_ly));
+                CHECK(mag <= 32768.5);
+            }
+        }
+    }
+    CHECK_EQ(Run(params, Pad(0, 32767, 0)).thumb_lx, 32767);
+}
+
+DC_TEST(GoldenRadialDeadzoneAndResponseCurve) {
+    XInputPipelineParams params;
+    params.left.min_in_x = 0.25f;  // Deadzone
+    params.left.max_in_x = 0.75f;  // Full output from 75% deflection
+    params.left.min_out_x = 0.2f;  // Anti-deadzone
+    params.left.max_out_x = 0.9f;
+
+    CHECK_EQ(Run(params, Pad(0, 8000, 0)).thumb_lx, 0);  // 24.4%: inside the deadzone
+    CHECK_EQ(Run(params, Pad(0, 0, -8000)).thumb_ly, 0);
+    // 50%: halfway along the curve -> 0.2 + 0.5 * 0.7 = 0.55
+    CHECK_NEAR(Run(params, Pad(0, 16384, 0)).thumb_lx, 0.55 * 32767.5, 2);
+    CHECK_NEAR(Run(params, Pad(0, -16384, 0)).thumb_lx, -0.55 * 32767.5, 2);
+    CHECK_NEAR(Run(params, Pad(0, 32767, 0)).thumb_lx, 0.9 * 32767.5, 2);  // Max output
+    // The curve applies to the magnitude: a diagonal keeps its direction
+    const XInputPadState diag = Run(params, Pad(0, 16384, 16384));
+    CHECK_NEAR(diag.thumb_lx, diag.thumb_ly, 1);
+    const double diag_in = std::hypot(ShortToFloat(16384), ShortToFloat(16384));
+    CHECK_NEAR(std::hypot(diag.thumb_lx, diag.thumb_ly), (0.2 + (diag_in - 0.25) / 0.5 * 0.7) * 32767.5, 3);
+    // Right stick untouched by left settings
+    CHECK_NEAR(Run(params, Pad(0, 0, 0, 8000, 0)).thumb_rx, 8000, 1);
+}
+
+DC_TEST(GoldenSquarePerAxisCurve) {
+    XInputPipelineParams params;
+    params.right.circular = false;
+    params.right.min_in_x = 0.1f;
+    params.right.max_in_x = 0.9f;
+    params.right.min_in_y = 0.5f;  // Y: big deadzone, half output
+    params.right.max_in_y = 1.0f;
+    params.right.max_out_y = 0.5f;
+
+    const XInputPadState out = Run(params, Pad(0, 0, 0, -16384, 16384));
+    CHECK_NEAR(out.thumb_rx, -0.5 * 32767.5, 2);  // (0.5 - 0.1) / 0.8
+    CHECK_EQ(out.thumb_ry, 0);                    // 50%: at the Y deadzone
+    CHECK_NEAR(Run(params, Pad(0, 0, 0, 32767, 32767)).thumb_rx, 32767, 1);
+    CHECK_NEAR(Run(params, Pad(0, 0, 0, 32767, 32767)).thumb_ry, 0.5 * 32767.5, 2);
+    CHECK_NEAR(Run(params, Pad(0, 0, 0, 0, -24576)).thumb_ry, -0.25 * 32767.5, 2);  // (0.75 - 0.5) / 0.5 * 0.5
+}
+
+DC_TEST(GoldenRecenter) {
+    XInputPipelineParams params;
+    params.left.center_x = 0.1f;
+    params.left.center_y = -0.2f;
+    // A stick resting at the calibrated center reports zero
+    const XInputPadState rest = Run(params, Pad(0, FloatToShort(0.1f), FloatToShort(-0.2f)));
+    CHECK_NEAR(rest.thumb_lx, 0, 1);
+    CHECK_NEAR(rest.thumb_ly, 0, 1);
+    // Full deflection on the far side of the center stays full: (-1 - 0.1) / (1 + 0.1)
+    CHECK_NEAR(Run(params, Pad(0, -32768, FloatToShort(-0.2f))).thumb_lx, -32768, 1);
+    CHECK_NEAR(Run(params, Pad(0, 16384, 0)).thumb_lx, (0.5 - 0.1) / 1.1 * 32767.5, 2);
+}
+
+DC_TEST(GoldenGamepadRemapStage) {
+    XInputPipelineParams params;
+    params.remap = true;
+    params.gamepad_remaps = SampleRemaps();
+
+    XInputPadState out = Run(params, Pad(kXInputButtonA | kXInputButtonB));
+    CHECK_EQ(out.buttons, kXInputButtonA | kX | kY);
+    CHECK_EQ(out.buttons_before_remap, kXInputButtonA | kXInputButtonB);
+    CHECK_EQ(Run(params, Pad(kDpadUp)).buttons, kDpadUp);
+    CHECK_EQ(Run(params, Pad(kDpadUp | kGuide)).buttons, kDpadUp | kGuide | kStart);
+
+    // Remaps see the swapped buttons; edges are reported for what entered the remap stage
+    params.swap_a_b = true;
+    out = Run(params, Pad(kXInputButtonA));
+    CHECK_EQ(out.buttons, kY);
+    CHECK_EQ(out.buttons_before_remap, kXInputButtonB);
+
+    // Remapping enabled without gamepad remaps: the stage only records the buttons
+    XInputPipelineParams keyboard_only;
+    keyboard_only.remap = true;
+    out = Run(keyboard_only, Pad(kX | kGuide));
+    CHECK_EQ(out.buttons, kX | kGuide);
+    CHECK_EQ(out.buttons_before_remap, kX | kGuide);
+}
+
+DC_TEST(RemapListsCompareByConfiguration) {
+    CompiledRemapTable a;
+    a.Add(GamepadRemap(kXInputButtonA, kX, true, false));
+    a.Add(GamepadRemap(kXInputButtonB, kY, true, false));
+    RemapBitEntry keyboard;
+    keyboard.kind = RemapEntryKind::kKeyboard;
+    keyboard.source_button = kXInputButtonB;
+    a.Add(keyboard);  // Replaces the B gamepad remap
+    CompiledRemapTable b;
+    b.Add(GamepadRemap(kXInputButtonA, kX, true, false));
+    CHECK((a.gamepad == b.gamepad));
+
+    XInputPipelineParams pa;
+    pa.remap = true;
+    pa.gamepad_remaps = a.gamepad;
+    XInputPipelineParams pb = pa;
+    pb.gamepad_remaps = b.gamepad;
+    CHECK((pa == pb));  // Republishing the same remaps is a no-op
+}
+
+// The processing before the compiled pipeline (ProcessXInputGetState with ApplyThumbstickProcessing and
+// apply_gamepad_remapping), transcribed without the Windows types: every setting is loaded on every poll through
+// the shared_ptr shared state.
+struct LegacySharedState {
+    std::atomic<float> override_lx{INFINITY}, override_ly{INFINITY}, override_rx{INFINITY}, override_ry{INFINITY};
+    std::atomic<uint16_t> override_buttons{0};
+    std::atomic<bool> swap_a_b{false};
+    std::atomic<float> center[4] = {};  // lx, ly, rx, ry
+    std::atomic<bool> circular[2] = {true, true};
+    std::atomic<bool> same_axes[2] = {true, true};
+    // Per stick: min_in_x, max_in_x, min_out_x, max_out_x, min_in_y, max_in_y, min_out_y, max_out_y
+    std::atomic<float> mapping[2][8] = {{0, 1, 0, 1, 0, 1, 0, 1}, {0, 1, 0, 1, 0, 1, 0, 1}};
+    std::atomic<bool> remapping_enabled{false};
+    display_commander::input_remapping::GamepadRemapList remaps;
+};
+
+void LegacyStick(const LegacySharedState& s, int stick, int16_t& sx, int16_t& sy) {
+    float m[8];
+    for (int i = 0; i < 8; ++i) {
+        m[i] = s.mapping[stick][i].load();
+    }
+    if (s.same_axes[stick].load()) {
+        m[4] = m[0];
+        m[5] = m[1];
+        m[6] = m[2];
+        m[7] = m[3];
+    }
+    const float cx = s.center[stick * 2].load();
+    const float cy = s.center[stick * 2 + 1].load();
+    float x = (ShortToFloat(sx) - cx) / (1 + std::abs(cx));
+    float y = (ShortToFloat(sy) - cy) / (1 + std::abs(cy));
+    if (s.circular[stick].load()) {
+        ProcessStickInputRadial(x, y, m[0], m[1], m[2], m[3]);
+    } else {
+        ProcessStickInputSquare(x, y, m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7]);
+    }
+    sx = FloatToShort(x);
+    sy = FloatToShort(y);
+}
+
+void LegacyProcess(const std::shared_ptr<LegacySharedState>& shared, XInputPadState& pad) {
+    const std::shared_ptr<LegacySharedState> s = shared;  // GetSharedState() copy per poll
+    if (!std::isinf(s->override_lx.load())) pad.thumb_lx = FloatToShort(s->override_lx.load());
+    if (!std::isinf(s->override_ly.load())) pad.thumb_ly = FloatToShort(s->override_ly.load());
+    if (!std::isinf(s->override_rx.load())) pad.thumb_rx = FloatToShort(s->override_rx.load());
+    if (!std::isinf(s->override_ry.load())) pad.thumb_ry = FloatToShort(s->override_ry.load());
+    if (s->override_buttons.load() != 0) pad.buttons |= s->override_buttons.load();
+    if (s->swap_a_b.load()) {
+        const uint16_t original = pad.buttons;
+        uint16_t swapped = original;
+        if (original & kXInputButtonA) {
+            swapped = static_cast<uint16_t>((swapped | kXInputButtonB) & ~kXInputButtonA);
+        }
+        if (original & kXInputButtonB) {
+            swapped = static_cast<uint16_t>((swapped | kXInputButtonA) & ~kXInputButtonB);
+        }
+        pad.buttons = swapped;
+    }
+    LegacyStick(*s, 0, pad.thumb_lx, pad.thumb_ly);
+    LegacyStick(*s, 1, pad.thumb_rx, pad.thumb_ry);
+    if (s->remapping_enabled.load()) {
+        pad.buttons = s->remaps.Apply(pad.buttons);
+    }
+}
+
+XInputPipelineParams ParamsOf(const LegacySharedState& s) {
+    XInputPipelineParams p;
+    p.override_lx = s.override_lx.load();
+    p.override_ly = s.override_ly.load();
+    p.override_rx = s.override_rx.load();
+    p.override_ry = s.override_ry.load();
+    p.override_buttons = s.override_buttons.load();
+    p.swap_a_b = s.swap_a_b.load();
+    XInputStickParams* sticks[2] = {&p.left, &p.right};
+    for (int i = 0; i < 2; ++i) {
+        XInputStickParams& st = *sticks[i];
+        const int y = s.same_axes[i].load() ? 0 : 4;
+        st.center_x = s.center[i * 2].load();
+        st.center_y = s.center[i * 2 + 1].load();
+        st.circular = s.circular[i].load();
+        st.min_in_x = s.mapping[i][0].load();
+        st.max_in_x = s.mapping[i][1].load();
+        st.min_out_x = s.mapping[i][2].load();
+        st.max_out_x = s.mapping[i][3].load();
+        st.min_in_y = s.mapping[i][y].load();
+        st.max_in_y = s.mapping[i][y + 1].load();
+        st.min_out_y = s.mapping[i][y + 2].load();
+        st.max_out_y = s.mapping[i][y + 3].load();
+    }
+    p.remap = s.remapping_enabled.load();
+    if (p.remap) {
+        p.gamepad_remaps = s.remaps;
+    }
+    return p;
+}
+
+// A recorded-like controller stream: sticks sweeping circles with noise around rest, buttons pressed in bursts.
+std::vector<XInputPadState> RecordedStream(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> noise(-600, 600);
+    std::uniform_int_distribution<int> press(0, 15);
+    std::vector<XInputPadState> stream(count);
+    uint16_t buttons = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double phase = static_cast<double>(i) * 0.013;
+        const double amp = (i / 2000) % 3 == 0 ? 0.05 : ((i / 2000) % 3 == 1 ? 0.6 : 1.1);
+        auto axis = [&](double v) {
+            return static_cast<int16_t>(std::clamp(v * 32767.0 + noise(rng), -32768.0, 32767.0));
+        };
+        if (i % 24 == 0) {
+            buttons ^= static_cast<uint16_t>(1u << press(rng));
+        }
+        stream[i] = Pad(buttons, axis(amp * std::cos(phase)), axis(amp * std::sin(phase)),
+                        axis(amp * std::sin(phase * 1.7)), axis(-amp * std::cos(phase * 0.9)));
+    }
+    return stream;
+}
+
+// 64 setting combinations over a recorded stream: the compiled chain matches the per-poll settings path exactly,
+// except that holding A and B with the swap on reports both (the old path reported only A).
+DC_TEST(CompiledChainMatchesPerPollProcessing) {
+    const std::vector<XInputPadState> stream = RecordedStream(20000);
+    for (int combo = 0; combo < 64; ++combo) {
+        auto shared = std::make_shared<LegacySharedState>();
+        LegacySharedState& s = *shared;
+        if (combo & 1) {
+            s.swap_a_b = true;
+        }
+        if (combo & 2) {
+            s.override_buttons = kStart;
+            s.override_rx = -0.25f;
+        }
+        if (combo & 4) {
+            s.circular[0] = false;
+            s.same_axes[0] = false;
+            const float square[8] = {0.1f, 0.8f, 0.05f, 1.0f, 0.3f, 0.95f, 0.0f, 0.7f};
+            for (int i = 0; i < 8; ++i) {
+                s.mapping[0][i] = square[i];
+            }
+        }
+        if (combo & 8) {
+            const float radial[8] = {0.2f, 0.9f, 0.15f, 0.95f, 0, 1, 0, 1};
+            for (int i = 0; i < 8; ++i) {
+                s.mapping[1][i] = radial[i];
+            }
+        }
+        if (combo & 16) {
+            s.center[0] = 0.05f;
+            s.center[3] = -0.1f;
+        }
+        if (combo & 32) {
+            s.remapping_enabled = true;
+            s.remaps = SampleRemaps();
+        }
+        const XInputPipeline pipeline = CompileXInputPipeline(ParamsOf(s));
+        int mismatches = 0;
+        for (const XInputPadState& in : stream) {
+            const uint16_t a_b = kXInputButtonA | kXInputButtonB;
+            if (s.swap_a_b.load() && (in.buttons & a_b) == a_b) {
+                continue;  // Covered by GoldenSwapAB
+            }
+            XInputPadState expected = in;
+            LegacyProcess(shared, expected);
+            XInputPadState actual = in;
+            pipeline.Apply(actual);
+            if (expected.buttons != actual.buttons || expected.thumb_lx != actual.thumb_lx
+                || expected.thumb_ly != actual.thumb_ly || expected.thumb_rx != actual.thumb_rx
+                || expected.thumb_ry != actual.thumb_ry || expected.left_trigger != actual.left_trigger
+                || expected.right_trigger != actual.right_trigger) {
+                ++mismatches;
+            }
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+}
+
+DC_TEST(BenchmarkPerPollVsCompiled) {
+    const std::vector<XInputPadState> stream = RecordedStream(4096);
+    auto shared = std::make_shared<LegacySharedState>();
+    shared->swap_a_b = true;
+    shared->mapping[0][0] = 0.15f;
+    shared->mapping[1][0] = 0.15f;
+    shared->remapping_enabled = true;
+    shared->remaps = SampleRemaps();
+
+    const double legacy_ns = dc_test::MeasureNsPerOp(400000, [&](size_t i) {
+        XInputPadState pad = stream[i % stream.size()];
+        LegacyProcess(shared, pad);
+        dc_test::Consume(static_cast<unsigned long long>(pad.buttons) + static_cast<uint16_t>(pad.thumb_lx));
+    });
+    const XInputPipeline pipeline = CompileXInputPipeline(ParamsOf(*shared));
+    const double compiled_ns = dc_test::MeasureNsPerOp(400000, [&](size_t i) {
+        XInputPadState pad = stream[i % stream.size()];
+        pipeline.Apply(pad);
+        dc_test::Consume(static_cast<unsigned long long>(pad.buttons) + static_cast<uint16_t>(pad.thumb_lx));
+    });
+    dc_test::ReportBenchmark("xinput per-poll settings path", legacy_ns);
+    dc_test::ReportBenchmark("xinput compiled pipeline", compiled_ns);
+}
+
+}  // namespace
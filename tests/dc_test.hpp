@@ -0,0 +1,72 @@
+// Source Code <Display Commander> // Minimal unit test harness for the platform-neutral cores (no Windows includes)
+#pragma once
+
+// Libraries <Standard C++>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+namespace dc_test {
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+std::vector<TestCase>& Registry();
+
+struct Registrar {
+    Registrar(const char* name, void (*fn)()) { Registry().push_back({name, fn}); }
+};
+
+// Marks the running test as failed and prints the location; the test keeps running.
+void ReportFailure(const char* file, int line, const char* expr);
+
+// Average wall time per call of fn over iterations calls (after a short warm-up), in nanoseconds.
+template <typename Fn>
+double MeasureNsPerOp(size_t iterations, Fn&& fn) {
+    for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+        fn(i);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+           / static_cast<double>(iterations);
+}
+
+// Benchmark results go to stdout (ctest --output-on-failure / -V); they are never asserted on.
+void ReportBenchmark(const char* name, double ns_per_op);
+
+// Keeps the optimizer from dropping a benchmarked computation.
+void Consume(unsigned long long value);
+
+}  // namespace dc_test
+
+#define DC_TEST(name)                                                   \
+    static void name();                                                 \
+    static const dc_test::Registrar name##_registrar(#name, &name);     \
+    static void name()
+
+#define CHECK(expr)                                                     \
+    do {                                                                \
+        if (!(expr)) {                                                  \
+            dc_test::ReportFailure(__FILE__, __LINE__, #expr);          \
+        }                                                               \
+    } while (0)
+
+#define CHECK_EQ(a, b)         CHECK((a) == (b))
+#define CHECK_NEAR(a, b, tol)  CHECK(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= (tol))
+
+// Stops the current test on failure (for preconditions the rest of the test depends on).
+#define REQUIRE(expr)                                                   \
+    do {                                                                \
+        if (!(expr)) {                                                  \
+            dc_test::ReportFailure(__FILE__, __LINE__, #expr);          \
+            return;                                                     \
+        }                                                               \
+    } while (0)
@@ -0,0 +1,56 @@
+// Source Code <Display Commander> // Minimal unit test harness for the platform-neutral cores (no Windows includes)
+#include "dc_test.hpp"
+
+// Libraries <Standard C++>
+#include <cstring>
+
+namespace dc_test {
+
+namespace {
+
+bool g_current_failed = false;
+
+}  // namespace
+
+std::vector<TestCase>& Registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+void ReportFailure(const char* file, int line, const char* expr) {
+    g_current_failed = true;
+    std::printf("  %s:%d: check failed: %s\n", file, line, expr);
+}
+
+void ReportBenchmark(const char* name, double ns_per_op) { std::printf("  [bench] %s: %.1f ns/op\n", name, ns_per_op); }
+
+void Consume(unsigned long long value) {
+    static volatile unsigned long long sink = 0;
+    sink = sink + value;
+}
+
+}  // namespace dc_test
+
+// Usage: <test binary> [name filter substring]
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int failed = 0;
+    int run = 0;
+    for (const dc_test::TestCase& test : dc_test::Registry()) {
+        if (filter != nullptr && std::strstr(test.name, filter) == nullptr) {
+            continue;
+        }
+        dc_test::g_current_failed = false;
+        std::printf("[ RUN  ] %s\n", test.name);
+        test.fn();
+        ++run;
+        if (dc_test::g_current_failed) {
+            ++failed;
+            std::printf("[ FAIL ] %s\n", test.name);
+        } else {
+            std::printf("[  OK  ] %s\n", test.name);
+        }
+    }
+    std::printf("%d / %d tests passed\n", run - failed, run);
+    return failed == 0 && run > 0 ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+// Source Code <Display Commander> // Incremental display snapshot tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "display/display_probe.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace display_cache;
+
+// What the OS reports for one monitor, the way WindowsDisplayProbeBackend condenses it.
+struct FakeMonitor {
+    std::wstring device_name;
+    uint64_t monitor_identity = 0;  // EDID / monitor device path of the connected monitor
+    int width = 0;
+    int height = 0;
+    uint32_t refresh_mhz = 0;
+    uint64_t handle = 0;  // HMONITOR: changes across hot-plug without the display changing
+    int work_bottom = 0;  // Work area (taskbar)
+};
+
+DisplayProbe ProbeOf(const FakeMonitor& m) {
+    DisplayProbe p;
+    p.device_name = m.device_name;
+    uint64_t h = FingerprintString(kFingerprintSeed, m.device_name);
+    h = FingerprintMix(h, m.monitor_identity);
+    h = FingerprintMix(h, (static_cast<uint64_t>(static_cast<uint32_t>(m.width)) << 32)
+                              | static_cast<uint32_t>(m.height));
+    p.fingerprint = FingerprintMix(h, m.refresh_mhz);
+    p.attributes = FingerprintMix(FingerprintMix(kFingerprintSeed, m.handle), static_cast<uint32_t>(m.work_bottom));
+    return p;
+}
+
+// Mock backend: returns the scripted monitor list, or fails when asked to.
+class ScriptedProbeBackend : public IDisplayProbeBackend {
+   public:
+    bool Probe(std::vector<DisplayProbe>& out) override {
+        out.clear();
+        if (fail) {
+            return false;
+        }
+        for (const FakeMonitor& m : monitors) {
+            out.push_back(ProbeOf(m));
+        }
+        return true;
+    }
+
+    std::vector<FakeMonitor> monitors;
+    bool fail = false;
+};
+
+struct FakeDisplayInfo {
+    std::wstring name;
+    uint64_t monitor_identity = 0;
+    int width = 0;
+    uint64_t handle = 0;
+    int work_bottom = 0;
+    int generation = 0;  // Full enumerations that produced this entry
+};
+
+using Snapshot = IncrementalDisplaySnapshot<FakeDisplayInfo>;
+
+// The display cache refresh on top of the mock: counts expensive builds and cheap updates.
+class FakeDisplayCache {
+   public:
+    explicit FakeDisplayCache(ScriptedProbeBackend* backend) : backend_(backend) {}
+
+    // Returns whether a new snapshot was published.
+    bool Refresh(bool force_all = false) {
+        std::vector<DisplayProbe> probes;
+        if (!backend_->Probe(probes)) {
+            return false;
+        }
+        auto next = BuildIncrementalDisplaySnapshot<FakeDisplayInfo>(
+            snapshot_.get(), probes, force_all,
+            [this](size_t i) -> std::shared_ptr<const FakeDisplayInfo> {
+                ++builds;
+                const FakeMonitor& m = backend_->monitors[i];
+                if (m.width == 0) {
+                    return nullptr;  // Enumeration failed: drop the display
+                }
+                auto info = std::make_shared<FakeDisplayInfo>();
+                info->name = m.device_name;
+                info->monitor_identity = m.monitor_identity;
+                info->width = m.width;
+                info->handle = m.handle;
+                info->work_bottom = m.work_bottom;
+                info->generation = builds;
+                return info;
+            },
+            [this](size_t i, const FakeDisplayInfo& previous) -> std::shared_ptr<const FakeDisplayInfo> {
+                ++updates;
+                auto info = std::make_shared<FakeDisplayInfo>(previous);
+                info->handle = backend_->monitors[i].handle;
+                info->work_bottom = backend_->monitors[i].work_bottom;
+                return info;
+            },
+            &last_diff);
+        if (next == nullptr) {
+            return false;
+        }
+        snapshot_ = std::move(next);
+        return true;
+    }
+
+    const Snapshot& Current() const { return *snapshot_; }
+    std::shared_ptr<const Snapshot> Shared() const { return snapshot_; }
+
+    int builds = 0;
+    int updates = 0;
+    DisplayDiffStats last_diff;
+
+   private:
+    ScriptedProbeBackend* backend_;
+    std::shared_ptr<const Snapshot> snapshot_;
+};
+
+std::vector<FakeMonitor> TwoMonitors() {
+    return {
+        {L"\\\\.\\DISPLAY1", 0xA1, 3840, 2160, 144000, 0x1001, 2100},
+        {L"\\\\.\\DISPLAY2", 0xB2, 2560, 1440, 60000, 0x1002, 1400},
+    };
+}
+
+DC_TEST(FirstRefreshEnumeratesEveryDisplay) {
+    ScriptedProbeBackend backend;
+    backend.monitors = TwoMonitors();
+    FakeDisplayCache cache(&backend);
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.builds, 2);
+    CHECK_EQ(cache.last_diff.added, 2u);
+    REQUIRE(cache.Current().entries.size() == 2);
+    CHECK(cache.Current().entries[1]->name == L"\\\\.\\DISPLAY2");
+}
+
+DC_TEST(UnchangedProbeKeepsPublishedSnapshot) {
+    ScriptedProbeBackend backend;
+    backend.monitors = TwoMonitors();
+    FakeDisplayCache cache(&backend);
+    cache.Refresh();
+    const std::shared_ptr<const Snapshot> before = cache.Shared();
+    CHECK(!cache.Refresh());
+    CHECK(cache.Shared() == before);
+    CHECK_EQ(cache.builds, 2);
+    CHECK_EQ(cache.last_diff.unchanged, 2u);
+}
+
+// Hot-plug of another device reissues monitor handles; name and mode are the same, so no re-enumeration.
+DC_TEST(NewHandleOnlyUpdatesEntry) {
+    ScriptedProbeBackend backend;
+    backend.monitors = TwoMonitors();
+    FakeDisplayCache cache(&backend);
+    cache.Refresh();
+    const std::shared_ptr<const FakeDisplayInfo> second = cache.Current().entries[1];
+
+    backend.monitors[0].handle = 0x2001;
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.builds, 2);
+    CHECK_EQ(cache.updates, 1);
+    CHECK_EQ(cache.last_diff.updated, 1u);
+    CHECK_EQ(cache.Current().entries[0]->handle, 0x2001u);
+    CHECK_EQ(cache.Current().entries[0]->generation, 1);  // Mode list etc. carried over
+    CHECK(cache.Current().entries[1] == second);           // Untouched display shares its entry
+
+    backend.monitors[1].work_bottom = 1380;  // Taskbar resized
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.builds, 2);
+    CHECK_EQ(cache.Current().entries[1]->work_bottom, 1380);
+}
+
+DC_TEST(ModeChangeReenumeratesOnlyThatDisplay) {
+    ScriptedProbeBackend backend;
+    backend.monitors = TwoMonitors();
+    FakeDisplayCache cache(&backend);
+    cache.Refresh();
+    const std::shared_ptr<const FakeDisplayInfo> first = cache.Current().entries[0];
+
+    backend.monitors[1].refresh_mhz = 59940;
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.builds, 3);
+    CHECK_EQ(cache.last_diff.changed, 1u);
+    CHECK_EQ(cache.last_diff.unchanged, 1u);
+    CHECK(cache.Current().entries[0] == first);
+}
+
+// A different monitor on the same output with the same mode (DBT_DEVNODES_CHANGED after a cable swap).
+DC_TEST(SwappedMonitorWithSameModeIsReenumerated) {
+    ScriptedProbeBackend backend;
+    backend.monitors = TwoMonitors();
+    FakeDisplayCache cache(&backend);
+    cache.Refresh();
+
+    backend.monitors[0].monitor_identity = 0xC3;
+    backend.monitors[0].handle = 0x3001;
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.last_diff.changed, 1u);
+    CHECK_EQ(cache.updates, 0);
+    CHECK_EQ(cache.Current().entries[0]->monitor_identity, 0xC3u);
+}
+
+DC_TEST(HotPlugAddRemoveAndReorder) {
+    ScriptedProbeBackend backend;
+    backend.monitors = TwoMonitors();
+    FakeDisplayCache cache(&backend);
+    cache.Refresh();
+
+    backend.monitors.push_back({L"\\\\.\\DISPLAY3", 0xD4, 1920, 1080, 60000, 0x1003, 1040});
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.last_diff.added, 1u);
+    CHECK_EQ(cache.builds, 3);
+
+    backend.monitors.erase(backend.monitors.begin());
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.last_diff.removed, 1u);
+    CHECK_EQ(cache.builds, 3);
+    REQUIRE(cache.Current().entries.size() == 2);
+    CHECK(cache.Current().entries[0]->name == L"\\\\.\\DISPLAY2");
+
+    // Same displays in a different order: published, nothing rebuilt
+    std::swap(backend.monitors[0], backend.monitors[1]);
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.builds, 3);
+    CHECK(cache.Current().entries[0]->name == L"\\\\.\\DISPLAY3");
+}
+
+DC_TEST(ForceAllAndFailures) {
+    ScriptedProbeBackend backend;
+    backend.monitors = TwoMonitors();
+    FakeDisplayCache cache(&backend);
+    cache.Refresh();
+
+    CHECK(cache.Refresh(true));
+    CHECK_EQ(cache.builds, 4);
+
+    backend.fail = true;  // QueryDisplayConfig failed: keep the published snapshot
+    CHECK(!cache.Refresh());
+    CHECK_EQ(cache.Current().entries.size(), 2u);
+    backend.fail = false;
+
+    backend.monitors[1].width = 0;  // Enumeration of a changed display fails: it is dropped
+    CHECK(cache.Refresh());
+    CHECK_EQ(cache.Current().entries.size(), 1u);
+    CHECK_EQ(cache.Current().probes.size(), 1u);
+}
+
+DC_TEST(FingerprintIgnoresHandleButNotName) {
+    FakeMonitor a = TwoMonitors()[0];
+    FakeMonitor b = a;
+    b.handle = 0x9999;
+    CHECK_EQ(ProbeOf(a).fingerprint, ProbeOf(b).fingerprint);
+    CHECK(ProbeOf(a).attributes != ProbeOf(b).attributes);
+    b.device_name = L"\\\\.\\DISPLAY7";
+    CHECK(ProbeOf(a).fingerprint != ProbeOf(b).fingerprint);
+    CHECK(FingerprintString(kFingerprintSeed, L"ab") != FingerprintString(kFingerprintSeed, L"ba"));
+}
+
+}  // namespace
@@ -0,0 +1,182 @@
+// Source Code <Display Commander> // GPU completion fence ring tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "hooks/dxgi/dxgi_gpu_completion_ring.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commanderhooks::dxgi;
+
+// Fake fence on a virtual clock: every signaled value completes at a scripted time. WaitSlot advances the clock to
+// the completion of the value armed for that slot, like the real waiter waking on the slot's event.
+class FakeFence : public IGpuCompletionFence {
+   public:
+    bool SignalAndArm(uint64_t value, size_t slot) override {
+        if (fail_next_signal) {
+            fail_next_signal = false;
+            return false;
+        }
+        signaled.push_back(value);
+        armed[slot] = value;
+        return true;
+    }
+
+    bool WaitSlot(size_t slot, uint32_t /*timeout_ms*/) override {
+        const int64_t done = CompletionTime(armed[slot]);
+        now_ns = (std::max)(now_ns, done);
+        return true;
+    }
+
+    uint64_t GetCompletedValue() override {
+        uint64_t completed = 0;
+        for (const uint64_t value : signaled) {
+            if (CompletionTime(value) <= now_ns) {
+                completed = value;
+            }
+        }
+        return completed;
+    }
+
+    int64_t CompletionTime(uint64_t value) const {
+        return value - 1 < completion_ns.size() ? completion_ns[value - 1] : INT64_MAX;
+    }
+
+    std::vector<int64_t> completion_ns;  // Completion time of fence value i + 1
+    std::vector<uint64_t> signaled;
+    uint64_t armed[kGpuCompletionRingSize] = {};
+    int64_t now_ns = 0;
+    bool fail_next_signal = false;
+};
+
+// One iteration of the waiter loop in dxgi_gpu_completion.cpp: wait on the oldest slot, stamp, retire one entry.
+void WaiterStep(GpuCompletionRing& ring, FakeFence& fence, std::vector<std::pair<uint64_t, int64_t>>* stamps) {
+    fence.WaitSlot(ring.OldestPendingSlot(), 100);
+    const int64_t now_ns = fence.now_ns;
+    ring.Retire(fence.GetCompletedValue(), 1, [&](uint64_t frame_id) { stamps->push_back({frame_id, now_ns}); });
+}
+
+DC_TEST(RetiresInOrderUpToCompletedValue) {
+    GpuCompletionRing ring;
+    FakeFence fence;
+    for (uint64_t frame = 100; frame < 105; ++frame) {
+        CHECK(ring.Enqueue(fence, frame) == GpuCompletionEnqueueResult::kOk);
+    }
+    CHECK_EQ(ring.InFlight(), 5u);
+    CHECK((fence.signaled == std::vector<uint64_t>{1, 2, 3, 4, 5}));
+
+    std::vector<uint64_t> retired;
+    CHECK_EQ(ring.Retire(3, 8, [&](uint64_t id) { retired.push_back(id); }), 3u);
+    CHECK((retired == std::vector<uint64_t>{100, 101, 102}));
+    CHECK_EQ(ring.Retire(3, 8, [&](uint64_t id) { retired.push_back(id); }), 0u);
+    CHECK_EQ(ring.Retire(5, 1, [&](uint64_t id) { retired.push_back(id); }), 1u);
+    CHECK_EQ(retired.back(), 103u);
+    CHECK_EQ(ring.InFlight(), 1u);
+    CHECK_EQ(ring.GetCounters().completed, 4u);
+}
+
+DC_TEST(FullRingDropsFrame) {
+    GpuCompletionRing ring;
+    FakeFence fence;
+    for (uint64_t frame = 0; frame < kGpuCompletionRingSize; ++frame) {
+        CHECK(ring.Enqueue(fence, frame) == GpuCompletionEnqueueResult::kOk);
+    }
+    CHECK(ring.Enqueue(fence, 99) == GpuCompletionEnqueueResult::kRingFull);
+    CHECK_EQ(ring.GetCounters().dropped_ring_full, 1u);
+    CHECK_EQ(fence.signaled.size(), kGpuCompletionRingSize);
+
+    ring.Retire(1, 8, [](uint64_t) {});
+    CHECK(ring.Enqueue(fence, 100) == GpuCompletionEnqueueResult::kOk);
+}
+
+DC_TEST(FailedSignalDoesNotConsumeFenceValue) {
+    GpuCompletionRing ring;
+    FakeFence fence;
+    CHECK(ring.Enqueue(fence, 1) == GpuCompletionEnqueueResult::kOk);
+    fence.fail_next_signal = true;
+    CHECK(ring.Enqueue(fence, 2) == GpuCompletionEnqueueResult::kSignalFailed);
+    CHECK(ring.Enqueue(fence, 3) == GpuCompletionEnqueueResult::kOk);
+    CHECK((fence.signaled == std::vector<uint64_t>{1, 2}));
+    CHECK_EQ(ring.GetCounters().signal_failures, 1u);
+
+    std::vector<uint64_t> retired;
+    ring.Retire(2, 8, [&](uint64_t id) { retired.push_back(id); });
+    CHECK((retired == std::vector<uint64_t>{1, 3}));
+}
+
+// The waiter fell behind: three frames completed at 10, 20 and 30 ms before it looked. Each frame keeps its own
+// observed time instead of all three getting the time of one batch.
+DC_TEST(EachFrameStampedFromItsOwnSignal) {
+    GpuCompletionRing ring;
+    FakeFence fence;
+    fence.completion_ns = {10, 20, 30, 45};
+    for (uint64_t frame = 1; frame <= 4; ++frame) {
+        ring.Enqueue(fence, frame);
+    }
+    std::vector<std::pair<uint64_t, int64_t>> stamps;
+    while (ring.HasPending()) {
+        WaiterStep(ring, fence, &stamps);
+    }
+    REQUIRE(stamps.size() == 4);
+    CHECK((stamps[0] == std::pair<uint64_t, int64_t>{1, 10}));
+    CHECK((stamps[1] == std::pair<uint64_t, int64_t>{2, 20}));
+    CHECK((stamps[2] == std::pair<uint64_t, int64_t>{3, 30}));
+    CHECK((stamps[3] == std::pair<uint64_t, int64_t>{4, 45}));
+}
+
+// Present thread and waiter on real threads: every enqueued frame is retired exactly once and in order.
+DC_TEST(ProducerConsumerThreads) {
+    class CounterFence : public IGpuCompletionFence {
+       public:
+        bool SignalAndArm(uint64_t value, size_t) override {
+            signaled.store(value, std::memory_order_release);
+            return true;
+        }
+        bool WaitSlot(size_t, uint32_t) override {
+            std::this_thread::yield();
+            return true;
+        }
+        uint64_t GetCompletedValue() override { return signaled.load(std::memory_order_acquire); }
+        std::atomic<uint64_t> signaled{0};
+    };
+
+    constexpr uint64_t kFrames = 200000;
+    GpuCompletionRing ring;
+    CounterFence fence;
+    std::atomic<bool> done{false};
+    std::vector<uint64_t> retired;
+    retired.reserve(kFrames);
+    std::thread waiter([&] {
+        while (!done.load(std::memory_order_acquire) || ring.HasPending()) {
+            if (!ring.HasPending()) {
+                std::this_thread::yield();
+                continue;
+            }
+            fence.WaitSlot(ring.OldestPendingSlot(), 0);
+            ring.Retire(fence.GetCompletedValue(), 1, [&](uint64_t id) { retired.push_back(id); });
+        }
+    });
+    uint64_t accepted = 0;
+    for (uint64_t frame = 0; frame < kFrames; ++frame) {
+        if (ring.Enqueue(fence, frame) == GpuCompletionEnqueueResult::kOk) {
+            ++accepted;
+        }
+    }
+    done.store(true, std::memory_order_release);
+    waiter.join();
+
+    CHECK_EQ(retired.size(), accepted);
+    CHECK(std::is_sorted(retired.begin(), retired.end()));
+    CHECK(std::adjacent_find(retired.begin(), retired.end()) == retired.end());
+    const GpuCompletionRing::Counters c = ring.GetCounters();
+    CHECK_EQ(c.enqueued, accepted);
+    CHECK_EQ(c.completed, accepted);
+    CHECK_EQ(c.enqueued + c.dropped_ring_full, kFrames);
+}
+
+}  // namespace
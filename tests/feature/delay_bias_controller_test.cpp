@@ -0,0 +1,207 @@
+// Source Code <Display Commander> // Adaptive delay_bias controller tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/adaptive_delay_bias/delay_bias_controller.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace {
+
+using namespace display_commander::feature::adaptive_delay_bias;
+
+constexpr int64_t kMs = 1000000;
+constexpr int64_t kUs = 1000;
+constexpr int64_t kFrameTime = 10 * kMs;  // 100 FPS limit
+constexpr int kFramesPerSecond = 100;
+
+// Limiter loop with a simulated game. Each frame's CPU work is base + uniform 0 .. jitter. A higher bias moves
+// limiter sleep after present, which leaves less of the frame time to absorb that work: the frame is late when
+// work + bias * bias_cost_ns exceeds the frame time. A late frame starts the next one when it finished.
+struct SimulatedGame {
+    int64_t base_work_ns = 4 * kMs;
+    int64_t work_jitter_ns = 4 * kMs;
+    int64_t bias_cost_ns = 6 * kMs;
+    int64_t spike_ns = 0;  // Added to every frame while set (load spike)
+    int64_t now_ns = 1000 * kMs;
+    uint32_t rng = 12345;
+    uint64_t late_frames = 0;
+    uint64_t frames = 0;
+
+    int64_t Jitter() {
+        rng = rng * 1664525u + 1013904223u;
+        return static_cast<int64_t>((rng >> 8) % static_cast<uint32_t>(work_jitter_ns + 1));
+    }
+
+    // Runs `count` frames; returns the bias after the last one
+    double Run(DelayBiasController& controller, int count) {
+        for (int i = 0; i < count; ++i) {
+            const int64_t work_ns = base_work_ns + (work_jitter_ns > 0 ? Jitter() : 0) + spike_ns;
+            const double bias = controller.GetOutput();
+            const int64_t busy_ns = work_ns + static_cast<int64_t>(bias * static_cast<double>(bias_cost_ns));
+            const bool late = busy_ns > kFrameTime;
+            now_ns += late ? busy_ns : kFrameTime;
+            late_frames += late ? 1 : 0;
+            ++frames;
+            controller.Update(DelayBiasFrameSample{now_ns, kFrameTime, late});
+        }
+        return controller.GetOutput();
+    }
+
+    double LatePercentSince(uint64_t late_before, uint64_t frames_before) const {
+        return 100.0 * static_cast<double>(late_frames - late_before) / static_cast<double>(frames - frames_before);
+    }
+};
+
+DelayBiasController MakeController(DelayBiasControlTarget target, double setpoint, double initial_bias) {
+    DelayBiasController controller;
+    controller.SetConfig(DelayBiasControllerConfig{target, setpoint, 0.0, 1.0});
+    controller.Reset(initial_bias);
+    return controller;
+}
+
+DC_TEST(CalmLoadRaisesBiasToTheMaximum) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kLateFramePercent, 2.0, 0.0);
+    SimulatedGame game;
+    game.work_jitter_ns = 0;
+    double bias = game.Run(controller, kFramesPerSecond);
+    CHECK(bias > 0.2);
+    bias = game.Run(controller, 5 * kFramesPerSecond);
+    CHECK_EQ(bias, 1.0);
+    CHECK(controller.GetState().saturated);
+    CHECK_EQ(game.late_frames, 0u);
+}
+
+DC_TEST(SettlesWhereLateFramesMeetTheSetpoint) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kLateFramePercent, 2.0, 0.5);
+    SimulatedGame game;
+    game.Run(controller, 30 * kFramesPerSecond);
+    const uint64_t late_before = game.late_frames;
+    const uint64_t frames_before = game.frames;
+    double bias_sum = 0.0;
+    for (int s = 0; s < 60; ++s) {
+        bias_sum += game.Run(controller, kFramesPerSecond);
+    }
+    // Late when 6 ms * bias > 6 ms - jitter: 2 % late frames at bias ~0.35
+    const double late_pct = game.LatePercentSince(late_before, frames_before);
+    CHECK(late_pct > 1.0);
+    CHECK(late_pct < 3.5);
+    CHECK_NEAR(bias_sum / 60.0, 0.35, 0.05);
+    CHECK(!controller.GetState().saturated);
+}
+
+DC_TEST(LoadSpikeBacksOffAndRecovers) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kLateFramePercent, 2.0, 0.5);
+    SimulatedGame game;
+    const double settled = game.Run(controller, 30 * kFramesPerSecond);
+
+    // 1.5 ms more work per frame for two seconds: the bias drops toward ~0.1
+    game.spike_ns = 1500 * kUs;
+    const uint64_t late_before = game.late_frames;
+    const double during = game.Run(controller, kFramesPerSecond / 4);
+    CHECK(during < settled - 0.1);
+    CHECK(game.late_frames > late_before);
+    CHECK(game.late_frames - late_before <= 5u);  // A few late frames are enough to back off
+    const double spike_bias = game.Run(controller, 2 * kFramesPerSecond);
+    CHECK_NEAR(spike_bias, 0.1, 0.06);
+
+    // Load back to normal: the bias climbs back to where it settled before
+    game.spike_ns = 0;
+    game.Run(controller, 30 * kFramesPerSecond);
+    double bias_sum = 0.0;
+    for (int s = 0; s < 20; ++s) {
+        bias_sum += game.Run(controller, kFramesPerSecond);
+    }
+    CHECK_NEAR(bias_sum / 20.0, settled, 0.1);
+}
+
+DC_TEST(SaturatedOutputDoesNotWindUp) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kLateFramePercent, 2.0, 0.0);
+    SimulatedGame game;
+    game.work_jitter_ns = 0;
+    game.Run(controller, 120 * kFramesPerSecond);
+    CHECK_EQ(controller.GetOutput(), 1.0);
+    CHECK(controller.GetState().integral < 1.0 + DelayBiasController::kProportionalGain * 3.0 + 1e-9);
+
+    // Every frame late from now on: the bias leaves the bound within a few frames, not after minutes of unwinding
+    game.spike_ns = 10 * kMs;
+    game.Run(controller, 5);
+    CHECK(controller.GetOutput() < 0.6);
+    game.Run(controller, kFramesPerSecond);
+    CHECK_EQ(controller.GetOutput(), 0.0);
+}
+
+DC_TEST(FrameTimeDeviationTargetReactsToSpikes) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kFrameTimeDeviation, 0.5, 0.5);
+    SimulatedGame game;
+    game.work_jitter_ns = 0;
+    CHECK_EQ(game.Run(controller, 10 * kFramesPerSecond), 1.0);
+    CHECK(controller.GetState().measurement < 0.01);
+
+    // A 20 ms hitch every half second: frame start spacing deviates, the bias comes down
+    for (int i = 0; i < 20; ++i) {
+        game.Run(controller, kFramesPerSecond / 2 - 1);
+        game.spike_ns = 20 * kMs;
+        game.Run(controller, 1);
+        game.spike_ns = 0;
+    }
+    const DelayBiasControllerState state = controller.GetState();
+    CHECK(state.measurement > 0.5);
+    CHECK(state.output < 0.5);
+}
+
+DC_TEST(PausesAreNotMeasured) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kFrameTimeDeviation, 0.5, 0.3);
+    int64_t now_ns = 1000 * kMs;
+    controller.Update(DelayBiasFrameSample{now_ns, kFrameTime, false});
+    now_ns += kFrameTime;
+    controller.Update(DelayBiasFrameSample{now_ns, kFrameTime, false});
+    const DelayBiasControllerState before = controller.GetState();
+    CHECK_EQ(before.frames, 1u);
+
+    // Loading screen: 2 s gap, then a late frame; neither moves the controller
+    now_ns += 2000 * kMs;
+    CHECK_EQ(controller.Update(DelayBiasFrameSample{now_ns, kFrameTime, true}), before.output);
+    CHECK_EQ(controller.GetState().frames, 1u);
+    CHECK_EQ(controller.GetState().measurement, before.measurement);
+    // Invalid frame time
+    now_ns += kFrameTime;
+    controller.Update(DelayBiasFrameSample{now_ns, 0, true});
+    CHECK_EQ(controller.GetState().frames, 1u);
+}
+
+DC_TEST(ResetIsBumplessAndConfigChangesKeepTheOutput) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kLateFramePercent, 2.0, 0.4);
+    CHECK_EQ(controller.GetOutput(), 0.4);
+    CHECK_EQ(controller.GetState().integral, 0.4);
+    SimulatedGame game;
+    game.Run(controller, 10 * kFramesPerSecond);
+    const double output = controller.GetOutput();
+
+    // Same target: integral and measurement kept
+    const double measurement = controller.GetState().measurement;
+    controller.SetConfig(DelayBiasControllerConfig{DelayBiasControlTarget::kLateFramePercent, 5.0, 0.0, 1.0});
+    CHECK_EQ(controller.GetOutput(), output);
+    CHECK_EQ(controller.GetState().measurement, measurement);
+    CHECK_EQ(controller.GetState().setpoint, 5.0);
+
+    // Other target: measurement restarts; a narrower range clamps the output
+    controller.SetConfig(DelayBiasControllerConfig{DelayBiasControlTarget::kFrameTimeDeviation, 0.5, 0.0, 0.1});
+    CHECK_EQ(controller.GetState().measurement, 0.0);
+    CHECK(controller.GetOutput() <= 0.1);
+    controller.Reset(0.9);
+    CHECK_EQ(controller.GetOutput(), 0.1);
+    CHECK_EQ(controller.GetState().frames, 0u);
+}
+
+DC_TEST(UpdateBenchmark) {
+    DelayBiasController controller = MakeController(DelayBiasControlTarget::kFrameTimeDeviation, 0.5, 0.5);
+    int64_t now_ns = 1000 * kMs;
+    const double ns = dc_test::MeasureNsPerOp(1000000, [&](size_t i) {
+        now_ns += kFrameTime + static_cast<int64_t>(i % 7) * 100 * kUs;
+        controller.Update(DelayBiasFrameSample{now_ns, kFrameTime, (i % 50) == 0});
+    });
+    dc_test::Consume(static_cast<unsigned long long>(controller.GetOutput() * 1000.0));
+    dc_test::ReportBenchmark("DelayBiasController::Update", ns);
+}
+
+}  // namespace
@@ -0,0 +1,165 @@
+// Source Code <Display Commander> // Frame generation pacing model tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/fg_pacing/fg_pacing_model.hpp"
+#include "feature/fg_pattern_sim.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace {
+
+using namespace display_commander::feature::fg_pacing;
+
+constexpr int64_t kMs = 1000000;
+constexpr int kFgModeActiveUnknown = -1;
+
+// Real frames every real_interval_ns with `multiplier` evenly spaced outputs each, real frame reported marker_lag
+// frames late
+void FeedEven(FgPacingModel& model, int frames, int multiplier, int64_t real_interval_ns, int marker_lag = 0,
+              int64_t start_ns = 1000 * kMs) {
+    for (int f = 0; f < frames + marker_lag; ++f) {
+        if (f < frames) {
+            const int64_t real_ns = start_ns + f * real_interval_ns;
+            for (int i = 0; i < multiplier; ++i) {
+                model.AddOutputPresent(real_ns + 1 * kMs + i * real_interval_ns / multiplier);
+            }
+        }
+        if (f >= marker_lag) {
+            model.AddRealFrame(start_ns + (f - marker_lag) * real_interval_ns);
+        }
+    }
+}
+
+DC_TEST(EvenStreamLocksOnItsMultiplier) {
+    for (int multiplier = 1; multiplier <= 4; ++multiplier) {
+        FgPacingModel model;
+        FeedEven(model, 200, multiplier, 12 * kMs);
+        const FgPacingStats& stats = model.GetStats();
+        CHECK(stats.valid);
+        CHECK_EQ(stats.locked_multiplier, multiplier);
+        CHECK_NEAR(stats.observed_multiplier, multiplier, 1e-9);
+        CHECK_NEAR(stats.real_interval_ms, 12.0, 1e-6);
+        CHECK_NEAR(stats.output_interval_ms, 12.0 / multiplier, 1e-3);
+        CHECK(stats.output_pacing_error_ms < 0.01);
+        CHECK_EQ(stats.irregular_pct, 0.0);
+        CHECK_EQ(stats.real_frames, 200u);
+        CHECK_EQ(stats.unattributed_frames, 0u);
+    }
+}
+
+DC_TEST(LateRealFramesAreStillAttributed) {
+    FgPacingModel model;
+    FeedEven(model, 200, 3, 12 * kMs, 5);
+    CHECK_EQ(model.GetStats().locked_multiplier, 3);
+    CHECK_EQ(model.GetStats().unattributed_frames, 0u);
+}
+
+DC_TEST(TooFewFramesDoNotLock) {
+    FgPacingModel model;
+    FeedEven(model, static_cast<int>(FgPacingModel::kMinValidFrames) - 1, 2, 12 * kMs);
+    CHECK(!model.GetStats().valid);
+    CHECK_EQ(model.GetStats().locked_multiplier, 0);
+}
+
+DC_TEST(PauseRestartsAttribution) {
+    FgPacingModel model;
+    FeedEven(model, 100, 2, 10 * kMs);
+    const uint64_t outputs = model.GetStats().output_presents;
+    // Loading screen: one second without frames, then 3x; the gap is not one huge real interval
+    FeedEven(model, 200, 3, 10 * kMs, 0, 3000 * kMs);
+    const FgPacingStats& stats = model.GetStats();
+    CHECK_EQ(stats.locked_multiplier, 3);
+    CHECK_NEAR(stats.real_interval_ms, 10.0, 1e-6);
+    CHECK_EQ(stats.output_presents, outputs + 600);
+}
+
+DC_TEST(OutOfOrderInputIsCountedNotAttributed) {
+    FgPacingModel model;
+    FeedEven(model, 50, 2, 10 * kMs);
+    model.AddRealFrame(1000 * kMs);  // Older than the last real frame
+    CHECK_EQ(model.GetStats().unattributed_frames, 1u);
+    const uint64_t outputs = model.GetStats().output_presents;
+    model.AddOutputPresent(1000 * kMs);  // Older than the last output: another swap chain racing
+    CHECK_EQ(model.GetStats().output_presents, outputs);
+}
+
+DC_TEST(ResolveMultiplierPrefersTheLockedModel) {
+    FgPacingStats stats;
+    CHECK_EQ(ResolveFgMultiplier(stats, 0), 1);
+    CHECK_EQ(ResolveFgMultiplier(stats, kFgModeActiveUnknown), 1);
+    CHECK_EQ(ResolveFgMultiplier(stats, 3), 3);
+    stats.locked_multiplier = 4;
+    CHECK_EQ(ResolveFgMultiplier(stats, 0), 1);  // FG off: never divide
+    CHECK_EQ(ResolveFgMultiplier(stats, kFgModeActiveUnknown), 4);
+    CHECK_EQ(ResolveFgMultiplier(stats, 2), 4);
+}
+
+FgPatternSimConfig SimConfig(FgPresentPattern pattern, int multiplier) {
+    FgPatternSimConfig config;
+    config.pattern = pattern;
+    config.multiplier = multiplier;
+    config.reported_fg_mode = kFgModeActiveUnknown;
+    config.generated_drop_rate = 0.02;
+    return config;
+}
+
+DC_TEST(SimulatedPatternsLockAndHoldTheOutputTarget) {
+    const FgPresentPattern patterns[] = {FgPresentPattern::kEven, FgPresentPattern::kBurst,
+                                         FgPresentPattern::kAlternating};
+    for (FgPresentPattern pattern : patterns) {
+        for (int multiplier = 2; multiplier <= 4; ++multiplier) {
+            const FgPatternSimResult result = RunFgPatternSim(SimConfig(pattern, multiplier));
+            CHECK_EQ(result.stats.locked_multiplier, multiplier);
+            CHECK_EQ(result.final_multiplier, multiplier);
+            CHECK(result.lock_time_ms >= 0.0);
+            CHECK(result.lock_time_ms < 500.0);
+            // Includes the frames before the lock, paced as if FG was off
+            CHECK_NEAR(result.achieved_output_fps, 240.0, 25.0);
+            CHECK(result.stats.irregular_pct < FgPacingModel::kMaxIrregularPct);
+        }
+    }
+}
+
+DC_TEST(SimulatedPatternsShowInThePacingError) {
+    FgPatternSimConfig config = SimConfig(FgPresentPattern::kEven, 3);
+    config.generated_drop_rate = 0.0;
+    const double even_ms = RunFgPatternSim(config).stats.output_pacing_error_ms;
+    config.pattern = FgPresentPattern::kAlternating;
+    const double alternating_ms = RunFgPatternSim(config).stats.output_pacing_error_ms;
+    config.pattern = FgPresentPattern::kBurst;
+    const double burst_ms = RunFgPatternSim(config).stats.output_pacing_error_ms;
+    CHECK(even_ms < 0.5);
+    CHECK(alternating_ms > 2.0 * even_ms);
+    CHECK(burst_ms > 2.0 * alternating_ms);
+}
+
+DC_TEST(SimulatedFixedRuleFollowsTheReportedMode) {
+    // MultiFrameCount unknown without the model: the limiter paces outputs as real frames
+    FgPatternSimConfig config = SimConfig(FgPresentPattern::kEven, 3);
+    config.use_model = false;
+    FgPatternSimResult result = RunFgPatternSim(config);
+    CHECK_EQ(result.final_multiplier, 1);
+    CHECK_NEAR(result.achieved_output_fps, 3 * 240.0, 30.0);
+    // Reported 2x while the game runs 3x: the model corrects it once locked
+    config.use_model = true;
+    config.reported_fg_mode = 2;
+    result = RunFgPatternSim(config);
+    CHECK_EQ(result.final_multiplier, 3);
+    CHECK_NEAR(result.achieved_output_fps, 240.0, 10.0);
+}
+
+DC_TEST(AddPresentBenchmark) {
+    FgPacingModel model;
+    int64_t now_ns = 1000 * kMs;
+    const double ns = dc_test::MeasureNsPerOp(1000000, [&](size_t i) {
+        now_ns += 4 * kMs;
+        model.AddOutputPresent(now_ns);
+        if (i % 2 == 1) {
+            model.AddRealFrame(now_ns - 1 * kMs);
+        }
+    });
+    dc_test::Consume(model.GetStats().real_frames);
+    dc_test::ReportBenchmark("FgPacingModel::AddOutputPresent + AddRealFrame/2", ns);
+}
+
+}  // namespace
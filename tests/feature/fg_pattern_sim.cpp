@@ -0,0 +1,123 @@
+// Source Code <Display Commander> // FG present pattern simulator for tests (platform-neutral, no Windows includes)
+#include "fg_pattern_sim.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace display_commander::feature::fg_pacing {
+
+namespace {
+
+constexpr int64_t kBurstGapNs = 500'000;
+
+struct SimEvent {
+    int64_t deliver_ns = 0;  // When the model sees it
+    int64_t time_ns = 0;     // Timestamp it carries
+    bool real = false;
+};
+
+class SimRandom {
+   public:
+    explicit SimRandom(uint32_t seed) : state_(seed != 0 ? seed : 1) {}
+
+    double Unit() {  // 0 .. 1
+        // xorshift32: deterministic runs for a given seed
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 17;
+        state_ ^= state_ << 5;
+        return static_cast<double>(state_) / 4294967295.0;
+    }
+    int64_t Symmetric(int64_t max_ns) {  // -max_ns .. max_ns
+        return static_cast<int64_t>(std::llround((Unit() * 2.0 - 1.0) * static_cast<double>(max_ns)));
+    }
+
+   private:
+    uint32_t state_;
+};
+
+}  // namespace
+
+const char* FgPresentPatternName(FgPresentPattern pattern) {
+    switch (pattern) {
+        case FgPresentPattern::kEven:        return "Even";
+        case FgPresentPattern::kBurst:       return "Burst";
+        case FgPresentPattern::kAlternating: return "Alternating";
+    }
+    return "?";
+}
+
+FgPatternSimResult RunFgPatternSim(const FgPatternSimConfig& config) {
+    FgPatternSimResult result;
+    FgPacingModel model;
+    SimRandom random(config.seed);
+    std::vector<SimEvent> queue;
+
+    const int multiplier = std::clamp(config.multiplier, 1, FgPacingModel::kMaxMultiplier);
+    const double target_fps = (std::max)(config.output_target_fps, 1.0);
+    const int64_t start_ns = 1'000'000'000;
+    const int64_t end_ns = start_ns + config.duration_ns;
+    int64_t real_ns = start_ns;
+    const int fixed_multiplier = config.reported_fg_mode >= 2 ? config.reported_fg_mode : 1;
+
+    while (real_ns < end_ns) {
+        // Deliver everything the model would have seen by now, in delivery order
+        std::stable_sort(queue.begin(), queue.end(),
+                         [](const SimEvent& a, const SimEvent& b) { return a.deliver_ns < b.deliver_ns; });
+        size_t delivered = 0;
+        while (delivered < queue.size() && queue[delivered].deliver_ns <= real_ns) {
+            const SimEvent& event = queue[delivered++];
+            if (event.real) {
+                model.AddRealFrame(event.time_ns);
+            } else {
+                model.AddOutputPresent(event.time_ns);
+            }
+        }
+        queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(delivered));
+        if (result.lock_time_ms < 0.0 && model.GetStats().locked_multiplier > 0) {
+            result.lock_time_ms = static_cast<double>(real_ns - start_ns) / 1'000'000.0;
+        }
+
+        // Limiter: real frame interval from the multiplier it believes in
+        const int limiter_multiplier =
+            config.use_model ? ResolveFgMultiplier(model.GetStats(), config.reported_fg_mode) : fixed_multiplier;
+        result.final_multiplier = limiter_multiplier;
+        const double real_interval_ns = 1'000'000'000.0 / (target_fps / limiter_multiplier);
+
+        // This real frame and the outputs it produces
+        ++result.real_frames;
+        const int64_t marker_lag_ns =
+            static_cast<int64_t>(std::llround(real_interval_ns * static_cast<double>(config.marker_lag_frames)));
+        queue.push_back({real_ns + marker_lag_ns, real_ns, true});
+        const bool late_frame = config.pattern == FgPresentPattern::kAlternating && (result.real_frames % 2) == 0;
+        const int64_t first_output_ns =
+            real_ns + config.present_latency_ns
+            + (late_frame ? static_cast<int64_t>(std::llround(real_interval_ns / (2.0 * multiplier))) : 0);
+        for (int i = 0; i < multiplier; ++i) {
+            const bool generated = i < multiplier - 1;  // Generated frames go out ahead of the real one
+            if (generated && random.Unit() < config.generated_drop_rate) {
+                ++result.dropped_generated;
+                continue;
+            }
+            int64_t output_ns = first_output_ns;
+            if (config.pattern == FgPresentPattern::kBurst) {
+                output_ns += i * kBurstGapNs;
+            } else {
+                output_ns += static_cast<int64_t>(std::llround(real_interval_ns * i / multiplier));
+            }
+            output_ns += random.Symmetric(config.output_jitter_ns);
+            queue.push_back({output_ns, output_ns, false});
+            ++result.output_presents;
+        }
+        real_ns += static_cast<int64_t>(std::llround(real_interval_ns)) + random.Symmetric(config.real_jitter_ns);
+    }
+
+    const double seconds = static_cast<double>(config.duration_ns) / 1'000'000'000.0;
+    result.achieved_output_fps = static_cast<double>(result.output_presents) / seconds;
+    result.achieved_real_fps = static_cast<double>(result.real_frames) / seconds;
+    result.stats = model.GetStats();
+    return result;
+}
+
+}  // namespace display_commander::feature::fg_pacing
@@ -0,0 +1,51 @@
+// Source Code <Display Commander> // FG present pattern simulator for tests (platform-neutral, no Windows includes)
+#pragma once
+
+#include "feature/fg_pacing/fg_pacing_model.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace display_commander::feature::fg_pacing {
+
+enum class FgPresentPattern : uint8_t {
+    kEven = 0,   // Outputs split the real frame interval evenly (frame pacing on)
+    kBurst,      // Generated frames presented back to back right after the real frame
+    kAlternating,  // Every other real frame presents its outputs late (uneven interleave)
+};
+
+const char* FgPresentPatternName(FgPresentPattern pattern);
+
+struct FgPatternSimConfig {
+    int multiplier = 2;         // True output presents per real frame (2x / 3x / 4x)
+    int reported_fg_mode = 2;   // What DLSSGSummaryLite reports (0 = off, -1 = active unknown, >= 2 = Nx)
+    bool use_model = true;      // Limiter divides by ResolveFgMultiplier(model) instead of the fixed rule
+    double output_target_fps = 240.0;  // FPS limit (output frames)
+    FgPresentPattern pattern = FgPresentPattern::kEven;
+    int64_t present_latency_ns = 3'000'000;  // Real frame (Present start marker) -> its first output
+    int64_t real_jitter_ns = 500'000;        // Real frame interval jitter, uniform +- jitter
+    int64_t output_jitter_ns = 200'000;      // Output present jitter, uniform +- jitter
+    double generated_drop_rate = 0.0;        // Share of generated frames never presented
+    uint32_t marker_lag_frames = 3;          // Real frames reach the model this many frames late (marker bus)
+    int64_t duration_ns = 10'000'000'000;
+    uint32_t seed = 1;
+};
+
+struct FgPatternSimResult {
+    uint64_t real_frames = 0;
+    uint64_t output_presents = 0;
+    uint64_t dropped_generated = 0;
+    double achieved_output_fps = 0.0;  // Output presents over the run
+    double achieved_real_fps = 0.0;
+    int final_multiplier = 0;          // What the limiter divided by at the end
+    double lock_time_ms = -1.0;        // Until the model first locked (-1 = never)
+    FgPacingStats stats;
+};
+
+// Drives FgPacingModel with a synthetic game + frame generation present stream while a limiter paces real frames at
+// output_target_fps / multiplier. With the model in use, achieved_output_fps should track the target whatever
+// reported_fg_mode says; stats.locked_multiplier should equal multiplier for even and alternating patterns, and the
+// burst pattern should show in output_pacing_error_ms.
+FgPatternSimResult RunFgPatternSim(const FgPatternSimConfig& config);
+
+}  // namespace display_commander::feature::fg_pacing
@@ -0,0 +1,183 @@
+// Source Code <Display Commander> // Foreground/background state machine tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/foreground/foreground_tracker.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::feature::foreground;
+
+constexpr int64_t kMs = 1000000;
+
+// One scripted report: the event as a source hands it to the tracker, and when it arrives.
+struct ScriptStep {
+    int64_t report_ns;
+    ForegroundEvent event;
+};
+
+ForegroundEvent Foreground(ForegroundEventSource source, bool ours, int64_t event_ns) {
+    ForegroundEvent e;
+    e.kind = ForegroundEventKind::kForeground;
+    e.source = source;
+    e.foreground_is_ours = ours;
+    e.event_time_ns = event_ns;
+    return e;
+}
+
+ForegroundEvent Poll(bool ours, bool minimized, int64_t now_ns) {
+    ForegroundEvent e = Foreground(ForegroundEventSource::kPoll, ours, now_ns);
+    e.minimized = minimized;
+    return e;
+}
+
+ForegroundEvent Minimize(ForegroundEventKind kind, bool ours, int64_t event_ns) {
+    ForegroundEvent e = Foreground(ForegroundEventSource::kWinEvent, ours, event_ns);
+    e.kind = kind;
+    return e;
+}
+
+// Replays the script and returns the background state after every step.
+std::vector<bool> Replay(ForegroundTracker& tracker, const std::vector<ScriptStep>& script) {
+    std::vector<bool> states;
+    for (const ScriptStep& step : script) {
+        tracker.OnEvent(step.event, step.report_ns);
+        states.push_back(tracker.InBackground());
+    }
+    return states;
+}
+
+DC_TEST(FirstEventEstablishesStateWithoutTransition) {
+    ForegroundTracker tracker;
+    CHECK(!tracker.IsKnown());
+    const ForegroundUpdate u = tracker.OnEvent(Poll(true, false, 10 * kMs), 10 * kMs);
+    CHECK(u.changed);
+    CHECK(!u.in_background);
+    CHECK(tracker.IsKnown());
+    CHECK_EQ(tracker.GetStats().transitions, 0u);
+}
+
+DC_TEST(AltTabRoundTripMeasuresLatency) {
+    ForegroundTracker tracker;
+    tracker.OnEvent(Poll(true, false, 0), 0);
+
+    ForegroundUpdate u =
+        tracker.OnEvent(Foreground(ForegroundEventSource::kWinEvent, false, 1000 * kMs), 1002 * kMs);
+    CHECK(u.changed);
+    CHECK(u.in_background);
+    CHECK_EQ(u.latency_ns, 2 * kMs);
+
+    // The game's own WM_ACTIVATEAPP for the same switch adds nothing
+    u = tracker.OnEvent(Foreground(ForegroundEventSource::kWindowProc, false, 1001 * kMs), 1003 * kMs);
+    CHECK(!u.changed);
+
+    u = tracker.OnEvent(Foreground(ForegroundEventSource::kWindowProc, true, 3000 * kMs), 3004 * kMs);
+    CHECK(u.changed);
+    CHECK(!u.in_background);
+
+    const ForegroundTrackerStats stats = tracker.GetStats();
+    CHECK_EQ(stats.transitions, 2u);
+    CHECK_EQ(stats.latency_samples, 2u);
+    CHECK_EQ(stats.max_latency_ns, 4 * kMs);
+    CHECK_EQ(stats.avg_latency_ns, 3 * kMs);
+    CHECK_EQ(stats.events[static_cast<size_t>(ForegroundEventSource::kWinEvent)], 1u);
+    CHECK_EQ(stats.events[static_cast<size_t>(ForegroundEventSource::kWindowProc)], 2u);
+}
+
+DC_TEST(MinimizedWindowStaysBackgroundWhileOwningForeground) {
+    ForegroundTracker tracker;
+    tracker.OnEvent(Poll(true, false, 0), 0);
+    // Minimize animation: the window still owns the foreground
+    CHECK(tracker.OnEvent(Minimize(ForegroundEventKind::kMinimizeStart, true, 100 * kMs), 100 * kMs).in_background);
+    CHECK(tracker.IsMinimized());
+    CHECK(tracker.OnEvent(Foreground(ForegroundEventSource::kWindowProc, true, 110 * kMs), 110 * kMs).in_background);
+    const ForegroundUpdate restored =
+        tracker.OnEvent(Minimize(ForegroundEventKind::kMinimizeEnd, true, 2000 * kMs), 2000 * kMs);
+    CHECK(restored.changed);
+    CHECK(!restored.in_background);
+    CHECK(!tracker.IsMinimized());
+}
+
+// IsIconic is still false while the minimize animation runs: a poll right after the push must not undo it.
+DC_TEST(PollWithinGraceIsDeferred) {
+    ForegroundTracker tracker;
+    tracker.OnEvent(Poll(true, false, 0), 0);
+    tracker.OnEvent(Minimize(ForegroundEventKind::kMinimizeStart, true, 1000 * kMs), 1000 * kMs);
+
+    ForegroundUpdate u = tracker.OnEvent(Poll(true, false, 1100 * kMs), 1100 * kMs);
+    CHECK(!u.changed);
+    CHECK(u.in_background);
+    CHECK_EQ(tracker.GetStats().deferred_polls, 1u);
+
+    // After the grace period the poll is authoritative again (e.g. the restore event was lost)
+    const int64_t after_grace_ns = 1000 * kMs + ForegroundTracker::kPollGraceNs;
+    u = tracker.OnEvent(Poll(true, false, after_grace_ns), after_grace_ns);
+    CHECK(u.changed);
+    CHECK(!u.in_background);
+    CHECK_EQ(u.latency_ns, 0);
+    CHECK_EQ(tracker.GetStats().poll_corrections, 1u);
+    CHECK_EQ(tracker.GetStats().latency_samples, 1u);  // Only the pushed minimize
+}
+
+DC_TEST(StaleEventFromSlowerReporterIsDropped) {
+    ForegroundTracker tracker;
+    tracker.OnEvent(Poll(true, false, 0), 0);
+    tracker.OnEvent(Foreground(ForegroundEventSource::kWinEvent, false, 2000 * kMs), 2001 * kMs);
+    // Window proc thread reports an older activation after the WinEvent hook already applied a newer one
+    const ForegroundUpdate u =
+        tracker.OnEvent(Foreground(ForegroundEventSource::kWindowProc, true, 1500 * kMs), 2002 * kMs);
+    CHECK(!u.changed);
+    CHECK(tracker.InBackground());
+    CHECK_EQ(tracker.GetStats().stale_events, 1u);
+}
+
+DC_TEST(PollOnlyCorrectsMissedEvents) {
+    ForegroundTracker tracker;
+    const std::vector<ScriptStep> script = {
+        {0, Poll(true, false, 0)},
+        {500 * kMs, Poll(false, false, 500 * kMs)},
+        {1000 * kMs, Poll(true, true, 1000 * kMs)},  // Minimized but foreground: still background
+        {1500 * kMs, Poll(true, false, 1500 * kMs)},
+    };
+    CHECK((Replay(tracker, script) == std::vector<bool>{false, true, true, false}));
+    const ForegroundTrackerStats stats = tracker.GetStats();
+    CHECK_EQ(stats.transitions, 2u);
+    CHECK_EQ(stats.poll_corrections, 2u);
+}
+
+// A mixed session from all three sources; replaying the same script reproduces the same states and statistics.
+DC_TEST(ScriptedSessionIsDeterministic) {
+    const std::vector<ScriptStep> script = {
+        {0, Poll(true, false, 0)},
+        {1001 * kMs, Foreground(ForegroundEventSource::kWinEvent, false, 1000 * kMs)},
+        {1002 * kMs, Foreground(ForegroundEventSource::kWindowProc, false, 1000 * kMs)},
+        {1100 * kMs, Poll(true, false, 1100 * kMs)},  // Deferred: racing the push
+        {1500 * kMs, Poll(false, false, 1500 * kMs)},
+        {4003 * kMs, Foreground(ForegroundEventSource::kWindowProc, true, 4000 * kMs)},
+        {4004 * kMs, Foreground(ForegroundEventSource::kWinEvent, false, 3999 * kMs)},  // Stale
+        {6000 * kMs, Minimize(ForegroundEventKind::kMinimizeStart, true, 6000 * kMs)},
+        {6100 * kMs, Poll(true, false, 6100 * kMs)},  // Deferred
+        {9002 * kMs, Minimize(ForegroundEventKind::kMinimizeEnd, true, 9000 * kMs)},
+    };
+    const std::vector<bool> expected = {false, true, true, true, true, false, false, true, true, false};
+
+    ForegroundTracker first;
+    ForegroundTracker second;
+    CHECK((Replay(first, script) == expected));
+    CHECK((Replay(second, script) == expected));
+
+    const ForegroundTrackerStats a = first.GetStats();
+    const ForegroundTrackerStats b = second.GetStats();
+    CHECK_EQ(a.transitions, 4u);
+    CHECK_EQ(a.deferred_polls, 2u);
+    CHECK_EQ(a.stale_events, 1u);
+    CHECK_EQ(a.poll_corrections, 0u);
+    CHECK_EQ(a.max_latency_ns, 3 * kMs);
+    CHECK_EQ(a.transitions, b.transitions);
+    CHECK_EQ(a.avg_latency_ns, b.avg_latency_ns);
+    CHECK_EQ(a.max_latency_ns, b.max_latency_ns);
+}
+
+}  // namespace
@@ -0,0 +1,179 @@
+// Source Code <Display Commander> // CPU/GPU bound analyzer tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/frame_bound/frame_bound_analyzer.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::feature::frame_bound;
+
+constexpr int64_t kMs = 1000000;
+
+// Synthetic render pipeline: the CPU simulates / submits a frame in cpu_ns, the FPS limiter sleeps sleep_ns before
+// Present, the GPU starts a frame once the previous one is done and submission began, and Present blocks while
+// max_queue frames are still on the GPU.
+struct PipelineSim {
+    int64_t cpu_ns = 0;
+    int64_t gpu_ns = 0;
+    int64_t sleep_ns = 0;
+    int max_queue = 2;
+    bool gpu_timestamps = true;
+
+    std::vector<FrameTimeline> Run(int frames) const {
+        std::vector<FrameTimeline> out;
+        std::vector<int64_t> gpu_done;
+        int64_t t = 1000 * kMs;
+        int64_t gpu_free = 0;
+        for (int n = 0; n < frames; ++n) {
+            FrameTimeline f;
+            f.frame_id = static_cast<uint64_t>(n + 1);
+            f.sim_start_ns = t;
+            f.submit_start_ns = t + cpu_ns / 2;
+            f.present_start_ns = t + cpu_ns + sleep_ns;
+            int64_t present_end = f.present_start_ns + kMs / 10;
+            if (n >= max_queue) {
+                present_end = std::max(present_end, gpu_done[static_cast<size_t>(n - max_queue)]);
+            }
+            f.present_end_ns = present_end;
+            const int64_t gpu_start = std::max(gpu_free, f.submit_start_ns);
+            gpu_free = gpu_start + gpu_ns;
+            gpu_done.push_back(gpu_free);
+            f.gpu_done_ns = gpu_timestamps ? gpu_free : 0;
+            f.limiter_sleep_ns = sleep_ns;
+            out.push_back(f);
+            t = present_end;
+        }
+        return out;
+    }
+};
+
+BoundAnalysis Analyze(const PipelineSim& sim, int frames) {
+    FrameBoundAnalyzer analyzer;
+    for (const FrameTimeline& f : sim.Run(frames)) {
+        analyzer.AddFrame(f);
+    }
+    return analyzer.GetAnalysis();
+}
+
+DC_TEST(CpuBoundTimeline) {
+    const BoundAnalysis a = Analyze({10 * kMs, 4 * kMs, 0}, 200);
+    CHECK(a.state == BoundState::kCpuBound);
+    CHECK(a.confidence >= 0.9f);
+    CHECK_NEAR(a.frame_time_ms, 10.1, 0.05);
+    CHECK_NEAR(a.gpu_busy_ms, 4.0, 0.05);
+    CHECK(a.cpu_utilization > 0.95);
+    CHECK(a.queue_depth < 0.5);
+    CHECK_NEAR(a.overlap_ms, 0.0, 1e-9);  // GPU idles before the next frame starts
+}
+
+DC_TEST(GpuBoundTimelineQueuesFrames) {
+    const BoundAnalysis a = Analyze({5 * kMs, 12 * kMs, 0}, 200);
+    CHECK(a.state == BoundState::kGpuBound);
+    CHECK(a.confidence >= 0.9f);
+    CHECK_NEAR(a.frame_time_ms, 12.0, 0.05);
+    CHECK(a.gpu_utilization > 0.95);
+    CHECK(a.queue_depth >= 1.0);
+}
+
+DC_TEST(SingleFrameQueueOverlapsCpuWithPreviousGpuFrame) {
+    PipelineSim sim{5 * kMs, 12 * kMs, 0};
+    sim.max_queue = 1;
+    const BoundAnalysis a = Analyze(sim, 200);
+    CHECK(a.state == BoundState::kGpuBound);
+    CHECK_NEAR(a.overlap_ms, 5.0, 0.05);  // Whole CPU frame runs while the GPU renders frame n-1
+}
+
+DC_TEST(LimiterBoundTimeline) {
+    const BoundAnalysis a = Analyze({4 * kMs, 4 * kMs, 10 * kMs}, 200);
+    CHECK(a.state == BoundState::kLimiterBound);
+    CHECK(a.confidence >= 0.9f);
+    CHECK(a.cpu_utilization < 0.5);
+}
+
+DC_TEST(WithoutGpuTimestampsPresentBlockingDecides) {
+    PipelineSim sim{5 * kMs, 12 * kMs, 0};
+    sim.gpu_timestamps = false;
+    const BoundAnalysis a = Analyze(sim, 200);
+    CHECK(a.state == BoundState::kGpuBound);
+    CHECK_EQ(a.gpu_samples, 0u);
+    // Present back-pressure alone halves the confidence
+    CHECK(a.confidence <= 0.5f);
+    CHECK(a.confidence >= 0.45f);
+}
+
+DC_TEST(ConfidenceRampsWithSamples) {
+    const BoundAnalysis few = Analyze({10 * kMs, 4 * kMs, 0}, 16);
+    const BoundAnalysis many = Analyze({10 * kMs, 4 * kMs, 0}, 200);
+    CHECK_EQ(few.samples, 15u);
+    CHECK_NEAR(few.confidence, 15.0 / FrameBoundAnalyzer::kFullConfidenceSamples, 1e-3);
+    CHECK_EQ(many.samples, static_cast<uint32_t>(FrameBoundAnalyzer::kWindowSize));
+}
+
+DC_TEST(FrameGapBreaksPairing) {
+    FrameBoundAnalyzer analyzer;
+    std::vector<FrameTimeline> frames = PipelineSim{10 * kMs, 4 * kMs, 0}.Run(10);
+    CHECK(!analyzer.AddFrame(frames[0]));
+    CHECK(analyzer.AddFrame(frames[1]));
+    CHECK(!analyzer.AddFrame(frames[3]));  // Frame 3 missing
+    FrameBoundSample sample;
+    CHECK(analyzer.AddFrame(frames[4], &sample));
+    CHECK_EQ(sample.frame_interval_ns, frames[4].present_start_ns - frames[3].present_start_ns);
+    CHECK_EQ(analyzer.GetAnalysis().samples, 2u);
+
+    analyzer.Reset();
+    CHECK_EQ(analyzer.GetAnalysis().samples, 0u);
+    CHECK(analyzer.GetAnalysis().state == BoundState::kUnknown);
+}
+
+DC_TEST(WindowFollowsWorkloadChange) {
+    FrameBoundAnalyzer analyzer;
+    std::vector<FrameTimeline> cpu = PipelineSim{10 * kMs, 4 * kMs, 0}.Run(200);
+    for (const FrameTimeline& f : cpu) {
+        analyzer.AddFrame(f);
+    }
+    CHECK(analyzer.GetAnalysis().state == BoundState::kCpuBound);
+    // Continue the same frame sequence with a GPU-heavy scene
+    std::vector<FrameTimeline> gpu = PipelineSim{5 * kMs, 12 * kMs, 0}.Run(200);
+    const int64_t shift = cpu.back().present_end_ns + kMs - gpu.front().sim_start_ns;
+    for (FrameTimeline f : gpu) {
+        f.frame_id += cpu.size();
+        f.sim_start_ns += shift;
+        f.submit_start_ns += shift;
+        f.present_start_ns += shift;
+        f.present_end_ns += shift;
+        f.gpu_done_ns += shift;
+        analyzer.AddFrame(f);
+    }
+    CHECK(analyzer.GetAnalysis().state == BoundState::kGpuBound);
+}
+
+DC_TEST(InjectedReflexSleepRecommendationHysteresis) {
+    BoundAnalysis a;
+    CHECK(RecommendInjectedReflexSleep(a, false));  // No data: default on
+
+    a.state = BoundState::kCpuBound;
+    a.queue_depth = 0.1;
+    a.confidence = 0.7f;
+    CHECK(RecommendInjectedReflexSleep(a, true));    // Not confident enough to turn off
+    CHECK(!RecommendInjectedReflexSleep(a, false));  // ...but enough to stay off
+    a.confidence = 0.9f;
+    CHECK(!RecommendInjectedReflexSleep(a, true));
+
+    a.queue_depth = 1.2;  // Frames queue up again
+    CHECK(RecommendInjectedReflexSleep(a, false));
+
+    a.state = BoundState::kGpuBound;
+    a.queue_depth = 2.0;
+    CHECK(RecommendInjectedReflexSleep(a, false));
+    CHECK(RecommendInjectedReflexSleep(a, true));
+
+    // Real timelines: CPU-bound turns the sleep off, GPU-bound turns it back on
+    CHECK(!RecommendInjectedReflexSleep(Analyze({10 * kMs, 4 * kMs, 0}, 200), true));
+    CHECK(RecommendInjectedReflexSleep(Analyze({5 * kMs, 12 * kMs, 0}, 200), false));
+}
+
+}  // namespace
@@ -0,0 +1,382 @@
+// Source Code <Display Commander> // Frame capture format, writer and converter tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/frame_capture/frame_capture_convert.hpp"
+#include "feature/frame_capture/frame_capture_format.hpp"
+#include "feature/frame_capture/frame_capture_writer.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::feature::frame_capture;
+
+constexpr int64_t kMs = 1000000;
+constexpr size_t kChunkBytes = 1024;  // 8 slots; the first chunk holds the header and 6
+constexpr uint64_t kSlotsPerChunk = kChunkBytes / sizeof(FrameCaptureRecord);
+
+// Stands in for the mapped views of the capture file: chunk k is file bytes [k * kChunkBytes, + kChunkBytes)
+struct ChunkedFile {
+    std::vector<std::vector<uint64_t>> chunks;
+
+    void* NewChunk() {
+        chunks.emplace_back(kChunkBytes / sizeof(uint64_t), 0);
+        return chunks.back().data();
+    }
+
+    // File image truncated to used_bytes, as the capture thread leaves it
+    std::vector<unsigned char> Image(size_t used_bytes) const {
+        std::vector<unsigned char> image(chunks.size() * kChunkBytes);
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            std::memcpy(image.data() + i * kChunkBytes, chunks[i].data(), kChunkBytes);
+        }
+        image.resize((std::min)(used_bytes, image.size()));
+        return image;
+    }
+};
+
+FrameCaptureHeader TestHeader() {
+    FrameCaptureHeader header;
+    header.start_ns = 1000 * kMs;
+    header.process_id = 42;
+    std::strcpy(header.application, "game.exe");
+    std::strcpy(header.runtime, "DXGI");
+    return header;
+}
+
+FrameCaptureRecord Frame(uint64_t frame_id, int64_t present_ns) {
+    FrameCaptureRecord record;
+    record.frame_id = frame_id;
+    record.present_start_ns = present_ns;
+    record.present_end_ns = present_ns + 1 * kMs;
+    return record;
+}
+
+// Frames 1..count every interval_ns from 1 s after the header start
+std::vector<FrameCaptureRecord> EvenFrames(uint64_t count, int64_t interval_ns) {
+    std::vector<FrameCaptureRecord> records;
+    for (uint64_t i = 0; i < count; ++i) {
+        records.push_back(Frame(i + 1, 2000 * kMs + static_cast<int64_t>(i) * interval_ns));
+        records.back().sequence = i + 1;
+    }
+    return records;
+}
+
+DC_TEST(FileLayoutIsFixed) {
+    CHECK_EQ(sizeof(FrameCaptureHeader), 256u);
+    CHECK_EQ(sizeof(FrameCaptureRecord), 128u);
+    CHECK_EQ(offsetof(FrameCaptureHeader, capacity), 16u);
+    CHECK_EQ(offsetof(FrameCaptureHeader, record_count), 24u);
+    CHECK_EQ(offsetof(FrameCaptureHeader, dropped), 52u);
+    CHECK_EQ(offsetof(FrameCaptureHeader, application), 56u);
+    CHECK_EQ(offsetof(FrameCaptureRecord, frame_id), 8u);
+    CHECK_EQ(offsetof(FrameCaptureRecord, late_amount_ns), 96u);
+    CHECK_EQ(offsetof(FrameCaptureRecord, flags), 114u);
+    CHECK_EQ(FrameCaptureFileBytes(0), 256u);
+    CHECK_EQ(FrameCaptureFileBytes(3), 256u + 3 * 128u);
+}
+
+DC_TEST(OpenRejectsBadChunks) {
+    ChunkedFile file;
+    FrameCaptureWriter writer;
+    CHECK(!writer.Open(nullptr, kChunkBytes, 10, TestHeader()));
+    CHECK(!writer.Open(file.NewChunk(), 256, 10, TestHeader()));              // No room for a record
+    CHECK(!writer.Open(file.NewChunk(), kChunkBytes + 64, 10, TestHeader()));  // Records would straddle chunks
+    CHECK(!writer.Open(file.NewChunk(), kChunkBytes, 0, TestHeader()));
+    CHECK(!writer.IsOpen());
+    CHECK(!writer.Append(Frame(1, 1)));
+    CHECK_EQ(writer.Finish(), 0u);
+
+    CHECK(writer.Open(file.NewChunk(), kChunkBytes, 1000000, TestHeader()));
+    CHECK_EQ(writer.Capacity(), FrameCaptureWriter::kMaxChunks * kSlotsPerChunk - 2);  // Capped by kMaxChunks
+    const FrameCaptureHeader& header = *reinterpret_cast<const FrameCaptureHeader*>(file.chunks.back().data());
+    CHECK_EQ(header.magic, kFrameCaptureMagic);
+    CHECK_EQ(header.version, kFrameCaptureVersion);
+    CHECK_EQ(header.record_size, 128u);
+    CHECK_EQ(header.capacity, writer.Capacity());
+    CHECK_EQ(header.record_count, 0u);
+    CHECK_EQ(std::string(header.application), "game.exe");
+}
+
+DC_TEST(ChunksGrowOnDemandAndUnmappedSlotsAreDropped) {
+    ChunkedFile file;
+    FrameCaptureWriter writer;
+    REQUIRE(writer.Open(file.NewChunk(), kChunkBytes, 100, TestHeader()));
+    CHECK_EQ(writer.MappedChunks(), 1u);
+    CHECK(!writer.NeedsChunk());
+    for (uint64_t i = 1; i <= 2; ++i) {
+        CHECK(writer.Append(Frame(i, static_cast<int64_t>(i) * 10 * kMs)));
+    }
+    CHECK(writer.NeedsChunk());  // 4 of 6 slots left: less than half a chunk ahead
+
+    // The owner is late: frames beyond the first chunk are dropped, not written past the mapping
+    for (uint64_t i = 3; i <= 10; ++i) {
+        writer.Append(Frame(i, static_cast<int64_t>(i) * 10 * kMs));
+    }
+    CHECK_EQ(writer.Count(), 6u);
+    CHECK_EQ(writer.Dropped(), 4u);
+
+    REQUIRE(writer.AddChunk(file.NewChunk()));
+    CHECK_EQ(writer.MappedChunks(), 2u);
+    for (uint64_t i = 11; i <= 14; ++i) {
+        CHECK(writer.Append(Frame(i, static_cast<int64_t>(i) * 10 * kMs)));
+    }
+    CHECK_EQ(writer.Count(), 10u);
+
+    const size_t used = writer.Finish();
+    CHECK_EQ(used, FrameCaptureFileBytes(10));
+    CHECK(!writer.IsOpen());
+
+    FrameCaptureData data;
+    std::string error;
+    const std::vector<unsigned char> image = file.Image(used);
+    REQUIRE(ReadFrameCapture(image.data(), image.size(), &data, &error));
+    CHECK_EQ(data.header.record_count, 10u);
+    CHECK_EQ(data.header.dropped, 4u);
+    CHECK_EQ(data.torn_records, 0u);
+    REQUIRE(data.records.size() == 10u);
+    // No hole where the frames were dropped: slots 6.. continue with frame 11
+    CHECK_EQ(data.records[5].frame_id, 6u);
+    CHECK_EQ(data.records[6].frame_id, 11u);
+    CHECK_EQ(data.records[9].frame_id, 14u);
+}
+
+DC_TEST(CapacityEndsTheCaptureBeforeTheLastChunk) {
+    ChunkedFile file;
+    FrameCaptureWriter writer;
+    REQUIRE(writer.Open(file.NewChunk(), kChunkBytes, 9, TestHeader()));
+    REQUIRE(writer.NeedsChunk() == false);
+    for (uint64_t i = 1; i <= 4; ++i) {
+        writer.Append(Frame(i, static_cast<int64_t>(i) * 10 * kMs));
+    }
+    REQUIRE(writer.NeedsChunk());
+    REQUIRE(writer.AddChunk(file.NewChunk()));
+    CHECK(!writer.NeedsChunk());  // Capacity 9 fits in two chunks
+    for (uint64_t i = 5; i <= 12; ++i) {
+        writer.Append(Frame(i, static_cast<int64_t>(i) * 10 * kMs));
+    }
+    CHECK_EQ(writer.Count(), 9u);
+    CHECK_EQ(writer.Dropped(), 3u);
+    CHECK_EQ(writer.Finish(), FrameCaptureFileBytes(9));
+}
+
+DC_TEST(ConcurrentAppendsFillEverySlotOnce) {
+    constexpr int kThreads = 4;
+    constexpr uint64_t kPerThread = 40;
+    ChunkedFile file;
+    FrameCaptureWriter writer;
+    REQUIRE(writer.Open(file.NewChunk(), kChunkBytes, kThreads * kPerThread, TestHeader()));
+    while (FrameCaptureFileBytes(kThreads * kPerThread) > writer.MappedChunks() * kChunkBytes) {
+        REQUIRE(writer.AddChunk(file.NewChunk()));
+    }
+    CHECK(!writer.NeedsChunk());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&writer, t] {
+            for (uint64_t i = 0; i < kPerThread; ++i) {
+                const uint64_t frame_id = static_cast<uint64_t>(t) * 1000 + i + 1;
+                writer.Append(Frame(frame_id, static_cast<int64_t>(frame_id) * kMs));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const size_t used = writer.Finish();
+
+    FrameCaptureData data;
+    std::string error;
+    const std::vector<unsigned char> image = file.Image(used);
+    REQUIRE(ReadFrameCapture(image.data(), image.size(), &data, &error));
+    CHECK_EQ(data.records.size(), kThreads * kPerThread);
+    CHECK_EQ(data.header.dropped, 0u);
+    CHECK_EQ(data.torn_records, 0u);
+    std::vector<int> seen(kThreads * kPerThread, 0);
+    for (const FrameCaptureRecord& record : data.records) {
+        const uint64_t t = record.frame_id / 1000;
+        const uint64_t i = record.frame_id % 1000 - 1;
+        REQUIRE(t < kThreads && i < kPerThread);
+        ++seen[t * kPerThread + i];
+    }
+    for (int count : seen) {
+        CHECK_EQ(count, 1);
+    }
+}
+
+DC_TEST(UnfinishedCaptureIsReadUpToTheFirstUnclaimedSlot) {
+    ChunkedFile file;
+    FrameCaptureWriter writer;
+    REQUIRE(writer.Open(file.NewChunk(), kChunkBytes, 6, TestHeader()));
+    for (uint64_t i = 1; i <= 4; ++i) {
+        writer.Append(Frame(i, static_cast<int64_t>(i) * 10 * kMs));
+    }
+    // Crash before Finish: record_count is still 0, slot 2 was claimed but never published
+    std::vector<unsigned char> image = file.Image(kChunkBytes);
+    FrameCaptureRecord* slots = reinterpret_cast<FrameCaptureRecord*>(image.data() + sizeof(FrameCaptureHeader));
+    slots[2].sequence = 0;
+    slots[2].frame_id = 0;
+    slots[3].sequence = 0;
+
+    FrameCaptureData data;
+    std::string error;
+    REQUIRE(ReadFrameCapture(image.data(), image.size(), &data, &error));
+    CHECK_EQ(data.header.record_count, 0u);
+    CHECK_EQ(data.records.size(), 2u);
+
+    // A stale sequence (slot reused from another capture) counts as torn, and the scan goes on
+    slots[2].sequence = 99;
+    slots[3].sequence = 4;
+    REQUIRE(ReadFrameCapture(image.data(), image.size(), &data, &error));
+    CHECK_EQ(data.records.size(), 3u);
+    CHECK_EQ(data.torn_records, 1u);
+}
+
+DC_TEST(ReadRejectsForeignFiles) {
+    FrameCaptureData data;
+    std::string error;
+    CHECK(!ReadFrameCapture(nullptr, 0, &data, &error));
+    std::vector<unsigned char> image(FrameCaptureFileBytes(2), 0);
+    CHECK(!ReadFrameCapture(image.data(), sizeof(FrameCaptureHeader) - 1, &data, &error));
+
+    FrameCaptureHeader header = TestHeader();
+    header.magic = 0x12345678;
+    std::memcpy(image.data(), &header, sizeof(header));
+    CHECK(!ReadFrameCapture(image.data(), image.size(), &data, &error));
+    CHECK(error.find("magic") != std::string::npos);
+
+    header = TestHeader();
+    header.version = kFrameCaptureVersion + 1;
+    header.record_size = sizeof(FrameCaptureRecord);
+    std::memcpy(image.data(), &header, sizeof(header));
+    CHECK(!ReadFrameCapture(image.data(), image.size(), &data, &error));
+    header.version = kFrameCaptureVersion;
+    header.record_size = 96;
+    std::memcpy(image.data(), &header, sizeof(header));
+    CHECK(!ReadFrameCapture(image.data(), image.size(), &data, &error));
+
+    // Truncated file: record_count says more than the file holds
+    header.record_size = sizeof(FrameCaptureRecord);
+    header.record_count = 10;
+    std::memcpy(image.data(), &header, sizeof(header));
+    REQUIRE(ReadFrameCapture(image.data(), image.size(), &data, &error));
+    CHECK_EQ(data.records.size() + data.torn_records, 2u);
+}
+
+DC_TEST(FrameTimeSkipsGapsAndMissingPresents) {
+    std::vector<FrameCaptureRecord> records = EvenFrames(4, 10 * kMs);
+    records[2].frame_id = 10;  // Frames 3..9 not recorded
+    records[3].frame_id = 11;
+    int64_t frame_time_ns = 0;
+    CHECK(!FrameCaptureFrameTimeNs(records, 0, &frame_time_ns));
+    REQUIRE(FrameCaptureFrameTimeNs(records, 1, &frame_time_ns));
+    CHECK_EQ(frame_time_ns, 10 * kMs);
+    CHECK(!FrameCaptureFrameTimeNs(records, 2, &frame_time_ns));
+    CHECK(FrameCaptureFrameTimeNs(records, 3, &frame_time_ns));
+    CHECK(!FrameCaptureFrameTimeNs(records, 4, &frame_time_ns));
+
+    // Present start not recorded: present end is used
+    records[3].present_start_ns = 0;
+    REQUIRE(FrameCaptureFrameTimeNs(records, 3, &frame_time_ns));
+    CHECK_EQ(frame_time_ns, 11 * kMs);
+}
+
+DC_TEST(SummaryPercentilesAndLows) {
+    FrameCaptureData data;
+    data.header = TestHeader();
+    // 999 frame times of 10 ms and one of 50 ms
+    data.records = EvenFrames(1001, 10 * kMs);
+    for (size_t i = 500; i < data.records.size(); ++i) {
+        data.records[i].present_start_ns += 40 * kMs;
+        data.records[i].present_end_ns += 40 * kMs;
+    }
+    data.records[10].late_amount_ns = 2 * kMs;
+    data.records[20].reflex_pc_latency_us = 30000;
+    const FrameCaptureSummary summary = SummarizeFrameCapture(data);
+    CHECK_EQ(summary.frames, 1000u);
+    CHECK_EQ(summary.gaps, 0u);
+    CHECK_NEAR(summary.duration_s, 10.04, 1e-9);
+    CHECK_NEAR(summary.avg_frame_ms, 10.04, 1e-9);
+    CHECK_NEAR(summary.min_frame_ms, 10.0, 1e-9);
+    CHECK_NEAR(summary.max_frame_ms, 50.0, 1e-9);
+    CHECK_NEAR(summary.p50_frame_ms, 10.0, 1e-9);
+    CHECK_NEAR(summary.p999_frame_ms, 10.0, 1e-9);  // Nearest rank 999 of 1000
+    CHECK_NEAR(summary.low_01pct_fps, 20.0, 1e-9);  // Slowest frame only
+    CHECK_NEAR(summary.low_1pct_fps, 1000.0 / 14.0, 1e-9);
+    CHECK_NEAR(summary.avg_present_ms, 1.0, 1e-9);
+    CHECK_EQ(summary.late_frames, 1u);
+    CHECK_NEAR(summary.avg_late_ms, 2.0, 1e-9);
+    CHECK_EQ(summary.reflex_frames, 1u);
+    CHECK_NEAR(summary.avg_reflex_pc_latency_ms, 30.0, 1e-9);
+
+    data.records.resize(1);
+    CHECK_EQ(SummarizeFrameCapture(data).frames, 0u);
+    CHECK_EQ(SummarizeFrameCapture(data).avg_fps, 0.0);
+}
+
+DC_TEST(CsvHasOneRowPerFrameTime) {
+    FrameCaptureData data;
+    data.header = TestHeader();
+    data.records = EvenFrames(5, 10 * kMs);
+    data.records[3].frame_id = 20;  // Gap: no row for record 3, nor for the first one
+    data.records[4].frame_id = 21;
+    data.records[4].flags = kFrameCaptureFlagBackground;
+    std::ostringstream csv;
+    WriteFrameCaptureCsv(data, csv);
+
+    std::istringstream lines(csv.str());
+    std::string line;
+    std::vector<std::string> rows;
+    while (std::getline(lines, line)) {
+        rows.push_back(line);
+    }
+    REQUIRE(rows.size() == 4u);
+    CHECK_EQ(rows[0].rfind("Application,ProcessID,SwapChainAddress,Runtime,", 0), 0u);
+    CHECK(rows[0].find(",MsBetweenPresents,") != std::string::npos);
+    CHECK_EQ(rows[1].rfind("game.exe,42,0x0000000000000000,DXGI,", 0), 0u);
+    CHECK(rows[1].find(",10.0000,") != std::string::npos);
+    CHECK(rows[1].substr(rows[1].size() - 2) == ",2");
+    CHECK(rows[3].substr(rows[3].size() - 5) == ",1,21");  // Background, FrameID
+    // Every row has as many columns as the header
+    const auto columns = [](const std::string& row) { return std::count(row.begin(), row.end(), ','); };
+    for (const std::string& row : rows) {
+        CHECK_EQ(columns(row), columns(rows[0]));
+    }
+}
+
+DC_TEST(SummaryTextNamesTheCapture) {
+    FrameCaptureData data;
+    data.header = TestHeader();
+    data.header.dropped = 3;
+    data.records = EvenFrames(101, 10 * kMs);
+    data.torn_records = 1;
+    std::ostringstream out;
+    WriteFrameCaptureSummary(data, SummarizeFrameCapture(data), out);
+    const std::string text = out.str();
+    CHECK(text.find("Application: game.exe (pid 42, DXGI)") != std::string::npos);
+    CHECK(text.find("Records: 101 (torn 1, dropped 3), frames with frame time: 100, gaps: 0") != std::string::npos);
+    CHECK(text.find("Average: 100.00 FPS") != std::string::npos);
+    CHECK(text.find("Reflex") == std::string::npos);
+}
+
+DC_TEST(AppendBenchmark) {
+    std::vector<std::vector<uint64_t>> chunks(FrameCaptureWriter::kMaxChunks,
+                                              std::vector<uint64_t>(64 * 1024 / sizeof(uint64_t)));
+    FrameCaptureWriter writer;
+    writer.Open(chunks[0].data(), 64 * 1024, ~uint64_t{0}, TestHeader());
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        writer.AddChunk(chunks[i].data());
+    }
+    const FrameCaptureRecord record = Frame(1, 1000 * kMs);
+    const double ns = dc_test::MeasureNsPerOp(10000, [&](size_t) { writer.Append(record); });
+    dc_test::Consume(writer.Count());
+    dc_test::ReportBenchmark("FrameCaptureWriter::Append", ns);
+}
+
+}  // namespace
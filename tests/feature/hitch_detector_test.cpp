@@ -0,0 +1,257 @@
+// Source Code <Display Commander> // Hitch detector tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/hitch/hitch_detector.hpp"
+#include "feature/hitch_trace.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::feature::hitch;
+
+constexpr int64_t kMs = 1000000;
+
+// Frame-time trace: `count` frames of frame_ns each, with the given frames (index -> ns) replaced
+std::vector<HitchTraceFrame> SteadyTrace(size_t count, int64_t frame_ns,
+                                         const std::vector<std::pair<size_t, int64_t>>& spikes = {}) {
+    std::vector<HitchTraceFrame> frames;
+    int64_t end_ns = 1000 * kMs;
+    for (size_t i = 0; i < count; ++i) {
+        int64_t ns = frame_ns;
+        for (const auto& spike : spikes) {
+            if (spike.first == i) {
+                ns = spike.second;
+            }
+        }
+        end_ns += ns;
+        frames.push_back(HitchTraceFrame{end_ns, ns});
+    }
+    return frames;
+}
+
+HitchEvidence Evidence(HitchCause cause, int64_t time_ns, int64_t duration_ns, const char* detail = nullptr) {
+    HitchEvidence evidence;
+    evidence.cause = cause;
+    evidence.time_ns = time_ns;
+    evidence.duration_ns = duration_ns;
+    SetHitchEvidenceDetail(&evidence, detail);
+    return evidence;
+}
+
+DC_TEST(SteadyFramesHaveNoHitches) {
+    const HitchTraceResult result = AnalyzeHitchTrace(SteadyTrace(1000, 16 * kMs), {});
+    CHECK_EQ(result.stats.frames, 1000u);
+    CHECK_EQ(result.stats.hitches, 0u);
+    CHECK_NEAR(result.stats.median_ms, 16.0, 1e-9);
+    CHECK_NEAR(result.stats.session_seconds, 16.0, 1e-6);
+    CHECK(result.hitches.empty());
+}
+
+DC_TEST(SpikeAboveTheAdaptiveThresholdIsAHitch) {
+    const HitchTraceResult result =
+        AnalyzeHitchTrace(SteadyTrace(200, 10 * kMs, {{100, 25 * kMs}, {150, 19 * kMs}}), {});
+    // 2x median = 20 ms: 25 ms is a hitch, 19 ms is not
+    REQUIRE(result.hitches.size() == 1u);
+    const HitchRecord& hitch = result.hitches[0];
+    CHECK_EQ(hitch.frame_index, 101u);
+    CHECK_NEAR(hitch.frame_time_ms, 25.0, 1e-9);
+    CHECK_NEAR(hitch.median_ms, 10.0, 1e-9);
+    CHECK_NEAR(hitch.threshold_ms, 20.0, 1e-9);
+    CHECK(hitch.primary_cause == HitchCause::kCount);
+    CHECK_EQ(result.stats.unattributed, 1u);
+    CHECK_NEAR(result.stats.worst_frame_ms, 25.0, 1e-9);
+    CHECK_NEAR(result.stats.hitch_frame_pct, 0.5, 1e-9);
+}
+
+DC_TEST(HighFrameRatesNeedTheMinimumExcess) {
+    // At 2 ms, 5 ms is 2.5x the median but only 3 ms above it
+    const HitchTraceResult result =
+        AnalyzeHitchTrace(SteadyTrace(200, 2 * kMs, {{100, 5 * kMs}, {150, 7 * kMs}}), {});
+    REQUIRE(result.hitches.size() == 1u);
+    CHECK_EQ(result.hitches[0].frame_index, 151u);
+    CHECK_NEAR(result.hitches[0].threshold_ms, 6.0, 1e-9);
+}
+
+DC_TEST(NoDetectionDuringWarmup) {
+    HitchDetectorConfig config;
+    config.warmup_frames = 30;
+    const HitchTraceResult result = AnalyzeHitchTrace(SteadyTrace(100, 10 * kMs, {{10, 50 * kMs}, {60, 50 * kMs}}), {},
+                                                      config);
+    REQUIRE(result.hitches.size() == 1u);
+    CHECK_EQ(result.hitches[0].frame_index, 61u);
+}
+
+DC_TEST(StutterBurstDoesNotRaiseTheThreshold) {
+    std::vector<std::pair<size_t, int64_t>> spikes;
+    for (size_t i = 100; i < 300; i += 2) {
+        spikes.push_back({i, 30 * kMs});
+    }
+    const HitchTraceResult result = AnalyzeHitchTrace(SteadyTrace(400, 10 * kMs, spikes), {});
+    CHECK_EQ(result.hitches.size(), spikes.size());
+    CHECK_NEAR(result.hitches.back().threshold_ms, 20.0, 1e-9);
+}
+
+DC_TEST(PausesAreNotFrames) {
+    HitchDetector detector;
+    int64_t end_ns = 0;
+    for (int i = 0; i < 100; ++i) {
+        end_ns += 10 * kMs;
+        detector.AddFrame(end_ns, 10 * kMs, nullptr);
+    }
+    end_ns += 5000 * kMs;
+    HitchRecord record;
+    CHECK(!detector.AddFrame(end_ns, 5000 * kMs, &record));
+    CHECK(!detector.AddFrame(end_ns, 0, &record));
+    CHECK_EQ(detector.GetStats().frames, 100u);
+    CHECK_EQ(detector.GetStats().hitches, 0u);
+}
+
+DC_TEST(EvidenceIsAttributedByPriorityAndOverlap) {
+    const std::vector<HitchTraceFrame> frames = SteadyTrace(200, 10 * kMs, {{100, 60 * kMs}});
+    const int64_t hitch_end_ns = frames[100].frame_end_ns;
+    const int64_t hitch_start_ns = hitch_end_ns - 60 * kMs;
+    const std::vector<HitchEvidence> evidence = {
+        Evidence(HitchCause::kLimiterLate, hitch_end_ns - 1 * kMs, 40 * kMs),
+        Evidence(HitchCause::kModuleLoad, hitch_start_ns + 30 * kMs, 5 * kMs, "short.dll"),
+        Evidence(HitchCause::kModuleLoad, hitch_start_ns + 50 * kMs, 45 * kMs, "nvngx_dlss.dll"),
+        // Ended before the frame started (beyond the slack): not this hitch's
+        Evidence(HitchCause::kDisplayModeChange, hitch_start_ns - 5 * kMs, 0),
+        // Config save during the frame, reported after it within the slack
+        Evidence(HitchCause::kConfigSave, hitch_end_ns + 1 * kMs, 2 * kMs),
+    };
+    const HitchTraceResult result = AnalyzeHitchTrace(frames, evidence);
+    REQUIRE(result.hitches.size() == 1u);
+    const HitchRecord& hitch = result.hitches[0];
+    CHECK(hitch.primary_cause == HitchCause::kModuleLoad);
+    CHECK_EQ(hitch.evidence_count, 4u);
+    CHECK(std::strcmp(hitch.evidence[0].detail.data(), "nvngx_dlss.dll") == 0);
+    CHECK(std::strcmp(hitch.evidence[1].detail.data(), "short.dll") == 0);
+    CHECK(hitch.evidence[2].cause == HitchCause::kConfigSave);
+    CHECK(hitch.evidence[3].cause == HitchCause::kLimiterLate);
+    const uint32_t expected_mask = (1u << static_cast<uint32_t>(HitchCause::kModuleLoad))
+                                   | (1u << static_cast<uint32_t>(HitchCause::kConfigSave))
+                                   | (1u << static_cast<uint32_t>(HitchCause::kLimiterLate));
+    CHECK_EQ(hitch.cause_mask, expected_mask);
+    CHECK_EQ(result.stats.by_primary_cause[static_cast<size_t>(HitchCause::kModuleLoad)], 1u);
+    CHECK_EQ(result.stats.unattributed, 0u);
+}
+
+DC_TEST(EvidenceHistoryKeepsTheNewestEvents) {
+    HitchDetector detector;
+    int64_t end_ns = 0;
+    for (int i = 0; i < 100; ++i) {
+        end_ns += 10 * kMs;
+        detector.AddFrame(end_ns, 10 * kMs, nullptr);
+    }
+    // Old event inside the coming hitch, then a full history of unrelated ones pushes it out
+    detector.AddEvidence(Evidence(HitchCause::kDisplayModeChange, end_ns + 10 * kMs, 0));
+    for (size_t i = 0; i < HitchDetector::kEvidenceHistory; ++i) {
+        detector.AddEvidence(Evidence(HitchCause::kLogBurst, static_cast<int64_t>(i) * kMs, 0));
+    }
+    detector.AddEvidence(Evidence(HitchCause::kBackgroundTransition, end_ns + 20 * kMs, 0));
+    detector.AddEvidence(Evidence(HitchCause::kCount, end_ns + 20 * kMs, 0));  // Invalid: ignored
+    HitchRecord record;
+    CHECK(detector.AddFrame(end_ns + 50 * kMs, 50 * kMs, &record));
+    CHECK(record.primary_cause == HitchCause::kBackgroundTransition);
+    CHECK_EQ(record.evidence_count, 1u);
+}
+
+DC_TEST(ResetKeepsTheConfig) {
+    HitchDetectorConfig config;
+    config.threshold_multiplier = 3.0;
+    HitchDetector detector(config);
+    detector.AddFrame(10 * kMs, 10 * kMs, nullptr);
+    detector.Reset();
+    CHECK_EQ(detector.GetStats().frames, 0u);
+    CHECK_EQ(detector.GetConfig().threshold_multiplier, 3.0);
+}
+
+DC_TEST(EvidenceDetailIsTruncated) {
+    HitchEvidence evidence;
+    const std::string long_name(100, 'x');
+    SetHitchEvidenceDetail(&evidence, long_name.c_str());
+    CHECK_EQ(std::strlen(evidence.detail.data()), evidence.detail.size() - 1);
+    SetHitchEvidenceDetail(&evidence, nullptr);
+    CHECK_EQ(evidence.detail[0], '\0');
+}
+
+DC_TEST(ParsesPresentMonCsv) {
+    std::istringstream csv(
+        "Application,ProcessID,TimeInSeconds,MsBetweenPresents,MsBetweenDisplayChange\r\n"
+        "game.exe,1,1.000,16.0,16.0\r\n"
+        "game.exe,1,1.016,16.0,16.0\r\n"
+        "game.exe,1,1.100,84.0,84.0\r\n"
+        "game.exe,1,1.101,NA,0\r\n"
+        "game.exe,1\r\n");
+    std::vector<HitchTraceFrame> frames;
+    std::string error;
+    CHECK(ParseHitchTraceCsv(csv, &frames, &error));
+    REQUIRE(frames.size() == 3u);
+    CHECK_EQ(frames[0].frame_end_ns, 1000 * kMs);
+    CHECK_EQ(frames[2].frame_end_ns, 1100 * kMs);
+    CHECK_EQ(frames[2].frame_time_ns, 84 * kMs);
+}
+
+DC_TEST(ParsesCsvWithoutTimestamps) {
+    std::istringstream csv("\"MsBetweenPresents\"\n10.5\n20.25\n");
+    std::vector<HitchTraceFrame> frames;
+    std::string error;
+    CHECK(ParseHitchTraceCsv(csv, &frames, &error));
+    REQUIRE(frames.size() == 2u);
+    CHECK_EQ(frames[0].frame_end_ns, 10'500'000);
+    CHECK_EQ(frames[1].frame_end_ns, 30'750'000);
+}
+
+DC_TEST(RejectsCsvWithoutFrameTimes) {
+    std::vector<HitchTraceFrame> frames;
+    std::string error;
+    std::istringstream no_column("TimeInSeconds,MsUntilDisplayed\n1.0,5.0\n");
+    CHECK(!ParseHitchTraceCsv(no_column, &frames, &error));
+    CHECK(error == "no MsBetweenPresents column");
+    std::istringstream empty("");
+    CHECK(!ParseHitchTraceCsv(empty, &frames, &error));
+    CHECK(error == "empty file");
+    CHECK(frames.empty());
+}
+
+DC_TEST(CsvTraceReplay) {
+    // 60 FPS with a shader compile stall and a two-frame loading hitch
+    std::string text = "TimeInSeconds,MsBetweenPresents\n";
+    double time_s = 0.0;
+    for (int i = 0; i < 600; ++i) {
+        const double ms = i == 200 ? 120.0 : (i == 400 || i == 401) ? 45.0 : 16.667;
+        time_s += ms / 1000.0;
+        text.append(std::to_string(time_s)).append(",").append(std::to_string(ms)).append("\n");
+    }
+    std::istringstream csv(text);
+    std::vector<HitchTraceFrame> frames;
+    std::string error;
+    REQUIRE(ParseHitchTraceCsv(csv, &frames, &error));
+    const HitchTraceResult result = AnalyzeHitchTrace(
+        frames, {Evidence(HitchCause::kModuleLoad, frames[200].frame_end_ns - 10 * kMs, 80 * kMs, "d3dcompiler")});
+    REQUIRE(result.hitches.size() == 3u);
+    CHECK(result.hitches[0].primary_cause == HitchCause::kModuleLoad);
+    CHECK(result.hitches[1].primary_cause == HitchCause::kCount);
+    CHECK_EQ(result.hitches[2].frame_index, 402u);
+    CHECK_NEAR(result.stats.hitches_per_minute, 3.0 * 60.0 / result.stats.session_seconds, 1e-9);
+}
+
+DC_TEST(AddFrameBenchmark) {
+    HitchDetector detector;
+    int64_t end_ns = 0;
+    const double ns = dc_test::MeasureNsPerOp(200000, [&](size_t i) {
+        const int64_t frame_ns = (i % 500) == 0 ? 50 * kMs : 16 * kMs + static_cast<int64_t>(i % 5) * kMs;
+        end_ns += frame_ns;
+        detector.AddFrame(end_ns, frame_ns, nullptr);
+    });
+    dc_test::Consume(detector.GetStats().hitches);
+    dc_test::ReportBenchmark("HitchDetector::AddFrame (120-frame median)", ns);
+}
+
+}  // namespace
@@ -0,0 +1,100 @@
+// Source Code <Display Commander> // Offline hitch trace analysis for tests (platform-neutral, no Windows includes)
+#include "hitch_trace.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace display_commander::feature::hitch {
+
+namespace {
+
+std::vector<std::string> SplitCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    for (char c : line) {
+        if (c == ',') {
+            fields.push_back(field);
+            field.clear();
+        } else if (c != '\r' && c != '"') {
+            field.push_back(c);
+        }
+    }
+    fields.push_back(field);
+    return fields;
+}
+
+int FindColumn(const std::vector<std::string>& header, const char* name) {
+    for (size_t i = 0; i < header.size(); ++i) {
+        if (header[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+HitchTraceResult AnalyzeHitchTrace(const std::vector<HitchTraceFrame>& frames,
+                                   const std::vector<HitchEvidence>& evidence,
+                                   const HitchDetectorConfig& config) {
+    HitchTraceResult result;
+    HitchDetector detector(config);
+    std::vector<HitchEvidence> sorted_evidence = evidence;
+    std::stable_sort(sorted_evidence.begin(), sorted_evidence.end(),
+                     [](const HitchEvidence& a, const HitchEvidence& b) { return a.time_ns < b.time_ns; });
+    size_t next_evidence = 0;
+    for (const HitchTraceFrame& frame : frames) {
+        // Events that ended by the end of this frame (plus slack) have been reported by the time it presents
+        while (next_evidence < sorted_evidence.size()
+               && sorted_evidence[next_evidence].time_ns <= frame.frame_end_ns + config.evidence_slack_ns) {
+            detector.AddEvidence(sorted_evidence[next_evidence++]);
+        }
+        HitchRecord record;
+        if (detector.AddFrame(frame.frame_end_ns, frame.frame_time_ns, &record)) {
+            result.hitches.push_back(record);
+        }
+    }
+    result.stats = detector.GetStats();
+    return result;
+}
+
+bool ParseHitchTraceCsv(std::istream& input, std::vector<HitchTraceFrame>* frames, std::string* error) {
+    std::string line;
+    if (!std::getline(input, line)) {
+        *error = "empty file";
+        return false;
+    }
+    const std::vector<std::string> header = SplitCsvLine(line);
+    const int frame_time_column = FindColumn(header, "MsBetweenPresents");
+    const int time_column = FindColumn(header, "TimeInSeconds");
+    if (frame_time_column < 0) {
+        *error = "no MsBetweenPresents column";
+        return false;
+    }
+
+    int64_t running_ns = 0;
+    while (std::getline(input, line)) {
+        const std::vector<std::string> fields = SplitCsvLine(line);
+        if (static_cast<int>(fields.size()) <= frame_time_column) {
+            continue;
+        }
+        const double frame_ms = std::strtod(fields[frame_time_column].c_str(), nullptr);
+        if (!(frame_ms > 0.0)) {
+            continue;
+        }
+        HitchTraceFrame frame;
+        frame.frame_time_ns = static_cast<int64_t>(std::llround(frame_ms * 1'000'000.0));
+        running_ns += frame.frame_time_ns;
+        frame.frame_end_ns = running_ns;
+        if (time_column >= 0 && static_cast<int>(fields.size()) > time_column) {
+            frame.frame_end_ns = static_cast<int64_t>(
+                std::llround(std::strtod(fields[time_column].c_str(), nullptr) * 1'000'000'000.0));
+        }
+        frames->push_back(frame);
+    }
+    return true;
+}
+
+}  // namespace display_commander::feature::hitch
@@ -0,0 +1,34 @@
+// Source Code <Display Commander> // Offline hitch trace analysis for tests (platform-neutral, no Windows includes)
+#pragma once
+
+#include "feature/hitch/hitch_detector.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace display_commander::feature::hitch {
+
+struct HitchTraceFrame {
+    int64_t frame_end_ns = 0;
+    int64_t frame_time_ns = 0;
+};
+
+struct HitchTraceResult {
+    HitchSessionStats stats;
+    std::vector<HitchRecord> hitches;
+};
+
+// Runs HitchDetector over a recorded frame-time trace. Evidence is fed in time order interleaved with the frames
+// (each event before the first frame ending at or after it), the same order the live hooks produce.
+HitchTraceResult AnalyzeHitchTrace(const std::vector<HitchTraceFrame>& frames,
+                                   const std::vector<HitchEvidence>& evidence,
+                                   const HitchDetectorConfig& config = HitchDetectorConfig());
+
+// Reads frames from a PresentMon-style CSV (header row with MsBetweenPresents; TimeInSeconds used for timestamps when
+// present, otherwise the running sum). Returns false with a reason when the header has no frame time column.
+bool ParseHitchTraceCsv(std::istream& input, std::vector<HitchTraceFrame>* frames, std::string* error);
+
+}  // namespace display_commander::feature::hitch
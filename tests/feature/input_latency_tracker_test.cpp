@@ -0,0 +1,298 @@
+// Source Code <Display Commander> // Input latency attribution tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/input_latency/input_latency_tracker.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::feature::input_latency;
+
+constexpr int64_t kMs = 1000000;
+
+// Synthetic frame timeline: sim starts every frame_ns, present ends present_ns later, GPU finishes gpu_ns later.
+struct SyntheticGame {
+    int64_t start_ns = 1000 * kMs;
+    int64_t frame_ns = 16 * kMs;
+    int64_t present_ns = 10 * kMs;
+    int64_t gpu_ns = 12 * kMs;
+    uint64_t next_id = 1;
+
+    InputFrameTimeline Frame(uint64_t id) const {
+        InputFrameTimeline f;
+        f.frame_id = id;
+        f.sim_start_ns = start_ns + static_cast<int64_t>(id - 1) * frame_ns;
+        f.present_end_ns = f.sim_start_ns + present_ns;
+        f.gpu_done_ns = f.sim_start_ns + gpu_ns;
+        return f;
+    }
+
+    InputFrameTimeline Next() { return Frame(next_id++); }
+
+    int64_t SimStart(uint64_t id) const { return Frame(id).sim_start_ns; }
+};
+
+InputLatencySourceStats Source(const InputLatencyStats& stats, InputSource source) {
+    return stats.sources[static_cast<size_t>(source)];
+}
+
+DC_TEST(InputIsAttributedToFirstFrameSimulatedAfterIt) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    tracker.AddFrame(game.Next());  // Frame 1
+
+    // Between frame 1 and 2 sim starts: frame 2 picks it up; latency ends at frame 2's GPU completion
+    const int64_t input_ns = game.SimStart(1) + 5 * kMs;
+    tracker.RecordInput(InputSource::kPad, input_ns);
+    tracker.AddFrame(game.Next());
+
+    const InputLatencySourceStats pad = Source(tracker.GetStats(), InputSource::kPad);
+    REQUIRE(pad.samples == 1);
+    CHECK_NEAR(pad.last_ms, (game.SimStart(2) + game.gpu_ns - input_ns) / 1e6, 1e-9);
+    CHECK_EQ(tracker.GetStats().frames, 2u);
+}
+
+// An input stamped exactly at a sim start was not seen by that frame's simulation.
+DC_TEST(InputAtSimStartGoesToNextFrame) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    tracker.AddFrame(game.Next());
+    tracker.AddFrame(game.Next());
+    tracker.RecordInput(InputSource::kKeyboard, game.SimStart(3));
+    tracker.AddFrame(game.Next());  // Frame 3 starts at the stamp: not attributed
+    CHECK_EQ(Source(tracker.GetStats(), InputSource::kKeyboard).samples, 0u);
+    tracker.AddFrame(game.Next());
+    const InputLatencySourceStats keyboard = Source(tracker.GetStats(), InputSource::kKeyboard);
+    REQUIRE(keyboard.samples == 1);
+    CHECK_NEAR(keyboard.last_ms, (game.frame_ns + game.gpu_ns) / 1e6, 1e-9);
+}
+
+DC_TEST(LaterInputsOfSameSourceCoalesce) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    tracker.AddFrame(game.Next());
+    const int64_t base = game.SimStart(1);
+    tracker.RecordInput(InputSource::kMouse, base + 6 * kMs);
+    tracker.RecordInput(InputSource::kMouse, base + 2 * kMs);  // Earlier stamp arriving late replaces it
+    tracker.RecordInput(InputSource::kMouse, base + 9 * kMs);
+    tracker.AddFrame(game.Next());
+
+    const InputLatencySourceStats mouse = Source(tracker.GetStats(), InputSource::kMouse);
+    CHECK_EQ(mouse.events, 3u);
+    CHECK_EQ(mouse.coalesced, 2u);
+    CHECK_EQ(mouse.samples, 1u);
+    CHECK_NEAR(mouse.last_ms, (game.SimStart(2) + game.gpu_ns - (base + 2 * kMs)) / 1e6, 1e-9);
+}
+
+DC_TEST(SourcesAreTrackedSeparately) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    tracker.AddFrame(game.Next());
+    const int64_t base = game.SimStart(1);
+    tracker.RecordInput(InputSource::kPad, base + 1 * kMs);
+    tracker.RecordInput(InputSource::kKeyboard, base + 8 * kMs);
+    tracker.AddFrame(game.Next());
+    tracker.RecordInput(InputSource::kMouse, game.SimStart(2) + 15 * kMs);
+    tracker.AddFrame(game.Next());
+
+    const InputLatencyStats stats = tracker.GetStats();
+    const int64_t end2 = game.SimStart(2) + game.gpu_ns;
+    CHECK_NEAR(Source(stats, InputSource::kPad).last_ms, (end2 - base - 1 * kMs) / 1e6, 1e-9);
+    CHECK_NEAR(Source(stats, InputSource::kKeyboard).last_ms, (end2 - base - 8 * kMs) / 1e6, 1e-9);
+    CHECK_NEAR(Source(stats, InputSource::kMouse).last_ms, (game.gpu_ns + 1 * kMs) / 1e6, 1e-9);
+    CHECK_EQ(Source(stats, InputSource::kPad).samples, 1u);
+    CHECK_EQ(Source(stats, InputSource::kMouse).samples, 1u);
+}
+
+// Present end is used when it is later than GPU completion (e.g. a blocking flip).
+DC_TEST(LatencyEndsAtLaterOfPresentAndGpu) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    game.present_ns = 20 * kMs;
+    game.gpu_ns = 11 * kMs;
+    tracker.AddFrame(game.Next());
+    tracker.RecordInput(InputSource::kPad, game.SimStart(1) + 16 * kMs - 1);
+    tracker.AddFrame(game.Next());
+    CHECK_NEAR(Source(tracker.GetStats(), InputSource::kPad).last_ms, (20 * kMs + 1) / 1e6, 1e-9);
+}
+
+DC_TEST(FrameGapMakesOlderInputsStale) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    tracker.AddFrame(game.Next());
+    tracker.RecordInput(InputSource::kPad, game.SimStart(1) + 1 * kMs);
+    // Frames 2..4 were not reported (overlay, hook gap): frame 5 cannot claim the input
+    game.next_id = 5;
+    tracker.AddFrame(game.Next());
+    InputLatencySourceStats pad = Source(tracker.GetStats(), InputSource::kPad);
+    CHECK_EQ(pad.stale, 1u);
+    CHECK_EQ(pad.samples, 0u);
+
+    // Contiguous again from frame 6
+    tracker.RecordInput(InputSource::kPad, game.SimStart(5) + 1 * kMs);
+    tracker.AddFrame(game.Next());
+    pad = Source(tracker.GetStats(), InputSource::kPad);
+    CHECK_EQ(pad.samples, 1u);
+}
+
+DC_TEST(MissingTimestampsAndPausesAreDropped) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    tracker.AddFrame(game.Next());
+    tracker.RecordInput(InputSource::kPad, game.SimStart(1) + 1 * kMs);
+    InputFrameTimeline no_end = game.Next();
+    no_end.present_end_ns = 0;
+    no_end.gpu_done_ns = 0;
+    tracker.AddFrame(no_end);
+    CHECK_EQ(Source(tracker.GetStats(), InputSource::kPad).dropped, 1u);
+
+    // Loading screen: present more than a second after the input
+    tracker.RecordInput(InputSource::kPad, game.SimStart(2) + 1 * kMs);
+    InputFrameTimeline paused = game.Next();
+    paused.present_end_ns = paused.sim_start_ns + 2000 * kMs;
+    tracker.AddFrame(paused);
+    const InputLatencySourceStats pad = Source(tracker.GetStats(), InputSource::kPad);
+    CHECK_EQ(pad.dropped, 2u);
+    CHECK_EQ(pad.samples, 0u);
+
+    // Frames without a sim start are ignored entirely
+    InputFrameTimeline no_sim = game.Next();
+    no_sim.sim_start_ns = 0;
+    tracker.AddFrame(no_sim);
+    CHECK_EQ(tracker.GetStats().frames, 3u);
+}
+
+// Latencies spread evenly over 10..39 ms: histogram, average and percentiles.
+DC_TEST(HistogramAndPercentiles) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    game.frame_ns = 50 * kMs;
+    game.present_ns = 10 * kMs;
+    game.gpu_ns = 10 * kMs;
+    tracker.AddFrame(game.Next());
+    for (int i = 0; i < 300; ++i) {
+        // Input 0..29 ms (+1 ns) before the next sim start -> latency 10..39 ms
+        const int64_t next_sim = game.SimStart(game.next_id);
+        tracker.RecordInput(InputSource::kKeyboard, next_sim - (i % 30) * kMs - 1);
+        tracker.AddFrame(game.Next());
+    }
+    const InputLatencySourceStats keyboard = Source(tracker.GetStats(), InputSource::kKeyboard);
+    REQUIRE(keyboard.samples == 300);
+    CHECK_NEAR(keyboard.min_ms, 10.0, 0.01);
+    CHECK_NEAR(keyboard.max_ms, 39.0, 0.01);
+    CHECK_NEAR(keyboard.avg_ms, 24.5, 0.01);
+    CHECK_NEAR(keyboard.p50_ms, 25.0, 1.0);
+    CHECK_NEAR(keyboard.p95_ms, 38.5, 1.0);
+    CHECK(keyboard.p50_ms <= keyboard.p95_ms && keyboard.p95_ms <= keyboard.p99_ms);
+    CHECK(keyboard.p99_ms <= keyboard.max_ms);
+    uint64_t total = 0;
+    for (size_t b = 0; b < kHistogramBucketCount; ++b) {
+        total += keyboard.histogram[b];
+    }
+    CHECK_EQ(total, 300u);
+    CHECK_EQ(keyboard.histogram[11], 10u);
+    CHECK_EQ(keyboard.histogram[9], 0u);
+}
+
+DC_TEST(OverflowBucketAndReset) {
+    InputLatencyTracker tracker;
+    SyntheticGame game;
+    game.present_ns = 300 * kMs;
+    game.frame_ns = 400 * kMs;
+    tracker.AddFrame(game.Next());
+    tracker.RecordInput(InputSource::kMouse, game.SimStart(2) - 1 * kMs);
+    tracker.AddFrame(game.Next());
+    InputLatencySourceStats mouse = Source(tracker.GetStats(), InputSource::kMouse);
+    CHECK_EQ(mouse.histogram[kHistogramBucketCount - 1], 1u);
+    CHECK_NEAR(mouse.p99_ms, mouse.max_ms, 1e-9);
+
+    tracker.Reset();
+    const InputLatencyStats cleared = tracker.GetStats();
+    CHECK_EQ(cleared.frames, 0u);
+    mouse = Source(cleared, InputSource::kMouse);
+    CHECK_EQ(mouse.samples, 0u);
+    CHECK_EQ(mouse.events, 0u);
+    CHECK_EQ(mouse.histogram[kHistogramBucketCount - 1], 0u);
+}
+
+// Input threads stamping while the consumer feeds frames: every stamp is accounted for exactly once.
+DC_TEST(ConcurrentStampsAreAccountedOnce) {
+    InputLatencyTracker tracker;
+    std::atomic<int64_t> clock{1000 * kMs};
+    std::atomic<bool> stop{false};
+    std::atomic<int> started{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 3; ++t) {
+        producers.emplace_back([&, t] {
+            const InputSource source = static_cast<InputSource>(t);
+            started.fetch_add(1, std::memory_order_acq_rel);
+            while (!stop.load(std::memory_order_acquire)) {
+                tracker.RecordInput(source, clock.load(std::memory_order_relaxed) + 1);
+            }
+        });
+    }
+    while (started.load(std::memory_order_acquire) < 3) {
+        std::this_thread::yield();
+    }
+    uint64_t id = 1;
+    for (int i = 0; i < 20000; ++i) {
+        InputFrameTimeline frame;
+        frame.frame_id = id++;
+        frame.sim_start_ns = clock.fetch_add(kMs, std::memory_order_relaxed) + kMs;
+        frame.present_end_ns = frame.sim_start_ns + 5 * kMs;
+        tracker.AddFrame(frame);
+    }
+    stop.store(true, std::memory_order_release);
+    for (std::thread& t : producers) {
+        t.join();
+    }
+    // Flush what is still pending
+    InputFrameTimeline last;
+    last.frame_id = id;
+    last.sim_start_ns = clock.load() + 10 * kMs;
+    last.present_end_ns = last.sim_start_ns + 5 * kMs;
+    tracker.AddFrame(last);
+
+    const InputLatencyStats stats = tracker.GetStats();
+    for (size_t i = 0; i < kInputSourceCount; ++i) {
+        const InputLatencySourceStats& s = stats.sources[i];
+        CHECK(s.events > 0);
+        CHECK_EQ(s.events, s.samples + s.coalesced + s.stale + s.dropped);
+    }
+}
+
+uint64_t Pack(uint16_t buttons, int16_t lx = 0, uint8_t lt = 0) {
+    return PadChangeDetector::PackState(buttons, lt, 0, lx, 0, 0, 0);
+}
+
+DC_TEST(PadChangeDetectorFiltersNoise) {
+    PadChangeDetector detector;
+    CHECK(!detector.Update(0, 1, Pack(0)));                 // First poll only sets the baseline
+    CHECK(!detector.Update(0, 1, Pack(0x1000)));            // Same packet number: unchanged by definition
+    CHECK(detector.Update(0, 2, Pack(0x1000)));             // Button press
+    CHECK(!detector.Update(0, 3, Pack(0x1000, 1500)));      // Stick jitter below ~3%
+    CHECK(detector.Update(0, 4, Pack(0x1000, 3000)));       // Real movement
+    CHECK(detector.Update(0, 5, Pack(0x1000, 3000, 1)));    // Triggers count exactly
+    CHECK(!detector.Update(1, 9, Pack(0x2000)));            // Slots are independent
+    CHECK(!detector.Update(7, 1, Pack(0)));                 // Out of range
+    detector.Reset();
+    CHECK(!detector.Update(0, 6, Pack(0x4000)));
+}
+
+// Drift: many sub-threshold steps do not add up to an input, the baseline only moves on a reported change.
+DC_TEST(PadChangeDetectorBaselineMovesOnlyOnReport) {
+    PadChangeDetector detector;
+    detector.Update(0, 1, Pack(0, 0));
+    uint32_t packet = 2;
+    int changes = 0;
+    for (int16_t lx = 0; lx < 4096; lx += 256) {
+        changes += detector.Update(0, packet++, Pack(0, lx)) ? 1 : 0;
+    }
+    CHECK_EQ(changes, 1);  // 2048 / 256 = 8 steps of the high byte
+}
+
+}  // namespace
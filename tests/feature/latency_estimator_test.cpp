@@ -0,0 +1,311 @@
+// Source Code <Display Commander> // Software latency estimator tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/latency_estimate/latency_estimator.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace {
+
+using namespace display_commander::feature::latency_estimate;
+
+constexpr int64_t kMs = 1000000;
+constexpr int64_t kUs = 1000;
+constexpr int64_t kPeriod60Hz = 16666667;
+constexpr int64_t kPeriod144Hz = 6944444;
+
+// Synthetic game loop: one frame every interval, present returns sim_to_present after sim start
+struct SyntheticGame {
+    int64_t interval_ns = 16 * kMs;
+    int64_t sim_to_present_ns = 8 * kMs;
+    int64_t gpu_lag_ns = 3 * kMs;  // Present end -> GPU done; < 0: no GPU timing
+    int64_t limiter_sleep_ns = 0;
+    int64_t start_ns = 1000 * kMs;
+    uint64_t next_id = 1;
+
+    EstimatorFrameTimeline Next() {
+        EstimatorFrameTimeline f;
+        f.frame_id = next_id;
+        f.sim_start_ns = start_ns + static_cast<int64_t>(next_id - 1) * interval_ns;
+        f.render_submit_start_ns = f.sim_start_ns + 2 * kMs;
+        f.render_submit_end_ns = f.sim_start_ns + 4 * kMs;
+        f.present_end_ns = f.sim_start_ns + sim_to_present_ns;
+        f.present_start_ns = f.present_end_ns - 500 * kUs;
+        if (limiter_sleep_ns > 0) {
+            f.sleep_pre_present_start_ns = f.present_start_ns - limiter_sleep_ns;
+        }
+        if (gpu_lag_ns >= 0) {
+            f.gpu_done_ns = f.present_end_ns + gpu_lag_ns;
+        }
+        ++next_id;
+        return f;
+    }
+
+    // Runs `frames` frames; returns the last estimate
+    LatencyEstimate Run(LatencyEstimator& estimator, int frames, const EstimatorDisplayTiming& display) {
+        LatencyEstimate e;
+        for (int i = 0; i < frames; ++i) {
+            estimator.AddFrame(Next(), display, &e);
+        }
+        return e;
+    }
+};
+
+EstimatorDisplayTiming Fixed60Hz() { return EstimatorDisplayTiming{kPeriod60Hz, false}; }
+
+DC_TEST(MeasuredTimelineOnFixedRefresh) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    const LatencyEstimate e = game.Run(estimator, 10, Fixed60Hz());
+    CHECK(e.gpu_measured);
+    CHECK(e.scanout_modeled);
+    CHECK_EQ(e.frame_id, 10u);
+    CHECK_EQ(e.sim_to_present_ns, 8 * kMs);
+    CHECK_EQ(e.present_to_gpu_done_ns, 3 * kMs);
+    CHECK_EQ(e.gpu_done_to_scanout_ns, kPeriod60Hz / 2);
+    CHECK_EQ(e.pc_latency_ns, 11 * kMs);
+    // Measured segments have no spread; the scanout wait is anywhere within one refresh
+    CHECK_EQ(e.pc_latency_low_ns, e.pc_latency_ns);
+    CHECK_EQ(e.pc_latency_high_ns, e.pc_latency_ns);
+    CHECK_EQ(e.total_ns, 11 * kMs + kPeriod60Hz / 2);
+    CHECK_EQ(e.total_low_ns, 11 * kMs);
+    CHECK_EQ(e.total_high_ns, 11 * kMs + kPeriod60Hz);
+
+    const LatencyEstimatorStats stats = estimator.GetStats();
+    CHECK_EQ(stats.frames, 10u);
+    CHECK_EQ(stats.gpu_measured_frames, 10u);
+    CHECK_NEAR(stats.frame_interval_ms, 16.0, 1e-9);
+    CHECK_NEAR(stats.refresh_period_ms, 16.666667, 1e-6);
+    CHECK_NEAR(stats.pc_latency_ms, 11.0, 1e-9);
+    CHECK_NEAR(stats.total_ms, 11.0 + 16.666667 / 2, 1e-6);
+}
+
+DC_TEST(LimiterSleepAndPostPresentPacing) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.limiter_sleep_ns = 5 * kMs;
+    LatencyEstimate e;
+    CHECK(estimator.AddFrame(game.Next(), Fixed60Hz(), &e));
+    CHECK_EQ(e.limiter_sleep_ns, 5 * kMs);
+    CHECK_EQ(e.sim_to_present_ns, 8 * kMs);  // The sleep is part of sim -> present
+
+    // Pacing after present: latency ends where the post-present sleep starts
+    EstimatorFrameTimeline f = game.Next();
+    f.sleep_post_present_start_ns = f.present_end_ns - 1 * kMs;
+    CHECK(estimator.AddFrame(f, Fixed60Hz(), &e));
+    CHECK_EQ(e.sim_to_present_ns, 7 * kMs);
+    CHECK_EQ(e.present_to_gpu_done_ns, 4 * kMs);
+}
+
+DC_TEST(FenceBeforePresentReturnCountsAsZero) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    EstimatorFrameTimeline f = game.Next();
+    f.gpu_done_ns = f.present_end_ns - 200 * kUs;
+    LatencyEstimate e;
+    CHECK(estimator.AddFrame(f, Fixed60Hz(), &e));
+    CHECK(e.gpu_measured);
+    CHECK_EQ(e.present_to_gpu_done_ns, 0);
+}
+
+DC_TEST(SkipsIncompleteAndImplausibleFrames) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    EstimatorFrameTimeline no_sim = game.Next();
+    no_sim.sim_start_ns = 0;
+    EstimatorFrameTimeline no_present = game.Next();
+    no_present.present_end_ns = 0;
+    EstimatorFrameTimeline reversed = game.Next();
+    reversed.present_end_ns = reversed.sim_start_ns - 1;
+    EstimatorFrameTimeline stalled = game.Next();
+    stalled.present_end_ns = stalled.sim_start_ns + LatencyEstimator::kMaxPlausibleLatencyNs + 1;
+    for (const EstimatorFrameTimeline& f : {no_sim, no_present, reversed, stalled}) {
+        CHECK(!estimator.AddFrame(f, Fixed60Hz()));
+    }
+    CHECK(estimator.AddFrame(game.Next(), Fixed60Hz()));
+    const LatencyEstimatorStats stats = estimator.GetStats();
+    CHECK_EQ(stats.skipped, 4u);
+    CHECK_EQ(stats.frames, 1u);
+    CHECK_EQ(stats.window_frames, 1u);
+    // Skipped frames with a sim start still feed the frame interval
+    CHECK_NEAR(stats.frame_interval_ms, 16.0, 1e-9);
+}
+
+DC_TEST(GpuLagModeledAfterTrackingStops) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.Run(estimator, 50, Fixed60Hz());
+    game.gpu_lag_ns = -1;
+    const LatencyEstimate steady = game.Run(estimator, 5, Fixed60Hz());
+    CHECK(!steady.gpu_measured);
+    CHECK_EQ(steady.present_to_gpu_done_ns, 3 * kMs);
+    CHECK_EQ(steady.pc_latency_low_ns, steady.pc_latency_high_ns);  // No jitter seen
+
+    // Jittery GPU: the bounds widen around the mean lag
+    LatencyEstimator jittery;
+    SyntheticGame jitter_game;
+    for (int i = 0; i < 200; ++i) {
+        jitter_game.gpu_lag_ns = i % 2 == 0 ? 2 * kMs : 4 * kMs;
+        jittery.AddFrame(jitter_game.Next(), Fixed60Hz());
+    }
+    jitter_game.gpu_lag_ns = -1;
+    LatencyEstimate e;
+    CHECK(jittery.AddFrame(jitter_game.Next(), Fixed60Hz(), &e));
+    CHECK(e.present_to_gpu_done_ns > 2 * kMs && e.present_to_gpu_done_ns < 4 * kMs);
+    CHECK(e.pc_latency_low_ns <= e.sim_to_present_ns + 2 * kMs);
+    CHECK(e.pc_latency_high_ns >= e.sim_to_present_ns + 4 * kMs);
+    CHECK(e.pc_latency_low_ns >= e.sim_to_present_ns);
+    CHECK_EQ(jittery.GetStats().gpu_measured_frames, 200u);
+}
+
+DC_TEST(NoGpuTimingUsesHalfFrameInterval) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.gpu_lag_ns = -1;
+    LatencyEstimate e;
+    // First frame: interval unknown, the sim -> present span stands in
+    CHECK(estimator.AddFrame(game.Next(), Fixed60Hz(), &e));
+    CHECK_EQ(e.present_to_gpu_done_ns, 4 * kMs);
+    CHECK_EQ(e.pc_latency_high_ns, 16 * kMs);
+
+    e = game.Run(estimator, 10, Fixed60Hz());
+    CHECK(!e.gpu_measured);
+    CHECK_EQ(e.present_to_gpu_done_ns, 8 * kMs);
+    CHECK_EQ(e.pc_latency_low_ns, 8 * kMs);
+    CHECK_EQ(e.pc_latency_high_ns, 8 * kMs + 16 * kMs);
+    CHECK_EQ(estimator.GetStats().gpu_measured_frames, 0u);
+}
+
+DC_TEST(VrrInsideRangeHasNoScanoutWait) {
+    const EstimatorDisplayTiming vrr{kPeriod144Hz, true};
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.interval_ns = 10 * kMs;  // 100 FPS on 144 Hz
+    LatencyEstimate e = game.Run(estimator, 20, vrr);
+    CHECK(e.scanout_modeled);
+    CHECK_EQ(e.gpu_done_to_scanout_ns, 0);
+    CHECK_EQ(e.total_high_ns, e.pc_latency_high_ns);
+    CHECK(estimator.GetStats().vrr_active);
+
+    // Above the refresh rate VRR is out of range: frames wait for the next refresh
+    LatencyEstimator fast;
+    SyntheticGame fast_game;
+    fast_game.interval_ns = 5 * kMs;
+    fast_game.sim_to_present_ns = 4 * kMs;
+    fast_game.gpu_lag_ns = 1 * kMs;
+    e = fast_game.Run(fast, 20, vrr);
+    CHECK_EQ(e.gpu_done_to_scanout_ns, kPeriod144Hz / 2);
+    CHECK_EQ(e.total_high_ns, e.pc_latency_high_ns + kPeriod144Hz);
+}
+
+DC_TEST(UnknownRefreshHasNoScanoutTerm) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    const LatencyEstimate e = game.Run(estimator, 5, EstimatorDisplayTiming{});
+    CHECK(!e.scanout_modeled);
+    CHECK_EQ(e.total_ns, e.pc_latency_ns);
+    CHECK_EQ(e.total_high_ns, e.pc_latency_high_ns);
+}
+
+DC_TEST(WindowCoversLastSecond) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.interval_ns = 10 * kMs;
+    game.sim_to_present_ns = 20 * kMs;
+    game.Run(estimator, 300, Fixed60Hz());  // 3 s of 20 ms frames
+    game.sim_to_present_ns = 10 * kMs;
+    game.Run(estimator, 50, Fixed60Hz());  // Last 0.5 s at 10 ms
+    LatencyEstimatorStats stats = estimator.GetStats();
+    CHECK_EQ(stats.window_frames, 101u);  // 1 s of frames at 10 ms, both ends inclusive
+    CHECK_NEAR(stats.sim_to_present_ms, (51 * 20.0 + 50 * 10.0) / 101, 1e-9);
+    // Totals: 13 ms + half a refresh for the new frames, 23 ms + half a refresh for the old ones
+    CHECK_NEAR(stats.total_p50_ms, 23.0 + 16.666667 / 2, 1e-6);
+    CHECK_NEAR(stats.total_p95_ms, 23.0 + 16.666667 / 2, 1e-6);
+
+    game.Run(estimator, 60, Fixed60Hz());
+    stats = estimator.GetStats();
+    CHECK_NEAR(stats.total_p50_ms, 13.0 + 16.666667 / 2, 1e-6);
+    CHECK_NEAR(stats.sim_to_present_ms, 10.0, 1e-9);
+}
+
+DC_TEST(HistoryRingBoundsTheWindow) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.interval_ns = 200 * kUs;  // 5000 FPS: more frames per second than the ring holds
+    game.sim_to_present_ns = 100 * kUs;
+    game.gpu_lag_ns = 50 * kUs;
+    game.Run(estimator, 3000, EstimatorDisplayTiming{});
+    const LatencyEstimatorStats stats = estimator.GetStats();
+    CHECK_EQ(stats.window_frames, LatencyEstimator::kHistoryCapacity);
+    CHECK_EQ(stats.frames, 3000u);
+    CHECK_NEAR(stats.pc_latency_ms, 0.15, 1e-9);
+}
+
+DC_TEST(PauseDoesNotSkewFrameInterval) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.Run(estimator, 20, Fixed60Hz());
+    game.start_ns += 5000 * kMs;  // Loading screen
+    game.Run(estimator, 1, Fixed60Hz());
+    CHECK_NEAR(estimator.GetStats().frame_interval_ms, 16.0, 1e-9);
+}
+
+DC_TEST(CrossValidationAgainstReflex) {
+    LatencyEstimator estimator;
+    estimator.AddReference(10.0);  // Empty window: ignored
+    CHECK_EQ(estimator.GetStats().validations, 0u);
+
+    SyntheticGame game;
+    game.gpu_lag_ns = -1;  // Modeled GPU: pc bounds 8 .. 24 ms, estimate 16 ms
+    game.Run(estimator, 100, Fixed60Hz());
+    estimator.AddReference(12.0);
+    estimator.AddReference(20.0);
+    estimator.AddReference(30.0);  // Outside the bounds
+    estimator.AddReference(0.0);   // No Reflex report: ignored
+    const LatencyEstimatorStats stats = estimator.GetStats();
+    CHECK_EQ(stats.validations, 3u);
+    CHECK_NEAR(stats.last_reference_ms, 30.0, 1e-9);
+    CHECK_NEAR(stats.mean_error_ms, (4.0 - 4.0 - 14.0) / 3, 1e-9);
+    CHECK_NEAR(stats.mean_abs_error_ms, (4.0 + 4.0 + 14.0) / 3, 1e-9);
+    CHECK_NEAR(stats.within_bounds_pct, 200.0 / 3, 1e-9);
+
+    // Measured timeline: a reference within the 1 ms marker tolerance counts as inside
+    LatencyEstimator measured;
+    SyntheticGame measured_game;
+    measured_game.Run(measured, 100, Fixed60Hz());
+    measured.AddReference(11.8);
+    measured.AddReference(13.0);
+    CHECK_NEAR(measured.GetStats().within_bounds_pct, 50.0, 1e-9);
+}
+
+DC_TEST(ResetKeepsDisplayTiming) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.Run(estimator, 30, Fixed60Hz());
+    estimator.AddReference(11.0);
+    estimator.Reset();
+    const LatencyEstimatorStats stats = estimator.GetStats();
+    CHECK_EQ(stats.frames, 0u);
+    CHECK_EQ(stats.window_frames, 0u);
+    CHECK_EQ(stats.validations, 0u);
+    CHECK_NEAR(stats.frame_interval_ms, 0.0, 1e-12);
+    CHECK_NEAR(stats.refresh_period_ms, 16.666667, 1e-6);
+}
+
+DC_TEST(BenchmarkAddFrameAndStats) {
+    LatencyEstimator estimator;
+    SyntheticGame game;
+    game.interval_ns = 4 * kMs;
+    const EstimatorDisplayTiming display = Fixed60Hz();
+    const double add_ns = dc_test::MeasureNsPerOp(200000, [&](size_t) { estimator.AddFrame(game.Next(), display); });
+    unsigned long long sink = 0;
+    const double stats_ns = dc_test::MeasureNsPerOp(2000, [&](size_t) {
+        estimator.AddFrame(game.Next(), display);
+        sink += estimator.GetStats().window_frames;
+    });
+    dc_test::Consume(sink);
+    dc_test::ReportBenchmark("latency estimator AddFrame", add_ns);
+    dc_test::ReportBenchmark("latency estimator AddFrame + GetStats (250-frame window)", stats_ns);
+}
+
+}  // namespace
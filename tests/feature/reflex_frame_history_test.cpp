@@ -0,0 +1,303 @@
+// Source Code <Display Commander> // Reflex frame history tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/reflex_latency/reflex_frame_history.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::feature::reflex_latency;
+
+constexpr uint64_t kBaseUs = 5'000'000'000;  // NVAPI's µs clock is far from zero
+
+// NV_LATENCY_RESULT_PARAMS fixture: a game at frame_us spacing with fixed stage durations. Frame n starts its
+// simulation at kBaseUs + n * frame_us; stages follow each other with the given durations.
+struct ReflexGame {
+    uint64_t frame_us = 16'667;
+    uint64_t input_to_sim_us = 500;
+    uint64_t sim_us = 3'000;
+    uint64_t submit_us = 2'000;
+    uint64_t present_us = 300;
+    uint64_t driver_us = 400;
+    uint64_t queue_us = 1'000;
+    uint64_t gpu_us = 8'000;
+    uint64_t first_id = 1000;
+
+    ReflexFrameReport Frame(uint64_t n) const {
+        ReflexFrameReport r;
+        r.frame_id = first_id + n;
+        r.sim_start_us = kBaseUs + n * frame_us;
+        r.input_sample_us = r.sim_start_us - input_to_sim_us;
+        r.sim_end_us = r.sim_start_us + sim_us;
+        r.render_submit_start_us = r.sim_end_us;
+        r.render_submit_end_us = r.render_submit_start_us + submit_us;
+        r.present_start_us = r.render_submit_end_us;
+        r.present_end_us = r.present_start_us + present_us;
+        r.driver_start_us = r.present_end_us;
+        r.driver_end_us = r.driver_start_us + driver_us;
+        r.os_render_queue_start_us = r.driver_end_us;
+        r.os_render_queue_end_us = r.os_render_queue_start_us + queue_us;
+        r.gpu_render_start_us = r.os_render_queue_end_us;
+        r.gpu_render_end_us = r.gpu_render_start_us + gpu_us;
+        r.gpu_frame_time_us = static_cast<uint32_t>(gpu_us);
+        r.gpu_active_render_time_us = static_cast<uint32_t>(gpu_us);
+        return r;
+    }
+
+    uint64_t PcLatencyUs() const {
+        return input_to_sim_us + sim_us + submit_us + present_us + driver_us + queue_us + gpu_us;
+    }
+
+    // What NvAPI_D3D_GetLatency returns after frame `newest` completed: the last 64 frames, oldest first.
+    std::array<ReflexFrameReport, ReflexFrameHistory::kNvapiReportCount> Poll(uint64_t newest) const {
+        std::array<ReflexFrameReport, ReflexFrameHistory::kNvapiReportCount> reports = {};
+        const size_t count = static_cast<size_t>((std::min)(newest + 1, uint64_t{reports.size()}));
+        for (size_t i = 0; i < count; ++i) {
+            reports[reports.size() - count + i] = Frame(newest + 1 - count + i);
+        }
+        return reports;
+    }
+};
+
+size_t Ingest(ReflexFrameHistory& history, const std::array<ReflexFrameReport, 64>& reports) {
+    return history.Ingest(reports.data(), reports.size());
+}
+
+const ReflexStageStats& Stage(const ReflexFrameHistoryStats& stats, ReflexStatsWindow window, ReflexStage stage) {
+    return stats.stages[static_cast<size_t>(window)][static_cast<size_t>(stage)];
+}
+
+DC_TEST(StageDurationsFromFixture) {
+    const ReflexGame game;
+    const ReflexFrameReport r = game.Frame(10);
+    uint64_t d = 0;
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kSimulation, &d) && d == game.sim_us);
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kRenderSubmit, &d) && d == game.submit_us);
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kPresent, &d) && d == game.present_us);
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kDriver, &d) && d == game.driver_us);
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kOsRenderQueue, &d) && d == game.queue_us);
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kGpuRender, &d) && d == game.gpu_us);
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kPcLatency, &d) && d == game.PcLatencyUs());
+}
+
+DC_TEST(MissingOrReversedStampsAreSkipped) {
+    const ReflexGame game;
+    ReflexFrameReport r = game.Frame(1);
+    uint64_t d = 0;
+    r.driver_start_us = 0;  // Stage not reported
+    CHECK(!ReflexStageDurationUs(r, ReflexStage::kDriver, &d));
+    r.os_render_queue_end_us = r.os_render_queue_start_us - 1;
+    CHECK(!ReflexStageDurationUs(r, ReflexStage::kOsRenderQueue, &d));
+    // No input sample (no input that frame): PC latency starts at simStart
+    r.input_sample_us = 0;
+    CHECK(ReflexStageDurationUs(r, ReflexStage::kPcLatency, &d));
+    CHECK_EQ(d, game.PcLatencyUs() - game.input_to_sim_us);
+    CHECK(!ReflexStageDurationUs(r, ReflexStage::kCount, &d));
+}
+
+DC_TEST(PollingWithinWindowKeepsEveryFrame) {
+    const ReflexGame game;
+    ReflexFrameHistory history;
+    // Poll every 32 frames: each poll overlaps the previous one by 32 frames
+    for (uint64_t newest = 31; newest < 3200; newest += 32) {
+        Ingest(history, game.Poll(newest));
+    }
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    CHECK_EQ(stats.frames, 3200u);
+    CHECK_EQ(stats.overruns, 0u);
+    CHECK_EQ(stats.id_resets, 0u);
+    CHECK_EQ(stats.newest_frame_id, game.first_id + 3199);
+    CHECK_EQ(stats.duplicates, 32u * 99u);
+    CHECK_EQ(Stage(stats, ReflexStatsWindow::kSession, ReflexStage::kGpuRender).samples, 3200u);
+}
+
+DC_TEST(PollingSlowerThanWindowCountsOverruns) {
+    const ReflexGame game;
+    ReflexFrameHistory history;
+    for (uint64_t newest = 99; newest < 1000; newest += 100) {
+        Ingest(history, game.Poll(newest));
+    }
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    CHECK_EQ(stats.frames, 640u);  // 64 per poll
+    CHECK_EQ(stats.overruns, 9u);  // Every poll after the first
+    CHECK_EQ(stats.duplicates, 0u);
+}
+
+DC_TEST(UnusedEntriesAndPartialReportsAreIgnored) {
+    const ReflexGame game;
+    ReflexFrameHistory history;
+    // Game started 10 frames ago: the first 54 entries are unused
+    CHECK_EQ(Ingest(history, game.Poll(9)), 10u);
+    const auto empty = std::array<ReflexFrameReport, 64>{};
+    CHECK_EQ(Ingest(history, empty), 0u);
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    CHECK_EQ(stats.polls, 2u);
+    CHECK_EQ(stats.frames, 10u);
+    CHECK_EQ(stats.overruns, 0u);
+}
+
+DC_TEST(ReportsInAnyOrderAreMerged) {
+    const ReflexGame game;
+    ReflexFrameHistory history;
+    auto reports = game.Poll(200);
+    std::reverse(reports.begin(), reports.end());
+    CHECK_EQ(Ingest(history, reports), 64u);
+    const auto snapshot = history.Snapshot(3);
+    REQUIRE(snapshot.size() == 3u);
+    CHECK_EQ(snapshot[0].frame_id, game.first_id + 200);
+    CHECK_EQ(snapshot[2].frame_id, game.first_id + 198);
+}
+
+DC_TEST(FrameIdRestartIsDetected) {
+    ReflexGame game;
+    ReflexFrameHistory history;
+    Ingest(history, game.Poll(500));
+    // Swapchain re-created: Reflex counts from 1 again, on a later clock
+    ReflexGame restarted = game;
+    restarted.first_id = 1;
+    const ReflexFrameReport first_new = restarted.Frame(0);
+    std::array<ReflexFrameReport, 64> reports = {};
+    for (size_t i = 0; i < 20; ++i) {
+        reports[i] = restarted.Frame(1000 + i);
+        reports[i].frame_id = first_new.frame_id + i;
+    }
+    CHECK_EQ(Ingest(history, reports), 20u);
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    CHECK_EQ(stats.id_resets, 1u);
+    CHECK_EQ(stats.newest_frame_id, 20u);
+    CHECK_EQ(stats.frames, 84u);
+}
+
+DC_TEST(StatsMatchFixtureDurations) {
+    const ReflexGame game;
+    ReflexFrameHistory history;
+    for (uint64_t newest = 31; newest < 1200; newest += 32) {
+        Ingest(history, game.Poll(newest));
+    }
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    for (const ReflexStatsWindow window : {ReflexStatsWindow::k1s, ReflexStatsWindow::k10s,
+                                           ReflexStatsWindow::kSession}) {
+        const ReflexStageStats& gpu = Stage(stats, window, ReflexStage::kGpuRender);
+        CHECK(gpu.samples > 0u);
+        CHECK_NEAR(gpu.min_ms, 8.0, 1e-9);
+        CHECK_NEAR(gpu.max_ms, 8.0, 1e-9);
+        CHECK_NEAR(gpu.avg_ms, 8.0, 1e-9);
+        CHECK_NEAR(gpu.p50_ms, 8.0, 1e-9);  // Clamped to min / max
+        CHECK_NEAR(Stage(stats, window, ReflexStage::kPcLatency).p99_ms, game.PcLatencyUs() / 1000.0, 1e-9);
+    }
+    CHECK_NEAR(stats.frame_interval_ms, 16.667, 0.001);
+}
+
+DC_TEST(WindowsKeepOnlyRecentFrames) {
+    const ReflexGame game;  // 60 fps
+    ReflexFrameHistory history;
+    for (uint64_t newest = 31; newest < 60 * 30; newest += 32) {
+        Ingest(history, game.Poll(newest));
+    }
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    const uint64_t session = Stage(stats, ReflexStatsWindow::kSession, ReflexStage::kSimulation).samples;
+    const uint64_t last_1s = Stage(stats, ReflexStatsWindow::k1s, ReflexStage::kSimulation).samples;
+    const uint64_t last_10s = Stage(stats, ReflexStatsWindow::k10s, ReflexStage::kSimulation).samples;
+    CHECK(session >= 1790u);
+    // 10 slots of 100 ms / 1 s, the newest one partially filled: 0.9..1 s and 9..10 s of frames
+    CHECK(last_1s >= 54u && last_1s <= 61u);
+    CHECK(last_10s >= 540u && last_10s <= 601u);
+}
+
+DC_TEST(PercentilesWithinBucketError) {
+    ReflexFrameHistory history;
+    ReflexGame game;
+    // GPU time 1..100 ms spread over 1000 frames (uniform)
+    std::array<ReflexFrameReport, 64> reports = {};
+    size_t count = 0;
+    for (uint64_t n = 0; n < 1000; ++n) {
+        ReflexFrameReport r = game.Frame(n);
+        r.gpu_render_end_us = r.gpu_render_start_us + 1000 + (n * 99'000) / 999;
+        reports[count++] = r;
+        if (count == reports.size()) {
+            Ingest(history, reports);
+            count = 0;
+        }
+    }
+    history.Ingest(reports.data(), count);
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    const ReflexStageStats& gpu = Stage(stats, ReflexStatsWindow::kSession, ReflexStage::kGpuRender);
+    CHECK_EQ(gpu.samples, 1000u);
+    CHECK_NEAR(gpu.p50_ms, 50.5, 50.5 * 0.035);
+    CHECK_NEAR(gpu.p90_ms, 90.1, 90.1 * 0.035);
+    CHECK_NEAR(gpu.p99_ms, 99.0, 99.0 * 0.035);
+    CHECK_NEAR(gpu.min_ms, 1.0, 1e-9);
+    CHECK_NEAR(gpu.max_ms, 100.0, 1e-9);
+}
+
+DC_TEST(PollIntervalFollowsFrameRate) {
+    CHECK_EQ(ReflexFrameHistory::PollIntervalForFrameIntervalNs(16'666'667), 16'666'667 * 32);
+    CHECK_EQ(ReflexFrameHistory::PollIntervalForFrameIntervalNs(1'000'000), ReflexFrameHistory::kMinPollIntervalNs);
+    CHECK_EQ(ReflexFrameHistory::PollIntervalForFrameIntervalNs(100'000'000), ReflexFrameHistory::kMaxPollIntervalNs);
+    CHECK_EQ(ReflexFrameHistory::PollIntervalForFrameIntervalNs(0), ReflexFrameHistory::kMinPollIntervalNs);
+
+    ReflexFrameHistory history;
+    CHECK_EQ(history.GetPollIntervalNs(), ReflexFrameHistory::kMaxPollIntervalNs);
+    ReflexGame game;
+    game.frame_us = 4'000;  // 250 fps -> 128 ms
+    Ingest(history, game.Poll(100));
+    CHECK_NEAR(history.GetPollIntervalNs(), 128'000'000, 1000);
+}
+
+DC_TEST(RingKeepsNewestFrames) {
+    const ReflexGame game;
+    ReflexFrameHistory history(100);
+    for (uint64_t newest = 31; newest < 320; newest += 32) {
+        Ingest(history, game.Poll(newest));
+    }
+    const auto snapshot = history.Snapshot(1000);
+    REQUIRE(snapshot.size() == 100u);
+    CHECK_EQ(snapshot.front().frame_id, game.first_id + 319);
+    CHECK_EQ(snapshot.back().frame_id, game.first_id + 220);
+    // Capacity below one NVAPI report is raised to it
+    ReflexFrameHistory tiny(8);
+    Ingest(tiny, game.Poll(63));
+    CHECK_EQ(tiny.Snapshot(1000).size(), 64u);
+}
+
+DC_TEST(ResetClearsHistoryAndCounters) {
+    const ReflexGame game;
+    ReflexFrameHistory history;
+    Ingest(history, game.Poll(200));
+    history.Reset();
+    const ReflexFrameHistoryStats stats = history.GetStats();
+    CHECK_EQ(stats.frames, 0u);
+    CHECK_EQ(stats.polls, 0u);
+    CHECK_EQ(Stage(stats, ReflexStatsWindow::kSession, ReflexStage::kGpuRender).samples, 0u);
+    CHECK(history.Snapshot(10).empty());
+    // Same IDs are new again after a reset
+    CHECK_EQ(Ingest(history, game.Poll(200)), 64u);
+}
+
+DC_TEST(ConcurrentIngestAndStats) {
+    const ReflexGame game;
+    ReflexFrameHistory history;
+    std::thread poller([&] {
+        for (uint64_t newest = 31; newest < 32 * 500; newest += 32) {
+            Ingest(history, game.Poll(newest));
+        }
+    });
+    uint64_t last_frames = 0;
+    bool monotonic = true;
+    for (int i = 0; i < 2000; ++i) {
+        const ReflexFrameHistoryStats stats = history.GetStats();
+        monotonic &= stats.frames >= last_frames;
+        last_frames = stats.frames;
+        history.Snapshot(16);
+    }
+    poller.join();
+    CHECK(monotonic);
+    CHECK_EQ(history.GetStats().frames, 32u * 500u);
+}
+
+}  // namespace
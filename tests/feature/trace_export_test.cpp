@@ -0,0 +1,307 @@
+// Source Code <Display Commander> // Trace buffer and Chrome trace JSON tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/trace/trace_buffer.hpp"
+#include "feature/trace/trace_json.hpp"
+
+// Libraries <Standard C++>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::feature::trace;
+
+constexpr int64_t kMs = 1000000;
+
+// Strict JSON syntax check (RFC 8259): the whole text is one value. Counts objects that have a "ph" key.
+class JsonChecker {
+   public:
+    explicit JsonChecker(std::string text) : text_(std::move(text)) {}
+
+    bool Valid() {
+        pos_ = 0;
+        events_ = 0;
+        SkipSpace();
+        if (!Value()) {
+            return false;
+        }
+        SkipSpace();
+        return pos_ == text_.size();
+    }
+
+    size_t ObjectsWithPhase() const { return events_; }
+
+   private:
+    void SkipSpace() {
+        while (pos_ < text_.size() && std::strchr(" \t\r\n", text_[pos_]) != nullptr) {
+            ++pos_;
+        }
+    }
+
+    bool Consume(char c) {
+        SkipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool String(std::string* out) {
+        if (!Consume('"')) {
+            return false;
+        }
+        while (pos_ < text_.size()) {
+            const auto c = static_cast<unsigned char>(text_[pos_++]);
+            if (c == '"') {
+                return true;
+            }
+            if (c < 0x20) {
+                return false;
+            }
+            if (c == '\\') {
+                if (pos_ >= text_.size()) {
+                    return false;
+                }
+                const char e = text_[pos_++];
+                if (e == 'u') {
+                    for (int i = 0; i < 4; ++i) {
+                        if (pos_ >= text_.size() || std::strchr("0123456789abcdefABCDEF", text_[pos_++]) == nullptr) {
+                            return false;
+                        }
+                    }
+                } else if (std::strchr("\"\\/bfnrt", e) == nullptr) {
+                    return false;
+                }
+                out->push_back('?');
+            } else {
+                out->push_back(static_cast<char>(c));
+            }
+        }
+        return false;
+    }
+
+    bool Number() {
+        SkipSpace();
+        const size_t start = pos_;
+        if (pos_ < text_.size() && text_[pos_] == '-') {
+            ++pos_;
+        }
+        const size_t int_start = pos_;
+        while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+            ++pos_;
+        }
+        if (pos_ == int_start || (text_[int_start] == '0' && pos_ - int_start > 1)) {
+            return false;
+        }
+        if (pos_ < text_.size() && text_[pos_] == '.') {
+            const size_t frac_start = ++pos_;
+            while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+                ++pos_;
+            }
+            if (pos_ == frac_start) {
+                return false;
+            }
+        }
+        return pos_ > start;
+    }
+
+    bool Value() {
+        SkipSpace();
+        if (pos_ >= text_.size()) {
+            return false;
+        }
+        const char c = text_[pos_];
+        if (c == '{') {
+            ++pos_;
+            if (Consume('}')) {
+                return true;
+            }
+            do {
+                std::string key;
+                if (!String(&key) || !Consume(':') || !Value()) {
+                    return false;
+                }
+                events_ += key == "ph" ? 1 : 0;
+            } while (Consume(','));
+            return Consume('}');
+        }
+        if (c == '[') {
+            ++pos_;
+            if (Consume(']')) {
+                return true;
+            }
+            do {
+                if (!Value()) {
+                    return false;
+                }
+            } while (Consume(','));
+            return Consume(']');
+        }
+        if (c == '"') {
+            std::string ignored;
+            return String(&ignored);
+        }
+        for (const char* literal : {"true", "false", "null"}) {
+            if (text_.compare(pos_, std::strlen(literal), literal) == 0) {
+                pos_ += std::strlen(literal);
+                return true;
+            }
+        }
+        return Number();
+    }
+
+    std::string text_;
+    size_t pos_ = 0;
+    size_t events_ = 0;
+};
+
+TraceEvent Span(const char* name, int64_t time_ns, int64_t duration_ns, uint32_t tid, uint64_t frame_id = 0) {
+    TraceEvent event;
+    event.time_ns = time_ns;
+    event.duration_ns = duration_ns;
+    event.name = name;
+    event.category = "frame";
+    event.frame_id = frame_id;
+    event.tid = tid;
+    return event;
+}
+
+TraceJsonMetadata TestMetadata() {
+    TraceJsonMetadata metadata;
+    metadata.pid = 1234;
+    metadata.process_name = "game.exe";
+    metadata.origin_ns = 1000 * kMs;
+    metadata.tracks.push_back({1, "Frames: simulation / submit"});
+    metadata.tracks.push_back({4321, "Present"});
+    return metadata;
+}
+
+std::string ToJson(const std::vector<TraceEvent>& events, const TraceJsonMetadata& metadata) {
+    std::ostringstream out;
+    WriteChromeTraceJson(events.data(), events.size(), metadata, out);
+    return out.str();
+}
+
+DC_TEST(BufferKeepsEventsInOrderAndCountsOverflow) {
+    TraceBuffer buffer(3);
+    CHECK_EQ(buffer.Capacity(), 3u);
+    CHECK_EQ(buffer.Size(), 0u);
+    for (int i = 0; i < 5; ++i) {
+        const bool stored = buffer.Append(Span("Present", 1000 * kMs + i * kMs, kMs, 4));
+        CHECK_EQ(stored, i < 3);
+    }
+    CHECK_EQ(buffer.Size(), 3u);
+    CHECK_EQ(buffer.Dropped(), 2u);
+    CHECK_EQ(buffer.Events()[2].time_ns, 1002 * kMs);
+}
+
+DC_TEST(ConcurrentAppendsClaimDistinctSlots) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 5000;
+    TraceBuffer buffer(kThreads * kPerThread - 100);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&buffer, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                buffer.Append(Span("Task", i, 1, static_cast<uint32_t>(t + 1), static_cast<uint64_t>(i + 1)));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK_EQ(buffer.Size(), buffer.Capacity());
+    CHECK_EQ(buffer.Dropped(), 100u);
+    std::vector<int> seen(kThreads * kPerThread, 0);
+    for (size_t i = 0; i < buffer.Size(); ++i) {
+        const TraceEvent& e = buffer.Events()[i];
+        REQUIRE(e.tid >= 1 && e.tid <= kThreads && e.frame_id >= 1 && e.frame_id <= kPerThread);
+        ++seen[(e.tid - 1) * kPerThread + (e.frame_id - 1)];
+    }
+    for (int count : seen) {
+        CHECK(count <= 1);
+    }
+}
+
+DC_TEST(JsonIsValidWithMetadataAndEvents) {
+    std::vector<TraceEvent> events;
+    events.push_back(Span("Simulation", 1001 * kMs, 3 * kMs, 1, 42));
+    TraceEvent marker = Span("PRESENT_START", 1004 * kMs + 1, 0, 4321);
+    marker.phase = TraceEventPhase::kInstant;
+    marker.category = "marker";
+    events.push_back(marker);
+    TraceJsonMetadata metadata = TestMetadata();
+    metadata.dropped_events = 7;
+    const std::string json = ToJson(events, metadata);
+
+    JsonChecker checker(json);
+    REQUIRE(checker.Valid());
+    CHECK_EQ(checker.ObjectsWithPhase(), 1u + metadata.tracks.size() + events.size());
+    CHECK_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    CHECK(json.find("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1234,\"tid\":0,\"args\":{\"name\":\"game.exe\"}}")
+          != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"Present\"}") != std::string::npos);
+    // Microseconds from the origin with nanosecond precision
+    CHECK(json.find("{\"name\":\"Simulation\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":1000.000,\"dur\":3000.000,"
+                    "\"pid\":1234,\"tid\":1,\"args\":{\"frame_id\":42}}")
+          != std::string::npos);
+    CHECK(json.find("\"ph\":\"i\",\"s\":\"t\",\"ts\":4000.001,\"pid\":1234,\"tid\":4321}") != std::string::npos);
+    CHECK(json.find("\"otherData\":{\"dropped_events\":7}") != std::string::npos);
+}
+
+DC_TEST(JsonEscapesNamesAndClampsOddEvents) {
+    std::vector<TraceEvent> events;
+    events.push_back(Span("Quote \" back\\slash\ttab\nnewline\x01", 1000 * kMs, kMs, 4));
+    events.push_back(Span(nullptr, 999 * kMs, -5, 4));  // Before the origin, negative duration, no name
+    events.back().category = nullptr;
+    TraceJsonMetadata metadata = TestMetadata();
+    metadata.process_name = "C:\\Games\\\"odd\".exe";
+    const std::string json = ToJson(events, metadata);
+
+    JsonChecker checker(json);
+    REQUIRE(checker.Valid());
+    CHECK(json.find("\"Quote \\\" back\\\\slash\\ttab\\nnewline\\u0001\"") != std::string::npos);
+    CHECK(json.find("\"C:\\\\Games\\\\\\\"odd\\\".exe\"") != std::string::npos);
+    CHECK(json.find("{\"name\":\"\",\"cat\":\"\",\"ph\":\"X\",\"ts\":-1000.000,\"dur\":0.000,") != std::string::npos);
+
+    std::string escaped;
+    AppendJsonEscaped(&escaped, "\xC3\xA9\x7F");  // UTF-8 and DEL pass through
+    CHECK_EQ(escaped, "\xC3\xA9\x7F");
+}
+
+DC_TEST(LargeTraceStaysValidAcrossFlushes) {
+    // More than one 64 KB flush of the internal buffer
+    TraceBuffer buffer(20000);
+    for (uint64_t i = 0; i < buffer.Capacity(); ++i) {
+        buffer.Append(Span("Present", 1000 * kMs + static_cast<int64_t>(i) * 4 * kMs, kMs, 4, i + 1));
+    }
+    std::ostringstream out;
+    WriteChromeTraceJson(buffer.Events(), buffer.Size(), TestMetadata(), out);
+    const std::string json = out.str();
+    CHECK(json.size() > 1024u * 1024u);
+    JsonChecker checker(json);
+    REQUIRE(checker.Valid());
+    CHECK_EQ(checker.ObjectsWithPhase(), 3u + buffer.Size());
+
+    // Empty trace: only metadata
+    JsonChecker empty(ToJson({}, TestMetadata()));
+    CHECK(empty.Valid());
+    CHECK_EQ(empty.ObjectsWithPhase(), 3u);
+}
+
+DC_TEST(AppendBenchmark) {
+    TraceBuffer buffer(1 << 20);
+    const TraceEvent event = Span("Present", 1000 * kMs, kMs, 4, 1);
+    const double ns = dc_test::MeasureNsPerOp(500000, [&](size_t) { buffer.Append(event); });
+    dc_test::Consume(buffer.Size());
+    dc_test::ReportBenchmark("TraceBuffer::Append", ns);
+}
+
+}  // namespace
@@ -0,0 +1,197 @@
+// Source Code <Display Commander> // VBlank phase lock tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "feature/vblank_replay.hpp"
+#include "feature/vblank_lock/vblank_phase_lock.hpp"
+
+// Libraries <Standard C++>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+using namespace display_commander::feature::vblank_lock;
+
+constexpr int64_t kMs = 1'000'000;
+
+VblankGrid LockedGrid(double period_ns) {
+    VblankGrid grid;
+    grid.reference_vblank_ns = 10 * kMs;
+    grid.period_ns = period_ns;
+    grid.locked = true;
+    return grid;
+}
+
+DC_TEST(GridFindsNextVblank) {
+    const VblankGrid grid = LockedGrid(16.0 * kMs);
+    CHECK_EQ(grid.NextVblankAtOrAfter(10 * kMs), 10 * kMs);
+    CHECK_EQ(grid.NextVblankAtOrAfter(10 * kMs + 1), 26 * kMs);
+    CHECK_EQ(grid.NextVblankAtOrAfter(5 * kMs), 10 * kMs);
+    CHECK_EQ(grid.NextVblankAtOrAfter(100 * kMs), 106 * kMs);
+    CHECK_EQ(VblankGrid{}.NextVblankAtOrAfter(100 * kMs), 0);
+}
+
+DC_TEST(TearLineLeadCoversTheActiveAreaBelowTheLine) {
+    VblankGrid grid = LockedGrid(16.0 * kMs);
+    CHECK_EQ(TearLineLeadNs(grid, 1.0), 0);
+    CHECK_EQ(TearLineLeadNs(grid, 0.5), 8 * kMs);  // No line time: the whole period counts as active
+    grid.line_time_ns = 10'000.0;
+    grid.active_lines = 1000;
+    CHECK_EQ(TearLineLeadNs(grid, 0.0), 10 * kMs);
+    CHECK_EQ(TearLineLeadNs(grid, 0.25), 7'500'000);
+    CHECK_EQ(TearLineLeadNs(grid, -1.0), 10 * kMs);  // Clamped
+}
+
+DC_TEST(SchedulerWaitsForTheLock) {
+    VblankPresentScheduler scheduler;
+    VblankTarget target;
+    target.vblank_ns = 123;
+    VblankGrid grid = LockedGrid(16.0 * kMs);
+    grid.locked = false;
+    CHECK(!scheduler.Schedule(grid, 20 * kMs, 1, kMs, &target));
+    CHECK_EQ(target.vblank_ns, 123);
+    CHECK_EQ(scheduler.GetStats().unlocked_frames, 1u);
+}
+
+DC_TEST(SchedulerKeepsTheIntervalAndCountsMissedVblanks) {
+    const VblankGrid grid = LockedGrid(16.0 * kMs);
+    VblankPresentScheduler scheduler;
+    VblankTarget target;
+    CHECK(scheduler.Schedule(grid, 20 * kMs, 2, kMs, &target));
+    CHECK_EQ(target.vblank_ns, 26 * kMs);
+    CHECK_EQ(target.release_ns, 25 * kMs);
+
+    // Ready early: still waits for the vblank two refreshes later
+    CHECK(scheduler.Schedule(grid, 27 * kMs, 2, kMs, &target));
+    CHECK_EQ(target.vblank_ns, 58 * kMs);
+    CHECK_EQ(target.missed_vblanks, 0u);
+
+    // Ready one refresh after its planned release (89 ms): the next reachable vblank, one missed
+    CHECK(scheduler.Schedule(grid, 95 * kMs, 2, kMs, &target));
+    CHECK_EQ(target.vblank_ns, 106 * kMs);
+    CHECK_EQ(target.missed_vblanks, 1u);
+    CHECK_EQ(target.late_ns, 6 * kMs);
+
+    const VblankSchedulerStats stats = scheduler.GetStats();
+    CHECK_EQ(stats.frames, 3u);
+    CHECK_EQ(stats.late_frames, 1u);
+    CHECK_EQ(stats.missed_vblanks, 1u);
+}
+
+VblankReplayConfig SteadyReplay() {
+    VblankReplayConfig config;
+    config.duration_ns = 5'000'000'000;
+    config.spike_every_frames = 0;
+    return config;
+}
+
+DC_TEST(ReplayLocksWithoutMissingVblanks) {
+    const VblankReplayResult result = RunVblankReplay(SteadyReplay());
+    CHECK(result.lock_stats.locked);
+    CHECK(result.scheduled_frames > result.frames * 9 / 10);
+    CHECK(result.lock_time_ms < 1000.0);
+    CHECK_EQ(result.missed_vblanks, 0u);
+    CHECK_EQ(result.scheduler_missed_vblanks, 0u);
+    CHECK_EQ(result.releases_after_vblank, 0u);
+    CHECK(result.phase_error_rms_us < 50.0);
+    CHECK(std::abs(result.period_error_ppm) < 50.0);
+}
+
+DC_TEST(ReplayFollowsDisplayDrift) {
+    VblankReplayConfig config = SteadyReplay();
+    config.display.drift_ppm = 2000.0;
+    const VblankReplayResult result = RunVblankReplay(config);
+    CHECK(result.lock_stats.locked);
+    CHECK(std::abs(result.lock_stats.drift_ppm - 2000.0) < 100.0);
+    CHECK(std::abs(result.period_error_ppm) < 50.0);
+    CHECK_EQ(result.missed_vblanks, 0u);
+    CHECK(result.phase_error_rms_us < 50.0);
+}
+
+DC_TEST(ReplayMissesVblanksOnlyOnSpikes) {
+    VblankReplayConfig config = SteadyReplay();
+    config.spike_every_frames = 100;
+    const VblankReplayResult result = RunVblankReplay(config);
+    CHECK(result.lock_stats.locked);
+    CHECK(result.missed_vblanks > 0u);
+    // A 25 ms spike costs at most two refreshes at 60 Hz
+    const uint64_t spikes = result.frames / config.spike_every_frames;
+    CHECK(result.missed_vblanks <= 2 * (spikes + 1));
+    CHECK_EQ(result.scheduler_missed_vblanks, result.missed_vblanks);
+    CHECK_EQ(result.releases_after_vblank, 0u);
+}
+
+DC_TEST(ReplayHoldsHalfRefreshAndTearLineTargets) {
+    VblankReplayConfig config = SteadyReplay();
+    config.display.refresh_hz = 120.0;
+    config.interval_vblanks = 2;
+    config.tear_line_fraction = 0.5;
+    const VblankReplayResult result = RunVblankReplay(config);
+    CHECK(result.lock_stats.locked);
+    CHECK_EQ(result.missed_vblanks, 0u);
+    CHECK_EQ(result.releases_after_vblank, 0u);
+    // 5 s at 60 fps, less the frames before the lock
+    CHECK(result.scheduled_frames > 250u);
+    CHECK(result.frames < 310u);
+}
+
+DC_TEST(FallbackPacerSpacesFramesByFrameTime) {
+    VblankFallbackPacer pacer;
+    VblankTarget target = pacer.Schedule(1, 100 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 100 * kMs);
+    CHECK_EQ(target.late_ns, 0);
+    target = pacer.Schedule(1, 104 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 110 * kMs);
+    CHECK_EQ(target.late_ns, 0);
+    target = pacer.Schedule(1, 123 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 120 * kMs);
+    CHECK_EQ(target.late_ns, 3 * kMs);
+    // The late frame moves the cadence to when it was ready
+    target = pacer.Schedule(1, 124 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 133 * kMs);
+}
+
+DC_TEST(FallbackPacerKeepsOneCadencePerSwapchain) {
+    VblankFallbackPacer pacer;
+    pacer.Schedule(1, 100 * kMs, 10.0 * kMs);
+    // A second swapchain does not inherit the first one's release time
+    VblankTarget target = pacer.Schedule(2, 150 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 150 * kMs);
+    CHECK_EQ(target.late_ns, 0);
+    target = pacer.Schedule(1, 105 * kMs + 50 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 110 * kMs);
+    CHECK_EQ(target.late_ns, 45 * kMs);
+    target = pacer.Schedule(2, 151 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 160 * kMs);
+}
+
+DC_TEST(FallbackPacerRestartsAfterIdleOrForget) {
+    VblankFallbackPacer pacer;
+    pacer.Schedule(1, 100 * kMs, 10.0 * kMs);
+    VblankTarget target = pacer.Schedule(1, 100 * kMs + VblankFallbackPacer::kIdleRestartNs + 1, 10.0 * kMs);
+    CHECK_EQ(target.late_ns, 0);
+    CHECK_EQ(target.release_ns, 100 * kMs + VblankFallbackPacer::kIdleRestartNs + 1);
+
+    pacer.Schedule(3, 2000 * kMs, 10.0 * kMs);
+    pacer.Forget(3);
+    target = pacer.Schedule(3, 2050 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 2050 * kMs);
+    CHECK_EQ(target.late_ns, 0);
+}
+
+DC_TEST(FallbackPacerEvictsTheLeastRecentSwapchain) {
+    VblankFallbackPacer pacer;
+    for (uint64_t key = 0; key < VblankFallbackPacer::kMaxSwapchains; ++key) {
+        pacer.Schedule(key, static_cast<int64_t>(100 + key) * kMs, 10.0 * kMs);
+    }
+    // Swapchain 0 presents again, so swapchain 1 is now the least recent
+    pacer.Schedule(0, 200 * kMs, 10.0 * kMs);
+    pacer.Schedule(99, 205 * kMs, 10.0 * kMs);
+    VblankTarget target = pacer.Schedule(0, 206 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 210 * kMs);
+    target = pacer.Schedule(1, 207 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 207 * kMs);  // Evicted: new cadence
+    target = pacer.Schedule(99, 208 * kMs, 10.0 * kMs);
+    CHECK_EQ(target.release_ns, 215 * kMs);
+}
+
+}  // namespace
@@ -0,0 +1,159 @@
+// Source Code <Display Commander> // VBlank phase lock replay harness for tests (platform-neutral, no Windows includes)
+#include "vblank_replay.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <cmath>
+
+namespace display_commander::feature::vblank_lock {
+
+SyntheticVblankSource::SyntheticVblankSource(const SyntheticVblankConfig& config)
+    : config_(config), rng_state_(config.seed != 0 ? config.seed : 1) {
+    const double nominal_ns = 1'000'000'000.0 / (std::max)(config.refresh_hz, 1.0);
+    period_ns_ = nominal_ns * (1.0 + config.drift_ppm / 1'000'000.0);
+    const uint32_t total_lines = (std::max)(config.total_lines, config.active_lines + 1);
+    vblank_ns_ = period_ns_ * static_cast<double>(total_lines - config.active_lines) / static_cast<double>(total_lines);
+}
+
+int64_t SyntheticVblankSource::NominalPeriodNs() const {
+    return static_cast<int64_t>(std::llround(1'000'000'000.0 / (std::max)(config_.refresh_hz, 1.0)));
+}
+
+int64_t SyntheticVblankSource::NextVblankAtOrAfter(int64_t time_ns) const {
+    const double n = std::ceil(static_cast<double>(time_ns - config_.first_vblank_ns) / period_ns_);
+    return config_.first_vblank_ns + static_cast<int64_t>(std::llround(n * period_ns_));
+}
+
+uint32_t SyntheticVblankSource::NextRandom() {
+    // xorshift32: deterministic runs for a given seed
+    rng_state_ ^= rng_state_ << 13;
+    rng_state_ ^= rng_state_ >> 17;
+    rng_state_ ^= rng_state_ << 5;
+    return rng_state_;
+}
+
+int64_t SyntheticVblankSource::Uniform(int64_t max_ns) {
+    if (max_ns <= 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(NextRandom() % static_cast<uint32_t>((std::min)(max_ns + 1, int64_t{UINT32_MAX})));
+}
+
+VblankObservation SyntheticVblankSource::WaitForVblank(int64_t time_ns) {
+    VblankObservation o;
+    o.from_wait = true;
+    o.time_ns = NextVblankAtOrAfter(time_ns) + config_.wait_latency_ns + Uniform(config_.wait_jitter_ns);
+    return o;
+}
+
+VblankObservation SyntheticVblankSource::ReadScanline(int64_t time_ns) {
+    VblankObservation o;
+    o.time_ns = time_ns;
+    const int64_t read_ns =
+        time_ns + Uniform(2 * config_.scanline_read_jitter_ns) - config_.scanline_read_jitter_ns;
+    const int64_t vblank_start_ns = NextVblankAtOrAfter(read_ns + 1) - static_cast<int64_t>(std::llround(period_ns_));
+    const double into_period_ns = static_cast<double>(read_ns - vblank_start_ns);
+    if (into_period_ns < vblank_ns_) {
+        o.in_vblank = true;
+        return o;
+    }
+    const double line_ns = (period_ns_ - vblank_ns_) / static_cast<double>(config_.active_lines);
+    o.scanline = (std::min)(static_cast<uint32_t>((into_period_ns - vblank_ns_) / line_ns), config_.active_lines - 1);
+    return o;
+}
+
+VblankReplayResult RunVblankReplay(const VblankReplayConfig& config) {
+    SyntheticVblankSource source(config.display);
+    VblankPhaseLock lock;
+    lock.SetGeometry(source.NominalPeriodNs(), config.display.active_lines);
+    VblankPresentScheduler scheduler;
+    VblankReplayResult result;
+
+    // Monitor thread: wait for vblank, then read the scanline evenly spaced across the refresh
+    const uint32_t reads = config.scanline_reads_per_refresh;
+    const double period_ns = source.TruePeriodNs();
+    int64_t monitor_ns = 0;
+    VblankObservation pending = source.WaitForVblank(monitor_ns);
+    uint32_t pending_read = 0;  // 0 = pending is the wait, n = n-th read after it
+    int64_t pending_wait_ns = pending.time_ns;
+    auto feed_until = [&](int64_t time_ns) {
+        while (pending.time_ns <= time_ns) {
+            lock.AddObservation(pending);
+            if (pending_read < reads) {
+                ++pending_read;
+                const double offset_ns = period_ns * pending_read / (reads + 1);
+                pending = source.ReadScanline(pending_wait_ns + static_cast<int64_t>(offset_ns));
+            } else {
+                monitor_ns = pending.time_ns;
+                pending = source.WaitForVblank(monitor_ns);
+                pending_wait_ns = pending.time_ns;
+                pending_read = 0;
+            }
+        }
+    };
+
+    // Flip happens at the first vblank after present is issued
+    int64_t last_flip_ns = 0;
+    double error_sq_sum = 0.0;
+    int64_t frame_ns = 0;
+    uint32_t work_rng = config.display.seed * 2654435761u + 1;  // Frame cost jitter, independent of display noise
+    while (frame_ns < config.duration_ns) {
+        ++result.frames;
+        work_rng ^= work_rng << 13;
+        work_rng ^= work_rng >> 17;
+        work_rng ^= work_rng << 5;
+        int64_t work_ns = config.frame_work_ns;
+        if (config.frame_work_jitter_ns > 0) {
+            work_ns += static_cast<int64_t>(work_rng % static_cast<uint32_t>(config.frame_work_jitter_ns + 1));
+        }
+        if (config.spike_every_frames > 0 && result.frames % config.spike_every_frames == 0) {
+            work_ns += config.spike_ns;
+        }
+        const int64_t ready_ns = frame_ns + work_ns;
+        feed_until(ready_ns);
+
+        const VblankGrid grid = lock.GetGrid();
+        int64_t lead_ns = config.lead_ns;
+        if (config.tear_line_fraction >= 0.0) {
+            lead_ns += TearLineLeadNs(grid, config.tear_line_fraction);
+        }
+        VblankTarget target;
+        int64_t release_ns = ready_ns;
+        if (scheduler.Schedule(grid, ready_ns, config.interval_vblanks, lead_ns, &target)) {
+            if (result.scheduled_frames == 0) {
+                result.lock_time_ms = static_cast<double>(ready_ns) / 1'000'000.0;
+            }
+            ++result.scheduled_frames;
+            release_ns = (std::max)(target.release_ns, ready_ns);
+            const int64_t true_vblank_ns =
+                source.NextVblankAtOrAfter(target.vblank_ns - static_cast<int64_t>(period_ns / 2.0));
+            const double error_ns = static_cast<double>(target.vblank_ns - true_vblank_ns);
+            error_sq_sum += error_ns * error_ns;
+            result.phase_error_max_us = (std::max)(result.phase_error_max_us, std::fabs(error_ns) / 1'000.0);
+            if (release_ns >= true_vblank_ns) {
+                ++result.releases_after_vblank;
+            }
+            const int64_t flip_ns = source.NextVblankAtOrAfter(release_ns);
+            if (last_flip_ns > 0) {
+                const int64_t refreshes = std::llround(static_cast<double>(flip_ns - last_flip_ns) / period_ns);
+                if (refreshes > static_cast<int64_t>(config.interval_vblanks)) {
+                    result.missed_vblanks += static_cast<uint64_t>(refreshes - config.interval_vblanks);
+                }
+            }
+            last_flip_ns = flip_ns;
+        } else {
+            last_flip_ns = 0;
+        }
+        frame_ns = release_ns;
+    }
+
+    if (result.scheduled_frames > 0) {
+        result.phase_error_rms_us = std::sqrt(error_sq_sum / static_cast<double>(result.scheduled_frames)) / 1'000.0;
+    }
+    result.period_error_ppm = (lock.GetGrid().period_ns / period_ns - 1.0) * 1'000'000.0;
+    result.scheduler_missed_vblanks = scheduler.GetStats().missed_vblanks;
+    result.lock_stats = lock.GetStats();
+    return result;
+}
+
+}  // namespace display_commander::feature::vblank_lock
@@ -0,0 +1,80 @@
+// Source Code <Display Commander> // VBlank phase lock replay harness for tests (platform-neutral, no Windows includes)
+#pragma once
+
+#include "feature/vblank_lock/vblank_phase_lock.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+
+namespace display_commander::feature::vblank_lock {
+
+struct SyntheticVblankConfig {
+    double refresh_hz = 60.0;  // Nominal refresh rate (what the OS reports)
+    double drift_ppm = 0.0;    // True period vs nominal (display clock mismatch)
+    int64_t first_vblank_ns = 1'000'000;
+    uint32_t active_lines = 1080;
+    uint32_t total_lines = 1125;
+    int64_t wait_latency_ns = 50'000;      // Minimum wake-up delay of a vblank wait
+    int64_t wait_jitter_ns = 150'000;      // Extra wake-up delay, uniform 0 .. jitter
+    int64_t scanline_read_jitter_ns = 2'000;  // Read time vs reported time, uniform +- jitter
+    uint32_t seed = 1;
+};
+
+// Display with an exact vblank timeline, answering vblank waits and scanline reads like D3DKMT does (with
+// wake-up delay and read jitter). Time is simulated: nothing blocks.
+class SyntheticVblankSource {
+   public:
+    explicit SyntheticVblankSource(const SyntheticVblankConfig& config);
+
+    int64_t NominalPeriodNs() const;
+    double TruePeriodNs() const { return period_ns_; }
+
+    // True start of the first vblank at or after time_ns.
+    int64_t NextVblankAtOrAfter(int64_t time_ns) const;
+
+    // Return of a vblank wait started at time_ns.
+    VblankObservation WaitForVblank(int64_t time_ns);
+    // Scanline read reported at time_ns.
+    VblankObservation ReadScanline(int64_t time_ns);
+
+   private:
+    uint32_t NextRandom();
+    int64_t Uniform(int64_t max_ns);  // 0 .. max_ns
+
+    SyntheticVblankConfig config_;
+    double period_ns_ = 0.0;
+    double vblank_ns_ = 0.0;  // Duration of the vblank at the start of each period
+    uint32_t rng_state_ = 1;
+};
+
+struct VblankReplayConfig {
+    SyntheticVblankConfig display;
+    int64_t duration_ns = 10'000'000'000;
+    uint32_t interval_vblanks = 1;
+    int64_t lead_ns = 1'000'000;         // Present this long before vblank
+    double tear_line_fraction = -1.0;    // >= 0: add the lead that targets this tear line
+    uint32_t scanline_reads_per_refresh = 2;
+    int64_t frame_work_ns = 8'000'000;    // Game frame cost before present
+    int64_t frame_work_jitter_ns = 2'000'000;  // Uniform 0 .. jitter on top
+    uint32_t spike_every_frames = 200;    // 0 = no spikes
+    int64_t spike_ns = 25'000'000;
+};
+
+struct VblankReplayResult {
+    uint64_t frames = 0;
+    uint64_t scheduled_frames = 0;  // Frames presented on a locked grid
+    double lock_time_ms = 0.0;      // Until the first scheduled frame
+    double phase_error_rms_us = 0.0;  // Predicted vs true vblank of each scheduled frame
+    double phase_error_max_us = 0.0;
+    double period_error_ppm = 0.0;    // Final period estimate vs true period
+    uint64_t missed_vblanks = 0;      // True timeline: refreshes between flips beyond the interval (repeated frames)
+    uint64_t scheduler_missed_vblanks = 0;  // What the scheduler detected
+    uint64_t releases_after_vblank = 0;     // Present issued after its target vblank had started
+    VblankPhaseLockStats lock_stats;
+};
+
+// Runs a game loop against a synthetic display through VblankPhaseLock and VblankPresentScheduler. Missed vblanks
+// in a run without spikes and with frame work below the target interval mean the lock or scheduler is off.
+VblankReplayResult RunVblankReplay(const VblankReplayConfig& config);
+
+}  // namespace display_commander::feature::vblank_lock
@@ -0,0 +1,255 @@
+// Source Code <Display Commander> // Key state tracker tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "hooks/windows_hooks/keyboard_state_tracker.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commanderhooks::keyboard_tracker;
+
+constexpr int64_t kMs = 1000000;
+constexpr int kVkControl = 0x11;
+constexpr int kVkK = 0x4B;
+constexpr int kVkF10 = 0x79;
+
+bool Held(const KeyPress& press, int vk) { return (press.held[static_cast<size_t>(vk) >> 6] >> (vk & 63)) & 1; }
+
+DC_TEST(DuplicateReportsProduceOneEdge) {
+    KeyStateTracker tracker;
+    CHECK(tracker.SetKeyState(kVkK, true, KeyEdgeSource::kMessage, 1 * kMs));
+    // Same key down seen by GetMessage and the window proc, then auto-repeat
+    CHECK(!tracker.SetKeyState(kVkK, true, KeyEdgeSource::kMessage, 1 * kMs));
+    CHECK(!tracker.SetKeyState(kVkK, true, KeyEdgeSource::kRawInput, 2 * kMs));
+    CHECK(tracker.IsDown(kVkK));
+    CHECK_EQ(tracker.DrainEdges(), 1u);
+    CHECK(tracker.IsPressed(kVkK));
+    CHECK_EQ(tracker.GetPresses().size(), 1u);
+    CHECK_EQ(tracker.GetStats().edges[static_cast<size_t>(KeyEdgeSource::kMessage)], 1u);
+}
+
+DC_TEST(TapShorterThanPassIsPressed) {
+    KeyStateTracker tracker;
+    tracker.SetKeyState(kVkF10, true, KeyEdgeSource::kMessage, 1 * kMs);
+    tracker.SetKeyState(kVkF10, false, KeyEdgeSource::kMessage, 3 * kMs);
+    CHECK(!tracker.IsDown(kVkF10));
+    CHECK_EQ(tracker.DrainEdges(), 2u);
+    CHECK(tracker.IsPressed(kVkF10));
+    REQUIRE(tracker.GetPresses().size() == 1u);
+    CHECK_EQ(tracker.GetPresses()[0].time_ns, 1 * kMs);
+
+    tracker.ResetFrame();
+    CHECK(!tracker.IsPressed(kVkF10));
+    CHECK(tracker.GetPresses().empty());
+}
+
+DC_TEST(PressesKeepOrderAndHeldKeys) {
+    KeyStateTracker tracker;
+    tracker.SetKeyState(kVkControl, true, KeyEdgeSource::kMessage, 1 * kMs);
+    tracker.SetKeyState(kVkK, true, KeyEdgeSource::kMessage, 2 * kMs);
+    tracker.SetKeyState(kVkK, false, KeyEdgeSource::kMessage, 3 * kMs);
+    tracker.SetKeyState(kVkControl, false, KeyEdgeSource::kMessage, 4 * kMs);
+    tracker.SetKeyState(kVkK, true, KeyEdgeSource::kMessage, 5 * kMs);
+    tracker.DrainEdges();
+
+    const auto presses = tracker.GetPresses();
+    REQUIRE(presses.size() == 3u);
+    CHECK_EQ(presses[0].vk, kVkControl);
+    CHECK_EQ(presses[1].vk, kVkK);
+    CHECK(Held(presses[1], kVkControl));  // Ctrl+K chord
+    CHECK(Held(presses[1], kVkK));
+    CHECK_EQ(presses[2].vk, kVkK);
+    CHECK(!Held(presses[2], kVkControl));  // K alone, even though drained in the same pass
+}
+
+DC_TEST(PressesBeyondCapacityOnlySetPressedBit) {
+    KeyStateTracker tracker;
+    for (size_t i = 0; i < KeyStateTracker::kMaxFramePresses + 10; ++i) {
+        const int vk = 0x30 + static_cast<int>(i % 2);
+        tracker.SetKeyState(vk, true, KeyEdgeSource::kMessage, static_cast<int64_t>(i));
+        tracker.SetKeyState(vk, false, KeyEdgeSource::kMessage, static_cast<int64_t>(i));
+    }
+    tracker.SetKeyState(kVkF10, true, KeyEdgeSource::kMessage, 1000);
+    tracker.DrainEdges();
+    CHECK_EQ(tracker.GetPresses().size(), KeyStateTracker::kMaxFramePresses);
+    CHECK(tracker.IsPressed(kVkF10));
+}
+
+DC_TEST(ReconcileFixesMissedTransitions) {
+    KeyStateTracker tracker;
+    // Key up lost to focus loss: the poll sees it released
+    tracker.SetKeyState(kVkK, true, KeyEdgeSource::kMessage, 1 * kMs);
+    tracker.DrainEdges();
+    tracker.ResetFrame();
+    CHECK(!tracker.Reconcile(kVkK, true, 2 * kMs));  // Agrees: no edge
+    CHECK(tracker.Reconcile(kVkK, false, 3 * kMs));
+    CHECK(!tracker.IsDown(kVkK));
+
+    // Key down filtered before the hooks: the poll produces the press
+    CHECK(tracker.Reconcile(kVkF10, true, 4 * kMs));
+    tracker.DrainEdges();
+    CHECK(tracker.IsPressed(kVkF10));
+    REQUIRE(tracker.GetPresses().size() == 1u);
+    CHECK(tracker.GetPresses()[0].source == KeyEdgeSource::kPoll);
+
+    const KeyboardTrackerStats stats = tracker.GetStats();
+    CHECK_EQ(stats.edges[static_cast<size_t>(KeyEdgeSource::kPoll)], 2u);
+    CHECK_EQ(stats.edges[static_cast<size_t>(KeyEdgeSource::kMessage)], 1u);
+}
+
+DC_TEST(ResponseTimeOncePerPressAndNotForPolls) {
+    KeyStateTracker tracker;
+    tracker.SetKeyState(kVkF10, true, KeyEdgeSource::kMessage, 10 * kMs);
+    tracker.DrainEdges();
+    tracker.ReportHotkeyHandled(kVkF10, 12 * kMs);
+    tracker.ReportHotkeyHandled(kVkF10, 20 * kMs);  // Same press: ignored
+    KeyboardTrackerStats stats = tracker.GetStats();
+    CHECK_EQ(stats.hotkey_responses, 1u);
+    CHECK_EQ(stats.last_response_ns, 2 * kMs);
+
+    // A poll only bounds when the key went down
+    tracker.SetKeyState(kVkF10, false, KeyEdgeSource::kMessage, 30 * kMs);
+    tracker.Reconcile(kVkF10, true, 40 * kMs);
+    tracker.DrainEdges();
+    tracker.ReportHotkeyHandled(kVkF10, 41 * kMs);
+    stats = tracker.GetStats();
+    CHECK_EQ(stats.hotkey_responses, 1u);
+
+    tracker.SetKeyState(kVkF10, false, KeyEdgeSource::kMessage, 50 * kMs);
+    tracker.SetKeyState(kVkF10, true, KeyEdgeSource::kRawInput, 60 * kMs);
+    tracker.DrainEdges();
+    tracker.ReportHotkeyHandled(kVkF10, 66 * kMs);
+    stats = tracker.GetStats();
+    CHECK_EQ(stats.hotkey_responses, 2u);
+    CHECK_EQ(stats.max_response_ns, 6 * kMs);
+    CHECK_EQ(stats.avg_response_ns, 4 * kMs);
+}
+
+DC_TEST(QueueOverflowKeepsPressedAndState) {
+    KeyStateTracker tracker;
+    // Fill the queue without draining: 256 edges from 128 down/up pairs
+    for (uint32_t i = 0; i < KeyStateTracker::kQueueCapacity / 2; ++i) {
+        tracker.SetKeyState(0x30, true, KeyEdgeSource::kMessage, i);
+        tracker.SetKeyState(0x30, false, KeyEdgeSource::kMessage, i);
+    }
+    CHECK(tracker.SetKeyState(kVkF10, true, KeyEdgeSource::kMessage, 1000));
+    CHECK_EQ(tracker.GetStats().queue_overflows, 1u);
+    CHECK(tracker.IsDown(kVkF10));
+    tracker.DrainEdges();
+    CHECK(tracker.IsPressed(kVkF10));
+
+    // The replay resynced: a later chord sees F10 held
+    tracker.ResetFrame();
+    tracker.SetKeyState(kVkK, true, KeyEdgeSource::kMessage, 2000);
+    tracker.DrainEdges();
+    REQUIRE(tracker.GetPresses().size() == 1u);
+    CHECK(Held(tracker.GetPresses()[0], kVkF10));
+}
+
+DC_TEST(InvalidKeysAreIgnored) {
+    KeyStateTracker tracker;
+    CHECK(!tracker.SetKeyState(-1, true, KeyEdgeSource::kMessage, 0));
+    CHECK(!tracker.SetKeyState(256, true, KeyEdgeSource::kMessage, 0));
+    CHECK(!tracker.Reconcile(300, true, 0));
+    CHECK(!tracker.IsDown(256));
+    CHECK(!tracker.IsPressed(-5));
+    CHECK_EQ(tracker.DrainEdges(), 0u);
+}
+
+DC_TEST(ConcurrentProducersLoseNoEdges) {
+    KeyStateTracker tracker;
+    constexpr int kThreads = 4;
+    constexpr int kTapsPerThread = 20000;
+    std::atomic<int> done{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&tracker, &done, t] {
+            const int vk = 0x41 + t;  // One key per thread: every report is an edge
+            for (int i = 0; i < kTapsPerThread; ++i) {
+                tracker.SetKeyState(vk, true, KeyEdgeSource::kMessage, i);
+                tracker.SetKeyState(vk, false, KeyEdgeSource::kMessage, i);
+            }
+            done.fetch_add(1);
+        });
+    }
+    uint64_t drained = 0;
+    while (done.load() < kThreads) {
+        drained += tracker.DrainEdges();
+        tracker.ResetFrame();
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    drained += tracker.DrainEdges();
+
+    const KeyboardTrackerStats stats = tracker.GetStats();
+    CHECK_EQ(stats.edges[static_cast<size_t>(KeyEdgeSource::kMessage)],
+             static_cast<uint64_t>(kThreads) * kTapsPerThread * 2);
+    CHECK_EQ(drained + stats.queue_overflows, stats.edges[static_cast<size_t>(KeyEdgeSource::kMessage)]);
+    for (int t = 0; t < kThreads; ++t) {
+        CHECK(!tracker.IsDown(0x41 + t));
+    }
+}
+
+DC_TEST(ReconcileScheduleBeforeAndAfterEventTraffic) {
+    ReconcileSchedule schedule;
+    constexpr int64_t kPoll = 10 * kMs;
+    CHECK_EQ(schedule.UpdateIntervalNs(kPoll, false), kPoll);
+    CHECK(schedule.ShouldReconcile(1 * kMs, false, false));
+    CHECK(schedule.ShouldReconcile(2 * kMs, false, false));
+
+    schedule.OnEventTraffic();
+    CHECK_EQ(schedule.UpdateIntervalNs(kPoll, false), ReconcileSchedule::kReconcileIntervalNs);
+    CHECK(!schedule.ShouldReconcile(100 * kMs, false, false));
+    CHECK(schedule.ShouldReconcile(100 * kMs, false, true));  // Requested (focus loss)
+    CHECK(!schedule.ShouldReconcile(200 * kMs, false, false));
+    CHECK(schedule.ShouldReconcile(350 * kMs, false, false));
+}
+
+DC_TEST(ReconcileScheduleBackgroundPollsEveryPass) {
+    ReconcileSchedule schedule;
+    schedule.OnEventTraffic();
+    constexpr int64_t kPoll = 10 * kMs;
+    CHECK_EQ(schedule.UpdateIntervalNs(kPoll, true), kPoll);
+    CHECK(!schedule.ShouldReconcile(1 * kMs, false, false));
+    CHECK(schedule.ShouldReconcile(11 * kMs, true, false));
+    CHECK(schedule.ShouldReconcile(21 * kMs, true, false));
+    // Back in foreground: events again, reconcile interval from the last background poll
+    CHECK(!schedule.ShouldReconcile(31 * kMs, false, false));
+    CHECK(schedule.ShouldReconcile(21 * kMs + ReconcileSchedule::kReconcileIntervalNs, false, false));
+}
+
+// Game in background after key events were seen: no key messages arrive, the only source is polling. A tap of
+// tap_ms at every phase must be pressed at least once when the monitoring thread runs at the interval the schedule
+// asks for.
+DC_TEST(BackgroundTapsShorterThanReconcileIntervalAreSeen) {
+    constexpr int64_t kPoll = 10 * kMs;
+    for (int64_t tap_ms : {15, 40, 120}) {
+        for (int64_t phase = 0; phase < 50 * kMs; phase += 3 * kMs) {
+            KeyStateTracker tracker;
+            ReconcileSchedule schedule;
+            schedule.OnEventTraffic();
+            const int64_t tap_start = 1000 * kMs + phase;
+            const int64_t tap_end = tap_start + tap_ms * kMs;
+            int presses = 0;
+            int64_t now = 0;
+            while (now < 2000 * kMs) {
+                tracker.DrainEdges();
+                if (schedule.ShouldReconcile(now, true, false)) {
+                    tracker.Reconcile(kVkF10, now >= tap_start && now < tap_end, now);
+                    tracker.DrainEdges();
+                }
+                presses += tracker.IsPressed(kVkF10) ? 1 : 0;
+                tracker.ResetFrame();
+                now += schedule.UpdateIntervalNs(kPoll, true);
+            }
+            CHECK_EQ(presses, 1);
+        }
+    }
+}
+
+}  // namespace
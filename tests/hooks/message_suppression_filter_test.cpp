@@ -0,0 +1,266 @@
+// Source Code <Display Commander> // Message suppression filter tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "hooks/windows_hooks/message_suppression_filter.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commanderhooks;
+
+// Message ids from winuser.h
+constexpr uint32_t kWmSetCursor = 0x0020;
+constexpr uint32_t kWmKeyDown = 0x0100;
+constexpr uint32_t kWmKeyUp = 0x0101;
+constexpr uint32_t kWmChar = 0x0102;
+constexpr uint32_t kWmSysKeyDown = 0x0104;
+constexpr uint32_t kWmSysKeyUp = 0x0105;
+constexpr uint32_t kWmTimer = 0x0113;
+constexpr uint32_t kWmInput = 0x00FF;
+constexpr uint32_t kWmPaint = 0x000F;
+constexpr uint32_t kWmMouseMove = 0x0200;
+constexpr uint32_t kWmLButtonDown = 0x0201;
+constexpr uint32_t kWmLButtonUp = 0x0202;
+constexpr uint32_t kWmMouseWheel = 0x020A;
+constexpr uint32_t kWmXButtonUp = 0x020C;
+constexpr uint32_t kWmRegisteredFirst = 0xC000;
+
+constexpr uint32_t kAllClasses = kKeyboardMessageClasses | kMouseMessageClasses;
+
+DC_TEST(ClassifiesDownsOnly) {
+    CHECK(ClassifyMessage(kWmKeyDown) == MessageClass::kKeyDown);
+    CHECK(ClassifyMessage(kWmSysKeyDown) == MessageClass::kKeyDown);
+    CHECK(ClassifyMessage(kWmChar) == MessageClass::kChar);
+    CHECK(ClassifyMessage(kWmLButtonDown) == MessageClass::kMouseButton);
+    CHECK(ClassifyMessage(kWmMouseMove) == MessageClass::kMouseMove);
+    CHECK(ClassifyMessage(kWmMouseWheel) == MessageClass::kMouseWheel);
+    CHECK(ClassifyMessage(kWmSetCursor) == MessageClass::kCursor);
+    // Ups always pass so nothing stays stuck
+    for (uint32_t msg : {kWmKeyUp, kWmSysKeyUp, kWmLButtonUp, kWmXButtonUp, kWmTimer, kWmInput, kWmPaint}) {
+        CHECK(ClassifyMessage(msg) == MessageClass::kOther);
+    }
+}
+
+DC_TEST(KeyboardAndMouseMasksAreSeparate) {
+    MessageSuppressionFilter filter;
+    CHECK(!filter.IsBlocked(kWmKeyDown));
+
+    CHECK(filter.SetBlockedClasses(kKeyboardMessageClasses));
+    CHECK(filter.IsBlocked(kWmKeyDown));
+    CHECK(filter.IsBlocked(kWmChar));
+    CHECK(!filter.IsBlocked(kWmKeyUp));
+    CHECK(!filter.IsBlocked(kWmMouseMove));
+    CHECK(!filter.IsBlocked(kWmLButtonDown));
+
+    CHECK(filter.SetBlockedClasses(kMouseMessageClasses));
+    CHECK(!filter.IsBlocked(kWmKeyDown));
+    CHECK(filter.IsBlocked(kWmMouseMove));
+    CHECK(filter.IsBlocked(kWmLButtonDown));
+    CHECK(filter.IsBlocked(kWmSetCursor));
+    CHECK(!filter.IsBlocked(kWmLButtonUp));
+
+    CHECK(filter.SetBlockedClasses(0));
+    CHECK(!filter.IsBlocked(kWmMouseMove));
+}
+
+DC_TEST(OtherClassAndOutOfRangeNeverBlocked) {
+    MessageSuppressionFilter filter;
+    filter.SetBlockedClasses(0xFFFFFFFFu);
+    CHECK_EQ(filter.GetStats().blocked_classes, 0xFFFFFFFFu & ~MessageClassBit(MessageClass::kOther));
+    CHECK(!filter.IsBlocked(kWmTimer));
+    CHECK(!filter.IsBlocked(kWmRegisteredFirst));
+    CHECK(!filter.IsBlocked(0xFFFF));
+    CHECK(!filter.IsBlocked(MessageSuppressionFilter::kMessageCount));
+    CHECK(!filter.IsBlocked(0x10000 + kWmKeyDown));  // Must not wrap into the table
+    CHECK(!filter.IsBlocked(UINT32_MAX));
+}
+
+DC_TEST(UnchangedMaskDoesNotRebuild) {
+    MessageSuppressionFilter filter;
+    CHECK(!filter.SetBlockedClasses(0));
+    CHECK(filter.SetBlockedClasses(kKeyboardMessageClasses));
+    CHECK(!filter.SetBlockedClasses(kKeyboardMessageClasses));
+    // kOther is masked out before the comparison
+    CHECK(!filter.SetBlockedClasses(kKeyboardMessageClasses | MessageClassBit(MessageClass::kOther)));
+    CHECK_EQ(filter.GetStats().rebuilds, 1u);
+}
+
+DC_TEST(BitmapMatchesClassificationForEveryMask) {
+    MessageSuppressionFilter filter;
+    bool all_match = true;
+    for (uint32_t mask = 0; mask < (1u << kMessageClassCount); ++mask) {
+        filter.SetBlockedClasses(mask);
+        const uint32_t effective = mask & ~MessageClassBit(MessageClass::kOther);
+        for (uint32_t msg = 0; msg < MessageSuppressionFilter::kMessageCount; ++msg) {
+            const bool expected = (effective & MessageClassBit(ClassifyMessage(msg))) != 0;
+            all_match &= filter.IsBlocked(msg) == expected;
+        }
+    }
+    CHECK(all_match);
+}
+
+DC_TEST(CountsSuppressedPerClass) {
+    MessageSuppressionFilter filter;
+    filter.CountSuppressed(kWmKeyDown);
+    filter.CountSuppressed(kWmSysKeyDown);
+    filter.CountSuppressed(kWmMouseMove);
+    filter.CountSuppressed(kWmTimer);
+    const MessageSuppressionStats stats = filter.GetStats();
+    CHECK_EQ(stats.suppressed[static_cast<size_t>(MessageClass::kKeyDown)], 2u);
+    CHECK_EQ(stats.suppressed[static_cast<size_t>(MessageClass::kMouseMove)], 1u);
+    CHECK_EQ(stats.suppressed[static_cast<size_t>(MessageClass::kOther)], 1u);
+    CHECK_EQ(stats.suppressed[static_cast<size_t>(MessageClass::kChar)], 0u);
+}
+
+// A reader racing rebuilds sees the old or the new decision per message: words that are equal in both masks never
+// flicker.
+DC_TEST(RebuildKeepsStableWordsUntouched) {
+    MessageSuppressionFilter filter;
+    filter.SetBlockedClasses(kKeyboardMessageClasses);
+    std::atomic<bool> stop{false};
+    std::atomic<bool> ready{false};
+    uint64_t flicker = 0;
+    std::thread reader([&] {
+        ready.store(true);
+        uint64_t local = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            local += filter.IsBlocked(kWmKeyDown) ? 0 : 1;  // Blocked by both masks
+            local += filter.IsBlocked(kWmKeyUp) ? 1 : 0;    // Blocked by neither
+        }
+        flicker = local;
+    });
+    while (!ready.load()) {
+    }
+    for (int i = 0; i < 200; ++i) {
+        filter.SetBlockedClasses(i % 2 == 0 ? kAllClasses : kKeyboardMessageClasses);
+    }
+    stop.store(true);
+    reader.join();
+    CHECK_EQ(flicker, 0u);
+}
+
+// Refreshes come from the monitoring thread, the UI and XInput detection: concurrent rebuilds must leave the bitmap
+// matching the mask that was set last.
+DC_TEST(ConcurrentRebuildsEndOnLastMask) {
+    MessageSuppressionFilter filter;
+    constexpr int kThreads = 4;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&filter, t] {
+            for (int i = 0; i < 200; ++i) {
+                filter.SetBlockedClasses((i + t) % 2 == 0 ? kKeyboardMessageClasses : kMouseMessageClasses);
+            }
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    const uint32_t final_mask = filter.GetStats().blocked_classes;
+    CHECK(final_mask == kKeyboardMessageClasses || final_mask == kMouseMessageClasses);
+    bool all_match = true;
+    for (uint32_t msg = 0; msg < MessageSuppressionFilter::kMessageCount; ++msg) {
+        all_match &= filter.IsBlocked(msg) == ((final_mask & MessageClassBit(ClassifyMessage(msg))) != 0);
+    }
+    CHECK(all_match);
+}
+
+// Per-message decision before the bitmap: settings re-evaluated for every pumped message.
+struct LegacyInputBlocking {
+    std::atomic<bool> test_block_keyboard{false};
+    std::atomic<bool> test_block_mouse{false};
+    std::atomic<int> keyboard_mode{2};  // 0 disabled, 1 always, 2 in background
+    std::atomic<int> mouse_mode{2};
+    std::atomic<bool> in_background{true};
+
+    static bool ModeBlocks(int mode, bool background) { return mode == 1 || (mode == 2 && background); }
+
+    bool ShouldSuppress(uint32_t msg) const {
+        switch (msg) {
+            case kWmKeyDown:
+            case kWmSysKeyDown:
+            case kWmChar:
+            case 0x0103:
+            case 0x0106:
+            case 0x0107:
+                return test_block_keyboard.load(std::memory_order_relaxed)
+                       || ModeBlocks(keyboard_mode.load(std::memory_order_relaxed),
+                                     in_background.load(std::memory_order_acquire));
+            case kWmMouseMove:
+            case kWmLButtonDown:
+            case 0x0204:
+            case 0x0207:
+            case 0x020B:
+            case kWmMouseWheel:
+            case 0x020E:
+            case kWmSetCursor:
+                return test_block_mouse.load(std::memory_order_relaxed)
+                       || ModeBlocks(mouse_mode.load(std::memory_order_relaxed),
+                                     in_background.load(std::memory_order_acquire));
+            default: return false;
+        }
+    }
+};
+
+// Typical pump traffic: mostly mouse moves, raw input, timers and paints, some keys
+std::vector<uint32_t> MessageStream() {
+    static const uint32_t kMix[] = {
+        kWmMouseMove, kWmInput, kWmMouseMove, kWmTimer, kWmPaint,       kWmInput,     kWmSetCursor,  kWmKeyDown,
+        kWmChar,      kWmKeyUp, kWmInput,     0xC0A1,   kWmLButtonDown, kWmLButtonUp, kWmMouseWheel, kWmMouseMove};
+    std::vector<uint32_t> stream;
+    uint32_t x = 12345;
+    for (int i = 0; i < 4096; ++i) {
+        x = x * 1664525u + 1013904223u;
+        stream.push_back(kMix[(x >> 16) % (sizeof(kMix) / sizeof(kMix[0]))]);
+    }
+    return stream;
+}
+
+DC_TEST(FilterMatchesLegacyDecision) {
+    LegacyInputBlocking legacy;
+    MessageSuppressionFilter filter;
+    const auto stream = MessageStream();
+    for (int keyboard = 0; keyboard < 3; ++keyboard) {
+        for (int mouse = 0; mouse < 3; ++mouse) {
+            for (bool background : {false, true}) {
+                legacy.keyboard_mode = keyboard;
+                legacy.mouse_mode = mouse;
+                legacy.in_background = background;
+                uint32_t mask = 0;
+                mask |= LegacyInputBlocking::ModeBlocks(keyboard, background) ? kKeyboardMessageClasses : 0;
+                mask |= LegacyInputBlocking::ModeBlocks(mouse, background) ? kMouseMessageClasses : 0;
+                filter.SetBlockedClasses(mask);
+                for (const uint32_t msg : stream) {
+                    CHECK_EQ(filter.IsBlocked(msg), legacy.ShouldSuppress(msg));
+                }
+            }
+        }
+    }
+}
+
+DC_TEST(BenchmarkDecisionPerMessage) {
+    LegacyInputBlocking legacy;
+    MessageSuppressionFilter filter;
+    filter.SetBlockedClasses(kAllClasses);
+    const auto stream = MessageStream();
+    unsigned long long sink = 0;
+    const double legacy_ns = dc_test::MeasureNsPerOp(2000000, [&](size_t i) {
+        sink += legacy.ShouldSuppress(stream[i & (stream.size() - 1)]) ? 1 : 0;
+    });
+    const double filter_ns = dc_test::MeasureNsPerOp(2000000, [&](size_t i) {
+        sink += filter.IsBlocked(stream[i & (stream.size() - 1)]) ? 1 : 0;
+    });
+    dc_test::Consume(sink);
+    dc_test::ReportBenchmark("message decision, per-message settings", legacy_ns);
+    dc_test::ReportBenchmark("message decision, bitmap", filter_ns);
+
+    const double rebuild_ns = dc_test::MeasureNsPerOp(200, [&](size_t i) {
+        filter.SetBlockedClasses(i % 2 == 0 ? kKeyboardMessageClasses : kAllClasses);
+    });
+    dc_test::ReportBenchmark("filter rebuild (settings change)", rebuild_ns);
+}
+
+}  // namespace
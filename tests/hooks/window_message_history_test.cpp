@@ -0,0 +1,203 @@
+// Source Code <Display Commander> // Window message history ring tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "hooks/windows_hooks/window_message_history.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commanderhooks;
+
+constexpr size_t kDepth = WindowMessageHistory::kMinDepth;
+constexpr uint32_t kWmKeyDown = 0x0100;
+
+// Every field derived from one value, so a record mixed from two writes is detectable
+uint64_t Record(WindowMessageHistory& history, uint32_t thread_id, uint32_t value) {
+    return history.Record(0x1000u + value, value & 0xFFFFu, value, ~static_cast<intptr_t>(value), thread_id,
+                          static_cast<int64_t>(value) * 3);
+}
+
+bool Consistent(const WindowMessageRecord& r) {
+    const auto value = static_cast<uint32_t>(r.wparam);
+    return r.hwnd == 0x1000u + value && r.message_id == (value & 0xFFFFu) && r.lparam == ~static_cast<intptr_t>(value)
+           && r.time_ns == static_cast<int64_t>(value) * 3;
+}
+
+DC_TEST(SnapshotIsNewestFirstWithinDepth) {
+    WindowMessageHistory history(64, 20);
+    CHECK_EQ(history.GetDepth(), 32u);  // Rounded up to a power of two
+    CHECK_EQ(history.GetMaxDepth(), 64u);
+    for (uint32_t i = 0; i < 40; ++i) {
+        CHECK_EQ(Record(history, 7, i), i);
+    }
+    const std::vector<WindowMessageRecord> all = history.Snapshot();
+    REQUIRE(all.size() == 32u);
+    CHECK_EQ(all.front().sequence, 39u);
+    CHECK_EQ(all.back().sequence, 8u);
+    CHECK(Consistent(all.front()) && all.front().thread_id == 7u);
+    CHECK_EQ(history.Snapshot(5).size(), 5u);
+    CHECK_EQ(history.GetRecordedCount(), 40u);
+    CHECK_EQ(history.GetDroppedCount(), 0u);
+
+    history.Clear();
+    CHECK(history.Snapshot().empty());
+    Record(history, 7, 40);
+    CHECK_EQ(history.Snapshot().size(), 1u);
+}
+
+DC_TEST(SetSuppressedIgnoresReusedSlot) {
+    WindowMessageHistory history(kDepth, kDepth);
+    const uint64_t first = Record(history, 1, 0);
+    history.SetSuppressed(first, MessageSuppression::kInputBlocking);
+    CHECK(history.Snapshot(1).front().suppressed == MessageSuppression::kInputBlocking);
+
+    // After a full wrap the slot holds a newer message, which must stay unmarked
+    for (uint32_t i = 1; i <= kDepth; ++i) {
+        Record(history, 1, i);
+    }
+    history.SetSuppressed(first, MessageSuppression::kWindowProc);
+    bool any_marked = false;
+    for (const WindowMessageRecord& r : history.Snapshot()) {
+        any_marked |= r.suppressed != MessageSuppression::kNone;
+    }
+    CHECK(!any_marked);
+}
+
+DC_TEST(BusySlotDropsAndStaleSlotIsSkipped) {
+    WindowMessageHistory history(kDepth, kDepth);
+    const WindowMessageHistory::RecordClaim held = history.BeginRecord();
+    REQUIRE(held.slot != WindowMessageHistory::kNoSlot);
+    CHECK(history.Snapshot().empty());  // Claimed but not committed: skipped
+
+    // A full wrap later the same slot is still held: that record is dropped, not waited for
+    for (uint32_t i = 1; i <= kDepth; ++i) {
+        Record(history, 1, i);
+    }
+    CHECK_EQ(history.GetDroppedCount(), 1u);
+    std::vector<WindowMessageRecord> records = history.Snapshot();
+    CHECK_EQ(records.size(), kDepth - 1);  // Sequences 1..16 minus the dropped 16
+    CHECK_EQ(records.front().sequence, kDepth - 1);
+
+    // The late commit lands in a slot the window has moved past: its stamp no longer matches
+    history.CommitRecord(held, 0x1000u, 0, 0, ~static_cast<intptr_t>(0), 1, 0);
+    records = history.Snapshot();
+    CHECK_EQ(records.size(), kDepth - 1);
+    bool all_consistent = true;
+    for (const WindowMessageRecord& r : records) {
+        all_consistent &= Consistent(r) && r.sequence != held.sequence;
+    }
+    CHECK(all_consistent);
+
+    // The slot is free again once committed
+    Record(history, 1, 17);
+    CHECK_EQ(history.Snapshot(1).front().sequence, kDepth + 1);
+    CHECK_EQ(history.GetDroppedCount(), 1u);
+}
+
+DC_TEST(SetDepthClearsAndDropsClaimsFromTheOldDepth) {
+    WindowMessageHistory history(256, 64);
+    for (uint32_t i = 0; i < 10; ++i) {
+        Record(history, 1, i);
+    }
+    const WindowMessageHistory::RecordClaim before = history.BeginRecord();
+    REQUIRE(before.slot != WindowMessageHistory::kNoSlot);
+    history.SetDepth(100);
+    CHECK_EQ(history.GetDepth(), 128u);
+    CHECK(history.Snapshot().empty());
+    // Committed after SetDepth: sequence is before the clear, never shown
+    history.CommitRecord(before, 0x1000u, 0, 0, ~static_cast<intptr_t>(0), 1, 0);
+    CHECK(history.Snapshot().empty());
+    Record(history, 1, 11);
+    REQUIRE(history.Snapshot().size() == 1u);
+    CHECK_EQ(history.Snapshot().front().sequence, 11u);
+
+    history.SetDepth(1);
+    CHECK_EQ(history.GetDepth(), kDepth);
+    history.SetDepth(100000);
+    CHECK_EQ(history.GetDepth(), 256u);
+}
+
+// Writers racing a Snapshot reader (and SetDepth): every copied record is whole, sequences strictly decrease, and
+// each record is either published or counted as dropped.
+DC_TEST(ConcurrentWritersAndSnapshotReader) {
+    constexpr uint32_t kWriters = 4;
+    constexpr uint32_t kPerWriter = 50000;
+    WindowMessageHistory history(1024, kDepth);
+    std::atomic<uint32_t> done{0};
+    std::vector<std::thread> writers;
+    for (uint32_t t = 0; t < kWriters; ++t) {
+        writers.emplace_back([&history, &done, t] {
+            for (uint32_t i = 0; i < kPerWriter; ++i) {
+                const uint64_t sequence = Record(history, t + 1, t * kPerWriter + i);
+                if ((i & 7) == 0) {
+                    history.SetSuppressed(sequence, MessageSuppression::kInputBlocking);
+                }
+            }
+            done.fetch_add(1);
+        });
+    }
+    bool whole = true;
+    bool ordered = true;
+    uint64_t snapshots = 0;
+    while (done.load() < kWriters) {
+        const std::vector<WindowMessageRecord> records = history.Snapshot();
+        for (size_t i = 0; i < records.size(); ++i) {
+            whole &= Consistent(records[i]) && records[i].thread_id >= 1 && records[i].thread_id <= kWriters;
+            ordered &= i == 0 || records[i].sequence < records[i - 1].sequence;
+        }
+        if (++snapshots % 64 == 0) {
+            history.SetDepth(snapshots % 128 == 0 ? 1024 : kDepth);
+        }
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    CHECK(whole);
+    CHECK(ordered);
+    CHECK_EQ(history.GetRecordedCount(), static_cast<uint64_t>(kWriters) * kPerWriter);
+
+    // Quiet ring: the last depth's worth of sequences is either visible or was dropped
+    history.SetDepth(kDepth);
+    for (uint32_t i = 0; i < kDepth; ++i) {
+        Record(history, 1, i);
+    }
+    const std::vector<WindowMessageRecord> final_records = history.Snapshot();
+    CHECK_EQ(final_records.size(), kDepth);
+    bool final_whole = true;
+    for (const WindowMessageRecord& r : final_records) {
+        final_whole &= Consistent(r);
+    }
+    CHECK(final_whole);
+}
+
+DC_TEST(CsvIsOldestFirstWithRelativeTimes) {
+    WindowMessageHistory history(kDepth, kDepth);
+    history.Record(0xAB, kWmKeyDown, 0x41, 0x1E0001, 12, 5000000);
+    const uint64_t second = history.Record(0xAB, 0x0200, 0, 0x00100020, 12, 6500000);
+    history.SetSuppressed(second, MessageSuppression::kInputBlocking);
+    const std::string csv = FormatWindowMessagesCsv(
+        history.Snapshot(), [](uint32_t id) { return id == kWmKeyDown ? "WM_KEYDOWN" : "WM_MOUSEMOVE"; });
+    CHECK_EQ(csv,
+             "sequence,time_ms,thread_id,hwnd,message,message_id,wparam,lparam,suppressed\n"
+             "0,0.000,12,0xab,WM_KEYDOWN,0x0100,0x41,0x1e0001,\n"
+             "1,1.500,12,0xab,WM_MOUSEMOVE,0x0200,0x0,0x100020,input blocking\n");
+    CHECK_EQ(FormatWindowMessagesCsv({}, nullptr),
+             "sequence,time_ms,thread_id,hwnd,message,message_id,wparam,lparam,suppressed\n");
+}
+
+DC_TEST(RecordBenchmark) {
+    WindowMessageHistory history(4096, 256);
+    const double ns = dc_test::MeasureNsPerOp(1000000, [&](size_t i) {
+        history.Record(0x1000, kWmKeyDown, i, 0, 1, static_cast<int64_t>(i));
+    });
+    dc_test::Consume(history.GetRecordedCount());
+    dc_test::ReportBenchmark("WindowMessageHistory::Record", ns);
+}
+
+}  // namespace
@@ -0,0 +1,336 @@
+// Source Code <Display Commander> // Latency marker bus tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "latency/latency_marker_bus.hpp"
+
+// Libraries <Standard C++>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::latency;
+
+constexpr int64_t kMs = 1000000;
+
+// Raw values shared by NV_LATENCY_MARKER_TYPE, NVLL_VK_LATENCY_MARKER_TYPE and PCLSTATS_LATENCY_MARKER_TYPE
+constexpr uint32_t kSimStart = 0;
+constexpr uint32_t kSimEnd = 1;
+constexpr uint32_t kSubmitStart = 2;
+constexpr uint32_t kSubmitEnd = 3;
+constexpr uint32_t kPresentStart = 4;
+constexpr uint32_t kPresentEnd = 5;
+
+struct Recorder {
+    std::mutex mutex;
+    std::vector<LatencyFrameMarkers> frames;
+
+    LatencyMarkerBus::Subscriber Subscriber() {
+        return [this](const LatencyFrameMarkers& frame) {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames.push_back(frame);
+        };
+    }
+
+    std::vector<uint64_t> Ids() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<uint64_t> ids;
+        for (const LatencyFrameMarkers& f : frames) {
+            ids.push_back(f.frame_id);
+        }
+        return ids;
+    }
+};
+
+void Publish(LatencyMarkerBus& bus, LatencyMarkerSource source, uint32_t raw, uint64_t frame_id, int64_t time_ns) {
+    LatencyMarkerEvent event;
+    event.source = source;
+    event.raw_marker = raw;
+    event.frame_id = frame_id;
+    event.time_ns = time_ns;
+    bus.Publish(event);
+}
+
+// One frame of game markers, 1 ms apart starting at time_ns
+void PublishFrame(LatencyMarkerBus& bus, LatencyMarkerSource source, uint64_t frame_id, int64_t time_ns) {
+    for (uint32_t raw : {kSimStart, kSimEnd, kSubmitStart, kSubmitEnd, kPresentStart, kPresentEnd}) {
+        Publish(bus, source, raw, frame_id, time_ns + raw * kMs);
+    }
+}
+
+LatencyMarker Normalized(LatencyMarkerSource source, uint32_t raw) {
+    LatencyMarker marker = LatencyMarker::kCount;
+    return NormalizeLatencyMarker(source, raw, &marker) ? marker : LatencyMarker::kCount;
+}
+
+DC_TEST(NormalizesPerSourceEnums) {
+    for (LatencyMarkerSource source : {LatencyMarkerSource::kNvapiD3D, LatencyMarkerSource::kNvLowLatencyVk,
+                                       LatencyMarkerSource::kVulkanNv, LatencyMarkerSource::kPclStatsEtw,
+                                       LatencyMarkerSource::kInjected}) {
+        for (uint32_t raw = kSimStart; raw <= kPresentEnd; ++raw) {
+            CHECK(Normalized(source, raw) == static_cast<LatencyMarker>(raw));
+        }
+    }
+    CHECK(Normalized(LatencyMarkerSource::kNvapiD3D, 12) == LatencyMarker::kOutOfBandPresentEnd);
+    CHECK(Normalized(LatencyMarkerSource::kNvapiD3D, 13) == LatencyMarker::kCount);
+    CHECK(Normalized(LatencyMarkerSource::kNvLowLatencyVk, 8) == LatencyMarker::kPcLatencyPing);
+    CHECK(Normalized(LatencyMarkerSource::kNvLowLatencyVk, 9) == LatencyMarker::kCount);
+    // VkLatencyMarkerNV has no PC_LATENCY_PING: 8..11 are the out-of-band markers
+    CHECK(Normalized(LatencyMarkerSource::kVulkanNv, 7) == LatencyMarker::kTriggerFlash);
+    CHECK(Normalized(LatencyMarkerSource::kVulkanNv, 8) == LatencyMarker::kOutOfBandRenderSubmitStart);
+    CHECK(Normalized(LatencyMarkerSource::kVulkanNv, 11) == LatencyMarker::kOutOfBandPresentEnd);
+    CHECK(Normalized(LatencyMarkerSource::kVulkanNv, 12) == LatencyMarker::kCount);
+    CHECK(Normalized(LatencyMarkerSource::kPclStatsEtw, 13) == LatencyMarker::kControllerInputSample);
+    CHECK(Normalized(LatencyMarkerSource::kPclStatsEtw, 14) == LatencyMarker::kCount);
+    CHECK(Normalized(LatencyMarkerSource::kCount, 0) == LatencyMarker::kCount);
+}
+
+DC_TEST(DeliversInOrderWithLag) {
+    LatencyMarkerBus bus;
+    Recorder recorder;
+    bus.Subscribe(recorder.Subscriber());
+    for (uint64_t id = 1; id <= 10; ++id) {
+        PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, id, static_cast<int64_t>(id) * 16 * kMs);
+    }
+    // Frame N is delivered when frame N + kDeliveryLagFrames starts
+    CHECK(recorder.Ids() == (std::vector<uint64_t>{1, 2, 3, 4, 5, 6, 7}));
+    bus.Flush();
+    CHECK(recorder.Ids() == (std::vector<uint64_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+
+    const LatencyFrameMarkers& first = recorder.frames.front();
+    CHECK(first.source == LatencyMarkerSource::kNvapiD3D);
+    CHECK_EQ(first.marker_mask, 0x3Fu);
+    CHECK_EQ(first.Time(LatencyMarker::kPresentStart), 16 * kMs + 4 * kMs);
+    CHECK_EQ(first.Time(LatencyMarker::kInputSample), 0);
+
+    LatencyFrameMarkers latest;
+    CHECK(bus.GetLatestFrame(&latest));
+    CHECK_EQ(latest.frame_id, 10u);
+    const std::vector<LatencyFrameMarkers> recent = bus.GetRecentFrames(3);
+    CHECK_EQ(recent.size(), 3u);
+    CHECK_EQ(recent[0].frame_id, 10u);
+    CHECK_EQ(recent[2].frame_id, 8u);
+    CHECK_EQ(bus.GetStats().frames_delivered, 10u);
+}
+
+DC_TEST(InterleavedFramesAssembleSeparately) {
+    LatencyMarkerBus bus;
+    Recorder recorder;
+    bus.Subscribe(recorder.Subscriber());
+    // Simulation of frame 2 starts before frame 1 presents
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimStart, 1, 1 * kMs);
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimEnd, 1, 2 * kMs);
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimStart, 2, 3 * kMs);
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kPresentStart, 1, 4 * kMs);
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimEnd, 2, 5 * kMs);
+    bus.Flush();
+    CHECK_EQ(recorder.frames.size(), 2u);
+    CHECK_EQ(recorder.frames[0].Time(LatencyMarker::kPresentStart), 4 * kMs);
+    CHECK_EQ(recorder.frames[1].Time(LatencyMarker::kSimulationEnd), 5 * kMs);
+    CHECK(!recorder.frames[1].Has(LatencyMarker::kPresentStart));
+}
+
+DC_TEST(NativeShadowsPclStatsDuplicates) {
+    LatencyMarkerBus bus;
+    Recorder recorder;
+    bus.Subscribe(recorder.Subscriber());
+    // A game writing Reflex and PCLStats markers for the same frames (PCLStats IDs in their own space)
+    for (uint64_t id = 1; id <= 20; ++id) {
+        const int64_t t = static_cast<int64_t>(id) * 16 * kMs;
+        PublishFrame(bus, LatencyMarkerSource::kPclStatsEtw, id + 5000, t);
+        PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, id, t);
+    }
+    bus.Flush();
+    const LatencyMarkerBusStats stats = bus.GetStats();
+    CHECK(stats.active_source == LatencyMarkerSource::kNvapiD3D);
+    CHECK_EQ(stats.sources[static_cast<size_t>(LatencyMarkerSource::kPclStatsEtw)].shadowed, 20u * 6u - 6u);
+    CHECK_EQ(stats.source_switches, 1u);
+    // Only PCLStats frame 5001 went out before native markers took over; one record per frame after that
+    std::vector<uint64_t> expected = {5001};
+    for (uint64_t id = 1; id <= 20; ++id) {
+        expected.push_back(id);
+    }
+    CHECK(recorder.Ids() == expected);
+}
+
+DC_TEST(FallsBackWhenPreferredSourceStops) {
+    LatencyMarkerBus bus;
+    Recorder recorder;
+    bus.Subscribe(recorder.Subscriber());
+    PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, 100, 0);
+    PublishFrame(bus, LatencyMarkerSource::kInjected, 7, 10 * kMs);  // Shadowed
+    CHECK(bus.GetStats().active_source == LatencyMarkerSource::kNvapiD3D);
+    // Native markers stop: after kSourceTimeoutNs the injected stream takes over
+    const int64_t later = LatencyMarkerBus::kSourceTimeoutNs + 20 * kMs;
+    PublishFrame(bus, LatencyMarkerSource::kInjected, 8, later);
+    bus.Flush();
+    const LatencyMarkerBusStats stats = bus.GetStats();
+    CHECK(stats.active_source == LatencyMarkerSource::kInjected);
+    CHECK_EQ(stats.source_switches, 1u);
+    CHECK(recorder.Ids() == (std::vector<uint64_t>{100, 8}));
+    CHECK(recorder.frames.back().source == LatencyMarkerSource::kInjected);
+}
+
+DC_TEST(UnknownMarkersDoNotElectSource) {
+    LatencyMarkerBus bus;
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, 99, 1, 0);
+    LatencyMarkerBusStats stats = bus.GetStats();
+    CHECK(stats.active_source == LatencyMarkerSource::kCount);
+    CHECK_EQ(stats.sources[0].unknown, 1u);
+    PublishFrame(bus, LatencyMarkerSource::kPclStatsEtw, 1, 1 * kMs);
+    stats = bus.GetStats();
+    CHECK(stats.active_source == LatencyMarkerSource::kPclStatsEtw);
+}
+
+DC_TEST(CountsRepeatsAndLateMarkers) {
+    LatencyMarkerBus bus;
+    Recorder recorder;
+    bus.Subscribe(recorder.Subscriber());
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kPresentStart, 1, 1 * kMs);
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kPresentStart, 1, 2 * kMs);  // Repeat: first kept
+    for (uint64_t id = 2; id <= 5; ++id) {
+        PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, id, static_cast<int64_t>(id) * 16 * kMs);
+    }
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kPresentEnd, 1, 90 * kMs);  // Frame 1 already delivered
+    const LatencyMarkerSourceStats stats = bus.GetStats().sources[0];
+    CHECK_EQ(stats.repeats, 1u);
+    CHECK_EQ(stats.late, 1u);
+    CHECK_EQ(recorder.frames.front().frame_id, 1u);
+    CHECK_EQ(recorder.frames.front().Time(LatencyMarker::kPresentStart), 1 * kMs);
+    CHECK(!recorder.frames.front().Has(LatencyMarker::kPresentEnd));
+}
+
+DC_TEST(FrameIdRestartFlushesAndContinues) {
+    LatencyMarkerBus bus;
+    Recorder recorder;
+    bus.Subscribe(recorder.Subscriber());
+    for (uint64_t id = 5000; id < 5005; ++id) {
+        PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, id, static_cast<int64_t>(id - 5000) * 16 * kMs);
+    }
+    // Device recreated: IDs restart at 1
+    for (uint64_t id = 1; id <= 5; ++id) {
+        PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, id, static_cast<int64_t>(id + 10) * 16 * kMs);
+    }
+    bus.Flush();
+    CHECK_EQ(bus.GetStats().id_resets, 1u);
+    CHECK(recorder.Ids() == (std::vector<uint64_t>{5000, 5001, 5002, 5003, 5004, 1, 2, 3, 4, 5}));
+    CHECK_EQ(bus.GetStats().sources[0].late, 0u);
+}
+
+DC_TEST(IdJumpDeliversOlderFrames) {
+    LatencyMarkerBus bus;
+    Recorder recorder;
+    bus.Subscribe(recorder.Subscriber());
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimStart, 1, 0);
+    Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimStart, 1 + LatencyMarkerBus::kOpenFrameSlots * 4, 1 * kMs);
+    bus.Flush();
+    CHECK(recorder.Ids() == (std::vector<uint64_t>{1, 1 + LatencyMarkerBus::kOpenFrameSlots * 4}));
+}
+
+DC_TEST(UnsubscribedSubscriberIsNotCalled) {
+    LatencyMarkerBus bus;
+    Recorder kept;
+    Recorder removed;
+    bus.Subscribe(kept.Subscriber());
+    const LatencyMarkerBus::SubscriberId id = bus.Subscribe(removed.Subscriber());
+    PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, 1, 0);
+    bus.Flush();
+    bus.Unsubscribe(id);
+    PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, 2, 16 * kMs);
+    bus.Flush();
+    CHECK_EQ(kept.frames.size(), 2u);
+    CHECK_EQ(removed.frames.size(), 1u);
+}
+
+// Subscribers run outside the bus lock: calling back into the bus (stats, or publishing a derived marker) must not
+// deadlock, and nested records are delivered after the current one.
+DC_TEST(SubscriberMayCallBackIntoBus) {
+    LatencyMarkerBus bus;
+    std::vector<uint64_t> seen;
+    uint64_t delivered_seen = 0;
+    bus.Subscribe([&](const LatencyFrameMarkers& frame) {
+        seen.push_back(frame.frame_id);
+        delivered_seen = bus.GetStats().frames_delivered;
+        if (frame.frame_id < 100) {
+            Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimStart, frame.frame_id + 100, 0);
+            bus.Flush();
+        }
+    });
+    PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, 1, 0);
+    bus.Flush();
+    CHECK(seen == (std::vector<uint64_t>{1, 101}));
+    CHECK_EQ(delivered_seen, 2u);
+}
+
+// Subscriber taking its own lock (fg_pacing's model mutex) while another thread reads the bus under that lock
+DC_TEST(SubscriberLockDoesNotDeadlockReaders) {
+    LatencyMarkerBus bus;
+    std::mutex model_mutex;
+    uint64_t model_frames = 0;
+    bus.Subscribe([&](const LatencyFrameMarkers&) {
+        std::lock_guard<std::mutex> lock(model_mutex);
+        ++model_frames;
+    });
+    std::atomic<bool> stop{false};
+    std::atomic<bool> started{false};
+    std::thread ui([&] {
+        started.store(true);
+        while (!stop.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(model_mutex);
+            dc_test::Consume(bus.GetStats().frames_delivered);
+        }
+    });
+    while (!started.load()) {
+    }
+    for (uint64_t id = 1; id <= 2000; ++id) {
+        PublishFrame(bus, LatencyMarkerSource::kNvapiD3D, id, static_cast<int64_t>(id) * kMs);
+    }
+    stop.store(true);
+    ui.join();
+    bus.Flush();
+    CHECK_EQ(model_frames, 2000u);
+}
+
+DC_TEST(ConcurrentPublishersKeepFrameOrder) {
+    LatencyMarkerBus bus;
+    std::vector<uint64_t> ids;  // Only touched by the single draining thread
+    bus.Subscribe([&](const LatencyFrameMarkers& frame) { ids.push_back(frame.frame_id); });
+    // Simulation thread and present thread of one game, at most two frames apart
+    std::atomic<uint64_t> simulated{0};
+    std::atomic<uint64_t> presented{0};
+    std::thread sim([&] {
+        for (uint64_t id = 1; id <= 5000; ++id) {
+            while (presented.load() + 2 < id) {
+            }
+            Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimStart, id, static_cast<int64_t>(id) * kMs);
+            Publish(bus, LatencyMarkerSource::kNvapiD3D, kSimEnd, id, static_cast<int64_t>(id) * kMs);
+            simulated.store(id);
+        }
+    });
+    std::thread present([&] {
+        for (uint64_t id = 1; id <= 5000; ++id) {
+            while (simulated.load() < id) {
+            }
+            Publish(bus, LatencyMarkerSource::kNvapiD3D, kPresentStart, id, static_cast<int64_t>(id) * kMs);
+            Publish(bus, LatencyMarkerSource::kNvapiD3D, kPresentEnd, id, static_cast<int64_t>(id) * kMs);
+            presented.store(id);
+        }
+    });
+    sim.join();
+    present.join();
+    bus.Flush();
+    bool ordered = true;
+    for (size_t i = 1; i < ids.size(); ++i) {
+        ordered &= ids[i] > ids[i - 1];
+    }
+    CHECK(ordered);
+    CHECK_EQ(ids.size(), static_cast<size_t>(bus.GetStats().frames_delivered));
+    CHECK_EQ(ids.size(), 5000u);
+    const LatencyMarkerSourceStats stats = bus.GetStats().sources[0];
+    CHECK_EQ(stats.late, 0u);
+    CHECK_EQ(stats.repeats, 0u);
+}
+
+}  // namespace
@@ -0,0 +1,414 @@
+// Source Code <Display Commander> // PCLStats ETW event queue tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "latency/pclstats_event_queue.hpp"
+
+// Libraries <Standard C++>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace display_commander::latency;
+
+constexpr size_t kCapacity = PclStatsEventQueue::kRingCapacity;
+constexpr size_t kThreadRings = PclStatsEventQueue::kThreadRings;
+
+// TraceLogging event metadata: UInt16 size, tags byte, name, then field names
+PclStatsRawEvent MakeEvent(const char* event_name, uint32_t marker, uint64_t frame_id) {
+    PclStatsRawEvent event;
+    const size_t name_len = std::strlen(event_name);
+    event.meta[2] = 0;
+    std::memcpy(event.meta + 3, event_name, name_len + 1);
+    std::memcpy(event.meta + 4 + name_len, "Marker", 7);
+    event.meta_size = static_cast<uint16_t>(4 + name_len + 7);
+    event.field_count = 2;
+    event.field_sizes[0] = sizeof(uint32_t);
+    event.field_sizes[1] = sizeof(uint64_t);
+    std::memcpy(event.payload, &marker, sizeof(marker));
+    std::memcpy(event.payload + sizeof(marker), &frame_id, sizeof(frame_id));
+    return event;
+}
+
+// Pushes one event stamped with (thread_id, sequence); false when dropped
+bool Push(PclStatsEventQueue& queue, uint32_t thread_id, int64_t sequence) {
+    PclStatsRawEvent* slot = queue.BeginPush(thread_id);
+    if (slot == nullptr) {
+        return false;
+    }
+    slot->thread_id = thread_id;
+    slot->time_ns = sequence;
+    queue.CommitPush();
+    return true;
+}
+
+std::vector<int64_t> DrainSequences(PclStatsEventQueue& queue) {
+    std::vector<int64_t> sequences;
+    queue.Drain([&](const PclStatsRawEvent& event) { sequences.push_back(event.time_ns); });
+    return sequences;
+}
+
+DC_TEST(DecodesMarkerEvents) {
+    uint32_t marker = 0;
+    uint64_t frame_id = 0;
+    CHECK(DecodePclStatsRawEvent(MakeEvent("PCLStatsEvent", 4, 1234), &marker, &frame_id)
+          == PclStatsEventKind::kMarker);
+    CHECK_EQ(marker, 4u);
+    CHECK_EQ(frame_id, 1234u);
+    CHECK(DecodePclStatsRawEvent(MakeEvent("PCLStatsEventV2", 13, 77), &marker, &frame_id)
+          == PclStatsEventKind::kMarker);
+    CHECK_EQ(marker, 13u);
+    CHECK_EQ(frame_id, 77u);
+}
+
+DC_TEST(DecodesInitAndOtherEvents) {
+    uint32_t marker = 0;
+    uint64_t frame_id = 0;
+    PclStatsRawEvent init = MakeEvent("PCLStatsInit", 0, 0);
+    init.field_count = 0;
+    CHECK(DecodePclStatsRawEvent(init, &marker, &frame_id) == PclStatsEventKind::kInit);
+    CHECK(DecodePclStatsRawEvent(MakeEvent("PCLStatsFlags", 0, 0), &marker, &frame_id) == PclStatsEventKind::kOther);
+    CHECK(DecodePclStatsRawEvent(PclStatsRawEvent{}, &marker, &frame_id) == PclStatsEventKind::kOther);
+
+    // Field layout other than UInt32 + UInt64
+    PclStatsRawEvent narrow = MakeEvent("PCLStatsEvent", 1, 2);
+    narrow.field_sizes[1] = sizeof(uint32_t);
+    CHECK(DecodePclStatsRawEvent(narrow, &marker, &frame_id) == PclStatsEventKind::kOther);
+    PclStatsRawEvent one_field = MakeEvent("PCLStatsEvent", 1, 2);
+    one_field.field_count = 1;
+    CHECK(DecodePclStatsRawEvent(one_field, &marker, &frame_id) == PclStatsEventKind::kOther);
+
+    // Name cut off by the metadata copy limit
+    PclStatsRawEvent truncated = MakeEvent("PCLStatsEvent", 1, 2);
+    truncated.meta_size = 10;
+    CHECK(DecodePclStatsRawEvent(truncated, &marker, &frame_id) == PclStatsEventKind::kOther);
+}
+
+DC_TEST(ProviderGuidHashIsStableAndDistinct) {
+    uint8_t a[16] = {0x8d, 0x3c, 0x1f, 0x0b};
+    uint8_t b[16] = {0x8d, 0x3c, 0x1f, 0x0c};
+    CHECK_EQ(HashProviderGuid(a), HashProviderGuid(a));
+    CHECK(HashProviderGuid(a) != HashProviderGuid(b));
+}
+
+DC_TEST(SingleThreadKeepsOrderAndDropsWhenFull) {
+    PclStatsEventQueue queue;
+    for (int64_t i = 0; i < static_cast<int64_t>(kCapacity) + 10; ++i) {
+        Push(queue, 1, i);
+    }
+    PclStatsEventQueueStats stats = queue.GetStats();
+    CHECK_EQ(stats.queued, kCapacity);
+    CHECK_EQ(stats.dropped, 10u);
+    CHECK_EQ(stats.producer_threads, 1u);
+
+    const std::vector<int64_t> sequences = DrainSequences(queue);
+    CHECK_EQ(sequences.size(), kCapacity);
+    CHECK_EQ(sequences.front(), 0);
+    CHECK_EQ(sequences.back(), static_cast<int64_t>(kCapacity) - 1);
+    // Space again after the drain
+    CHECK(Push(queue, 1, 1000));
+    CHECK(DrainSequences(queue) == std::vector<int64_t>{1000});
+    stats = queue.GetStats();
+    CHECK_EQ(stats.drained, kCapacity + 1);
+}
+
+DC_TEST(AbortedPushIsNotDrained) {
+    PclStatsEventQueue queue;
+    Push(queue, 1, 1);
+    PclStatsRawEvent* slot = queue.BeginPush(1);
+    CHECK(slot != nullptr);
+    queue.AbortPush();
+    Push(queue, 1, 2);
+    CHECK(DrainSequences(queue) == (std::vector<int64_t>{1, 2}));
+    CHECK_EQ(queue.GetStats().queued, 2u);
+}
+
+DC_TEST(ExitingThreadsHandTheirRingBack) {
+    PclStatsEventQueue queue;
+    // More short-lived writers than rings, one after another: each finds a free ring
+    for (uint32_t t = 0; t < 3 * kThreadRings; ++t) {
+        std::thread writer([&queue, t] {
+            for (int64_t i = 0; i < 8; ++i) {
+                Push(queue, 100 + t, i);
+            }
+        });
+        writer.join();
+    }
+    const PclStatsEventQueueStats stats = queue.GetStats();
+    CHECK_EQ(stats.released_rings, 3 * kThreadRings);
+    CHECK_EQ(stats.producer_threads, 0u);
+    CHECK_EQ(stats.shared_ring_events, 0u);
+    CHECK_EQ(stats.queued, 3 * kThreadRings * 8);
+    CHECK_EQ(DrainSequences(queue).size(), 3 * kThreadRings * 8);
+}
+
+// Starts `count` threads that each take a ring with one push and keep it until released
+struct RingHolders {
+    std::atomic<bool> release{false};
+    std::atomic<size_t> holding{0};
+    std::vector<std::thread> threads;
+
+    RingHolders(PclStatsEventQueue& queue, size_t count) {
+        for (size_t t = 0; t < count; ++t) {
+            threads.emplace_back([this, &queue, t] {
+                Push(queue, static_cast<uint32_t>(10 + t), 0);
+                holding.fetch_add(1);
+                while (!release.load()) {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        while (holding.load() < count) {
+        }
+    }
+
+    ~RingHolders() {
+        release.store(true);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+};
+
+DC_TEST(ThreadsBeyondRingsShareTheOverflowRing) {
+    PclStatsEventQueue queue;
+    RingHolders holders(queue, kThreadRings);
+    CHECK_EQ(queue.GetStats().producer_threads, kThreadRings);
+    std::thread late([&queue] {
+        for (int64_t i = 0; i < 5; ++i) {
+            Push(queue, 99, 100 + i);
+        }
+    });
+    late.join();
+    const PclStatsEventQueueStats stats = queue.GetStats();
+    CHECK_EQ(stats.shared_ring_events, 5u);
+    CHECK_EQ(stats.queued, kThreadRings + 5);
+    const std::vector<int64_t> sequences = DrainSequences(queue);
+    CHECK_EQ(sequences.size(), kThreadRings + 5);
+    CHECK_EQ(sequences.back(), 104);
+}
+
+DC_TEST(FullOverflowRingDropsWithoutWaiting) {
+    PclStatsEventQueue queue;
+    RingHolders holders(queue, kThreadRings);
+    std::thread late([&queue] {
+        for (int64_t i = 0; i < static_cast<int64_t>(kCapacity) + 50; ++i) {
+            Push(queue, 99, i);
+        }
+        // A claimed but unfilled slot is skipped instead of stalling the consumer
+        if (queue.BeginPush(99) != nullptr) {
+            queue.AbortPush();
+        }
+    });
+    late.join();
+    PclStatsEventQueueStats stats = queue.GetStats();
+    CHECK_EQ(stats.shared_ring_events, kCapacity);
+    CHECK_EQ(stats.dropped, 51u);
+    CHECK_EQ(DrainSequences(queue).size(), kThreadRings + kCapacity);
+
+    std::thread again([&queue] {
+        if (queue.BeginPush(99) != nullptr) {
+            queue.AbortPush();
+        }
+        Push(queue, 99, 7);
+    });
+    again.join();
+    CHECK(DrainSequences(queue) == std::vector<int64_t>{7});
+}
+
+DC_TEST(ConcurrentProducersAndConsumer) {
+    PclStatsEventQueue queue;
+    constexpr size_t kProducers = kThreadRings + 5;  // Five share the overflow ring
+    constexpr int64_t kEvents = 20000;
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> started{0};
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < kProducers; ++t) {
+        producers.emplace_back([&, t] {
+            // Every producer holds its ring (or the overflow ring) before anyone can exit and hand one back
+            Push(queue, static_cast<uint32_t>(1 + t), 0);
+            started.fetch_add(1);
+            while (started.load() < kProducers) {
+            }
+            for (int64_t i = 1; i < kEvents; ++i) {
+                Push(queue, static_cast<uint32_t>(1 + t), i);
+            }
+            done.fetch_add(1);
+        });
+    }
+    std::map<uint32_t, int64_t> last_by_thread;
+    bool ordered = true;
+    size_t drained = 0;
+    const auto consume = [&](const PclStatsRawEvent& event) {
+        auto [it, inserted] = last_by_thread.emplace(event.thread_id, event.time_ns);
+        if (!inserted) {
+            ordered &= event.time_ns > it->second;
+            it->second = event.time_ns;
+        }
+        ++drained;
+    };
+    while (done.load() < kProducers) {
+        queue.Drain(consume);
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    queue.Drain(consume);
+    const PclStatsEventQueueStats stats = queue.GetStats();
+    CHECK(ordered);
+    CHECK_EQ(drained, static_cast<size_t>(stats.queued));
+    CHECK_EQ(stats.queued + stats.dropped, kProducers * kEvents);
+    CHECK(stats.shared_ring_events > 0u);
+    CHECK_EQ(stats.released_rings, kThreadRings);
+}
+
+// EVENT_DATA_DESCRIPTOR layout (evntprov.h)
+struct SyntheticDataDescriptor {
+    uint64_t ptr = 0;
+    uint32_t size = 0;
+    uint32_t reserved = 0;
+};
+
+// The ETW detours (pclstats_etw_hooks.cpp) without Windows types: EventRegister keeps PCLStats registrations after a
+// GUID hash + compare; EventWriteTransfer matches the REGHANDLE and copies the descriptors raw into the queue.
+class SyntheticPclStatsHooks {
+   public:
+    static constexpr size_t kMaxRegistrations = 4;
+
+    explicit SyntheticPclStatsHooks(const uint8_t* provider_guid) : provider_hash_(HashProviderGuid(provider_guid)) {
+        std::memcpy(provider_guid_, provider_guid, sizeof(provider_guid_));
+    }
+
+    void Register(const uint8_t* guid, uint64_t handle) {
+        if (HashProviderGuid(guid) != provider_hash_
+            || std::memcmp(guid, provider_guid_, sizeof(provider_guid_)) != 0) {
+            return;
+        }
+        const size_t slot = count_.fetch_add(1, std::memory_order_acq_rel);
+        if (slot < kMaxRegistrations) {
+            handles_[slot].store(handle, std::memory_order_release);
+        }
+    }
+
+    // false when the write is only forwarded (not a PCLStats registration)
+    bool Write(uint64_t handle, uint32_t thread_id, int64_t time_ns, const SyntheticDataDescriptor* data,
+               uint32_t count) {
+        if (!IsRegistered(handle)) {
+            return false;
+        }
+        PclStatsRawEvent* slot = queue.BeginPush(thread_id);
+        if (slot == nullptr) {
+            return true;
+        }
+        slot->time_ns = time_ns;
+        slot->thread_id = thread_id;
+        if (count < 2) {
+            queue.AbortPush();
+            return true;
+        }
+        const uint32_t meta_size = (std::min)(data[1].size, static_cast<uint32_t>(PclStatsRawEvent::kMetaBytes));
+        std::memcpy(slot->meta, reinterpret_cast<const void*>(static_cast<uintptr_t>(data[1].ptr)), meta_size);
+        slot->meta_size = static_cast<uint16_t>(meta_size);
+        slot->field_count = static_cast<uint8_t>((std::min)(count - 2, 2u));
+        size_t offset = 0;
+        for (uint8_t i = 0; i < slot->field_count; ++i) {
+            const SyntheticDataDescriptor& field = data[2 + i];
+            slot->field_sizes[i] = static_cast<uint8_t>((std::min)(field.size, 255u));
+            const size_t n = (std::min)(static_cast<size_t>(field.size), PclStatsRawEvent::kPayloadBytes - offset);
+            std::memcpy(slot->payload + offset, reinterpret_cast<const void*>(static_cast<uintptr_t>(field.ptr)), n);
+            offset += n;
+        }
+        queue.CommitPush();
+        return true;
+    }
+
+    PclStatsEventQueue queue;
+
+   private:
+    bool IsRegistered(uint64_t handle) const {
+        if (handle == 0) {
+            return false;
+        }
+        for (const auto& h : handles_) {
+            if (h.load(std::memory_order_relaxed) == handle) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint8_t provider_guid_[16] = {};
+    uint64_t provider_hash_ = 0;
+    std::array<std::atomic<uint64_t>, kMaxRegistrations> handles_{};
+    std::atomic<size_t> count_{0};
+};
+
+// Inline cost on the game thread per PCLStats write, and the consumer's drain + decode cost per event.
+DC_TEST(InterceptedWriteBenchmark) {
+    const uint8_t pclstats_guid[16] = {0x8d, 0x3c, 0x1f, 0x0b, 0x22, 0x41, 0x5a, 0x51,
+                                       0x9a, 0x9f, 0x60, 0x4f, 0x32, 0x27, 0x13, 0x51};
+    const uint8_t other_guid[16] = {0x01, 0x02, 0x03, 0x04};
+    auto hooks = std::make_unique<SyntheticPclStatsHooks>(pclstats_guid);
+    hooks->Register(other_guid, 0x1111);
+    hooks->Register(pclstats_guid, 0x2222);  // Game PCLStats
+    hooks->Register(pclstats_guid, 0x3333);  // Streamline sl.pcl
+
+    // TraceLogging descriptors: [0] provider metadata, [1] event metadata, [2] Marker, [3] FrameID
+    const PclStatsRawEvent source = MakeEvent("PCLStatsEventV2", 4, 0);
+    uint32_t marker = 4;
+    uint64_t frame_id = 0;
+    SyntheticDataDescriptor data[4];
+    data[1] = {reinterpret_cast<uintptr_t>(source.meta), source.meta_size, 0};
+    data[2] = {reinterpret_cast<uintptr_t>(&marker), sizeof(marker), 0};
+    data[3] = {reinterpret_cast<uintptr_t>(&frame_id), sizeof(frame_id), 0};
+
+    uint64_t decoded_markers = 0;
+    uint64_t last_frame_id = 0;
+    const auto decode = [&](const PclStatsRawEvent& event) {
+        uint32_t m = 0;
+        uint64_t f = 0;
+        if (DecodePclStatsRawEvent(event, &m, &f) == PclStatsEventKind::kMarker) {
+            ++decoded_markers;
+            last_frame_id = f;
+        }
+    };
+
+    // Matched write; the consumer drains before the ring fills, as the monitoring thread does every 8 ms
+    constexpr size_t kDrainEvery = kCapacity / 2;
+    const double matched_ns = dc_test::MeasureNsPerOp(1000000, [&](size_t i) {
+        frame_id = i;
+        hooks->Write(0x3333, 1, static_cast<int64_t>(i), data, 4);
+        if (i % kDrainEvery == kDrainEvery - 1) {
+            hooks->queue.Drain([](const PclStatsRawEvent&) {});
+        }
+    });
+    const double forwarded_ns = dc_test::MeasureNsPerOp(
+        1000000, [&](size_t i) { dc_test::Consume(hooks->Write(0x1111, 1, static_cast<int64_t>(i), data, 4)); });
+    hooks->queue.Drain([](const PclStatsRawEvent&) {});
+
+    size_t drained = 0;
+    const double drain_ns = dc_test::MeasureNsPerOp(2000, [&](size_t batch) {
+        for (size_t i = 0; i < kDrainEvery; ++i) {
+            frame_id = batch * kDrainEvery + i;
+            hooks->Write(0x2222, 1, static_cast<int64_t>(frame_id), data, 4);
+        }
+        drained += hooks->queue.Drain(decode);
+    });
+
+    const PclStatsEventQueueStats stats = hooks->queue.GetStats();
+    CHECK_EQ(stats.dropped, 0u);
+    CHECK_EQ(decoded_markers, drained);
+    CHECK_EQ(last_frame_id, frame_id);
+    dc_test::ReportBenchmark("PCLStats write: matched (copy + enqueue)", matched_ns);
+    dc_test::ReportBenchmark("PCLStats write: other provider (forwarded)", forwarded_ns);
+    dc_test::ReportBenchmark("PCLStats write + drain + decode, per event",
+                             drain_ns / static_cast<double>(kDrainEvery));
+}
+
+}  // namespace
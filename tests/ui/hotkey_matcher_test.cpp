@@ -0,0 +1,346 @@
+// Source Code <Display Commander> // Compiled hotkey matcher tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "ui/new_ui/hotkey_matcher.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace ui::new_ui;
+
+constexpr int64_t kMs = 1000000;
+constexpr int kVkShift = 0x10;
+constexpr int kVkControl = 0x11;
+constexpr int kVkMenu = 0x12;
+constexpr int kVkLControl = 0xA2;
+constexpr int kVkF1 = 0x70;
+constexpr int kVkAdd = 0x6B;
+
+// Letters, digits, f1..f12 and "numpad+" (a key whose name contains the separator)
+int ResolveKey(std::string_view token) {
+    if (token.size() == 1 && token[0] >= 'a' && token[0] <= 'z') return 'A' + (token[0] - 'a');
+    if (token.size() == 1 && token[0] >= '0' && token[0] <= '9') return token[0];
+    if (token == "numpad+") return kVkAdd;
+    if (token == "lctrl") return kVkLControl;
+    if (token.size() >= 2 && token[0] == 'f') {
+        const int n = std::stoi(std::string(token.substr(1)));
+        return n >= 1 && n <= 12 ? kVkF1 + n - 1 : 0;
+    }
+    return 0;
+}
+
+std::string NameKey(int vk) {
+    if ((vk >= 'A' && vk <= 'Z') || (vk >= '0' && vk <= '9')) return std::string(1, static_cast<char>(vk));
+    if (vk == kVkAdd) return "Numpad+";
+    if (vk >= kVkF1 && vk < kVkF1 + 12) return std::string("F").append(std::to_string(vk - kVkF1 + 1));
+    return "?";
+}
+
+std::vector<HotkeyStep> Parse(std::string_view text) {
+    std::vector<HotkeyStep> steps;
+    std::string error;
+    const bool ok = ParseHotkeyBinding(text, ResolveKey, steps, &error);
+    CHECK(ok);
+    return steps;
+}
+
+HotkeyBindingSpec Binding(uint32_t action, std::string_view text, uint32_t group = 0) {
+    HotkeyBindingSpec spec;
+    spec.action = action;
+    spec.group = group;
+    spec.steps = Parse(text);
+    return spec;
+}
+
+HotkeyKeyBitmap Keys(std::initializer_list<int> vks) {
+    HotkeyKeyBitmap keys = {};
+    for (const int vk : vks) {
+        keys[static_cast<size_t>(vk) >> 6] |= 1ull << (vk & 63);
+    }
+    return keys;
+}
+
+// Fires vk with `held` (vk added) and returns the completed actions.
+std::vector<uint32_t> Press(const CompiledHotkeyMatcher& matcher, HotkeyMatchState& state, int vk,
+                            std::initializer_list<int> held, int64_t now_ns) {
+    HotkeyKeyBitmap keys = Keys(held);
+    keys[static_cast<size_t>(vk) >> 6] |= 1ull << (vk & 63);
+    const auto actions = matcher.OnKeyDown(state, vk, keys, now_ns);
+    return {actions.begin(), actions.end()};
+}
+
+bool HasDiagnostic(const CompiledHotkeyMatcher& matcher, HotkeyConflictKind kind, uint32_t action, uint32_t other) {
+    for (const HotkeyDiagnostic& d : matcher.GetDiagnostics()) {
+        if (d.kind == kind && d.action == action && d.other_action == other) return true;
+    }
+    return false;
+}
+
+DC_TEST(ParseAcceptsSpacePlusAndSequences) {
+    const auto a = Parse("ctrl shift d");
+    const auto b = Parse("Ctrl+Shift+D");
+    CHECK(a == b);
+    REQUIRE(a.size() == 1u);
+    CHECK_EQ(a[0].modifiers, kHotkeyModCtrl | kHotkeyModShift);
+    CHECK_EQ(a[0].key_count, 1u);
+    CHECK_EQ(a[0].keys[0], 'D');
+
+    const auto chord = Parse("s a");  // Both held; keys sorted
+    REQUIRE(chord.size() == 1u);
+    CHECK_EQ(chord[0].key_count, 2u);
+    CHECK_EQ(chord[0].keys[0], 'A');
+    CHECK_EQ(chord[0].keys[1], 'S');
+
+    const auto sequence = Parse("ctrl k, ctrl s");
+    REQUIRE(sequence.size() == 2u);
+    CHECK_EQ(sequence[1].keys[0], 'S');
+
+    const auto numpad = Parse("alt+numpad+");
+    REQUIRE(numpad.size() == 1u);
+    CHECK_EQ(numpad[0].modifiers, kHotkeyModAlt);
+    CHECK_EQ(numpad[0].keys[0], kVkAdd);
+}
+
+DC_TEST(ParseRejectsInvalidBindings) {
+    std::vector<HotkeyStep> steps;
+    std::string error;
+    CHECK(!ParseHotkeyBinding("ctrl bogus", ResolveKey, steps, &error));
+    CHECK(error.find("bogus") != std::string::npos);
+    CHECK(steps.empty());
+    CHECK(!ParseHotkeyBinding("ctrl", ResolveKey, steps, &error));             // No key
+    CHECK(!ParseHotkeyBinding("a,, b", ResolveKey, steps, &error));            // Empty step
+    CHECK(!ParseHotkeyBinding("a, b, c, d, e", ResolveKey, steps, &error));    // Too many steps
+    CHECK(!ParseHotkeyBinding("a b c d e", ResolveKey, steps, &error));        // Too many chord keys
+    CHECK(!ParseHotkeyBinding("lctrl a", ResolveKey, steps, &error));          // Modifier as key
+    CHECK(error.find("modifier") != std::string::npos);
+}
+
+DC_TEST(FormatRoundTrips) {
+    for (std::string_view text : {"ctrl shift d", "ctrl k, ctrl s", "alt numpad+", "win f12", "a s"}) {
+        const auto steps = Parse(text);
+        const std::string config = FormatHotkeyBinding(steps, NameKey, ' ');
+        CHECK(Parse(config) == steps);
+        const std::string display = FormatHotkeyBinding(steps, NameKey, '+');
+        CHECK(Parse(display) == steps);
+    }
+    CHECK_EQ(FormatHotkeyBinding(Parse("shift ctrl d, x"), NameKey, '+'), std::string("ctrl+shift+D, X"));
+}
+
+DC_TEST(ModifiersMustMatchExactly) {
+    const auto matcher = CompiledHotkeyMatcher::Compile({Binding(1, "ctrl d"), Binding(2, "ctrl shift d")});
+    HotkeyMatchState state;
+    CHECK(Press(matcher, state, 'D', {kVkControl}, 0) == std::vector<uint32_t>{1});
+    CHECK(Press(matcher, state, 'D', {kVkControl, kVkShift}, 0) == std::vector<uint32_t>{2});
+    CHECK(Press(matcher, state, 'D', {kVkControl, kVkMenu}, 0).empty());
+    CHECK(Press(matcher, state, 'D', {}, 0).empty());
+    // Modifier keys themselves never match or reset anything
+    CHECK(Press(matcher, state, kVkControl, {}, 0).empty());
+    CHECK(Press(matcher, state, kVkLControl, {kVkControl}, 0).empty());
+}
+
+DC_TEST(ChordFiresOnLastKeyAndMostSpecificWins) {
+    const auto matcher = CompiledHotkeyMatcher::Compile({Binding(1, "a"), Binding(2, "a s", 1), Binding(3, "f1")});
+    HotkeyMatchState state;
+    CHECK(Press(matcher, state, 'A', {}, 0) == std::vector<uint32_t>{1});
+    // S goes down last with A held: the chord
+    CHECK(Press(matcher, state, 'S', {'A'}, 0) == std::vector<uint32_t>{2});
+    // A goes down last with S held: the chord is more specific than "a"
+    CHECK(Press(matcher, state, 'A', {'S'}, 0) == std::vector<uint32_t>{2});
+    // Unrelated held keys are ignored
+    CHECK(Press(matcher, state, kVkF1, {'Q', 'W'}, 0) == std::vector<uint32_t>{3});
+}
+
+DC_TEST(SequenceAdvancesAndTimesOut) {
+    const auto matcher = CompiledHotkeyMatcher::Compile({Binding(1, "ctrl k, ctrl s"), Binding(2, "ctrl s")});
+    // ctrl s alone and as second step are different paths: no conflict
+    CHECK(matcher.GetDiagnostics().empty());
+    HotkeyMatchState state;
+    CHECK(Press(matcher, state, 'K', {kVkControl}, 0).empty());
+    CHECK(state.node != 0u);
+    CHECK(Press(matcher, state, 'S', {kVkControl}, 500 * kMs) == std::vector<uint32_t>{1});
+    CHECK_EQ(state.node, 0u);
+
+    // Too slow: the second step starts over from the root
+    CHECK(Press(matcher, state, 'K', {kVkControl}, 1000 * kMs).empty());
+    CHECK(Press(matcher, state, 'S', {kVkControl}, 1000 * kMs + kHotkeySequenceTimeoutNs + 1)
+          == std::vector<uint32_t>{2});
+
+    // Broken sequence: the key may still start something from the root
+    CHECK(Press(matcher, state, 'K', {kVkControl}, 5000 * kMs).empty());
+    CHECK(Press(matcher, state, 'X', {}, 5001 * kMs).empty());
+    CHECK_EQ(state.node, 0u);
+    CHECK(Press(matcher, state, 'K', {kVkControl}, 5002 * kMs).empty());
+    // Modifier key down between steps does not break the sequence
+    CHECK(Press(matcher, state, kVkControl, {}, 5003 * kMs).empty());
+    CHECK(Press(matcher, state, 'S', {kVkControl}, 5004 * kMs) == std::vector<uint32_t>{1});
+}
+
+DC_TEST(ConflictsInOneGroupAreRejected) {
+    const auto matcher = CompiledHotkeyMatcher::Compile({
+        Binding(1, "ctrl d"),
+        Binding(2, "ctrl d"),          // Duplicate of 1
+        Binding(3, "ctrl d, x"),       // Shadowed by prefix 1
+        Binding(4, "ctrl k, ctrl s"),
+        Binding(5, "ctrl k"),          // Would shadow 4
+        HotkeyBindingSpec{6, 0, {}},   // No steps
+    });
+    CHECK_EQ(matcher.GetBindingCount(), 2u);
+    CHECK(HasDiagnostic(matcher, HotkeyConflictKind::kDuplicate, 2, 1));
+    CHECK(HasDiagnostic(matcher, HotkeyConflictKind::kShadowedByPrefix, 3, 1));
+    CHECK(HasDiagnostic(matcher, HotkeyConflictKind::kShadowsLonger, 5, 4));
+    CHECK(HasDiagnostic(matcher, HotkeyConflictKind::kInvalid, 6, UINT32_MAX));
+    for (const HotkeyDiagnostic& d : matcher.GetDiagnostics()) {
+        CHECK(d.IsError());
+    }
+
+    // The earlier binding keeps working
+    HotkeyMatchState state;
+    CHECK(Press(matcher, state, 'D', {kVkControl}, 0) == std::vector<uint32_t>{1});
+    CHECK(Press(matcher, state, 'K', {kVkControl}, 0).empty());
+    CHECK(Press(matcher, state, 'S', {kVkControl}, 1) == std::vector<uint32_t>{4});
+}
+
+DC_TEST(ConflictsAcrossGroupsAreWarnings) {
+    const auto matcher = CompiledHotkeyMatcher::Compile({
+        Binding(1, "ctrl d", 0),
+        Binding(2, "ctrl d", 1),     // Shared: both fire
+        Binding(3, "ctrl d, x", 2),  // Prefix across groups
+    });
+    CHECK_EQ(matcher.GetBindingCount(), 3u);
+    CHECK(HasDiagnostic(matcher, HotkeyConflictKind::kSharedAcrossGroups, 2, 1));
+    CHECK(HasDiagnostic(matcher, HotkeyConflictKind::kPrefixAcrossGroups, 3, 1));
+    CHECK(HasDiagnostic(matcher, HotkeyConflictKind::kPrefixAcrossGroups, 3, 2));
+    for (const HotkeyDiagnostic& d : matcher.GetDiagnostics()) {
+        CHECK(!d.IsError());
+    }
+
+    HotkeyMatchState state;
+    CHECK(Press(matcher, state, 'D', {kVkControl}, 0) == (std::vector<uint32_t>{1, 2}));
+    // The longer one still completes
+    CHECK(Press(matcher, state, 'X', {}, 1) == std::vector<uint32_t>{3});
+}
+
+DC_TEST(InvalidStepsAreRejected) {
+    HotkeyBindingSpec unsorted;
+    unsorted.action = 7;
+    HotkeyStep step;
+    step.key_count = 2;
+    step.keys = {'S', 'A', 0, 0};
+    unsorted.steps.push_back(step);
+    HotkeyBindingSpec modifier_key;
+    modifier_key.action = 8;
+    step.key_count = 1;
+    step.keys = {kVkLControl, 0, 0, 0};
+    modifier_key.steps.push_back(step);
+    HotkeyBindingSpec empty;
+    empty.action = 9;
+
+    const auto matcher = CompiledHotkeyMatcher::Compile({unsorted, modifier_key, empty});
+    CHECK_EQ(matcher.GetBindingCount(), 0u);
+    CHECK_EQ(matcher.GetDiagnostics().size(), 3u);
+    HotkeyMatchState state;
+    CHECK(Press(matcher, state, 'A', {'S'}, 0).empty());
+}
+
+DC_TEST(UsedKeysCoverEveryTriggerKey) {
+    const auto matcher = CompiledHotkeyMatcher::Compile({Binding(1, "ctrl k, ctrl s"), Binding(2, "a s", 1)});
+    const HotkeyKeyBitmap used = matcher.GetUsedKeys();
+    CHECK(used == Keys({'K', 'S', 'A'}));
+}
+
+// 500 bindings: letters / digits / F-keys with 11 modifier sets, plus two-step sequences behind ctrl alt shift
+// (a modifier set no single-step binding uses, so there are no conflicts).
+std::vector<HotkeyBindingSpec> MakeBindings(size_t count) {
+    static const std::string kModifiers[] = {"",          "ctrl ",     "shift ",    "alt ",     "ctrl shift ",
+                                             "ctrl alt ", "shift alt ", "win ",     "ctrl win ", "shift win ",
+                                             "alt win "};
+    constexpr size_t kModifierSets = sizeof(kModifiers) / sizeof(kModifiers[0]);
+    std::vector<std::string> keys;
+    for (char c = 'a'; c <= 'z'; ++c) keys.emplace_back(1, c);
+    for (char c = '0'; c <= '9'; ++c) keys.emplace_back(1, c);
+    for (int f = 1; f <= 12; ++f) keys.push_back(std::string("f").append(std::to_string(f)));
+
+    std::vector<HotkeyBindingSpec> bindings;
+    for (size_t i = 0; bindings.size() < count * 4 / 5; ++i) {
+        const std::string text = kModifiers[i % kModifierSets] + keys[i / kModifierSets];
+        bindings.push_back(Binding(static_cast<uint32_t>(bindings.size()), text));
+    }
+    for (size_t i = 0; bindings.size() < count; ++i) {
+        const std::string text = "ctrl alt shift " + keys[i % keys.size()] + ", " + keys[i / keys.size()];
+        bindings.push_back(Binding(static_cast<uint32_t>(bindings.size()), text));
+    }
+    return bindings;
+}
+
+// What the per-pass scan did before compilation: every binding checked against the pressed key and held set.
+size_t LinearMatch(const std::vector<HotkeyBindingSpec>& bindings, int vk, const HotkeyKeyBitmap& held) {
+    const uint8_t modifiers = HotkeyModifiersFromBitmap(held);
+    size_t matches = 0;
+    for (const HotkeyBindingSpec& spec : bindings) {
+        const HotkeyStep& step = spec.steps[0];
+        if (step.modifiers != modifiers) continue;
+        bool triggered = false;
+        bool held_all = true;
+        for (size_t k = 0; k < step.key_count; ++k) {
+            triggered |= step.keys[k] == vk;
+            held_all &= (held[step.keys[k] >> 6] >> (step.keys[k] & 63)) & 1;
+        }
+        matches += triggered && held_all ? 1 : 0;
+    }
+    return matches;
+}
+
+DC_TEST(FiveHundredBindingsCompileWithoutErrorsAndMatch) {
+    const auto bindings = MakeBindings(500);
+    const auto matcher = CompiledHotkeyMatcher::Compile(bindings);
+    for (const HotkeyDiagnostic& d : matcher.GetDiagnostics()) {
+        CHECK(!d.IsError());
+    }
+    CHECK_EQ(matcher.GetBindingCount(), 500u);
+
+    // Every single-step binding fires for its own keys and nothing else
+    HotkeyMatchState state;
+    for (size_t i = 0; i < 400; ++i) {
+        const HotkeyStep& step = bindings[i].steps[0];
+        HotkeyKeyBitmap held = {};
+        if (step.modifiers & kHotkeyModCtrl) held[kVkControl >> 6] |= 1ull << (kVkControl & 63);
+        if (step.modifiers & kHotkeyModShift) held[kVkShift >> 6] |= 1ull << (kVkShift & 63);
+        if (step.modifiers & kHotkeyModAlt) held[kVkMenu >> 6] |= 1ull << (kVkMenu & 63);
+        if (step.modifiers & kHotkeyModWin) held[0x5B >> 6] |= 1ull << (0x5B & 63);
+        held[step.keys[0] >> 6] |= 1ull << (step.keys[0] & 63);
+        state = {};
+        const auto actions = matcher.OnKeyDown(state, step.keys[0], held, 0);
+        REQUIRE(actions.size() == 1u);
+        CHECK_EQ(actions[0], bindings[i].action);
+    }
+}
+
+DC_TEST(BenchmarkKeyDownFiveHundredBindings) {
+    const auto bindings = MakeBindings(500);
+    const auto matcher = CompiledHotkeyMatcher::Compile(bindings);
+    const HotkeyKeyBitmap held_ctrl = Keys({kVkControl, 'Q'});
+    unsigned long long sink = 0;
+
+    const double linear_ns = dc_test::MeasureNsPerOp(200000, [&](size_t i) {
+        const int vk = 'A' + static_cast<int>(i % 26);
+        HotkeyKeyBitmap held = held_ctrl;
+        held[static_cast<size_t>(vk) >> 6] |= 1ull << (vk & 63);
+        sink += LinearMatch(bindings, vk, held);
+    });
+    HotkeyMatchState state;
+    const double compiled_ns = dc_test::MeasureNsPerOp(200000, [&](size_t i) {
+        const int vk = 'A' + static_cast<int>(i % 26);
+        HotkeyKeyBitmap held = held_ctrl;
+        held[static_cast<size_t>(vk) >> 6] |= 1ull << (vk & 63);
+        sink += matcher.OnKeyDown(state, vk, held, static_cast<int64_t>(i)).size();
+    });
+    dc_test::Consume(sink);
+    dc_test::ReportBenchmark("key-down, 500 bindings, linear scan", linear_ns);
+    dc_test::ReportBenchmark("key-down, 500 bindings, compiled trie", compiled_ns);
+}
+
+}  // namespace
@@ -0,0 +1,267 @@
+// Source Code <Display Commander> // Timer wheel scheduler tests (platform-neutral, no Windows includes)
+#include "dc_test.hpp"
+#include "continuous_monitoring.hpp"
+#include "utils/timer_wheel_scheduler.hpp"
+
+// Libraries <Standard C++>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using utils::TimerWheelScheduler;
+
+constexpr int64_t kMs = 1000000;
+
+// Virtual clock read by the scheduler for task durations; tests advance it explicitly.
+int64_t g_virtual_now_ns = 0;
+int64_t VirtualClockNs() { return g_virtual_now_ns; }
+
+// Steps the wheel in 1 ms increments up to end_ns (tasks read now_ns for their run times).
+void StepTo(TimerWheelScheduler& scheduler, int64_t& now_ns, int64_t end_ns) {
+    while (now_ns < end_ns) {
+        now_ns += kMs;
+        g_virtual_now_ns = now_ns;
+        scheduler.RunDue(now_ns);
+    }
+}
+
+const TimerWheelScheduler::TaskStats& StatsOf(const std::vector<TimerWheelScheduler::TaskStats>& stats,
+                                              const char* name) {
+    for (const TimerWheelScheduler::TaskStats& s : stats) {
+        if (std::string(s.name) == name) {
+            return s;
+        }
+    }
+    static const TimerWheelScheduler::TaskStats kNone;
+    return kNone;
+}
+
+DC_TEST(PeriodicTaskRunsOnPeriod) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    std::vector<int64_t> runs;
+    int64_t now_ns = 0;
+    scheduler.AddPeriodic("periodic", 8 * kMs, [&] { runs.push_back(now_ns); });
+    StepTo(scheduler, now_ns, 100 * kMs);
+    REQUIRE(runs.size() == 12);
+    for (size_t i = 0; i < runs.size(); ++i) {
+        CHECK_EQ(runs[i], static_cast<int64_t>(i + 1) * 8 * kMs);
+    }
+}
+
+DC_TEST(FirstDelayAndOneShot) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    std::vector<int64_t> periodic_runs;
+    std::vector<int64_t> one_shot_runs;
+    int64_t now_ns = 0;
+    scheduler.AddPeriodic("warmup", 50 * kMs, [&] { periodic_runs.push_back(now_ns); }, 1000 * kMs);
+    const TimerWheelScheduler::TaskId one_shot =
+        scheduler.AddOneShot("one_shot", 5 * kMs, [&] { one_shot_runs.push_back(now_ns); });
+    StepTo(scheduler, now_ns, 1100 * kMs);
+    CHECK((one_shot_runs == std::vector<int64_t>{5 * kMs}));
+    CHECK((periodic_runs == std::vector<int64_t>{1000 * kMs, 1050 * kMs, 1100 * kMs}));
+    CHECK(!StatsOf(scheduler.GetStats(), "one_shot").active);
+
+    scheduler.Reschedule(one_shot, 1200 * kMs);
+    StepTo(scheduler, now_ns, 1200 * kMs);
+    CHECK_EQ(one_shot_runs.size(), 2u);
+}
+
+DC_TEST(TriggerRunsNowWithoutMovingDeadline) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    int wakes = 0;
+    scheduler.SetWakeCallback([&] { ++wakes; });
+    std::vector<int64_t> runs;
+    int64_t now_ns = 0;
+    const TimerWheelScheduler::TaskId id =
+        scheduler.AddPeriodic("safety_net", 100 * kMs, [&] { runs.push_back(now_ns); });
+    StepTo(scheduler, now_ns, 30 * kMs);
+    scheduler.Trigger(id);
+    CHECK_EQ(wakes, 1);
+    CHECK_EQ(scheduler.NextDeadlineNs(), 0);
+    StepTo(scheduler, now_ns, 31 * kMs);
+    StepTo(scheduler, now_ns, 100 * kMs);
+    CHECK((runs == std::vector<int64_t>{31 * kMs, 100 * kMs}));
+    const TimerWheelScheduler::TaskStats stats = StatsOf(scheduler.GetStats(), "safety_net");
+    CHECK_EQ(stats.runs, 2u);
+    CHECK_EQ(stats.triggered_runs, 1u);
+}
+
+DC_TEST(ScheduledRunSatisfiesPendingTrigger) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    int runs = 0;
+    const TimerWheelScheduler::TaskId id = scheduler.AddPeriodic("task", 10 * kMs, [&] { ++runs; });
+    scheduler.Trigger(id);
+    CHECK_EQ(scheduler.RunDue(10 * kMs), 1u);
+    CHECK_EQ(runs, 1);
+    CHECK_EQ(StatsOf(scheduler.GetStats(), "task").triggered_runs, 0u);
+}
+
+DC_TEST(EventTaskRunsOnlyWhenTriggered) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    int runs = 0;
+    int64_t now_ns = 0;
+    const TimerWheelScheduler::TaskId id = scheduler.AddEventTask("event", [&] { ++runs; });
+    CHECK_EQ(scheduler.NextDeadlineNs(), TimerWheelScheduler::kNoDeadline);
+    StepTo(scheduler, now_ns, 500 * kMs);
+    CHECK_EQ(runs, 0);
+    scheduler.Trigger(id);
+    scheduler.Trigger(id);  // Coalesced
+    StepTo(scheduler, now_ns, 501 * kMs);
+    CHECK_EQ(runs, 1);
+}
+
+// Adaptive period as used by keyboard_hotkeys / frame consumers: the task changes its own period while running.
+DC_TEST(TaskChangesItsOwnPeriod) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    std::vector<int64_t> runs;
+    int64_t now_ns = 0;
+    int64_t period_ns = 8 * kMs;
+    TimerWheelScheduler::TaskId id = TimerWheelScheduler::kInvalidTask;
+    id = scheduler.AddPeriodic("adaptive", period_ns, [&] {
+        runs.push_back(now_ns);
+        if (runs.size() == 3 && period_ns != 250 * kMs) {
+            period_ns = 250 * kMs;
+            scheduler.SetPeriod(id, period_ns, now_ns);
+        }
+    });
+    StepTo(scheduler, now_ns, 1000 * kMs);
+    CHECK((runs == std::vector<int64_t>{8 * kMs, 16 * kMs, 24 * kMs, 274 * kMs, 524 * kMs, 774 * kMs}));
+    CHECK_EQ(StatsOf(scheduler.GetStats(), "adaptive").period_ns, 250 * kMs);
+}
+
+DC_TEST(MissedPeriodsDoNotBurst) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    std::vector<int64_t> runs;
+    int64_t now_ns = 0;
+    scheduler.AddPeriodic("late", 10 * kMs, [&] { runs.push_back(now_ns); });
+    now_ns = 1000 * kMs;  // Thread stalled for a second
+    g_virtual_now_ns = now_ns;
+    scheduler.RunDue(now_ns);
+    CHECK_EQ(runs.size(), 1u);
+    const TimerWheelScheduler::TaskStats stats = StatsOf(scheduler.GetStats(), "late");
+    CHECK_EQ(stats.overruns, 1u);
+    CHECK_EQ(stats.max_start_delay_ns, 990 * kMs);
+    CHECK_EQ(scheduler.NextDeadlineNs(), 1010 * kMs);
+}
+
+DC_TEST(CancelStopsTask) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    int runs = 0;
+    int64_t now_ns = 0;
+    TimerWheelScheduler::TaskId id = TimerWheelScheduler::kInvalidTask;
+    id = scheduler.AddPeriodic("limited", 10 * kMs, [&] {
+        if (++runs == 6) {
+            scheduler.Cancel(id);
+        }
+    });
+    StepTo(scheduler, now_ns, 200 * kMs);
+    CHECK_EQ(runs, 6);
+    scheduler.Trigger(id);  // Cancelled tasks ignore triggers
+    StepTo(scheduler, now_ns, 201 * kMs);
+    CHECK_EQ(runs, 6);
+    CHECK(!StatsOf(scheduler.GetStats(), "limited").active);
+}
+
+// Deadlines on the second and third wheel level and in the overflow list, reached by sleeping until
+// NextDeadlineNs like the monitoring thread does (no 1 ms stepping).
+DC_TEST(LongDeadlinesCascadeExactly) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    std::vector<int64_t> level1_runs;
+    std::vector<int64_t> level2_runs;
+    std::vector<int64_t> overflow_runs;
+    int64_t now_ns = 0;
+    scheduler.AddPeriodic("level1", 1000 * kMs, [&] { level1_runs.push_back(now_ns); });
+    scheduler.AddPeriodic("level2", 10000 * kMs, [&] { level2_runs.push_back(now_ns); });
+    scheduler.AddOneShot("overflow", 300000 * kMs, [&] { overflow_runs.push_back(now_ns); });
+    size_t wakeups = 0;
+    while (now_ns < 300000 * kMs) {
+        now_ns = scheduler.NextDeadlineNs();
+        g_virtual_now_ns = now_ns;
+        scheduler.RunDue(now_ns);
+        ++wakeups;
+    }
+    CHECK_EQ(wakeups, 300u);  // One wake-up per second; the level2 / overflow runs share it
+    CHECK_EQ(level1_runs.size(), 300u);
+    CHECK_EQ(level1_runs.back(), 300000 * kMs);
+    REQUIRE(level2_runs.size() == 30);
+    for (size_t i = 0; i < level2_runs.size(); ++i) {
+        CHECK_EQ(level2_runs[i], static_cast<int64_t>(i + 1) * 10000 * kMs);
+    }
+    CHECK((overflow_runs == std::vector<int64_t>{300000 * kMs}));
+}
+
+DC_TEST(ObserverSeesVirtualDurations) {
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    static std::vector<int64_t> s_durations;
+    s_durations.clear();
+    scheduler.SetTaskObserver([](const char*, int64_t start_ns, int64_t end_ns) {
+        s_durations.push_back(end_ns - start_ns);
+    });
+    scheduler.AddPeriodic("slow", 10 * kMs, [] { g_virtual_now_ns += 15 * kMs; });
+    g_virtual_now_ns = 10 * kMs;
+    scheduler.RunDue(10 * kMs);
+    CHECK((s_durations == std::vector<int64_t>{15 * kMs}));
+    const TimerWheelScheduler::TaskStats stats = StatsOf(scheduler.GetStats(), "slow");
+    CHECK_EQ(stats.max_duration_ns, 15 * kMs);
+    CHECK_EQ(stats.overruns, 1u);  // Ran longer than its period
+}
+
+DC_TEST(MonitorWakeTime) {
+    using continuous_monitoring::MonitorWakeTimeNs;
+    const int64_t warmup_end = 1000 * kMs;
+    CHECK_EQ(MonitorWakeTimeNs(500 * kMs, 100 * kMs, false, warmup_end), 500 * kMs);
+    // Pending during warmup: sleep until the warmup ends (or an earlier deadline)
+    CHECK_EQ(MonitorWakeTimeNs(2000 * kMs, 100 * kMs, true, warmup_end), warmup_end);
+    CHECK_EQ(MonitorWakeTimeNs(500 * kMs, 100 * kMs, true, warmup_end), 500 * kMs);
+    // Pending after warmup: run now
+    CHECK_EQ(MonitorWakeTimeNs(2000 * kMs, 1200 * kMs, true, warmup_end), 1200 * kMs);
+}
+
+// The monitoring loop on a virtual clock: a task request arrives during the one second warmup. The loop has to sleep
+// until the warmup ends and then run the requested task once, instead of waking continuously.
+DC_TEST(MonitorLoopDoesNotSpinOnRequestDuringWarmup) {
+    const int64_t warmup_end = 1000 * kMs;
+    TimerWheelScheduler scheduler(0, &VirtualClockNs);
+    std::vector<int64_t> keyboard_runs;
+    int64_t now_ns = 0;
+    scheduler.AddPeriodic("game_window_from_foreground", 500 * kMs, [] {}, 0);
+    const TimerWheelScheduler::TaskId keyboard =
+        scheduler.AddPeriodic("keyboard_hotkeys", 250 * kMs, [&] { keyboard_runs.push_back(now_ns); }, warmup_end);
+
+    const int64_t request_at = 200 * kMs;
+    bool request_sent = false;
+    bool pending = false;
+    size_t wakeups_in_warmup = 0;
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+        const int64_t wake_ns = continuous_monitoring::MonitorWakeTimeNs(scheduler.NextDeadlineNs(), now_ns, pending,
+                                                                         warmup_end);
+        if (wake_ns > 1600 * kMs) {
+            break;
+        }
+        if (wake_ns > now_ns) {
+            // WaitForSingleObject: the request's SetEvent ends the wait early
+            now_ns = (!request_sent && request_at < wake_ns) ? request_at : wake_ns;
+        }
+        if (!request_sent && now_ns >= request_at) {
+            request_sent = true;
+            pending = true;
+        }
+        if (now_ns < warmup_end) {
+            ++wakeups_in_warmup;
+        } else if (pending) {
+            pending = false;
+            scheduler.Trigger(keyboard);
+        }
+        g_virtual_now_ns = now_ns;
+        scheduler.RunDue(now_ns);
+    }
+    // Wake-ups before the warmup ended: t = 0 (foreground task) and the request at 200 ms; the 500 ms foreground
+    // run lies before the warmup end too.
+    CHECK_EQ(wakeups_in_warmup, 3u);
+    CHECK((keyboard_runs == std::vector<int64_t>{1000 * kMs, 1250 * kMs, 1500 * kMs}));
+    CHECK_EQ(StatsOf(scheduler.GetStats(), "keyboard_hotkeys").triggered_runs, 0u);  // Satisfied by the 1 s run
+}
+
+}  // namespace